@@ -6,6 +6,7 @@
 
 #include <AK/Assertions.h>
 #include <AK/Format.h>
+#include <execinfo.h>
 
 #if !defined(KERNEL)
 extern "C" {
@@ -13,6 +14,7 @@ extern "C" {
 void ak_verification_failed(char const* message)
 {
     dbgln("VERIFICATION FAILED: {}", message);
+    { void* frames[64]; int n = backtrace(frames, 64); backtrace_symbols_fd(frames, n, 2); }
     __builtin_trap();
 }
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/ByteBuffer.h>
+#include <AK/Endian.h>
 #include <AK/MaybeOwned.h>
 #include <AK/OwnPtr.h>
 #include <AK/Stream.h>
@@ -119,8 +120,18 @@ private:
 
 /// A stream wrapper class that allows you to read arbitrary amounts of bits
 /// in little-endian order from another stream.
+/// Bits are read ahead from the underlying stream into a 64-bit buffer, so the underlying
+/// stream must not be read from directly while it is wrapped by this stream.
 class LittleEndianInputBitStream : public Stream {
+    using BufferType = u64;
+
+    static constexpr size_t bits_per_byte = 8;
+    static constexpr size_t bit_buffer_size = sizeof(BufferType) * bits_per_byte;
+
 public:
+    // The buffer is refilled a whole byte at a time, so this is how many bits it is guaranteed to be able to hold at once.
+    static constexpr size_t max_peek_bit_count = bit_buffer_size - bits_per_byte + 1;
+
     explicit LittleEndianInputBitStream(MaybeOwned<Stream> stream)
         : m_stream(move(stream))
     {
@@ -129,16 +140,22 @@ public:
     // ^Stream
     virtual ErrorOr<Bytes> read(Bytes bytes) override
     {
-        if (m_current_byte.has_value() && is_aligned_to_byte_boundary()) {
-            bytes[0] = m_current_byte.release_value();
-            return m_stream->read(bytes.slice(1));
-        }
         align_to_byte_boundary();
-        return m_stream->read(bytes);
+
+        size_t buffered_bytes_read = 0;
+        for (; buffered_bytes_read < bytes.size() && m_bit_count > 0; ++buffered_bytes_read) {
+            bytes[buffered_bytes_read] = static_cast<u8>(m_bit_buffer);
+            consume_bits(bits_per_byte);
+        }
+        if (buffered_bytes_read == bytes.size())
+            return bytes;
+
+        auto read_bytes = TRY(m_stream->read(bytes.slice(buffered_bytes_read)));
+        return bytes.trim(buffered_bytes_read + read_bytes.size());
     }
     virtual ErrorOr<size_t> write(ReadonlyBytes bytes) override { return m_stream->write(bytes); }
     virtual ErrorOr<void> write_entire_buffer(ReadonlyBytes bytes) override { return m_stream->write_entire_buffer(bytes); }
-    virtual bool is_eof() const override { return m_stream->is_eof() && !m_current_byte.has_value(); }
+    virtual bool is_eof() const override { return m_stream->is_eof() && m_bit_count == 0; }
     virtual bool is_open() const override { return m_stream->is_open(); }
     virtual void close() override
     {
@@ -159,65 +176,85 @@ public:
         if constexpr (IsSame<bool, T>) {
             VERIFY(count == 1);
         }
-        T result = 0;
 
-        size_t nread = 0;
-        while (nread < count) {
-            if (m_current_byte.has_value()) {
-                if constexpr (!IsSame<bool, T> && !IsSame<u8, T>) {
-                    // read as many bytes as possible directly
-                    if (((count - nread) >= 8) && is_aligned_to_byte_boundary()) {
-                        // shift existing data over
-                        result |= (m_current_byte.value() << nread);
-                        nread += 8;
-                        m_current_byte.clear();
-                    } else {
-                        auto const bit = (m_current_byte.value() >> m_bit_offset) & 1;
-                        result |= (bit << nread);
-                        ++nread;
-                        if (m_bit_offset++ == 7)
-                            m_current_byte.clear();
-                    }
-                } else {
-                    // Always take this branch for booleans or u8: there's no purpose in reading more than a single bit
-                    auto const bit = (m_current_byte.value() >> m_bit_offset) & 1;
-                    if constexpr (IsSame<bool, T>)
-                        result = bit;
-                    else
-                        result |= (bit << nread);
-                    ++nread;
-                    if (m_bit_offset++ == 7)
-                        m_current_byte.clear();
-                }
-            } else {
-                auto temp_buffer = TRY(ByteBuffer::create_uninitialized(1));
-                auto read_bytes = TRY(m_stream->read(temp_buffer.bytes()));
-                if (read_bytes.is_empty())
-                    return Error::from_string_literal("eof");
-                m_current_byte = temp_buffer[0];
-                m_bit_offset = 0;
-            }
+        if (count > max_peek_bit_count) {
+            // The bits don't fit into the buffer at once, so read them in two halves.
+            static constexpr size_t low_bit_count = bit_buffer_size / 2;
+            u64 low_bits = TRY(read_bits<u64>(low_bit_count));
+            u64 high_bits = TRY(read_bits<u64>(count - low_bit_count));
+            return static_cast<T>(low_bits | (high_bits << low_bit_count));
         }
 
+        T result = TRY(peek_bits<T>(count));
+        TRY(discard_previously_peeked_bits(count));
         return result;
     }
 
+    /// Returns the next `count` bits without consuming them. Bits past the end of the underlying
+    /// stream read as zero, so that a variable-length code at the very end of the stream can be
+    /// looked up by peeking at the longest possible code length. Trying to consume those bits
+    /// with discard_previously_peeked_bits() fails instead.
+    template<Unsigned T = u64>
+    ErrorOr<T> peek_bits(size_t count)
+    {
+        VERIFY(count <= max_peek_bit_count);
+
+        TRY(refill_buffer_from_stream(count));
+        return static_cast<T>(m_bit_buffer & lsb_mask(count));
+    }
+
+    ErrorOr<void> discard_previously_peeked_bits(size_t count)
+    {
+        if (count > m_bit_count)
+            return Error::from_string_literal("eof");
+
+        consume_bits(count);
+        return {};
+    }
+
     /// Discards any sub-byte stream positioning the input stream may be keeping track of.
     /// Non-bitwise reads will implicitly call this.
     u8 align_to_byte_boundary()
     {
-        u8 remaining_bits = m_current_byte.value_or(0) >> m_bit_offset;
-        m_current_byte.clear();
-        m_bit_offset = 0;
+        auto remaining_bit_count = m_bit_count % bits_per_byte;
+        u8 remaining_bits = m_bit_buffer & lsb_mask(remaining_bit_count);
+        consume_bits(remaining_bit_count);
         return remaining_bits;
     }
 
     /// Whether we are (accidentally or intentionally) at a byte boundary right now.
-    ALWAYS_INLINE bool is_aligned_to_byte_boundary() const { return m_bit_offset == 0; }
+    ALWAYS_INLINE bool is_aligned_to_byte_boundary() const { return m_bit_count % bits_per_byte == 0; }
 
 private:
-    Optional<u8> m_current_byte;
-    size_t m_bit_offset { 0 };
+    static ALWAYS_INLINE BufferType lsb_mask(size_t bit_count)
+    {
+        return bit_count >= bit_buffer_size ? NumericLimits<BufferType>::max() : (static_cast<BufferType>(1) << bit_count) - 1;
+    }
+
+    ALWAYS_INLINE void consume_bits(size_t count)
+    {
+        m_bit_buffer = count >= bit_buffer_size ? 0 : m_bit_buffer >> count;
+        m_bit_count -= count;
+    }
+
+    ErrorOr<void> refill_buffer_from_stream(size_t requested_bit_count)
+    {
+        while (m_bit_count < requested_bit_count) {
+            // Fill all whole bytes that are free in the buffer with a single read.
+            BufferType new_bits = 0;
+            auto free_byte_count = (bit_buffer_size - m_bit_count) / bits_per_byte;
+            auto read_bytes = TRY(m_stream->read({ reinterpret_cast<u8*>(&new_bits), free_byte_count }));
+            if (read_bytes.is_empty())
+                break;
+
+            m_bit_buffer |= convert_between_host_and_little_endian(new_bits) << m_bit_count;
+            m_bit_count += read_bytes.size() * bits_per_byte;
+        }
+        return {};
+    }
+
+    BufferType m_bit_buffer { 0 };
+    size_t m_bit_count { 0 };
     MaybeOwned<Stream> m_stream;
 };
 
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// An I/O ring is a pair of queues shared between a process and the kernel. The process puts
+// submissions into the submission queue and calls io_ring_enter() to have the kernel consume them.
+// Every consumed submission eventually produces exactly one completion in the completion queue.
+//
+// Both queues are single-producer, single-consumer rings of power-of-two size, living in the
+// memory the process gets by mmap()ing the ring's file descriptor with MAP_SHARED. The producer
+// of a queue advances its tail, and the consumer advances its head. Both indices wrap around
+// naturally and are masked with the queue size when indexing the entries.
+
+enum class IORingOpcode : u8 {
+    Nop,
+    // Reads up to `length` bytes into `address`, from `offset` or the current file offset.
+    Read,
+    // Writes up to `length` bytes from `address`, at `offset` or the current file offset.
+    Write,
+    // Accepts a connection on the socket and produces its file descriptor. If `address` is set,
+    // up to `length` bytes of the peer address are written there. `flags` take SOCK_NONBLOCK and SOCK_CLOEXEC.
+    Accept,
+    // Connects the socket to the `length` bytes long socket address at `address`.
+    // The socket has to be non-blocking, otherwise this fails with EAGAIN.
+    Connect,
+    // Waits for any of the poll events in `flags` and produces the events that occurred.
+    Poll,
+    Fsync,
+};
+
+// Makes Read and Write use and advance the current offset of the file description.
+static constexpr u64 IORING_CURRENT_OFFSET = ~static_cast<u64>(0);
+
+struct IORingSubmission {
+    u64 user_data;
+    u64 address;
+    u64 offset;
+    u32 length;
+    u32 flags;
+    i32 fd;
+    IORingOpcode opcode;
+    u8 reserved[3];
+};
+
+struct IORingCompletion {
+    u64 user_data;
+    // The result of the operation, or a negated errno.
+    i64 result;
+};
+
+struct IORingQueueIndices {
+    u32 head;
+    u32 tail;
+};
+
+struct IORingControl {
+    IORingQueueIndices submissions;
+    IORingQueueIndices completions;
+};
+
+static constexpr u32 IORING_MAX_ENTRIES = 4096;
+
+// Flags for io_ring_create().
+static constexpr u32 IORING_CLOEXEC = 1 << 0;
+
+// The completion queue is twice as large as the submission queue, so operations that have to
+// wait for their file don't hold up new submissions too soon.
+static constexpr u32 io_ring_completion_entries(u32 submission_entries)
+{
+    return submission_entries * 2;
+}
+
+static constexpr size_t io_ring_submissions_offset()
+{
+    return sizeof(IORingControl);
+}
+
+static constexpr size_t io_ring_completions_offset(u32 submission_entries)
+{
+    return io_ring_submissions_offset() + submission_entries * sizeof(IORingSubmission);
+}
+
+static constexpr size_t io_ring_mapping_size(u32 submission_entries)
+{
+    constexpr size_t page_size = 4096;
+    auto size = io_ring_completions_offset(submission_entries) + io_ring_completion_entries(submission_entries) * sizeof(IORingCompletion);
+    return (size + page_size - 1) & ~(page_size - 1);
+}
+
@@ -7,6 +7,7 @@
 #include <AK/IntrusiveList.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Process.h>
 
 namespace Kernel {
@@ -18,21 +19,28 @@ struct CacheEntry {
     bool has_data { false };
 };
 
+// The cache starts out small and grows one segment at a time while it's full, up to a size
+// that depends on how much physical memory is still available. Once memory gets scarce, the
+// target size drops and segments that only hold clean blocks are given back.
 class DiskCache {
 public:
-    static constexpr size_t EntryCount = 10000;
-    explicit DiskCache(BlockBasedFileSystem& fs, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer)
-        : m_fs(fs)
-        , m_cached_block_data(move(cached_block_data))
-        , m_entries(move(entries_buffer))
+    static constexpr size_t EntriesPerSegment = 256;
+    static constexpr size_t MinimumEntryCount = 4 * EntriesPerSegment;
+
+    static ErrorOr<NonnullOwnPtr<DiskCache>> try_create(BlockBasedFileSystem& fs)
     {
-        for (size_t i = 0; i < EntryCount; ++i) {
-            entries()[i].data = m_cached_block_data->data() + i * m_fs->block_size();
-            m_clean_list.append(entries()[i]);
-        }
+        auto cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(fs)));
+        while (cache->entry_count() < MinimumEntryCount)
+            TRY(cache->try_add_segment());
+        cache->m_target_entry_count = cache->compute_target_entry_count();
+        return cache;
     }
 
-    ~DiskCache() = default;
+    ~DiskCache()
+    {
+        while (!m_segments.is_empty())
+            remove_last_segment();
+    }
 
     bool is_dirty() const { return !m_dirty_list.is_empty(); }
     bool entry_is_dirty(CacheEntry const& entry) const { return m_dirty_list.contains(entry); }
@@ -68,6 +76,9 @@ public:
         if (auto* entry = get(block_index))
             return entry;
 
+        if (m_hash.size() >= entry_count())
+            adjust_size_before_eviction();
+
         if (m_clean_list.is_empty()) {
             // Not a single clean entry! Flush writes and try again.
             // NOTE: We want to make sure we only call FileBackedFileSystem flush here,
@@ -80,7 +91,7 @@ public:
         auto& new_entry = *m_clean_list.last();
         m_clean_list.prepend(new_entry);
 
-        m_hash.remove(new_entry.block_index);
+        remove_from_hash(new_entry);
         TRY(m_hash.try_set(block_index, &new_entry));
 
         new_entry.block_index = block_index;
@@ -89,8 +100,7 @@ public:
         return &new_entry;
     }
 
-    CacheEntry const* entries() const { return (CacheEntry const*)m_entries->data(); }
-    CacheEntry* entries() { return (CacheEntry*)m_entries->data(); }
+    size_t entry_count() const { return m_segments.size() * EntriesPerSegment; }
 
     template<typename Callback>
     void for_each_dirty_entry(Callback callback)
@@ -100,12 +110,101 @@ public:
     }
 
 private:
+    struct Segment {
+        NonnullOwnPtr<KBuffer> block_data;
+        NonnullOwnPtr<KBuffer> entries_buffer;
+
+        CacheEntry* entries() { return (CacheEntry*)entries_buffer->data(); }
+    };
+
+    explicit DiskCache(BlockBasedFileSystem& fs)
+        : m_fs(fs)
+    {
+    }
+
+    size_t compute_target_entry_count() const
+    {
+        auto memory_info = MM.get_system_memory_info();
+        u64 total_bytes = memory_info.physical_pages * PAGE_SIZE;
+        u64 available_bytes = memory_info.physical_pages_uncommitted * PAGE_SIZE;
+        u64 cache_bytes = entry_count() * m_fs->block_size();
+
+        // Use up to an eighth of physical memory, but always leave at least half of the
+        // memory that's still available to everyone else.
+        u64 budget_bytes = min(total_bytes / 8, cache_bytes + available_bytes / 2);
+        return max(MinimumEntryCount, static_cast<size_t>(budget_bytes / m_fs->block_size()));
+    }
+
+    void adjust_size_before_eviction() const
+    {
+        if (++m_evictions_since_target_update >= EntriesPerSegment) {
+            m_evictions_since_target_update = 0;
+            m_target_entry_count = compute_target_entry_count();
+        }
+
+        if (entry_count() < m_target_entry_count) {
+            // If the memory isn't there after all, we just keep evicting entries.
+            (void)try_add_segment();
+            return;
+        }
+
+        while (entry_count() > m_target_entry_count && can_remove_last_segment())
+            remove_last_segment();
+    }
+
+    ErrorOr<void> try_add_segment() const
+    {
+        auto block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, EntriesPerSegment * m_fs->block_size()));
+        auto entries_buffer = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, EntriesPerSegment * sizeof(CacheEntry)));
+        TRY(m_segments.try_append({ move(block_data), move(entries_buffer) }));
+
+        auto& segment = m_segments.last();
+        for (size_t i = 0; i < EntriesPerSegment; ++i) {
+            auto* entry = new (&segment.entries()[i]) CacheEntry;
+            entry->data = segment.block_data->data() + i * m_fs->block_size();
+            m_clean_list.append(*entry);
+        }
+        return {};
+    }
+
+    bool can_remove_last_segment() const
+    {
+        if (m_segments.size() * EntriesPerSegment <= MinimumEntryCount)
+            return false;
+        auto& segment = m_segments.last();
+        for (size_t i = 0; i < EntriesPerSegment; ++i) {
+            if (entry_is_dirty(segment.entries()[i]))
+                return false;
+        }
+        return true;
+    }
+
+    void remove_last_segment() const
+    {
+        auto& segment = m_segments.last();
+        for (size_t i = 0; i < EntriesPerSegment; ++i) {
+            auto& entry = segment.entries()[i];
+            remove_from_hash(entry);
+            if (entry.list_node.is_in_list())
+                entry.list_node.remove();
+            entry.~CacheEntry();
+        }
+        m_segments.take_last();
+    }
+
+    void remove_from_hash(CacheEntry& entry) const
+    {
+        if (auto it = m_hash.find(entry.block_index); it != m_hash.end() && it->value == &entry)
+            m_hash.remove(it);
+    }
+
     mutable NonnullRefPtr<BlockBasedFileSystem> m_fs;
     mutable IntrusiveList<&CacheEntry::list_node> m_dirty_list;
     mutable IntrusiveList<&CacheEntry::list_node> m_clean_list;
     mutable HashMap<BlockBasedFileSystem::BlockIndex, CacheEntry*> m_hash;
-    NonnullOwnPtr<KBuffer> m_cached_block_data;
-    NonnullOwnPtr<KBuffer> m_entries;
+    mutable Vector<Segment> m_segments;
+    mutable size_t m_target_entry_count { MinimumEntryCount };
+    mutable size_t m_evictions_since_target_update { 0 };
 };
 
 BlockBasedFileSystem::BlockBasedFileSystem(OpenFileDescription& file_description)
@@ -129,9 +228,7 @@ ErrorOr<void> BlockBasedFileSystem::initialize_while_locked()
     VERIFY(m_lock.is_locked());
     VERIFY(!is_initialized_while_locked());
     VERIFY(block_size() != 0);
-    auto cached_block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, DiskCache::EntryCount * block_size()));
-    auto entries_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, DiskCache::EntryCount * sizeof(CacheEntry)));
-    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(*this, move(cached_block_data), move(entries_data))));
+    auto disk_cache = TRY(DiskCache::try_create(*this));
 
     m_cache.with_exclusive([&](auto& cache) {
         cache = move(disk_cache);
@@ -158,6 +255,9 @@ ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBu
             u64 base_offset = index.value() * block_size() + offset;
             auto nwritten = TRY(file_description().write(base_offset, data, count));
             VERIFY(nwritten == count);
+            // Don't let the cache hand out what was there before.
+            if (auto* entry = cache->get(index))
+                entry->has_data = false;
             return {};
         }
 
@@ -265,6 +365,37 @@ ErrorOr<void> BlockBasedFileSystem::read_blocks(BlockIndex index, unsigned count
     return {};
 }
 
+ErrorOr<void> BlockBasedFileSystem::read_blocks_uncached(BlockIndex index, size_t count, UserOrKernelBuffer& buffer) const
+{
+    VERIFY(m_logical_block_size);
+    dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::read_blocks_uncached {}, count={}", index, count);
+    for (size_t i = 0; i < count; ++i)
+        const_cast<BlockBasedFileSystem*>(this)->flush_specific_block_if_needed(BlockIndex { index.value() + i });
+    auto nread = TRY(file_description().read(buffer, index.value() * block_size(), count * block_size()));
+    VERIFY(nread == count * block_size());
+    return {};
+}
+
+ErrorOr<void> BlockBasedFileSystem::write_blocks_uncached(BlockIndex index, size_t count, UserOrKernelBuffer const& data)
+{
+    VERIFY(m_logical_block_size);
+    dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::write_blocks_uncached {}, count={}", index, count);
+    m_cache.with_exclusive([&](auto& cache) {
+        // These blocks are overwritten entirely, so whatever the cache holds for them is stale now.
+        for (size_t i = 0; i < count; ++i) {
+            auto* entry = cache->get(BlockIndex { index.value() + i });
+            if (!entry)
+                continue;
+            if (cache->entry_is_dirty(*entry))
+                cache->mark_clean(*entry);
+            entry->has_data = false;
+        }
+    });
+    auto nwritten = TRY(file_description().write(index.value() * block_size(), data, count * block_size()));
+    VERIFY(nwritten == count * block_size());
+    return {};
+}
+
 void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
 {
     m_cache.with_exclusive([&](auto& cache) {
@@ -278,6 +409,7 @@ void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
         size_t base_offset = entry->block_index.value() * block_size();
         auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry->data);
         (void)file_description().write(base_offset, entry_data_buffer, block_size());
+        cache->mark_clean(*entry);
     });
 }
 
@@ -36,6 +36,11 @@ protected:
     ErrorOr<void> raw_read_blocks(BlockIndex index, size_t count, UserOrKernelBuffer&);
     ErrorOr<void> raw_write_blocks(BlockIndex index, size_t count, UserOrKernelBuffer const&);
 
+    // Transfers a run of adjacent blocks with a single request, bypassing the cache. This is meant for
+    // file data, which is cached in the page cache instead.
+    ErrorOr<void> read_blocks_uncached(BlockIndex, size_t count, UserOrKernelBuffer&) const;
+    ErrorOr<void> write_blocks_uncached(BlockIndex, size_t count, UserOrKernelBuffer const&);
+
     ErrorOr<void> write_block(BlockIndex, UserOrKernelBuffer const&, size_t count, u64 offset = 0, bool allow_cache = true);
     ErrorOr<void> write_blocks(BlockIndex, unsigned count, UserOrKernelBuffer const&, bool allow_cache = true);
 
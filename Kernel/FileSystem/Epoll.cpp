@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/Epoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Locking/Spinlock.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+// Protects all watches, along with the watch lists of epoll instances and files.
+static Spinlock<LockRank::None> s_watch_lock {};
+
+EpollWatch::EpollWatch(Epoll& epoll, OpenFileDescription& description, int fd, epoll_event const& event)
+    : epoll(epoll)
+    , description(&description)
+    , blocker_set(description.blocker_set())
+    , fd(fd)
+    , events(event.events)
+    , data(event.data.u64)
+{
+}
+
+ErrorOr<NonnullLockRefPtr<Epoll>> Epoll::try_create()
+{
+    return adopt_nonnull_lock_ref_or_enomem(new (nothrow) Epoll);
+}
+
+Epoll::~Epoll()
+{
+    (void)close();
+}
+
+bool Epoll::can_read(OpenFileDescription const&, u64) const
+{
+    return m_ready_watch_count.load(AK::MemoryOrder::memory_order_relaxed) != 0;
+}
+
+ErrorOr<void> Epoll::close()
+{
+    MutexLocker locker(m_watches_lock);
+    {
+        SpinlockLocker lock(s_watch_lock);
+        for (auto& it : m_watches)
+            unregister_watch(*it.value);
+    }
+    m_watches.clear();
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<KString>> Epoll::pseudo_path(OpenFileDescription const&) const
+{
+    MutexLocker locker(m_watches_lock);
+    return KString::formatted("Epoll:({})", m_watches.size());
+}
+
+bool Epoll::mark_watch_ready(EpollWatch& watch)
+{
+    VERIFY(s_watch_lock.is_locked());
+    if (!watch.is_registered() || watch.is_disabled || watch.ready_list_node.is_in_list())
+        return false;
+    m_ready_watches.append(watch);
+    m_ready_watch_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    return true;
+}
+
+void Epoll::unregister_watch(EpollWatch& watch)
+{
+    VERIFY(s_watch_lock.is_locked());
+    if (!watch.is_registered())
+        return;
+    watch.description = nullptr;
+    watch.blocker_set.m_epoll_watches.remove(watch);
+    watch.blocker_set.m_epoll_watch_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+    if (watch.ready_list_node.is_in_list()) {
+        m_ready_watches.remove(watch);
+        m_ready_watch_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+    }
+}
+
+ErrorOr<void> Epoll::add_watch(int fd, OpenFileDescription& description, epoll_event const& event)
+{
+    auto watch = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) EpollWatch(*this, description, fd, event)));
+
+    MutexLocker locker(m_watches_lock);
+    if (auto it = m_watches.find(fd); it != m_watches.end()) {
+        SpinlockLocker lock(s_watch_lock);
+        if (it->value->description == &description)
+            return EEXIST;
+        // The watched description has been destroyed or closed, but the file descriptor has been reused.
+        unregister_watch(*it->value);
+    }
+    // NOTE: This replaces the stale watch, if any.
+    TRY(m_watches.try_set(fd, watch));
+
+    SpinlockLocker lock(s_watch_lock);
+    watch->blocker_set.m_epoll_watches.append(*watch);
+    watch->blocker_set.m_epoll_watch_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+
+    // The description might already be ready, so the next wait should have a look at it.
+    if (mark_watch_ready(*watch))
+        blocker_set().unblock_all_blockers_whose_conditions_are_met();
+    return {};
+}
+
+ErrorOr<void> Epoll::modify_watch(int fd, OpenFileDescription& description, epoll_event const& event)
+{
+    MutexLocker locker(m_watches_lock);
+    auto it = m_watches.find(fd);
+    if (it == m_watches.end())
+        return ENOENT;
+    auto& watch = *it->value;
+
+    SpinlockLocker lock(s_watch_lock);
+    if (watch.description != &description) {
+        unregister_watch(watch);
+        lock.unlock();
+        m_watches.remove(it);
+        return ENOENT;
+    }
+
+    watch.events = event.events;
+    watch.data = event.data.u64;
+    watch.is_disabled = false;
+    if (mark_watch_ready(watch))
+        blocker_set().unblock_all_blockers_whose_conditions_are_met();
+    return {};
+}
+
+ErrorOr<void> Epoll::remove_watch(int fd, OpenFileDescription& description)
+{
+    MutexLocker locker(m_watches_lock);
+    auto it = m_watches.find(fd);
+    if (it == m_watches.end())
+        return ENOENT;
+    bool is_stale;
+    {
+        SpinlockLocker lock(s_watch_lock);
+        is_stale = it->value->description != &description;
+        unregister_watch(*it->value);
+    }
+    m_watches.remove(it);
+    if (is_stale)
+        return ENOENT;
+    return {};
+}
+
+static u32 ready_events(OpenFileDescription const& description, u32 events)
+{
+    using BlockFlags = Thread::FileBlocker::BlockFlags;
+    auto block_flags = BlockFlags::None;
+    if (events & EPOLLIN)
+        block_flags |= BlockFlags::Read;
+    if (events & EPOLLOUT)
+        block_flags |= BlockFlags::Write;
+
+    auto unblock_flags = description.should_unblock(block_flags);
+    u32 ready_events = 0;
+    if (has_flag(unblock_flags, BlockFlags::Read))
+        ready_events |= EPOLLIN;
+    if (has_flag(unblock_flags, BlockFlags::Write))
+        ready_events |= EPOLLOUT;
+    return ready_events;
+}
+
+ErrorOr<void> Epoll::collect_ready_events(Vector<epoll_event>& events, size_t max_events)
+{
+    struct Candidate {
+        NonnullRefPtr<EpollWatch> watch;
+        NonnullLockRefPtr<OpenFileDescription> description;
+        u32 events { 0 };
+        u32 ready_events { 0 };
+        u64 data { 0 };
+    };
+    Vector<Candidate> candidates;
+    TRY(candidates.try_ensure_capacity(max_events));
+    TRY(events.try_ensure_capacity(events.size() + max_events));
+
+    {
+        SpinlockLocker lock(s_watch_lock);
+        while (candidates.size() < max_events && !m_ready_watches.is_empty()) {
+            auto& watch = *m_ready_watches.take_first();
+            m_ready_watch_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+            // NOTE: The description may be in the middle of being destroyed, in which case it'll unregister this watch soon.
+            if (!watch.is_registered() || watch.is_disabled || !watch.description->try_ref())
+                continue;
+            candidates.unchecked_append({ watch, adopt_lock_ref(*watch.description), watch.events, 0, watch.data });
+        }
+    }
+
+    // NOTE: Files may take their own locks to figure out whether they're ready, so this is done without holding the watch lock.
+    for (auto& candidate : candidates)
+        candidate.ready_events = ready_events(*candidate.description, candidate.events);
+
+    SpinlockLocker lock(s_watch_lock);
+    for (auto& candidate : candidates) {
+        auto& watch = *candidate.watch;
+        if (candidate.ready_events == 0 || !watch.is_registered())
+            continue;
+        events.unchecked_append({ .events = candidate.ready_events, .data = { .u64 = candidate.data } });
+
+        if (watch.events & EPOLLONESHOT)
+            watch.is_disabled = true;
+        else if (!(watch.events & EPOLLET))
+            mark_watch_ready(watch);
+    }
+    return {};
+}
+
+void Epoll::notify_watches(Badge<FileBlockerSet>, FileBlockerSet& file_blocker_set)
+{
+    SpinlockLocker lock(s_watch_lock);
+    for (auto& watch : file_blocker_set.m_epoll_watches) {
+        auto& epoll = watch.epoll;
+        if (epoll.mark_watch_ready(watch))
+            epoll.blocker_set().unblock_all_blockers_whose_conditions_are_met();
+    }
+}
+
+void Epoll::unregister_description(Badge<OpenFileDescription>, OpenFileDescription& description)
+{
+    auto& file_blocker_set = description.blocker_set();
+    if (file_blocker_set.m_epoll_watch_count.load(AK::MemoryOrder::memory_order_relaxed) == 0)
+        return;
+
+    // NOTE: This leaves the watches in the interest sets of their epoll instances, which can't be changed
+    //       while holding the watch lock. They're dropped when their file descriptor is watched again or removed.
+    SpinlockLocker lock(s_watch_lock);
+    for (auto it = file_blocker_set.m_epoll_watches.begin(); it != file_blocker_set.m_epoll_watches.end();) {
+        auto& watch = *it;
+        ++it;
+        if (watch.description == &description)
+            watch.epoll.unregister_watch(watch);
+    }
+}
+
+}
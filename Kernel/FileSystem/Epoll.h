@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/HashMap.h>
+#include <AK/RefPtr.h>
+#include <Kernel/FileSystem/EpollWatch.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/UnixTypes.h>
+
+namespace Kernel {
+
+// Epoll keeps a persistent set of file descriptions a process is interested in, and a list of those
+// whose readiness may have changed since they were last looked at. Files notify their watches
+// whenever they evaluate their block conditions, so waiting only has to look at the descriptions
+// on the ready list instead of every description in the interest set.
+class Epoll final : public File {
+public:
+    static ErrorOr<NonnullLockRefPtr<Epoll>> try_create();
+    virtual ~Epoll() override;
+
+    static constexpr size_t max_events_per_wait = 1024;
+
+    virtual bool can_read(OpenFileDescription const&, u64) const override;
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+    virtual ErrorOr<void> close() override;
+
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "Epoll"sv; }
+    virtual bool is_epoll() const override { return true; }
+
+    ErrorOr<void> add_watch(int fd, OpenFileDescription&, epoll_event const&);
+    ErrorOr<void> modify_watch(int fd, OpenFileDescription&, epoll_event const&);
+    ErrorOr<void> remove_watch(int fd, OpenFileDescription&);
+
+    // Appends the events of up to max_events ready watches. Level-triggered watches that are
+    // still ready are put back on the ready list, so they're reported again by the next wait.
+    ErrorOr<void> collect_ready_events(Vector<epoll_event>&, size_t max_events);
+
+    static void notify_watches(Badge<FileBlockerSet>, FileBlockerSet&);
+    static void unregister_description(Badge<OpenFileDescription>, OpenFileDescription&);
+
+private:
+    Epoll() = default;
+
+    bool mark_watch_ready(EpollWatch&);
+    void unregister_watch(EpollWatch&);
+
+    // The interest set, keyed by file descriptor. Since it has to allocate, it's protected by its own mutex
+    // rather than by the watch lock. Watches of descriptions that have been destroyed stay in here until
+    // they're replaced or removed.
+    mutable Mutex m_watches_lock { "Epoll"sv };
+    HashMap<int, NonnullRefPtr<EpollWatch>> m_watches;
+    EpollWatch::ReadyList m_ready_watches;
+    Atomic<size_t> m_ready_watch_count { 0 };
+};
+
+}
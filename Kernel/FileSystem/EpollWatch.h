@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/IntrusiveList.h>
+#include <Kernel/Forward.h>
+#include <Kernel/UnixTypes.h>
+
+namespace Kernel {
+
+class FileBlockerSet;
+
+// The interest of an epoll instance in one open file description.
+// All members are protected by the global epoll watch lock.
+struct EpollWatch : public AtomicRefCounted<EpollWatch> {
+    EpollWatch(Epoll&, OpenFileDescription&, int fd, epoll_event const&);
+
+    bool is_registered() const { return description != nullptr; }
+
+    Epoll& epoll;
+    // Cleared when the watch is removed, or when the description is destroyed.
+    OpenFileDescription* description { nullptr };
+    FileBlockerSet& blocker_set;
+    int fd { -1 };
+    u32 events { 0 };
+    u64 data { 0 };
+    bool is_disabled { false };
+
+    // NOTE: These are intrusive so that registering a watch doesn't have to allocate while holding the watch lock.
+    IntrusiveListNode<EpollWatch> blocker_set_list_node;
+    using BlockerSetList = IntrusiveList<&EpollWatch::blocker_set_list_node>;
+
+    IntrusiveListNode<EpollWatch> ready_list_node;
+    using ReadyList = IntrusiveList<&EpollWatch::ready_list_node>;
+};
+
+}
@@ -588,6 +588,74 @@ ErrorOr<size_t> Ext2FSInode::read_bytes_locked(off_t offset, size_t count, UserO
     return nread;
 }
 
+bool Ext2FSInode::uses_page_cache() const
+{
+    // Blocks are transferred straight to and from the pages, so they can't be any bigger than a page.
+    return Kernel::is_regular_file(m_raw_inode.i_mode) && m_raw_inode.i_links_count != 0 && fs().block_size() <= PAGE_SIZE;
+}
+
+// Calls back with runs of adjacent blocks (or holes) that back the given range, so each run can be
+// transferred with a single request.
+template<typename Callback>
+ErrorOr<void> Ext2FSInode::for_each_block_run(u64 offset, u64 count, Callback callback) const
+{
+    u64 const block_size = fs().block_size();
+    auto first_logical_index = offset / block_size;
+    auto end_logical_index = min<u64>(ceil_div(offset + count, block_size), m_block_list.size());
+
+    for (auto logical_index = first_logical_index; logical_index < end_logical_index;) {
+        auto first_block_index = m_block_list[logical_index];
+        size_t run_length = 1;
+        while (logical_index + run_length < end_logical_index) {
+            auto block_index = m_block_list[logical_index + run_length];
+            bool is_adjacent = first_block_index.value() == 0 ? block_index.value() == 0 : block_index.value() == first_block_index.value() + run_length;
+            if (!is_adjacent)
+                break;
+            ++run_length;
+        }
+        TRY(callback(first_block_index, run_length, (logical_index - first_logical_index) * block_size));
+        logical_index += run_length;
+    }
+    return {};
+}
+
+ErrorOr<size_t> Ext2FSInode::read_bytes_for_page_cache(u64 offset, size_t count, UserOrKernelBuffer& buffer) const
+{
+    VERIFY(m_inode_lock.is_locked());
+    u64 const block_size = fs().block_size();
+    VERIFY(offset % block_size == 0 && count % block_size == 0);
+    if (offset >= size())
+        return 0;
+    size_t nread = min<u64>(count, size() - offset);
+
+    TRY(const_cast<Ext2FSInode&>(*this).compute_block_list_with_exclusive_locking());
+    TRY(for_each_block_run(offset, nread, [&](BlockBasedFileSystem::BlockIndex first_block_index, size_t block_count, size_t offset_into_buffer) -> ErrorOr<void> {
+        auto buffer_offset = buffer.offset(offset_into_buffer);
+        // This is a hole, act as if it's filled with zeroes.
+        if (first_block_index.value() == 0)
+            return buffer_offset.memset(0, block_count * block_size);
+        return fs().read_blocks_uncached(first_block_index, block_count, buffer_offset);
+    }));
+    return nread;
+}
+
+ErrorOr<void> Ext2FSInode::write_bytes_for_page_cache(u64 offset, size_t count, UserOrKernelBuffer const& data)
+{
+    VERIFY(m_inode_lock.is_locked());
+    VERIFY(offset % fs().block_size() == 0);
+    VERIFY(offset + count <= size());
+
+    TRY(compute_block_list_with_exclusive_locking());
+    return for_each_block_run(offset, count, [&](BlockBasedFileSystem::BlockIndex first_block_index, size_t block_count, size_t offset_into_buffer) -> ErrorOr<void> {
+        // FIXME: Allocate blocks for holes. We never create any ourselves, but other implementations do.
+        if (first_block_index.value() == 0) {
+            dmesgln("Ext2FSInode[{}]::write_bytes_for_page_cache(): Can't write to a hole", identifier());
+            return EIO;
+        }
+        return fs().write_blocks_uncached(first_block_index, block_count, data.offset(offset_into_buffer));
+    });
+}
+
 ErrorOr<void> Ext2FSInode::resize(u64 new_size)
 {
     auto old_size = size();
@@ -644,6 +712,9 @@ ErrorOr<void> Ext2FSInode::resize(u64 new_size)
 
     set_metadata_dirty(true);
 
+    if (new_size < old_size)
+        truncate_page_cache(new_size);
+
     if (new_size > old_size) {
         // If we're growing the inode, make sure we zero out all the new space.
         // FIXME: There are definitely more efficient ways to achieve this.
@@ -651,7 +722,8 @@ ErrorOr<void> Ext2FSInode::resize(u64 new_size)
         auto clear_from = old_size;
         u8 zero_buffer[PAGE_SIZE] {};
         while (bytes_to_clear) {
-            auto nwritten = TRY(write_bytes(clear_from, min(static_cast<u64>(sizeof(zero_buffer)), bytes_to_clear), UserOrKernelBuffer::for_kernel_buffer(zero_buffer), nullptr));
+            // The page cache doesn't hold anything beyond the old size, so this can go straight to the file system.
+            auto nwritten = TRY(write_bytes_locked(clear_from, min(static_cast<u64>(sizeof(zero_buffer)), bytes_to_clear), UserOrKernelBuffer::for_kernel_buffer(zero_buffer), nullptr));
             VERIFY(nwritten != 0);
             bytes_to_clear -= nwritten;
             clear_from += nwritten;
@@ -1028,8 +1100,10 @@ ErrorOr<void> Ext2FSInode::decrement_link_count()
 
     --m_raw_inode.i_links_count;
     set_metadata_dirty(true);
-    if (m_raw_inode.i_links_count == 0)
+    if (m_raw_inode.i_links_count == 0) {
         did_delete_self();
+        drop_page_cache();
+    }
 
     if (ref_count() == 1 && m_raw_inode.i_links_count == 0)
         fs().uncache_inode(index());
@@ -44,6 +44,9 @@ private:
     virtual ErrorOr<void> chown(UserID, GroupID) override;
     virtual ErrorOr<void> truncate(u64) override;
     virtual ErrorOr<int> get_block_address(int) override;
+    virtual bool uses_page_cache() const override;
+    virtual ErrorOr<size_t> read_bytes_for_page_cache(u64 offset, size_t count, UserOrKernelBuffer&) const override;
+    virtual ErrorOr<void> write_bytes_for_page_cache(u64 offset, size_t count, UserOrKernelBuffer const&) override;
 
     ErrorOr<void> write_directory(Vector<Ext2FSDirectoryEntry>&);
     ErrorOr<void> populate_lookup_cache();
@@ -55,6 +58,9 @@ private:
     ErrorOr<void> shrink_triply_indirect_block(BlockBasedFileSystem::BlockIndex, size_t, size_t, unsigned&);
     ErrorOr<void> flush_block_list();
 
+    template<typename Callback>
+    ErrorOr<void> for_each_block_run(u64 offset, u64 count, Callback) const;
+
     ErrorOr<void> compute_block_list_with_exclusive_locking();
     ErrorOr<Vector<BlockBasedFileSystem::BlockIndex>> compute_block_list() const;
     ErrorOr<Vector<BlockBasedFileSystem::BlockIndex>> compute_block_list_with_meta_blocks() const;
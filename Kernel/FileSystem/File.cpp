@@ -6,6 +6,7 @@
 
 #include <AK/StringView.h>
 #include <AK/Userspace.h>
+#include <Kernel/FileSystem/Epoll.h>
 #include <Kernel/FileSystem/File.h>
 #include <Kernel/FileSystem/OpenFileDescription.h>
 #include <Kernel/Process.h>
@@ -50,4 +51,9 @@ void File::detach(OpenFileDescription&)
 {
     m_attach_count--;
 }
+
+void FileBlockerSet::notify_epoll_watches()
+{
+    Epoll::notify_watches({}, *this);
+}
 }
@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/AtomicRefCounted.h>
 #include <AK/Error.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
+#include <AK/Vector.h>
+#include <Kernel/FileSystem/EpollWatch.h>
 #include <Kernel/Forward.h>
 #include <Kernel/Library/LockWeakable.h>
 #include <Kernel/Library/NonnullLockRefPtr.h>
@@ -34,13 +37,26 @@ public:
 
     void unblock_all_blockers_whose_conditions_are_met()
     {
-        SpinlockLocker lock(m_lock);
-        BlockerSet::unblock_all_blockers_whose_conditions_are_met_locked([&](auto& b, void* data, bool&) {
-            VERIFY(b.blocker_type() == Thread::Blocker::Type::File);
-            auto& blocker = static_cast<Thread::FileBlocker&>(b);
-            return blocker.unblock_if_conditions_are_met(false, data);
-        });
+        {
+            SpinlockLocker lock(m_lock);
+            BlockerSet::unblock_all_blockers_whose_conditions_are_met_locked([&](auto& b, void* data, bool&) {
+                VERIFY(b.blocker_type() == Thread::Blocker::Type::File);
+                auto& blocker = static_cast<Thread::FileBlocker&>(b);
+                return blocker.unblock_if_conditions_are_met(false, data);
+            });
+        }
+        if (m_epoll_watch_count.load(AK::MemoryOrder::memory_order_relaxed) != 0)
+            notify_epoll_watches();
     }
+
+private:
+    friend class Epoll;
+
+    void notify_epoll_watches();
+
+    // NOTE: These are protected by the epoll watch lock, see Epoll.cpp.
+    EpollWatch::BlockerSetList m_epoll_watches;
+    Atomic<size_t> m_epoll_watch_count { 0 };
 };
 
 // File is the base class for anything that can be referenced by a OpenFileDescription.
@@ -114,6 +130,8 @@ public:
     virtual bool is_character_device() const { return false; }
     virtual bool is_socket() const { return false; }
     virtual bool is_inode_watcher() const { return false; }
+    virtual bool is_epoll() const { return false; }
+    virtual bool is_io_ring() const { return false; }
 
     virtual bool is_regular_file() const { return false; }
 
@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <Kernel/FileSystem/IORing.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Memory/MemoryManager.h>
+#include <Kernel/Net/Socket.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+ErrorOr<NonnullLockRefPtr<IORing>> IORing::try_create(u32 submission_entries)
+{
+    if (submission_entries == 0 || submission_entries > IORING_MAX_ENTRIES || !is_power_of_two(submission_entries))
+        return EINVAL;
+
+    auto size = io_ring_mapping_size(submission_entries);
+    // One VMObject backs both the kernel region and the mapping of the process.
+    auto vmobject = TRY(Memory::AnonymousVMObject::try_create_with_size(size, AllocationStrategy::AllocateNow));
+    auto kernel_region = TRY(MM.allocate_kernel_region_with_vmobject(*vmobject, size, "IORing"sv, Memory::Region::Access::ReadWrite));
+    return adopt_nonnull_lock_ref_or_enomem(new (nothrow) IORing(submission_entries, move(vmobject), move(kernel_region)));
+}
+
+IORing::IORing(u32 submission_entries, NonnullLockRefPtr<Memory::AnonymousVMObject> vmobject, NonnullOwnPtr<Memory::Region> kernel_region)
+    : m_submission_entries(submission_entries)
+    , m_completion_entries(io_ring_completion_entries(submission_entries))
+    , m_vmobject(move(vmobject))
+    , m_kernel_region(move(kernel_region))
+{
+}
+
+IORing::~IORing() = default;
+
+ErrorOr<NonnullLockRefPtr<Memory::VMObject>> IORing::vmobject_for_mmap(Process&, Memory::VirtualRange const& range, u64& offset, bool shared)
+{
+    if (!shared || offset != 0 || range.size() > m_vmobject->size())
+        return EINVAL;
+    return m_vmobject;
+}
+
+ErrorOr<NonnullOwnPtr<KString>> IORing::pseudo_path(OpenFileDescription const&) const
+{
+    return KString::formatted("IORing:({})", m_submission_entries);
+}
+
+IORingControl& IORing::control() const
+{
+    return *reinterpret_cast<IORingControl*>(m_kernel_region->vaddr().as_ptr());
+}
+
+IORingSubmission const& IORing::submission_at(u32 index) const
+{
+    auto* submissions = reinterpret_cast<IORingSubmission const*>(m_kernel_region->vaddr().offset(io_ring_submissions_offset()).as_ptr());
+    return submissions[index & (m_submission_entries - 1)];
+}
+
+IORingCompletion& IORing::completion_at(u32 index) const
+{
+    auto* completions = reinterpret_cast<IORingCompletion*>(m_kernel_region->vaddr().offset(io_ring_completions_offset(m_submission_entries)).as_ptr());
+    return completions[index & (m_completion_entries - 1)];
+}
+
+size_t IORing::completions_waiting_to_be_reaped() const
+{
+    auto head = AK::atomic_load(&control().completions.head, AK::MemoryOrder::memory_order_acquire);
+    return min(m_completion_tail - head, m_completion_entries);
+}
+
+void IORing::post_completion(u64 user_data, ErrorOr<FlatPtr> const& result)
+{
+    auto& completion = completion_at(m_completion_tail);
+    completion.user_data = user_data;
+    completion.result = result.is_error() ? -static_cast<i64>(result.error().code()) : static_cast<i64>(result.value());
+    ++m_completion_tail;
+    AK::atomic_store(&control().completions.tail, m_completion_tail, AK::MemoryOrder::memory_order_release);
+}
+
+ErrorOr<size_t> IORing::enter(Process& process, u32 to_submit, u32 min_complete, Optional<Time> deadline)
+{
+    MutexLocker locker(m_lock);
+
+    auto tail = AK::atomic_load(&control().submissions.tail, AK::MemoryOrder::memory_order_acquire);
+    auto submissions_available = tail - m_submission_head;
+    if (submissions_available > m_submission_entries)
+        return EINVAL;
+    to_submit = min(to_submit, submissions_available);
+    min_complete = min(min_complete, m_completion_entries);
+
+    retry_pending_operations(process);
+
+    size_t submitted = 0;
+    while (submitted < to_submit) {
+        // Every operation in flight is going to need a slot in the completion queue. If there's no room
+        // left, the remaining submissions stay in the queue until the process has reaped some completions.
+        if (completions_waiting_to_be_reaped() + m_pending_operations.size() >= m_completion_entries)
+            break;
+
+        // The process may still be scribbling over the entry, so it's copied before looking at any of its fields.
+        IORingSubmission submission;
+        memcpy(&submission, &submission_at(m_submission_head), sizeof(submission));
+        ++m_submission_head;
+        AK::atomic_store(&control().submissions.head, m_submission_head, AK::MemoryOrder::memory_order_release);
+        ++submitted;
+
+        submit(process, submission);
+    }
+
+    Thread::BlockTimeout timeout;
+    if (deadline.has_value())
+        timeout = Thread::BlockTimeout(true, &deadline.value());
+
+    while (completions_waiting_to_be_reaped() < min_complete && !m_pending_operations.is_empty()) {
+        m_wait_fds.clear_with_capacity();
+        TRY(m_wait_fds.try_ensure_capacity(m_pending_operations.size()));
+        for (auto& operation : m_pending_operations)
+            m_wait_fds.unchecked_append({ operation.description, operation.block_flags });
+
+        auto result = Thread::current()->block<Thread::SelectBlocker>(timeout, m_wait_fds);
+        m_wait_fds.clear_with_capacity();
+        if (result.was_interrupted()) {
+            if (submitted == 0)
+                return EINTR;
+            break;
+        }
+
+        retry_pending_operations(process);
+        if (result == Thread::BlockResult::InterruptedByTimeout)
+            break;
+    }
+
+    return submitted;
+}
+
+static BlockFlags block_flags_for(IORingSubmission const& submission)
+{
+    switch (submission.opcode) {
+    case IORingOpcode::Read:
+        return BlockFlags::Read;
+    case IORingOpcode::Write:
+        return BlockFlags::Write;
+    case IORingOpcode::Accept:
+        return BlockFlags::Accept;
+    case IORingOpcode::Connect:
+        return BlockFlags::Connect;
+    case IORingOpcode::Poll: {
+        auto block_flags = BlockFlags::None;
+        if (submission.flags & POLLIN)
+            block_flags |= BlockFlags::Read;
+        if (submission.flags & POLLOUT)
+            block_flags |= BlockFlags::Write;
+        return block_flags;
+    }
+    default:
+        return BlockFlags::None;
+    }
+}
+
+void IORing::submit(Process& process, IORingSubmission const& submission)
+{
+    if (submission.opcode == IORingOpcode::Nop) {
+        post_completion(submission.user_data, 0);
+        return;
+    }
+
+    auto description_or_error = process.open_file_description(submission.fd);
+    if (description_or_error.is_error()) {
+        post_completion(submission.user_data, description_or_error.release_error());
+        return;
+    }
+    auto description = description_or_error.release_value();
+    // The ring must not keep itself alive through one of its own operations.
+    if (description->is_io_ring()) {
+        post_completion(submission.user_data, EINVAL);
+        return;
+    }
+
+    // NOTE: Operations only make progress inside io_ring_enter(), so a connect() that waits for the connection
+    //       to be established would hold up every other operation in the ring. The description has to be
+    //       non-blocking, so that the connection is established in the background instead.
+    if (submission.opcode == IORingOpcode::Connect && description->is_blocking()) {
+        post_completion(submission.user_data, EAGAIN);
+        return;
+    }
+
+    auto result = start_operation(process, submission, *description);
+    auto block_flags = block_flags_for(submission);
+    if (!result.is_error() || result.error().code() != EAGAIN || block_flags == BlockFlags::None) {
+        post_completion(submission.user_data, result);
+        return;
+    }
+
+    if (auto append_result = m_pending_operations.try_append({ submission, move(description), block_flags }); append_result.is_error())
+        post_completion(submission.user_data, append_result.release_error());
+}
+
+void IORing::retry_pending_operations(Process& process)
+{
+    for (size_t i = 0; i < m_pending_operations.size();) {
+        auto& operation = m_pending_operations[i];
+        if (operation.description->should_unblock(operation.block_flags) == BlockFlags::None) {
+            ++i;
+            continue;
+        }
+
+        auto result = continue_operation(process, operation);
+        if (result.is_error() && result.error().code() == EAGAIN) {
+            // Someone else got to the file first.
+            ++i;
+            continue;
+        }
+        post_completion(operation.submission.user_data, result);
+        m_pending_operations.remove(i);
+    }
+}
+
+static ErrorOr<FlatPtr> read_from_description(OpenFileDescription& description, IORingSubmission const& submission)
+{
+    if (!description.is_readable())
+        return EBADF;
+    if (description.is_directory())
+        return EISDIR;
+    if (submission.length == 0)
+        return 0;
+    if (!description.can_read())
+        return EAGAIN;
+
+    auto buffer = TRY(UserOrKernelBuffer::for_user_buffer(Userspace<u8*> { static_cast<FlatPtr>(submission.address) }, submission.length));
+    if (submission.offset == IORING_CURRENT_OFFSET)
+        return TRY(description.read(buffer, submission.length));
+    if (!description.file().is_seekable() || submission.offset > static_cast<u64>(NumericLimits<off_t>::max()))
+        return EINVAL;
+    return TRY(description.read(buffer, submission.offset, submission.length));
+}
+
+static ErrorOr<FlatPtr> write_to_description(OpenFileDescription& description, IORingSubmission const& submission)
+{
+    if (!description.is_writable())
+        return EBADF;
+    if (submission.length == 0)
+        return 0;
+    if (!description.can_write())
+        return EAGAIN;
+
+    auto buffer = TRY(UserOrKernelBuffer::for_user_buffer(Userspace<u8 const*> { static_cast<FlatPtr>(submission.address) }, submission.length));
+    ErrorOr<size_t> result { 0 };
+    if (submission.offset == IORING_CURRENT_OFFSET) {
+        if (description.should_append() && description.file().is_seekable())
+            TRY(description.seek(0, SEEK_END));
+        result = description.write(buffer, submission.length);
+    } else {
+        if (!description.file().is_seekable() || submission.offset > static_cast<u64>(NumericLimits<off_t>::max()))
+            return EINVAL;
+        result = description.write(submission.offset, buffer, submission.length);
+    }
+
+    return TRY(result);
+}
+
+static ErrorOr<FlatPtr> accept_on_description(Process& process, OpenFileDescription& description, IORingSubmission const& submission)
+{
+    if (!description.is_socket())
+        return ENOTSOCK;
+    if (submission.flags & ~(SOCK_NONBLOCK | SOCK_CLOEXEC))
+        return EINVAL;
+    auto& socket = *description.socket();
+    if (!socket.can_accept())
+        return EAGAIN;
+
+    // The descriptor is allocated first, so running out of them doesn't lose the connection.
+    auto fd_allocation = TRY(process.allocate_fd());
+    auto accepted_socket = socket.accept();
+    if (!accepted_socket)
+        return EAGAIN;
+
+    if (submission.address) {
+        sockaddr_un address_buffer {};
+        socklen_t address_size = min(sizeof(sockaddr_un), static_cast<size_t>(submission.length));
+        accepted_socket->get_peer_address(reinterpret_cast<sockaddr*>(&address_buffer), &address_size);
+        TRY(copy_to_user(Userspace<sockaddr*> { static_cast<FlatPtr>(submission.address) }, &address_buffer, min(address_size, submission.length)));
+    }
+
+    auto accepted_socket_description = TRY(OpenFileDescription::try_create(*accepted_socket));
+    accepted_socket_description->set_readable(true);
+    accepted_socket_description->set_writable(true);
+    if (submission.flags & SOCK_NONBLOCK)
+        accepted_socket_description->set_blocking(false);
+    int fd_flags = 0;
+    if (submission.flags & SOCK_CLOEXEC)
+        fd_flags |= FD_CLOEXEC;
+
+    TRY(process.fds().with_exclusive([&](auto& fds) -> ErrorOr<void> {
+        fds[fd_allocation.fd].set(move(accepted_socket_description), fd_flags);
+        return {};
+    }));
+
+    // NOTE: Moving this state to Completed is what causes connect() to unblock on the client side.
+    accepted_socket->set_setup_state(Socket::SetupState::Completed);
+    return fd_allocation.fd;
+}
+
+static ErrorOr<FlatPtr> connect_on_description(Process& process, OpenFileDescription& description, IORingSubmission const& submission)
+{
+    if (!description.is_socket())
+        return ENOTSOCK;
+    auto& socket = *description.socket();
+    if (socket.domain() == AF_INET)
+        TRY(process.require_promise(Pledge::inet));
+    else if (socket.domain() == AF_LOCAL)
+        TRY(process.require_promise(Pledge::unix));
+
+    auto result = socket.connect(process.credentials(), description, Userspace<sockaddr const*> { static_cast<FlatPtr>(submission.address) }, submission.length);
+    if (result.is_error() && result.error().code() == EINPROGRESS)
+        return EAGAIN;
+    TRY(result);
+    return 0;
+}
+
+static ErrorOr<FlatPtr> poll_description(OpenFileDescription& description, IORingSubmission const& submission)
+{
+    auto block_flags = block_flags_for(submission);
+    if (block_flags == BlockFlags::None)
+        return EINVAL;
+
+    auto unblocked_flags = description.should_unblock(block_flags);
+    if (unblocked_flags == BlockFlags::None)
+        return EAGAIN;
+
+    FlatPtr revents = 0;
+    if (has_flag(unblocked_flags, BlockFlags::Read))
+        revents |= POLLIN;
+    if (has_flag(unblocked_flags, BlockFlags::Write))
+        revents |= POLLOUT;
+    return revents;
+}
+
+ErrorOr<FlatPtr> IORing::start_operation(Process& process, IORingSubmission const& submission, OpenFileDescription& description)
+{
+    switch (submission.opcode) {
+    case IORingOpcode::Read:
+        return read_from_description(description, submission);
+    case IORingOpcode::Write:
+        return write_to_description(description, submission);
+    case IORingOpcode::Accept:
+        TRY(process.require_promise(Pledge::accept));
+        return accept_on_description(process, description, submission);
+    case IORingOpcode::Connect:
+        return connect_on_description(process, description, submission);
+    case IORingOpcode::Poll:
+        return poll_description(description, submission);
+    case IORingOpcode::Fsync:
+        TRY(description.sync());
+        return 0;
+    default:
+        return EINVAL;
+    }
+}
+
+ErrorOr<FlatPtr> IORing::continue_operation(Process& process, PendingOperation& operation)
+{
+    if (operation.submission.opcode != IORingOpcode::Connect)
+        return start_operation(process, operation.submission, *operation.description);
+
+    // The connection attempt has already been started, and has now either succeeded or failed.
+    auto& socket = *operation.description->socket();
+    if (!socket.is_connected())
+        return ECONNREFUSED;
+    return 0;
+}
+
+}
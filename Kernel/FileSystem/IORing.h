@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Time.h>
+#include <Kernel/API/IORing.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Library/NonnullLockRefPtr.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/Memory/AnonymousVMObject.h>
+#include <Kernel/Thread.h>
+
+namespace Kernel {
+
+// An IORing lets a process submit many operations with a single syscall, and reap their completions
+// the same way. The queues live in memory that is mapped both into the kernel and into the process.
+// Operations are carried out while the process is inside io_ring_enter(). Those whose file isn't ready
+// yet wait in the ring, and complete in the same or a later io_ring_enter() once the file has become ready.
+class IORing final : public File {
+public:
+    static ErrorOr<NonnullLockRefPtr<IORing>> try_create(u32 submission_entries);
+    virtual ~IORing() override;
+
+    virtual bool can_read(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+    virtual ErrorOr<NonnullLockRefPtr<Memory::VMObject>> vmobject_for_mmap(Process&, Memory::VirtualRange const&, u64& offset, bool shared) override;
+
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "IORing"sv; }
+    virtual bool is_io_ring() const override { return true; }
+
+    // Consumes up to `to_submit` submissions, then waits until at least `min_complete` completions are
+    // waiting to be reaped, or until the timeout expires. Returns the number of consumed submissions.
+    ErrorOr<size_t> enter(Process&, u32 to_submit, u32 min_complete, Optional<Time> deadline);
+
+private:
+    struct PendingOperation {
+        IORingSubmission submission;
+        NonnullLockRefPtr<OpenFileDescription> description;
+        Thread::FileBlocker::BlockFlags block_flags;
+    };
+
+    IORing(u32 submission_entries, NonnullLockRefPtr<Memory::AnonymousVMObject>, NonnullOwnPtr<Memory::Region>);
+
+    IORingControl& control() const;
+    IORingSubmission const& submission_at(u32 index) const;
+    IORingCompletion& completion_at(u32 index) const;
+
+    size_t completions_waiting_to_be_reaped() const;
+    void post_completion(u64 user_data, ErrorOr<FlatPtr> const&);
+
+    void submit(Process&, IORingSubmission const&);
+    // These fail with EAGAIN if the operation has to wait for its file to become ready.
+    ErrorOr<FlatPtr> start_operation(Process&, IORingSubmission const&, OpenFileDescription&);
+    ErrorOr<FlatPtr> continue_operation(Process&, PendingOperation&);
+    void retry_pending_operations(Process&);
+
+    u32 const m_submission_entries;
+    u32 const m_completion_entries;
+    NonnullLockRefPtr<Memory::AnonymousVMObject> m_vmobject;
+    NonnullOwnPtr<Memory::Region> m_kernel_region;
+
+    // A ring is driven by one thread at a time, which keeps it locked while waiting for completions.
+    Mutex m_lock { "IORing"sv };
+    // These are the authoritative copies of the indices the kernel advances, as the process could change the shared ones.
+    u32 m_submission_head { 0 };
+    u32 m_completion_tail { 0 };
+    Vector<PendingOperation> m_pending_operations;
+    // Only used while waiting, but kept here as it is too large for the kernel stack.
+    Thread::SelectBlocker::FDVector m_wait_fds;
+};
+
+}
@@ -31,6 +31,8 @@ SpinlockProtected<Inode::AllInstancesList, LockRank::None>& Inode::all_instances
 
 void Inode::sync_all()
 {
+    Memory::SharedInodeVMObject::write_back_all_page_caches();
+
     NonnullLockRefPtrVector<Inode, 32> inodes;
     Inode::all_instances().with([&](auto& all_inodes) {
         for (auto& inode : all_inodes) {
@@ -47,6 +49,10 @@ void Inode::sync_all()
 
 void Inode::sync()
 {
+    if (auto page_cache = shared_vmobject()) {
+        MutexLocker locker(m_inode_lock, Mutex::Mode::Shared);
+        (void)page_cache->write_back_dirty_pages();
+    }
     if (is_metadata_dirty())
         (void)flush_metadata();
     fs().flush_writes();
@@ -110,13 +116,72 @@ ErrorOr<size_t> Inode::write_bytes(off_t offset, size_t length, UserOrKernelBuff
 {
     MutexLocker locker(m_inode_lock);
     TRY(prepare_to_write_data());
-    return write_bytes_locked(offset, length, target_buffer, open_description);
+    if (!uses_page_cache())
+        return write_bytes_locked(offset, length, target_buffer, open_description);
+
+    VERIFY(offset >= 0);
+    // Writes that grow the file go straight to the file system, which has to allocate blocks for them anyway.
+    // So do O_DIRECT writes, of course.
+    if ((open_description && open_description->is_direct()) || static_cast<u64>(offset) + length > size()) {
+        auto nwritten = TRY(write_bytes_locked(offset, length, target_buffer, open_description));
+        if (auto page_cache = shared_vmobject())
+            TRY(page_cache->update_pages(offset, nwritten, target_buffer));
+        return nwritten;
+    }
+
+    if (length == 0)
+        return 0;
+    auto page_cache = TRY(Memory::SharedInodeVMObject::try_create_with_inode(*this));
+    page_cache->mark_as_recently_used();
+    auto nwritten = TRY(page_cache->write_bytes(offset, length, target_buffer));
+    did_modify_contents();
+    return nwritten;
 }
 
 ErrorOr<size_t> Inode::read_bytes(off_t offset, size_t length, UserOrKernelBuffer& buffer, OpenFileDescription* open_description) const
 {
     MutexLocker locker(m_inode_lock, Mutex::Mode::Shared);
-    return read_bytes_locked(offset, length, buffer, open_description);
+    if (!uses_page_cache())
+        return read_bytes_locked(offset, length, buffer, open_description);
+
+    VERIFY(offset >= 0);
+    if (open_description && open_description->is_direct()) {
+        // O_DIRECT reads bypass the page cache, but they still have to see what has been written to it.
+        if (auto page_cache = shared_vmobject())
+            TRY(page_cache->write_back_dirty_pages(offset / PAGE_SIZE, ceil_div(offset % PAGE_SIZE + length, static_cast<size_t>(PAGE_SIZE))));
+        return read_bytes_locked(offset, length, buffer, open_description);
+    }
+
+    u64 file_size = size();
+    if (static_cast<u64>(offset) >= file_size)
+        return 0;
+    auto page_cache = TRY(Memory::SharedInodeVMObject::try_create_with_inode(const_cast<Inode&>(*this)));
+    page_cache->mark_as_recently_used();
+    auto nread = TRY(page_cache->read_bytes(offset, min<u64>(length, file_size - offset), buffer));
+
+    if (open_description) {
+        if (auto read_ahead_range = open_description->update_read_ahead(offset, nread); read_ahead_range.has_value() && read_ahead_range->offset < file_size)
+            page_cache->read_ahead(read_ahead_range->offset, min(read_ahead_range->size, file_size - read_ahead_range->offset));
+    }
+    return nread;
+}
+
+void Inode::truncate_page_cache(u64 size)
+{
+    VERIFY(m_inode_lock.is_exclusively_locked_by_current_thread());
+    if (auto page_cache = shared_vmobject())
+        page_cache->truncate(size);
+}
+
+void Inode::drop_page_cache()
+{
+    VERIFY(m_inode_lock.is_locked());
+    auto page_cache = shared_vmobject();
+    if (!page_cache)
+        return;
+    if (auto result = page_cache->write_back_dirty_pages(); result.is_error())
+        dmesgln("Inode[{}]: Failed to write back the page cache: {}", identifier(), result.error());
+    page_cache->remove_from_recently_used();
 }
 
 ErrorOr<void> Inode::update_timestamps([[maybe_unused]] Optional<Time> atime, [[maybe_unused]] Optional<Time> ctime, [[maybe_unused]] Optional<Time> mtime)
@@ -134,13 +199,6 @@ ErrorOr<void> Inode::decrement_link_count()
     return ENOTIMPL;
 }
 
-ErrorOr<void> Inode::set_shared_vmobject(Memory::SharedInodeVMObject& vmobject)
-{
-    MutexLocker locker(m_inode_lock);
-    m_shared_vmobject = TRY(vmobject.try_make_weak_ptr<Memory::SharedInodeVMObject>());
-    return {};
-}
-
 LockRefPtr<LocalSocket> Inode::bound_socket() const
 {
     return m_bound_socket.strong_ref();
@@ -268,7 +326,7 @@ ErrorOr<void> Inode::prepare_to_write_data()
 
 LockRefPtr<Memory::SharedInodeVMObject> Inode::shared_vmobject() const
 {
-    MutexLocker locker(m_inode_lock);
+    MutexLocker locker(m_shared_vmobject_lock);
     return m_shared_vmobject.strong_ref();
 }
 
@@ -33,6 +33,7 @@ class Inode : public ListedRefCounted<Inode, LockType::Spinlock>
     friend class VirtualFileSystem;
     friend class FileSystem;
     friend class InodeFile;
+    friend class Memory::SharedInodeVMObject;
 
 public:
     virtual ~Inode();
@@ -91,7 +92,6 @@ public:
 
     void will_be_destroyed();
 
-    ErrorOr<void> set_shared_vmobject(Memory::SharedInodeVMObject&);
     LockRefPtr<Memory::SharedInodeVMObject> shared_vmobject() const;
 
     static void sync_all();
@@ -125,11 +125,23 @@ protected:
     virtual ErrorOr<size_t> write_bytes_locked(off_t, size_t, UserOrKernelBuffer const& data, OpenFileDescription*) = 0;
     virtual ErrorOr<size_t> read_bytes_locked(off_t, size_t, UserOrKernelBuffer& buffer, OpenFileDescription*) const = 0;
 
+    // Inodes that use the page cache have read() and write() served from the pages of their shared VMObject,
+    // which are filled and written back by the following. Offsets are page aligned, and the file system
+    // should bypass any caches of its own, so that the data isn't cached twice.
+    virtual bool uses_page_cache() const { return false; }
+    virtual ErrorOr<size_t> read_bytes_for_page_cache(u64, size_t, UserOrKernelBuffer&) const { return ENOTSUP; }
+    virtual ErrorOr<void> write_bytes_for_page_cache(u64, size_t, UserOrKernelBuffer const&) { return ENOTSUP; }
+
+    void truncate_page_cache(u64 size);
+    // Writes back the page cache and stops keeping it around, as it keeps the inode alive.
+    void drop_page_cache();
+
 private:
     ErrorOr<bool> try_apply_flock(Process const&, OpenFileDescription const&, flock const&);
 
     FileSystem& m_file_system;
     InodeIndex m_index { 0 };
+    mutable Mutex m_shared_vmobject_lock { "InodeSharedVMObject"sv };
     LockWeakPtr<Memory::SharedInodeVMObject> m_shared_vmobject;
     LockWeakPtr<LocalSocket> m_bound_socket;
     SpinlockProtected<HashTable<InodeWatcher*>, LockRank::None> m_watchers {};
@@ -9,7 +9,9 @@
 #include <Kernel/API/POSIX/errno.h>
 #include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/FileSystem/Custody.h>
+#include <Kernel/FileSystem/Epoll.h>
 #include <Kernel/FileSystem/FIFO.h>
+#include <Kernel/FileSystem/IORing.h>
 #include <Kernel/FileSystem/InodeFile.h>
 #include <Kernel/FileSystem/InodeWatcher.h>
 #include <Kernel/FileSystem/OpenFileDescription.h>
@@ -52,6 +54,7 @@ OpenFileDescription::OpenFileDescription(File& file)
 
 OpenFileDescription::~OpenFileDescription()
 {
+    Epoll::unregister_description({}, *this);
     m_file->detach(*this);
     if (is_fifo())
         static_cast<FIFO*>(m_file.ptr())->detach(fifo_direction());
@@ -323,6 +326,30 @@ InodeWatcher* OpenFileDescription::inode_watcher()
     return static_cast<InodeWatcher*>(m_file.ptr());
 }
 
+bool OpenFileDescription::is_epoll() const
+{
+    return m_file->is_epoll();
+}
+
+Epoll* OpenFileDescription::epoll()
+{
+    if (!is_epoll())
+        return nullptr;
+    return static_cast<Epoll*>(m_file.ptr());
+}
+
+bool OpenFileDescription::is_io_ring() const
+{
+    return m_file->is_io_ring();
+}
+
+IORing* OpenFileDescription::io_ring()
+{
+    if (!is_io_ring())
+        return nullptr;
+    return static_cast<IORing*>(m_file.ptr());
+}
+
 bool OpenFileDescription::is_master_pty() const
 {
     return m_file->is_master_pty();
@@ -489,6 +516,37 @@ bool OpenFileDescription::is_direct() const
     return m_state.with([](auto& state) { return state.direct; });
 }
 
+// The read-ahead window starts out small, and doubles every time the reader catches up with it.
+static constexpr u64 min_read_ahead_window = 16 * KiB;
+static constexpr u64 max_read_ahead_window = 512 * KiB;
+
+Optional<OpenFileDescription::ReadAheadRange> OpenFileDescription::update_read_ahead(u64 offset, size_t count)
+{
+    return m_state.with([&](auto& state) -> Optional<ReadAheadRange> {
+        auto end = offset + count;
+        bool is_sequential = offset == state.sequential_read_end;
+        state.sequential_read_end = end;
+
+        if (!is_sequential) {
+            state.read_ahead_end = 0;
+            state.read_ahead_window = 0;
+            return {};
+        }
+
+        // Wait until the reader has used up half of what was read ahead last time, so that there's
+        // always a read-ahead in flight without issuing a new one for every read.
+        if (state.read_ahead_end > end && state.read_ahead_end - end > state.read_ahead_window / 2)
+            return {};
+
+        state.read_ahead_window = state.read_ahead_window ? min(state.read_ahead_window * 2, max_read_ahead_window) : min_read_ahead_window;
+        auto read_ahead_start = max(end, state.read_ahead_end);
+        state.read_ahead_end = end + state.read_ahead_window;
+        if (read_ahead_start >= state.read_ahead_end)
+            return {};
+        return ReadAheadRange { read_ahead_start, state.read_ahead_end - read_ahead_start };
+    });
+}
+
 bool OpenFileDescription::is_directory() const
 {
     return m_state.with([](auto& state) { return state.is_directory; });
@@ -65,6 +65,14 @@ public:
 
     bool is_direct() const;
 
+    struct ReadAheadRange {
+        u64 offset { 0 };
+        u64 size { 0 };
+    };
+    // Keeps track of whether this file is being read sequentially, and if so, returns the part of the
+    // file that should be read ahead of a read of `count` bytes at `offset`.
+    Optional<ReadAheadRange> update_read_ahead(u64 offset, size_t count);
+
     bool is_directory() const;
 
     File& file() { return *m_file; }
@@ -82,6 +90,12 @@ public:
     InodeWatcher const* inode_watcher() const;
     InodeWatcher* inode_watcher();
 
+    bool is_epoll() const;
+    Epoll* epoll();
+
+    bool is_io_ring() const;
+    IORing* io_ring();
+
     bool is_master_pty() const;
     MasterPTY const* master_pty() const;
     MasterPTY* master_pty();
@@ -155,6 +169,9 @@ private:
         bool should_append : 1 { false };
         bool direct : 1 { false };
         FIFO::Direction fifo_direction : 2 { FIFO::Direction::Neither };
+        u64 sequential_read_end { 0 };
+        u64 read_ahead_end { 0 };
+        u64 read_ahead_window { 0 };
     };
 
     SpinlockProtected<State, LockRank::None> m_state {};
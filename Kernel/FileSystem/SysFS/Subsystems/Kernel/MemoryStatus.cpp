@@ -37,6 +37,21 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     TRY(json.add("physical_uncommitted"sv, system_memory.physical_pages_uncommitted));
     TRY(json.add("kmalloc_call_count"sv, stats.kmalloc_call_count));
     TRY(json.add("kfree_call_count"sv, stats.kfree_call_count));
+
+    auto processors = TRY(json.add_array("kmalloc_processors"sv));
+    for (u32 processor_id = 0; processor_id < Processor::count(); ++processor_id) {
+        kmalloc_processor_stats processor_stats;
+        get_kmalloc_processor_stats(processor_id, processor_stats);
+        auto processor_object = TRY(processors.add_object());
+        TRY(processor_object.add("processor"sv, processor_id));
+        TRY(processor_object.add("kmalloc_call_count"sv, processor_stats.kmalloc_call_count));
+        TRY(processor_object.add("kfree_call_count"sv, processor_stats.kfree_call_count));
+        TRY(processor_object.add("slab_cache_hits"sv, processor_stats.slab_cache_hits));
+        TRY(processor_object.add("slab_cache_misses"sv, processor_stats.slab_cache_misses));
+        TRY(processor_object.add("slab_cache_flushes"sv, processor_stats.slab_cache_flushes));
+        TRY(processor_object.finish());
+    }
+    TRY(processors.finish());
     TRY(json.finish());
     return {};
 }
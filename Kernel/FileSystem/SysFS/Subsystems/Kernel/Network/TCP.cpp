@@ -41,6 +41,9 @@ ErrorOr<void> SysFSNetworkTCPStats::try_generate(KBufferBuilder& builder)
         TRY(obj.add("bytes_in"sv, socket.bytes_in()));
         TRY(obj.add("packets_out"sv, socket.packets_out()));
         TRY(obj.add("bytes_out"sv, socket.bytes_out()));
+        TRY(obj.add("congestion_control"sv, TCPCongestionControl::to_string(socket.congestion_control_algorithm())));
+        TRY(obj.add("congestion_window"sv, socket.congestion_window()));
+        TRY(obj.add("send_window"sv, socket.send_window_size()));
         auto current_process_credentials = Process::current().credentials();
         if (current_process_credentials->is_superuser() || current_process_credentials->uid() == socket.origin_uid()) {
             TRY(obj.add("origin_pid"sv, socket.origin_pid().value()));
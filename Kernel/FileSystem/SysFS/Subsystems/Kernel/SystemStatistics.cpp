@@ -34,6 +34,19 @@ ErrorOr<void> SysFSSystemStatistics::try_generate(KBufferBuilder& builder)
         idle_time += processor.time_spent_idle();
     });
     TRY(json.add("idle_time"sv, idle_time));
+
+    auto processors = TRY(json.add_array("processors"sv));
+    for (u32 processor_id = 0; processor_id < Processor::count(); ++processor_id) {
+        auto statistics = Scheduler::get_processor_scheduling_statistics(processor_id);
+        auto processor_object = TRY(processors.add_object());
+        TRY(processor_object.add("processor"sv, processor_id));
+        TRY(processor_object.add("context_switches"sv, statistics.context_switches));
+        TRY(processor_object.add("stolen_threads"sv, statistics.stolen_threads));
+        TRY(processor_object.add("migrated_threads"sv, statistics.migrated_threads));
+        TRY(processor_object.add("runnable_threads"sv, statistics.runnable_threads));
+        TRY(processor_object.finish());
+    }
+    TRY(processors.finish());
     TRY(json.finish());
     return {};
 }
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Variables/LoopbackPacketDropInterval.h>
+#include <Kernel/Net/LoopbackAdapter.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSLoopbackPacketDropInterval::SysFSLoopbackPacketDropInterval(SysFSDirectory const& parent_directory)
+    : SysFSSystemStringVariable(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullLockRefPtr<SysFSLoopbackPacketDropInterval> SysFSLoopbackPacketDropInterval::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_lock_ref_if_nonnull(new (nothrow) SysFSLoopbackPacketDropInterval(parent_directory)).release_nonnull();
+}
+
+ErrorOr<NonnullOwnPtr<KString>> SysFSLoopbackPacketDropInterval::value() const
+{
+    return KString::formatted("{}", LoopbackAdapter::packet_drop_interval());
+}
+
+ErrorOr<void> SysFSLoopbackPacketDropInterval::set_value(NonnullOwnPtr<KString> new_value)
+{
+    auto interval = new_value->view().to_uint();
+    if (!interval.has_value())
+        return EINVAL;
+    LoopbackAdapter::set_packet_drop_interval(interval.value());
+    return {};
+}
+
+mode_t SysFSLoopbackPacketDropInterval::permissions() const
+{
+    // NOTE: Dropping packets affects everyone using the loopback adapter, so only root gets to do this.
+    return S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+}
+
+}
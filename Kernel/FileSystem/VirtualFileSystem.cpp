@@ -163,6 +163,9 @@ ErrorOr<void> VirtualFileSystem::unmount(Custody& mountpoint_custody)
     auto custody_path = TRY(mountpoint_custody.try_serialize_absolute_path());
     dbgln("VirtualFileSystem: unmount called with inode {} on mountpoint {}", guest_inode.identifier(), custody_path->view());
 
+    // The page caches of recently used files keep their inodes alive, which would keep the file system busy.
+    TRY(Memory::SharedInodeVMObject::remove_page_caches_of(guest_inode.fs()));
+
     return m_mounts.with([&](auto& mounts) -> ErrorOr<void> {
         for (auto& mount : mounts) {
             if (&mount.guest() != &guest_inode)
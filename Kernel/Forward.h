@@ -21,6 +21,7 @@ class Custody;
 class Device;
 class DiskCache;
 class DoubleBuffer;
+class Epoll;
 class File;
 class FATInode;
 class OpenFileDescription;
@@ -31,6 +32,7 @@ class IPv4Socket;
 class Inode;
 class InodeIdentifier;
 class InodeWatcher;
+class IORing;
 class Jail;
 class KBuffer;
 class KString;
@@ -10,6 +10,7 @@
 #include <Kernel/Debug.h>
 #include <Kernel/Heap/Heap.h>
 #include <Kernel/Heap/kmalloc.h>
+#include <Kernel/InterruptDisabler.h>
 #include <Kernel/KSyms.h>
 #include <Kernel/Locking/Spinlock.h>
 #include <Kernel/Memory/MemoryManager.h>
@@ -221,6 +222,24 @@ struct KmallocGlobalData {
         subheaps.append(*subheap);
     }
 
+    Optional<size_t> slabheap_index_for_allocation(size_t size, size_t alignment) const
+    {
+        for (size_t i = 0; i < slabheap_count; ++i) {
+            if (size <= slabheaps[i].slab_size() && alignment <= slabheaps[i].slab_size())
+                return i;
+        }
+        return {};
+    }
+
+    Optional<size_t> slabheap_index_for_deallocation(size_t size) const
+    {
+        for (size_t i = 0; i < slabheap_count; ++i) {
+            if (size <= slabheaps[i].slab_size())
+                return i;
+        }
+        return {};
+    }
+
     void* allocate(size_t size, size_t alignment, CallerWillInitializeMemory caller_will_initialize_memory)
     {
         VERIFY(!expansion_in_progress);
@@ -394,7 +413,8 @@ struct KmallocGlobalData {
 
     KmallocSubheap::List subheaps;
 
-    KmallocSlabheap slabheaps[6] = { 16, 32, 64, 128, 256, 512 };
+    static constexpr size_t slabheap_count = 6;
+    KmallocSlabheap slabheaps[slabheap_count] = { 16, 32, 64, 128, 256, 512 };
 
     bool expansion_in_progress { false };
 };
@@ -402,9 +422,29 @@ struct KmallocGlobalData {
 READONLY_AFTER_INIT static KmallocGlobalData* g_kmalloc_global;
 alignas(KmallocGlobalData) static u8 g_kmalloc_global_heap[sizeof(KmallocGlobalData)];
 
-static size_t g_kmalloc_call_count;
-static size_t g_kfree_call_count;
-static size_t g_nested_kfree_calls;
+// Every processor keeps a magazine of free slabs for each slabheap. Allocating or freeing a slab
+// only touches the current processor's magazine with interrupts disabled, so s_lock is only
+// taken to move half a magazine's worth of slabs from or to the slabheap at once.
+struct KmallocProcessorCache {
+    static constexpr size_t slabs_per_magazine = 32;
+
+    struct Magazine {
+        size_t slab_count { 0 };
+        void* slabs[slabs_per_magazine];
+    };
+
+    Magazine magazines[KmallocGlobalData::slabheap_count];
+
+    size_t kmalloc_call_count { 0 };
+    size_t kfree_call_count { 0 };
+    size_t nested_kfree_calls { 0 };
+    size_t slab_cache_hits { 0 };
+    size_t slab_cache_misses { 0 };
+    size_t slab_cache_flushes { 0 };
+};
+
+static KmallocProcessorCache s_processor_caches[MAX_CPU_COUNT];
+
 bool g_dump_kmalloc_stacks;
 
 void kmalloc_enable_expand()
@@ -421,6 +461,56 @@ UNMAP_AFTER_INIT void kmalloc_init()
     s_lock.initialize();
 }
 
+static void* allocate_from_magazine(KmallocProcessorCache& processor_cache, size_t slabheap_index, CallerWillInitializeMemory caller_will_initialize_memory)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    auto& magazine = processor_cache.magazines[slabheap_index];
+    auto& slabheap = g_kmalloc_global->slabheaps[slabheap_index];
+
+    if (magazine.slab_count == 0) {
+        ++processor_cache.slab_cache_misses;
+        SpinlockLocker lock(s_lock);
+        // Only fill the magazine halfway, so that freeing these slabs again doesn't immediately overflow it.
+        while (magazine.slab_count < KmallocProcessorCache::slabs_per_magazine / 2) {
+            auto* slab = slabheap.allocate(CallerWillInitializeMemory::Yes);
+            if (!slab)
+                break;
+            magazine.slabs[magazine.slab_count++] = slab;
+        }
+        if (magazine.slab_count == 0)
+            return nullptr;
+    } else {
+        ++processor_cache.slab_cache_hits;
+    }
+
+    auto* ptr = magazine.slabs[--magazine.slab_count];
+    if (caller_will_initialize_memory == CallerWillInitializeMemory::No)
+        memset(ptr, KMALLOC_SCRUB_BYTE, slabheap.slab_size());
+    return ptr;
+}
+
+static void deallocate_to_magazine(KmallocProcessorCache& processor_cache, size_t slabheap_index, void* ptr)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    auto& magazine = processor_cache.magazines[slabheap_index];
+    auto& slabheap = g_kmalloc_global->slabheaps[slabheap_index];
+
+    memset(ptr, KFREE_SCRUB_BYTE, slabheap.slab_size());
+
+    if (magazine.slab_count == KmallocProcessorCache::slabs_per_magazine) {
+        ++processor_cache.slab_cache_flushes;
+        SpinlockLocker lock(s_lock);
+        // Give back the oldest half of the magazine, as the most recently freed slabs are the likeliest to still be in the cache.
+        constexpr size_t flush_count = KmallocProcessorCache::slabs_per_magazine / 2;
+        for (size_t i = 0; i < flush_count; ++i)
+            slabheap.deallocate(magazine.slabs[i]);
+        magazine.slab_count -= flush_count;
+        memmove(magazine.slabs, magazine.slabs + flush_count, magazine.slab_count * sizeof(void*));
+    }
+
+    magazine.slabs[magazine.slab_count++] = ptr;
+}
+
 static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMemory caller_will_initialize_memory)
 {
     // Catch bad callers allocating under spinlock.
@@ -431,16 +521,26 @@ static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMem
     // Alignment must be a power of two.
     VERIFY(is_power_of_two(alignment));
 
-    SpinlockLocker lock(s_lock);
-    ++g_kmalloc_call_count;
+    void* ptr = nullptr;
+    {
+        InterruptDisabler disabler;
+        auto& processor_cache = s_processor_caches[Processor::current_id()];
+        ++processor_cache.kmalloc_call_count;
+
+        if (g_dump_kmalloc_stacks && Kernel::g_kernel_symbols_available) {
+            SpinlockLocker lock(s_lock);
+            dbgln("kmalloc({})", size);
+            Kernel::dump_backtrace();
+        }
 
-    if (g_dump_kmalloc_stacks && Kernel::g_kernel_symbols_available) {
-        dbgln("kmalloc({})", size);
-        Kernel::dump_backtrace();
+        if (auto slabheap_index = g_kmalloc_global->slabheap_index_for_allocation(size, alignment); slabheap_index.has_value()) {
+            ptr = allocate_from_magazine(processor_cache, *slabheap_index, caller_will_initialize_memory);
+        } else {
+            SpinlockLocker lock(s_lock);
+            ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+        }
     }
 
-    void* ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
-
     Thread* current_thread = Thread::current();
     if (!current_thread)
         current_thread = Processor::idle_thread();
@@ -482,11 +582,12 @@ void kfree_sized(void* ptr, size_t size)
         Processor::verify_no_spinlocks_held();
     }
 
-    SpinlockLocker lock(s_lock);
-    ++g_kfree_call_count;
-    ++g_nested_kfree_calls;
+    InterruptDisabler disabler;
+    auto& processor_cache = s_processor_caches[Processor::current_id()];
+    ++processor_cache.kfree_call_count;
+    ++processor_cache.nested_kfree_calls;
 
-    if (g_nested_kfree_calls == 1) {
+    if (processor_cache.nested_kfree_calls == 1) {
         Thread* current_thread = Thread::current();
         if (!current_thread)
             current_thread = Processor::idle_thread();
@@ -496,8 +597,14 @@ void kfree_sized(void* ptr, size_t size)
         }
     }
 
-    g_kmalloc_global->deallocate(ptr, size);
-    --g_nested_kfree_calls;
+    if (auto slabheap_index = g_kmalloc_global->slabheap_index_for_deallocation(size); slabheap_index.has_value()) {
+        VERIFY(g_kmalloc_global->is_valid_kmalloc_address(VirtualAddress { ptr }));
+        deallocate_to_magazine(processor_cache, *slabheap_index, ptr);
+    } else {
+        SpinlockLocker lock(s_lock);
+        g_kmalloc_global->deallocate(ptr, size);
+    }
+    --processor_cache.nested_kfree_calls;
 }
 
 size_t kmalloc_good_size(size_t size)
@@ -584,6 +691,21 @@ void get_kmalloc_stats(kmalloc_stats& stats)
     SpinlockLocker lock(s_lock);
     stats.bytes_allocated = g_kmalloc_global->allocated_bytes();
     stats.bytes_free = g_kmalloc_global->free_bytes();
-    stats.kmalloc_call_count = g_kmalloc_call_count;
-    stats.kfree_call_count = g_kfree_call_count;
+    stats.kmalloc_call_count = 0;
+    stats.kfree_call_count = 0;
+    for (auto const& processor_cache : s_processor_caches) {
+        stats.kmalloc_call_count += processor_cache.kmalloc_call_count;
+        stats.kfree_call_count += processor_cache.kfree_call_count;
+    }
+}
+
+void get_kmalloc_processor_stats(u32 processor_id, kmalloc_processor_stats& stats)
+{
+    // NOTE: The counters are only ever updated by their own processor, so these may be slightly out of date.
+    auto const& processor_cache = s_processor_caches[processor_id];
+    stats.kmalloc_call_count = processor_cache.kmalloc_call_count;
+    stats.kfree_call_count = processor_cache.kfree_call_count;
+    stats.slab_cache_hits = processor_cache.slab_cache_hits;
+    stats.slab_cache_misses = processor_cache.slab_cache_misses;
+    stats.slab_cache_flushes = processor_cache.slab_cache_flushes;
 }
@@ -55,6 +55,15 @@ struct kmalloc_stats {
 };
 void get_kmalloc_stats(kmalloc_stats&);
 
+struct kmalloc_processor_stats {
+    size_t kmalloc_call_count;
+    size_t kfree_call_count;
+    size_t slab_cache_hits;
+    size_t slab_cache_misses;
+    size_t slab_cache_flushes;
+};
+void get_kmalloc_processor_stats(u32 processor_id, kmalloc_processor_stats&);
+
 extern bool g_dump_kmalloc_stacks;
 
 inline void* operator new(size_t, void* p) { return p; }
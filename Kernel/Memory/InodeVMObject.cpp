@@ -29,6 +29,7 @@ InodeVMObject::~InodeVMObject() = default;
 
 size_t InodeVMObject::amount_clean() const
 {
+    SpinlockLocker locker(m_lock);
     size_t count = 0;
     VERIFY(page_count() == m_dirty_pages.size());
     for (size_t i = 0; i < page_count(); ++i) {
@@ -40,6 +41,7 @@ size_t InodeVMObject::amount_clean() const
 
 size_t InodeVMObject::amount_dirty() const
 {
+    SpinlockLocker locker(m_lock);
     size_t count = 0;
     for (size_t i = 0; i < m_dirty_pages.size(); ++i) {
         if (m_dirty_pages.get(i))
@@ -468,14 +468,19 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
     auto& inode_vmobject = static_cast<InodeVMObject&>(vmobject());
 
     auto page_index_in_vmobject = translate_to_vmobject_page(page_index_in_region);
-    auto& vmobject_physical_page_slot = inode_vmobject.physical_pages()[page_index_in_vmobject];
+    // NOTE: The page array of an inode's page cache may be replaced with a bigger one when the file grows,
+    //       so the slot has to be looked up again every time the VMObject lock is taken.
+    auto vmobject_physical_page_slot = [&]() -> RefPtr<PhysicalPage>& {
+        VERIFY(inode_vmobject.m_lock.is_locked_by_current_processor());
+        return inode_vmobject.physical_pages()[page_index_in_vmobject];
+    };
 
     {
         // NOTE: The VMObject lock is required when manipulating the VMObject's physical page slot.
         SpinlockLocker locker(inode_vmobject.m_lock);
-        if (!vmobject_physical_page_slot.is_null()) {
+        if (auto& physical_page_slot = vmobject_physical_page_slot(); !physical_page_slot.is_null()) {
             dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else before reading, remapping.");
-            if (!remap_vmobject_page(page_index_in_vmobject, *vmobject_physical_page_slot))
+            if (!remap_vmobject_page(page_index_in_vmobject, *physical_page_slot))
                 return PageFaultResponse::OutOfMemory;
             return PageFaultResponse::Continue;
         }
@@ -509,6 +514,16 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
         memset(page_buffer + nread, 0, PAGE_SIZE - nread);
     }
 
+    {
+        // If this VMObject is the inode's page cache, reading from the inode already put the page in place.
+        SpinlockLocker locker(inode_vmobject.m_lock);
+        if (auto& physical_page_slot = vmobject_physical_page_slot(); !physical_page_slot.is_null()) {
+            if (!remap_vmobject_page(page_index_in_vmobject, *physical_page_slot))
+                return PageFaultResponse::OutOfMemory;
+            return PageFaultResponse::Continue;
+        }
+    }
+
     // Allocate a new physical page, and copy the read inode contents into it.
     auto new_physical_page_or_error = MM.allocate_physical_page(MemoryManager::ShouldZeroFill::No);
     if (new_physical_page_or_error.is_error()) {
@@ -527,19 +542,20 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region)
         // NOTE: The VMObject lock is required when manipulating the VMObject's physical page slot.
         SpinlockLocker locker(inode_vmobject.m_lock);
 
-        if (!vmobject_physical_page_slot.is_null()) {
+        auto& physical_page_slot = vmobject_physical_page_slot();
+        if (!physical_page_slot.is_null()) {
             // Someone else faulted in this page while we were reading from the inode.
             // No harm done (other than some duplicate work), remap the page here and return.
             dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else, remapping.");
-            if (!remap_vmobject_page(page_index_in_vmobject, *vmobject_physical_page_slot))
+            if (!remap_vmobject_page(page_index_in_vmobject, *physical_page_slot))
                 return PageFaultResponse::OutOfMemory;
             return PageFaultResponse::Continue;
         }
 
-        vmobject_physical_page_slot = new_physical_page;
+        physical_page_slot = new_physical_page;
     }
 
-    if (!remap_vmobject_page(page_index_in_vmobject, *vmobject_physical_page_slot))
+    if (!remap_vmobject_page(page_index_in_vmobject, *new_physical_page))
         return PageFaultResponse::OutOfMemory;
 
     return PageFaultResponse::Continue;
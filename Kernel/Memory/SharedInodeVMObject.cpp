@@ -4,12 +4,31 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Singleton.h>
 #include <Kernel/FileSystem/Inode.h>
+#include <Kernel/InterruptDisabler.h>
+#include <Kernel/KBuffer.h>
+#include <Kernel/Library/NonnullLockRefPtrVector.h>
 #include <Kernel/Locking/Spinlock.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Memory/SharedInodeVMObject.h>
+#include <Kernel/WorkQueue.h>
 
 namespace Kernel::Memory {
 
+static constexpr size_t max_recently_used_count = 256;
+// Pages are read from and written back to the inode this many at a time.
+static constexpr size_t max_pages_per_transfer = 16;
+static constexpr u32 max_pending_read_ahead_count = 4;
+
+struct RecentlyUsedPageCaches {
+    SharedInodeVMObject::RecentlyUsedList list;
+    size_t count { 0 };
+};
+
+static Singleton<SpinlockProtected<RecentlyUsedPageCaches, LockRank::None>> s_recently_used;
+static Atomic<u32> s_pending_read_ahead_count { 0 };
+
 ErrorOr<NonnullLockRefPtr<SharedInodeVMObject>> SharedInodeVMObject::try_create_with_inode(Inode& inode)
 {
     if (inode.size() == 0)
@@ -23,15 +42,43 @@ ErrorOr<NonnullLockRefPtr<SharedInodeVMObject>> SharedInodeVMObject::try_create_
     // on "smaller" VMObject than the requested Region, we simply take the max size between both values.
     auto size = max(inode.size(), (offset + range_size));
     VERIFY(size > 0);
-    if (auto shared_vmobject = inode.shared_vmobject())
-        return shared_vmobject.release_nonnull();
+
+    MutexLocker locker(inode.m_shared_vmobject_lock);
+    if (auto vmobject = inode.m_shared_vmobject.strong_ref()) {
+        if (vmobject->size() < size)
+            TRY(vmobject->grow(size));
+        return vmobject.release_nonnull();
+    }
+
     auto new_physical_pages = TRY(VMObject::try_create_physical_pages(size));
     auto dirty_pages = TRY(Bitmap::create(new_physical_pages.size(), false));
     auto vmobject = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) SharedInodeVMObject(inode, move(new_physical_pages), move(dirty_pages))));
-    TRY(vmobject->inode().set_shared_vmobject(*vmobject));
+    inode.m_shared_vmobject = TRY(vmobject->try_make_weak_ptr<SharedInodeVMObject>());
     return vmobject;
 }
 
+ErrorOr<void> SharedInodeVMObject::grow(size_t new_size)
+{
+    // The page cache has to grow along with its file. It's grown in place, so that the regions mapping it,
+    // the pages and their dirty state all stay where they are. Growing by at least a factor of two keeps
+    // appending to a file from copying the page array over and over.
+    new_size = max(new_size, size() * 2);
+    auto new_physical_pages = TRY(VMObject::try_create_physical_pages(new_size));
+    auto new_dirty_pages = TRY(Bitmap::create(new_physical_pages.size(), false));
+
+    // NOTE: Everyone indexes the page array while holding the VMObject lock, and indices that were computed
+    //       for the smaller size stay valid. The old arrays are freed after dropping the lock.
+    SpinlockLocker locker(m_lock);
+    VERIFY(new_physical_pages.size() > page_count());
+    for (size_t i = 0; i < page_count(); ++i) {
+        new_physical_pages[i] = move(m_physical_pages[i]);
+        new_dirty_pages.set(i, m_dirty_pages.get(i));
+    }
+    m_physical_pages.swap(new_physical_pages);
+    swap(m_dirty_pages, new_dirty_pages);
+    return {};
+}
+
 ErrorOr<NonnullLockRefPtr<VMObject>> SharedInodeVMObject::try_clone()
 {
     auto new_physical_pages = TRY(this->try_clone_physical_pages());
@@ -51,21 +98,389 @@ SharedInodeVMObject::SharedInodeVMObject(SharedInodeVMObject const& other, Fixed
 
 ErrorOr<void> SharedInodeVMObject::sync(off_t offset_in_pages, size_t pages)
 {
-    SpinlockLocker locker(m_lock);
+    if (static_cast<size_t>(offset_in_pages) >= page_count())
+        return {};
+    pages = min(pages, page_count() - offset_in_pages);
 
-    size_t highest_page_to_flush = min(page_count(), offset_in_pages + pages);
+    {
+        // Writes through shared mappings aren't tracked, so every page that is present may have been written to.
+        SpinlockLocker locker(m_lock);
+        for (size_t page_index = offset_in_pages; page_index < offset_in_pages + pages; ++page_index) {
+            if (m_physical_pages[page_index])
+                m_dirty_pages.set(page_index, true);
+        }
+    }
 
-    for (size_t page_index = offset_in_pages; page_index < highest_page_to_flush; ++page_index) {
-        auto& physical_page = m_physical_pages[page_index];
-        if (!physical_page)
-            continue;
+    MutexLocker locker(m_inode->m_inode_lock, Mutex::Mode::Shared);
+    return write_back_dirty_pages(offset_in_pages, pages);
+}
+
+ErrorOr<size_t> SharedInodeVMObject::read_bytes(u64 offset, size_t count, UserOrKernelBuffer& buffer)
+{
+    VERIFY(m_inode->m_inode_lock.is_locked());
+    VERIFY(offset + count <= size());
+    if (count == 0)
+        return 0;
+
+    auto first_page_index = offset / PAGE_SIZE;
+    auto last_page_index = (offset + count - 1) / PAGE_SIZE;
+    TRY(fill_pages(first_page_index, last_page_index - first_page_index + 1));
 
-        u8 page_buffer[PAGE_SIZE];
+    size_t nread = 0;
+    u8 page_buffer[PAGE_SIZE];
+    for (auto page_index = first_page_index; page_index <= last_page_index; ++page_index) {
+        size_t offset_in_page = page_index == first_page_index ? offset % PAGE_SIZE : 0;
+        size_t nbytes = min(PAGE_SIZE - offset_in_page, count - nread);
+        auto physical_page = TRY(ensure_page(page_index));
+        // The page can't stay mapped while copying it out, as writing to the buffer may page fault.
         MM.copy_physical_page(*physical_page, page_buffer);
+        TRY(buffer.write(page_buffer + offset_in_page, nread, nbytes));
+        nread += nbytes;
+    }
+    return nread;
+}
+
+ErrorOr<size_t> SharedInodeVMObject::write_bytes(u64 offset, size_t count, UserOrKernelBuffer const& data)
+{
+    VERIFY(m_inode->m_inode_lock.is_exclusively_locked_by_current_thread());
+    VERIFY(offset + count <= size());
+
+    size_t nwritten = 0;
+    u8 page_buffer[PAGE_SIZE];
+    while (nwritten < count) {
+        auto page_index = (offset + nwritten) / PAGE_SIZE;
+        size_t offset_in_page = (offset + nwritten) % PAGE_SIZE;
+        size_t nbytes = min(PAGE_SIZE - offset_in_page, count - nwritten);
+        // Reading the data may page fault, so it has to happen before the page is mapped.
+        TRY(data.read(page_buffer, nwritten, nbytes));
+        TRY(write_to_page(page_index, offset_in_page, { page_buffer, nbytes }, ShouldMarkDirty::Yes));
+        nwritten += nbytes;
+    }
+    return nwritten;
+}
+
+ErrorOr<void> SharedInodeVMObject::update_pages(u64 offset, size_t count, UserOrKernelBuffer const& data)
+{
+    VERIFY(m_inode->m_inode_lock.is_exclusively_locked_by_current_thread());
+    if (offset >= size())
+        return {};
+    count = min<u64>(count, size() - offset);
+
+    size_t nwritten = 0;
+    u8 page_buffer[PAGE_SIZE];
+    while (nwritten < count) {
+        auto page_index = (offset + nwritten) / PAGE_SIZE;
+        size_t offset_in_page = (offset + nwritten) % PAGE_SIZE;
+        size_t nbytes = min(PAGE_SIZE - offset_in_page, count - nwritten);
+        TRY(data.read(page_buffer, nwritten, nbytes));
+        TRY(write_to_page(page_index, offset_in_page, { page_buffer, nbytes }, ShouldMarkDirty::No));
+        nwritten += nbytes;
+    }
+    return {};
+}
+
+ErrorOr<void> SharedInodeVMObject::write_to_page(size_t page_index, size_t offset_in_page, ReadonlyBytes bytes, ShouldMarkDirty should_mark_dirty)
+{
+    VERIFY(offset_in_page + bytes.size() <= PAGE_SIZE);
+
+    auto copy_into = [&](PhysicalPage& physical_page) {
+        VERIFY(m_lock.is_locked());
+        u8* page = MM.quickmap_page(physical_page);
+        memcpy(page + offset_in_page, bytes.data(), bytes.size());
+        MM.unquickmap_page();
+        if (should_mark_dirty == ShouldMarkDirty::Yes)
+            m_dirty_pages.set(page_index, true);
+    };
+
+    for (;;) {
+        {
+            SpinlockLocker locker(m_lock);
+            if (auto& physical_page = m_physical_pages[page_index]) {
+                copy_into(*physical_page);
+                return {};
+            }
+        }
+
+        // Pages that aren't cached are already up to date on disk after a write that went straight to the inode.
+        if (should_mark_dirty == ShouldMarkDirty::No)
+            return {};
+
+        if (bytes.size() == PAGE_SIZE) {
+            // The whole page is overwritten, so there's no need to read it first.
+            auto new_physical_page = TRY(MM.allocate_physical_page(MemoryManager::ShouldZeroFill::No));
+            SpinlockLocker locker(m_lock);
+            auto& physical_page = m_physical_pages[page_index];
+            if (!physical_page)
+                physical_page = move(new_physical_page);
+            copy_into(*physical_page);
+            return {};
+        }
+
+        // The page may be released under memory pressure again before we get to write to it, in which case
+        // this takes another round.
+        if (TRY(read_pages(page_index, 1)) == 0)
+            return EIO;
+    }
+}
+
+ErrorOr<NonnullRefPtr<PhysicalPage>> SharedInodeVMObject::ensure_page(size_t page_index)
+{
+    for (;;) {
+        {
+            SpinlockLocker locker(m_lock);
+            if (auto& physical_page = m_physical_pages[page_index])
+                return NonnullRefPtr { *physical_page };
+        }
+        if (TRY(read_pages(page_index, 1)) == 0)
+            return EIO;
+    }
+}
+
+ErrorOr<void> SharedInodeVMObject::fill_pages(size_t first_page_index, size_t page_count)
+{
+    VERIFY(m_inode->m_inode_lock.is_locked());
+    if (first_page_index >= this->page_count())
+        return {};
+    auto end_page_index = first_page_index + min(page_count, this->page_count() - first_page_index);
+
+    for (auto page_index = first_page_index; page_index < end_page_index;) {
+        // Runs of missing pages are read from the inode all at once.
+        size_t run_length = 0;
+        {
+            SpinlockLocker locker(m_lock);
+            while (page_index < end_page_index && m_physical_pages[page_index])
+                ++page_index;
+            while (page_index + run_length < end_page_index && run_length < max_pages_per_transfer && !m_physical_pages[page_index + run_length])
+                ++run_length;
+        }
+        if (run_length == 0)
+            break;
+
+        auto pages_read = TRY(read_pages(page_index, run_length));
+        // We've reached the end of the file.
+        if (pages_read < run_length)
+            break;
+        page_index += run_length;
+    }
+    return {};
+}
+
+ErrorOr<size_t> SharedInodeVMObject::read_pages(size_t first_page_index, size_t page_count)
+{
+    VERIFY(page_count <= max_pages_per_transfer);
+
+    u8 page_buffer[PAGE_SIZE];
+    OwnPtr<KBuffer> run_buffer;
+    u8* data = page_buffer;
+    if (page_count > 1) {
+        run_buffer = TRY(KBuffer::try_create_with_size("SharedInodeVMObject: Page cache fill"sv, page_count * PAGE_SIZE, Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+        data = run_buffer->data();
+    }
+
+    auto buffer = UserOrKernelBuffer::for_kernel_buffer(data);
+    auto nread = TRY(m_inode->read_bytes_for_page_cache(first_page_index * PAGE_SIZE, page_count * PAGE_SIZE, buffer));
+    VERIFY(nread <= page_count * PAGE_SIZE);
+    auto pages_read = ceil_div(nread, static_cast<size_t>(PAGE_SIZE));
+    // Don't leak whatever comes after the end of the file.
+    memset(data + nread, 0, pages_read * PAGE_SIZE - nread);
+
+    for (size_t i = 0; i < pages_read; ++i) {
+        auto new_physical_page = TRY(MM.allocate_physical_page(MemoryManager::ShouldZeroFill::No));
+        {
+            InterruptDisabler disabler;
+            u8* dest_ptr = MM.quickmap_page(*new_physical_page);
+            memcpy(dest_ptr, data + i * PAGE_SIZE, PAGE_SIZE);
+            MM.unquickmap_page();
+        }
+
+        // Someone may have faulted in the page while we were reading it, in which case theirs wins.
+        SpinlockLocker locker(m_lock);
+        auto& physical_page = m_physical_pages[first_page_index + i];
+        if (!physical_page)
+            physical_page = move(new_physical_page);
+    }
+    return pages_read;
+}
+
+ErrorOr<void> SharedInodeVMObject::write_back_dirty_pages(size_t first_page_index, size_t page_count)
+{
+    VERIFY(m_inode->m_inode_lock.is_locked());
+    if (first_page_index >= this->page_count())
+        return {};
+    auto end_page_index = first_page_index + min(page_count, this->page_count() - first_page_index);
+    u64 file_size = m_inode->size();
+
+    OwnPtr<KBuffer> run_buffer;
+    for (auto page_index = first_page_index; page_index < end_page_index;) {
+        {
+            SpinlockLocker locker(m_lock);
+            while (page_index < end_page_index && !m_dirty_pages.get(page_index))
+                ++page_index;
+        }
+        if (page_index == end_page_index)
+            break;
+        if (!run_buffer)
+            run_buffer = TRY(KBuffer::try_create_with_size("SharedInodeVMObject: Page cache write-back"sv, max_pages_per_transfer * PAGE_SIZE, Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+
+        // Runs of dirty pages are written back all at once. They're marked clean before being written,
+        // so writes that happen in the meantime mark them dirty again.
+        size_t run_length = 0;
+        {
+            SpinlockLocker locker(m_lock);
+            while (page_index + run_length < end_page_index && run_length < max_pages_per_transfer && m_dirty_pages.get(page_index + run_length)) {
+                auto& physical_page = m_physical_pages[page_index + run_length];
+                VERIFY(physical_page);
+                MM.copy_physical_page(*physical_page, run_buffer->data() + run_length * PAGE_SIZE);
+                m_dirty_pages.set(page_index + run_length, false);
+                ++run_length;
+            }
+        }
+
+        u64 offset = page_index * PAGE_SIZE;
+        // Anything past the end of the file is going to be dropped by truncate() anyway.
+        if (run_length && offset < file_size) {
+            auto buffer = UserOrKernelBuffer::for_kernel_buffer(run_buffer->data());
+            if (auto result = m_inode->write_bytes_for_page_cache(offset, min<u64>(run_length * PAGE_SIZE, file_size - offset), buffer); result.is_error()) {
+                SpinlockLocker locker(m_lock);
+                for (size_t i = 0; i < run_length; ++i)
+                    m_dirty_pages.set(page_index + i, true);
+                return result.release_error();
+            }
+        }
+        page_index += run_length;
+    }
+    return {};
+}
+
+bool SharedInodeVMObject::has_dirty_pages() const
+{
+    SpinlockLocker locker(m_lock);
+    return m_dirty_pages.view().find_first_set().has_value();
+}
+
+void SharedInodeVMObject::truncate(u64 size)
+{
+    SpinlockLocker locker(m_lock);
 
-        TRY(m_inode->write_bytes(page_index * PAGE_SIZE, PAGE_SIZE, UserOrKernelBuffer::for_kernel_buffer(page_buffer), nullptr));
+    bool did_drop_pages = false;
+    for (size_t page_index = ceil_div(size, static_cast<u64>(PAGE_SIZE)); page_index < page_count(); ++page_index) {
+        m_dirty_pages.set(page_index, false);
+        if (m_physical_pages[page_index]) {
+            m_physical_pages[page_index] = nullptr;
+            did_drop_pages = true;
+        }
     }
 
+    // The rest of the last page has to read back as zeroes if the file grows again.
+    auto last_page_index = size / PAGE_SIZE;
+    if (size % PAGE_SIZE && last_page_index < page_count()) {
+        if (auto& physical_page = m_physical_pages[last_page_index]) {
+            u8* page = MM.quickmap_page(*physical_page);
+            memset(page + size % PAGE_SIZE, 0, PAGE_SIZE - size % PAGE_SIZE);
+            MM.unquickmap_page();
+        }
+    }
+
+    if (did_drop_pages) {
+        for_each_region([](auto& region) {
+            region.remap();
+        });
+    }
+}
+
+void SharedInodeVMObject::read_ahead(u64 offset, u64 size)
+{
+    auto first_page_index = offset / PAGE_SIZE;
+    if (size == 0 || first_page_index >= page_count())
+        return;
+    auto read_ahead_page_count = min(ceil_div(offset + size, static_cast<u64>(PAGE_SIZE)), static_cast<u64>(page_count())) - first_page_index;
+
+    // Don't let read-ahead requests pile up if the device can't keep up with them anyway.
+    if (s_pending_read_ahead_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed) >= max_pending_read_ahead_count) {
+        s_pending_read_ahead_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+        return;
+    }
+
+    auto result = g_read_ahead_work->try_queue([page_cache = NonnullLockRefPtr { *this }, first_page_index, read_ahead_page_count]() mutable {
+        {
+            MutexLocker locker(page_cache->m_inode->m_inode_lock, Mutex::Mode::Shared);
+            (void)page_cache->fill_pages(first_page_index, read_ahead_page_count);
+        }
+        s_pending_read_ahead_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+    });
+    if (result.is_error())
+        s_pending_read_ahead_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+}
+
+void SharedInodeVMObject::mark_as_recently_used()
+{
+    // Dropping the last reference to a page cache may destroy its inode, which mustn't happen while holding the spinlock.
+    LockRefPtr<SharedInodeVMObject> least_recently_used;
+    s_recently_used->with([&](auto& recently_used) {
+        if (m_recently_used_list_node.is_in_list()) {
+            recently_used.list.remove(*this);
+            --recently_used.count;
+        }
+        recently_used.list.prepend(*this);
+        ++recently_used.count;
+
+        if (recently_used.count <= max_recently_used_count)
+            return;
+        least_recently_used = recently_used.list.take_last();
+        --recently_used.count;
+        // Dirty pages still have to be written back, which the next sync will take care of.
+        if (least_recently_used->has_dirty_pages()) {
+            recently_used.list.prepend(*least_recently_used);
+            ++recently_used.count;
+        }
+    });
+}
+
+void SharedInodeVMObject::remove_from_recently_used()
+{
+    NonnullLockRefPtr protector { *this };
+    s_recently_used->with([&](auto& recently_used) {
+        if (!m_recently_used_list_node.is_in_list())
+            return;
+        recently_used.list.remove(*this);
+        --recently_used.count;
+    });
+}
+
+void SharedInodeVMObject::write_back_all_page_caches()
+{
+    NonnullLockRefPtrVector<SharedInodeVMObject, 32> page_caches;
+    s_recently_used->with([&](auto& recently_used) {
+        for (auto& page_cache : recently_used.list) {
+            if (page_cache.has_dirty_pages())
+                page_caches.append(page_cache);
+        }
+    });
+
+    for (auto& page_cache : page_caches) {
+        MutexLocker locker(page_cache.m_inode->m_inode_lock, Mutex::Mode::Shared);
+        if (auto result = page_cache.write_back_dirty_pages(); result.is_error())
+            dmesgln("SharedInodeVMObject: Failed to write back pages of inode {}: {}", page_cache.inode().identifier(), result.error());
+    }
+}
+
+ErrorOr<void> SharedInodeVMObject::remove_page_caches_of(FileSystem const& file_system)
+{
+    NonnullLockRefPtrVector<SharedInodeVMObject, 32> page_caches;
+    s_recently_used->with([&](auto& recently_used) {
+        for (auto& page_cache : recently_used.list) {
+            if (&page_cache.inode().fs() == &file_system)
+                page_caches.append(page_cache);
+        }
+    });
+
+    for (auto& page_cache : page_caches) {
+        {
+            MutexLocker locker(page_cache.m_inode->m_inode_lock, Mutex::Mode::Shared);
+            TRY(page_cache.write_back_dirty_pages());
+        }
+        page_cache.remove_from_recently_used();
+    }
     return {};
 }
 
@@ -6,11 +6,15 @@
 
 #pragma once
 
+#include <AK/IntrusiveList.h>
 #include <Kernel/Memory/InodeVMObject.h>
 #include <Kernel/UnixTypes.h>
 
 namespace Kernel::Memory {
 
+// The shared VMObject of an inode doubles as its page cache: read() and write() on files that opt into it
+// go through these pages, so file data is only cached once and mmap() shares the pages with them.
+// Unless stated otherwise, the page cache functions expect the inode lock to be held.
 class SharedInodeVMObject final : public InodeVMObject {
     AK_MAKE_NONMOVABLE(SharedInodeVMObject);
 
@@ -19,8 +23,31 @@ public:
     static ErrorOr<NonnullLockRefPtr<SharedInodeVMObject>> try_create_with_inode_and_range(Inode&, u64 offset, size_t range_size);
     virtual ErrorOr<NonnullLockRefPtr<VMObject>> try_clone() override;
 
+    // Takes the inode lock by itself.
     ErrorOr<void> sync(off_t offset_in_pages = 0, size_t pages = -1);
 
+    ErrorOr<size_t> read_bytes(u64 offset, size_t count, UserOrKernelBuffer&);
+    ErrorOr<size_t> write_bytes(u64 offset, size_t count, UserOrKernelBuffer const&);
+    // Brings pages that are already cached up to date after a write that went straight to the inode.
+    ErrorOr<void> update_pages(u64 offset, size_t count, UserOrKernelBuffer const&);
+    // Drops all pages past the new end of the file.
+    void truncate(u64 size);
+
+    ErrorOr<void> fill_pages(size_t first_page_index, size_t page_count);
+    ErrorOr<void> write_back_dirty_pages(size_t first_page_index = 0, size_t page_count = -1);
+    bool has_dirty_pages() const;
+
+    // Fills the given range in the background, without holding up the caller.
+    void read_ahead(u64 offset, u64 size);
+
+    // The page caches of recently used files are kept alive, even while nobody has them open or mapped.
+    void mark_as_recently_used();
+    void remove_from_recently_used();
+
+    // These take the inode locks by themselves.
+    static void write_back_all_page_caches();
+    static ErrorOr<void> remove_page_caches_of(FileSystem const&);
+
 private:
     virtual bool is_shared_inode() const override { return true; }
 
@@ -30,6 +57,20 @@ private:
     virtual StringView class_name() const override { return "SharedInodeVMObject"sv; }
 
     SharedInodeVMObject& operator=(SharedInodeVMObject const&) = delete;
+
+    enum class ShouldMarkDirty {
+        No,
+        Yes,
+    };
+    ErrorOr<void> grow(size_t new_size);
+    ErrorOr<void> write_to_page(size_t page_index, size_t offset_in_page, ReadonlyBytes, ShouldMarkDirty);
+    ErrorOr<NonnullRefPtr<PhysicalPage>> ensure_page(size_t page_index);
+    ErrorOr<size_t> read_pages(size_t first_page_index, size_t page_count);
+
+    IntrusiveListNode<SharedInodeVMObject, LockRefPtr<SharedInodeVMObject>> m_recently_used_list_node;
+
+public:
+    using RecentlyUsedList = IntrusiveList<&SharedInodeVMObject::m_recently_used_list_node>;
 };
 
 }
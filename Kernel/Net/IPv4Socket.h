@@ -29,6 +29,7 @@ struct PortAllocationResult {
 class IPv4Socket : public Socket {
 public:
     static ErrorOr<NonnullLockRefPtr<Socket>> create(int type, int protocol);
+    static constexpr size_t receive_buffer_size = 256 * KiB;
     virtual ~IPv4Socket() override;
 
     virtual ErrorOr<void> close() override;
@@ -86,6 +87,7 @@ protected:
     virtual ErrorOr<u16> protocol_allocate_local_port() { return ENOPROTOOPT; }
     virtual ErrorOr<size_t> protocol_size(ReadonlyBytes /* raw_ipv4_packet */) { return ENOTIMPL; }
     virtual bool protocol_is_disconnected() const { return false; }
+    virtual void protocol_did_read_from_receive_buffer() { }
 
     virtual void shut_down_for_reading() override;
 
@@ -94,6 +96,7 @@ protected:
 
     static ErrorOr<NonnullOwnPtr<DoubleBuffer>> try_create_receive_buffer();
     void drop_receive_buffer();
+    size_t receive_buffer_space() const { return m_receive_buffer ? m_receive_buffer->space_for_writing() : 0; }
 
 private:
     virtual bool is_ipv4() const override { return true; }
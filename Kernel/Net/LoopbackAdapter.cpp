@@ -4,12 +4,24 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/Singleton.h>
 #include <Kernel/Net/LoopbackAdapter.h>
 
 namespace Kernel {
 
 static bool s_loopback_initialized = false;
+static Atomic<u32> s_packet_drop_interval { 0 };
+
+u32 LoopbackAdapter::packet_drop_interval()
+{
+    return s_packet_drop_interval.load();
+}
+
+void LoopbackAdapter::set_packet_drop_interval(u32 interval)
+{
+    s_packet_drop_interval.store(interval);
+}
 
 LockRefPtr<LoopbackAdapter> LoopbackAdapter::try_create()
 {
@@ -32,6 +44,14 @@ LoopbackAdapter::~LoopbackAdapter() = default;
 
 void LoopbackAdapter::send_raw(ReadonlyBytes payload)
 {
+    if (auto interval = packet_drop_interval(); interval != 0) {
+        if (m_packets_until_drop == 0 || m_packets_until_drop > interval)
+            m_packets_until_drop = interval;
+        if (--m_packets_until_drop == 0) {
+            dbgln("LoopbackAdapter: Dropping {} byte(s) on purpose.", payload.size());
+            return;
+        }
+    }
     dbgln("LoopbackAdapter: Sending {} byte(s) to myself.", payload.size());
     did_receive(payload);
 }
@@ -26,6 +26,14 @@ public:
     virtual bool link_up() override { return true; }
     virtual bool link_full_duplex() override { return true; }
     virtual int link_speed() override { return 1000; }
+
+    // When set, every Nth packet sent over the loopback adapter is dropped, which makes it
+    // possible to exercise loss recovery without a real lossy link. 0 disables this.
+    static u32 packet_drop_interval();
+    static void set_packet_drop_interval(u32);
+
+private:
+    u32 m_packets_until_drop { 0 };
 };
 
 }
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
 #include <Kernel/Net/IPv4.h>
 
 namespace Kernel {
@@ -21,6 +23,19 @@ struct TCPFlags {
     };
 };
 
+enum class TCPOptionKind : u8 {
+    End = 0,
+    NoOperation = 1,
+    MaximumSegmentSize = 2,
+    WindowScale = 3,
+    SACKPermitted = 4,
+    SACK = 5,
+};
+
+// Sequence numbers wrap around, so they can only be compared relative to each other (RFC 793, section 3.3).
+constexpr bool tcp_sequence_before(u32 a, u32 b) { return static_cast<i32>(a - b) < 0; }
+constexpr bool tcp_sequence_before_or_equal(u32 a, u32 b) { return static_cast<i32>(a - b) <= 0; }
+
 class [[gnu::packed]] TCPOptionMSS {
 public:
     TCPOptionMSS(u16 value)
@@ -38,6 +53,62 @@ private:
 
 static_assert(AssertSize<TCPOptionMSS, 4>());
 
+// NOTE: The following options are preceded by NOP padding, so that they keep the options area 32-bit aligned.
+
+class [[gnu::packed]] TCPOptionWindowScale {
+public:
+    TCPOptionWindowScale(u8 shift_count)
+        : m_shift_count(shift_count)
+    {
+    }
+
+    u8 shift_count() const { return m_shift_count; }
+
+private:
+    u8 m_padding { to_underlying(TCPOptionKind::NoOperation) };
+    u8 m_option_kind { to_underlying(TCPOptionKind::WindowScale) };
+    u8 m_option_length { 3 };
+    u8 m_shift_count { 0 };
+};
+
+static_assert(AssertSize<TCPOptionWindowScale, 4>());
+
+class [[gnu::packed]] TCPOptionSACKPermitted {
+private:
+    u8 m_padding[2] { to_underlying(TCPOptionKind::NoOperation), to_underlying(TCPOptionKind::NoOperation) };
+    u8 m_option_kind { to_underlying(TCPOptionKind::SACKPermitted) };
+    u8 m_option_length { 2 };
+};
+
+static_assert(AssertSize<TCPOptionSACKPermitted, 4>());
+
+struct [[gnu::packed]] TCPSACKBlock {
+    NetworkOrdered<u32> left_edge;
+    NetworkOrdered<u32> right_edge;
+};
+
+static_assert(AssertSize<TCPSACKBlock, 8>());
+
+// The SACK option header is followed by up to 4 blocks, which is all that fits into the options area.
+class [[gnu::packed]] TCPOptionSACK {
+public:
+    static constexpr size_t maximum_blocks = 4;
+
+    TCPOptionSACK(size_t block_count)
+        : m_option_length(2 + block_count * sizeof(TCPSACKBlock))
+    {
+    }
+
+    static constexpr size_t size_with_blocks(size_t block_count) { return sizeof(TCPOptionSACK) + block_count * sizeof(TCPSACKBlock); }
+
+private:
+    u8 m_padding[2] { to_underlying(TCPOptionKind::NoOperation), to_underlying(TCPOptionKind::NoOperation) };
+    u8 m_option_kind { to_underlying(TCPOptionKind::SACK) };
+    u8 m_option_length { 2 };
+};
+
+static_assert(AssertSize<TCPOptionSACK, 4>());
+
 class [[gnu::packed]] TCPPacket {
 public:
     TCPPacket() = default;
@@ -77,6 +148,13 @@ public:
     u16 urgent() const { return m_urgent; }
     void set_urgent(u16 urgent) { m_urgent = urgent; }
 
+    ReadonlyBytes options() const
+    {
+        if (header_size() <= sizeof(TCPPacket))
+            return {};
+        return { ((u8 const*)this) + sizeof(TCPPacket), header_size() - sizeof(TCPPacket) };
+    }
+
     void const* payload() const { return ((u8 const*)this) + header_size(); }
     void* payload() { return ((u8*)this) + header_size(); }
 
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <Kernel/Net/TCPCongestionControl.h>
+
+namespace Kernel {
+
+static Atomic<TCPCongestionControl::Algorithm> s_default_algorithm { TCPCongestionControl::Algorithm::NewReno };
+
+ErrorOr<NonnullOwnPtr<TCPCongestionControl>> TCPCongestionControl::try_create(Algorithm algorithm)
+{
+    switch (algorithm) {
+    case Algorithm::NewReno:
+        return adopt_nonnull_own_or_enomem<TCPCongestionControl>(new (nothrow) TCPNewReno);
+    case Algorithm::Cubic:
+        return adopt_nonnull_own_or_enomem<TCPCongestionControl>(new (nothrow) TCPCubic);
+    }
+    VERIFY_NOT_REACHED();
+}
+
+TCPCongestionControl::Algorithm TCPCongestionControl::default_algorithm()
+{
+    return s_default_algorithm.load();
+}
+
+void TCPCongestionControl::set_default_algorithm(Algorithm algorithm)
+{
+    s_default_algorithm.store(algorithm);
+}
+
+StringView TCPCongestionControl::to_string(Algorithm algorithm)
+{
+    switch (algorithm) {
+    case Algorithm::NewReno:
+        return "newreno"sv;
+    case Algorithm::Cubic:
+        return "cubic"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+Optional<TCPCongestionControl::Algorithm> TCPCongestionControl::algorithm_from_string(StringView name)
+{
+    if (name == "newreno"sv)
+        return Algorithm::NewReno;
+    if (name == "cubic"sv)
+        return Algorithm::Cubic;
+    return {};
+}
+
+void TCPCongestionControl::set_maximum_segment_size(size_t maximum_segment_size)
+{
+    VERIFY(maximum_segment_size > 0);
+    m_maximum_segment_size = maximum_segment_size;
+    // RFC 6928 says the initial window should be min(10 * MSS, max(2 * MSS, 14600)).
+    m_congestion_window = min(10 * maximum_segment_size, max(2 * maximum_segment_size, 14600));
+}
+
+void TCPCongestionControl::did_receive_ack(size_t acked_bytes, Time now, Optional<Time> smoothed_rtt)
+{
+    if (is_in_slow_start()) {
+        // RFC 5681 says the window should grow by at most one segment per ACK in slow start.
+        m_congestion_window += min(acked_bytes, m_maximum_segment_size);
+    } else {
+        grow_in_congestion_avoidance(acked_bytes, now, smoothed_rtt);
+    }
+    m_congestion_window = min(m_congestion_window, maximum_congestion_window);
+}
+
+void TCPCongestionControl::did_enter_fast_recovery(size_t bytes_in_flight, Time now)
+{
+    m_slow_start_threshold = did_detect_loss(bytes_in_flight, now);
+    // The three duplicate ACKs mean three segments have left the network.
+    m_congestion_window = m_slow_start_threshold + 3 * m_maximum_segment_size;
+}
+
+void TCPCongestionControl::did_receive_duplicate_ack_in_fast_recovery()
+{
+    m_congestion_window = min(m_congestion_window + m_maximum_segment_size, maximum_congestion_window);
+}
+
+void TCPCongestionControl::did_receive_partial_ack_in_fast_recovery(size_t acked_bytes)
+{
+    // Deflate the window by the amount of new data acknowledged, then add back one segment (RFC 6582, section 3.2).
+    m_congestion_window = m_congestion_window > acked_bytes ? m_congestion_window - acked_bytes : 0;
+    if (acked_bytes >= m_maximum_segment_size)
+        m_congestion_window += m_maximum_segment_size;
+    m_congestion_window = max(m_congestion_window, m_maximum_segment_size);
+}
+
+void TCPCongestionControl::did_exit_fast_recovery(size_t bytes_in_flight)
+{
+    // Avoid sending a burst of data once the window is deflated (RFC 6582, section 3.2).
+    m_congestion_window = min(m_slow_start_threshold, max(bytes_in_flight, m_maximum_segment_size) + m_maximum_segment_size);
+}
+
+void TCPCongestionControl::did_time_out(size_t bytes_in_flight, Time now)
+{
+    m_slow_start_threshold = did_detect_loss(bytes_in_flight, now);
+    // After a retransmission timeout, we're back to the loss window of one segment (RFC 5681, section 3.1).
+    m_congestion_window = m_maximum_segment_size;
+}
+
+size_t TCPNewReno::did_detect_loss(size_t bytes_in_flight, Time)
+{
+    m_bytes_acked = 0;
+    return max(bytes_in_flight / 2, 2 * m_maximum_segment_size);
+}
+
+void TCPNewReno::grow_in_congestion_avoidance(size_t acked_bytes, Time, Optional<Time>)
+{
+    // Grow by one segment for every window's worth of acknowledged data (RFC 3465, section 2.1).
+    m_bytes_acked += acked_bytes;
+    if (m_bytes_acked >= m_congestion_window) {
+        m_bytes_acked -= m_congestion_window;
+        m_congestion_window += m_maximum_segment_size;
+    }
+}
+
+// CUBIC's constants are C = 0.4 and beta = 0.7, see RFC 8312 section 5.
+static constexpr u64 cubic_beta_numerator = 7;
+static constexpr u64 cubic_beta_denominator = 10;
+
+// Beyond this, the cubic function is steep enough that we don't care about the exact value.
+static constexpr i64 cubic_maximum_milliseconds = 100'000;
+
+static u64 integer_cube_root(u64 value)
+{
+    // Anything above this would overflow when cubed.
+    u64 low = 0;
+    u64 high = 2'642'245;
+    while (low < high) {
+        u64 middle = (low + high + 1) / 2;
+        if (middle * middle * middle <= value)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+    return low;
+}
+
+size_t TCPCubic::did_detect_loss(size_t, Time)
+{
+    // Fast convergence: if we didn't make it back to the previous W_max, another flow probably
+    // joined, so give up some more bandwidth (RFC 8312, section 4.6).
+    if (m_congestion_window < m_window_before_loss)
+        m_window_before_loss = m_congestion_window * (cubic_beta_denominator + cubic_beta_numerator) / (2 * cubic_beta_denominator);
+    else
+        m_window_before_loss = m_congestion_window;
+    m_epoch_start.clear();
+    return max(m_congestion_window * cubic_beta_numerator / cubic_beta_denominator, 2 * m_maximum_segment_size);
+}
+
+size_t TCPCubic::cubic_window(i64 milliseconds_since_epoch_start) const
+{
+    // W_cubic(t) = C * (t - K)^3 + W_max, with the window in segments and t in seconds.
+    auto delta = clamp(milliseconds_since_epoch_start - m_milliseconds_until_window_before_loss, -cubic_maximum_milliseconds, cubic_maximum_milliseconds);
+    // 0.4 * delta^3 / 1000^3 segments, in thousandths of a segment.
+    i64 segments_times_1000 = 4 * delta * delta * delta / 10'000'000;
+    i64 window = static_cast<i64>(m_window_before_loss) + segments_times_1000 * static_cast<i64>(m_maximum_segment_size) / 1000;
+    return static_cast<size_t>(clamp<i64>(window, 0, maximum_congestion_window));
+}
+
+size_t TCPCubic::reno_friendly_window(i64 milliseconds_since_epoch_start, Time smoothed_rtt) const
+{
+    // W_est(t) = W_max * beta + 3 * (1 - beta) / (1 + beta) * t / RTT, see RFC 8312 section 4.2.
+    // 3 * (1 - beta) / (1 + beta) is roughly 0.529.
+    u64 rtt_milliseconds = max<i64>(smoothed_rtt.to_milliseconds(), 1);
+    u64 milliseconds = min(milliseconds_since_epoch_start, cubic_maximum_milliseconds);
+    u64 window = m_window_before_loss * cubic_beta_numerator / cubic_beta_denominator
+        + 529 * milliseconds * m_maximum_segment_size / (1000 * rtt_milliseconds);
+    return min(window, maximum_congestion_window);
+}
+
+void TCPCubic::grow_in_congestion_avoidance(size_t acked_bytes, Time now, Optional<Time> smoothed_rtt)
+{
+    if (!m_epoch_start.has_value()) {
+        m_epoch_start = now;
+        if (m_congestion_window < m_window_before_loss) {
+            // K = cbrt((W_max - cwnd) / C), with the window in segments. In milliseconds, that's
+            // cbrt((W_max - cwnd) / MSS * 2.5 * 1000^3).
+            u64 missing_bytes = m_window_before_loss - m_congestion_window;
+            m_milliseconds_until_window_before_loss = static_cast<i64>(integer_cube_root(missing_bytes * 2'500'000'000 / m_maximum_segment_size));
+        } else {
+            // We left slow start without having seen a loss, so the curve starts right here.
+            m_milliseconds_until_window_before_loss = 0;
+            m_window_before_loss = m_congestion_window;
+        }
+    }
+
+    auto elapsed_milliseconds = (now - m_epoch_start.value()).to_milliseconds();
+    // Aim for the window we should have one round-trip from now.
+    auto target = cubic_window(elapsed_milliseconds + (smoothed_rtt.has_value() ? smoothed_rtt->to_milliseconds() : 0));
+    // Don't fall behind what standard TCP would have achieved in the same situation.
+    if (smoothed_rtt.has_value())
+        target = max(target, reno_friendly_window(elapsed_milliseconds, smoothed_rtt.value()));
+
+    // Grow by at most half the window per round-trip.
+    target = min(target, m_congestion_window + m_congestion_window / 2);
+    if (target <= m_congestion_window)
+        return;
+    u64 increment = static_cast<u64>(target - m_congestion_window) * acked_bytes / m_congestion_window;
+    m_congestion_window += max<u64>(increment, 1);
+}
+
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// Keeps track of the congestion window of a TCP connection (RFC 5681).
+// Deciding what to retransmit is up to TCPSocket, which only tells the congestion control about
+// acknowledgements and losses. Subclasses decide how the window grows during congestion avoidance,
+// and how far it shrinks after a loss.
+class TCPCongestionControl {
+public:
+    enum class Algorithm {
+        NewReno,
+        Cubic,
+    };
+
+    static ErrorOr<NonnullOwnPtr<TCPCongestionControl>> try_create(Algorithm);
+
+    static Algorithm default_algorithm();
+    static void set_default_algorithm(Algorithm);
+
+    static StringView to_string(Algorithm);
+    static Optional<Algorithm> algorithm_from_string(StringView);
+
+    virtual ~TCPCongestionControl() = default;
+
+    virtual Algorithm algorithm() const = 0;
+
+    size_t congestion_window() const { return m_congestion_window; }
+    size_t slow_start_threshold() const { return m_slow_start_threshold; }
+    bool is_in_slow_start() const { return m_congestion_window < m_slow_start_threshold; }
+
+    // Resets the congestion window to the initial window for the given segment size.
+    void set_maximum_segment_size(size_t);
+
+    // New data was acknowledged while no loss was being recovered from.
+    void did_receive_ack(size_t acked_bytes, Time now, Optional<Time> smoothed_rtt);
+
+    // Fast recovery as described by RFC 6582.
+    void did_enter_fast_recovery(size_t bytes_in_flight, Time now);
+    void did_receive_duplicate_ack_in_fast_recovery();
+    void did_receive_partial_ack_in_fast_recovery(size_t acked_bytes);
+    void did_exit_fast_recovery(size_t bytes_in_flight);
+
+    void did_time_out(size_t bytes_in_flight, Time now);
+
+protected:
+    TCPCongestionControl() = default;
+
+    // Called whenever a loss has been detected, returns the new slow start threshold.
+    virtual size_t did_detect_loss(size_t bytes_in_flight, Time now) = 0;
+    virtual void grow_in_congestion_avoidance(size_t acked_bytes, Time now, Optional<Time> smoothed_rtt) = 0;
+
+    // The largest window that can be advertised with window scaling (RFC 7323, section 2.3).
+    static constexpr size_t maximum_congestion_window = 1 * GiB;
+
+    // The default MSS, until the peer tells us otherwise (RFC 1122, section 4.2.2.6).
+    size_t m_maximum_segment_size { 536 };
+    size_t m_congestion_window { 4 * 536 };
+    size_t m_slow_start_threshold { maximum_congestion_window };
+};
+
+class TCPNewReno final : public TCPCongestionControl {
+public:
+    virtual Algorithm algorithm() const override { return Algorithm::NewReno; }
+
+private:
+    virtual size_t did_detect_loss(size_t bytes_in_flight, Time now) override;
+    virtual void grow_in_congestion_avoidance(size_t acked_bytes, Time now, Optional<Time> smoothed_rtt) override;
+
+    size_t m_bytes_acked { 0 };
+};
+
+// CUBIC (RFC 8312) grows the window as a cubic function of the time since the last loss, which
+// makes it probe for bandwidth much faster than NewReno on paths with a large bandwidth-delay product.
+// All of this is done in fixed point, with time in milliseconds.
+class TCPCubic final : public TCPCongestionControl {
+public:
+    virtual Algorithm algorithm() const override { return Algorithm::Cubic; }
+
+private:
+    virtual size_t did_detect_loss(size_t bytes_in_flight, Time now) override;
+    virtual void grow_in_congestion_avoidance(size_t acked_bytes, Time now, Optional<Time> smoothed_rtt) override;
+
+    size_t cubic_window(i64 milliseconds_since_epoch_start) const;
+    size_t reno_friendly_window(i64 milliseconds_since_epoch_start, Time smoothed_rtt) const;
+
+    // W_max, the window right before the last loss.
+    size_t m_window_before_loss { 0 };
+    // K, the time it takes to grow back to W_max.
+    i64 m_milliseconds_until_window_before_loss { 0 };
+    Optional<Time> m_epoch_start;
+};
+
+}
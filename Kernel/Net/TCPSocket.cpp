@@ -22,6 +22,45 @@
 
 namespace Kernel {
 
+// The smallest shift that lets us advertise the whole receive buffer (RFC 7323, section 2.2).
+static constexpr u8 receive_window_scale = [] {
+    u8 shift = 0;
+    while ((IPv4Socket::receive_buffer_size >> shift) > NumericLimits<u16>::max())
+        ++shift;
+    return shift;
+}();
+
+// RFC 7323 says shift counts above 14 must be treated as 14.
+static constexpr u8 maximum_window_scale = 14;
+
+static size_t maximum_segment_size_for_adapter(NetworkAdapter const& adapter)
+{
+    // The IPv4 total length field limits the packet size, even if the MTU is larger (like on the loopback adapter).
+    return min<size_t>(adapter.mtu(), NumericLimits<u16>::max()) - sizeof(IPv4Packet) - sizeof(TCPPacket);
+}
+
+template<typename Callback>
+static void for_each_tcp_option(TCPPacket const& packet, Callback callback)
+{
+    auto options = packet.options();
+    for (size_t offset = 0; offset < options.size();) {
+        auto kind = static_cast<TCPOptionKind>(options[offset]);
+        if (kind == TCPOptionKind::End)
+            return;
+        if (kind == TCPOptionKind::NoOperation) {
+            ++offset;
+            continue;
+        }
+        if (offset + 1 >= options.size())
+            return;
+        size_t length = options[offset + 1];
+        if (length < 2 || offset + length > options.size())
+            return;
+        callback(kind, options.slice(offset + 2, length - 2));
+        offset += length;
+    }
+}
+
 void TCPSocket::for_each(Function<void(TCPSocket const&)> callback)
 {
     sockets_by_tuple().for_each_shared([&](auto const& it) {
@@ -73,6 +112,7 @@ void TCPSocket::set_state(State new_state)
         // are packets on the way which we wouldn't want a new socket to get hit
         // with, so there's no point in keeping the receive buffer around.
         drop_receive_buffer();
+        drop_out_of_order_segments();
     }
 
     if (new_state == State::Closed) {
@@ -162,10 +202,11 @@ void TCPSocket::release_for_accept(NonnullLockRefPtr<TCPSocket> socket)
     [[maybe_unused]] auto rc = queue_connection_from(move(socket));
 }
 
-TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer)
+TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullOwnPtr<TCPCongestionControl> congestion_control)
     : IPv4Socket(SOCK_STREAM, protocol, move(receive_buffer), move(scratch_buffer))
+    , m_congestion_control(move(congestion_control))
 {
-    m_last_retransmit_time = kgettimeofday();
+    m_retransmit_timer_start = kgettimeofday();
 }
 
 TCPSocket::~TCPSocket()
@@ -179,7 +220,8 @@ ErrorOr<NonnullLockRefPtr<TCPSocket>> TCPSocket::try_create(int protocol, Nonnul
 {
     // Note: Scratch buffer is only used for SOCK_STREAM sockets.
     auto scratch_buffer = TRY(KBuffer::try_create_with_size("TCPSocket: Scratch buffer"sv, 65536));
-    return adopt_nonnull_lock_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer)));
+    auto congestion_control = TRY(TCPCongestionControl::try_create(TCPCongestionControl::default_algorithm()));
+    return adopt_nonnull_lock_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer), move(congestion_control)));
 }
 
 ErrorOr<size_t> TCPSocket::protocol_size(ReadonlyBytes raw_ipv4_packet)
@@ -205,12 +247,50 @@ ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t
     RoutingDecision routing_decision = route_to(peer_address(), local_address(), bound_interface());
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
-    size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
-    data_length = min(data_length, mss);
+
+    size_t mss = maximum_segment_size(routing_decision);
+    // Leave room for the SACK blocks that will be sent along with the data.
+    if (auto sack_block_count = sack_blocks_to_send().size(); sack_block_count > 0)
+        mss -= TCPOptionSACK::size_with_blocks(sack_block_count);
+
+    size_t bytes_in_flight = m_unacked_packets.with_shared([](auto& unacked_packets) { return unacked_packets.size; });
+    size_t window = send_window();
+    size_t available_window = bytes_in_flight < window ? window - bytes_in_flight : 0;
+    // With nothing in flight, we always send a segment, so that a closed window gets probed by the retransmit timer.
+    if (bytes_in_flight == 0)
+        available_window = max(available_window, mss);
+    if (available_window == 0)
+        return set_so_error(EAGAIN);
+
+    data_length = min(data_length, min(mss, available_window));
     TRY(send_tcp_packet(TCPFlags::PSH | TCPFlags::ACK, &data, data_length, &routing_decision));
     return data_length;
 }
 
+size_t TCPSocket::maximum_segment_size(RoutingDecision const& routing_decision) const
+{
+    return min<size_t>(maximum_segment_size_for_adapter(*routing_decision.adapter), m_peer_maximum_segment_size);
+}
+
+u32 TCPSocket::receive_window() const
+{
+    // Out-of-order segments lie within this window as well, so they don't shrink it
+    // until the hole before them is filled and they make it into the receive buffer.
+    return receive_buffer_space();
+}
+
+void TCPSocket::protocol_did_read_from_receive_buffer()
+{
+    if (m_state != State::Established && m_state != State::FinWait1 && m_state != State::FinWait2)
+        return;
+
+    // The peer might be waiting for the window to open up, so tell it once a
+    // significant amount of space has been freed (RFC 1122, section 4.2.3.3).
+    size_t threshold = min<size_t>(receive_buffer_size / 2, m_peer_maximum_segment_size);
+    if (receive_window() >= m_last_advertised_window + threshold)
+        [[maybe_unused]] auto result = send_ack(true);
+}
+
 ErrorOr<void> TCPSocket::send_ack(bool allow_duplicate)
 {
     if (!allow_duplicate && m_last_ack_number_sent == m_ack_number)
@@ -226,8 +306,24 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
     auto ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
 
-    bool const has_mss_option = flags == TCPFlags::SYN;
-    const size_t options_size = has_mss_option ? sizeof(TCPOptionMSS) : 0;
+    bool const has_syn = flags & TCPFlags::SYN;
+    // When answering a SYN, only the options the peer sent as well may be included (RFC 7323, section 1.3 and RFC 2018, section 2).
+    bool const is_answering_syn = has_syn && (flags & TCPFlags::ACK);
+    bool const has_window_scale_option = has_syn && (!is_answering_syn || m_window_scaling_enabled);
+    bool const has_sack_permitted_option = has_syn && (!is_answering_syn || m_sack_permitted);
+    Vector<TCPSACKBlock, TCPOptionSACK::maximum_blocks> sack_blocks;
+    if (!has_syn && (flags & TCPFlags::ACK))
+        sack_blocks = sack_blocks_to_send();
+
+    size_t options_size = 0;
+    if (has_syn)
+        options_size += sizeof(TCPOptionMSS);
+    if (has_window_scale_option)
+        options_size += sizeof(TCPOptionWindowScale);
+    if (has_sack_permitted_option)
+        options_size += sizeof(TCPOptionSACKPermitted);
+    if (!sack_blocks.is_empty())
+        options_size += TCPOptionSACK::size_with_blocks(sack_blocks.size());
     const size_t tcp_header_size = sizeof(TCPPacket) + options_size;
     const size_t buffer_size = ipv4_payload_offset + tcp_header_size + payload_size;
     auto packet = routing_decision.adapter->acquire_packet_buffer(buffer_size);
@@ -241,7 +337,10 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
     VERIFY(local_port());
     tcp_packet.set_source_port(local_port());
     tcp_packet.set_destination_port(peer_port());
-    tcp_packet.set_window_size(NumericLimits<u16>::max());
+    // The window in a SYN is never scaled (RFC 7323, section 2.2).
+    u8 window_scale = (!has_syn && m_window_scaling_enabled) ? receive_window_scale : 0;
+    u16 window_size = min<u32>(receive_window() >> window_scale, NumericLimits<u16>::max());
+    tcp_packet.set_window_size(window_size);
     tcp_packet.set_sequence_number(m_sequence_number);
     tcp_packet.set_data_offset(tcp_header_size / sizeof(u32));
     tcp_packet.set_flags(flags);
@@ -256,20 +355,40 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
     if (flags & TCPFlags::ACK) {
         m_last_ack_number_sent = m_ack_number;
         m_last_ack_sent_time = kgettimeofday();
+        m_last_advertised_window = static_cast<u32>(window_size) << window_scale;
         tcp_packet.set_ack_number(m_ack_number);
     }
 
-    if (flags & TCPFlags::SYN) {
+    auto packet_sequence_number = m_sequence_number;
+    if (has_syn) {
+        m_send_unacknowledged = m_sequence_number;
         ++m_sequence_number;
     } else {
         m_sequence_number += payload_size;
     }
 
-    if (has_mss_option) {
-        u16 mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
-        TCPOptionMSS mss_option { mss };
-        VERIFY(packet->buffer->size() >= ipv4_payload_offset + sizeof(TCPPacket) + sizeof(mss_option));
-        memcpy(packet->buffer->data() + ipv4_payload_offset + sizeof(TCPPacket), &mss_option, sizeof(mss_option));
+    VERIFY(packet->buffer->size() >= ipv4_payload_offset + tcp_header_size);
+    u8* options = packet->buffer->data() + ipv4_payload_offset + sizeof(TCPPacket);
+    if (has_syn) {
+        TCPOptionMSS mss_option { static_cast<u16>(maximum_segment_size_for_adapter(*routing_decision.adapter)) };
+        memcpy(options, &mss_option, sizeof(mss_option));
+        options += sizeof(mss_option);
+    }
+    if (has_window_scale_option) {
+        TCPOptionWindowScale window_scale_option { receive_window_scale };
+        memcpy(options, &window_scale_option, sizeof(window_scale_option));
+        options += sizeof(window_scale_option);
+    }
+    if (has_sack_permitted_option) {
+        TCPOptionSACKPermitted sack_permitted_option;
+        memcpy(options, &sack_permitted_option, sizeof(sack_permitted_option));
+        options += sizeof(sack_permitted_option);
+    }
+    if (!sack_blocks.is_empty()) {
+        TCPOptionSACK sack_option { sack_blocks.size() };
+        memcpy(options, &sack_option, sizeof(sack_option));
+        options += sizeof(sack_option);
+        memcpy(options, sack_blocks.data(), sack_blocks.size() * sizeof(TCPSACKBlock));
     }
 
     tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
@@ -278,13 +397,16 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
     if (expect_ack) {
         bool append_failed { false };
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter });
+            bool was_empty = unacked_packets.packets.is_empty();
+            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter, 0, packet_sequence_number, payload_size });
             if (result.is_error()) {
                 dbgln("TCPSocket: Dropped outbound packet because try_append() failed");
                 append_failed = true;
                 return;
             }
             unacked_packets.size += payload_size;
+            if (was_empty)
+                m_retransmit_timer_start = kgettimeofday();
             enqueue_for_retransmit();
         });
         if (append_failed)
@@ -302,44 +424,303 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
 void TCPSocket::receive_tcp_packet(TCPPacket const& packet, u16 size)
 {
-    if (packet.has_ack()) {
-        u32 ack_number = packet.ack_number();
+    if (packet.has_ack())
+        process_ack(packet, size - packet.header_size());
 
-        dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
+    m_packets_in++;
+    m_bytes_in += packet.header_size() + size;
+}
 
-        int removed = 0;
-        m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            while (!unacked_packets.packets.is_empty()) {
-                auto& packet = unacked_packets.packets.first();
-
-                dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", packet.ack_number);
-
-                if (packet.ack_number <= ack_number) {
-                    auto old_adapter = packet.adapter.strong_ref();
-                    if (old_adapter)
-                        old_adapter->release_packet_buffer(*packet.buffer);
-                    TCPPacket& tcp_packet = *(TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                    auto payload_size = packet.buffer->buffer->data() + packet.buffer->buffer->size() - (u8*)tcp_packet.payload();
-                    unacked_packets.size -= payload_size;
-                    evaluate_block_conditions();
-                    unacked_packets.packets.take_first();
-                    removed++;
-                } else {
-                    break;
+void TCPSocket::process_syn_options(TCPPacket const& packet)
+{
+    VERIFY(packet.has_syn());
+
+    for_each_tcp_option(packet, [&](TCPOptionKind kind, ReadonlyBytes data) {
+        switch (kind) {
+        case TCPOptionKind::MaximumSegmentSize:
+            if (data.size() == sizeof(u16) && (data[0] || data[1]))
+                m_peer_maximum_segment_size = (data[0] << 8) | data[1];
+            break;
+        case TCPOptionKind::WindowScale:
+            if (data.size() == sizeof(u8)) {
+                m_window_scaling_enabled = true;
+                m_send_window_scale = min(data[0], maximum_window_scale);
+            }
+            break;
+        case TCPOptionKind::SACKPermitted:
+            if (data.is_empty())
+                m_sack_permitted = true;
+            break;
+        default:
+            break;
+        }
+    });
+
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) peer MSS is {}, window scaling {}, SACK {}", this, m_peer_maximum_segment_size, m_window_scaling_enabled, m_sack_permitted);
+
+    auto routing_decision = route_to(peer_address(), local_address(), bound_interface());
+    m_congestion_control->set_maximum_segment_size(routing_decision.is_zero() ? m_peer_maximum_segment_size : maximum_segment_size(routing_decision));
+}
+
+void TCPSocket::process_ack(TCPPacket const& packet, size_t payload_size)
+{
+    u32 ack_number = packet.ack_number();
+
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
+
+    // Ignore ACKs for data we haven't sent yet, as well as ones that are older than what we've already seen.
+    if (tcp_sequence_before(m_sequence_number, ack_number) || tcp_sequence_before(ack_number, m_send_unacknowledged))
+        return;
+
+    auto now = kgettimeofday();
+
+    auto previous_send_window_size = m_send_window_size;
+    // The window in a SYN is never scaled (RFC 7323, section 2.2).
+    u8 window_scale = (!packet.has_syn() && m_window_scaling_enabled) ? m_send_window_scale : 0;
+    m_send_window_size = static_cast<u32>(packet.window_size()) << window_scale;
+
+    Vector<TCPSACKBlock, TCPOptionSACK::maximum_blocks> sack_blocks;
+    if (m_sack_permitted) {
+        for_each_tcp_option(packet, [&](TCPOptionKind kind, ReadonlyBytes data) {
+            if (kind != TCPOptionKind::SACK)
+                return;
+            for (size_t offset = 0; offset + sizeof(TCPSACKBlock) <= data.size() && sack_blocks.size() < TCPOptionSACK::maximum_blocks; offset += sizeof(TCPSACKBlock))
+                sack_blocks.unchecked_append(*bit_cast<TCPSACKBlock const*>(data.offset(offset)));
+        });
+    }
+
+    u32 acked_bytes = ack_number - m_send_unacknowledged;
+    m_send_unacknowledged = ack_number;
+
+    Optional<Time> rtt_sample;
+    size_t bytes_in_flight = 0;
+    int removed = 0;
+    bool sacked_new_data = false;
+    m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+        while (!unacked_packets.packets.is_empty()) {
+            auto& packet = unacked_packets.packets.first();
+
+            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", packet.ack_number);
+
+            if (!tcp_sequence_before_or_equal(packet.ack_number, ack_number))
+                break;
+
+            // Karn's algorithm: we can't know which copy of a retransmitted packet was acknowledged,
+            // so those don't tell us anything about the round-trip time.
+            if (packet.tx_counter == 0)
+                rtt_sample = now - packet.buffer->timestamp;
+
+            auto old_adapter = packet.adapter.strong_ref();
+            if (old_adapter)
+                old_adapter->release_packet_buffer(*packet.buffer);
+            unacked_packets.size -= packet.payload_size;
+            unacked_packets.packets.take_first();
+            removed++;
+        }
+
+        for (auto& packet : unacked_packets.packets) {
+            for (auto& block : sack_blocks) {
+                if (packet.is_sacked || packet.payload_size == 0)
+                    continue;
+                if (tcp_sequence_before_or_equal(block.left_edge, packet.sequence_number) && tcp_sequence_before_or_equal(packet.ack_number, block.right_edge)) {
+                    packet.is_sacked = true;
+                    sacked_new_data = true;
                 }
             }
+        }
 
-            if (unacked_packets.packets.is_empty()) {
-                m_retransmit_attempts = 0;
-                dequeue_for_retransmit();
+        bytes_in_flight = unacked_packets.size;
+        if (unacked_packets.packets.is_empty()) {
+            m_retransmit_attempts = 0;
+            dequeue_for_retransmit();
+        }
+
+        dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
+    });
+
+    if (acked_bytes > 0) {
+        m_duplicate_acks_received = 0;
+        m_retransmit_attempts = 0;
+        m_retransmit_timer_start = now;
+        if (rtt_sample.has_value())
+            update_rtt_estimate(rtt_sample.value());
+
+        bool is_partial_ack = tcp_sequence_before(ack_number, m_recovery_point);
+        switch (m_loss_recovery) {
+        case LossRecovery::None:
+            m_congestion_control->did_receive_ack(acked_bytes, now, m_smoothed_rtt);
+            break;
+        case LossRecovery::FastRecovery:
+            if (is_partial_ack) {
+                // The next hole starts right where the acknowledged data ends (RFC 6582, section 3.2).
+                m_congestion_control->did_receive_partial_ack_in_fast_recovery(acked_bytes);
+                retransmit_next_packet(RetransmitCandidate::FirstUnacknowledged);
+            } else {
+                m_congestion_control->did_exit_fast_recovery(bytes_in_flight);
+                m_loss_recovery = LossRecovery::None;
             }
+            break;
+        case LossRecovery::AfterRetransmitTimeout:
+            m_congestion_control->did_receive_ack(acked_bytes, now, m_smoothed_rtt);
+            if (is_partial_ack)
+                retransmit_next_packet(RetransmitCandidate::FirstUnacknowledged);
+            else
+                m_loss_recovery = LossRecovery::None;
+            break;
+        }
+    } else if (payload_size == 0 && !packet.has_syn() && !packet.has_fin() && bytes_in_flight > 0 && (m_send_window_size == previous_send_window_size || sacked_new_data)) {
+        // This is a duplicate ACK, as defined by RFC 5681, section 2. The window may change while the
+        // receiving application reads data, but new SACK information still means a segment arrived.
+        ++m_duplicate_acks_received;
+        if (m_loss_recovery == LossRecovery::FastRecovery) {
+            m_congestion_control->did_receive_duplicate_ack_in_fast_recovery();
+            if (m_sack_permitted)
+                retransmit_next_packet(RetransmitCandidate::KnownLost);
+        } else if (m_loss_recovery == LossRecovery::None && m_duplicate_acks_received == fast_retransmit_threshold) {
+            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) entering fast recovery at {}", this, ack_number);
+            m_loss_recovery = LossRecovery::FastRecovery;
+            m_recovery_point = m_sequence_number;
+            m_congestion_control->did_enter_fast_recovery(bytes_in_flight, now);
+            m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+                for (auto& packet : unacked_packets.packets)
+                    packet.was_retransmitted_during_recovery = false;
+            });
+            retransmit_next_packet(RetransmitCandidate::FirstUnacknowledged);
+        }
+    }
 
-            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
-        });
+    if (removed > 0 || m_send_window_size != previous_send_window_size)
+        evaluate_block_conditions();
+}
+
+void TCPSocket::update_rtt_estimate(Time sample)
+{
+    if (!m_smoothed_rtt.has_value()) {
+        m_smoothed_rtt = sample;
+        m_rtt_variance = Time::from_microseconds(sample.to_microseconds() / 2);
+        return;
     }
 
-    m_packets_in++;
-    m_bytes_in += packet.header_size() + size;
+    // RFC 6298, section 2.3
+    i64 smoothed_rtt = m_smoothed_rtt->to_microseconds();
+    i64 rtt_variance = m_rtt_variance.to_microseconds();
+    i64 rtt = sample.to_microseconds();
+    rtt_variance = (3 * rtt_variance + AK::abs(smoothed_rtt - rtt)) / 4;
+    smoothed_rtt = (7 * smoothed_rtt + rtt) / 8;
+    m_smoothed_rtt = Time::from_microseconds(smoothed_rtt);
+    m_rtt_variance = Time::from_microseconds(rtt_variance);
+}
+
+Time TCPSocket::retransmit_timeout() const
+{
+    // RFC 6298 says the RTO is SRTT + 4 * RTTVAR, but at least one second.
+    // Until we have measured the round-trip time, it's one second as well.
+    if (!m_smoothed_rtt.has_value())
+        return Time::from_seconds(1);
+    auto timeout = Time::from_microseconds(m_smoothed_rtt->to_microseconds() + 4 * m_rtt_variance.to_microseconds());
+    return clamp(timeout, Time::from_seconds(1), Time::from_seconds(60));
+}
+
+bool TCPSocket::queue_out_of_order_segment(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, size_t payload_size, Time const& packet_timestamp)
+{
+    u32 sequence_number = tcp_packet.sequence_number();
+    u32 end = sequence_number + payload_size;
+
+    // Only keep segments that are entirely ahead of what we're expecting next.
+    if (payload_size == 0 || tcp_packet.has_fin() || !tcp_sequence_before(m_ack_number, sequence_number))
+        return false;
+    if (end - m_ack_number > receive_window())
+        return false;
+
+    size_t index = 0;
+    for (; index < m_out_of_order_segments.size(); ++index) {
+        auto& segment = m_out_of_order_segments[index];
+        if (segment.sequence_number == sequence_number && segment.payload_size == payload_size) {
+            // We already have this one.
+            m_last_out_of_order_sequence_number = sequence_number;
+            return true;
+        }
+        if (tcp_sequence_before(sequence_number, segment.sequence_number))
+            break;
+    }
+
+    // Segments that partially overlap the ones we already have are not worth the trouble.
+    if (index > 0) {
+        auto& previous = m_out_of_order_segments[index - 1];
+        if (tcp_sequence_before(sequence_number, previous.sequence_number + previous.payload_size))
+            return false;
+    }
+    if (index < m_out_of_order_segments.size() && tcp_sequence_before(m_out_of_order_segments[index].sequence_number, end))
+        return false;
+
+    if (m_out_of_order_segments.size() >= maximum_out_of_order_segments)
+        return false;
+
+    auto ipv4_packet_or_error = ByteBuffer::copy(&ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size());
+    if (ipv4_packet_or_error.is_error())
+        return false;
+    if (m_out_of_order_segments.try_insert(index, { sequence_number, payload_size, packet_timestamp, ipv4_packet_or_error.release_value() }).is_error())
+        return false;
+
+    m_last_out_of_order_sequence_number = sequence_number;
+    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) queued out of order segment {}-{}, {} segments queued", this, sequence_number, end, m_out_of_order_segments.size());
+    return true;
+}
+
+void TCPSocket::deliver_out_of_order_segments()
+{
+    while (!m_out_of_order_segments.is_empty()) {
+        auto& segment = m_out_of_order_segments.first();
+        if (tcp_sequence_before(m_ack_number, segment.sequence_number))
+            break;
+
+        // Segments behind the next expected sequence number were covered by a segment that arrived in order.
+        if (segment.sequence_number == m_ack_number) {
+            if (!did_receive(peer_address(), peer_port(), segment.ipv4_packet.bytes(), segment.timestamp))
+                break;
+            m_ack_number += segment.payload_size;
+        }
+
+        m_out_of_order_segments.take_first();
+    }
+}
+
+void TCPSocket::drop_out_of_order_segments()
+{
+    m_out_of_order_segments.clear();
+}
+
+Vector<TCPSACKBlock, TCPOptionSACK::maximum_blocks> TCPSocket::sack_blocks_to_send() const
+{
+    Vector<TCPSACKBlock, TCPOptionSACK::maximum_blocks> blocks;
+    if (!m_sack_permitted || m_out_of_order_segments.is_empty())
+        return blocks;
+
+    // The first block has to contain the most recently received segment (RFC 2018, section 4).
+    // The remaining blocks are filled in from the lowest sequence number upwards.
+    Optional<TCPSACKBlock> most_recent_block;
+    auto add_block = [&](u32 left_edge, u32 right_edge) {
+        bool is_most_recent = tcp_sequence_before_or_equal(left_edge, m_last_out_of_order_sequence_number) && tcp_sequence_before(m_last_out_of_order_sequence_number, right_edge);
+        if (is_most_recent)
+            most_recent_block = TCPSACKBlock { left_edge, right_edge };
+        else if (blocks.size() < TCPOptionSACK::maximum_blocks - 1)
+            blocks.unchecked_append({ left_edge, right_edge });
+    };
+
+    u32 left_edge = m_out_of_order_segments.first().sequence_number;
+    u32 right_edge = left_edge;
+    for (auto& segment : m_out_of_order_segments) {
+        if (segment.sequence_number != right_edge) {
+            add_block(left_edge, right_edge);
+            left_edge = segment.sequence_number;
+        }
+        right_edge = segment.sequence_number + segment.payload_size;
+    }
+    add_block(left_edge, right_edge);
+
+    if (most_recent_block.has_value())
+        MUST(blocks.try_insert(0, most_recent_block.release_value()));
+    return blocks;
 }
 
 bool TCPSocket::should_delay_next_ack() const
@@ -348,7 +729,7 @@ bool TCPSocket::should_delay_next_ack() const
     const size_t mss = 1500;
 
     // RFC 1122 says we should send an ACK for every two full-sized segments.
-    if (m_ack_number >= m_last_ack_number_sent + 2 * mss)
+    if (m_ack_number - m_last_ack_number_sent >= 2 * mss)
         return false;
 
     // RFC 1122 says we should not delay ACKs for more than 500 milliseconds.
@@ -577,18 +958,18 @@ void TCPSocket::retransmit_packets()
 {
     auto now = kgettimeofday();
 
-    // RFC6298 says we should have at least one second between retransmits. According to
+    // RFC 6298 says we should have at least one second between retransmits. According to
     // RFC1122 we must do exponential backoff - even for SYN packets.
-    i64 retransmit_interval = 1;
+    i64 retransmit_interval_ms = retransmit_timeout().to_milliseconds();
     for (decltype(m_retransmit_attempts) i = 0; i < m_retransmit_attempts; i++)
-        retransmit_interval *= 2;
+        retransmit_interval_ms *= 2;
 
-    if (m_last_retransmit_time > now - Time::from_seconds(retransmit_interval))
+    if (m_retransmit_timer_start > now - Time::from_milliseconds(retransmit_interval_ms))
         return;
 
     dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) handling retransmit", this);
 
-    m_last_retransmit_time = now;
+    m_retransmit_timer_start = now;
     ++m_retransmit_attempts;
 
     if (m_retransmit_attempts > maximum_retransmits) {
@@ -603,43 +984,95 @@ void TCPSocket::retransmit_packets()
         return;
 
     m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+        if (unacked_packets.packets.is_empty())
+            return;
+
+        // After a timeout, everything that's still outstanding is considered lost. The peer may also
+        // have dropped data it SACKed in the meantime, so start over from the left edge (RFC 2018, section 8).
         for (auto& packet : unacked_packets.packets) {
-            packet.tx_counter++;
-
-            if constexpr (TCP_SOCKET_DEBUG) {
-                auto& tcp_packet = *(const TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
-                    local_address(), local_port(),
-                    peer_address(), peer_port(),
-                    (tcp_packet.has_syn() ? "SYN " : ""),
-                    (tcp_packet.has_ack() ? "ACK " : ""),
-                    (tcp_packet.has_fin() ? "FIN " : ""),
-                    (tcp_packet.has_rst() ? "RST " : ""),
-                    tcp_packet.sequence_number(),
-                    tcp_packet.ack_number(),
-                    packet.tx_counter);
-            }
+            packet.is_sacked = false;
+            packet.was_retransmitted_during_recovery = false;
+        }
 
-            size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
-            if (ipv4_payload_offset != packet.ipv4_payload_offset) {
-                // FIXME: Add support for this. This can happen if after a route change
-                // we ended up on another adapter which doesn't have the same layer 2 type
-                // like the previous adapter.
-                VERIFY_NOT_REACHED();
-            }
+        m_congestion_control->did_time_out(unacked_packets.size, now);
+        m_loss_recovery = LossRecovery::AfterRetransmitTimeout;
+        m_recovery_point = m_sequence_number;
+        m_duplicate_acks_received = 0;
+
+        // The rest is retransmitted as the ACKs for this one come in.
+        resend_packet(unacked_packets.packets.first(), routing_decision);
+    });
+}
+
+void TCPSocket::retransmit_next_packet(RetransmitCandidate candidate)
+{
+    auto routing_decision = route_to(peer_address(), local_address(), bound_interface());
+    if (routing_decision.is_zero())
+        return;
 
-            auto packet_buffer = packet.buffer->bytes();
+    m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+        if (unacked_packets.packets.is_empty())
+            return;
+
+        if (candidate == RetransmitCandidate::FirstUnacknowledged) {
+            auto& packet = unacked_packets.packets.first();
+            if (!packet.is_sacked && !packet.was_retransmitted_during_recovery)
+                resend_packet(packet, routing_decision);
+            return;
+        }
 
-            routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
-                local_address(), routing_decision.next_hop, peer_address(),
-                IPv4Protocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
-            routing_decision.adapter->send_packet(packet_buffer);
-            m_packets_out++;
-            m_bytes_out += packet_buffer.size();
+        OutgoingPacket* hole = nullptr;
+        for (auto& packet : unacked_packets.packets) {
+            if (packet.is_sacked) {
+                if (hole) {
+                    resend_packet(*hole, routing_decision);
+                    return;
+                }
+                continue;
+            }
+            if (!hole && !packet.was_retransmitted_during_recovery)
+                hole = &packet;
         }
     });
 }
 
+void TCPSocket::resend_packet(OutgoingPacket& packet, RoutingDecision& routing_decision)
+{
+    packet.tx_counter++;
+    packet.was_retransmitted_during_recovery = true;
+
+    if constexpr (TCP_SOCKET_DEBUG) {
+        auto& tcp_packet = *(const TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
+        dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
+            local_address(), local_port(),
+            peer_address(), peer_port(),
+            (tcp_packet.has_syn() ? "SYN " : ""),
+            (tcp_packet.has_ack() ? "ACK " : ""),
+            (tcp_packet.has_fin() ? "FIN " : ""),
+            (tcp_packet.has_rst() ? "RST " : ""),
+            tcp_packet.sequence_number(),
+            tcp_packet.ack_number(),
+            packet.tx_counter);
+    }
+
+    size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
+    if (ipv4_payload_offset != packet.ipv4_payload_offset) {
+        // FIXME: Add support for this. This can happen if after a route change
+        // we ended up on another adapter which doesn't have the same layer 2 type
+        // like the previous adapter.
+        VERIFY_NOT_REACHED();
+    }
+
+    auto packet_buffer = packet.buffer->bytes();
+
+    routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
+        local_address(), routing_decision.next_hop, peer_address(),
+        IPv4Protocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
+    routing_decision.adapter->send_packet(packet_buffer);
+    m_packets_out++;
+    m_bytes_out += packet_buffer.size();
+}
+
 bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size) const
 {
     if (!IPv4Socket::can_write(file_description, size))
@@ -648,11 +1081,9 @@ bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size)
     if (m_state == State::SynSent || m_state == State::SynReceived)
         return false;
 
-    if (!file_description.is_blocking())
-        return true;
-
+    // This matches protocol_send(), which always sends something when nothing is in flight.
     return m_unacked_packets.with_shared([&](auto& unacked_packets) {
-        return unacked_packets.size + size <= m_send_window_size;
+        return unacked_packets.size == 0 || unacked_packets.size < send_window();
     });
 }
 }
@@ -6,13 +6,17 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/Error.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/SinglyLinkedList.h>
+#include <AK/Vector.h>
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Net/IPv4Socket.h>
+#include <Kernel/Net/TCP.h>
+#include <Kernel/Net/TCPCongestionControl.h>
 
 namespace Kernel {
 
@@ -136,6 +140,8 @@ public:
 
     // FIXME: Make this configurable?
     static constexpr u32 maximum_duplicate_acks = 5;
+    // RFC 5681 says three duplicate ACKs in a row mean a segment was lost.
+    static constexpr u32 fast_retransmit_threshold = 3;
     void set_duplicate_acks(u32 acks) { m_duplicate_acks = acks; }
     u32 duplicate_acks() const { return m_duplicate_acks; }
 
@@ -143,6 +149,20 @@ public:
     ErrorOr<void> send_tcp_packet(u16 flags, UserOrKernelBuffer const* = nullptr, size_t = 0, RoutingDecision* = nullptr);
     void receive_tcp_packet(TCPPacket const&, u16 size);
 
+    // Picks up the MSS, window scale and SACK options the peer sent with its SYN.
+    void process_syn_options(TCPPacket const&);
+
+    // Segments that arrive ahead of a hole are kept around until the hole has been filled,
+    // so the sender only has to retransmit what was actually lost.
+    bool queue_out_of_order_segment(IPv4Packet const&, TCPPacket const&, size_t payload_size, Time const& packet_timestamp);
+    bool has_out_of_order_segments() const { return !m_out_of_order_segments.is_empty(); }
+    void deliver_out_of_order_segments();
+    void drop_out_of_order_segments();
+
+    TCPCongestionControl::Algorithm congestion_control_algorithm() const { return m_congestion_control->algorithm(); }
+    size_t congestion_window() const { return m_congestion_control->congestion_window(); }
+    u32 send_window_size() const { return m_send_window_size; }
+
     bool should_delay_next_ack() const;
 
     static MutexProtected<HashMap<IPv4SocketTuple, TCPSocket*>>& sockets_by_tuple();
@@ -168,7 +188,7 @@ protected:
     void set_direction(Direction direction) { m_direction = direction; }
 
 private:
-    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer);
+    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullOwnPtr<TCPCongestionControl>);
     virtual StringView class_name() const override { return "TCPSocket"sv; }
 
     virtual void shut_down_for_writing() override;
@@ -181,10 +201,31 @@ private:
     virtual bool protocol_is_disconnected() const override;
     virtual ErrorOr<void> protocol_bind() override;
     virtual ErrorOr<void> protocol_listen(bool did_allocate_port) override;
+    virtual void protocol_did_read_from_receive_buffer() override;
 
     void enqueue_for_retransmit();
     void dequeue_for_retransmit();
 
+    struct OutgoingPacket;
+    void resend_packet(OutgoingPacket&, RoutingDecision&);
+
+    enum class RetransmitCandidate {
+        FirstUnacknowledged,
+        // Only retransmit a packet if the peer has SACKed data after it, so we know it's missing.
+        KnownLost,
+    };
+    void retransmit_next_packet(RetransmitCandidate);
+
+    void process_ack(TCPPacket const&, size_t payload_size);
+    void update_rtt_estimate(Time sample);
+    Time retransmit_timeout() const;
+
+    size_t send_window() const { return min<size_t>(m_send_window_size, m_congestion_control->congestion_window()); }
+    size_t maximum_segment_size(RoutingDecision const&) const;
+    u32 receive_window() const;
+
+    Vector<TCPSACKBlock, TCPOptionSACK::maximum_blocks> sack_blocks_to_send() const;
+
     LockWeakPtr<TCPSocket> m_originator;
     HashMap<IPv4SocketTuple, NonnullLockRefPtr<TCPSocket>> m_pending_release_for_accept;
     Direction m_direction { Direction::Unspecified };
@@ -204,6 +245,10 @@ private:
         size_t ipv4_payload_offset;
         LockWeakPtr<NetworkAdapter> adapter;
         int tx_counter { 0 };
+        u32 sequence_number { 0 };
+        size_t payload_size { 0 };
+        bool is_sacked { false };
+        bool was_retransmitted_during_recovery { false };
     };
 
     struct UnackedPackets {
@@ -214,17 +259,53 @@ private:
     MutexProtected<UnackedPackets> m_unacked_packets;
 
     u32 m_duplicate_acks { 0 };
+    u32 m_duplicate_acks_received { 0 };
+
+    // The oldest sequence number that hasn't been acknowledged yet (SND.UNA).
+    u32 m_send_unacknowledged { 0 };
+
+    NonnullOwnPtr<TCPCongestionControl> m_congestion_control;
+
+    enum class LossRecovery {
+        None,
+        FastRecovery,
+        AfterRetransmitTimeout,
+    };
+    LossRecovery m_loss_recovery { LossRecovery::None };
+    // Once everything up to here has been acknowledged, we're done recovering from a loss (RFC 6582).
+    u32 m_recovery_point { 0 };
+
+    Optional<Time> m_smoothed_rtt;
+    Time m_rtt_variance;
 
     u32 m_last_ack_number_sent { 0 };
     Time m_last_ack_sent_time;
 
     // FIXME: Make this configurable (sysctl)
     static constexpr u32 maximum_retransmits = 5;
-    Time m_last_retransmit_time;
+    Time m_retransmit_timer_start;
     u32 m_retransmit_attempts { 0 };
 
-    // FIXME: Parse window size TCP option from the peer
     u32 m_send_window_size { 64 * KiB };
+    u32 m_last_advertised_window { 0 };
+
+    // The MSS the peer is willing to receive. Until it tells us otherwise, it's 536 (RFC 1122, section 4.2.2.6).
+    u16 m_peer_maximum_segment_size { 536 };
+    bool m_window_scaling_enabled { false };
+    u8 m_send_window_scale { 0 };
+    bool m_sack_permitted { false };
+
+    struct OutOfOrderSegment {
+        u32 sequence_number { 0 };
+        size_t payload_size { 0 };
+        Time timestamp;
+        ByteBuffer ipv4_packet;
+    };
+
+    static constexpr size_t maximum_out_of_order_segments = 256;
+    // Ordered by sequence number.
+    Vector<OutOfOrderSegment> m_out_of_order_segments;
+    u32 m_last_out_of_order_sequence_number { 0 };
 
     IntrusiveListNode<TCPSocket> m_retransmit_list_node;
 
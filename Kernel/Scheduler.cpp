@@ -44,9 +44,29 @@ struct ThreadReadyQueues {
     u32 mask {};
     static constexpr size_t count = sizeof(mask) * 8;
     Array<ThreadReadyQueue, count> queues;
+
+    Thread* find_runnable_thread(u64 affinity_mask);
+    void append(Thread&, u32 priority);
+    void remove(Thread&);
+};
+
+// Every processor has ready queues of its own, so a processor picking its next thread
+// only has to lock its own queues. Only once those run dry does it look at the queues
+// of the other processors, and steal a thread from the one with the most threads waiting.
+struct ProcessorReadyQueues {
+    SpinlockProtected<ThreadReadyQueues, LockRank::None> ready_queues;
+    Atomic<u32> thread_count { 0 };
+
+    Atomic<u64> context_switches { 0 };
+    Atomic<u64> stolen_threads { 0 };
+    Atomic<u64> migrated_threads { 0 };
 };
 
-static Singleton<SpinlockProtected<ThreadReadyQueues, LockRank::None>> g_ready_queues;
+static Singleton<Array<ProcessorReadyQueues, MAX_CPU_COUNT>> s_processor_ready_queues;
+
+// A thread stays with the processor it last ran on unless that processor has at least
+// this many more threads waiting than the least busy processor the thread may run on.
+static constexpr u32 affinity_imbalance_threshold = 2;
 
 static SpinlockProtected<TotalTimeScheduled, LockRank::None> g_total_time_scheduled {};
 
@@ -55,7 +75,7 @@ static void dump_thread_list(bool = false);
 static inline u32 thread_priority_to_priority_index(u32 thread_priority)
 {
     // Converts the priority in the range of THREAD_PRIORITY_MIN...THREAD_PRIORITY_MAX
-    // to a index into g_ready_queues where 0 is the highest priority bucket
+    // to a index into the ready queues where 0 is the highest priority bucket
     VERIFY(thread_priority >= THREAD_PRIORITY_MIN && thread_priority <= THREAD_PRIORITY_MAX);
     constexpr u32 thread_priority_count = THREAD_PRIORITY_MAX - THREAD_PRIORITY_MIN + 1;
     static_assert(thread_priority_count > 0);
@@ -64,71 +84,181 @@ static inline u32 thread_priority_to_priority_index(u32 thread_priority)
     return priority_bucket;
 }
 
-Thread& Scheduler::pull_next_runnable_thread()
+Thread* ThreadReadyQueues::find_runnable_thread(u64 affinity_mask)
 {
-    auto affinity_mask = 1u << Processor::current_id();
-
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread& {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                thread.m_runnable_priority = -1;
-                ready_queue.thread_list.remove(thread);
-                if (ready_queue.thread_list.is_empty())
-                    ready_queues.mask &= ~(1u << priority);
-                // Mark it as active because we are using this thread. This is similar
-                // to comparing it with Processor::current_thread, but when there are
-                // multiple processors there's no easy way to check whether the thread
-                // is actually still needed. This prevents accidental finalization when
-                // a thread is no longer in Running state, but running on another core.
-
-                // We need to mark it active here so that this thread won't be
-                // scheduled on another core if it were to be queued before actually
-                // switching to it.
-                // FIXME: Figure out a better way maybe?
-                thread.set_active(true);
-                return thread;
-            }
-            priority_mask &= ~(1u << priority);
+    auto priority_mask = mask;
+    while (priority_mask != 0) {
+        auto priority = bit_scan_forward(priority_mask);
+        VERIFY(priority > 0);
+        auto& ready_queue = queues[--priority];
+        for (auto& thread : ready_queue.thread_list) {
+            VERIFY(thread.m_runnable_priority == (int)priority);
+            if (thread.is_active())
+                continue;
+            if (!(thread.affinity() & affinity_mask))
+                continue;
+            return &thread;
         }
-        return *Processor::idle_thread();
-    });
+        priority_mask &= ~(1u << priority);
+    }
+    return nullptr;
 }
 
-Thread* Scheduler::peek_next_runnable_thread()
+void ThreadReadyQueues::append(Thread& thread, u32 priority)
 {
-    auto affinity_mask = 1u << Processor::current_id();
+    VERIFY(thread.m_runnable_priority < 0);
+    thread.m_runnable_priority = (int)priority;
+    VERIFY(!thread.m_ready_queue_node.is_in_list());
+    auto& ready_queue = queues[priority];
+    bool was_empty = ready_queue.thread_list.is_empty();
+    ready_queue.thread_list.append(thread);
+    if (was_empty)
+        mask |= (1u << priority);
+}
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread* {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                return &thread;
-            }
-            priority_mask &= ~(1u << priority);
-        }
+void ThreadReadyQueues::remove(Thread& thread)
+{
+    auto priority = thread.m_runnable_priority;
+    VERIFY(priority >= 0);
+    VERIFY(mask & (1u << priority));
+    auto& ready_queue = queues[priority];
+    thread.m_runnable_priority = -1;
+    ready_queue.thread_list.remove(thread);
+    if (ready_queue.thread_list.is_empty())
+        mask &= ~(1u << priority);
+}
 
-        // Unlike in pull_next_runnable_thread() we don't want to fall back to
-        // the idle thread. We just want to see if we have any other thread ready
-        // to be scheduled.
+static Thread* take_runnable_thread(ProcessorReadyQueues& processor_ready_queues, u64 affinity_mask)
+{
+    if (processor_ready_queues.thread_count.load(AK::MemoryOrder::memory_order_relaxed) == 0)
         return nullptr;
+
+    auto* thread = processor_ready_queues.ready_queues.with([&](auto& ready_queues) -> Thread* {
+        auto* candidate = ready_queues.find_runnable_thread(affinity_mask);
+        if (!candidate)
+            return nullptr;
+        ready_queues.remove(*candidate);
+        // Mark it as active because we are using this thread. This is similar
+        // to comparing it with Processor::current_thread, but when there are
+        // multiple processors there's no easy way to check whether the thread
+        // is actually still needed. This prevents accidental finalization when
+        // a thread is no longer in Running state, but running on another core.
+
+        // We need to mark it active here so that this thread won't be
+        // scheduled on another core if it were to be queued before actually
+        // switching to it.
+        // FIXME: Figure out a better way maybe?
+        candidate->set_active(true);
+        return candidate;
     });
+    if (thread)
+        processor_ready_queues.thread_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+    return thread;
+}
+
+static Thread* steal_runnable_thread(u32 processor_id)
+{
+    auto affinity_mask = 1ull << processor_id;
+    auto processor_count = Processor::count();
+
+    // Visit the other processors from the busiest to the least busy one, as a thread waiting
+    // on a busy processor would otherwise have to wait the longest.
+    u64 visited_processors = 1ull << processor_id;
+    while (true) {
+        Optional<u32> busiest_processor_id;
+        u32 busiest_thread_count = 0;
+        for (u32 id = 0; id < processor_count; ++id) {
+            if (visited_processors & (1ull << id))
+                continue;
+            auto thread_count = s_processor_ready_queues->at(id).thread_count.load(AK::MemoryOrder::memory_order_relaxed);
+            if (thread_count > busiest_thread_count) {
+                busiest_processor_id = id;
+                busiest_thread_count = thread_count;
+            }
+        }
+        if (!busiest_processor_id.has_value())
+            return nullptr;
+
+        if (auto* thread = take_runnable_thread(s_processor_ready_queues->at(*busiest_processor_id), affinity_mask))
+            return thread;
+        visited_processors |= 1ull << *busiest_processor_id;
+    }
+}
+
+static u32 processor_for_runnable_thread(Thread const& thread)
+{
+    auto processor_count = Processor::count();
+    auto processor_mask = processor_count >= 64 ? NumericLimits<u64>::max() : (1ull << processor_count) - 1;
+    auto affinity = thread.affinity() & processor_mask;
+    if (affinity == 0)
+        return 0;
+
+    auto thread_count_of = [](u32 id) {
+        return s_processor_ready_queues->at(id).thread_count.load(AK::MemoryOrder::memory_order_relaxed);
+    };
+
+    // Prefer the processor the thread last ran on, as its caches may still be warm.
+    auto preferred_id = thread.cpu();
+    if (preferred_id >= processor_count || !(affinity & (1ull << preferred_id)))
+        preferred_id = bit_scan_forward(affinity) - 1;
+
+    auto least_busy_id = preferred_id;
+    for (auto remaining = affinity; remaining != 0;) {
+        auto id = bit_scan_forward(remaining) - 1;
+        remaining &= ~(1ull << id);
+        if (thread_count_of(id) < thread_count_of(least_busy_id))
+            least_busy_id = id;
+    }
+
+    if (thread_count_of(preferred_id) >= thread_count_of(least_busy_id) + affinity_imbalance_threshold)
+        return least_busy_id;
+    return preferred_id;
+}
+
+Thread& Scheduler::pull_next_runnable_thread()
+{
+    auto processor_id = Processor::current_id();
+    auto& processor_ready_queues = s_processor_ready_queues->at(processor_id);
+
+    if (auto* thread = take_runnable_thread(processor_ready_queues, 1ull << processor_id))
+        return *thread;
+
+    if (auto* thread = steal_runnable_thread(processor_id)) {
+        processor_ready_queues.stolen_threads.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        return *thread;
+    }
+
+    return *Processor::idle_thread();
+}
+
+bool Scheduler::has_next_runnable_thread()
+{
+    auto processor_id = Processor::current_id();
+    auto& processor_ready_queues = s_processor_ready_queues->at(processor_id);
+    if (processor_ready_queues.thread_count.load(AK::MemoryOrder::memory_order_relaxed) != 0) {
+        auto* thread = processor_ready_queues.ready_queues.with([&](auto& ready_queues) {
+            return ready_queues.find_runnable_thread(1ull << processor_id);
+        });
+        if (thread)
+            return true;
+    }
+
+    // Threads waiting on other processors count as well, since pull_next_runnable_thread()
+    // would try to steal one of them if our own queues are empty. This runs on every timer
+    // tick, so we only look at their thread counts instead of taking their locks. If none
+    // of those threads may run here, we merely end up picking the current thread again.
+    auto processor_count = Processor::count();
+    for (u32 id = 0; id < processor_count; ++id) {
+        if (id == processor_id)
+            continue;
+        if (s_processor_ready_queues->at(id).thread_count.load(AK::MemoryOrder::memory_order_relaxed) != 0)
+            return true;
+    }
+
+    // Unlike in pull_next_runnable_thread() we don't want to fall back to
+    // the idle thread. We just want to see if we have any other thread ready
+    // to be scheduled.
+    return false;
 }
 
 bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
@@ -136,24 +266,22 @@ bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
     if (thread.is_idle_thread())
         return true;
 
-    return g_ready_queues->with([&](auto& ready_queues) {
-        auto priority = thread.m_runnable_priority;
-        if (priority < 0) {
+    auto& processor_ready_queues = s_processor_ready_queues->at(thread.m_ready_queue_processor);
+    bool did_dequeue = processor_ready_queues.ready_queues.with([&](auto& ready_queues) {
+        if (thread.m_runnable_priority < 0) {
             VERIFY(!thread.m_ready_queue_node.is_in_list());
             return false;
         }
 
-        if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
+        if (check_affinity && !(thread.affinity() & (1ull << Processor::current_id())))
             return false;
 
-        VERIFY(ready_queues.mask & (1u << priority));
-        auto& ready_queue = ready_queues.queues[priority];
-        thread.m_runnable_priority = -1;
-        ready_queue.thread_list.remove(thread);
-        if (ready_queue.thread_list.is_empty())
-            ready_queues.mask &= ~(1u << priority);
+        ready_queues.remove(thread);
         return true;
     });
+    if (did_dequeue)
+        processor_ready_queues.thread_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+    return did_dequeue;
 }
 
 void Scheduler::enqueue_runnable_thread(Thread& thread)
@@ -163,16 +291,16 @@ void Scheduler::enqueue_runnable_thread(Thread& thread)
         return;
     auto priority = thread_priority_to_priority_index(thread.priority());
 
-    g_ready_queues->with([&](auto& ready_queues) {
-        VERIFY(thread.m_runnable_priority < 0);
-        thread.m_runnable_priority = (int)priority;
-        VERIFY(!thread.m_ready_queue_node.is_in_list());
-        auto& ready_queue = ready_queues.queues[priority];
-        bool was_empty = ready_queue.thread_list.is_empty();
-        ready_queue.thread_list.append(thread);
-        if (was_empty)
-            ready_queues.mask |= (1u << priority);
+    auto processor_id = processor_for_runnable_thread(thread);
+    auto& processor_ready_queues = s_processor_ready_queues->at(processor_id);
+    if (thread.is_initialized() && processor_id != thread.cpu())
+        processor_ready_queues.migrated_threads.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+
+    processor_ready_queues.ready_queues.with([&](auto& ready_queues) {
+        thread.m_ready_queue_processor = processor_id;
+        ready_queues.append(thread, priority);
     });
+    processor_ready_queues.thread_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
 }
 
 UNMAP_AFTER_INIT void Scheduler::start()
@@ -192,7 +320,7 @@ UNMAP_AFTER_INIT void Scheduler::start()
     idle_thread.set_initialized(true);
     processor.init_context(idle_thread, false);
     idle_thread.set_state(Thread::State::Running);
-    VERIFY(idle_thread.affinity() == (1u << processor.id()));
+    VERIFY(idle_thread.affinity() == (1ull << processor.id()));
     processor.initialize_context_switching(idle_thread);
     VERIFY_NOT_REACHED();
 }
@@ -285,6 +413,7 @@ void Scheduler::context_switch(Thread* thread)
     thread->set_state(Thread::State::Running);
 
     PerformanceManager::add_context_switch_perf_event(*from_thread, *thread);
+    s_processor_ready_queues->at(proc.id()).context_switches.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
 
     proc.switch_context(from_thread, thread);
 
@@ -393,7 +522,7 @@ UNMAP_AFTER_INIT Thread* Scheduler::create_ap_idle_thread(u32 cpu)
     VERIFY(Processor::is_bootstrap_processor());
 
     VERIFY(s_colonel_process);
-    Thread* idle_thread = s_colonel_process->create_kernel_thread(idle_loop, nullptr, THREAD_PRIORITY_MIN, MUST(KString::formatted("idle thread #{}", cpu)), 1 << cpu, false);
+    Thread* idle_thread = s_colonel_process->create_kernel_thread(idle_loop, nullptr, THREAD_PRIORITY_MIN, MUST(KString::formatted("idle thread #{}", cpu)), 1ull << cpu, false);
     VERIFY(idle_thread);
     return idle_thread;
 }
@@ -438,7 +567,7 @@ void Scheduler::timer_tick(RegisterState const& regs)
     if (current_thread->tick())
         return;
 
-    if (!current_thread->is_idle_thread() && !peek_next_runnable_thread()) {
+    if (!current_thread->is_idle_thread() && !has_next_runnable_thread()) {
         // If no other thread is ready to be scheduled we don't need to
         // switch to the idle thread. Just give the current thread another
         // time slice and let it run!
@@ -502,6 +631,17 @@ TotalTimeScheduled Scheduler::get_total_time_scheduled()
     return g_total_time_scheduled.with([&](auto& total_time_scheduled) { return total_time_scheduled; });
 }
 
+ProcessorSchedulingStatistics Scheduler::get_processor_scheduling_statistics(u32 processor_id)
+{
+    auto& processor_ready_queues = s_processor_ready_queues->at(processor_id);
+    return {
+        .context_switches = processor_ready_queues.context_switches.load(AK::MemoryOrder::memory_order_relaxed),
+        .stolen_threads = processor_ready_queues.stolen_threads.load(AK::MemoryOrder::memory_order_relaxed),
+        .migrated_threads = processor_ready_queues.migrated_threads.load(AK::MemoryOrder::memory_order_relaxed),
+        .runnable_threads = processor_ready_queues.thread_count.load(AK::MemoryOrder::memory_order_relaxed),
+    };
+}
+
 void dump_thread_list(bool with_stack_traces)
 {
     dbgln("Scheduler thread list for processor {}:", Processor::current_id());
@@ -29,6 +29,13 @@ struct TotalTimeScheduled {
     u64 total_kernel { 0 };
 };
 
+struct ProcessorSchedulingStatistics {
+    u64 context_switches { 0 };
+    u64 stolen_threads { 0 };
+    u64 migrated_threads { 0 };
+    u32 runnable_threads { 0 };
+};
+
 class Scheduler {
 public:
     static void initialize();
@@ -48,13 +55,14 @@ public:
     static void invoke_async();
     static void notify_finalizer();
     static Thread& pull_next_runnable_thread();
-    static Thread* peek_next_runnable_thread();
+    static bool has_next_runnable_thread();
     static bool dequeue_runnable_thread(Thread&, bool = false);
     static void enqueue_runnable_thread(Thread&);
     static void dump_scheduler_state(bool = false);
     static bool is_initialized();
     static TotalTimeScheduled get_total_time_scheduled();
     static void add_time_scheduled(u64, bool);
+    static ProcessorSchedulingStatistics get_processor_scheduling_statistics(u32 processor_id);
 };
 
 }
@@ -58,6 +58,8 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::initialize(bool is_queue_polled)
     VERIFY(IO_QUEUE_SIZE < MQES(caps));
     dbgln_if(NVME_DEBUG, "NVMe: IO queue depth is: {}", IO_QUEUE_SIZE);
 
+    TRY(identify_controller());
+
     // Create an IO queue per core
     for (u32 cpuid = 0; cpuid < nr_of_queues; ++cpuid) {
         // qid is zero is used for admin queue
@@ -146,6 +148,33 @@ UNMAP_AFTER_INIT u32 NVMeController::get_admin_q_dept()
     return q_depth;
 }
 
+UNMAP_AFTER_INIT ErrorOr<void> NVMeController::identify_controller()
+{
+    RefPtr<Memory::PhysicalPage> prp_dma_buffer;
+    auto prp_dma_region = TRY(MM.allocate_dma_buffer_page("Identify PRP"sv, Memory::Region::Access::ReadWrite, prp_dma_buffer));
+
+    NVMeSubmission sub {};
+    sub.op = OP_ADMIN_IDENTIFY;
+    sub.identify.data_ptr.prp1 = reinterpret_cast<u64>(AK::convert_between_host_and_little_endian(prp_dma_buffer->paddr().as_ptr()));
+    sub.identify.cns = NVMe_CNS_ID_CTRL & 0xff;
+    if (auto status = submit_admin_command(sub, true); status) {
+        dmesgln_pci(*this, "Failed to identify controller command");
+        return EFAULT;
+    }
+
+    u8 mdts;
+    if (void* fault_at; !safe_memcpy(&mdts, prp_dma_region->vaddr().offset(IDENTIFY_CTRL_MDTS_INDEX).as_ptr(), sizeof(mdts), fault_at))
+        return EFAULT;
+
+    // MDTS is a power of two in units of the minimum memory page size, and 0 means there's no limit.
+    if (mdts != 0) {
+        u64 max_transfer_pages = 1ull << (mdts + CAP_MPSMIN(m_controller_regs->cap));
+        m_max_transfer_pages = min<u64>(m_max_transfer_pages, max_transfer_pages);
+    }
+    dbgln_if(NVME_DEBUG, "NVMe: Maximum data transfer size is {} pages", m_max_transfer_pages);
+    return {};
+}
+
 UNMAP_AFTER_INIT ErrorOr<void> NVMeController::identify_and_init_namespaces()
 {
 
@@ -288,7 +317,7 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_admin_queue(Optional<u8> i
         return EFAULT;
     }
     set_admin_queue_ready_flag();
-    m_admin_queue = TRY(NVMeQueue::try_create(0, irq, qdepth, move(cq_dma_region), cq_dma_pages, move(sq_dma_region), sq_dma_pages, move(doorbell_regs)));
+    m_admin_queue = TRY(NVMeQueue::try_create(0, irq, qdepth, 0, move(cq_dma_region), cq_dma_pages, move(sq_dma_region), sq_dma_pages, move(doorbell_regs)));
 
     dbgln_if(NVME_DEBUG, "NVMe: Admin queue created");
     return {};
@@ -348,7 +377,7 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_io_queue(u8 qid, Optional<
     auto queue_doorbell_offset = REG_SQ0TDBL_START + ((2 * qid) * (4 << m_dbl_stride));
     auto doorbell_regs = TRY(Memory::map_typed_writable<DoorbellRegister volatile>(PhysicalAddress(m_bar + queue_doorbell_offset)));
 
-    m_queues.append(TRY(NVMeQueue::try_create(qid, irq, IO_QUEUE_SIZE, move(cq_dma_region), cq_dma_pages, move(sq_dma_region), sq_dma_pages, move(doorbell_regs))));
+    m_queues.append(TRY(NVMeQueue::try_create(qid, irq, IO_QUEUE_SIZE, m_max_transfer_pages, move(cq_dma_region), cq_dma_pages, move(sq_dma_region), sq_dma_pages, move(doorbell_regs))));
     dbgln_if(NVME_DEBUG, "NVMe: Created IO Queue with QID{}", m_queues.size());
     return {};
 }
@@ -58,6 +58,7 @@ public:
 private:
     NVMeController(PCI::DeviceIdentifier const&, u32 hardware_relative_controller_id);
 
+    ErrorOr<void> identify_controller();
     ErrorOr<void> identify_and_init_namespaces();
     Tuple<u64, u8> get_ns_features(IdentifyNamespace& identify_data_struct);
     ErrorOr<void> create_admin_queue(Optional<u8> irq);
@@ -78,6 +79,7 @@ private:
     AK::Time m_ready_timeout;
     u32 m_bar { 0 };
     u8 m_dbl_stride { 0 };
+    u32 m_max_transfer_pages { IO_MAX_TRANSFER_PAGES };
     static Atomic<u8> s_controller_id;
 };
 }
@@ -55,6 +55,13 @@ static constexpr u32 CAP_TO(u64 cap)
     return (cap & CAP_TO_MASK) >> CAP_TO_SHIFT;
 }
 
+static constexpr u8 CAP_MPSMIN_SHIFT = 48;
+static constexpr u64 CAP_MPSMIN_MASK = 0xfull << CAP_MPSMIN_SHIFT;
+static constexpr u8 CAP_MPSMIN(u64 cap)
+{
+    return (cap & CAP_MPSMIN_MASK) >> CAP_MPSMIN_SHIFT;
+}
+
 // CC – Controller Configuration
 static constexpr u8 CC_EN_BIT = 0x0;
 static constexpr u8 CSTS_RDY_BIT = 0x0;
@@ -99,10 +106,19 @@ static constexpr u16 CQ_STATUS_FIELD(u16 x)
 
 static constexpr u16 IO_QUEUE_SIZE = 64; // TODO:Need to be configurable
 
+// Every IO queue has this many commands in flight at most, each with its own DMA buffer.
+static constexpr u16 IO_QUEUE_MAX_OUTSTANDING_COMMANDS = 8;
+// The size of each of those DMA buffers, unless the controller only allows smaller transfers (MDTS).
+static constexpr u32 IO_MAX_TRANSFER_PAGES = 16;
+// How many adjacent block requests can be merged into a single command.
+static constexpr size_t IO_MAX_MERGED_REQUESTS = 16;
+
 // IDENTIFY
 static constexpr u16 NVMe_IDENTIFY_SIZE = 4096;
 static constexpr u8 NVMe_CNS_ID_ACTIVE_NS = 0x2;
 static constexpr u8 NVMe_CNS_ID_NS = 0x0;
+static constexpr u8 NVMe_CNS_ID_CTRL = 0x1;
+static constexpr u16 IDENTIFY_CTRL_MDTS_INDEX = 77;
 static constexpr u8 FLBA_SIZE_INDEX = 26;
 static constexpr u8 FLBA_SIZE_MASK = 0xf;
 static constexpr u8 LBA_FORMAT_SUPPORT_INDEX = 128;
@@ -25,18 +25,17 @@ UNMAP_AFTER_INIT NVMeNameSpace::NVMeNameSpace(LUNAddress logical_unit_number_add
 {
 }
 
+size_t NVMeNameSpace::max_blocks_per_request() const
+{
+    return m_queues.first().max_transfer_size() / block_size();
+}
+
 void NVMeNameSpace::start_request(AsyncBlockDeviceRequest& request)
 {
+    // Every processor has a queue of its own, so processors never have to wait for each other to submit a request.
     auto index = Processor::current_id();
     auto& queue = m_queues.at(index);
-    // TODO: For now we support only IO transfers of size PAGE_SIZE (Going along with the current constraint in the block layer)
-    // Eventually remove this constraint by using the PRP2 field in the submission struct and remove block layer constraint for NVMe driver.
-    VERIFY(request.block_count() <= (PAGE_SIZE / block_size()));
-
-    if (request.request_type() == AsyncBlockDeviceRequest::Read) {
-        queue.read(request, m_nsid, request.block_index(), request.block_count());
-    } else {
-        queue.write(request, m_nsid, request.block_index(), request.block_count());
-    }
+    VERIFY(request.block_count() <= max_blocks_per_request());
+    queue.submit_request(request, m_nsid);
 }
 }
@@ -5,6 +5,7 @@
  */
 
 #include <Kernel/Arch/Delay.h>
+#include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/StdLib.h>
 #include <Kernel/Storage/NVMe/NVMeController.h>
 #include <Kernel/Storage/NVMe/NVMeInterruptQueue.h>
@@ -12,35 +13,56 @@
 #include <Kernel/Storage/NVMe/NVMeQueue.h>
 
 namespace Kernel {
-ErrorOr<NonnullLockRefPtr<NVMeQueue>> NVMeQueue::try_create(u16 qid, Optional<u8> irq, u32 q_depth, OwnPtr<Memory::Region> cq_dma_region, NonnullRefPtrVector<Memory::PhysicalPage> cq_dma_page, OwnPtr<Memory::Region> sq_dma_region, NonnullRefPtrVector<Memory::PhysicalPage> sq_dma_page, Memory::TypedMapping<DoorbellRegister volatile> db_regs)
+ErrorOr<NonnullLockRefPtr<NVMeQueue>> NVMeQueue::try_create(u16 qid, Optional<u8> irq, u32 q_depth, u32 max_transfer_pages, OwnPtr<Memory::Region> cq_dma_region, NonnullRefPtrVector<Memory::PhysicalPage> cq_dma_page, OwnPtr<Memory::Region> sq_dma_region, NonnullRefPtrVector<Memory::PhysicalPage> sq_dma_page, Memory::TypedMapping<DoorbellRegister volatile> db_regs)
 {
-    // Note: Allocate DMA region for RW operation. For now the requests don't exceed more than 4096 bytes (Storage device takes care of it)
-    RefPtr<Memory::PhysicalPage> rw_dma_page;
-    auto rw_dma_region = TRY(MM.allocate_dma_buffer_page("NVMe Queue Read/Write DMA"sv, Memory::Region::Access::ReadWrite, rw_dma_page));
+    // Note: Every command slot of an IO queue gets its own DMA buffer, and a page for its PRP list
+    // in case the transfer is larger than two pages. The admin queue only transfers data to buffers it is given.
+    OwnPtr<Memory::Region> rw_dma_region;
+    NonnullRefPtrVector<Memory::PhysicalPage> rw_dma_pages;
+    OwnPtr<Memory::Region> prp_list_dma_region;
+    NonnullRefPtrVector<Memory::PhysicalPage> prp_list_dma_pages;
+    if (qid != 0) {
+        VERIFY(max_transfer_pages > 0);
+        rw_dma_region = TRY(MM.allocate_dma_buffer_pages(IO_QUEUE_MAX_OUTSTANDING_COMMANDS * max_transfer_pages * PAGE_SIZE, "NVMe Queue Read/Write DMA"sv, Memory::Region::Access::ReadWrite, rw_dma_pages));
+        prp_list_dma_region = TRY(MM.allocate_dma_buffer_pages(IO_QUEUE_MAX_OUTSTANDING_COMMANDS * PAGE_SIZE, "NVMe Queue PRP lists"sv, Memory::Region::Access::ReadWrite, prp_list_dma_pages));
+    }
     if (!irq.has_value()) {
-        auto queue = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) NVMePollQueue(move(rw_dma_region), *rw_dma_page, qid, q_depth, move(cq_dma_region), cq_dma_page, move(sq_dma_region), sq_dma_page, move(db_regs))));
+        auto queue = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) NVMePollQueue(move(rw_dma_region), move(rw_dma_pages), move(prp_list_dma_region), move(prp_list_dma_pages), qid, q_depth, max_transfer_pages, move(cq_dma_region), cq_dma_page, move(sq_dma_region), sq_dma_page, move(db_regs))));
         return queue;
     }
-    auto queue = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) NVMeInterruptQueue(move(rw_dma_region), *rw_dma_page, qid, irq.value(), q_depth, move(cq_dma_region), cq_dma_page, move(sq_dma_region), sq_dma_page, move(db_regs))));
+    auto queue = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) NVMeInterruptQueue(move(rw_dma_region), move(rw_dma_pages), move(prp_list_dma_region), move(prp_list_dma_pages), qid, irq.value(), q_depth, max_transfer_pages, move(cq_dma_region), cq_dma_page, move(sq_dma_region), sq_dma_page, move(db_regs))));
     return queue;
 }
 
-UNMAP_AFTER_INIT NVMeQueue::NVMeQueue(NonnullOwnPtr<Memory::Region> rw_dma_region, Memory::PhysicalPage const& rw_dma_page, u16 qid, u32 q_depth, OwnPtr<Memory::Region> cq_dma_region, NonnullRefPtrVector<Memory::PhysicalPage> cq_dma_page, OwnPtr<Memory::Region> sq_dma_region, NonnullRefPtrVector<Memory::PhysicalPage> sq_dma_page, Memory::TypedMapping<DoorbellRegister volatile> db_regs)
-    : m_current_request(nullptr)
-    , m_rw_dma_region(move(rw_dma_region))
-    , m_qid(qid)
+UNMAP_AFTER_INIT NVMeQueue::NVMeQueue(OwnPtr<Memory::Region> rw_dma_region, NonnullRefPtrVector<Memory::PhysicalPage> rw_dma_pages, OwnPtr<Memory::Region> prp_list_dma_region, NonnullRefPtrVector<Memory::PhysicalPage> prp_list_dma_pages, u16 qid, u32 q_depth, u32 max_transfer_pages, OwnPtr<Memory::Region> cq_dma_region, NonnullRefPtrVector<Memory::PhysicalPage> cq_dma_page, OwnPtr<Memory::Region> sq_dma_region, NonnullRefPtrVector<Memory::PhysicalPage> sq_dma_page, Memory::TypedMapping<DoorbellRegister volatile> db_regs)
+    : m_qid(qid)
     , m_admin_queue(qid == 0)
     , m_qdepth(q_depth)
+    , m_max_transfer_pages(max_transfer_pages)
     , m_cq_dma_region(move(cq_dma_region))
     , m_cq_dma_page(cq_dma_page)
     , m_sq_dma_region(move(sq_dma_region))
     , m_sq_dma_page(sq_dma_page)
     , m_db_regs(move(db_regs))
-    , m_rw_dma_page(rw_dma_page)
+    , m_rw_dma_region(move(rw_dma_region))
+    , m_rw_dma_pages(move(rw_dma_pages))
+    , m_prp_list_dma_region(move(prp_list_dma_region))
+    , m_prp_list_dma_pages(move(prp_list_dma_pages))
 
 {
     m_sqe_array = { reinterpret_cast<NVMeSubmission*>(m_sq_dma_region->vaddr().as_ptr()), m_qdepth };
     m_cqe_array = { reinterpret_cast<NVMeCompletion*>(m_cq_dma_region->vaddr().as_ptr()), m_qdepth };
+
+    if (m_admin_queue)
+        return;
+
+    // The DMA buffers never move, so the PRP lists pointing at their second and later pages can be filled in right away.
+    VERIFY(m_max_transfer_pages - 1 <= PAGE_SIZE / sizeof(u64));
+    for (u16 cmdid = 0; cmdid < IO_QUEUE_MAX_OUTSTANDING_COMMANDS; ++cmdid) {
+        auto* prp_list = reinterpret_cast<LittleEndian<u64>*>(m_prp_list_dma_region->vaddr().offset(cmdid * PAGE_SIZE).as_ptr());
+        for (size_t i = 1; i < m_max_transfer_pages; ++i)
+            prp_list[i - 1] = m_rw_dma_pages[cmdid * m_max_transfer_pages + i].paddr().get();
+    }
 }
 
 bool NVMeQueue::cqe_available()
@@ -73,13 +95,8 @@ u32 NVMeQueue::process_cq()
         // TODO: We don't use AsyncBlockDevice requests for admin queue as it is only applicable for a block device (NVMe namespace)
         //  But admin commands precedes namespace creation. Unify requests to avoid special conditions
         if (m_admin_queue == false) {
-            // As the block layer calls are now sync (as we wait on each requests),
-            // everything is operated on a single request similar to BMIDE driver.
-            // TODO: Remove this constraint eventually.
-            VERIFY(cmdid == m_prev_sq_tail);
-            if (m_current_request) {
-                complete_current_request(status);
-            }
+            VERIFY(cmdid < IO_QUEUE_MAX_OUTSTANDING_COMMANDS);
+            complete_command(cmdid, status);
         }
         update_cqe_head();
     }
@@ -92,9 +109,10 @@ u32 NVMeQueue::process_cq()
 void NVMeQueue::submit_sqe(NVMeSubmission& sub)
 {
     SpinlockLocker lock(m_sq_lock);
-    // For now let's use sq tail as a unique command id.
-    sub.cmdid = m_sq_tail;
-    m_prev_sq_tail = m_sq_tail;
+    // For now let's use sq tail as a unique command id for admin commands.
+    // IO commands are identified by their command slot instead.
+    if (m_admin_queue)
+        sub.cmdid = m_sq_tail;
 
     memcpy(&m_sqe_array[m_sq_tail], &sub, sizeof(NVMeSubmission));
     {
@@ -133,42 +151,145 @@ u16 NVMeQueue::submit_sync_sqe(NVMeSubmission& sub)
     return status;
 }
 
-void NVMeQueue::read(AsyncBlockDeviceRequest& request, u16 nsid, u64 index, u32 count)
+void NVMeQueue::submit_request(AsyncBlockDeviceRequest& request, u16 nsid)
 {
-    NVMeSubmission sub {};
-    SpinlockLocker m_lock(m_request_lock);
-    m_current_request = request;
+    VERIFY(!m_admin_queue);
+    VERIFY(request.block_count() * request.block_size() <= max_transfer_size());
+    {
+        SpinlockLocker lock(m_request_lock);
+        if (auto result = m_pending_requests.try_append({ request, nsid }); result.is_error()) {
+            lock.unlock();
+            request.complete(AsyncDeviceRequest::OutOfMemory);
+            return;
+        }
+    }
+    submit_pending_requests();
+}
 
-    sub.op = OP_NVME_READ;
-    sub.rw.nsid = nsid;
-    sub.rw.slba = AK::convert_between_host_and_little_endian(index);
-    // No. of lbas is 0 based
-    sub.rw.length = AK::convert_between_host_and_little_endian((count - 1) & 0xFFFF);
-    sub.rw.data_ptr.prp1 = reinterpret_cast<u64>(AK::convert_between_host_and_little_endian(m_rw_dma_page->paddr().as_ptr()));
+void NVMeQueue::set_data_pointer(DataPtr& data_ptr, u16 cmdid, size_t byte_count)
+{
+    auto first_page = cmdid * m_max_transfer_pages;
+    auto page_count = ceil_div(byte_count, static_cast<size_t>(PAGE_SIZE));
+    data_ptr.prp1 = reinterpret_cast<u64>(AK::convert_between_host_and_little_endian(m_rw_dma_pages[first_page].paddr().as_ptr()));
+    // PRP2 points at the second page if that's the last one, and at a list of all the remaining pages otherwise.
+    if (page_count == 2)
+        data_ptr.prp2 = reinterpret_cast<u64>(AK::convert_between_host_and_little_endian(m_rw_dma_pages[first_page + 1].paddr().as_ptr()));
+    else if (page_count > 2)
+        data_ptr.prp2 = reinterpret_cast<u64>(AK::convert_between_host_and_little_endian(m_prp_list_dma_pages[cmdid].paddr().as_ptr()));
+}
 
-    full_memory_barrier();
-    submit_sqe(sub);
+void NVMeQueue::submit_pending_requests()
+{
+    while (true) {
+        NVMeSubmission sub {};
+        Vector<NonnullLockRefPtr<AsyncBlockDeviceRequest>, IO_MAX_MERGED_REQUESTS> faulted_requests;
+        bool has_command = false;
+        {
+            SpinlockLocker lock(m_request_lock);
+            if (m_pending_requests.is_empty())
+                return;
+
+            Optional<u16> free_cmdid;
+            for (u16 cmdid = 0; cmdid < IO_QUEUE_MAX_OUTSTANDING_COMMANDS; ++cmdid) {
+                if (!m_io[cmdid].in_use) {
+                    free_cmdid = cmdid;
+                    break;
+                }
+            }
+            // All command slots are busy, the next completion will pick up the pending requests.
+            if (!free_cmdid.has_value())
+                return;
+            u16 cmdid = free_cmdid.value();
+            auto& io = m_io[cmdid];
+
+            auto& first_request = *m_pending_requests.first().request;
+            auto nsid = m_pending_requests.first().nsid;
+            auto request_type = first_request.request_type();
+            auto block_size = first_request.block_size();
+            u64 start_block = first_request.block_index();
+            u64 end_block = start_block;
+            size_t max_blocks = max_transfer_size() / block_size;
+
+            auto try_add_request = [&](size_t pending_index) {
+                auto request = m_pending_requests.take(pending_index).request;
+                if (request_type == AsyncBlockDeviceRequest::Write) {
+                    auto* buffer = io_buffer(cmdid) + (end_block - start_block) * block_size;
+                    if (auto result = request->read_from_buffer(request->buffer(), buffer, request->buffer_size()); result.is_error()) {
+                        faulted_requests.unchecked_append(move(request));
+                        return false;
+                    }
+                }
+                end_block += request->block_count();
+                io.requests.unchecked_append(move(request));
+                return true;
+            };
+
+            // Requests for the blocks right after the ones we already have go into the same command.
+            // They're usually queued up by another thread on this processor while all command slots were busy.
+            if (try_add_request(0)) {
+                for (size_t i = 0; i < m_pending_requests.size() && io.requests.size() < IO_MAX_MERGED_REQUESTS;) {
+                    auto& candidate = *m_pending_requests[i].request;
+                    bool is_adjacent = m_pending_requests[i].nsid == nsid
+                        && candidate.request_type() == request_type
+                        && candidate.block_index() == end_block
+                        && end_block + candidate.block_count() - start_block <= max_blocks;
+                    if (!is_adjacent) {
+                        ++i;
+                        continue;
+                    }
+                    if (!try_add_request(i))
+                        break;
+                    // An earlier pending request might continue where this one ends.
+                    i = 0;
+                }
+            }
+
+            if (!io.requests.is_empty()) {
+                io.in_use = true;
+                has_command = true;
+                auto block_count = end_block - start_block;
+                dbgln_if(NVME_DEBUG, "NVMe: Submitting {} requests for {} blocks at {} with command identifier {}", io.requests.size(), block_count, start_block, cmdid);
+
+                sub.op = request_type == AsyncBlockDeviceRequest::Read ? OP_NVME_READ : OP_NVME_WRITE;
+                sub.cmdid = cmdid;
+                sub.rw.nsid = nsid;
+                sub.rw.slba = AK::convert_between_host_and_little_endian(start_block);
+                // No. of lbas is 0 based
+                sub.rw.length = AK::convert_between_host_and_little_endian((block_count - 1) & 0xFFFF);
+                set_data_pointer(sub.rw.data_ptr, cmdid, block_count * block_size);
+            }
+        }
+
+        for (auto& request : faulted_requests)
+            request->complete(AsyncDeviceRequest::MemoryFault);
+
+        if (has_command) {
+            full_memory_barrier();
+            submit_sqe(sub);
+        }
+    }
 }
 
-void NVMeQueue::write(AsyncBlockDeviceRequest& request, u16 nsid, u64 index, u32 count)
+void NVMeQueue::complete_io(u16 cmdid, AsyncDeviceRequest::RequestResult result)
 {
-    NVMeSubmission sub {};
-    SpinlockLocker m_lock(m_request_lock);
-    m_current_request = request;
+    // Nobody else touches the requests of a command until its slot is marked as free again.
+    auto& io = m_io[cmdid];
+    VERIFY(io.in_use);
 
-    if (auto result = m_current_request->read_from_buffer(m_current_request->buffer(), m_rw_dma_region->vaddr().as_ptr(), m_current_request->buffer_size()); result.is_error()) {
-        complete_current_request(AsyncDeviceRequest::MemoryFault);
-        return;
+    u64 start_block = io.requests.first()->block_index();
+    for (auto& request : io.requests) {
+        auto request_result = result;
+        if (request_result == AsyncDeviceRequest::Success && request->request_type() == AsyncBlockDeviceRequest::RequestType::Read) {
+            auto* buffer = io_buffer(cmdid) + (request->block_index() - start_block) * request->block_size();
+            if (auto write_result = request->write_to_buffer(request->buffer(), buffer, request->buffer_size()); write_result.is_error())
+                request_result = AsyncDeviceRequest::MemoryFault;
+        }
+        request->complete(request_result);
     }
-    sub.op = OP_NVME_WRITE;
-    sub.rw.nsid = nsid;
-    sub.rw.slba = AK::convert_between_host_and_little_endian(index);
-    // No. of lbas is 0 based
-    sub.rw.length = AK::convert_between_host_and_little_endian((count - 1) & 0xFFFF);
-    sub.rw.data_ptr.prp1 = reinterpret_cast<u64>(AK::convert_between_host_and_little_endian(m_rw_dma_page->paddr().as_ptr()));
 
-    full_memory_barrier();
-    submit_sqe(sub);
+    SpinlockLocker lock(m_request_lock);
+    io.requests.clear();
+    io.in_use = false;
 }
 
 UNMAP_AFTER_INIT NVMeQueue::~NVMeQueue() = default;
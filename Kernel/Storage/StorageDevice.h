@@ -88,6 +88,10 @@ protected:
     // ^DiskDevice
     virtual StringView class_name() const override;
 
+    // The largest transfer a single AsyncBlockDeviceRequest may ask for. Most controllers
+    // only have a single page for their DMA buffer, so that's the default.
+    virtual size_t max_blocks_per_request() const { return m_blocks_per_page; }
+
 private:
     virtual ErrorOr<void> after_inserting() override;
     virtual void will_be_destroyed() override;
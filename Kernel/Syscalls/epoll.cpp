@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ScopeGuard.h>
+#include <Kernel/FileSystem/Epoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Process.h>
+#include <Kernel/Time/TimeManagement.h>
+
+namespace Kernel {
+
+ErrorOr<FlatPtr> Process::sys$epoll_create(u32 flags)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (flags & ~EPOLL_CLOEXEC)
+        return EINVAL;
+
+    auto epoll = TRY(Epoll::try_create());
+    auto description = TRY(OpenFileDescription::try_create(move(epoll)));
+    description->set_readable(true);
+
+    return m_fds.with_exclusive([&](auto& fds) -> ErrorOr<FlatPtr> {
+        auto fd_allocation = TRY(fds.allocate());
+        fds[fd_allocation.fd].set(move(description));
+
+        if (flags & EPOLL_CLOEXEC)
+            fds[fd_allocation.fd].set_flags(fds[fd_allocation.fd].flags() | FD_CLOEXEC);
+
+        return fd_allocation.fd;
+    });
+}
+
+ErrorOr<FlatPtr> Process::sys$epoll_ctl(int epfd, int op, int fd, Userspace<epoll_event const*> user_event)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto epoll_description = TRY(open_file_description(epfd));
+    if (!epoll_description->is_epoll())
+        return EINVAL;
+    auto& epoll = *epoll_description->epoll();
+
+    auto description = TRY(open_file_description(fd));
+    // FIXME: Support watching other epoll instances.
+    if (description->is_epoll())
+        return EINVAL;
+
+    switch (op) {
+    case EPOLL_CTL_ADD: {
+        auto event = TRY(copy_typed_from_user(user_event));
+        TRY(epoll.add_watch(fd, *description, event));
+        return 0;
+    }
+    case EPOLL_CTL_MOD: {
+        auto event = TRY(copy_typed_from_user(user_event));
+        TRY(epoll.modify_watch(fd, *description, event));
+        return 0;
+    }
+    case EPOLL_CTL_DEL:
+        TRY(epoll.remove_watch(fd, *description));
+        return 0;
+    default:
+        return EINVAL;
+    }
+}
+
+ErrorOr<FlatPtr> Process::sys$epoll_wait(Userspace<Syscall::SC_epoll_wait_params const*> user_params)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto params = TRY(copy_typed_from_user(user_params));
+    if (params.maxevents <= 0)
+        return EINVAL;
+
+    auto description = TRY(open_file_description(params.epfd));
+    if (!description->is_epoll())
+        return EINVAL;
+    auto& epoll = *description->epoll();
+
+    Thread::BlockTimeout timeout;
+    bool should_block = true;
+    if (params.timeout) {
+        auto timeout_time = TRY(copy_time_from_user(params.timeout));
+        should_block = timeout_time != Time::zero();
+        // The deadline is absolute, as waking up for a watch that turns out not to be ready anymore starts another wait.
+        auto deadline = TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE) + timeout_time;
+        timeout = Thread::BlockTimeout(true, &deadline);
+    }
+
+    sigset_t sigmask = {};
+    if (params.sigmask)
+        TRY(copy_from_user(&sigmask, params.sigmask));
+
+    auto* current_thread = Thread::current();
+
+    u32 previous_signal_mask = 0;
+    if (params.sigmask)
+        previous_signal_mask = current_thread->update_signal_mask(sigmask);
+    ScopeGuard rollback_signal_mask([&]() {
+        if (params.sigmask)
+            current_thread->update_signal_mask(previous_signal_mask);
+    });
+
+    auto max_events = min(static_cast<size_t>(params.maxevents), Epoll::max_events_per_wait);
+    Vector<epoll_event> events;
+    while (true) {
+        TRY(epoll.collect_ready_events(events, max_events));
+        if (!events.is_empty() || !should_block)
+            break;
+
+        Thread::FileBlocker::BlockFlags unblocked_flags {};
+        auto result = current_thread->block<Thread::ReadBlocker>(timeout, *description, unblocked_flags);
+        if (result.was_interrupted())
+            return EINTR;
+        if (result == Thread::BlockResult::InterruptedByTimeout)
+            break;
+    }
+
+    if (!events.is_empty())
+        TRY(copy_n_to_user(params.events, events.data(), events.size()));
+    return events.size();
+}
+
+}
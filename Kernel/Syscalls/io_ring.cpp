@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/IORing.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Process.h>
+#include <Kernel/Time/TimeManagement.h>
+
+namespace Kernel {
+
+ErrorOr<FlatPtr> Process::sys$io_ring_create(u32 entries, u32 flags)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (flags & ~IORING_CLOEXEC)
+        return EINVAL;
+
+    auto io_ring = TRY(IORing::try_create(entries));
+    auto description = TRY(OpenFileDescription::try_create(move(io_ring)));
+    // The queues are accessed by mapping the description with read and write access.
+    description->set_readable(true);
+    description->set_writable(true);
+
+    return m_fds.with_exclusive([&](auto& fds) -> ErrorOr<FlatPtr> {
+        auto fd_allocation = TRY(fds.allocate());
+        fds[fd_allocation.fd].set(move(description));
+
+        if (flags & IORING_CLOEXEC)
+            fds[fd_allocation.fd].set_flags(fds[fd_allocation.fd].flags() | FD_CLOEXEC);
+
+        return fd_allocation.fd;
+    });
+}
+
+ErrorOr<FlatPtr> Process::sys$io_ring_enter(Userspace<Syscall::SC_io_ring_enter_params const*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    auto description = TRY(open_file_description(params.fd));
+    if (!description->is_io_ring())
+        return EINVAL;
+
+    Optional<Time> deadline;
+    if (params.timeout) {
+        auto timeout_time = TRY(copy_time_from_user(params.timeout));
+        deadline = TimeManagement::the().current_time(CLOCK_MONOTONIC_COARSE) + timeout_time;
+    }
+
+    return TRY(description->io_ring()->enter(*this, params.to_submit, params.min_complete, deadline));
+}
+
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/KBuffer.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+// Data is moved through a kernel buffer of at most this size, one chunk at a time.
+static constexpr size_t sendfile_chunk_size = 64 * KiB;
+
+static ErrorOr<void> wait_until_readable(OpenFileDescription& description)
+{
+    if (description.can_read())
+        return {};
+    if (!description.is_blocking())
+        return EAGAIN;
+    auto unblock_flags = Thread::FileBlocker::BlockFlags::None;
+    if (Thread::current()->block<Thread::ReadBlocker>({}, description, unblock_flags).was_interrupted())
+        return EINTR;
+    if (!has_flag(unblock_flags, Thread::FileBlocker::BlockFlags::Read))
+        return EAGAIN;
+    return {};
+}
+
+// NOTE: The offset is passed by pointer because off_t is 64bit,
+// hence it can't be passed by register on 32bit platforms.
+ErrorOr<FlatPtr> Process::sys$sendfile(int out_fd, int in_fd, Userspace<off_t*> userspace_offset, size_t count)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    if (count > NumericLimits<ssize_t>::max())
+        return EINVAL;
+    dbgln_if(IO_DEBUG, "sys$sendfile({}, {}, {}, {})", out_fd, in_fd, userspace_offset.ptr(), count);
+
+    auto in_description = TRY(open_file_description(in_fd));
+    if (!in_description->is_readable())
+        return EBADF;
+    if (in_description->is_directory())
+        return EISDIR;
+    auto out_description = TRY(open_file_description(out_fd));
+    if (!out_description->is_writable())
+        return EBADF;
+
+    // Seekable inputs are read at an explicit offset, so that data which couldn't be written out isn't consumed.
+    // Anything read from other inputs (like pipes) can't be put back, so it has to be written out in full.
+    bool input_is_seekable = in_description->file().is_seekable();
+    if (!input_is_seekable) {
+        if (userspace_offset)
+            return ESPIPE;
+        if (!out_description->is_blocking())
+            return EINVAL;
+    }
+
+    off_t offset = 0;
+    if (userspace_offset) {
+        offset = TRY(copy_typed_from_user(userspace_offset));
+        if (offset < 0)
+            return EINVAL;
+    } else if (input_is_seekable) {
+        offset = in_description->offset();
+    }
+
+    if (count == 0)
+        return 0;
+
+    auto buffer = TRY(KBuffer::try_create_with_size("sendfile"sv, min(count, sendfile_chunk_size)));
+    auto kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer->data());
+
+    size_t total_nwritten = 0;
+    while (total_nwritten < count) {
+        auto chunk_size = min(count - total_nwritten, buffer->size());
+
+        ErrorOr<size_t> nread_or_error = 0;
+        if (input_is_seekable) {
+            nread_or_error = in_description->read(kernel_buffer, offset + total_nwritten, chunk_size);
+        } else if (auto result = wait_until_readable(*in_description); result.is_error()) {
+            nread_or_error = result.release_error();
+        } else {
+            nread_or_error = in_description->read(kernel_buffer, chunk_size);
+        }
+        if (nread_or_error.is_error()) {
+            if (total_nwritten > 0)
+                break;
+            return nread_or_error.release_error();
+        }
+        auto nread = nread_or_error.value();
+        if (nread == 0)
+            break;
+
+        auto nwritten_or_error = do_write(*out_description, kernel_buffer, nread);
+        if (nwritten_or_error.is_error()) {
+            if (total_nwritten > 0)
+                break;
+            return nwritten_or_error.release_error();
+        }
+        total_nwritten += nwritten_or_error.value();
+        if (nwritten_or_error.value() < nread)
+            break;
+
+        // Don't wait for more data from an unseekable input once something has been sent.
+        if (!input_is_seekable && !in_description->can_read())
+            break;
+    }
+
+    off_t new_offset = offset + static_cast<off_t>(total_nwritten);
+    if (userspace_offset)
+        TRY(copy_to_user(userspace_offset, &new_offset));
+    else if (input_is_seekable)
+        TRY(in_description->seek(new_offset, SEEK_SET));
+    return total_nwritten;
+}
+
+}
@@ -48,7 +48,7 @@ struct ThreadSpecificData {
     ThreadSpecificData* self;
 };
 
-#define THREAD_AFFINITY_DEFAULT 0xffffffff
+#define THREAD_AFFINITY_DEFAULT 0xffffffffffffffff
 
 class Thread
     : public ListedRefCounted<Thread, LockType::Spinlock>
@@ -59,6 +59,7 @@ class Thread
     friend class Mutex;
     friend class Process;
     friend class Scheduler;
+    friend struct ThreadReadyQueues;
     friend struct ThreadReadyQueue;
 
 public:
@@ -768,8 +769,8 @@ public:
 
     u32 cpu() const { return m_cpu.load(AK::MemoryOrder::memory_order_consume); }
     void set_cpu(u32 cpu) { m_cpu.store(cpu, AK::MemoryOrder::memory_order_release); }
-    u32 affinity() const { return m_cpu_affinity; }
-    void set_affinity(u32 affinity) { m_cpu_affinity = affinity; }
+    u64 affinity() const { return m_cpu_affinity; }
+    void set_affinity(u64 affinity) { m_cpu_affinity = affinity; }
 
     RegisterState& get_register_dump_from_stack();
     RegisterState const& get_register_dump_from_stack() const { return const_cast<Thread*>(this)->get_register_dump_from_stack(); }
@@ -1089,6 +1090,7 @@ private:
 
     IntrusiveListNode<Thread> m_process_thread_list_node;
     int m_runnable_priority { -1 };
+    u32 m_ready_queue_processor { 0 };
 
     friend class WaitQueue;
 
@@ -1162,7 +1164,7 @@ private:
     u32 m_saved_critical { 1 };
     IntrusiveListNode<Thread> m_ready_queue_node;
     Atomic<u32> m_cpu { 0 };
-    u32 m_cpu_affinity { THREAD_AFFINITY_DEFAULT };
+    u64 m_cpu_affinity { THREAD_AFFINITY_DEFAULT };
     Optional<u64> m_last_time_scheduled;
     Atomic<u64> m_total_time_scheduled_user { 0 };
     Atomic<u64> m_total_time_scheduled_kernel { 0 };
@@ -65,9 +65,58 @@ def parse_typed_value(ast):
     if len(ast) == 2 and ast[0][0] in types:
         return {"type": types[ast[0][0]], "value": ast[1][0]}
 
+    # (v128.const <shape> lane...)
+    if len(ast) > 2 and ast[0][0] == 'v128.const':
+        return {"type": "v128", "shape": ast[1][0], "value": [lane[0] for lane in ast[2:]]}
+
     return {"type": "error"}
 
 
+vector_shapes = {
+    'i8x16': ('<b', '<B'),
+    'i16x8': ('<h', '<H'),
+    'i32x4': ('<i', '<I'),
+    'i64x2': ('<q', '<Q'),
+    'f32x4': ('<f', '<I'),
+    'f64x2': ('<d', '<Q'),
+}
+
+
+def has_comparable_lanes(spec):
+    # NaN lanes of results are only specified to be canonical or arithmetic, not bit for bit.
+    return spec['type'] != 'v128' or not any(lane in ('nan:canonical', 'nan:arithmetic') for lane in spec['value'])
+
+
+def vector_lane_bytes(shape, lane):
+    float_format, bits_format = vector_shapes[shape]
+    lane = lane.replace('_', '')
+    if not shape.startswith('f'):
+        bits = struct.calcsize(bits_format) * 8
+        return struct.pack(bits_format, int(lane, 0) & ((1 << bits) - 1))
+
+    sign = lane.startswith('-')
+    magnitude = lane.lstrip('+-')
+    if magnitude.startswith('nan'):
+        exponent_bits, mantissa_bits = (8, 23) if shape == 'f32x4' else (11, 52)
+        payload = int(magnitude[4:], 16) if magnitude.startswith('nan:0x') else 1 << (mantissa_bits - 1)
+        value = (sign << (exponent_bits + mantissa_bits)) | (((1 << exponent_bits) - 1) << mantissa_bits) | payload
+        return struct.pack(bits_format, value)
+
+    if magnitude == 'inf':
+        return struct.pack(float_format, -math.inf if sign else math.inf)
+
+    try:
+        return struct.pack(float_format, float(lane))
+    except ValueError:
+        return struct.pack(float_format, float.fromhex(lane))
+
+
+def genvector(spec):
+    # Vectors are passed as BigInts, with the first lane in the least significant bits.
+    data = b''.join(vector_lane_bytes(spec['shape'], lane) for lane in spec['value'])
+    return hex(int.from_bytes(data, 'little')) + 'n'
+
+
 def generate_module_source_for_compilation(entries):
     s = '('
     for entry in entries:
@@ -283,6 +332,9 @@ def genarg(spec):
     if spec['type'] == 'error':
         return '0'
 
+    if spec['type'] == 'v128':
+        return genvector(spec)
+
     def gen():
         x = spec['value']
         if spec['type'] in ('i32', 'i64'):
@@ -359,7 +411,8 @@ def genresult(ident, entry, index):
     if entry['kind'] == 'return':
         return (
                 f'let {ident}_result = {expectation};\n    ' +
-                (f'expect({ident}_result).toBe({genarg(entry["result"])})\n    ' if entry["result"] is not None else '')
+                (f'expect({ident}_result).toBe({genarg(entry["result"])})\n    '
+                 if entry["result"] is not None and has_comparable_lanes(entry["result"]) else '')
         )
 
     if entry['kind'] == 'ignore':
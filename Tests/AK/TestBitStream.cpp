@@ -119,3 +119,30 @@ TEST_CASE(big_endian_bit_stream_input_output_match)
         EXPECT_EQ(0b1101001000100001u, result);
     }
 }
+
+TEST_CASE(little_endian_bit_stream_peek_and_read_ahead)
+{
+    Array<u8, 12> const data { 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0, 0x0f, 0xa5, 0x3c, 0x69 };
+    auto memory_stream = make<FixedMemoryStream>(data);
+    LittleEndianInputBitStream bit_stream { move(memory_stream) };
+
+    EXPECT_EQ(MUST(bit_stream.peek_bits(12)), 0x412u);
+    EXPECT_EQ(MUST(bit_stream.read_bits(4)), 0x2u);
+    EXPECT_EQ(MUST(bit_stream.read_bits(12)), 0x341u);
+
+    // Byte-wise reads continue with the bytes that have already been buffered.
+    Array<u8, 2> bytes;
+    MUST(bit_stream.read_entire_buffer(bytes));
+    EXPECT_EQ(bytes[0], 0x56);
+    EXPECT_EQ(bytes[1], 0x78);
+
+    // Reads that are wider than the buffer are split up.
+    EXPECT_EQ(MUST(bit_stream.read_bits(60)), 0x93ca50ff0debc9aull);
+    EXPECT_EQ(MUST(bit_stream.read_bit()), false);
+
+    // Peeking past the end of the stream pads with zeroes, but the padding can't be consumed.
+    EXPECT_EQ(MUST(bit_stream.peek_bits(8)), 0x3u);
+    EXPECT(!bit_stream.discard_previously_peeked_bits(3).is_error());
+    EXPECT(bit_stream.discard_previously_peeked_bits(1).is_error());
+    EXPECT(bit_stream.is_eof());
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+struct Pipe {
+    Pipe()
+    {
+        VERIFY(pipe(fds) == 0);
+    }
+
+    ~Pipe()
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    int read_fd() const { return fds[0]; }
+    int write_fd() const { return fds[1]; }
+
+    void write_byte() const
+    {
+        char c = 'x';
+        VERIFY(write(write_fd(), &c, 1) == 1);
+    }
+
+    void read_byte() const
+    {
+        char c;
+        VERIFY(read(read_fd(), &c, 1) == 1);
+    }
+
+    int fds[2];
+};
+
+static void watch(int epoll_fd, int fd, u32 events, u64 data)
+{
+    epoll_event event {};
+    event.events = events;
+    event.data.u64 = data;
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event), 0);
+}
+
+TEST_CASE(level_triggered_read)
+{
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    EXPECT(epoll_fd >= 0);
+    Pipe pipe;
+    watch(epoll_fd, pipe.read_fd(), EPOLLIN, 42);
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    pipe.write_byte();
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(events[0].events, static_cast<u32>(EPOLLIN));
+    EXPECT_EQ(events[0].data.u64, 42u);
+
+    // The pipe is still readable, so it should be reported again.
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+
+    pipe.read_byte();
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+    close(epoll_fd);
+}
+
+TEST_CASE(edge_triggered_read)
+{
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    Pipe pipe;
+    watch(epoll_fd, pipe.read_fd(), EPOLLIN | EPOLLET, 1);
+
+    epoll_event events[4];
+    pipe.write_byte();
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    pipe.write_byte();
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    close(epoll_fd);
+}
+
+TEST_CASE(oneshot_is_rearmed_by_modify)
+{
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    Pipe pipe;
+    watch(epoll_fd, pipe.read_fd(), EPOLLIN | EPOLLONESHOT, 1);
+
+    epoll_event events[4];
+    pipe.write_byte();
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+
+    epoll_event event {};
+    event.events = EPOLLIN | EPOLLONESHOT;
+    event.data.u64 = 2;
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_MOD, pipe.read_fd(), &event), 0);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(events[0].data.u64, 2u);
+    close(epoll_fd);
+}
+
+TEST_CASE(write_readiness)
+{
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    Pipe pipe;
+    watch(epoll_fd, pipe.write_fd(), EPOLLOUT, 7);
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 1);
+    EXPECT_EQ(events[0].events, static_cast<u32>(EPOLLOUT));
+    EXPECT_EQ(events[0].data.u64, 7u);
+    close(epoll_fd);
+}
+
+TEST_CASE(maxevents_limits_returned_events)
+{
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    Pipe pipes[3];
+    for (size_t i = 0; i < 3; ++i) {
+        watch(epoll_fd, pipes[i].read_fd(), EPOLLIN, i);
+        pipes[i].write_byte();
+    }
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 2, 0), 2);
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 3);
+    close(epoll_fd);
+}
+
+TEST_CASE(closing_a_watched_fd_removes_it)
+{
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    int fds[2];
+    EXPECT_EQ(pipe(fds), 0);
+    watch(epoll_fd, fds[0], EPOLLIN, 1);
+
+    char c = 'x';
+    EXPECT_EQ(write(fds[1], &c, 1), 1);
+    close(fds[0]);
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+    close(fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(invalid_operations)
+{
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    Pipe pipe;
+    watch(epoll_fd, pipe.read_fd(), EPOLLIN, 1);
+
+    epoll_event event {};
+    event.events = EPOLLIN;
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipe.read_fd(), &event), -1);
+    EXPECT_EQ(errno, EEXIST);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_DEL, pipe.write_fd(), nullptr), -1);
+    EXPECT_EQ(errno, ENOENT);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_MOD, pipe.write_fd(), &event), -1);
+    EXPECT_EQ(errno, ENOENT);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, epoll_fd, &event), -1);
+    EXPECT_EQ(errno, EINVAL);
+    EXPECT_EQ(epoll_ctl(pipe.read_fd(), EPOLL_CTL_ADD, pipe.write_fd(), &event), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 0, 0), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_DEL, pipe.read_fd(), nullptr), 0);
+    pipe.write_byte();
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 0), 0);
+    close(epoll_fd);
+}
+
+TEST_CASE(blocking_wait_is_woken_up)
+{
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    Pipe pipe;
+    watch(epoll_fd, pipe.read_fd(), EPOLLIN, 3);
+
+    pthread_t thread;
+    auto write_later = [](void* argument) -> void* {
+        usleep(10'000);
+        static_cast<Pipe*>(argument)->write_byte();
+        return nullptr;
+    };
+    EXPECT_EQ(pthread_create(&thread, nullptr, write_later, &pipe), 0);
+
+    epoll_event events[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 5000), 1);
+    EXPECT_EQ(events[0].data.u64, 3u);
+    EXPECT_EQ(pthread_join(thread, nullptr), 0);
+
+    // Nothing else is going to happen, so this should time out.
+    pipe.read_byte();
+    EXPECT_EQ(epoll_wait(epoll_fd, events, 4, 10), 0);
+    close(epoll_fd);
+}
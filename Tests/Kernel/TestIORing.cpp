@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibCore/IORing.h>
+#include <LibTest/TestCase.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+struct Pipe {
+    Pipe()
+    {
+        VERIFY(pipe(fds) == 0);
+    }
+
+    ~Pipe()
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    int read_fd() const { return fds[0]; }
+    int write_fd() const { return fds[1]; }
+
+    int fds[2];
+};
+
+static Core::IORing::Callback expect_result(size_t expected, size_t& completed)
+{
+    return [expected, &completed](ErrorOr<size_t> result) {
+        EXPECT(!result.is_error());
+        if (!result.is_error())
+            EXPECT_EQ(result.value(), expected);
+        ++completed;
+    };
+}
+
+TEST_CASE(batched_writes_and_reads)
+{
+    auto ring = MUST(Core::IORing::create(16));
+    Pipe pipe;
+
+    static constexpr size_t operation_count = 8;
+    Array<u8, operation_count> data;
+    for (size_t i = 0; i < operation_count; ++i)
+        data[i] = i;
+
+    size_t completed = 0;
+    for (size_t i = 0; i < operation_count; ++i)
+        MUST(ring->write(pipe.write_fd(), data.span().slice(i, 1), {}, expect_result(1, completed)));
+    EXPECT_EQ(MUST(ring->submit_and_wait(operation_count)), operation_count);
+    EXPECT_EQ(completed, operation_count);
+
+    Array<u8, operation_count> received;
+    received.fill(0xff);
+    completed = 0;
+    for (size_t i = 0; i < operation_count; ++i)
+        MUST(ring->read(pipe.read_fd(), received.span().slice(i, 1), {}, expect_result(1, completed)));
+    EXPECT_EQ(MUST(ring->submit_and_wait(operation_count)), operation_count);
+    EXPECT_EQ(completed, operation_count);
+    EXPECT_EQ(received, data);
+}
+
+TEST_CASE(read_waits_for_data)
+{
+    auto ring = MUST(Core::IORing::create(4));
+    Pipe pipe;
+
+    u8 byte = 0;
+    size_t completed = 0;
+    MUST(ring->read(pipe.read_fd(), { &byte, 1 }, {}, expect_result(1, completed)));
+    EXPECT_EQ(MUST(ring->submit_and_wait(0)), 0u);
+    EXPECT_EQ(ring->operations_in_flight(), 1u);
+
+    // Nothing arrives before the timeout.
+    EXPECT_EQ(MUST(ring->submit_and_wait(1, Time::from_milliseconds(10))), 0u);
+
+    u8 sent = 42;
+    EXPECT_EQ(write(pipe.write_fd(), &sent, 1), 1);
+    EXPECT_EQ(MUST(ring->submit_and_wait(1)), 1u);
+    EXPECT_EQ(completed, 1u);
+    EXPECT_EQ(byte, 42);
+    EXPECT_EQ(ring->operations_in_flight(), 0u);
+}
+
+TEST_CASE(poll_reports_readiness)
+{
+    auto ring = MUST(Core::IORing::create(4));
+    Pipe pipe;
+
+    size_t completed = 0;
+    MUST(ring->poll(pipe.read_fd(), POLLIN, expect_result(POLLIN, completed)));
+    MUST(ring->poll(pipe.write_fd(), POLLOUT, expect_result(POLLOUT, completed)));
+    EXPECT_EQ(MUST(ring->submit_and_wait(0)), 1u);
+
+    u8 byte = 0;
+    EXPECT_EQ(write(pipe.write_fd(), &byte, 1), 1);
+    EXPECT_EQ(MUST(ring->submit_and_wait(1)), 1u);
+    EXPECT_EQ(completed, 2u);
+}
+
+TEST_CASE(positioned_file_io_and_fsync)
+{
+    char path[] = "/tmp/io_ring.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    EXPECT_EQ(unlink(path), 0);
+
+    auto ring = MUST(Core::IORing::create(4));
+    size_t completed = 0;
+    auto data = "hello"sv.bytes();
+    MUST(ring->write(fd, data, 100, expect_result(data.size(), completed)));
+    MUST(ring->fsync(fd, expect_result(0, completed)));
+    EXPECT_EQ(MUST(ring->submit_and_wait(2)), 2u);
+
+    Array<u8, 5> received;
+    MUST(ring->read(fd, received, 100, expect_result(data.size(), completed)));
+    EXPECT_EQ(MUST(ring->submit_and_wait(1)), 1u);
+    EXPECT_EQ(completed, 3u);
+    EXPECT(data == received.span());
+    // Positioned I/O doesn't move the file offset.
+    EXPECT_EQ(lseek(fd, 0, SEEK_CUR), 0);
+
+    close(fd);
+}
+
+TEST_CASE(errors_are_reported_per_operation)
+{
+    auto ring = MUST(Core::IORing::create(4));
+    Pipe pipe;
+
+    Optional<int> error_code;
+    u8 byte = 0;
+    MUST(ring->read(pipe.write_fd(), { &byte, 1 }, {}, [&](ErrorOr<size_t> result) {
+        EXPECT(result.is_error());
+        if (result.is_error())
+            error_code = result.error().code();
+    }));
+    EXPECT_EQ(MUST(ring->submit_and_wait(1)), 1u);
+    EXPECT_EQ(error_code, EBADF);
+}
+
+TEST_CASE(accept_and_connect)
+{
+    int server_fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT(server_fd >= 0);
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    EXPECT_EQ(bind(server_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    socklen_t address_length = sizeof(address);
+    EXPECT_EQ(getsockname(server_fd, reinterpret_cast<sockaddr*>(&address), &address_length), 0);
+    EXPECT_EQ(listen(server_fd, 1), 0);
+
+    int client_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    EXPECT(client_fd >= 0);
+
+    auto ring = MUST(Core::IORing::create(4));
+    int accepted_fd = -1;
+    Optional<ErrorOr<size_t>> connect_result;
+    MUST(ring->accept(server_fd, SOCK_CLOEXEC, [&](ErrorOr<size_t> result) {
+        EXPECT(!result.is_error());
+        if (!result.is_error())
+            accepted_fd = static_cast<int>(result.value());
+    }));
+    MUST(ring->connect(client_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address), [&](ErrorOr<size_t> result) {
+        connect_result = move(result);
+    }));
+
+    size_t completed = 0;
+    while (completed < 2)
+        completed += MUST(ring->submit_and_wait(1));
+    EXPECT(connect_result.has_value() && !connect_result->is_error());
+    EXPECT(accepted_fd >= 0);
+    EXPECT_EQ(fcntl(accepted_fd, F_GETFD), FD_CLOEXEC);
+
+    close(accepted_fd);
+    close(client_fd);
+    close(server_fd);
+}
+
+TEST_CASE(connect_requires_non_blocking_socket)
+{
+    int server_fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT(server_fd >= 0);
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    EXPECT_EQ(bind(server_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    socklen_t address_length = sizeof(address);
+    EXPECT_EQ(getsockname(server_fd, reinterpret_cast<sockaddr*>(&address), &address_length), 0);
+    EXPECT_EQ(listen(server_fd, 1), 0);
+
+    int client_fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT(client_fd >= 0);
+
+    auto ring = MUST(Core::IORing::create(4));
+    Optional<int> error_code;
+    MUST(ring->connect(client_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address), [&](ErrorOr<size_t> result) {
+        EXPECT(result.is_error());
+        if (result.is_error())
+            error_code = result.error().code();
+    }));
+    EXPECT_EQ(MUST(ring->submit_and_wait(1)), 1u);
+    EXPECT_EQ(error_code, EAGAIN);
+
+    close(client_fd);
+    close(server_fd);
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/DeprecatedString.h>
+#include <LibTest/TestCase.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static constexpr size_t page_size = 4096;
+
+TEST_CASE(overwrite_is_read_back)
+{
+    static constexpr size_t size = 3 * page_size + 100;
+    char path[] = "/tmp/page_cache.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    EXPECT_EQ(unlink(path), 0);
+    Array<u8, size> initial_contents;
+    for (size_t i = 0; i < initial_contents.size(); ++i)
+        initial_contents[i] = i % 251;
+    EXPECT_EQ(write(fd, initial_contents.data(), initial_contents.size()), static_cast<ssize_t>(initial_contents.size()));
+
+    // Spans a page boundary, without changing the size of the file.
+    Array<u8, 200> data;
+    data.fill(0xaa);
+    EXPECT_EQ(pwrite(fd, data.data(), data.size(), page_size - 100), static_cast<ssize_t>(data.size()));
+
+    Array<u8, size> contents;
+    EXPECT_EQ(pread(fd, contents.data(), size, 0), static_cast<ssize_t>(size));
+    for (size_t i = 0; i < size; ++i) {
+        u8 expected = (i >= page_size - 100 && i < page_size + 100) ? 0xaa : i % 251;
+        if (contents[i] != expected) {
+            FAIL(DeprecatedString::formatted("Unexpected byte at offset {}", i));
+            break;
+        }
+    }
+
+    close(fd);
+}
+
+TEST_CASE(writes_are_visible_through_shared_mapping)
+{
+    char path[] = "/tmp/page_cache.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    EXPECT_EQ(unlink(path), 0);
+    Array<u8, 2 * page_size> initial_contents;
+    for (size_t i = 0; i < initial_contents.size(); ++i)
+        initial_contents[i] = i % 251;
+    EXPECT_EQ(write(fd, initial_contents.data(), initial_contents.size()), static_cast<ssize_t>(initial_contents.size()));
+    auto* mapping = static_cast<u8*>(mmap(nullptr, 2 * page_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    EXPECT(mapping != MAP_FAILED);
+
+    // Fault the first page in before writing to it, and leave the second one for after.
+    EXPECT_EQ(mapping[10], 10);
+    u8 byte = 0x42;
+    EXPECT_EQ(pwrite(fd, &byte, 1, 10), 1);
+    EXPECT_EQ(pwrite(fd, &byte, 1, page_size + 10), 1);
+    EXPECT_EQ(mapping[10], 0x42);
+    EXPECT_EQ(mapping[page_size + 10], 0x42);
+
+    // And the other way around.
+    mapping[20] = 0x43;
+    EXPECT_EQ(msync(mapping, 2 * page_size, MS_SYNC), 0);
+    EXPECT_EQ(pread(fd, &byte, 1, 20), 1);
+    EXPECT_EQ(byte, 0x43);
+
+    EXPECT_EQ(munmap(mapping, 2 * page_size), 0);
+    close(fd);
+}
+
+TEST_CASE(truncated_data_does_not_come_back)
+{
+    char path[] = "/tmp/page_cache.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    EXPECT_EQ(unlink(path), 0);
+    Array<u8, 2 * page_size> initial_contents;
+    for (size_t i = 0; i < initial_contents.size(); ++i)
+        initial_contents[i] = i % 251;
+    EXPECT_EQ(write(fd, initial_contents.data(), initial_contents.size()), static_cast<ssize_t>(initial_contents.size()));
+    Array<u8, 2 * page_size> contents;
+    EXPECT_EQ(pread(fd, contents.data(), contents.size(), 0), static_cast<ssize_t>(contents.size()));
+
+    EXPECT_EQ(ftruncate(fd, 100), 0);
+    EXPECT_EQ(ftruncate(fd, 2 * page_size), 0);
+
+    EXPECT_EQ(pread(fd, contents.data(), contents.size(), 0), static_cast<ssize_t>(contents.size()));
+    for (size_t i = 100; i < contents.size(); ++i) {
+        if (contents[i] != 0) {
+            FAIL(DeprecatedString::formatted("Unexpected byte at offset {}", i));
+            break;
+        }
+    }
+
+    close(fd);
+}
+
+TEST_CASE(direct_reads_see_cached_writes)
+{
+    char path[] = "/tmp/page_cache.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    Array<u8, page_size> data;
+    data.fill(1);
+    EXPECT_EQ(write(fd, data.data(), data.size()), static_cast<ssize_t>(data.size()));
+    // This one is served from the page cache, as it doesn't grow the file.
+    data.fill(2);
+    EXPECT_EQ(pwrite(fd, data.data(), data.size(), 0), static_cast<ssize_t>(data.size()));
+
+    int direct_fd = open(path, O_RDONLY | O_DIRECT);
+    EXPECT(direct_fd >= 0);
+    EXPECT_EQ(unlink(path), 0);
+    data.fill(0);
+    EXPECT_EQ(read(direct_fd, data.data(), data.size()), static_cast<ssize_t>(data.size()));
+    EXPECT_EQ(data[0], 2);
+    EXPECT_EQ(data[page_size - 1], 2);
+
+    close(direct_fd);
+    close(fd);
+}
+
+TEST_CASE(shared_mapping_stays_coherent_when_file_grows)
+{
+    char path[] = "/tmp/page_cache.XXXXXX";
+    int fd = mkstemp(path);
+    EXPECT(fd >= 0);
+    Array<u8, page_size> data;
+    data.fill(1);
+    EXPECT_EQ(write(fd, data.data(), data.size()), static_cast<ssize_t>(data.size()));
+
+    auto* mapping = static_cast<u8*>(mmap(nullptr, page_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    EXPECT(mapping != MAP_FAILED);
+    EXPECT_EQ(mapping[0], 1);
+
+    // Grow the file well past the size of the mapping, so its page cache has to grow as well.
+    data.fill(2);
+    for (size_t i = 0; i < 4; ++i)
+        EXPECT_EQ(write(fd, data.data(), data.size()), static_cast<ssize_t>(data.size()));
+
+    // Writes through the mapping still show up in read(), and the other way around.
+    mapping[10] = 0x42;
+    u8 byte = 0;
+    EXPECT_EQ(pread(fd, &byte, 1, 10), 1);
+    EXPECT_EQ(byte, 0x42);
+
+    byte = 0x43;
+    EXPECT_EQ(pwrite(fd, &byte, 1, 20), 1);
+    EXPECT_EQ(mapping[20], 0x43);
+
+    // And the mapping's writes are still written back.
+    EXPECT_EQ(msync(mapping, page_size, MS_SYNC), 0);
+    int direct_fd = open(path, O_RDONLY | O_DIRECT);
+    EXPECT(direct_fd >= 0);
+    EXPECT_EQ(unlink(path), 0);
+    EXPECT_EQ(read(direct_fd, data.data(), data.size()), static_cast<ssize_t>(data.size()));
+    EXPECT_EQ(data[10], 0x42);
+    EXPECT_EQ(data[20], 0x43);
+    close(direct_fd);
+
+    EXPECT_EQ(munmap(mapping, page_size), 0);
+    close(fd);
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/StringView.h>
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+
+static constexpr auto file_contents = "Hello, sendfile!"sv;
+
+static StringView read_from_pipe(int fd, Bytes buffer)
+{
+    auto nread = read(fd, buffer.data(), buffer.size());
+    VERIFY(nread >= 0);
+    return StringView { buffer.data(), static_cast<size_t>(nread) };
+}
+
+TEST_CASE(file_to_pipe_with_offset)
+{
+    char path[] = "/tmp/sendfile.XXXXXX";
+    int file_fd = mkstemp(path);
+    EXPECT(file_fd >= 0);
+    EXPECT_EQ(unlink(path), 0);
+    EXPECT_EQ(write(file_fd, file_contents.characters_without_null_termination(), file_contents.length()), static_cast<ssize_t>(file_contents.length()));
+    EXPECT_EQ(lseek(file_fd, 0, SEEK_SET), 0);
+    int fds[2];
+    EXPECT_EQ(pipe(fds), 0);
+
+    off_t offset = 7;
+    EXPECT_EQ(sendfile(fds[1], file_fd, &offset, 4), 4);
+    EXPECT_EQ(offset, 11);
+    // Passing an offset must leave the file offset alone.
+    EXPECT_EQ(lseek(file_fd, 0, SEEK_CUR), 0);
+
+    Array<u8, 64> buffer;
+    EXPECT_EQ(read_from_pipe(fds[0], buffer.span()), "send"sv);
+
+    close(fds[0]);
+    close(fds[1]);
+    close(file_fd);
+}
+
+TEST_CASE(file_to_pipe_without_offset)
+{
+    char path[] = "/tmp/sendfile.XXXXXX";
+    int file_fd = mkstemp(path);
+    EXPECT(file_fd >= 0);
+    EXPECT_EQ(unlink(path), 0);
+    EXPECT_EQ(write(file_fd, file_contents.characters_without_null_termination(), file_contents.length()), static_cast<ssize_t>(file_contents.length()));
+    EXPECT_EQ(lseek(file_fd, 0, SEEK_SET), 0);
+    int fds[2];
+    EXPECT_EQ(pipe(fds), 0);
+
+    EXPECT_EQ(sendfile(fds[1], file_fd, nullptr, 5), 5);
+    EXPECT_EQ(lseek(file_fd, 0, SEEK_CUR), 5);
+
+    // Asking for more than what's left stops at the end of the file.
+    EXPECT_EQ(sendfile(fds[1], file_fd, nullptr, 1000), static_cast<ssize_t>(file_contents.length() - 5));
+    EXPECT_EQ(sendfile(fds[1], file_fd, nullptr, 1000), 0);
+
+    Array<u8, 64> buffer;
+    EXPECT_EQ(read_from_pipe(fds[0], buffer.span()), file_contents);
+
+    close(fds[0]);
+    close(fds[1]);
+    close(file_fd);
+}
+
+TEST_CASE(large_file_to_pipe)
+{
+    // Big enough to need more than one chunk, but small enough to fit into the pipe.
+    static constexpr size_t size = 40000;
+    char path[] = "/tmp/sendfile.XXXXXX";
+    int file_fd = mkstemp(path);
+    EXPECT(file_fd >= 0);
+    EXPECT_EQ(unlink(path), 0);
+    u8 contents[size];
+    for (size_t i = 0; i < size; ++i)
+        contents[i] = i % 251;
+    EXPECT_EQ(write(file_fd, contents, size), static_cast<ssize_t>(size));
+
+    int fds[2];
+    EXPECT_EQ(pipe(fds), 0);
+    off_t offset = 0;
+    EXPECT_EQ(sendfile(fds[1], file_fd, &offset, size), static_cast<ssize_t>(size));
+    EXPECT_EQ(offset, static_cast<off_t>(size));
+
+    u8 received[size];
+    size_t total_nread = 0;
+    while (total_nread < size) {
+        auto nread = read(fds[0], received + total_nread, size - total_nread);
+        EXPECT(nread > 0);
+        if (nread <= 0)
+            break;
+        total_nread += nread;
+    }
+    EXPECT_EQ(ReadonlyBytes(received, size), ReadonlyBytes(contents, size));
+
+    close(fds[0]);
+    close(fds[1]);
+    close(file_fd);
+}
+
+TEST_CASE(pipe_to_pipe)
+{
+    int in_fds[2];
+    int out_fds[2];
+    EXPECT_EQ(pipe(in_fds), 0);
+    EXPECT_EQ(pipe(out_fds), 0);
+
+    EXPECT_EQ(write(in_fds[1], "abcdef", 6), 6);
+    // Only what's currently in the pipe is sent, rather than waiting for the whole count.
+    EXPECT_EQ(sendfile(out_fds[1], in_fds[0], nullptr, 100), 6);
+
+    Array<u8, 64> buffer;
+    EXPECT_EQ(read_from_pipe(out_fds[0], buffer.span()), "abcdef"sv);
+
+    close(in_fds[0]);
+    close(in_fds[1]);
+    close(out_fds[0]);
+    close(out_fds[1]);
+}
+
+TEST_CASE(invalid_arguments)
+{
+    char path[] = "/tmp/sendfile.XXXXXX";
+    int file_fd = mkstemp(path);
+    EXPECT(file_fd >= 0);
+    EXPECT_EQ(unlink(path), 0);
+    EXPECT_EQ(write(file_fd, file_contents.characters_without_null_termination(), file_contents.length()), static_cast<ssize_t>(file_contents.length()));
+    EXPECT_EQ(lseek(file_fd, 0, SEEK_SET), 0);
+    int fds[2];
+    EXPECT_EQ(pipe(fds), 0);
+
+    EXPECT_EQ(sendfile(fds[1], -1, nullptr, 1), -1);
+    EXPECT_EQ(errno, EBADF);
+    EXPECT_EQ(sendfile(-1, file_fd, nullptr, 1), -1);
+    EXPECT_EQ(errno, EBADF);
+    // The write end of a pipe can't be read from.
+    EXPECT_EQ(sendfile(fds[1], fds[1], nullptr, 1), -1);
+    EXPECT_EQ(errno, EBADF);
+
+    off_t offset = 0;
+    EXPECT_EQ(sendfile(fds[1], fds[0], &offset, 1), -1);
+    EXPECT_EQ(errno, ESPIPE);
+
+    offset = -1;
+    EXPECT_EQ(sendfile(fds[1], file_fd, &offset, 1), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    close(fds[0]);
+    close(fds[1]);
+    close(file_fd);
+}
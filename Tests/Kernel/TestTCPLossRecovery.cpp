@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/DeprecatedString.h>
+#include <AK/StringView.h>
+#include <LibTest/TestCase.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+static constexpr char const* drop_interval_path = "/sys/kernel/variables/loopback_packet_drop_interval";
+static constexpr char const* congestion_control_path = "/sys/kernel/variables/tcp_congestion_control";
+
+static constexpr size_t transfer_size = 2 * MiB;
+// Small writes make for lots of segments, so plenty of them end up being dropped.
+static constexpr size_t chunk_size = 1024;
+
+static u8 byte_at(size_t offset)
+{
+    return offset % 251;
+}
+
+static bool write_variable(char const* path, StringView value)
+{
+    int fd = open(path, O_WRONLY | O_TRUNC);
+    if (fd < 0)
+        return false;
+    bool ok = write(fd, value.characters_without_null_termination(), value.length()) == static_cast<ssize_t>(value.length());
+    close(fd);
+    return ok;
+}
+
+static DeprecatedString read_variable(char const* path)
+{
+    Array<char, 64> buffer;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return {};
+    auto nread = read(fd, buffer.data(), buffer.size());
+    close(fd);
+    if (nread <= 0)
+        return {};
+    return StringView { buffer.data(), static_cast<size_t>(nread) }.trim_whitespace();
+}
+
+struct Sender {
+    int socket_fd { -1 };
+    int start_fd { -1 };
+};
+
+static void* send_data(void* argument)
+{
+    auto& sender = *static_cast<Sender*>(argument);
+    char c;
+    VERIFY(read(sender.start_fd, &c, 1) == 1);
+
+    Array<u8, chunk_size> chunk;
+    for (size_t offset = 0; offset < transfer_size; offset += chunk_size) {
+        for (size_t i = 0; i < chunk_size; ++i)
+            chunk[i] = byte_at(offset + i);
+        size_t nwritten = 0;
+        while (nwritten < chunk_size) {
+            auto rc = write(sender.socket_fd, chunk.data() + nwritten, chunk_size - nwritten);
+            VERIFY(rc > 0);
+            nwritten += rc;
+        }
+    }
+    return nullptr;
+}
+
+static void transfer_with_packet_loss(StringView algorithm, StringView drop_interval)
+{
+    auto original_algorithm = read_variable(congestion_control_path);
+    if (!write_variable(congestion_control_path, algorithm)) {
+        warnln("Can't select the {} congestion control, skipping", algorithm);
+        return;
+    }
+
+    int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT(listen_fd >= 0);
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    EXPECT_EQ(bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    EXPECT_EQ(listen(listen_fd, 1), 0);
+    socklen_t address_length = sizeof(address);
+    EXPECT_EQ(getsockname(listen_fd, reinterpret_cast<sockaddr*>(&address), &address_length), 0);
+
+    int client_fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT(client_fd >= 0);
+    EXPECT_EQ(connect(client_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    int server_fd = accept(listen_fd, nullptr, nullptr);
+    EXPECT(server_fd >= 0);
+
+    // Only start dropping packets once the connection is up, since the handshake doesn't cope well with loss.
+    if (!write_variable(drop_interval_path, drop_interval))
+        warnln("Can't drop loopback packets, measuring a lossless transfer instead");
+
+    int start_fds[2];
+    EXPECT_EQ(pipe(start_fds), 0);
+    Sender sender { client_fd, start_fds[0] };
+    pthread_t thread;
+    EXPECT_EQ(pthread_create(&thread, nullptr, send_data, &sender), 0);
+
+    timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    EXPECT_EQ(write(start_fds[1], "x", 1), 1);
+
+    Array<u8, 4096> buffer;
+    size_t total_nread = 0;
+    bool data_is_intact = true;
+    while (total_nread < transfer_size) {
+        auto nread = read(server_fd, buffer.data(), min(buffer.size(), transfer_size - total_nread));
+        EXPECT(nread > 0);
+        if (nread <= 0)
+            break;
+        for (ssize_t i = 0; i < nread; ++i) {
+            if (buffer[i] != byte_at(total_nread + i))
+                data_is_intact = false;
+        }
+        total_nread += nread;
+    }
+
+    timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    // FIN segments aren't retransmitted, so stop dropping packets before the connection is shut down.
+    write_variable(drop_interval_path, "0"sv);
+    write_variable(congestion_control_path, original_algorithm);
+
+    EXPECT_EQ(pthread_join(thread, nullptr), 0);
+    EXPECT_EQ(total_nread, transfer_size);
+    EXPECT(data_is_intact);
+
+    auto elapsed_ms = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1'000'000;
+    outln("{}: {} KiB in {} ms ({} KiB/s), dropping every {}th packet", algorithm, transfer_size / KiB, elapsed_ms, transfer_size / KiB * 1000 / max(elapsed_ms, 1), drop_interval);
+
+    close(start_fds[0]);
+    close(start_fds[1]);
+    close(server_fd);
+    close(client_fd);
+    close(listen_fd);
+}
+
+TEST_CASE(newreno_recovers_from_packet_loss)
+{
+    transfer_with_packet_loss("newreno"sv, "50"sv);
+}
+
+TEST_CASE(cubic_recovers_from_packet_loss)
+{
+    transfer_with_packet_loss("cubic"sv, "50"sv);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Array.h>
+#include <AK/Vector.h>
+#include <LibCore/ElapsedTimer.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+static constexpr size_t allocations_per_thread = 1'000'000;
+
+// Each thread keeps this many allocations alive, and replaces a random one of them on every iteration.
+static constexpr size_t live_allocations_per_thread = 256;
+
+static void* allocate_and_free(void* argument)
+{
+    u32 state = static_cast<u32>(reinterpret_cast<uintptr_t>(argument)) * 2654435761u + 1;
+    auto next_random = [&] {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+
+    Array<void*, live_allocations_per_thread> allocations {};
+    for (size_t i = 0; i < allocations_per_thread; ++i) {
+        auto& allocation = allocations[next_random() % live_allocations_per_thread];
+        free(allocation);
+
+        // Most allocations are small, like they are in real programs.
+        size_t size = 8 + (next_random() % 120);
+        if (next_random() % 8 == 0)
+            size = 128 + (next_random() % 1920);
+        allocation = malloc(size);
+        VERIFY(allocation);
+        *static_cast<u8*>(allocation) = 0;
+    }
+
+    for (auto* allocation : allocations)
+        free(allocation);
+    return nullptr;
+}
+
+static void benchmark_threads(size_t thread_count)
+{
+    Vector<pthread_t> threads;
+    threads.resize(thread_count);
+
+    Core::ElapsedTimer timer(true);
+    for (size_t i = 0; i < thread_count; ++i)
+        EXPECT_EQ(pthread_create(&threads[i], nullptr, allocate_and_free, reinterpret_cast<void*>(i)), 0);
+    for (auto thread : threads)
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+    auto elapsed_microseconds = max(timer.elapsed_time().to_microseconds(), 1);
+
+    auto operations = static_cast<double>(thread_count * allocations_per_thread * 2);
+    outln("{} thread(s): {:.2} million malloc()/free() calls per second", thread_count, operations / elapsed_microseconds);
+}
+
+#define __ENUMERATE_THREAD_COUNT_BENCHMARK(thread_count) \
+    BENCHMARK_CASE(malloc_free_##thread_count##_threads)  \
+    {                                                     \
+        benchmark_threads(thread_count);                  \
+    }
+
+__ENUMERATE_THREAD_COUNT_BENCHMARK(1)
+__ENUMERATE_THREAD_COUNT_BENCHMARK(2)
+__ENUMERATE_THREAD_COUNT_BENCHMARK(4)
+__ENUMERATE_THREAD_COUNT_BENCHMARK(8)
+
+#undef __ENUMERATE_THREAD_COUNT_BENCHMARK
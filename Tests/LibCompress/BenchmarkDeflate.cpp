@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteBuffer.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibCompress/Deflate.h>
+#include <LibCore/ElapsedTimer.h>
+
+using CompressionLevel = Compress::DeflateCompressor::CompressionLevel;
+
+static constexpr size_t corpus_file_size = 256 * KiB;
+
+// A small xorshift generator, so that the corpus is the same on every run
+class CorpusRandom {
+public:
+    u32 next()
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+private:
+    u32 m_state { 0x2545f491 };
+};
+
+static ByteBuffer generate_text()
+{
+    static constexpr StringView words[] = {
+        "the"sv, "of"sv, "and"sv, "to"sv, "a"sv, "in"sv, "is"sv, "that"sv, "for"sv, "it"sv, "as"sv, "was"sv, "with"sv,
+        "be"sv, "by"sv, "on"sv, "not"sv, "he"sv, "this"sv, "are"sv, "or"sv, "his"sv, "from"sv, "at"sv, "which"sv,
+        "but"sv, "have"sv, "an"sv, "had"sv, "they"sv, "you"sv, "were"sv, "their"sv, "one"sv, "all"sv, "we"sv,
+        "compression"sv, "window"sv, "library"sv, "operating"sv, "system"sv, "kernel"sv, "serenity"sv, "stream"sv,
+    };
+    CorpusRandom random;
+    ByteBuffer text;
+    while (text.size() < corpus_file_size) {
+        // Picking the lowest of two random numbers makes the first words more common, like in natural language
+        auto index = min(random.next() % array_size(words), random.next() % array_size(words));
+        text.append(words[index].bytes());
+        text.append(random.next() % 12 == 0 ? ".\n"sv.bytes() : " "sv.bytes());
+    }
+    text.resize(corpus_file_size);
+    return text;
+}
+
+static ByteBuffer generate_source_code()
+{
+    CorpusRandom random;
+    ByteBuffer source;
+    while (source.size() < corpus_file_size) {
+        auto line = DeprecatedString::formatted("    auto value_{} = TRY(read_value(stream, {}));\n    if (value_{} > {})\n        return Error::from_errno(EINVAL);\n",
+            random.next() % 64, random.next() % 1024, random.next() % 64, random.next() % 100000);
+        source.append(line.bytes());
+    }
+    source.resize(corpus_file_size);
+    return source;
+}
+
+static ByteBuffer generate_image()
+{
+    // An uncompressed RGBA image with smooth gradients, slight noise and some areas of flat color
+    CorpusRandom random;
+    auto image = ByteBuffer::create_zeroed(corpus_file_size).release_value();
+    static constexpr size_t width = 256;
+    for (size_t i = 0; i < corpus_file_size / 4; i++) {
+        auto x = i % width;
+        auto y = i / width;
+        auto* pixel = &image[i * 4];
+        if ((x / 32 + y / 32) % 3 == 0) {
+            pixel[0] = 0x20;
+            pixel[1] = 0x40;
+            pixel[2] = 0x80;
+        } else {
+            pixel[0] = x + (random.next() % 4);
+            pixel[1] = y + (random.next() % 4);
+            pixel[2] = (x + y) / 2;
+        }
+        pixel[3] = 0xff;
+    }
+    return image;
+}
+
+static ByteBuffer generate_random()
+{
+    CorpusRandom random;
+    auto data = ByteBuffer::create_uninitialized(corpus_file_size).release_value();
+    for (auto& byte : data.bytes())
+        byte = random.next() >> 24;
+    return data;
+}
+
+struct CorpusFile {
+    StringView name;
+    ByteBuffer contents;
+};
+
+static Vector<CorpusFile> generate_corpus()
+{
+    return {
+        { "text"sv, generate_text() },
+        { "source"sv, generate_source_code() },
+        { "image"sv, generate_image() },
+        { "random"sv, generate_random() },
+    };
+}
+
+static void benchmark_compression_level(CompressionLevel level)
+{
+    for (auto const& file : generate_corpus()) {
+        Core::ElapsedTimer timer(true);
+        timer.start();
+        auto compressed = Compress::DeflateCompressor::compress_all(file.contents, level);
+        auto elapsed_microseconds = max(timer.elapsed_time().to_microseconds(), 1);
+        EXPECT(!compressed.is_error());
+
+        auto decompressed = Compress::DeflateDecompressor::decompress_all(compressed.value());
+        EXPECT(!decompressed.is_error());
+        EXPECT(decompressed.value() == file.contents);
+
+        auto megabytes_per_second = static_cast<double>(file.contents.size()) / elapsed_microseconds;
+        auto ratio = static_cast<double>(file.contents.size()) / compressed.value().size();
+        outln("{:>6}: {:>8.2} MB/s, ratio {:.3}", file.name, megabytes_per_second, ratio);
+    }
+}
+
+#define __ENUMERATE_COMPRESSION_LEVEL_BENCHMARK(name, level) \
+    BENCHMARK_CASE(deflate_##name)                           \
+    {                                                        \
+        benchmark_compression_level(CompressionLevel::level); \
+    }
+
+__ENUMERATE_COMPRESSION_LEVEL_BENCHMARK(store, STORE)
+__ENUMERATE_COMPRESSION_LEVEL_BENCHMARK(fastest, FASTEST)
+__ENUMERATE_COMPRESSION_LEVEL_BENCHMARK(fast, FAST)
+__ENUMERATE_COMPRESSION_LEVEL_BENCHMARK(good, GOOD)
+__ENUMERATE_COMPRESSION_LEVEL_BENCHMARK(great, GREAT)
+__ENUMERATE_COMPRESSION_LEVEL_BENCHMARK(best, BEST)
+
+#undef __ENUMERATE_COMPRESSION_LEVEL_BENCHMARK
+
+static void benchmark_decompression(CompressionLevel level)
+{
+    // Each file is decompressed a few times, as a single pass is over too quickly to be measured reliably.
+    static constexpr size_t iterations = 8;
+
+    for (auto const& file : generate_corpus()) {
+        auto compressed = Compress::DeflateCompressor::compress_all(file.contents, level);
+        EXPECT(!compressed.is_error());
+
+        Core::ElapsedTimer timer(true);
+        timer.start();
+        for (size_t i = 0; i < iterations; ++i) {
+            auto decompressed = Compress::DeflateDecompressor::decompress_all(compressed.value());
+            EXPECT(!decompressed.is_error());
+            EXPECT_EQ(decompressed.value().size(), file.contents.size());
+        }
+        auto elapsed_microseconds = max(timer.elapsed_time().to_microseconds(), 1);
+
+        auto megabytes_per_second = static_cast<double>(file.contents.size() * iterations) / elapsed_microseconds;
+        outln("{:>6}: {:>8.2} MB/s", file.name, megabytes_per_second);
+    }
+}
+
+#define __ENUMERATE_DECOMPRESSION_BENCHMARK(name, level) \
+    BENCHMARK_CASE(inflate_##name)                       \
+    {                                                    \
+        benchmark_decompression(CompressionLevel::level); \
+    }
+
+__ENUMERATE_DECOMPRESSION_BENCHMARK(store, STORE)
+__ENUMERATE_DECOMPRESSION_BENCHMARK(fast, FAST)
+__ENUMERATE_DECOMPRESSION_BENCHMARK(good, GOOD)
+__ENUMERATE_DECOMPRESSION_BENCHMARK(best, BEST)
+
+#undef __ENUMERATE_DECOMPRESSION_BENCHMARK
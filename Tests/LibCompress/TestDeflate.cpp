@@ -148,6 +148,26 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed.value() == original);
 }
 
+TEST_CASE(deflate_round_trip_compress_greedy)
+{
+    // Random bytes make the greedy search skip ahead, zeroes are encoded as runs, and the repeated text has ordinary back references
+    auto size = Compress::DeflateCompressor::block_size * 3;
+    auto original = ByteBuffer::create_zeroed(size).release_value();
+    fill_with_random(original.data(), size / 3);
+    auto text = "The quick brown fox jumps over the lazy dog. "sv;
+    for (size_t i = 2 * size / 3; i < size; i++)
+        original[i] = text[i % text.length()];
+
+    for (auto level : { Compress::DeflateCompressor::CompressionLevel::FASTEST, Compress::DeflateCompressor::CompressionLevel::FAST }) {
+        auto compressed = Compress::DeflateCompressor::compress_all(original, level);
+        EXPECT(!compressed.is_error());
+        EXPECT(compressed.value().size() < size / 2);
+        auto uncompressed = Compress::DeflateDecompressor::decompress_all(compressed.value());
+        EXPECT(!uncompressed.is_error());
+        EXPECT(uncompressed.value() == original);
+    }
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
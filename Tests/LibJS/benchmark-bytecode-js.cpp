@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+using DispatchMode = JS::Bytecode::Interpreter::DispatchMode;
+
+static constexpr auto arithmetic_loop_source = "var result = 0;\n"
+                                               "for (var i = 0; i < 200000; ++i)\n"
+                                               "    result = (result + i * 3) % 1000003;\n"sv;
+
+static constexpr auto branchy_loop_source = "var result = 0;\n"
+                                            "for (var i = 0; i < 200000; ++i) {\n"
+                                            "    if (i % 3 === 0) result += 1;\n"
+                                            "    else if (i % 3 === 1) result -= 2;\n"
+                                            "    else result = result ?? 0;\n"
+                                            "}\n"sv;
+
+static constexpr auto property_access_loop_source = "var point = { x: 0, y: 0 };\n"
+                                                    "for (var i = 0; i < 100000; ++i) {\n"
+                                                    "    point.x = point.x + 1;\n"
+                                                    "    point.y = point.x - point.y;\n"
+                                                    "}\n"
+                                                    "var result = point.x + point.y;\n"sv;
+
+static constexpr auto function_call_loop_source = "function add(a, b) { return a + b; }\n"
+                                                  "var result = 0;\n"
+                                                  "for (var i = 0; i < 50000; ++i)\n"
+                                                  "    result = add(result, i) % 1000003;\n"sv;
+
+static constexpr auto try_catch_loop_source = "function check(i) {\n"
+                                              "    try {\n"
+                                              "        if (i % 2) throw i;\n"
+                                              "        return 1;\n"
+                                              "    } catch (e) {\n"
+                                              "        return 2;\n"
+                                              "    }\n"
+                                              "}\n"
+                                              "var result = 0;\n"
+                                              "for (var i = 0; i < 20000; ++i)\n"
+                                              "    result += check(i);\n"sv;
+
+static JS::Value run_script(StringView source, DispatchMode mode, bool optimize = false)
+{
+    auto vm = JS::VM::create();
+    auto ast_interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+    auto& realm = ast_interpreter->realm();
+
+    auto script = JS::Script::parse(source, realm).release_value();
+    auto executable = MUST(JS::Bytecode::Generator::generate(script->parse_node()));
+    if (optimize)
+        JS::Bytecode::Interpreter::optimization_pipeline(JS::Bytecode::Interpreter::OptimizationLevel::Optimize).perform(*executable);
+
+    JS::Bytecode::Interpreter bytecode_interpreter(realm);
+    bytecode_interpreter.set_dispatch_mode(mode);
+    auto result = bytecode_interpreter.run(*executable);
+    EXPECT(!result.is_error());
+
+    return MUST(realm.global_object().get("result"));
+}
+
+TEST_CASE(dispatch_modes_agree)
+{
+    for (auto source : { arithmetic_loop_source, branchy_loop_source, property_access_loop_source, function_call_loop_source, try_catch_loop_source }) {
+        for (auto optimize : { false, true }) {
+            auto expected = run_script(source, DispatchMode::BasicBlocks, optimize);
+            auto actual = run_script(source, DispatchMode::Threaded, optimize);
+            EXPECT(expected.is_number());
+            EXPECT_EQ(actual.as_double(), expected.as_double());
+        }
+    }
+}
+
+#define __ENUMERATE_DISPATCH_BENCHMARK(name)                        \
+    BENCHMARK_CASE(name##_basic_blocks)                             \
+    {                                                               \
+        (void)run_script(name##_source, DispatchMode::BasicBlocks); \
+    }                                                               \
+    BENCHMARK_CASE(name##_threaded)                                 \
+    {                                                               \
+        (void)run_script(name##_source, DispatchMode::Threaded);    \
+    }
+
+__ENUMERATE_DISPATCH_BENCHMARK(arithmetic_loop)
+__ENUMERATE_DISPATCH_BENCHMARK(branchy_loop)
+__ENUMERATE_DISPATCH_BENCHMARK(property_access_loop)
+__ENUMERATE_DISPATCH_BENCHMARK(function_call_loop)
+__ENUMERATE_DISPATCH_BENCHMARK(try_catch_loop)
+
+#undef __ENUMERATE_DISPATCH_BENCHMARK
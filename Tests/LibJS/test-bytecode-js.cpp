@@ -139,3 +139,24 @@ TEST_CASE(catch_exception)
                             "if (hitCatch !== true) throw new Exception('failed');\n"
                             "if (hitFinally !== true) throw new Exception('failed');");
 }
+
+TEST_CASE(property_lookup_caches)
+{
+    SETUP_AND_PARSE("var object = { x: 1 };\n"
+                    "var sum = 0;\n"
+                    "for (var i = 0; i < 10; ++i) {\n"
+                    "    object.x = i;\n"
+                    "    sum += object.x;\n"
+                    "}\n"
+                    "if (sum !== 45) throw new Exception('failed');");
+
+    EXPECT_NO_EXCEPTION(executable);
+
+    // Only the first execution of each instruction should have to do a full lookup.
+    // NOTE: The object literal's property is also defined through a PutById, which adds a property and can't be cached.
+    auto const& statistics = bytecode_interpreter.property_lookup_cache_statistics();
+    EXPECT_EQ(statistics.get_by_id_hits, 9u);
+    EXPECT_EQ(statistics.get_by_id_misses, 1u);
+    EXPECT_EQ(statistics.put_by_id_hits, 9u);
+    EXPECT_EQ(statistics.put_by_id_misses, 2u);
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+// NOTE: The items are created before marking starts. The holders are created after, so they're marked right away, while the
+//       items in the first few boxes are only reached towards the end. The items are then moved from their boxes into the
+//       holders, which is the only place they're reachable from afterwards, so they only survive if the collector notices.
+static constexpr auto setup_source = "var boxes = [];\n"
+                                     "for (var i = 0; i < 200; ++i) {\n"
+                                     "    var box = { items: [] };\n"
+                                     "    for (var j = 0; j < 100; ++j) box.items.push({ value: i * 100 + j });\n"
+                                     "    boxes.push(box);\n"
+                                     "}\n"
+                                     "var holder;\n"
+                                     "var expected;\n"
+                                     "var closures;\n"
+                                     "var closures_expected;\n"
+                                     "var transfer = null;\n"
+                                     "function create_holders() {\n"
+                                     "    holder = {};\n"
+                                     "    expected = [];\n"
+                                     "    closures = [];\n"
+                                     "    closures_expected = [];\n"
+                                     "    for (var i = 0; i < 50; ++i) {\n"
+                                     "        closures.push((() => {\n"
+                                     "            let value = null;\n"
+                                     "            return { get: () => value, take: () => { value = transfer; transfer = null; } };\n"
+                                     "        })());\n"
+                                     "    }\n"
+                                     "}\n"
+                                     "var next_box = 0;\n"
+                                     "function take_item() {\n"
+                                     "    next_box = (next_box + 37) % boxes.length;\n"
+                                     "    return boxes[next_box].items.pop();\n"
+                                     "}\n"
+                                     "function move_items() {\n"
+                                     "    holder[expected.length] = take_item();\n"
+                                     "    expected.push(holder[expected.length].value);\n"
+                                     "    var index = (expected.length - 1) % closures.length;\n"
+                                     "    transfer = take_item();\n"
+                                     "    closures[index].take();\n"
+                                     "    closures_expected[index] = closures[index].get().value;\n"
+                                     "}\n"
+                                     "function check() {\n"
+                                     "    for (let i = 0; i < 50000; ++i) ({ value: -1 });\n"
+                                     "    if (!expected.length) return false;\n"
+                                     "    for (let i = 0; i < expected.length; ++i) {\n"
+                                     "        if (holder[i].value !== expected[i]) return false;\n"
+                                     "    }\n"
+                                     "    for (let i = 0; i < closures_expected.length; ++i) {\n"
+                                     "        if (closures[i].get().value !== closures_expected[i]) return false;\n"
+                                     "    }\n"
+                                     "    return true;\n"
+                                     "}\n"sv;
+
+static JS::Value run(JS::Interpreter& interpreter, StringView source)
+{
+    auto script = JS::Script::parse(source, interpreter.realm()).release_value();
+    return MUST(interpreter.run(script));
+}
+
+// NOTE: Marking follows the chain one link at a time, so its end stays unmarked for a while. This is a separate function
+//       so that no pointer to the links is left on the stack when the conservative roots are gathered.
+static NEVER_INLINE JS::Handle<JS::Object> create_chain(JS::Realm& realm, size_t length)
+{
+    auto head = JS::make_handle(JS::Object::create(realm, nullptr));
+    JS::Object* link = head.cell();
+    for (size_t i = 0; i < length; ++i) {
+        auto next = JS::Object::create(realm, nullptr);
+        link->define_direct_property("next", next, JS::default_attributes);
+        link = next;
+    }
+    return head;
+}
+
+TEST_CASE(incremental_marking_write_barrier)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+    auto& realm = interpreter->realm();
+    auto& heap = vm->heap();
+    auto chain = create_chain(realm, 10000);
+
+    heap.set_incremental_marking_step_budget(Time::zero());
+    heap.start_incremental_marking();
+
+    // Cells allocated during marking are traced in the next step.
+    auto holder = JS::make_handle(JS::Object::create(realm, nullptr));
+    EXPECT(!heap.perform_incremental_marking_step());
+    EXPECT(holder->is_marked());
+
+    // Move the unmarked end of the chain into the already traced holder.
+    JS::Object* before_last = nullptr;
+    JS::Object* last = chain.cell();
+    while (last->get_without_side_effects("next").is_object()) {
+        before_last = last;
+        last = &last->get_without_side_effects("next").as_object();
+    }
+    EXPECT(!last->is_marked());
+    holder->define_direct_property("item", last, JS::default_attributes);
+    before_last->define_direct_property("next", JS::js_null(), JS::default_attributes);
+
+    while (!heap.perform_incremental_marking_step())
+        ;
+    EXPECT(last->is_marked());
+    heap.collect_garbage();
+}
+
+TEST_CASE(incremental_marking_steps)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+    auto& heap = vm->heap();
+    run(*interpreter, setup_source);
+
+    heap.set_incremental_marking_step_budget(Time::zero());
+    heap.start_incremental_marking();
+    run(*interpreter, "create_holders();"sv);
+    EXPECT(!heap.perform_incremental_marking_step());
+
+    // Allocations also perform marking steps, so marking may finish on its own.
+    while (heap.is_incremental_marking_in_progress() && !heap.perform_incremental_marking_step())
+        run(*interpreter, "move_items();"sv);
+    if (heap.is_incremental_marking_in_progress())
+        heap.collect_garbage();
+
+    EXPECT(run(*interpreter, "check();"sv).as_bool());
+}
+
+TEST_CASE(incremental_marking_from_event_loop)
+{
+    Core::EventLoop event_loop;
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+    auto& heap = vm->heap();
+    run(*interpreter, setup_source);
+
+    heap.set_incremental_marking_enabled(true);
+    heap.set_incremental_marking_step_budget(Time::zero());
+    heap.start_incremental_marking();
+    run(*interpreter, "create_holders();"sv);
+    run(*interpreter, "move_items();"sv);
+    event_loop.spin_until([&] {
+        return !heap.is_incremental_marking_in_progress();
+    });
+
+    EXPECT(run(*interpreter, "check();"sv).as_bool());
+}
+
+TEST_CASE(destroy_heap_during_incremental_marking)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+    auto& heap = vm->heap();
+    run(*interpreter, setup_source);
+
+    heap.set_incremental_marking_step_budget(Time::zero());
+    heap.start_incremental_marking();
+    EXPECT(!heap.perform_incremental_marking_step());
+}
+
+// NOTE: This is a separate function for the same reason as create_chain().
+static NEVER_INLINE void create_strings(JS::VM& vm, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        (void)JS::PrimitiveString::create(vm, MUST(String::formatted("string {}", i)));
+}
+
+TEST_CASE(lazily_swept_strings_are_not_reused)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+    auto& heap = vm->heap();
+
+    // The dead strings stay in the string cache until their blocks are swept, so these must be new ones.
+    create_strings(*vm, 5000);
+    heap.collect_garbage();
+    JS::MarkedVector<JS::PrimitiveString*> strings(heap);
+    for (size_t i = 0; i < 5000; ++i) {
+        auto string = JS::PrimitiveString::create(*vm, MUST(String::formatted("string {}", i)));
+        EXPECT(!JS::Heap::is_dead(*string));
+        strings.append(string);
+    }
+
+    // Sweeping the dead strings must leave the new ones in the cache.
+    heap.collect_garbage();
+    for (size_t i = 0; i < 5000; ++i)
+        EXPECT_EQ(JS::PrimitiveString::create(*vm, MUST(String::formatted("string {}", i))).ptr(), strings[i]);
+}
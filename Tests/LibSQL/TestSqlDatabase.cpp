@@ -21,6 +21,8 @@ void insert_into_table(SQL::Database&, int);
 void verify_table_contents(SQL::Database&, int);
 void insert_and_verify(int);
 void commit(SQL::Database&);
+ByteBuffer make_block(u32);
+void copy_file(StringView, StringView);
 
 NonnullRefPtr<SQL::SchemaDef> setup_schema(SQL::Database& db)
 {
@@ -105,6 +107,21 @@ void insert_and_verify(int count)
     }
 }
 
+ByteBuffer make_block(u32 value)
+{
+    auto buffer = MUST(ByteBuffer::create_zeroed(SQL::BLOCKSIZE));
+    buffer.overwrite(0, &value, sizeof(u32));
+    return buffer;
+}
+
+void copy_file(StringView from, StringView to)
+{
+    auto source = MUST(Core::File::open(from, Core::File::OpenMode::Read));
+    auto contents = MUST(source->read_until_eof());
+    auto destination = MUST(Core::File::open(to, Core::File::OpenMode::Write));
+    MUST(destination->write_entire_buffer(contents));
+}
+
 TEST_CASE(create_heap)
 {
     ScopeGuard guard([]() { unlink("/tmp/test.db"); });
@@ -216,3 +233,75 @@ TEST_CASE(insert_100_into_table)
 {
     insert_and_verify(100);
 }
+
+TEST_CASE(heap_page_cache_is_bounded)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    Vector<u32> blocks;
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        EXPECT(!heap->open().is_error());
+        heap->set_cache_size(8);
+
+        for (u32 ix = 0; ix < 100; ix++) {
+            auto block = heap->new_record_pointer();
+            auto buffer = make_block(ix);
+            heap->add_to_wal(block, buffer);
+            blocks.append(block);
+        }
+        EXPECT(heap->cached_block_count() <= heap->cache_size());
+
+        // Blocks that were evicted before they were committed have to be read back from the log.
+        for (u32 ix = 0; ix < blocks.size(); ix++)
+            EXPECT_EQ(MUST(heap->read_block(blocks[ix])), make_block(ix));
+        EXPECT(!heap->flush().is_error());
+        EXPECT(heap->cached_block_count() <= heap->cache_size());
+    }
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        EXPECT(!heap->open().is_error());
+        for (u32 ix = 0; ix < blocks.size(); ix++)
+            EXPECT_EQ(MUST(heap->read_block(blocks[ix])), make_block(ix));
+    }
+}
+
+TEST_CASE(heap_recovers_committed_transactions)
+{
+    ScopeGuard guard([]() {
+        unlink("/tmp/test.db");
+        unlink("/tmp/test-crashed.db");
+        unlink("/tmp/test-crashed.db-wal");
+    });
+    Vector<u32> blocks;
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        EXPECT(!heap->open().is_error());
+        heap->set_cache_size(4);
+
+        for (u32 ix = 0; ix < 20; ix++) {
+            auto block = heap->new_record_pointer();
+            auto buffer = make_block(ix);
+            heap->add_to_wal(block, buffer);
+            blocks.append(block);
+        }
+        EXPECT(!heap->flush().is_error());
+        EXPECT(heap->wal_frame_count() > 0);
+
+        // These changes are evicted into the log, but never committed.
+        for (u32 ix = 0; ix < blocks.size(); ix++) {
+            auto buffer = make_block(ix + 1000);
+            heap->add_to_wal(blocks[ix], buffer);
+        }
+
+        // Copying the files while the heap is still open leaves them in the state they'd be in after a crash.
+        copy_file("/tmp/test.db"sv, "/tmp/test-crashed.db"sv);
+        copy_file(heap->wal_file_name(), "/tmp/test-crashed.db-wal"sv);
+    }
+    {
+        auto heap = SQL::Heap::construct("/tmp/test-crashed.db");
+        EXPECT(!heap->open().is_error());
+        EXPECT_EQ(heap->wal_frame_count(), 0u);
+        for (u32 ix = 0; ix < blocks.size(); ix++)
+            EXPECT_EQ(MUST(heap->read_block(blocks[ix])), make_block(ix));
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <unistd.h>
+
+#include <AK/ScopeGuard.h>
+#include <LibTest/TestCase.h>
+#include <SQLServer/DatabaseConnection.h>
+#include <SQLServer/SQLStatement.h>
+
+namespace {
+
+constexpr auto database_path = "/tmp"sv;
+constexpr auto database_name = "test-prepared-statements"sv;
+constexpr char const* database_file = "/tmp/test-prepared-statements.db";
+
+NonnullRefPtr<SQLServer::DatabaseConnection> connect()
+{
+    return MUST(SQLServer::DatabaseConnection::create(database_path, database_name, 0));
+}
+
+SQL::StatementID prepare(SQLServer::DatabaseConnection& connection, DeprecatedString const& sql)
+{
+    auto statement_id = connection.prepare_statement(sql);
+    VERIFY(!statement_id.is_error());
+    return statement_id.value();
+}
+
+DeprecatedString nth_statement(size_t n)
+{
+    return DeprecatedString::formatted("SELECT {} FROM TestSchema.TestTable;", n);
+}
+
+Vector<SQL::StatementID> fill_cache(SQLServer::DatabaseConnection& connection)
+{
+    Vector<SQL::StatementID> statement_ids;
+    for (size_t i = 0; i < SQLServer::DatabaseConnection::prepared_statement_cache_size; ++i)
+        statement_ids.append(prepare(connection, nth_statement(i)));
+    return statement_ids;
+}
+
+}
+
+TEST_CASE(reuse_prepared_statement)
+{
+    ScopeGuard guard([]() { unlink(database_file); });
+    auto connection = connect();
+
+    auto statement_id = prepare(connection, "SELECT * FROM TestSchema.TestTable;");
+    EXPECT_EQ(prepare(connection, "SELECT * FROM TestSchema.TestTable;"), statement_id);
+    EXPECT_NE(prepare(connection, "SELECT TextColumn FROM TestSchema.TestTable;"), statement_id);
+    EXPECT(SQLServer::SQLStatement::statement_for(statement_id));
+
+    connection->disconnect();
+    EXPECT(!SQLServer::SQLStatement::statement_for(statement_id));
+}
+
+TEST_CASE(evict_least_recently_prepared_statement)
+{
+    ScopeGuard guard([]() { unlink(database_file); });
+    auto connection = connect();
+
+    auto statement_ids = fill_cache(connection);
+    EXPECT_EQ(prepare(connection, nth_statement(0)), statement_ids[0]);
+
+    prepare(connection, "SELECT * FROM TestSchema.TestTable;");
+    EXPECT(SQLServer::SQLStatement::statement_for(statement_ids[0]));
+    EXPECT(!SQLServer::SQLStatement::statement_for(statement_ids[1]));
+    EXPECT_NE(prepare(connection, nth_statement(1)), statement_ids[1]);
+
+    connection->disconnect();
+}
+
+TEST_CASE(executed_statement_is_not_evicted)
+{
+    ScopeGuard guard([]() { unlink(database_file); });
+    auto connection = connect();
+
+    auto statement_ids = fill_cache(connection);
+    connection->did_execute_statement(statement_ids[0]);
+
+    prepare(connection, "SELECT * FROM TestSchema.TestTable;");
+    EXPECT(SQLServer::SQLStatement::statement_for(statement_ids[0]));
+    EXPECT(!SQLServer::SQLStatement::statement_for(statement_ids[1]));
+
+    connection->disconnect();
+}
+
+TEST_CASE(statement_does_not_keep_connection_alive)
+{
+    ScopeGuard guard([]() { unlink(database_file); });
+
+    RefPtr<SQLServer::SQLStatement> statement;
+    {
+        auto connection = connect();
+        statement = SQLServer::SQLStatement::statement_for(prepare(connection, "SELECT * FROM TestSchema.TestTable;"));
+        EXPECT(statement);
+        EXPECT_EQ(statement->connection(), connection.ptr());
+        connection->disconnect();
+    }
+
+    EXPECT(!statement->connection());
+    EXPECT(!SQLServer::SQLStatement::statement_for(statement->statement_id()));
+}
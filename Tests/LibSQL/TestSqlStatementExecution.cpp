@@ -388,6 +388,78 @@ TEST_CASE(select_inner_join)
     EXPECT_EQ(result[0].row[2].to_deprecated_string(), "Test_12");
 }
 
+TEST_CASE(select_inner_join_with_where)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    EXPECT(!database->open().is_error());
+    create_two_tables(database);
+    auto result = execute(database, "CREATE TABLE TestSchema.TestTable3 ( TextColumn3 text, IntColumn3 integer );");
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Create);
+
+    for (auto count = 0; count < 100; count++) {
+        result = execute(database,
+            DeprecatedString::formatted("INSERT INTO TestSchema.TestTable1 ( TextColumn1, IntColumn ) VALUES ( 'Test_{}', {} );", count, count));
+        EXPECT(result.size() == 1);
+        result = execute(database,
+            DeprecatedString::formatted("INSERT INTO TestSchema.TestTable2 ( TextColumn2, IntColumn ) VALUES ( 'Test_{}', {} );", count, count % 10));
+        EXPECT(result.size() == 1);
+    }
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable3 ( TextColumn3, IntColumn3 ) VALUES "
+        "( 'Test_5', 1 ), "
+        "( 'Test_15', 2 ), "
+        "( 'Test_99', 3 );");
+    EXPECT(result.size() == 3);
+
+    result = execute(database,
+        "SELECT TestTable1.IntColumn, TextColumn2, IntColumn3 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2, TestSchema.TestTable3 "
+        "WHERE (TestTable1.IntColumn = TestTable2.IntColumn) AND (TextColumn2 = TextColumn3) AND (TestTable1.IntColumn < 8) "
+        "ORDER BY IntColumn3;");
+    EXPECT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].row[0].to_int<i32>(), 5);
+    EXPECT_EQ(result[0].row[1].to_deprecated_string(), "Test_5");
+    EXPECT_EQ(result[0].row[2].to_int<i32>(), 1);
+    EXPECT_EQ(result[1].row[0].to_int<i32>(), 5);
+    EXPECT_EQ(result[1].row[1].to_deprecated_string(), "Test_15");
+    EXPECT_EQ(result[1].row[2].to_int<i32>(), 2);
+
+    result = execute(database,
+        "SELECT TextColumn1 FROM TestSchema.TestTable1, TestSchema.TestTable3 "
+        "WHERE (TextColumn1 = TextColumn3) OR (IntColumn3 = IntColumn);");
+    EXPECT_EQ(result.size(), 6u);
+
+    result = execute(database,
+        "SELECT TextColumn1 FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TestTable1.IntColumn = TestTable2.IntColumn) AND (TextColumn1 = 'Test_99');");
+    EXPECT_EQ(result.size(), 0u);
+}
+
+TEST_CASE(select_cross_join_with_limit)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    EXPECT(!database->open().is_error());
+    create_two_tables(database);
+    for (auto count = 0; count < 100; count++) {
+        auto result = execute(database,
+            DeprecatedString::formatted("INSERT INTO TestSchema.TestTable1 ( TextColumn1, IntColumn ) VALUES ( 'Test_{}', {} );", count, count));
+        EXPECT(result.size() == 1);
+        result = execute(database,
+            DeprecatedString::formatted("INSERT INTO TestSchema.TestTable2 ( TextColumn2, IntColumn ) VALUES ( 'Test_{}', {} );", count, count));
+        EXPECT(result.size() == 1);
+    }
+
+    auto result = execute(database, "SELECT * FROM TestSchema.TestTable1, TestSchema.TestTable2 LIMIT 10 OFFSET 95;");
+    EXPECT_EQ(result.size(), 10u);
+    for (size_t i = 0; i < 5; ++i)
+        EXPECT_EQ(result[i].row[0], result[0].row[0]);
+    for (size_t i = 5; i < 10; ++i)
+        EXPECT_EQ(result[i].row[0], result[5].row[0]);
+    EXPECT_NE(result[0].row[0], result[5].row[0]);
+}
+
 TEST_CASE(select_with_like)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/RegisterInterpreter.h>
+#include <LibWasm/Types.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// (module
+//   (memory 1)
+//   (func (export "load") (param i32) (result i32) (i32.load (local.get 0)))
+//   (func (export "nested") (param i32) (result i32) (call 0 (local.get 0))))
+static constexpr u8 module_bytes[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x03, 0x03, 0x02, 0x00, 0x00,
+    0x05, 0x03, 0x01, 0x00, 0x01,
+    0x07, 0x11, 0x02, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x00, 0x06, 0x6e, 0x65, 0x73, 0x74, 0x65, 0x64, 0x00, 0x01,
+    0x0a, 0x10, 0x02, 0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x00, 0x0b, 0x06, 0x00, 0x20, 0x00, 0x10, 0x00, 0x0b
+};
+
+static constexpr i32 memory_size = 64 * KiB;
+
+class GuardPageTestMachine {
+public:
+    GuardPageTestMachine()
+        : m_module(parse_module())
+    {
+        m_machine.enable_guard_page_memories();
+        auto result = m_machine.instantiate(m_module, {});
+        VERIFY(!result.is_error());
+        m_instance = result.release_value();
+    }
+
+    Wasm::Result call(Wasm::Interpreter& interpreter, StringView name, i32 address)
+    {
+        auto function = m_instance->exports().first_matching([&](auto& entry) { return entry.name() == name; });
+        VERIFY(function.has_value());
+        return m_machine.invoke(interpreter, function->value().get<Wasm::FunctionAddress>(), { Wasm::Value { address } });
+    }
+
+private:
+    static Wasm::Module parse_module()
+    {
+        FixedMemoryStream stream { ReadonlyBytes { module_bytes, sizeof(module_bytes) } };
+        auto result = Wasm::Module::parse(stream);
+        VERIFY(!result.is_error());
+        return result.release_value();
+    }
+
+    Wasm::Module m_module;
+    Wasm::AbstractMachine m_machine;
+    OwnPtr<Wasm::ModuleInstance> m_instance;
+};
+
+static void expect_traps_and_recovers(Wasm::Interpreter& interpreter)
+{
+    GuardPageTestMachine machine;
+
+    for (auto name : { "load"sv, "nested"sv }) {
+        auto result = machine.call(interpreter, name, memory_size - 4);
+        EXPECT(!result.is_trap());
+
+        for (auto address : { memory_size - 3, memory_size, memory_size + 4096 }) {
+            result = machine.call(interpreter, name, address);
+            EXPECT(result.is_trap());
+            if (result.is_trap())
+                EXPECT_EQ(result.trap().reason, "Memory access out of bounds");
+        }
+
+        // The faults must have left nothing behind that breaks the calls after them.
+        result = machine.call(interpreter, name, 0);
+        EXPECT(!result.is_trap());
+        if (!result.is_trap())
+            EXPECT_EQ(result.values().first().to<i32>(), 0);
+    }
+}
+
+static u8* s_unrelated_page { nullptr };
+static sig_atomic_t volatile s_unrelated_faults { 0 };
+
+static void handle_unrelated_fault(int, siginfo_t* info, void*)
+{
+    VERIFY(info->si_addr == s_unrelated_page);
+    s_unrelated_faults = s_unrelated_faults + 1;
+    mprotect(s_unrelated_page, PAGE_SIZE, PROT_READ | PROT_WRITE);
+}
+
+// NOTE: This has to come first, as the fault handler for guard pages is only installed once, the first time such a
+//       memory is created, and it has to find the handler below to pass on the faults that aren't its own.
+TEST_CASE(faults_outside_guard_pages_go_to_the_previous_handler)
+{
+    struct sigaction action {};
+    action.sa_sigaction = handle_unrelated_fault;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    struct sigaction previous_action;
+    VERIFY(sigaction(SIGSEGV, &action, &previous_action) == 0);
+
+    s_unrelated_page = static_cast<u8*>(mmap(nullptr, PAGE_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    VERIFY(s_unrelated_page != MAP_FAILED);
+
+    Wasm::BytecodeInterpreter interpreter;
+    GuardPageTestMachine machine;
+
+    *static_cast<u8 volatile*>(s_unrelated_page) = 42;
+    EXPECT_EQ(s_unrelated_faults, 1);
+    EXPECT_EQ(s_unrelated_page[0], 42);
+
+    // Passing the fault on must not have uninstalled the handler for guard pages.
+    auto result = machine.call(interpreter, "load"sv, memory_size);
+    EXPECT(result.is_trap());
+
+    munmap(s_unrelated_page, PAGE_SIZE);
+}
+
+TEST_CASE(out_of_bounds_access_traps)
+{
+    Wasm::BytecodeInterpreter interpreter;
+    expect_traps_and_recovers(interpreter);
+}
+
+TEST_CASE(out_of_bounds_access_traps_with_register_interpreter)
+{
+    Wasm::RegisterInterpreter interpreter;
+    expect_traps_and_recovers(interpreter);
+}
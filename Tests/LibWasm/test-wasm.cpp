@@ -7,11 +7,14 @@
 #include <AK/MemoryStream.h>
 #include <LibTest/JavaScriptTestRunner.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/RegisterInterpreter.h>
 #include <LibWasm/Types.h>
 #include <string.h>
 
 TEST_ROOT("Userland/Libraries/LibWasm/Tests");
 
+TESTJS_PROGRAM_FLAG(use_register_interpreter, "Call functions on the register interpreter", "register-interpreter", 0);
+
 TESTJS_GLOBAL_FUNCTION(read_binary_wasm_file, readBinaryWasmFile)
 {
     auto& realm = *vm.current_realm();
@@ -157,6 +160,30 @@ JS::ThrowCompletionOr<void> WebAssemblyModule::initialize(JS::Realm& realm)
     return {};
 }
 
+// Vectors are passed around as BigInts holding their 128 bits, the first lane being the least significant one.
+static Crypto::SignedBigInteger vector_to_bigint(u128 value)
+{
+    Vector<Crypto::UnsignedBigInteger::Word, Crypto::STARTING_WORD_SIZE> words;
+    for (auto part : { value.low(), value.high() }) {
+        words.append(static_cast<u32>(part));
+        words.append(static_cast<u32>(part >> 32));
+    }
+    while (words.size() > 1 && words.last() == 0)
+        words.take_last();
+    return Crypto::SignedBigInteger { Crypto::UnsignedBigInteger { move(words) } };
+}
+
+static u128 bigint_to_vector(Crypto::SignedBigInteger const& value)
+{
+    u128 result { 0u };
+    auto& words = value.unsigned_value().words();
+    for (size_t i = 0; i < min(words.size(), sizeof(u128) / sizeof(words[0])); ++i)
+        result |= u128 { words[i] } << (i * sizeof(words[0]) * 8);
+    if (value.is_negative())
+        result = ~result + 1u;
+    return result;
+}
+
 JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::get_export)
 {
     auto name = TRY(vm.argument(0).to_deprecated_string(vm));
@@ -175,6 +202,7 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::get_export)
                     [&](auto const& value) -> JS::Value { return JS::Value(static_cast<double>(value)); },
                     [&](i32 value) { return JS::Value(static_cast<double>(value)); },
                     [&](i64 value) -> JS::Value { return JS::BigInt::create(vm, Crypto::SignedBigInteger { value }); },
+                    [&](u128 value) -> JS::Value { return JS::BigInt::create(vm, vector_to_bigint(value)); },
                     [&](Wasm::Reference const& reference) -> JS::Value {
                         return reference.ref().visit(
                             [&](const Wasm::Reference::Null&) -> JS::Value { return JS::js_null(); },
@@ -227,6 +255,11 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
         case Wasm::ValueType::Kind::F64:
             arguments.append(Wasm::Value(static_cast<double>(double_value)));
             break;
+        case Wasm::ValueType::Kind::V128: {
+            auto bigint = TRY(argument.to_bigint(vm));
+            arguments.append(Wasm::Value(bigint_to_vector(bigint->big_integer())));
+            break;
+        }
         case Wasm::ValueType::Kind::FunctionReference:
             arguments.append(Wasm::Value(Wasm::Reference { Wasm::Reference::Func { static_cast<u64>(double_value) } }));
             break;
@@ -242,7 +275,13 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
         }
     }
 
-    auto result = WebAssemblyModule::machine().invoke(function_address, arguments);
+    auto result = [&] {
+        if (use_register_interpreter) {
+            Wasm::RegisterInterpreter interpreter;
+            return WebAssemblyModule::machine().invoke(interpreter, function_address, arguments);
+        }
+        return WebAssemblyModule::machine().invoke(function_address, arguments);
+    }();
     if (result.is_trap())
         return vm.throw_completion<JS::TypeError>(TRY_OR_THROW_OOM(vm, String::formatted("Execution trapped: {}", result.trap().reason)));
 
@@ -254,6 +293,7 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
         [&](auto const& value) { return_value = JS::Value(static_cast<double>(value)); },
         [&](i32 value) { return_value = JS::Value(static_cast<double>(value)); },
         [&](i64 value) { return_value = JS::Value(JS::BigInt::create(vm, Crypto::SignedBigInteger { value })); },
+        [&](u128 value) { return_value = JS::Value(JS::BigInt::create(vm, vector_to_bigint(value))); },
         [&](Wasm::Reference const& reference) {
             reference.ref().visit(
                 [&](const Wasm::Reference::Null&) { return_value = JS::js_null(); },
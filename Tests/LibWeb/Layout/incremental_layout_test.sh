@@ -0,0 +1,32 @@
+#!/usr/bin/env bash
+
+# Checks that laying out only what changed since the previous layout gives the same result as laying out
+# everything again. Every page in incremental/ changes after being laid out once, and its layout tree is
+# compared against the one we get when the whole page is laid out from scratch.
+
+set -eo pipefail
+
+SCRIPT_DIR="$(cd -P -- "$(dirname -- "${0}")" && pwd -P)"
+LAGOM_BUILD_DIR="${1}"
+
+if [[ -z "${LAGOM_BUILD_DIR}" ]] ; then
+    echo "Provide path to the Lagom build directory"
+    exit 1
+fi
+
+HEADLESS_BROWSER_BINARY="./headless-browser"
+RESOURCES_DIR="${SCRIPT_DIR}/../../../Base/res"
+
+for input_html_path in "${SCRIPT_DIR}"/incremental/*.html; do
+    input_html_file="$(basename "${input_html_path}" .html)"
+
+    incremental_layout_dump=$(cd "${LAGOM_BUILD_DIR}"; "${HEADLESS_BROWSER_BINARY}" -r "${RESOURCES_DIR}" -d "file://${input_html_path}")
+    full_layout_dump=$(cd "${LAGOM_BUILD_DIR}"; "${HEADLESS_BROWSER_BINARY}" -r "${RESOURCES_DIR}" -d --from-scratch "file://${input_html_path}")
+
+    if cmp <(echo "${incremental_layout_dump}") <(echo "${full_layout_dump}"); then
+        echo "${input_html_file} PASSED"
+    else
+        echo "${input_html_file} FAILED"
+        diff <(echo "${full_layout_dump}") <(echo "${incremental_layout_dump}")
+    fi
+done
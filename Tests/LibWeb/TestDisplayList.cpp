@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Gradients.h>
+#include <LibGfx/Painter.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/RecordingPainter.h>
+
+static constexpr Gfx::IntSize canvas_size { 120, 100 };
+
+static NonnullRefPtr<Gfx::Bitmap> create_canvas()
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, canvas_size));
+    bitmap->fill(Color::White);
+    return bitmap;
+}
+
+static NonnullRefPtr<Gfx::Bitmap> create_checkerboard()
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 8, 8 }));
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x)
+            bitmap->set_pixel(x, y, (x + y) % 2 ? Color::Black : Color::Magenta);
+    }
+    return bitmap;
+}
+
+// Works the same on a Gfx::Painter and a RecordingPainter, so the results can be compared.
+template<typename PainterType>
+static void paint_scene(PainterType& painter, Gfx::Bitmap const& image)
+{
+    painter.fill_rect({ 5, 5, 50, 30 }, Color::Red);
+    painter.draw_rect({ 0, 0, 120, 100 }, Color::Blue);
+    painter.draw_line({ 0, 99 }, { 119, 0 }, Color::Green, 2);
+
+    painter.save();
+    painter.translate(40, 30);
+    painter.add_clip_rect({ 0, 0, 30, 20 });
+    painter.fill_rect({ -10, -10, 100, 100 }, Color::from_rgb(0x336699));
+    painter.blit({ 10, 5 }, image, image.rect(), 0.5f);
+    painter.restore();
+
+    Array<Gfx::ColorStop, 2> color_stops { Gfx::ColorStop { Color::Yellow, 0 }, Gfx::ColorStop { Color::Cyan, 1 } };
+    painter.fill_rect_with_linear_gradient({ 60, 60, 50, 30 }, color_stops, 90);
+
+    // Far outside of the canvas, so it should get culled from the list without changing anything.
+    painter.fill_rect({ 1000, 1000, 10, 10 }, Color::Black);
+}
+
+static void expect_same_pixels(Gfx::Bitmap const& expected, Gfx::Bitmap const& actual)
+{
+    for (int y = 0; y < canvas_size.height(); ++y) {
+        for (int x = 0; x < canvas_size.width(); ++x) {
+            if (expected.get_pixel(x, y) != actual.get_pixel(x, y)) {
+                FAIL(DeprecatedString::formatted("Pixel at {},{} is {}, expected {}", x, y, actual.get_pixel(x, y), expected.get_pixel(x, y)));
+                return;
+            }
+        }
+    }
+}
+
+TEST_CASE(replay_matches_direct_painting)
+{
+    auto image = create_checkerboard();
+
+    auto expected = create_canvas();
+    Gfx::Painter direct_painter(expected);
+    paint_scene(direct_painter, image);
+
+    Web::Painting::RecordingPainter recording_painter;
+    paint_scene(recording_painter, image);
+    auto display_list = recording_painter.take_display_list();
+
+    auto actual = create_canvas();
+    Gfx::Painter replay_painter(actual);
+    display_list->execute(replay_painter);
+
+    expect_same_pixels(expected, actual);
+}
+
+TEST_CASE(replay_matches_direct_painting_with_clipped_and_translated_target)
+{
+    auto image = create_checkerboard();
+
+    auto prepare = [](Gfx::Painter& painter) {
+        painter.add_clip_rect({ 20, 10, 60, 50 });
+        painter.translate(7, 3);
+    };
+
+    auto expected = create_canvas();
+    Gfx::Painter direct_painter(expected);
+    prepare(direct_painter);
+    paint_scene(direct_painter, image);
+
+    Web::Painting::RecordingPainter recording_painter;
+    paint_scene(recording_painter, image);
+    auto display_list = recording_painter.take_display_list();
+
+    // The same list can be replayed onto any number of targets.
+    for (int i = 0; i < 2; ++i) {
+        auto actual = create_canvas();
+        Gfx::Painter replay_painter(actual);
+        prepare(replay_painter);
+        display_list->execute(replay_painter);
+        expect_same_pixels(expected, actual);
+    }
+}
+
+TEST_CASE(replay_of_nested_lists_matches_direct_painting)
+{
+    auto image = create_checkerboard();
+
+    auto expected = create_canvas();
+    Gfx::Painter direct_painter(expected);
+    direct_painter.fill_rect({ 0, 0, 120, 10 }, Color::DarkGray);
+    direct_painter.save();
+    direct_painter.translate(30, 20);
+    paint_scene(direct_painter, image);
+    direct_painter.restore();
+    paint_scene(direct_painter, image);
+
+    // A list recorded in its own coordinate space, like the one of a stacking context that gets cached.
+    Web::Painting::RecordingPainter nested_recording_painter;
+    paint_scene(nested_recording_painter, image);
+    auto nested_display_list = nested_recording_painter.take_display_list();
+
+    Web::Painting::RecordingPainter recording_painter;
+    recording_painter.fill_rect({ 0, 0, 120, 10 }, Color::DarkGray);
+    recording_painter.save();
+    recording_painter.translate(30, 20);
+    recording_painter.append(*nested_display_list, Web::Painting::RecordingPainter::CoordinateSpace::New);
+    recording_painter.restore();
+
+    // And one recorded starting from the state of the recorder it gets appended to.
+    Web::Painting::RecordingPainter shared_recording_painter { recording_painter.state() };
+    paint_scene(shared_recording_painter, image);
+    auto shared_display_list = shared_recording_painter.take_display_list();
+    recording_painter.append(*shared_display_list, Web::Painting::RecordingPainter::CoordinateSpace::Shared);
+
+    auto display_list = recording_painter.take_display_list();
+
+    auto actual = create_canvas();
+    Gfx::Painter replay_painter(actual);
+    display_list->execute(replay_painter);
+
+    expect_same_pixels(expected, actual);
+}
@@ -160,6 +160,9 @@ private:
     int virt$disown(pid_t);
     int virt$dup2(int, int);
     int virt$emuctl(FlatPtr, FlatPtr, FlatPtr);
+    int virt$epoll_create(unsigned);
+    int virt$epoll_ctl(int epfd, int op, int fd, FlatPtr event);
+    int virt$epoll_wait(FlatPtr);
     int virt$execve(FlatPtr);
     void virt$exit(int);
     int virt$faccessat(FlatPtr);
@@ -224,6 +227,7 @@ private:
     int virt$scheduler_get_parameters(FlatPtr);
     int virt$scheduler_set_parameters(FlatPtr);
     int virt$sendfd(int, int);
+    int virt$sendfile(int, int, FlatPtr, size_t);
     int virt$sendmsg(int sockfd, FlatPtr msg_addr, int flags);
     int virt$set_coredump_metadata(FlatPtr address);
     int virt$set_mmap_name(FlatPtr);
@@ -17,6 +17,7 @@
 #include <sched.h>
 #include <serenity.h>
 #include <strings.h>
+#include <sys/epoll.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/poll.h>
@@ -73,6 +74,12 @@ u32 Emulator::virt_syscall(u32 function, u32 arg1, u32 arg2, u32 arg3)
         return virt$dbgputstr(arg1, arg2);
     case SC_disown:
         return virt$disown(arg1);
+    case SC_epoll_create:
+        return virt$epoll_create(arg1);
+    case SC_epoll_ctl:
+        return virt$epoll_ctl(arg1, arg2, arg3, arg4);
+    case SC_epoll_wait:
+        return virt$epoll_wait(arg1);
     case SC_dup2:
         return virt$dup2(arg1, arg2);
     case SC_emuctl:
@@ -144,6 +151,10 @@ u32 Emulator::virt_syscall(u32 function, u32 arg1, u32 arg2, u32 arg3)
         return virt$inode_watcher_remove_watch(arg1, arg2);
     case SC_ioctl:
         return virt$ioctl(arg1, arg2, arg3);
+    case SC_io_ring_create:
+    case SC_io_ring_enter:
+        // The rings refer to the memory of the emulated process, which the kernel can't see.
+        return -ENOSYS;
     case SC_kill:
         return virt$kill(arg1, arg2);
     case SC_killpg:
@@ -206,6 +217,8 @@ u32 Emulator::virt_syscall(u32 function, u32 arg1, u32 arg2, u32 arg3)
         return virt$scheduler_set_parameters(arg1);
     case SC_sendfd:
         return virt$sendfd(arg1, arg2);
+    case SC_sendfile:
+        return virt$sendfile(arg1, arg2, arg3, arg4);
     case SC_sendmsg:
         return virt$sendmsg(arg1, arg2, arg3);
     case SC_set_coredump_metadata:
@@ -276,6 +289,17 @@ int Emulator::virt$sendfd(int socket, int fd)
     return syscall(SC_sendfd, socket, fd);
 }
 
+int Emulator::virt$sendfile(int out_fd, int in_fd, FlatPtr offset_addr, size_t count)
+{
+    off_t offset = 0;
+    if (offset_addr)
+        mmu().copy_from_vm(&offset, offset_addr, sizeof(offset));
+    int rc = syscall(SC_sendfile, out_fd, in_fd, offset_addr ? &offset : nullptr, count);
+    if (rc >= 0 && offset_addr)
+        mmu().copy_to_vm(offset_addr, &offset, sizeof(offset));
+    return rc;
+}
+
 int Emulator::virt$recvfd(int socket, int options)
 {
     return syscall(SC_recvfd, socket, options);
@@ -1542,6 +1566,46 @@ int Emulator::virt$create_inode_watcher(unsigned flags)
     return syscall(SC_create_inode_watcher, flags);
 }
 
+int Emulator::virt$epoll_create(unsigned flags)
+{
+    return syscall(SC_epoll_create, flags);
+}
+
+int Emulator::virt$epoll_ctl(int epfd, int op, int fd, FlatPtr event_addr)
+{
+    epoll_event event {};
+    if (event_addr)
+        mmu().copy_from_vm(&event, event_addr, sizeof(event));
+    return syscall(SC_epoll_ctl, epfd, op, fd, event_addr ? &event : nullptr);
+}
+
+int Emulator::virt$epoll_wait(FlatPtr params_addr)
+{
+    Syscall::SC_epoll_wait_params params;
+    mmu().copy_from_vm(&params, params_addr, sizeof(params));
+
+    if (params.maxevents <= 0)
+        return -EINVAL;
+
+    Vector<epoll_event> events;
+    events.resize(params.maxevents);
+    struct timespec timeout;
+    u32 sigmask;
+
+    if (params.timeout)
+        mmu().copy_from_vm(&timeout, (FlatPtr)params.timeout, sizeof(timeout));
+    if (params.sigmask)
+        mmu().copy_from_vm(&sigmask, (FlatPtr)params.sigmask, sizeof(sigmask));
+
+    int rc = epoll_pwait2(params.epfd, events.data(), params.maxevents, params.timeout ? &timeout : nullptr, params.sigmask ? &sigmask : nullptr);
+    if (rc < 0)
+        return -errno;
+
+    if (rc > 0)
+        mmu().copy_to_vm((FlatPtr)params.events, events.data(), sizeof(epoll_event) * rc);
+    return rc;
+}
+
 int Emulator::virt$inode_watcher_add_watch(FlatPtr params_addr)
 {
     Syscall::SC_inode_watcher_add_watch_params params;
@@ -8,8 +8,9 @@
 #include <AK/Array.h>
 #include <AK/Assertions.h>
 #include <AK/BinaryHeap.h>
-#include <AK/BinarySearch.h>
 #include <AK/BitStream.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/Endian.h>
 #include <AK/MemoryStream.h>
 #include <string.h>
 
@@ -64,8 +65,8 @@ Optional<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         }
     }
     if (non_zero_symbols == 1) { // special case - only 1 symbol
-        code.m_symbol_codes.append(0b10);
-        code.m_symbol_values.append(last_non_zero);
+        for (size_t i = 0; i < code.m_primary_table.size(); i += 2)
+            code.m_primary_table[i] = { .symbol = static_cast<u16>(last_non_zero), .code_length = 1 };
         code.m_bit_codes[last_non_zero] = 0;
         code.m_bit_code_lengths[last_non_zero] = 1;
         return code;
@@ -83,11 +84,15 @@ Optional<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             if (next_code > start_bit)
                 return {};
 
-            code.m_symbol_codes.append(start_bit | next_code);
-            code.m_symbol_values.append(symbol);
             code.m_bit_codes[symbol] = fast_reverse16(start_bit | next_code, code_length); // DEFLATE writes huffman encoded symbols as lsb-first
             code.m_bit_code_lengths[symbol] = code_length;
 
+            // A short code occupies every primary table entry whose low bits are the code.
+            if (code_length <= primary_table_bits) {
+                for (size_t index = code.m_bit_codes[symbol]; index < code.m_primary_table.size(); index += 1 << code_length)
+                    code.m_primary_table[index] = { .symbol = static_cast<u16>(symbol), .code_length = static_cast<u8>(code_length) };
+            }
+
             next_code++;
         }
     }
@@ -96,24 +101,51 @@ Optional<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
         return {};
     }
 
+    // All long codes that share their first primary_table_bits bits get a secondary table,
+    // which is large enough to be indexed by the remaining bits of the longest of them.
+    Array<u8, 1 << primary_table_bits> longest_code_length_for_prefix {};
+    for (size_t symbol = 0; symbol < bytes.size(); ++symbol) {
+        if (bytes[symbol] <= primary_table_bits)
+            continue;
+        auto& longest_code_length = longest_code_length_for_prefix[code.m_bit_codes[symbol] & (code.m_primary_table.size() - 1)];
+        longest_code_length = max(longest_code_length, bytes[symbol]);
+    }
+
+    for (size_t prefix = 0; prefix < longest_code_length_for_prefix.size(); ++prefix) {
+        if (longest_code_length_for_prefix[prefix] == 0)
+            continue;
+        u8 secondary_table_bits = longest_code_length_for_prefix[prefix] - primary_table_bits;
+        code.m_primary_table[prefix] = { .symbol = static_cast<u16>(code.m_secondary_tables.size()), .secondary_table_bits = secondary_table_bits };
+        code.m_secondary_tables.resize(code.m_secondary_tables.size() + (1 << secondary_table_bits));
+    }
+
+    for (size_t symbol = 0; symbol < bytes.size(); ++symbol) {
+        auto code_length = bytes[symbol];
+        if (code_length <= primary_table_bits)
+            continue;
+        auto const& table = code.m_primary_table[code.m_bit_codes[symbol] & (code.m_primary_table.size() - 1)];
+        auto table_size = 1u << table.secondary_table_bits;
+        for (size_t index = code.m_bit_codes[symbol] >> primary_table_bits; index < table_size; index += 1 << (code_length - primary_table_bits))
+            code.m_secondary_tables[table.symbol + index] = { .symbol = static_cast<u16>(symbol), .code_length = code_length };
+    }
+
     return code;
 }
 
 ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
 {
-    u32 code_bits = 1;
-
-    for (;;) {
-        code_bits = code_bits << 1 | TRY(stream.read_bits(1));
-        if (code_bits >= (1 << 16))
-            return Error::from_string_literal("Symbol exceeds maximum symbol number");
-
-        // FIXME: This is very inefficient and could greatly be improved by implementing this
-        //        algorithm: https://www.hanshq.net/zip.html#huffdec
-        size_t index;
-        if (binary_search(m_symbol_codes.span(), code_bits, &index))
-            return m_symbol_values[index];
-    }
+    // Deflate codes are at most 15 bits long, so peeking at that many bits is enough to decode any symbol with at most two lookups.
+    auto bits = TRY(stream.peek_bits<u16>(max_code_length));
+
+    auto entry = m_primary_table[bits & (m_primary_table.size() - 1)];
+    if (entry.secondary_table_bits != 0)
+        entry = m_secondary_tables[entry.symbol + ((bits >> primary_table_bits) & ((1 << entry.secondary_table_bits) - 1))];
+
+    if (entry.code_length == 0)
+        return Error::from_string_literal("Symbol exceeds maximum symbol number");
+
+    TRY(stream.discard_previously_peeked_bits(entry.code_length));
+    return entry.symbol;
 }
 
 ErrorOr<void> CanonicalCode::write_symbol(LittleEndianOutputBitStream& stream, u32 symbol) const
@@ -157,11 +189,12 @@ ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
 
         auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
 
-        for (size_t idx = 0; idx < length; ++idx) {
-            u8 byte = 0;
-            TRY(m_decompressor.m_output_buffer.read_with_seekback({ &byte, sizeof(byte) }, distance));
-
-            m_decompressor.m_output_buffer.write({ &byte, sizeof(byte) });
+        // The copied bytes may overlap the ones they produce, so they are copied in chunks of at most `distance` bytes.
+        Array<u8, DeflateCompressor::max_match_length> buffer;
+        for (size_t copied = 0; copied < length;) {
+            auto chunk = TRY(m_decompressor.m_output_buffer.read_with_seekback(buffer.span().trim(min(length - copied, distance)), distance));
+            m_decompressor.m_output_buffer.write(chunk);
+            copied += chunk.size();
         }
 
         return true;
@@ -182,6 +215,8 @@ ErrorOr<bool> DeflateDecompressor::UncompressedBlock::try_read_more()
     Array<u8, 4096> temporary_buffer;
     auto readable_bytes = temporary_buffer.span().trim(min(m_bytes_remaining, m_decompressor.m_output_buffer.empty_space()));
     auto read_bytes = TRY(m_decompressor.m_input_stream->read(readable_bytes));
+    if (read_bytes.is_empty())
+        return Error::from_string_literal("Unexpected end of stream in uncompressed block");
     auto written_bytes = m_decompressor.m_output_buffer.write(read_bytes);
     VERIFY(read_bytes.size() == written_bytes);
 
@@ -190,13 +225,19 @@ ErrorOr<bool> DeflateDecompressor::UncompressedBlock::try_read_more()
 }
 
 ErrorOr<NonnullOwnPtr<DeflateDecompressor>> DeflateDecompressor::construct(MaybeOwned<Stream> stream)
+{
+    auto bit_stream = TRY(try_make<LittleEndianInputBitStream>(move(stream)));
+    return construct(MaybeOwned<LittleEndianInputBitStream>(move(bit_stream)));
+}
+
+ErrorOr<NonnullOwnPtr<DeflateDecompressor>> DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream> stream)
 {
     auto output_buffer = TRY(CircularBuffer::create_empty(32 * KiB));
     return TRY(adopt_nonnull_own_or_enomem(new (nothrow) DeflateDecompressor(move(stream), move(output_buffer))));
 }
 
-DeflateDecompressor::DeflateDecompressor(MaybeOwned<Stream> stream, CircularBuffer output_buffer)
-    : m_input_stream(make<LittleEndianInputBitStream>(move(stream)))
+DeflateDecompressor::DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, CircularBuffer output_buffer)
+    : m_input_stream(move(stream))
     , m_output_buffer(move(output_buffer))
 {
 }
@@ -520,8 +561,20 @@ size_t DeflateCompressor::compare_match_candidate(size_t start, size_t candidate
             return 0;
     }
 
-    // Find the actual length
+    // Find the actual length, comparing 8 bytes at a time for as long as possible
     auto match_length = previous_match_length + 1;
+    while (match_length + sizeof(u64) <= maximum_match_length) {
+        u64 start_bytes;
+        u64 candidate_bytes;
+        memcpy(&start_bytes, &m_rolling_window[start + match_length], sizeof(u64));
+        memcpy(&candidate_bytes, &m_rolling_window[candidate + match_length], sizeof(u64));
+        if (auto difference = AK::convert_between_host_and_little_endian(start_bytes ^ candidate_bytes); difference != 0) {
+            match_length += count_trailing_zeroes(difference) / 8;
+            VERIFY(match_length < maximum_match_length);
+            return match_length;
+        }
+        match_length += sizeof(u64);
+    }
     while (match_length < maximum_match_length && m_rolling_window[start + match_length] == m_rolling_window[candidate + match_length]) {
         match_length++;
     }
@@ -560,8 +613,8 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             match_position = candidate;
             previous_match_length = match_length;
 
-            if (match_length == maximum_match_length)
-                return match_length; // bail if we got the maximum possible length
+            if (match_length == maximum_match_length || match_length >= m_compression_constants.great_match_length)
+                return match_length; // bail if we got the maximum possible length, or one that's long enough
         }
 
         candidate = m_hash_prev[candidate % window_size];
@@ -594,8 +647,8 @@ void DeflateCompressor::generate_huffman_lengths(Array<u8, Size>& lengths, Array
             frequency = frequency_cap;
         }
 
-        heap_keys[non_zero_freqs] = frequency;               // sort symbols by frequency
-        heap_values[non_zero_freqs] = Size + non_zero_freqs; // huffman_links "links"
+        heap_keys[non_zero_freqs] = frequency;                   // sort symbols by frequency
+        heap_values[non_zero_freqs] = Size + 1 + non_zero_freqs; // huffman_links "links", after the 2..Size used by the inner nodes
         non_zero_freqs++;
     }
 
@@ -630,7 +683,7 @@ void DeflateCompressor::generate_huffman_lengths(Array<u8, Size>& lengths, Array
             continue;
         }
 
-        u16 link = huffman_links[Size + non_zero_freqs];
+        u16 link = huffman_links[Size + 1 + non_zero_freqs];
         non_zero_freqs++;
 
         size_t bit_length = 1;
@@ -733,6 +786,81 @@ void DeflateCompressor::lz77_compress_block()
     }
 }
 
+// A greedy variant of the above, which always takes the first match it finds instead of checking whether the next byte starts a longer one
+void DeflateCompressor::lz77_compress_block_greedy()
+{
+    for (auto& slot : m_hash_head) { // initialize chained hash table
+        slot = empty_slot;
+    }
+
+    auto insert_hash = [&](auto pos, auto hash) {
+        auto window_pos = pos % window_size;
+        m_hash_prev[window_pos] = m_hash_head[hash];
+        m_hash_head[hash] = window_pos;
+    };
+
+    auto emit_literal = [&](auto literal) {
+        VERIFY(m_pending_symbol_size <= block_size + 1);
+        auto index = m_pending_symbol_size++;
+        m_symbol_buffer[index].distance = 0;
+        m_symbol_buffer[index].literal = literal;
+        m_symbol_frequencies[literal]++;
+    };
+
+    auto emit_back_reference = [&](auto distance, auto length) {
+        VERIFY(m_pending_symbol_size <= block_size + 1);
+        auto index = m_pending_symbol_size++;
+        m_symbol_buffer[index].distance = distance;
+        m_symbol_buffer[index].length = length;
+        m_symbol_frequencies[length_to_symbol[length]]++;
+        m_distance_frequencies[distance_to_base(distance)]++;
+    };
+
+    // our block starts at block_size and is m_pending_block_size in length
+    auto block_end = block_size + m_pending_block_size;
+    auto hashable_end = block_end - min_match_length + 1;
+    size_t positions_without_match = 0;
+    size_t current_position = block_size;
+    while (current_position < hashable_end) {
+        auto maximum_match_length = min(max_match_length, block_end - current_position);
+        size_t match_position = current_position - 1;
+
+        // runs of the same byte are a back reference to the previous byte, which doesn't need a hash table lookup to find
+        size_t match_length = 0;
+        if (current_position > block_size && m_rolling_window[current_position] == m_rolling_window[match_position])
+            match_length = compare_match_candidate(current_position, match_position, min_match_length - 1, maximum_match_length);
+
+        if (match_length == 0) {
+            auto hash = hash_sequence(&m_rolling_window[current_position]);
+            match_length = find_back_match(current_position, hash, 0, maximum_match_length, match_position);
+            insert_hash(current_position, hash);
+        }
+
+        if (match_length == 0) {
+            // The longer we go without finding a match, the more likely it is that the data is incompressible, so we look at fewer positions
+            auto literal_count = min(1 + (positions_without_match++ >> skip_acceleration_shift), block_end - current_position);
+            for (size_t i = 0; i < literal_count; i++)
+                emit_literal(m_rolling_window[current_position++]);
+            continue;
+        }
+
+        positions_without_match = 0;
+        emit_back_reference(current_position - match_position, match_length);
+
+        // Hashing every byte of a long match costs more time than the matches it would find later on are worth
+        if (match_length <= m_compression_constants.max_lazy_length) {
+            for (size_t j = current_position + 1; j < min(current_position + match_length, hashable_end); j++)
+                insert_hash(j, hash_sequence(&m_rolling_window[j]));
+        }
+        current_position += match_length;
+    }
+
+    // output remaining literals
+    while (current_position < block_end) {
+        emit_literal(m_rolling_window[current_position++]);
+    }
+}
+
 size_t DeflateCompressor::huffman_block_length(Array<u8, max_huffman_literals> const& literal_bit_lengths, Array<u8, max_huffman_distances> const& distance_bit_lengths)
 {
     size_t length = 0;
@@ -942,7 +1070,10 @@ ErrorOr<void> DeflateCompressor::flush()
     // The following implementation of lz77 compression and huffman encoding is based on the reference implementation by Hans Wennborg https://www.hanshq.net/zip.html
 
     // this reads from the pending block and writes to m_symbol_buffer
-    lz77_compress_block();
+    if (m_compression_level <= CompressionLevel::FAST)
+        lz77_compress_block_greedy();
+    else
+        lz77_compress_block();
 
     // insert EndOfBlock marker to the symbol buffer
     m_symbol_buffer[m_pending_symbol_size].distance = 0;
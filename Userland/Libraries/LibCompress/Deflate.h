@@ -30,9 +30,18 @@ public:
     static Optional<CanonicalCode> from_bytes(ReadonlyBytes);
 
 private:
-    // Decompression - indexed by code
-    Vector<u16> m_symbol_codes;
-    Vector<u16> m_symbol_values;
+    static constexpr size_t max_code_length = 15;
+    static constexpr size_t primary_table_bits = 10;
+
+    struct DecodingTableEntry {
+        u16 symbol { 0 };              // or, if secondary_table_bits is set, the offset of the secondary table
+        u8 code_length { 0 };          // zero if no code starts with these bits
+        u8 secondary_table_bits { 0 }; // codes longer than primary_table_bits continue in a secondary table indexed by this many of the following bits
+    };
+
+    // Decompression - indexed by the next primary_table_bits bits of the input, which hold the code in lsb-first order
+    Array<DecodingTableEntry, 1 << primary_table_bits> m_primary_table {};
+    Vector<DecodingTableEntry> m_secondary_tables;
 
     // Compression - indexed by symbol
     Array<u16, 288> m_bit_codes {}; // deflate uses a maximum of 288 symbols (maximum of 32 for distances)
@@ -77,6 +86,8 @@ public:
     friend UncompressedBlock;
 
     static ErrorOr<NonnullOwnPtr<DeflateDecompressor>> construct(MaybeOwned<Stream> stream);
+    // The bit stream reads ahead of the compressed data, so any data following it has to be read through the same bit stream.
+    static ErrorOr<NonnullOwnPtr<DeflateDecompressor>> construct(MaybeOwned<LittleEndianInputBitStream> stream);
     ~DeflateDecompressor();
 
     virtual ErrorOr<Bytes> read(Bytes) override;
@@ -88,7 +99,7 @@ public:
     static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
 
 private:
-    DeflateDecompressor(MaybeOwned<Stream> stream, CircularBuffer buffer);
+    DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, CircularBuffer buffer);
 
     ErrorOr<u32> decode_length(u32);
     ErrorOr<u32> decode_distance(u32);
@@ -116,10 +127,11 @@ public:
     static constexpr size_t min_match_length = 4;   // matches smaller than these are not worth the size of the back reference
     static constexpr size_t max_match_length = 258; // matches longer than these cannot be encoded using huffman codes
     static constexpr u16 empty_slot = UINT16_MAX;
+    static constexpr size_t skip_acceleration_shift = 5; // after every 2^shift positions without a match, the greedy search skips one more position
 
     struct CompressionConstants {
         size_t good_match_length;  // Once we find a match of at least this length (a good enough match) we reduce max_chain to lower processing time
-        size_t max_lazy_length;    // If the match is at least this long we dont defer matching to the next byte (which takes time) as its good enough
+        size_t max_lazy_length;    // If the match is at least this long we dont defer matching to the next byte (which takes time) as its good enough (the greedy levels instead only hash the positions inside matches up to this length)
         size_t great_match_length; // Once we find a match of at least this length (a great match) we can just stop searching for longer ones
         size_t max_chain;          // We only check the actual length of the max_chain closest matches
     };
@@ -127,6 +139,7 @@ public:
     // These constants were shamelessly "borrowed" from zlib
     static constexpr CompressionConstants compression_constants[] = {
         { 0, 0, 0, 0 },
+        { 4, 4, 8, 1 },
         { 4, 4, 8, 4 },
         { 8, 16, 128, 128 },
         { 32, 258, 258, 4096 },
@@ -135,6 +148,7 @@ public:
 
     enum class CompressionLevel : int {
         STORE = 0,
+        FASTEST,
         FAST,
         GOOD,
         GREAT,
@@ -163,6 +177,7 @@ private:
     size_t compare_match_candidate(size_t start, size_t candidate, size_t prev_match_length, size_t max_match_length);
     size_t find_back_match(size_t start, u16 hash, size_t previous_match_length, size_t max_match_length, size_t& match_position);
     void lz77_compress_block();
+    void lz77_compress_block_greedy();
 
     // Huffman Coding
     struct code_length_symbol {
@@ -74,8 +74,23 @@ ErrorOr<NonnullOwnPtr<ZlibCompressor>> ZlibCompressor::construct(MaybeOwned<Stre
     // Zlib only defines Deflate as a compression method.
     auto compression_method = ZlibCompressionMethod::Deflate;
 
-    // FIXME: Find a way to compress with Deflate's "Best" compression level.
-    auto compressor_stream = TRY(DeflateCompressor::construct(MaybeOwned(*stream), static_cast<DeflateCompressor::CompressionLevel>(compression_level)));
+    auto deflate_compression_level = DeflateCompressor::CompressionLevel::GOOD;
+    switch (compression_level) {
+    case ZlibCompressionLevel::Fastest:
+        deflate_compression_level = DeflateCompressor::CompressionLevel::FASTEST;
+        break;
+    case ZlibCompressionLevel::Fast:
+        deflate_compression_level = DeflateCompressor::CompressionLevel::FAST;
+        break;
+    case ZlibCompressionLevel::Default:
+        deflate_compression_level = DeflateCompressor::CompressionLevel::GOOD;
+        break;
+    case ZlibCompressionLevel::Best:
+        // FIXME: Find a way to compress with Deflate's "Best" compression level.
+        deflate_compression_level = DeflateCompressor::CompressionLevel::GREAT;
+        break;
+    }
+    auto compressor_stream = TRY(DeflateCompressor::construct(MaybeOwned(*stream), deflate_compression_level));
 
     auto zlib_compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ZlibCompressor(move(stream), move(compressor_stream))));
     TRY(zlib_compressor->write_header(compression_method, compression_level));
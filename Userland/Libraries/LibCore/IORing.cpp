@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibCore/IORing.h>
+#include <LibCore/System.h>
+#include <sys/mman.h>
+
+namespace Core {
+
+ErrorOr<NonnullOwnPtr<IORing>> IORing::create(u32 entries)
+{
+    auto fd = TRY(System::io_ring_create(entries, IORING_CLOEXEC));
+    auto mapping_or_error = System::mmap(nullptr, io_ring_mapping_size(entries), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0, 0, "IORing"sv);
+    if (mapping_or_error.is_error()) {
+        (void)System::close(fd);
+        return mapping_or_error.release_error();
+    }
+    return adopt_nonnull_own_or_enomem(new (nothrow) IORing(fd, entries, static_cast<u8*>(mapping_or_error.value())));
+}
+
+IORing::IORing(int fd, u32 entries, u8* mapping)
+    : m_fd(fd)
+    , m_entries(entries)
+    , m_mapping(mapping)
+{
+}
+
+IORing::~IORing()
+{
+    // Operations that are still in flight are cancelled along with the ring, and their callbacks never run.
+    (void)System::munmap(m_mapping, io_ring_mapping_size(m_entries));
+    (void)System::close(m_fd);
+}
+
+IORingSubmission& IORing::submission_at(u32 index)
+{
+    auto* submissions = reinterpret_cast<IORingSubmission*>(m_mapping + io_ring_submissions_offset());
+    return submissions[index & (m_entries - 1)];
+}
+
+IORingCompletion const& IORing::completion_at(u32 index)
+{
+    auto* completions = reinterpret_cast<IORingCompletion const*>(m_mapping + io_ring_completions_offset(m_entries));
+    return completions[index & (io_ring_completion_entries(m_entries) - 1)];
+}
+
+ErrorOr<void> IORing::queue(IORingSubmission submission, Callback callback)
+{
+    auto submissions_queued = [&] {
+        return m_submission_tail - AK::atomic_load(&control().submissions.head, AK::MemoryOrder::memory_order_acquire);
+    };
+    if (submissions_queued() == m_entries) {
+        TRY(submit_and_wait());
+        // The kernel only takes new submissions while there's room for their completions.
+        if (submissions_queued() == m_entries)
+            return Error::from_errno(EBUSY);
+    }
+
+    submission.user_data = m_next_user_data++;
+    TRY(m_callbacks.try_set(submission.user_data, move(callback)));
+    submission_at(m_submission_tail) = submission;
+    ++m_submission_tail;
+    AK::atomic_store(&control().submissions.tail, m_submission_tail, AK::MemoryOrder::memory_order_release);
+    return {};
+}
+
+ErrorOr<void> IORing::read(int fd, Bytes buffer, Optional<off_t> offset, Callback callback)
+{
+    IORingSubmission submission {};
+    submission.opcode = IORingOpcode::Read;
+    submission.fd = fd;
+    submission.address = reinterpret_cast<FlatPtr>(buffer.data());
+    submission.length = min(buffer.size(), static_cast<size_t>(NumericLimits<u32>::max()));
+    submission.offset = offset.has_value() ? static_cast<u64>(offset.value()) : IORING_CURRENT_OFFSET;
+    return queue(submission, move(callback));
+}
+
+ErrorOr<void> IORing::write(int fd, ReadonlyBytes buffer, Optional<off_t> offset, Callback callback)
+{
+    IORingSubmission submission {};
+    submission.opcode = IORingOpcode::Write;
+    submission.fd = fd;
+    submission.address = reinterpret_cast<FlatPtr>(buffer.data());
+    submission.length = min(buffer.size(), static_cast<size_t>(NumericLimits<u32>::max()));
+    submission.offset = offset.has_value() ? static_cast<u64>(offset.value()) : IORING_CURRENT_OFFSET;
+    return queue(submission, move(callback));
+}
+
+ErrorOr<void> IORing::accept(int fd, int flags, Callback callback)
+{
+    IORingSubmission submission {};
+    submission.opcode = IORingOpcode::Accept;
+    submission.fd = fd;
+    submission.flags = flags;
+    return queue(submission, move(callback));
+}
+
+ErrorOr<void> IORing::connect(int fd, sockaddr const* address, socklen_t address_length, Callback callback)
+{
+    IORingSubmission submission {};
+    submission.opcode = IORingOpcode::Connect;
+    submission.fd = fd;
+    submission.address = reinterpret_cast<FlatPtr>(address);
+    submission.length = address_length;
+    return queue(submission, move(callback));
+}
+
+ErrorOr<void> IORing::poll(int fd, short events, Callback callback)
+{
+    IORingSubmission submission {};
+    submission.opcode = IORingOpcode::Poll;
+    submission.fd = fd;
+    submission.flags = static_cast<u16>(events);
+    return queue(submission, move(callback));
+}
+
+ErrorOr<void> IORing::fsync(int fd, Callback callback)
+{
+    IORingSubmission submission {};
+    submission.opcode = IORingOpcode::Fsync;
+    submission.fd = fd;
+    return queue(submission, move(callback));
+}
+
+ErrorOr<size_t> IORing::submit_and_wait(u32 min_complete, Optional<Time> timeout)
+{
+    auto to_submit = m_submission_tail - AK::atomic_load(&control().submissions.head, AK::MemoryOrder::memory_order_acquire);
+    auto result = System::io_ring_enter(m_fd, to_submit, min_complete, timeout);
+    // A signal only cuts the wait short, whatever has completed until then is still handled.
+    if (result.is_error() && result.error().code() != EINTR)
+        return result.release_error();
+    return run_completion_callbacks();
+}
+
+size_t IORing::run_completion_callbacks()
+{
+    size_t callbacks_run = 0;
+    while (m_completion_head != AK::atomic_load(&control().completions.tail, AK::MemoryOrder::memory_order_acquire)) {
+        auto completion = completion_at(m_completion_head);
+        ++m_completion_head;
+        AK::atomic_store(&control().completions.head, m_completion_head, AK::MemoryOrder::memory_order_release);
+
+        // The callback may queue up further operations, so it must not be run from inside the map.
+        auto callback = m_callbacks.take(completion.user_data);
+        VERIFY(callback.has_value());
+        if (completion.result < 0)
+            callback.value()(Error::from_errno(static_cast<int>(-completion.result)));
+        else
+            callback.value()(static_cast<size_t>(completion.result));
+        ++callbacks_run;
+    }
+    return callbacks_run;
+}
+
+}
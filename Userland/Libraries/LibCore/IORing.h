@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
+#include <Kernel/API/IORing.h>
+#include <sys/socket.h>
+
+namespace Core {
+
+// Hands many I/O operations to the kernel with a single syscall, and runs a callback once each of them has completed.
+// Operations are queued up until the next submit_and_wait(), which also runs the callbacks of all completed operations.
+// The buffers and socket addresses passed to an operation have to stay valid until its callback has run.
+class IORing {
+    AK_MAKE_NONCOPYABLE(IORing);
+    AK_MAKE_NONMOVABLE(IORing);
+
+public:
+    // Receives the number of bytes transferred, the accepted file descriptor or the poll events that occurred.
+    using Callback = Function<void(ErrorOr<size_t>)>;
+
+    static ErrorOr<NonnullOwnPtr<IORing>> create(u32 entries = 64);
+    ~IORing();
+
+    int fd() const { return m_fd; }
+    size_t operations_in_flight() const { return m_callbacks.size(); }
+
+    ErrorOr<void> read(int fd, Bytes, Optional<off_t> offset, Callback);
+    ErrorOr<void> write(int fd, ReadonlyBytes, Optional<off_t> offset, Callback);
+    ErrorOr<void> accept(int fd, int flags, Callback);
+    ErrorOr<void> connect(int fd, sockaddr const*, socklen_t, Callback);
+    ErrorOr<void> poll(int fd, short events, Callback);
+    ErrorOr<void> fsync(int fd, Callback);
+
+    // Submits all queued operations, and waits until at least `min_complete` completions have arrived,
+    // the timeout expires, or there is nothing left to wait for. Returns the number of callbacks that ran.
+    ErrorOr<size_t> submit_and_wait(u32 min_complete = 0, Optional<Time> timeout = {});
+
+private:
+    IORing(int fd, u32 entries, u8* mapping);
+
+    IORingControl& control() { return *reinterpret_cast<IORingControl*>(m_mapping); }
+    IORingSubmission& submission_at(u32 index);
+    IORingCompletion const& completion_at(u32 index);
+
+    ErrorOr<void> queue(IORingSubmission, Callback);
+    size_t run_completion_callbacks();
+
+    int m_fd { -1 };
+    u32 m_entries { 0 };
+    u8* m_mapping { nullptr };
+    u32 m_submission_tail { 0 };
+    u32 m_completion_head { 0 };
+    u64 m_next_user_data { 0 };
+    HashMap<u64, Callback> m_callbacks;
+};
+
+}
@@ -191,6 +191,8 @@ public:
     ErrorOr<void> set_blocking(bool enabled) override { return m_helper.set_blocking(enabled); }
     ErrorOr<void> set_close_on_exec(bool enabled) override { return m_helper.set_close_on_exec(enabled); }
 
+    Optional<int> fd() const;
+
     virtual ~TCPSocket() override { close(); }
 
 private:
@@ -418,6 +420,9 @@ public:
     ErrorOr<Bytes> read_until_any_of(Bytes buffer, Array<StringView, N> candidates) { return m_helper.read_until_any_of(move(buffer), move(candidates)); }
     virtual ErrorOr<bool> can_read_line() override { return m_helper.can_read_line(); }
 
+    // Only available for stream types that expose their file descriptor.
+    Optional<int> fd() const { return m_helper.stream().fd(); }
+
     virtual size_t buffer_size() const override { return m_helper.buffer_size(); }
 
     virtual ~BufferedSocket() override = default;
@@ -32,6 +32,10 @@
 #    include <sys/ptrace.h>
 #endif
 
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+#    include <sys/sendfile.h>
+#endif
+
 #if defined(AK_OS_LINUX) && !defined(MFD_CLOEXEC)
 #    include <linux/memfd.h>
 #    include <sys/syscall.h>
@@ -286,6 +290,22 @@ ErrorOr<void> profiling_free_buffer(pid_t pid)
     int rc = ::profiling_free_buffer(pid);
     HANDLE_SYSCALL_RETURN_VALUE("profiling_free_buffer", rc, {});
 }
+
+ErrorOr<int> io_ring_create(u32 entries, u32 flags)
+{
+    int rc = syscall(SC_io_ring_create, entries, flags);
+    HANDLE_SYSCALL_RETURN_VALUE("io_ring_create", rc, rc);
+}
+
+ErrorOr<size_t> io_ring_enter(int fd, u32 to_submit, u32 min_complete, Optional<Time> timeout)
+{
+    timespec timeout_spec;
+    if (timeout.has_value())
+        timeout_spec = timeout->to_timespec();
+    Syscall::SC_io_ring_enter_params params { fd, to_submit, min_complete, timeout.has_value() ? &timeout_spec : nullptr };
+    int rc = syscall(SC_io_ring_enter, &params);
+    HANDLE_SYSCALL_RETURN_VALUE("io_ring_enter", rc, static_cast<size_t>(rc));
+}
 #endif
 
 #if !defined(AK_OS_BSD_GENERIC) && !defined(AK_OS_ANDROID)
@@ -525,6 +545,16 @@ ErrorOr<ssize_t> write(int fd, ReadonlyBytes buffer)
     return rc;
 }
 
+#if defined(AK_OS_SERENITY) || defined(AK_OS_LINUX)
+ErrorOr<size_t> sendfile(int out_fd, int in_fd, off_t* offset, size_t count)
+{
+    ssize_t rc = ::sendfile(out_fd, in_fd, offset, count);
+    if (rc < 0)
+        return Error::from_syscall("sendfile"sv, -errno);
+    return static_cast<size_t>(rc);
+}
+#endif
+
 ErrorOr<void> kill(pid_t pid, int signal)
 {
     if (::kill(pid, signal) < 0)
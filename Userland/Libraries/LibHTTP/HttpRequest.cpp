@@ -210,6 +210,13 @@ Optional<HttpRequest> HttpRequest::from_raw_request(ReadonlyBytes raw_request)
     else
         return {};
 
+    if (protocol == "HTTP/1.0")
+        request.m_version = Version::HTTP1_0;
+    else if (protocol == "HTTP/1.1")
+        request.m_version = Version::HTTP1_1;
+    else
+        return {};
+
     request.m_headers = move(headers);
     auto url_parts = resource.split_limit('?', 2, SplitBehavior::KeepEmpty);
 
@@ -31,6 +31,11 @@ public:
         PUT,
     };
 
+    enum class Version {
+        HTTP1_0,
+        HTTP1_1,
+    };
+
     struct Header {
         DeprecatedString name;
         DeprecatedString value;
@@ -53,6 +58,8 @@ public:
     Method method() const { return m_method; }
     void set_method(Method method) { m_method = method; }
 
+    Version version() const { return m_version; }
+
     ByteBuffer const& body() const { return m_body; }
     void set_body(ByteBuffer&& body) { m_body = move(body); }
 
@@ -69,6 +76,7 @@ private:
     URL m_url;
     DeprecatedString m_resource;
     Method m_method { GET };
+    Version m_version { Version::HTTP1_1 };
     Vector<Header> m_headers;
     ByteBuffer m_body;
 };
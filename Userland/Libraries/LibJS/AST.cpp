@@ -3718,13 +3718,13 @@ Completion ArrayExpression::execute(Interpreter& interpreter) const
 
             if (is<SpreadExpression>(*element)) {
                 (void)TRY(get_iterator_values(vm, value, [&](Value iterator_value) -> Optional<Completion> {
-                    array->indexed_properties().put(index++, iterator_value, default_attributes);
+                    array->put_indexed_property(index++, iterator_value, default_attributes);
                     return {};
                 }));
                 continue;
             }
         }
-        array->indexed_properties().put(index++, value, default_attributes);
+        array->put_indexed_property(index++, value, default_attributes);
     }
 
     // 3. Return array.
@@ -3890,11 +3890,11 @@ ThrowCompletionOr<Value> TaggedTemplateLiteral::get_template_object(Interpreter&
             cooked_value = js_undefined();
 
         // c. Perform ! DefinePropertyOrThrow(template, prop, PropertyDescriptor { [[Value]]: cookedValue, [[Writable]]: false, [[Enumerable]]: true, [[Configurable]]: false }).
-        template_->indexed_properties().append(cooked_value);
+        template_->append_indexed_property(cooked_value);
 
         // d. Let rawValue be the String value rawStrings[index].
         // e. Perform ! DefinePropertyOrThrow(rawObj, prop, PropertyDescriptor { [[Value]]: rawValue, [[Writable]]: false, [[Enumerable]]: true, [[Configurable]]: false }).
-        raw_obj->indexed_properties().append(TRY(raw_strings[i].execute(interpreter)).release_value());
+        raw_obj->append_indexed_property(TRY(raw_strings[i].execute(interpreter)).release_value());
 
         // f. Set index to index + 1.
     }
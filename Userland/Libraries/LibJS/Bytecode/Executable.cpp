@@ -5,9 +5,77 @@
  */
 
 #include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
 
 namespace JS::Bytecode {
 
+void PropertyLookupCache::update(Object const& object, CacheablePropertyMetadata const& metadata)
+{
+    if (metadata.type == CacheablePropertyMetadata::Type::NotCacheable)
+        return;
+
+    auto const& shape = object.shape();
+    Entry entry;
+    entry.shape = shape.make_weak_ptr<Shape>();
+    entry.unique_shape_serial_number = shape.unique_shape_serial_number();
+    entry.property_offset = metadata.property_offset.value();
+
+    if (metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
+        VERIFY(metadata.prototype);
+        if (metadata.prototype != shape.prototype())
+            return;
+        auto const& prototype_shape = metadata.prototype->shape();
+        entry.prototype_shape = prototype_shape.make_weak_ptr<Shape>();
+        entry.prototype_unique_shape_serial_number = prototype_shape.unique_shape_serial_number();
+    }
+
+    entries[next_entry_to_replace] = move(entry);
+    next_entry_to_replace = (next_entry_to_replace + 1) % max_number_of_shapes;
+}
+
+NonnullOwnPtr<FlattenedExecutable> FlattenedExecutable::create(Executable const& executable, Span<void* const> handlers, void* end_of_basic_block_handler)
+{
+    auto flattened = make<FlattenedExecutable>();
+
+    for (auto& block : executable.basic_blocks) {
+        flattened->block_offsets.set(&block, flattened->instructions.size());
+        InstructionStreamIterator it(block.instruction_stream());
+        while (!it.at_end()) {
+            auto const& instruction = *it;
+            flattened->instructions.append({ &instruction, handlers[to_underlying(instruction.type())] });
+            ++it;
+        }
+        flattened->instructions.append({ nullptr, end_of_basic_block_handler });
+    }
+
+    // Now that every block has a known position, resolve the jump targets.
+    for (auto& flattened_instruction : flattened->instructions) {
+        auto const* instruction = flattened_instruction.instruction;
+        if (!instruction)
+            continue;
+        switch (instruction->type()) {
+        case Instruction::Type::Jump:
+        case Instruction::Type::JumpConditional:
+        case Instruction::Type::JumpNullish:
+        case Instruction::Type::JumpUndefined: {
+            auto const& jump = static_cast<Op::Jump const&>(*instruction);
+            VERIFY(jump.true_target().has_value());
+            flattened_instruction.true_target = flattened->offset_of(jump.true_target()->block());
+            if (jump.false_target().has_value())
+                flattened_instruction.false_target = flattened->offset_of(jump.false_target()->block());
+            else
+                VERIFY(instruction->type() == Instruction::Type::Jump);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    return flattened;
+}
+
 void Executable::dump() const
 {
     dbgln("\033[33;1mJS::Bytecode::Executable\033[0m ({})", name);
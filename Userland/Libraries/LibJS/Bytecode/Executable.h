@@ -6,14 +6,98 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
+#include <AK/HashMap.h>
 #include <AK/NonnullOwnPtrVector.h>
+#include <AK/OwnPtr.h>
+#include <AK/WeakPtr.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/IdentifierTable.h>
 #include <LibJS/Bytecode/StringTable.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Shape.h>
 
 namespace JS::Bytecode {
 
+// A small polymorphic inline cache for the property lookups done by a single GetById/PutById instruction.
+// Entries are keyed on the receiver's shape, and (for hits in the receiver's prototype) on the prototype's shape.
+struct PropertyLookupCache {
+    static constexpr size_t max_number_of_shapes = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        u32 unique_shape_serial_number { 0 };
+        WeakPtr<Shape> prototype_shape;
+        u32 prototype_unique_shape_serial_number { 0 };
+        u32 property_offset { 0 };
+    };
+
+    // Returns the cached property value, or an empty value if this is a cache miss.
+    ALWAYS_INLINE Value get(Object const& object) const
+    {
+        auto const& shape = object.shape();
+        for (auto const& entry : entries) {
+            if (entry.shape.ptr() != &shape || entry.unique_shape_serial_number != shape.unique_shape_serial_number())
+                continue;
+            auto const* holder = &object;
+            if (entry.prototype_shape) {
+                holder = shape.prototype();
+                if (!holder || entry.prototype_shape.ptr() != &holder->shape() || entry.prototype_unique_shape_serial_number != holder->shape().unique_shape_serial_number())
+                    return {};
+            }
+            // NOTE: A data property can be redefined as an accessor with the same attributes, which doesn't change the shape.
+            auto value = holder->get_direct(entry.property_offset);
+            if (value.is_accessor())
+                return {};
+            return value;
+        }
+        return {};
+    }
+
+    // Returns true if the value was stored through the cache.
+    ALWAYS_INLINE bool put(Object& object, Value value) const
+    {
+        auto const& shape = object.shape();
+        for (auto const& entry : entries) {
+            if (entry.shape.ptr() != &shape || entry.unique_shape_serial_number != shape.unique_shape_serial_number() || entry.prototype_shape)
+                continue;
+            // NOTE: An empty slot is a lazily initialized intrinsic that has to go through the slow path first.
+            auto current_value = object.get_direct(entry.property_offset);
+            if (current_value.is_empty() || current_value.is_accessor())
+                return false;
+            object.put_direct(entry.property_offset, value);
+            return true;
+        }
+        return false;
+    }
+
+    void update(Object const&, CacheablePropertyMetadata const&);
+
+    AK::Array<Entry, max_number_of_shapes> entries;
+    size_t next_entry_to_replace { 0 };
+};
+
+// An instruction in the flattened form of an executable, with its handler in the interpreter's dispatch loop resolved ahead of time.
+// A null instruction marks the end of a basic block.
+struct FlattenedInstruction {
+    Instruction const* instruction { nullptr };
+    void* handler { nullptr };
+    // Indices of the jump targets in FlattenedExecutable::instructions, only used by the jump instructions.
+    u32 true_target { 0 };
+    u32 false_target { 0 };
+};
+
+// All basic blocks of an executable laid out back to back, so the interpreter can dispatch straight from one instruction to the next.
+struct FlattenedExecutable {
+    static NonnullOwnPtr<FlattenedExecutable> create(Executable const&, Span<void* const> handlers, void* end_of_basic_block_handler);
+
+    u32 offset_of(BasicBlock const& block) const { return block_offsets.get(&block).value(); }
+
+    Vector<FlattenedInstruction> instructions;
+    HashMap<BasicBlock const*, u32> block_offsets;
+};
+
 struct Executable {
     DeprecatedFlyString name;
     NonnullOwnPtrVector<BasicBlock> basic_blocks;
@@ -21,6 +105,10 @@ struct Executable {
     NonnullOwnPtr<IdentifierTable> identifier_table;
     size_t number_of_registers { 0 };
     bool is_strict_mode { false };
+    mutable Vector<PropertyLookupCache> property_lookup_caches;
+
+    // Built by the interpreter the first time this executable is run, and thrown away whenever the basic blocks change.
+    mutable OwnPtr<FlattenedExecutable> flattened;
 
     DeprecatedString const& get_string(StringTableIndex index) const { return string_table->get(index); }
     DeprecatedFlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
@@ -61,7 +61,7 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable const& e
         pushed_execution_context = true;
     }
 
-    TemporaryChange restore_current_block { m_current_block, entry_point ?: &executable.basic_blocks.first() };
+    TemporaryChange<Instruction const*> restore_current_instruction { m_current_instruction, nullptr };
 
     if (in_frame)
         m_register_windows.append(in_frame);
@@ -70,14 +70,76 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable const& e
 
     registers().resize(executable.number_of_registers);
 
+    auto const& entry_block = entry_point ? *entry_point : executable.basic_blocks.first();
+    if (m_dispatch_mode == DispatchMode::Threaded)
+        run_threaded(executable, entry_block);
+    else
+        run_basic_blocks(entry_block);
+
+    dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
+
+    if constexpr (JS_BYTECODE_DEBUG) {
+        for (size_t i = 0; i < registers().size(); ++i) {
+            String value_string;
+            if (registers()[i].is_empty())
+                value_string = MUST(String::from_utf8("(empty)"sv));
+            else
+                value_string = MUST(registers()[i].to_string_without_side_effects());
+            dbgln("[{:3}] {}", i, value_string);
+        }
+    }
+
+    auto frame = m_register_windows.take_last();
+
+    Value return_value = js_undefined();
+    if (!m_return_value.is_empty()) {
+        return_value = m_return_value;
+        m_return_value = {};
+    } else if (!m_saved_return_value.is_null()) {
+        return_value = m_saved_return_value.value();
+        m_saved_return_value = {};
+    }
+
+    // NOTE: The return value from a called function is put into $0 in the caller context.
+    if (!m_register_windows.is_empty())
+        window().registers[0] = return_value;
+
+    // At this point we may have already run any queued promise jobs via on_call_stack_emptied,
+    // in which case this is a no-op.
+    vm().run_queued_promise_jobs();
+
+    if (pushed_execution_context) {
+        VERIFY(&vm().running_execution_context() == &execution_context);
+        vm().pop_execution_context();
+    }
+
+    vm().finish_execution_generation();
+
+    if (!m_saved_exception.is_null()) {
+        Value thrown_value = m_saved_exception.value();
+        m_saved_exception = {};
+        if (auto* register_window = frame.get_pointer<NonnullOwnPtr<RegisterWindow>>())
+            return { throw_completion(thrown_value), move(*register_window) };
+        return { throw_completion(thrown_value), nullptr };
+    }
+
+    if (auto* register_window = frame.get_pointer<NonnullOwnPtr<RegisterWindow>>())
+        return { return_value, move(*register_window) };
+    return { return_value, nullptr };
+}
+
+void Interpreter::run_basic_blocks(BasicBlock const& entry_point)
+{
+    auto const* current_block = &entry_point;
+
     for (;;) {
-        Bytecode::InstructionStreamIterator pc(m_current_block->instruction_stream());
-        TemporaryChange temp_change { m_pc, &pc };
+        Bytecode::InstructionStreamIterator pc(current_block->instruction_stream());
 
         bool will_jump = false;
         bool will_return = false;
         while (!pc.at_end()) {
             auto& instruction = *pc;
+            m_current_instruction = &instruction;
             auto ran_or_error = instruction.execute(*this);
             if (ran_or_error.is_error()) {
                 auto exception_value = *ran_or_error.throw_completion().value();
@@ -88,7 +150,7 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable const& e
                 if (unwind_context.executable != m_current_executable)
                     break;
                 if (unwind_context.handler) {
-                    m_current_block = unwind_context.handler;
+                    current_block = unwind_context.handler;
                     unwind_context.handler = nullptr;
 
                     accumulator() = exception_value;
@@ -97,7 +159,7 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable const& e
                     break;
                 }
                 if (unwind_context.finalizer) {
-                    m_current_block = unwind_context.finalizer;
+                    current_block = unwind_context.finalizer;
                     will_jump = true;
                     break;
                 }
@@ -106,7 +168,7 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable const& e
                 VERIFY_NOT_REACHED();
             }
             if (m_pending_jump.has_value()) {
-                m_current_block = m_pending_jump.release_value();
+                current_block = m_pending_jump.release_value();
                 will_jump = true;
                 break;
             }
@@ -125,7 +187,7 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable const& e
             if (unwind_context.executable == m_current_executable && unwind_context.finalizer) {
                 m_saved_return_value = make_handle(m_return_value);
                 m_return_value = {};
-                m_current_block = unwind_context.finalizer;
+                current_block = unwind_context.finalizer;
                 // the unwind_context will be pop'ed when entering the finally block
                 continue;
             }
@@ -140,57 +202,130 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable const& e
         if (will_return)
             break;
     }
+}
 
-    dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
-
-    if constexpr (JS_BYTECODE_DEBUG) {
-        for (size_t i = 0; i < registers().size(); ++i) {
-            String value_string;
-            if (registers()[i].is_empty())
-                value_string = MUST(String::from_utf8("(empty)"sv));
-            else
-                value_string = MUST(registers()[i].to_string_without_side_effects());
-            dbgln("[{:3}] {}", i, value_string);
-        }
+NEVER_INLINE void Interpreter::run_threaded(Executable const& executable, BasicBlock const& entry_point)
+{
+    // NOTE: This uses the "labels as values" extension to give every instruction type its own dispatch site.
+    //       Each handler jumps straight to the handler of the next instruction, and jumps between basic blocks
+    //       are resolved to indices into the flattened executable ahead of time.
+    static void* const s_handlers[] = {
+#define __BYTECODE_OP(op) &&handle_##op,
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    };
+
+    if (!executable.flattened) {
+        AK::Array<void*, array_size(s_handlers)> handlers;
+        for (size_t i = 0; i < handlers.size(); ++i)
+            handlers[i] = s_handlers[i];
+        handlers[to_underlying(Instruction::Type::Jump)] = &&handle_direct_jump;
+        handlers[to_underlying(Instruction::Type::JumpConditional)] = &&handle_direct_jump_conditional;
+        handlers[to_underlying(Instruction::Type::JumpNullish)] = &&handle_direct_jump_nullish;
+        handlers[to_underlying(Instruction::Type::JumpUndefined)] = &&handle_direct_jump_undefined;
+        executable.flattened = FlattenedExecutable::create(executable, handlers.span(), &&end_of_basic_block);
     }
 
-    auto frame = m_register_windows.take_last();
-
-    Value return_value = js_undefined();
-    if (!m_return_value.is_empty()) {
-        return_value = m_return_value;
-        m_return_value = {};
-    } else if (!m_saved_return_value.is_null()) {
-        return_value = m_saved_return_value.value();
-        m_saved_return_value = {};
+    auto const& flattened = *executable.flattened;
+    auto const* instructions = flattened.instructions.data();
+    auto const* current = &instructions[flattened.offset_of(entry_point)];
+    Value exception_value;
+    BasicBlock const* next_block = nullptr;
+
+    goto* current->handler;
+
+#define __BYTECODE_OP(op)                                                                    \
+    handle_##op:                                                                             \
+    {                                                                                        \
+        m_current_instruction = current->instruction;                                        \
+        auto result = static_cast<Op::op const&>(*current->instruction).execute_impl(*this); \
+        if (result.is_error()) [[unlikely]] {                                                \
+            exception_value = *result.throw_completion().value();                            \
+            goto handle_exception;                                                           \
+        }                                                                                    \
+        if (m_pending_jump.has_value()) [[unlikely]]                                         \
+            goto handle_pending_jump;                                                        \
+        if (!m_return_value.is_empty()) [[unlikely]]                                         \
+            goto end_of_basic_block;                                                         \
+        ++current;                                                                           \
+        goto* current->handler;                                                              \
     }
-
-    // NOTE: The return value from a called function is put into $0 in the caller context.
-    if (!m_register_windows.is_empty())
-        window().registers[0] = return_value;
-
-    // At this point we may have already run any queued promise jobs via on_call_stack_emptied,
-    // in which case this is a no-op.
-    vm().run_queued_promise_jobs();
-
-    if (pushed_execution_context) {
-        VERIFY(&vm().running_execution_context() == &execution_context);
-        vm().pop_execution_context();
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+
+handle_direct_jump:
+    current = &instructions[current->true_target];
+    goto* current->handler;
+
+handle_direct_jump_conditional:
+    current = &instructions[accumulator().to_boolean() ? current->true_target : current->false_target];
+    goto* current->handler;
+
+handle_direct_jump_nullish:
+    current = &instructions[accumulator().is_nullish() ? current->true_target : current->false_target];
+    goto* current->handler;
+
+handle_direct_jump_undefined:
+    current = &instructions[accumulator().is_undefined() ? current->true_target : current->false_target];
+    goto* current->handler;
+
+handle_pending_jump:
+    current = &instructions[flattened.offset_of(*m_pending_jump.release_value())];
+    goto* current->handler;
+
+handle_exception:
+    m_saved_exception = make_handle(exception_value);
+    if (unwind_contexts().is_empty() || unwind_contexts().last().executable != m_current_executable)
+        return;
+    {
+        auto& unwind_context = unwind_contexts().last();
+        if (unwind_context.handler) {
+            next_block = unwind_context.handler;
+            unwind_context.handler = nullptr;
+
+            accumulator() = exception_value;
+            m_saved_exception = {};
+        } else if (unwind_context.finalizer) {
+            next_block = unwind_context.finalizer;
+        } else {
+            // See the comment in run_basic_blocks().
+            VERIFY_NOT_REACHED();
+        }
     }
+    current = &instructions[flattened.offset_of(*next_block)];
+    goto* current->handler;
+
+end_of_basic_block:
+    // We get here either by running off the end of a basic block, or when an instruction has set a return value.
+    if (!unwind_contexts().is_empty()) {
+        auto& unwind_context = unwind_contexts().last();
+        if (unwind_context.executable == m_current_executable && unwind_context.finalizer) {
+            m_saved_return_value = make_handle(m_return_value);
+            m_return_value = {};
+            // the unwind_context will be pop'ed when entering the finally block
+            current = &instructions[flattened.offset_of(*unwind_context.finalizer)];
+            goto* current->handler;
+        }
+    }
+}
 
-    vm().finish_execution_generation();
-
-    if (!m_saved_exception.is_null()) {
-        Value thrown_value = m_saved_exception.value();
-        m_saved_exception = {};
-        if (auto* register_window = frame.get_pointer<NonnullOwnPtr<RegisterWindow>>())
-            return { throw_completion(thrown_value), move(*register_window) };
-        return { throw_completion(thrown_value), nullptr };
+BasicBlock const& Interpreter::current_block() const
+{
+    VERIFY(m_current_instruction);
+    auto const* instruction = reinterpret_cast<u8 const*>(m_current_instruction);
+    for (auto const& block : m_current_executable->basic_blocks) {
+        auto stream = block.instruction_stream();
+        if (instruction >= stream.data() && instruction < stream.data() + stream.size())
+            return block;
     }
+    VERIFY_NOT_REACHED();
+}
 
-    if (auto* register_window = frame.get_pointer<NonnullOwnPtr<RegisterWindow>>())
-        return { return_value, move(*register_window) };
-    return { return_value, nullptr };
+size_t Interpreter::pc() const
+{
+    if (!m_current_instruction)
+        return 0;
+    return reinterpret_cast<u8 const*>(m_current_instruction) - current_block().instruction_stream().data();
 }
 
 void Interpreter::enter_unwind_context(Optional<Label> handler_target, Optional<Label> finalizer_target)
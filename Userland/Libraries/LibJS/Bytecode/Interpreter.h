@@ -66,13 +66,22 @@ public:
     ThrowCompletionOr<void> continue_pending_unwind(Label const& resume_label);
 
     Executable const& current_executable() { return *m_current_executable; }
-    BasicBlock const& current_block() const { return *m_current_block; }
-    size_t pc() const { return m_pc ? m_pc->offset() : 0; }
+    BasicBlock const& current_block() const;
+    size_t pc() const;
     DeprecatedString debug_position()
     {
-        return DeprecatedString::formatted("{}:{:2}:{:4x}", m_current_executable->name, m_current_block->name(), pc());
+        return DeprecatedString::formatted("{}:{:2}:{:4x}", m_current_executable->name, current_block().name(), pc());
     }
 
+    enum class DispatchMode {
+        // Run the flattened form of the executable, dispatching directly from one instruction's handler to the next.
+        Threaded,
+        // Walk the basic blocks one instruction at a time.
+        BasicBlocks,
+    };
+    DispatchMode dispatch_mode() const { return m_dispatch_mode; }
+    void set_dispatch_mode(DispatchMode mode) { m_dispatch_mode = mode; }
+
     enum class OptimizationLevel {
         None,
         Optimize,
@@ -81,6 +90,15 @@ public:
     };
     static Bytecode::PassManager& optimization_pipeline(OptimizationLevel = OptimizationLevel::Default);
 
+    struct PropertyLookupCacheStatistics {
+        u64 get_by_id_hits { 0 };
+        u64 get_by_id_misses { 0 };
+        u64 put_by_id_hits { 0 };
+        u64 put_by_id_misses { 0 };
+    };
+    PropertyLookupCacheStatistics& property_lookup_cache_statistics() { return m_property_lookup_cache_statistics; }
+    PropertyLookupCacheStatistics const& property_lookup_cache_statistics() const { return m_property_lookup_cache_statistics; }
+
     VM::InterpreterExecutionScope ast_interpreter_scope();
 
 private:
@@ -96,6 +114,9 @@ private:
 
     MarkedVector<Value>& registers() { return window().registers; }
 
+    void run_threaded(Executable const&, BasicBlock const& entry_point);
+    void run_basic_blocks(BasicBlock const& entry_point);
+
     static AK::Array<OwnPtr<PassManager>, static_cast<UnderlyingType<Interpreter::OptimizationLevel>>(Interpreter::OptimizationLevel::__Count)> s_optimization_pipelines;
 
     VM& m_vm;
@@ -107,8 +128,9 @@ private:
     Executable const* m_current_executable { nullptr };
     Handle<Value> m_saved_exception;
     OwnPtr<JS::Interpreter> m_ast_interpreter;
-    BasicBlock const* m_current_block { nullptr };
-    InstructionStreamIterator* m_pc { nullptr };
+    Instruction const* m_current_instruction { nullptr };
+    DispatchMode m_dispatch_mode { DispatchMode::Threaded };
+    PropertyLookupCacheStatistics m_property_lookup_cache_statistics;
 };
 
 extern bool g_dump_bytecode;
@@ -179,7 +179,7 @@ ThrowCompletionOr<void> NewArray::execute_impl(Bytecode::Interpreter& interprete
     auto array = MUST(Array::create(interpreter.realm(), 0));
     for (size_t i = 0; i < m_element_count; i++) {
         auto& value = interpreter.reg(Register(m_elements[0].index() + i));
-        array->indexed_properties().put(i, value, default_attributes);
+        array->put_indexed_property(i, value, default_attributes);
     }
     interpreter.accumulator() = array;
     return {};
@@ -235,12 +235,12 @@ ThrowCompletionOr<void> Append::execute_impl(Bytecode::Interpreter& interpreter)
         // ...rhs
         size_t i = lhs_size;
         TRY(get_iterator_values(vm, rhs, [&i, &lhs](Value iterator_value) -> Optional<Completion> {
-            lhs.indexed_properties().put(i, iterator_value, default_attributes);
+            lhs.put_indexed_property(i, iterator_value, default_attributes);
             ++i;
             return {};
         }));
     } else {
-        lhs.indexed_properties().put(lhs_size, rhs, default_attributes);
+        lhs.put_indexed_property(lhs_size, rhs, default_attributes);
     }
 
     return {};
@@ -493,7 +493,19 @@ ThrowCompletionOr<void> GetById::execute_impl(Bytecode::Interpreter& interpreter
 {
     auto& vm = interpreter.vm();
     auto* object = TRY(interpreter.accumulator().to_object(vm));
-    interpreter.accumulator() = TRY(object->get(interpreter.current_executable().get_identifier(m_property)));
+
+    auto& cache = interpreter.current_executable().property_lookup_caches[m_cache_index];
+    auto& statistics = interpreter.property_lookup_cache_statistics();
+    if (auto value = cache.get(*object); !value.is_empty()) {
+        ++statistics.get_by_id_hits;
+        interpreter.accumulator() = value;
+        return {};
+    }
+    ++statistics.get_by_id_misses;
+
+    CacheablePropertyMetadata cacheable_metadata;
+    interpreter.accumulator() = TRY(object->internal_get(interpreter.current_executable().get_identifier(m_property), object, &cacheable_metadata));
+    cache.update(*object, cacheable_metadata);
     return {};
 }
 
@@ -503,7 +515,23 @@ ThrowCompletionOr<void> PutById::execute_impl(Bytecode::Interpreter& interpreter
     auto* object = TRY(interpreter.reg(m_base).to_object(vm));
     PropertyKey name = interpreter.current_executable().get_identifier(m_property);
     auto value = interpreter.accumulator();
-    return put_by_property_key(object, value, name, interpreter, m_kind);
+    if (m_kind != PropertyKind::KeyValue)
+        return put_by_property_key(object, value, name, interpreter, m_kind);
+
+    auto& cache = interpreter.current_executable().property_lookup_caches[m_cache_index];
+    auto& statistics = interpreter.property_lookup_cache_statistics();
+    if (cache.put(*object, value)) {
+        ++statistics.put_by_id_hits;
+        return {};
+    }
+    ++statistics.put_by_id_misses;
+
+    CacheablePropertyMetadata cacheable_metadata;
+    bool succeeded = TRY(object->internal_set(name, value, object, &cacheable_metadata));
+    if (!succeeded && vm.in_strict_mode())
+        return vm.throw_completion<TypeError>(ErrorType::ReferenceNullishSetProperty, name, TRY_OR_THROW_OOM(vm, value.to_string_without_side_effects()));
+    cache.update(*object, cacheable_metadata);
+    return {};
 }
 
 ThrowCompletionOr<void> DeleteById::execute_impl(Bytecode::Interpreter& interpreter) const
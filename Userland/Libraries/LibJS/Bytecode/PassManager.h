@@ -62,6 +62,8 @@ public:
         started();
         for (auto& pass : m_passes)
             pass.perform(executable);
+        // The passes may have rewritten or removed basic blocks, so the flattened form has to be rebuilt.
+        executable.executable.flattened = nullptr;
         finished();
     }
 
@@ -222,6 +222,7 @@ ThrowCompletionOr<Promise*> CyclicModule::evaluate(VM& vm)
     // 6. Let capability be ! NewPromiseCapability(%Promise%).
     // 7. Set module.[[TopLevelCapability]] to capability.
     m_top_level_capability = MUST(new_promise_capability(vm, realm.intrinsics().promise_constructor()));
+    write_barrier();
 
     // 8. Let result be Completion(InnerModuleEvaluation(module, stack, 0)).
     auto result = inner_module_evaluation(vm, stack, 0);
@@ -245,6 +246,7 @@ ThrowCompletionOr<Promise*> CyclicModule::evaluate(VM& vm)
 
             // iii. Set m.[[EvaluationError]] to result.
             cyclic_module.m_evaluation_error = result.throw_completion();
+            cyclic_module.write_barrier();
         }
 
         // b. Assert: module.[[Status]] is evaluated.
@@ -366,6 +368,7 @@ ThrowCompletionOr<u32> CyclicModule::inner_module_evaluation(VM& vm, Vector<Modu
 
             // 2. Append module to requiredModule.[[AsyncParentModules]].
             cyclic_module->m_async_parent_modules.append(this);
+            cyclic_module->write_barrier();
         }
     }
 
@@ -428,6 +431,7 @@ ThrowCompletionOr<u32> CyclicModule::inner_module_evaluation(VM& vm, Vector<Modu
 
             // vii. Set requiredModule.[[CycleRoot]] to module.
             cyclic_module.m_cycle_root = this;
+            cyclic_module.write_barrier();
         }
     }
 
@@ -648,6 +652,7 @@ void CyclicModule::async_module_execution_rejected(VM& vm, Value error)
 
     // 5. Set module.[[EvaluationError]] to ThrowCompletion(error)
     m_evaluation_error = throw_completion(error);
+    write_barrier();
 
     // 6. Set module.[[Status]] to evaluated.
     m_status = ModuleStatus::Evaluated;
@@ -154,6 +154,7 @@ class Accessor;
 struct AsyncGeneratorRequest;
 class BigInt;
 class BoundFunction;
+struct CacheablePropertyMetadata;
 class Cell;
 class CellAllocator;
 class ClassExpression;
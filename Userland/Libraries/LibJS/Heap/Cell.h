@@ -16,15 +16,24 @@
 #include <LibJS/Runtime/Completion.h>
 #include <LibJS/Runtime/Value.h>
 
+// Cells declared in the JS namespace call write_barrier() after every store of a cell reference into them (outside of
+// their constructor), so young generation collections only have to look at the old ones that have been written to.
+// Cells declared anywhere else don't, and are looked at by every young generation collection instead.
+// JS_CELL picks the right one of these through unqualified lookup from the class it's used in.
+inline constexpr bool cells_declared_in_this_namespace_have_write_barrier = false;
+
 namespace JS {
 
-#define JS_CELL(class_, base_class)                \
-public:                                            \
-    using Base = base_class;                       \
-    virtual StringView class_name() const override \
-    {                                              \
-        return #class_##sv;                        \
-    }                                              \
+inline constexpr bool cells_declared_in_this_namespace_have_write_barrier = true;
+
+#define JS_CELL(class_, base_class)                                                                    \
+public:                                                                                                \
+    using Base = base_class;                                                                           \
+    static constexpr bool cell_has_write_barrier = cells_declared_in_this_namespace_have_write_barrier; \
+    virtual StringView class_name() const override                                                     \
+    {                                                                                                  \
+        return #class_##sv;                                                                            \
+    }                                                                                                  \
     friend class JS::Heap;
 
 class Cell {
@@ -32,6 +41,9 @@ class Cell {
     AK_MAKE_NONMOVABLE(Cell);
 
 public:
+    // Overridden by JS_CELL, this is for cells that don't use it.
+    static constexpr bool cell_has_write_barrier = false;
+
     virtual ThrowCompletionOr<void> initialize(Realm&) { return {}; }
     virtual ~Cell() = default;
 
@@ -46,6 +58,27 @@ public:
     State state() const { return m_state; }
     void set_state(State state) { m_state = state; }
 
+    // Cells start out in the young generation, and are promoted to the old generation once they survive a collection.
+    bool is_young() const { return m_young; }
+    void set_young(bool b) { m_young = b; }
+
+    // Old cells in the remembered set are treated as roots by young generation collections.
+    // Cells without a write barrier are always in the remembered set.
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(bool b) { m_remembered = b; }
+
+    // Dead cells can stay around until their block is next allocated from, unless they can be looked up after dying.
+    bool must_be_swept_eagerly() const { return m_must_be_swept_eagerly; }
+    void set_must_be_swept_eagerly(bool b) { m_must_be_swept_eagerly = b; }
+
+    // Called after storing a cell reference into this cell. Old cells have to be remembered until the next collection,
+    // and marked cells have to be traced again if this happens during incremental marking.
+    ALWAYS_INLINE void write_barrier()
+    {
+        if (m_mark || (!m_young && !m_remembered))
+            did_write_to_cell();
+    }
+
     virtual StringView class_name() const = 0;
 
     class Visitor {
@@ -107,9 +140,14 @@ protected:
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
 private:
+    void did_write_to_cell();
+
     bool m_mark : 1 { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
     State m_state : 1 { State::Live };
+    bool m_young : 1 { true };
+    bool m_remembered : 1 { false };
+    bool m_must_be_swept_eagerly : 1 { false };
 };
 
 }
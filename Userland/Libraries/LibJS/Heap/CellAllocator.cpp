@@ -19,6 +19,13 @@ CellAllocator::CellAllocator(size_t cell_size)
 
 Cell* CellAllocator::allocate_cell(Heap& heap)
 {
+    // A block that's waiting to be swept doesn't know which of its cells are free yet, and would mistake the cells
+    // allocated from it for dead ones. When all usable blocks are used up, full blocks are swept to make room.
+    while (!m_usable_blocks.is_empty() && m_usable_blocks.last()->is_waiting_to_be_swept())
+        heap.sweep_block({}, *m_usable_blocks.last());
+    while (m_usable_blocks.is_empty() && !m_blocks_waiting_to_be_swept.is_empty())
+        heap.sweep_block({}, *m_blocks_waiting_to_be_swept.first());
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, m_cell_size);
         m_usable_blocks.append(*block.leak_ptr());
@@ -36,6 +43,8 @@ void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
 {
     auto& heap = block.heap();
     block.m_list_node.remove();
+    if (block.is_waiting_to_be_swept())
+        block.m_sweep_list_node.remove();
     // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
     block.~HeapBlock();
     heap.block_allocator().deallocate_block(&block);
@@ -47,4 +56,9 @@ void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
     m_usable_blocks.append(block);
 }
 
+void CellAllocator::block_is_waiting_to_be_swept(Badge<Heap>, HeapBlock& block)
+{
+    m_blocks_waiting_to_be_swept.append(block);
+}
+
 }
@@ -39,12 +39,18 @@ public:
     void block_did_become_empty(Badge<Heap>, HeapBlock&);
     void block_did_become_usable(Badge<Heap>, HeapBlock&);
 
+    void block_is_waiting_to_be_swept(Badge<Heap>, HeapBlock&);
+    HeapBlock* next_block_waiting_to_be_swept() { return m_blocks_waiting_to_be_swept.first(); }
+
 private:
     const size_t m_cell_size;
 
     using BlockList = IntrusiveList<&HeapBlock::m_list_node>;
     BlockList m_full_blocks;
     BlockList m_usable_blocks;
+
+    using SweepList = IntrusiveList<&HeapBlock::m_sweep_list_node>;
+    SweepList m_blocks_waiting_to_be_swept;
 };
 
 }
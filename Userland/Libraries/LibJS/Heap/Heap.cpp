@@ -10,6 +10,7 @@
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/Timer.h>
 #include <LibJS/Heap/CellAllocator.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/Heap.h>
@@ -76,15 +77,40 @@ Cell* Heap::allocate_cell(size_t size)
 {
     if (should_collect_on_every_allocation()) {
         collect_garbage();
+    } else if (is_incremental_marking_in_progress()) {
+        // Keep marking along with the allocations, in case the event loop doesn't get to run for a while. If the program
+        // keeps giving us more to mark than that, finish marking in one go rather than letting the heap grow without bound.
+        if (++m_allocations_since_last_gc > m_max_allocations_between_gc) {
+            m_allocations_since_last_gc = 0;
+            collect_garbage();
+        } else if (m_allocations_since_last_gc % m_max_allocations_between_incremental_marking_steps == 0 && perform_incremental_marking_step()) {
+            m_allocations_since_last_gc = 0;
+            collect_garbage();
+        }
     } else if (m_allocations_since_last_gc > m_max_allocations_between_gc) {
         m_allocations_since_last_gc = 0;
-        collect_garbage();
+        // The statistics that decide which kind of collection this is aren't complete until everything has been swept.
+        sweep_blocks_waiting_to_be_swept();
+        auto collection_type = automatic_collection_type();
+        if (collection_type == CollectionType::CollectGarbage && m_incremental_marking_enabled)
+            start_incremental_marking();
+        else
+            collect_garbage(collection_type);
     } else {
         ++m_allocations_since_last_gc;
     }
 
     auto& allocator = allocator_for_size(size);
-    return allocator.allocate_cell(*this);
+    auto* cell = allocator.allocate_cell(*this);
+    HeapBlock::from_cell(cell)->set_has_young_cells(true);
+    return cell;
+}
+
+Heap::CollectionType Heap::automatic_collection_type() const
+{
+    if (m_cells_promoted_since_last_full_gc > max(m_live_cells_after_last_full_gc, m_max_allocations_between_gc))
+        return CollectionType::CollectGarbage;
+    return CollectionType::CollectYoungGeneration;
 }
 
 void Heap::collect_garbage(CollectionType collection_type, bool print_report)
@@ -97,21 +123,49 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     perf_event(PERF_EVENT_SIGNPOST, gc_perf_string_id, global_gc_counter++);
 #endif
 
+    // Marking relies on the mark bits being clear, and on everything it finds through a cell pointer being alive.
+    sweep_blocks_waiting_to_be_swept();
+
     Core::ElapsedTimer collection_measurement_timer;
     if (print_report)
         collection_measurement_timer.start();
 
-    if (collection_type == CollectionType::CollectGarbage) {
+    if (collection_type != CollectionType::CollectEverything) {
         if (m_gc_deferrals) {
             m_should_gc_when_deferral_ends = true;
             return;
         }
         HashTable<Cell*> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        if (is_incremental_marking_in_progress()) {
+            // A full collection is already being marked, so finish that one.
+            finish_incremental_marking(roots);
+            collection_type = CollectionType::CollectGarbage;
+        } else if (collection_type == CollectionType::CollectYoungGeneration) {
+            mark_live_young_cells(roots);
+        } else {
+            mark_live_cells(roots);
+        }
+    } else if (is_incremental_marking_in_progress()) {
+        abandon_incremental_marking();
     }
-    finalize_unmarked_cells();
-    sweep_dead_cells(print_report, collection_measurement_timer);
+
+    // After a collection there are no young cells left for old cells to point to, so everything can be forgotten.
+    for (auto* cell : m_remembered_cells)
+        cell->set_remembered(false);
+    m_remembered_cells.clear();
+
+    // The program doesn't have to wait for dead cells to be swept, only for those that can be found after dying.
+    // A full report needs everything swept though.
+    bool sweep_lazily = collection_type == CollectionType::CollectGarbage && !print_report;
+    if (sweep_lazily)
+        queue_blocks_for_lazy_sweeping();
+
+    finalize_unmarked_cells(collection_type);
+    sweep_dead_cells(collection_type, print_report, collection_measurement_timer);
+
+    if (sweep_lazily && m_lazy_sweeping_timer)
+        m_lazy_sweeping_timer->start();
 }
 
 void Heap::gather_roots(HashTable<Cell*>& roots)
@@ -209,7 +263,14 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(HashTable<Cell*> const& roots)
+    enum class IsIncremental {
+        No,
+        Yes,
+    };
+
+    explicit MarkingVisitor(HashTable<Cell*> const& roots, Heap::CollectionType collection_type = Heap::CollectionType::CollectGarbage, IsIncremental is_incremental = IsIncremental::No)
+        : m_only_mark_young_cells(collection_type == Heap::CollectionType::CollectYoungGeneration)
+        , m_incremental(is_incremental == IsIncremental::Yes)
     {
         for (auto* root : roots) {
             visit(root);
@@ -220,6 +281,9 @@ public:
     {
         if (cell.is_marked())
             return;
+        // Old cells are known to be live during a young generation collection, so there's no need to trace through them.
+        if (m_only_mark_young_cells && !cell.is_young())
+            return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
         cell.set_marked(true);
@@ -228,13 +292,62 @@ public:
 
     void mark_all_live_cells()
     {
+        mark_cells_marked_for_later();
         while (!m_work_queue.is_empty()) {
-            m_work_queue.take_last().visit_edges(*this);
+            trace(m_work_queue.take_last());
         }
     }
 
+    // Returns true if there was nothing left to mark before the budget ran out.
+    bool mark_live_cells_for(Time budget)
+    {
+        Core::ElapsedTimer timer(true);
+        timer.start();
+        mark_cells_marked_for_later();
+        while (!m_work_queue.is_empty()) {
+            // Looking at the clock is more expensive than tracing a cell, so only do it every once in a while.
+            for (size_t i = 0; i < 256 && !m_work_queue.is_empty(); ++i)
+                trace(m_work_queue.take_last());
+            if (timer.elapsed_time() >= budget)
+                break;
+        }
+        return m_work_queue.is_empty() && m_cells_marked_for_later.is_empty();
+    }
+
+    void mark_later(Cell& cell)
+    {
+        m_cells_marked_for_later.append(&cell);
+    }
+
+    void trace_cells_without_write_barrier_again()
+    {
+        auto cells = move(m_cells_without_write_barrier);
+        for (auto* cell : cells)
+            cell->visit_edges(*this);
+    }
+
 private:
+    void trace(Cell& cell)
+    {
+        cell.visit_edges(*this);
+        // Cells without a write barrier can be given references to unmarked cells after being traced, without us noticing.
+        if (m_incremental && cell.is_remembered())
+            m_cells_without_write_barrier.set(&cell);
+    }
+
+    void mark_cells_marked_for_later()
+    {
+        for (auto* cell : m_cells_marked_for_later)
+            visit(cell);
+        m_cells_marked_for_later.clear();
+    }
+
     Vector<Cell&> m_work_queue;
+    bool m_only_mark_young_cells { false };
+
+    bool m_incremental { false };
+    Vector<Cell*> m_cells_marked_for_later;
+    HashTable<Cell*> m_cells_without_write_barrier;
 };
 
 void Heap::mark_live_cells(HashTable<Cell*> const& roots)
@@ -250,6 +363,156 @@ void Heap::mark_live_cells(HashTable<Cell*> const& roots)
     m_uprooted_cells.clear();
 }
 
+void Heap::set_incremental_marking_enabled(bool enabled)
+{
+    m_incremental_marking_enabled = enabled;
+    if (!enabled || m_incremental_marking_timer)
+        return;
+    m_incremental_marking_timer = MUST(Core::Timer::create_single_shot(0, [this] {
+        if (!is_incremental_marking_in_progress())
+            return;
+        if (perform_incremental_marking_step())
+            collect_garbage();
+        else
+            m_incremental_marking_timer->start();
+    }));
+    m_lazy_sweeping_timer = MUST(Core::Timer::create_single_shot(0, [this] {
+        if (!sweep_blocks_waiting_to_be_swept(m_incremental_marking_step_budget))
+            m_lazy_sweeping_timer->start();
+    }));
+}
+
+void Heap::start_incremental_marking()
+{
+    VERIFY(!m_collecting_garbage);
+    VERIFY(!is_incremental_marking_in_progress());
+    TemporaryChange change(m_collecting_garbage, true);
+
+    dbgln_if(HEAP_DEBUG, "start_incremental_marking:");
+
+    // From here on, this counts the allocations since marking started.
+    m_allocations_since_last_gc = 0;
+
+    sweep_blocks_waiting_to_be_swept();
+
+    HashTable<Cell*> roots;
+    gather_roots(roots);
+    m_incremental_marking_visitor = make<MarkingVisitor>(roots, CollectionType::CollectGarbage, MarkingVisitor::IsIncremental::Yes);
+
+    if (m_incremental_marking_enabled)
+        m_incremental_marking_timer->start();
+}
+
+bool Heap::perform_incremental_marking_step()
+{
+    VERIFY(!m_collecting_garbage);
+    VERIFY(is_incremental_marking_in_progress());
+    TemporaryChange change(m_collecting_garbage, true);
+
+    return m_incremental_marking_visitor->mark_live_cells_for(m_incremental_marking_step_budget);
+}
+
+void Heap::mark_cell_incrementally(Cell& cell)
+{
+    // The cell stays unmarked until the next step traces it, so that writing to it again doesn't get it here again.
+    cell.set_marked(false);
+    m_incremental_marking_visitor->mark_later(cell);
+}
+
+void Heap::finish_incremental_marking(HashTable<Cell*> const& roots)
+{
+    dbgln_if(HEAP_DEBUG, "finish_incremental_marking:");
+
+    auto visitor = m_incremental_marking_visitor.release_nonnull();
+    if (m_incremental_marking_timer)
+        m_incremental_marking_timer->stop();
+
+    // The write barrier has kept track of everything else that changed while we were marking.
+    for (auto* root : roots)
+        visitor->visit(root);
+    for (auto* cell : m_cells_under_construction)
+        cell->visit_edges(*visitor);
+    visitor->trace_cells_without_write_barrier_again();
+    visitor->mark_all_live_cells();
+
+    for (auto& inverse_root : m_uprooted_cells)
+        inverse_root->set_marked(false);
+
+    m_uprooted_cells.clear();
+}
+
+void Heap::abandon_incremental_marking()
+{
+    m_incremental_marking_visitor = nullptr;
+    if (m_incremental_marking_timer)
+        m_incremental_marking_timer->stop();
+
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
+}
+
+void Heap::mark_live_young_cells(HashTable<Cell*> const& roots)
+{
+    dbgln_if(HEAP_DEBUG, "mark_live_young_cells:");
+
+    MarkingVisitor visitor(roots, CollectionType::CollectYoungGeneration);
+
+    // Any young cell that is only reachable through an old cell has to be reachable through one in the remembered set.
+    for (auto* cell : m_remembered_cells)
+        cell->visit_edges(visitor);
+    for (auto* cell : m_cells_without_write_barrier)
+        cell->visit_edges(visitor);
+
+    visitor.mark_all_live_cells();
+
+    if constexpr (HEAP_DEBUG)
+        verify_remembered_set();
+
+    // Old cells can only be collected by a full collection, so keep them around until then.
+    m_uprooted_cells.remove_all_matching([](Cell* cell) {
+        if (!cell->is_young())
+            return false;
+        cell->set_marked(false);
+        return true;
+    });
+}
+
+class RememberedSetVerifier final : public Cell::Visitor {
+public:
+    explicit RememberedSetVerifier(Cell& cell)
+        : m_cell(cell)
+    {
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        if (!cell.is_young() || cell.is_marked())
+            return;
+        dbgln("Old cell {} points to unmarked young cell {}, but is not in the remembered set!", &m_cell, &cell);
+        VERIFY_NOT_REACHED();
+    }
+
+private:
+    Cell& m_cell;
+};
+
+void Heap::verify_remembered_set()
+{
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (cell->is_young() || cell->is_remembered())
+                return;
+            RememberedSetVerifier verifier(*cell);
+            cell->visit_edges(verifier);
+        });
+        return IterationDecision::Continue;
+    });
+}
+
 bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
 {
     if (!cell.overrides_must_survive_garbage_collection({}))
@@ -257,10 +520,15 @@ bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
     return cell.must_survive_garbage_collection();
 }
 
-void Heap::finalize_unmarked_cells()
+void Heap::finalize_unmarked_cells(CollectionType collection_type)
 {
+    bool only_young_cells = collection_type == CollectionType::CollectYoungGeneration;
     for_each_block([&](auto& block) {
-        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+        if ((only_young_cells && !block.has_young_cells()) || block.is_waiting_to_be_swept())
+            return IterationDecision::Continue;
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (only_young_cells && !cell->is_young())
+                return;
             if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell))
                 cell->finalize();
         });
@@ -268,34 +536,132 @@ void Heap::finalize_unmarked_cells()
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::queue_blocks_for_lazy_sweeping()
+{
+    for_each_block([&](auto& block) {
+        if (!block.has_cells_that_must_be_swept_eagerly())
+            allocator_for_size(block.cell_size()).block_is_waiting_to_be_swept({}, block);
+        return IterationDecision::Continue;
+    });
+}
+
+void Heap::promote_cell(Cell& cell)
+{
+    // A cell that is still being constructed may have young cells stored into it without a write barrier.
+    if (is_under_construction(cell))
+        return;
+    cell.set_young(false);
+    if (cell.is_remembered())
+        m_cells_without_write_barrier.append(&cell);
+}
+
+bool Heap::sweep_cells_in_block(HeapBlock& block, CollectionType collection_type, SweepStatistics& statistics, RememberPromotedCells remember_promoted_cells)
+{
+    bool only_young_cells = collection_type == CollectionType::CollectYoungGeneration;
+    bool block_has_live_cells = false;
+    bool block_has_young_cells = false;
+    bool block_has_cells_that_must_be_swept_eagerly = false;
+    block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+        if (only_young_cells && !cell->is_young()) {
+            block_has_live_cells = true;
+            block_has_cells_that_must_be_swept_eagerly |= cell->must_be_swept_eagerly();
+            ++statistics.live_cells;
+            statistics.live_cell_bytes += block.cell_size();
+            return;
+        }
+        if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
+            dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+            block.deallocate(cell);
+            ++statistics.collected_cells;
+            statistics.collected_cell_bytes += block.cell_size();
+        } else {
+            cell->set_marked(false);
+            if (cell->is_young()) {
+                promote_cell(*cell);
+                if (cell->is_young()) {
+                    block_has_young_cells = true;
+                } else {
+                    ++statistics.promoted_cells;
+                    if (remember_promoted_cells == RememberPromotedCells::Yes)
+                        remember_cell(*cell);
+                }
+            } else if (!only_young_cells && cell->is_remembered()) {
+                m_cells_without_write_barrier.append(cell);
+            }
+            block_has_live_cells = true;
+            block_has_cells_that_must_be_swept_eagerly |= cell->must_be_swept_eagerly();
+            ++statistics.live_cells;
+            statistics.live_cell_bytes += block.cell_size();
+        }
+    });
+    block.set_has_young_cells(block_has_young_cells);
+    block.set_has_cells_that_must_be_swept_eagerly(block_has_cells_that_must_be_swept_eagerly);
+    return block_has_live_cells;
+}
+
+void Heap::sweep_block(HeapBlock& block)
 {
+    dbgln_if(HEAP_DEBUG, "sweep_block: {}", &block);
+    VERIFY(block.is_waiting_to_be_swept());
+    block.m_sweep_list_node.remove();
+
+    block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+        if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell))
+            cell->finalize();
+    });
+
+    // Young cells that survived the collection have been written to without being remembered, since they were young.
+    // Now that they're old, they have to be remembered in case any of those writes were references to young cells.
+    SweepStatistics statistics;
+    bool block_was_full = block.is_full();
+    bool block_has_live_cells = sweep_cells_in_block(block, CollectionType::CollectGarbage, statistics, RememberPromotedCells::Yes);
+    m_live_cells_after_last_full_gc += statistics.live_cells;
+
+    if (!block_has_live_cells)
+        allocator_for_size(block.cell_size()).block_did_become_empty({}, block);
+    else if (block_was_full != block.is_full())
+        allocator_for_size(block.cell_size()).block_did_become_usable({}, block);
+}
+
+bool Heap::sweep_blocks_waiting_to_be_swept(Optional<Time> budget)
+{
+    Core::ElapsedTimer timer(true);
+    timer.start();
+    for (auto& allocator : m_allocators) {
+        while (auto* block = allocator->next_block_waiting_to_be_swept()) {
+            if (budget.has_value() && timer.elapsed_time() >= *budget)
+                return false;
+            sweep_block(*block);
+        }
+    }
+    return true;
+}
+
+bool Heap::is_dead(Cell const& cell)
+{
+    if (cell.state() != Cell::State::Live)
+        return true;
+    return HeapBlock::from_cell(&cell)->is_waiting_to_be_swept() && !cell.is_marked() && !cell_must_survive_garbage_collection(cell);
+}
+
+void Heap::sweep_dead_cells(CollectionType collection_type, bool print_report, Core::ElapsedTimer const& measurement_timer)
+{
+    bool only_young_cells = collection_type == CollectionType::CollectYoungGeneration;
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
     Vector<HeapBlock*, 32> full_blocks_that_became_usable;
 
-    size_t collected_cells = 0;
-    size_t live_cells = 0;
-    size_t collected_cell_bytes = 0;
-    size_t live_cell_bytes = 0;
+    SweepStatistics statistics;
+
+    // A full collection finds all the surviving cells without a write barrier on its own.
+    if (!only_young_cells)
+        m_cells_without_write_barrier.clear();
 
     for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
+        if ((only_young_cells && !block.has_young_cells()) || block.is_waiting_to_be_swept())
+            return IterationDecision::Continue;
         bool block_was_full = block.is_full();
-        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
-                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
-                ++collected_cells;
-                collected_cell_bytes += block.cell_size();
-            } else {
-                cell->set_marked(false);
-                block_has_live_cells = true;
-                ++live_cells;
-                live_cell_bytes += block.cell_size();
-            }
-        });
-        if (!block_has_live_cells)
+        if (!sweep_cells_in_block(block, collection_type, statistics, RememberPromotedCells::No))
             empty_blocks.append(&block);
         else if (block_was_full != block.is_full())
             full_blocks_that_became_usable.append(&block);
@@ -305,6 +671,14 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
 
+    if (only_young_cells) {
+        m_cells_promoted_since_last_full_gc += statistics.promoted_cells;
+    } else {
+        // The blocks that are swept lazily add their live cells to this when they're swept.
+        m_live_cells_after_last_full_gc = statistics.live_cells;
+        m_cells_promoted_since_last_full_gc = 0;
+    }
+
     for (auto* block : empty_blocks) {
         dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
         allocator_for_size(block->cell_size()).block_did_become_empty({}, *block);
@@ -330,11 +704,12 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
             return IterationDecision::Continue;
         });
 
-        dbgln("Garbage collection report");
+        dbgln("Garbage collection report ({})", only_young_cells ? "young generation"sv : "full"sv);
         dbgln("=============================================");
         dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
-        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        dbgln("     Live cells: {} ({} bytes)", statistics.live_cells, statistics.live_cell_bytes);
+        dbgln("Collected cells: {} ({} bytes)", statistics.collected_cells, statistics.collected_cell_bytes);
+        dbgln(" Promoted cells: {}", statistics.promoted_cells);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
         dbgln("=============================================");
@@ -399,6 +774,28 @@ void Heap::uproot_cell(Cell* cell)
     m_uprooted_cells.append(cell);
 }
 
+void Heap::did_write_to_cell(Badge<Cell>, Cell& cell)
+{
+    if (cell.is_marked() && is_incremental_marking_in_progress())
+        mark_cell_incrementally(cell);
+
+    if (!cell.is_young())
+        remember_cell(cell);
+}
+
+void Heap::remember_cell(Cell& cell)
+{
+    if (cell.is_remembered())
+        return;
+    cell.set_remembered(true);
+    m_remembered_cells.append(&cell);
+}
+
+void Cell::did_write_to_cell()
+{
+    heap().did_write_to_cell({}, *this);
+}
+
 void register_safe_function_closure(void* base, size_t size)
 {
     if (!s_custom_ranges_for_conservative_scan) {
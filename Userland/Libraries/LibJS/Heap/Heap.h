@@ -11,6 +11,11 @@
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/ScopeGuard.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -24,6 +29,14 @@
 
 namespace JS {
 
+class MarkingVisitor;
+
+// Full collections leave most dead cells for the allocator to sweep once it gets to their block, which cells that can
+// still be found after dying (through a weak pointer, or by a weak container) can't wait for. Neither can cells outside
+// of LibJS, whose destructors and finalizers might unregister them from somewhere.
+template<typename T>
+concept CellCanBeSweptLazily = T::cell_has_write_barrier && !IsBaseOf<WeakContainer, T> && !requires(T& cell) { cell.make_weak_ptr(); };
+
 class Heap {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -36,7 +49,9 @@ public:
     NonnullGCPtr<T> allocate_without_realm(Args&&... args)
     {
         auto* memory = allocate_cell(sizeof(T));
+        m_cells_under_construction.append(memory);
         new (memory) T(forward<Args>(args)...);
+        did_construct_cell<T>(*memory);
         return *static_cast<T*>(memory);
     }
 
@@ -44,6 +59,8 @@ public:
     ThrowCompletionOr<NonnullGCPtr<T>> allocate(Realm& realm, Args&&... args)
     {
         auto* memory = allocate_cell(sizeof(T));
+        m_cells_under_construction.append(memory);
+        ScopeGuard did_construct_guard = [&] { did_construct_cell<T>(*memory); };
         new (memory) T(forward<Args>(args)...);
         auto* cell = static_cast<T*>(memory);
         MUST_OR_THROW_OOM(memory->initialize(realm));
@@ -53,6 +70,7 @@ public:
     enum class CollectionType {
         CollectGarbage,
         CollectEverything,
+        CollectYoungGeneration,
     };
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
@@ -62,6 +80,24 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // With incremental marking enabled, automatic full collections mark the heap in steps that run from the Core::EventLoop
+    // (and on allocation), each taking about as long as the step budget. The collection is then finished by a short pause.
+    bool is_incremental_marking_enabled() const { return m_incremental_marking_enabled; }
+    void set_incremental_marking_enabled(bool);
+
+    Time incremental_marking_step_budget() const { return m_incremental_marking_step_budget; }
+    void set_incremental_marking_step_budget(Time budget) { m_incremental_marking_step_budget = budget; }
+
+    bool is_incremental_marking_in_progress() const { return m_incremental_marking_visitor; }
+    void start_incremental_marking();
+    // Returns true once everything reachable has been marked, and collect_garbage() can finish the collection.
+    bool perform_incremental_marking_step();
+
+    // Whether the last collection found the cell to be dead. Unlike its state(), this is also true before it's swept.
+    static bool is_dead(Cell const&);
+
+    void sweep_block(Badge<CellAllocator>, HeapBlock& block) { sweep_block(block); }
+
     void did_create_handle(Badge<HandleImpl>, HandleImpl&);
     void did_destroy_handle(Badge<HandleImpl>, HandleImpl&);
 
@@ -78,16 +114,62 @@ public:
 
     void uproot_cell(Cell* cell);
 
+    void did_write_to_cell(Badge<Cell>, Cell&);
+
 private:
+    template<typename T>
+    void did_construct_cell(Cell& cell)
+    {
+        VERIFY(m_cells_under_construction.last() == &cell);
+        m_cells_under_construction.take_last();
+        if constexpr (!T::cell_has_write_barrier)
+            cell.set_remembered(true);
+        if constexpr (!CellCanBeSweptLazily<T>) {
+            cell.set_must_be_swept_eagerly(true);
+            HeapBlock::from_cell(&cell)->set_has_cells_that_must_be_swept_eagerly(true);
+        }
+        if (is_incremental_marking_in_progress())
+            mark_cell_incrementally(cell);
+    }
+
+    bool is_under_construction(Cell& cell) const { return m_cells_under_construction.contains_slow(&cell); }
+    void promote_cell(Cell&);
+
     static bool cell_must_survive_garbage_collection(Cell const&);
 
     Cell* allocate_cell(size_t);
 
+    CollectionType automatic_collection_type() const;
+
     void gather_roots(HashTable<Cell*>&);
     void gather_conservative_roots(HashTable<Cell*>&);
     void mark_live_cells(HashTable<Cell*> const& live_cells);
-    void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void mark_live_young_cells(HashTable<Cell*> const& live_cells);
+    void mark_cell_incrementally(Cell&);
+    void finish_incremental_marking(HashTable<Cell*> const& live_cells);
+    void abandon_incremental_marking();
+    void verify_remembered_set();
+    void finalize_unmarked_cells(CollectionType);
+    void queue_blocks_for_lazy_sweeping();
+    void sweep_dead_cells(CollectionType, bool print_report, Core::ElapsedTimer const&);
+    void sweep_block(HeapBlock&);
+    // Returns true if there was nothing left to sweep before the budget ran out.
+    bool sweep_blocks_waiting_to_be_swept(Optional<Time> budget = {});
+
+    struct SweepStatistics {
+        size_t collected_cells { 0 };
+        size_t live_cells { 0 };
+        size_t collected_cell_bytes { 0 };
+        size_t live_cell_bytes { 0 };
+        size_t promoted_cells { 0 };
+    };
+    enum class RememberPromotedCells {
+        No,
+        Yes,
+    };
+    // Returns true if any cells in the block are still alive.
+    bool sweep_cells_in_block(HeapBlock&, CollectionType, SweepStatistics&, RememberPromotedCells);
+    void remember_cell(Cell&);
 
     CellAllocator& allocator_for_size(size_t);
 
@@ -103,8 +185,21 @@ private:
     size_t m_max_allocations_between_gc { 100000 };
     size_t m_allocations_since_last_gc { 0 };
 
+    // Automatic collections only look at the young generation, until the cells promoted since the last full collection
+    // outnumber the cells that survived it (or the allocation threshold, whichever is larger).
+    size_t m_live_cells_after_last_full_gc { 0 };
+    size_t m_cells_promoted_since_last_full_gc { 0 };
+
     bool m_should_collect_on_every_allocation { false };
 
+    bool m_incremental_marking_enabled { false };
+    Time m_incremental_marking_step_budget { Time::from_milliseconds(8) };
+    size_t m_max_allocations_between_incremental_marking_steps { 10000 };
+    OwnPtr<MarkingVisitor> m_incremental_marking_visitor;
+    RefPtr<Core::Timer> m_incremental_marking_timer;
+    // With incremental marking enabled, the blocks left for lazy sweeping are also swept in steps of the same budget.
+    RefPtr<Core::Timer> m_lazy_sweeping_timer;
+
     VM& m_vm;
 
     Vector<NonnullOwnPtr<CellAllocator>> m_allocators;
@@ -115,6 +210,14 @@ private:
 
     Vector<Cell*> m_uprooted_cells;
 
+    // Old cells that have been written to since the last collection.
+    Vector<Cell*> m_remembered_cells;
+    // Old cells that don't use the write barrier, and so have to be treated as written to by every young generation collection.
+    Vector<Cell*> m_cells_without_write_barrier;
+
+    // Cells are kept in the young generation until their constructor has finished, since stores into them aren't barriered until then.
+    Vector<Cell*, 8> m_cells_under_construction;
+
     BlockAllocator m_block_allocator;
 
     size_t m_gc_deferrals { 0 };
@@ -68,6 +68,17 @@ public:
 
     Heap& heap() { return m_heap; }
 
+    // Whether any cells have been allocated in this block since the last collection.
+    bool has_young_cells() const { return m_has_young_cells; }
+    void set_has_young_cells(bool b) { m_has_young_cells = b; }
+
+    // Whether any cells in this block have to be swept by the collection that found them dead (see Heap::is_dead()).
+    bool has_cells_that_must_be_swept_eagerly() const { return m_has_cells_that_must_be_swept_eagerly; }
+    void set_has_cells_that_must_be_swept_eagerly(bool b) { m_has_cells_that_must_be_swept_eagerly = b; }
+
+    // Whether the last full collection left the unmarked cells in this block for later, rather than sweeping them.
+    bool is_waiting_to_be_swept() const { return m_sweep_list_node.is_in_list(); }
+
     static HeapBlock* from_cell(Cell const* cell)
     {
         return reinterpret_cast<HeapBlock*>((FlatPtr)cell & ~(block_size - 1));
@@ -90,6 +101,7 @@ public:
     }
 
     IntrusiveListNode<HeapBlock> m_list_node;
+    IntrusiveListNode<HeapBlock> m_sweep_list_node;
 
 private:
     HeapBlock(Heap&, size_t cell_size);
@@ -111,6 +123,8 @@ private:
     size_t m_cell_size { 0 };
     size_t m_next_lazy_freelist_index { 0 };
     FreelistEntry* m_freelist { nullptr };
+    bool m_has_young_cells { false };
+    bool m_has_cells_that_must_be_swept_eagerly { false };
     alignas(Cell) u8 m_storage[];
 
 public:
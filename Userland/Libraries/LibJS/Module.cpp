@@ -118,6 +118,7 @@ Object* Module::module_namespace_create(VM& vm, Vector<DeprecatedFlyString> unam
 
     // 9. Set module.[[Namespace]] to M.
     m_namespace = make_handle(module_namespace);
+    write_barrier();
 
     // 10. Return M.
     return module_namespace;
@@ -90,6 +90,7 @@ protected:
     void set_environment(Environment* environment)
     {
         m_environment = environment;
+        write_barrier();
     }
 
 private:
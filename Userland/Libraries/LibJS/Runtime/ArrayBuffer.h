@@ -40,7 +40,11 @@ public:
     void set_buffer(ByteBuffer buffer) { m_buffer = move(buffer); }
 
     Value detach_key() const { return m_detach_key; }
-    void set_detach_key(Value detach_key) { m_detach_key = detach_key; }
+    void set_detach_key(Value detach_key)
+    {
+        m_detach_key = detach_key;
+        write_barrier();
+    }
 
     void detach_buffer() { m_buffer = Empty {}; }
     bool is_detached() const { return m_buffer.has<Empty>(); }
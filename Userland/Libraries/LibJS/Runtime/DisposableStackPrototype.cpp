@@ -104,6 +104,7 @@ JS_DEFINE_NATIVE_FUNCTION(DisposableStackPrototype::use)
         // i. Perform ? AddDisposableResource(disposableStack, value, sync-dispose, method).
         // FIXME: Fairly sure this can't fail, see https://github.com/tc39/proposal-explicit-resource-management/pull/142
         MUST(add_disposable_resource(vm, disposable_stack->disposable_resource_stack(), value, Environment::InitializeBindingHint::SyncDispose, method));
+        disposable_stack->write_barrier();
     }
 
     // 5. Return value.
@@ -149,6 +150,7 @@ JS_DEFINE_NATIVE_FUNCTION(DisposableStackPrototype::adopt)
 
     // 8. Perform ? AddDisposableResource(disposableStack, undefined, sync-dispose, F).
     TRY(add_disposable_resource(vm, disposable_stack->disposable_resource_stack(), js_undefined(), Environment::InitializeBindingHint::SyncDispose, function));
+    disposable_stack->write_barrier();
 
     // 9. Return value.
     return value;
@@ -173,6 +175,7 @@ JS_DEFINE_NATIVE_FUNCTION(DisposableStackPrototype::defer)
 
     // 5. Perform ? AddDisposableResource(disposableStack, undefined, sync-dispose, onDispose).
     TRY(add_disposable_resource(vm, disposable_stack->disposable_resource_stack(), js_undefined(), Environment::InitializeBindingHint::SyncDispose, &on_dispose.as_function()));
+    disposable_stack->write_barrier();
 
     // 6. Return undefined.
     return js_undefined();
@@ -21,6 +21,7 @@ void FinalizationRegistry::add_finalization_record(Cell& target, Value held_valu
 {
     VERIFY(!held_value.is_empty());
     m_records.append({ &target, held_value, unregister_token });
+    write_barrier();
 }
 
 // Extracted from FinalizationRegistry.prototype.unregister ( unregisterToken )
@@ -49,7 +50,7 @@ void FinalizationRegistry::remove_dead_cells(Badge<Heap>)
 {
     auto any_cells_were_removed = false;
     for (auto& record : m_records) {
-        if (!record.target || record.target->state() == Cell::State::Live)
+        if (!record.target || !Heap::is_dead(*record.target))
             continue;
         record.target = nullptr;
         any_cells_were_removed = true;
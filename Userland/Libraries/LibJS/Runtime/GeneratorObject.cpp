@@ -147,6 +147,7 @@ ThrowCompletionOr<Value> GeneratorObject::execute(VM& vm, Completion const& comp
         return result_value;
     }
     m_previous_value = result_value.release_value();
+    write_barrier();
     bool done = generated_continuation(m_previous_value) == nullptr;
 
     m_generator_state = done ? GeneratorState::Completed : GeneratorState::SuspendedYield;
@@ -70,7 +70,11 @@ public:
     void set_numeric(bool numeric) { m_numeric = numeric; }
 
     CollatorCompareFunction* bound_compare() const { return m_bound_compare; }
-    void set_bound_compare(CollatorCompareFunction* bound_compare) { m_bound_compare = bound_compare; }
+    void set_bound_compare(CollatorCompareFunction* bound_compare)
+    {
+        m_bound_compare = bound_compare;
+        write_barrier();
+    }
 
 private:
     explicit Collator(Object& prototype);
@@ -124,7 +124,11 @@ public:
     StringView time_zone_name_string() const { return ::Locale::calendar_pattern_style_to_string(*Patterns::time_zone_name); }
 
     NativeFunction* bound_format() const { return m_bound_format; }
-    void set_bound_format(NativeFunction* bound_format) { m_bound_format = bound_format; }
+    void set_bound_format(NativeFunction* bound_format)
+    {
+        m_bound_format = bound_format;
+        write_barrier();
+    }
 
 private:
     DateTimeFormat(Object& prototype);
@@ -56,7 +56,11 @@ public:
     void set_number_format(NumberFormat* number_format) { m_number_format = number_format; }
 
     PluralRules& plural_rules() const { return *m_plural_rules; }
-    void set_plural_rules(PluralRules* plural_rules) { m_plural_rules = plural_rules; }
+    void set_plural_rules(PluralRules* plural_rules)
+    {
+        m_plural_rules = plural_rules;
+        write_barrier();
+    }
 
 private:
     explicit RelativeTimeFormat(Object& prototype);
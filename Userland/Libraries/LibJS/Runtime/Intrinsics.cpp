@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibJS/Heap/DeferGC.h>
 #include <LibJS/Runtime/AggregateErrorConstructor.h>
 #include <LibJS/Runtime/AggregateErrorPrototype.h>
 #include <LibJS/Runtime/ArrayBufferConstructor.h>
@@ -140,6 +141,9 @@ NonnullGCPtr<Intrinsics> Intrinsics::create(Realm& realm)
 {
     auto& vm = realm.vm();
 
+    // The intrinsics are stored without a write barrier below, so they mustn't be promoted while that's happening.
+    DeferGC defer_gc(vm.heap());
+
     // 1. Set realmRec.[[Intrinsics]] to a new Record.
     auto intrinsics = vm.heap().allocate_without_realm<Intrinsics>(realm);
     realm.set_intrinsics({}, intrinsics);
@@ -275,10 +279,14 @@ JS_ENUMERATE_TYPED_ARRAYS
         VERIFY(!m_##snake_namespace##snake_name##_constructor);                                                                                                                                                    \
         if constexpr (IsTypedArrayConstructor<Namespace::ConstructorName>) {                                                                                                                                       \
             m_##snake_namespace##snake_name##_prototype = heap().allocate<Namespace::PrototypeName>(m_realm, *typed_array_prototype()).release_allocated_value_but_fixme_should_propagate_errors();                \
+            write_barrier();                                                                                                                                                                                       \
             m_##snake_namespace##snake_name##_constructor = heap().allocate<Namespace::ConstructorName>(m_realm, m_realm, *typed_array_constructor()).release_allocated_value_but_fixme_should_propagate_errors(); \
+            write_barrier();                                                                                                                                                                                       \
         } else {                                                                                                                                                                                                   \
             m_##snake_namespace##snake_name##_prototype = heap().allocate<Namespace::PrototypeName>(m_realm, m_realm).release_allocated_value_but_fixme_should_propagate_errors();                                 \
+            write_barrier();                                                                                                                                                                                       \
             m_##snake_namespace##snake_name##_constructor = heap().allocate<Namespace::ConstructorName>(m_realm, m_realm).release_allocated_value_but_fixme_should_propagate_errors();                             \
+            write_barrier();                                                                                                                                                                                       \
         }                                                                                                                                                                                                          \
                                                                                                                                                                                                                    \
         /* FIXME: Add these special cases to JS_ENUMERATE_NATIVE_OBJECTS */                                                                                                                                        \
@@ -334,8 +342,10 @@ JS_ENUMERATE_TEMPORAL_OBJECTS
 #define __JS_ENUMERATE(ClassName, snake_name)                                                                                                   \
     ClassName* Intrinsics::snake_name##_object()                                                                                                \
     {                                                                                                                                           \
-        if (!m_##snake_name##_object)                                                                                                           \
+        if (!m_##snake_name##_object) {                                                                                                         \
             m_##snake_name##_object = heap().allocate<ClassName>(m_realm, m_realm).release_allocated_value_but_fixme_should_propagate_errors(); \
+            write_barrier();                                                                                                                    \
+        }                                                                                                                                       \
         return m_##snake_name##_object;                                                                                                         \
     }
 JS_ENUMERATE_BUILTIN_NAMESPACE_OBJECTS
@@ -70,6 +70,7 @@ void Map::map_set(Value const& key, Value value)
         m_keys.insert(index, key);
         m_entries.set(key, value);
     }
+    write_barrier();
 }
 
 size_t Map::map_size() const
@@ -75,6 +75,7 @@ ThrowCompletionOr<void> ModuleEnvironment::create_import_binding(DeprecatedFlySt
     m_indirect_bindings.append({ move(name),
         module,
         move(binding_name) });
+    write_barrier();
 
     // 4. Return unused.
     return {};
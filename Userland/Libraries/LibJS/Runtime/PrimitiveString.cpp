@@ -42,10 +42,17 @@ PrimitiveString::PrimitiveString(Utf16String string)
 
 PrimitiveString::~PrimitiveString()
 {
-    if (has_utf8_string())
-        vm().string_cache().remove(*m_utf8_string);
-    if (has_deprecated_string())
-        vm().deprecated_string_cache().remove(*m_deprecated_string);
+    // A string that was dead while waiting to be swept may have been replaced in the cache already.
+    if (has_utf8_string()) {
+        auto& string_cache = vm().string_cache();
+        if (auto it = string_cache.find(*m_utf8_string); it != string_cache.end() && it->value == this)
+            string_cache.remove(it);
+    }
+    if (has_deprecated_string()) {
+        auto& string_cache = vm().deprecated_string_cache();
+        if (auto it = string_cache.find(*m_deprecated_string); it != string_cache.end() && it->value == this)
+            string_cache.remove(it);
+    }
 }
 
 void PrimitiveString::visit_edges(Cell::Visitor& visitor)
@@ -179,8 +186,9 @@ NonnullGCPtr<PrimitiveString> PrimitiveString::create(VM& vm, String string)
             return vm.single_ascii_character_string(ch);
     }
 
+    // Strings that were found to be dead stay in the cache until they're swept, but mustn't be brought back to life.
     auto& string_cache = vm.string_cache();
-    if (auto it = string_cache.find(string); it != string_cache.end())
+    if (auto it = string_cache.find(string); it != string_cache.end() && !Heap::is_dead(*it->value))
         return *it->value;
 
     auto new_string = vm.heap().allocate_without_realm<PrimitiveString>(string);
@@ -206,7 +214,7 @@ NonnullGCPtr<PrimitiveString> PrimitiveString::create(VM& vm, DeprecatedString s
 
     auto& string_cache = vm.deprecated_string_cache();
     auto it = string_cache.find(string);
-    if (it == string_cache.end()) {
+    if (it == string_cache.end() || Heap::is_dead(*it->value)) {
         auto new_string = vm.heap().allocate_without_realm<PrimitiveString>(string);
         string_cache.set(move(string), new_string);
         return *new_string;
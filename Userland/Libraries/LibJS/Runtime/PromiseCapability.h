@@ -22,13 +22,25 @@ public:
     virtual ~PromiseCapability() = default;
 
     [[nodiscard]] GCPtr<Object> promise() const { return m_promise; }
-    void set_promise(NonnullGCPtr<Object> promise) { m_promise = promise; }
+    void set_promise(NonnullGCPtr<Object> promise)
+    {
+        m_promise = promise;
+        write_barrier();
+    }
 
     [[nodiscard]] GCPtr<FunctionObject> resolve() const { return m_resolve; }
-    void set_resolve(NonnullGCPtr<FunctionObject> resolve) { m_resolve = resolve; }
+    void set_resolve(NonnullGCPtr<FunctionObject> resolve)
+    {
+        m_resolve = resolve;
+        write_barrier();
+    }
 
     [[nodiscard]] GCPtr<FunctionObject> reject() const { return m_reject; }
-    void set_reject(NonnullGCPtr<FunctionObject> reject) { m_reject = reject; }
+    void set_reject(NonnullGCPtr<FunctionObject> reject)
+    {
+        m_reject = reject;
+        write_barrier();
+    }
 
 private:
     PromiseCapability(GCPtr<Object>, GCPtr<FunctionObject>, GCPtr<FunctionObject>);
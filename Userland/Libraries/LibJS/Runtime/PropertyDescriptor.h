@@ -40,6 +40,9 @@ public:
     Optional<bool> writable {};
     Optional<bool> enumerable {};
     Optional<bool> configurable {};
+
+    // Not a standard field, set by ordinary objects when the property lives in the object's shape-based storage.
+    Optional<u32> property_offset {};
 };
 
 }
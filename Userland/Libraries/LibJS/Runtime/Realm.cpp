@@ -109,6 +109,7 @@ void Realm::set_global_object(Object* global_object, Object* this_value)
     // 5. Let newGlobalEnv be NewGlobalEnvironment(globalObj, thisValue).
     // 6. Set realmRec.[[GlobalEnv]] to newGlobalEnv.
     m_global_environment = m_global_object->heap().allocate_without_realm<GlobalEnvironment>(*global_object, *this_value);
+    write_barrier();
 
     // 7. Return unused.
 }
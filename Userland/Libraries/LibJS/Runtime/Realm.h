@@ -43,10 +43,15 @@ public:
     {
         VERIFY(!m_intrinsics);
         m_intrinsics = &intrinsics;
+        write_barrier();
     }
 
     HostDefined* host_defined() { return m_host_defined; }
-    void set_host_defined(OwnPtr<HostDefined> host_defined) { m_host_defined = move(host_defined); }
+    void set_host_defined(OwnPtr<HostDefined> host_defined)
+    {
+        m_host_defined = move(host_defined);
+        write_barrier();
+    }
 
 private:
     Realm() = default;
@@ -53,7 +53,11 @@ public:
     Realm const& realm() const { return *m_realm; }
     bool legacy_features_enabled() const { return m_legacy_features_enabled; }
     void set_legacy_features_enabled(bool legacy_features_enabled) { m_legacy_features_enabled = legacy_features_enabled; }
-    void set_realm(Realm& realm) { m_realm = &realm; }
+    void set_realm(Realm& realm)
+    {
+        m_realm = &realm;
+        write_barrier();
+    }
 
 private:
     RegExpObject(Object& prototype);
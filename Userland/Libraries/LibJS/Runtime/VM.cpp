@@ -496,7 +496,7 @@ ThrowCompletionOr<void> VM::iterator_binding_initialization(BindingPattern const
                 }
 
                 // f. Perform ! CreateDataPropertyOrThrow(A, ! ToString(𝔽(n)), nextValue).
-                array->indexed_properties().append(next_value.value());
+                array->append_indexed_property(next_value.value());
 
                 // g. Set n to n + 1.
             }
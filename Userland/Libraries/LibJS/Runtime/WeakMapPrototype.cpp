@@ -76,6 +76,7 @@ JS_DEFINE_NATIVE_FUNCTION(WeakMapPrototype::set)
     if (!can_be_held_weakly(value))
         return vm.throw_completion<TypeError>(ErrorType::CannotBeHeldWeakly, TRY_OR_THROW_OOM(vm, value.to_string_without_side_effects()));
     weak_map->values().set(&value.as_cell(), vm.argument(1));
+    weak_map->write_barrier();
     return weak_map;
 }
 
@@ -417,6 +417,7 @@ ThrowCompletionOr<void> SourceTextModule::initialize_environment(VM& vm)
 
     // 14. Set the LexicalEnvironment of moduleContext to module.[[Environment]].
     m_execution_context.lexical_environment = environment;
+    write_barrier();
 
     // 15. Set the PrivateEnvironment of moduleContext to null.
 
@@ -0,0 +1,120 @@
+// NOTE: Automatic garbage collections only happen every 100'000 allocations or so, and usually only collect
+//       the young generation. These tests make sure that young cells only reachable through old ones survive.
+//       Each old object is only written to once, so that one write can't cover for another.
+
+function allocateALot() {
+    let garbage = null;
+    for (let i = 0; i < 250_000; ++i) garbage = { i };
+    return garbage;
+}
+
+function makeOld(value) {
+    allocateALot();
+    return value;
+}
+
+function makeOldWithUniqueShape() {
+    const object = {};
+    for (let i = 0; i < 200; ++i) object[`property${i}`] = i;
+    return makeOld(object);
+}
+
+test("young objects stored into existing properties of old objects", () => {
+    const old = makeOld({ property: null });
+    const oldWithUniqueShape = makeOldWithUniqueShape();
+
+    (() => {
+        old.property = { value: "property" };
+        oldWithUniqueShape.property0 = { value: "unique shape" };
+    })();
+    allocateALot();
+
+    expect(old.property.value).toBe("property");
+    expect(oldWithUniqueShape.property0.value).toBe("unique shape");
+});
+
+test("young objects stored into new properties of old objects", () => {
+    const old = makeOld({});
+    const oldWithSymbol = makeOld({});
+    const oldWithUniqueShape = makeOldWithUniqueShape();
+
+    (() => {
+        old.property = { value: "property" };
+        oldWithSymbol[Symbol.for("young")] = { value: "symbol" };
+        oldWithUniqueShape.young = { value: "unique shape" };
+    })();
+    allocateALot();
+
+    expect(old.property.value).toBe("property");
+    expect(oldWithSymbol[Symbol.for("young")].value).toBe("symbol");
+    expect(oldWithUniqueShape.young.value).toBe("unique shape");
+});
+
+test("young objects stored into old arrays", () => {
+    const oldArray = makeOld([0]);
+    const oldArrayToPushTo = makeOld([]);
+
+    (() => {
+        oldArray[0] = { value: "element" };
+        oldArrayToPushTo.push({ value: "pushed" });
+    })();
+    allocateALot();
+
+    expect(oldArray[0].value).toBe("element");
+    expect(oldArrayToPushTo[0].value).toBe("pushed");
+});
+
+test("young prototypes of old objects", () => {
+    const old = makeOld({});
+    const oldWithUniqueShape = makeOldWithUniqueShape();
+
+    (() => {
+        Object.setPrototypeOf(old, { value: "prototype" });
+        Object.setPrototypeOf(oldWithUniqueShape, { value: "unique shape prototype" });
+    })();
+    allocateALot();
+
+    expect(old.value).toBe("prototype");
+    expect(oldWithUniqueShape.value).toBe("unique shape prototype");
+});
+
+test("young accessor functions of old accessors", () => {
+    const old = makeOld({});
+    Object.defineProperty(old, "accessor", { get: () => "getter", configurable: true });
+    allocateALot();
+
+    let setterValue;
+    (() => {
+        Object.defineProperty(old, "accessor", { set: value => (setterValue = value) });
+    })();
+    allocateALot();
+
+    expect(old.accessor).toBe("getter");
+    old.accessor = "setter";
+    expect(setterValue).toBe("setter");
+});
+
+test("young strings stored into old objects", () => {
+    const old = makeOld({ rope: null });
+    let rope = "";
+    for (let i = 0; i < 100; ++i) rope += i;
+
+    (() => {
+        old.rope = rope + "!";
+    })();
+    allocateALot();
+
+    expect(old.rope).toBe(rope + "!");
+});
+
+test("young objects captured by old closures", () => {
+    let captured = null;
+    const old = makeOld(() => captured);
+
+    (() => {
+        captured = { value: "captured" };
+    })();
+    allocateALot();
+
+    expect(old().value).toBe("captured");
+});
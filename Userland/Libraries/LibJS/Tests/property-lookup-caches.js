@@ -0,0 +1,121 @@
+// NOTE: These tests run each property access many times from the same call site, so that the
+//       bytecode interpreter's property lookup caches get populated and then have to be invalidated.
+
+function getX(object) {
+    return object.x;
+}
+
+function setX(object, value) {
+    object.x = value;
+}
+
+test("own property reads through different shapes", () => {
+    const objects = [{ x: 1 }, { a: 0, x: 2 }, { a: 0, b: 0, x: 3 }, { a: 0, b: 0, c: 0, x: 4 }, { x: 5 }];
+    for (let i = 0; i < 10; ++i) {
+        for (let j = 0; j < objects.length; ++j) expect(getX(objects[j])).toBe(j + 1);
+    }
+});
+
+test("prototype property reads", () => {
+    class A {
+        get y() {
+            return "accessor";
+        }
+    }
+    A.prototype.x = "prototype";
+    const a = new A();
+    for (let i = 0; i < 10; ++i) expect(getX(a)).toBe("prototype");
+
+    A.prototype.x = "changed";
+    for (let i = 0; i < 10; ++i) expect(getX(a)).toBe("changed");
+
+    a.x = "own";
+    for (let i = 0; i < 10; ++i) expect(getX(a)).toBe("own");
+
+    delete a.x;
+    for (let i = 0; i < 10; ++i) expect(getX(a)).toBe("changed");
+
+    delete A.prototype.x;
+    for (let i = 0; i < 10; ++i) expect(getX(a)).toBeUndefined();
+});
+
+test("prototype changes", () => {
+    const first = { x: "first" };
+    const second = { x: "second" };
+    const object = Object.create(first);
+    for (let i = 0; i < 10; ++i) expect(getX(object)).toBe("first");
+
+    Object.setPrototypeOf(object, second);
+    for (let i = 0; i < 10; ++i) expect(getX(object)).toBe("second");
+});
+
+test("objects with unique shapes", () => {
+    const object = {};
+    for (let i = 0; i < 200; ++i) object[`property${i}`] = i;
+    object.x = 1;
+    for (let i = 0; i < 10; ++i) expect(getX(object)).toBe(1);
+
+    delete object.property0;
+    for (let i = 0; i < 10; ++i) expect(getX(object)).toBe(1);
+
+    delete object.x;
+    for (let i = 0; i < 10; ++i) expect(getX(object)).toBeUndefined();
+
+    Object.defineProperty(object, "x", { get: () => "getter", configurable: true });
+    for (let i = 0; i < 10; ++i) expect(getX(object)).toBe("getter");
+});
+
+test("data property redefined as accessor", () => {
+    const object = {};
+    Object.defineProperty(object, "x", { value: "data", configurable: true });
+    for (let i = 0; i < 10; ++i) expect(getX(object)).toBe("data");
+
+    Object.defineProperty(object, "x", { get: () => "accessor" });
+    for (let i = 0; i < 10; ++i) expect(getX(object)).toBe("accessor");
+});
+
+test("proxies are not confused with ordinary objects", () => {
+    const object = {};
+    const proxy = new Proxy({}, { get: () => "trap" });
+    for (let i = 0; i < 10; ++i) {
+        expect(object.toString).toBe(Object.prototype.toString);
+        expect(proxy.toString).toBe("trap");
+    }
+});
+
+test("own property writes", () => {
+    const objects = [{ x: 0 }, { a: 0, x: 0 }];
+    for (let i = 0; i < 10; ++i) {
+        for (const object of objects) {
+            setX(object, i);
+            expect(object.x).toBe(i);
+        }
+    }
+});
+
+test("writes to non-writable and frozen properties", () => {
+    const object = { x: 1 };
+    for (let i = 0; i < 10; ++i) setX(object, i);
+    expect(object.x).toBe(9);
+
+    Object.freeze(object);
+    for (let i = 0; i < 10; ++i) setX(object, 42);
+    expect(object.x).toBe(9);
+
+    expect(() => {
+        "use strict";
+        const frozen = Object.freeze({ x: 1 });
+        for (let i = 0; i < 10; ++i) frozen.x = 2;
+    }).toThrow(TypeError);
+});
+
+test("writes go through setters", () => {
+    let setterCalls = 0;
+    const object = {
+        set x(value) {
+            ++setterCalls;
+        },
+    };
+    for (let i = 0; i < 10; ++i) setX(object, i);
+    expect(setterCalls).toBe(10);
+});
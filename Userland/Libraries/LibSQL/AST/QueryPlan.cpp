@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibSQL/AST/QueryPlan.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/Row.h>
+
+namespace SQL::AST {
+
+static NonnullRefPtr<TupleDescriptor> concatenate_descriptors(TupleDescriptor const& first, TupleDescriptor const& second)
+{
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    descriptor->extend(first);
+    descriptor->extend(second);
+    return descriptor;
+}
+
+static Tuple concatenate_rows(NonnullRefPtr<TupleDescriptor> const& descriptor, Tuple const& first, Tuple const& second)
+{
+    Tuple row(descriptor);
+    for (size_t i = 0; i < first.size(); ++i)
+        row[i] = first[i];
+    for (size_t i = 0; i < second.size(); ++i)
+        row[first.size() + i] = second[i];
+    return row;
+}
+
+SingleRow::SingleRow()
+    : QueryPlanNode(adopt_ref(*new TupleDescriptor))
+{
+}
+
+ResultOr<Optional<Tuple>> SingleRow::next(ExecutionContext&)
+{
+    if (m_done)
+        return Optional<Tuple> {};
+
+    m_done = true;
+    return Tuple { descriptor() };
+}
+
+TableScan::TableScan(NonnullRefPtr<TableDef> table)
+    : QueryPlanNode(table->to_tuple_descriptor())
+    , m_table(move(table))
+    , m_next_pointer(m_table->pointer())
+{
+}
+
+ResultOr<Optional<Tuple>> TableScan::next(ExecutionContext& context)
+{
+    if (m_next_pointer == 0)
+        return Optional<Tuple> {};
+
+    auto table_row = context.database->read_row(*m_table, m_next_pointer);
+    m_next_pointer = table_row.next_pointer();
+
+    // The descriptor of a row read from the database doesn't know which table it belongs to, which is needed
+    // to resolve qualified column names.
+    Tuple row(descriptor());
+    for (size_t i = 0; i < table_row.size(); ++i)
+        row[i] = table_row[i];
+    return row;
+}
+
+Filter::Filter(NonnullOwnPtr<QueryPlanNode> input, NonnullRefPtr<Expression const> predicate, PredicateType predicate_type)
+    : QueryPlanNode(input->descriptor())
+    , m_input(move(input))
+    , m_predicate(move(predicate))
+    , m_predicate_type(predicate_type)
+{
+}
+
+ResultOr<Optional<Tuple>> Filter::next(ExecutionContext& context)
+{
+    while (true) {
+        auto row = TRY(m_input->next(context));
+        if (!row.has_value())
+            return Optional<Tuple> {};
+
+        context.current_row = &row.value();
+        auto result = TRY(m_predicate->evaluate(context)).to_bool();
+        context.current_row = nullptr;
+
+        if (!result.has_value()) {
+            if (m_predicate_type == PredicateType::Conjunct)
+                return Result { SQLCommand::Unknown, SQLErrorCode::BooleanOperatorTypeMismatch, BinaryOperator_name(BinaryOperator::And) };
+            continue;
+        }
+        if (result.value())
+            return row;
+    }
+}
+
+NestedLoopJoin::NestedLoopJoin(NonnullOwnPtr<QueryPlanNode> outer, NonnullOwnPtr<QueryPlanNode> inner)
+    : QueryPlanNode(concatenate_descriptors(outer->descriptor(), inner->descriptor()))
+    , m_outer(move(outer))
+    , m_inner(move(inner))
+{
+}
+
+ResultOr<Optional<Tuple>> NestedLoopJoin::next(ExecutionContext& context)
+{
+    if (!m_inner_rows_loaded) {
+        while (true) {
+            auto row = TRY(m_inner->next(context));
+            if (!row.has_value())
+                break;
+            TRY(m_inner_rows.try_append(row.release_value()));
+        }
+        m_inner_rows_loaded = true;
+    }
+
+    if (m_inner_rows.is_empty())
+        return Optional<Tuple> {};
+
+    if (!m_outer_row.has_value() || m_inner_index == m_inner_rows.size()) {
+        m_outer_row = TRY(m_outer->next(context));
+        if (!m_outer_row.has_value())
+            return Optional<Tuple> {};
+        m_inner_index = 0;
+    }
+
+    return concatenate_rows(descriptor(), *m_outer_row, m_inner_rows[m_inner_index++]);
+}
+
+HashJoin::HashJoin(NonnullOwnPtr<QueryPlanNode> outer, size_t outer_column, NonnullOwnPtr<QueryPlanNode> inner, size_t inner_column)
+    : QueryPlanNode(concatenate_descriptors(outer->descriptor(), inner->descriptor()))
+    , m_outer(move(outer))
+    , m_outer_column(outer_column)
+    , m_inner(move(inner))
+    , m_inner_column(inner_column)
+{
+}
+
+ResultOr<void> HashJoin::load_inner_rows(ExecutionContext& context)
+{
+    while (true) {
+        auto row = TRY(m_inner->next(context));
+        if (!row.has_value())
+            break;
+
+        auto const& value = row.value()[m_inner_column];
+
+        // NULL never equals anything, so these rows can't be part of the result.
+        if (value.is_null())
+            continue;
+
+        auto& rows = m_inner_rows_by_hash.ensure(value.hash());
+        TRY(rows.try_append(m_inner_rows.size()));
+        TRY(m_inner_rows.try_append(row.release_value()));
+    }
+
+    m_inner_rows_loaded = true;
+    return {};
+}
+
+ResultOr<Optional<Tuple>> HashJoin::next(ExecutionContext& context)
+{
+    if (!m_inner_rows_loaded)
+        TRY(load_inner_rows(context));
+
+    if (m_inner_rows.is_empty())
+        return Optional<Tuple> {};
+
+    while (true) {
+        if (m_candidates) {
+            auto const& outer_value = (*m_outer_row)[m_outer_column];
+
+            while (m_candidate_index < m_candidates->size()) {
+                auto const& inner_row = m_inner_rows[(*m_candidates)[m_candidate_index++]];
+                if (outer_value.compare(inner_row[m_inner_column]) == 0)
+                    return concatenate_rows(descriptor(), *m_outer_row, inner_row);
+            }
+        }
+
+        m_outer_row = TRY(m_outer->next(context));
+        if (!m_outer_row.has_value())
+            return Optional<Tuple> {};
+
+        auto const& outer_value = (*m_outer_row)[m_outer_column];
+        m_candidates = nullptr;
+        m_candidate_index = 0;
+
+        if (!outer_value.is_null()) {
+            if (auto it = m_inner_rows_by_hash.find(outer_value.hash()); it != m_inner_rows_by_hash.end())
+                m_candidates = &it->value;
+        }
+    }
+}
+
+Sort::Sort(NonnullOwnPtr<QueryPlanNode> input, NonnullRefPtrVector<OrderingTerm> const& ordering_terms)
+    : QueryPlanNode(input->descriptor())
+    , m_input(move(input))
+    , m_ordering_terms(ordering_terms)
+{
+}
+
+ResultOr<void> Sort::sort_rows(ExecutionContext& context)
+{
+    auto sort_descriptor = adopt_ref(*new TupleDescriptor);
+    for (auto& term : m_ordering_terms)
+        sort_descriptor->append(TupleElementDescriptor { .order = term.order() });
+
+    struct SortEntry {
+        Tuple row;
+        Tuple sort_key;
+        size_t index { 0 };
+    };
+    Vector<SortEntry> entries;
+
+    while (true) {
+        auto row = TRY(m_input->next(context));
+        if (!row.has_value())
+            break;
+
+        Tuple sort_key(sort_descriptor);
+        context.current_row = &row.value();
+        for (size_t i = 0; i < m_ordering_terms.size(); ++i)
+            sort_key[i] = TRY(m_ordering_terms[i].expression()->evaluate(context));
+        context.current_row = nullptr;
+
+        TRY(entries.try_append({ row.release_value(), move(sort_key), entries.size() }));
+    }
+
+    // Rows with equal sort keys keep the order in which they were produced.
+    quick_sort(entries, [](auto const& a, auto const& b) {
+        if (auto result = a.sort_key.compare(b.sort_key); result != 0)
+            return result < 0;
+        return a.index < b.index;
+    });
+
+    TRY(m_rows.try_ensure_capacity(entries.size()));
+    for (auto& entry : entries)
+        m_rows.unchecked_append(move(entry.row));
+
+    m_rows_sorted = true;
+    return {};
+}
+
+ResultOr<Optional<Tuple>> Sort::next(ExecutionContext& context)
+{
+    if (!m_rows_sorted)
+        TRY(sort_rows(context));
+
+    if (m_index == m_rows.size())
+        return Optional<Tuple> {};
+    return move(m_rows[m_index++]);
+}
+
+Limit::Limit(NonnullOwnPtr<QueryPlanNode> input, size_t offset, size_t limit)
+    : QueryPlanNode(input->descriptor())
+    , m_input(move(input))
+    , m_offset(offset)
+    , m_limit(limit)
+{
+}
+
+ResultOr<Optional<Tuple>> Limit::next(ExecutionContext& context)
+{
+    for (; m_offset > 0; --m_offset) {
+        if (!TRY(m_input->next(context)).has_value())
+            return Optional<Tuple> {};
+    }
+
+    if (m_limit == 0)
+        return Optional<Tuple> {};
+
+    --m_limit;
+    return m_input->next(context);
+}
+
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Result.h>
+#include <LibSQL/Tuple.h>
+
+namespace SQL::AST {
+
+/**
+ * A query plan is a tree of nodes which produce rows one at a time when asked
+ * to by their parent (the "Volcano" model). A SELECT statement pulls rows from
+ * the root of its plan until it is exhausted, so rows that are filtered out or
+ * cut off by a LIMIT clause are never collected, and joins don't have to build
+ * the cartesian product of their inputs up front.
+ */
+class QueryPlanNode {
+public:
+    virtual ~QueryPlanNode() = default;
+
+    NonnullRefPtr<TupleDescriptor> const& descriptor() const { return m_descriptor; }
+
+    // Returns the next row, or an empty Optional once all rows have been produced.
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) = 0;
+
+protected:
+    explicit QueryPlanNode(NonnullRefPtr<TupleDescriptor> descriptor)
+        : m_descriptor(move(descriptor))
+    {
+    }
+
+private:
+    NonnullRefPtr<TupleDescriptor> m_descriptor;
+};
+
+// Produces a single row without any columns, for SELECT statements without tables.
+class SingleRow final : public QueryPlanNode {
+public:
+    SingleRow();
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    bool m_done { false };
+};
+
+// Reads the rows of a table from the database one at a time.
+class TableScan final : public QueryPlanNode {
+public:
+    explicit TableScan(NonnullRefPtr<TableDef>);
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    NonnullRefPtr<TableDef> m_table;
+    u32 m_next_pointer { 0 };
+};
+
+class Filter final : public QueryPlanNode {
+public:
+    enum class PredicateType {
+        // Rows for which the predicate isn't a boolean are skipped.
+        WhereClause,
+        // The predicate is one operand of an AND in the WHERE clause, so it has to be a boolean.
+        Conjunct,
+    };
+
+    Filter(NonnullOwnPtr<QueryPlanNode>, NonnullRefPtr<Expression const> predicate, PredicateType);
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    NonnullOwnPtr<QueryPlanNode> m_input;
+    NonnullRefPtr<Expression const> m_predicate;
+    PredicateType m_predicate_type;
+};
+
+// Joins every row of the outer input with every row of the inner input. The inner
+// input is read into memory once, the outer input is streamed.
+class NestedLoopJoin final : public QueryPlanNode {
+public:
+    NestedLoopJoin(NonnullOwnPtr<QueryPlanNode> outer, NonnullOwnPtr<QueryPlanNode> inner);
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    NonnullOwnPtr<QueryPlanNode> m_outer;
+    NonnullOwnPtr<QueryPlanNode> m_inner;
+    Vector<Tuple> m_inner_rows;
+    bool m_inner_rows_loaded { false };
+    Optional<Tuple> m_outer_row;
+    size_t m_inner_index { 0 };
+};
+
+// Joins the rows of its inputs for which a column of the outer input equals a column
+// of the inner input. The inner input is read into a hash table keyed by its column,
+// which the rows of the outer input are then looked up in as they are streamed.
+class HashJoin final : public QueryPlanNode {
+public:
+    HashJoin(NonnullOwnPtr<QueryPlanNode> outer, size_t outer_column, NonnullOwnPtr<QueryPlanNode> inner, size_t inner_column);
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    ResultOr<void> load_inner_rows(ExecutionContext&);
+
+    NonnullOwnPtr<QueryPlanNode> m_outer;
+    size_t m_outer_column { 0 };
+    NonnullOwnPtr<QueryPlanNode> m_inner;
+    size_t m_inner_column { 0 };
+
+    Vector<Tuple> m_inner_rows;
+    HashMap<u32, Vector<size_t>> m_inner_rows_by_hash;
+    bool m_inner_rows_loaded { false };
+
+    Optional<Tuple> m_outer_row;
+    Vector<size_t> const* m_candidates { nullptr };
+    size_t m_candidate_index { 0 };
+};
+
+class Sort final : public QueryPlanNode {
+public:
+    Sort(NonnullOwnPtr<QueryPlanNode>, NonnullRefPtrVector<OrderingTerm> const&);
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    ResultOr<void> sort_rows(ExecutionContext&);
+
+    NonnullOwnPtr<QueryPlanNode> m_input;
+    NonnullRefPtrVector<OrderingTerm> m_ordering_terms;
+    Vector<Tuple> m_rows;
+    bool m_rows_sorted { false };
+    size_t m_index { 0 };
+};
+
+// Skips the first rows of its input, and stops reading it after the rest of the limit has been produced.
+class Limit final : public QueryPlanNode {
+public:
+    Limit(NonnullOwnPtr<QueryPlanNode>, size_t offset, size_t limit);
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+private:
+    NonnullOwnPtr<QueryPlanNode> m_input;
+    size_t m_offset { 0 };
+    size_t m_limit { 0 };
+};
+
+}
@@ -6,6 +6,7 @@
 
 #include <AK/NumericLimits.h>
 #include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/QueryPlan.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Meta.h>
 #include <LibSQL/Row.h>
@@ -37,6 +38,243 @@ static DeprecatedString result_column_name(ResultColumn const& column, size_t co
     return fallback_column_name();
 }
 
+struct ColumnLocation {
+    size_t table_index { 0 };
+    size_t column_index { 0 };
+};
+
+// Finds the column a column name refers to, if it refers to exactly one column of the given tables.
+static Optional<ColumnLocation> locate_column(ColumnNameExpression const& column, NonnullRefPtrVector<TableDef> const& tables)
+{
+    Optional<ColumnLocation> location;
+
+    for (size_t table_index = 0; table_index < tables.size(); ++table_index) {
+        auto const& table = tables[table_index];
+        if (!column.table_name().is_empty() && table.name() != column.table_name())
+            continue;
+
+        for (size_t column_index = 0; column_index < table.columns().size(); ++column_index) {
+            if (table.columns()[column_index].name() != column.column_name())
+                continue;
+            if (location.has_value())
+                return {};
+            location = ColumnLocation { table_index, column_index };
+        }
+    }
+
+    return location;
+}
+
+struct TableRange {
+    Optional<size_t> first;
+    Optional<size_t> last;
+
+    void add(size_t table_index)
+    {
+        first = first.has_value() ? min(*first, table_index) : table_index;
+        last = last.has_value() ? max(*last, table_index) : table_index;
+    }
+};
+
+// Determines which of the tables an expression reads columns from. Returns false if that isn't known, because the
+// expression refers to a column that doesn't exist or is ambiguous, or contains a kind of expression we don't look into.
+static bool collect_referenced_tables(Expression const& expression, NonnullRefPtrVector<TableDef> const& tables, TableRange& range)
+{
+    if (is<NumericLiteral>(expression) || is<StringLiteral>(expression) || is<BlobLiteral>(expression) || is<BooleanLiteral>(expression) || is<NullLiteral>(expression) || is<Placeholder>(expression))
+        return true;
+
+    if (is<ColumnNameExpression>(expression)) {
+        auto location = locate_column(static_cast<ColumnNameExpression const&>(expression), tables);
+        if (!location.has_value())
+            return false;
+
+        range.add(location->table_index);
+        return true;
+    }
+
+    if (is<ChainedExpression>(expression)) {
+        for (auto const& element : static_cast<ChainedExpression const&>(expression).expressions()) {
+            if (!collect_referenced_tables(element, tables, range))
+                return false;
+        }
+        return true;
+    }
+
+    if (is<InSelectionExpression>(expression) || is<InTableExpression>(expression))
+        return false;
+
+    if (is<InChainedExpression>(expression)) {
+        auto const& in_chained_expression = static_cast<InChainedExpression const&>(expression);
+        return collect_referenced_tables(*in_chained_expression.expression(), tables, range)
+            && collect_referenced_tables(*in_chained_expression.expression_chain(), tables, range);
+    }
+
+    if (is<NestedExpression>(expression))
+        return collect_referenced_tables(*static_cast<NestedExpression const&>(expression).expression(), tables, range);
+
+    if (is<NestedDoubleExpression>(expression)) {
+        auto const& nested_double_expression = static_cast<NestedDoubleExpression const&>(expression);
+        if (!collect_referenced_tables(*nested_double_expression.lhs(), tables, range) || !collect_referenced_tables(*nested_double_expression.rhs(), tables, range))
+            return false;
+
+        if (is<MatchExpression>(expression)) {
+            if (auto const& escape = static_cast<MatchExpression const&>(expression).escape())
+                return collect_referenced_tables(*escape, tables, range);
+        } else if (is<BetweenExpression>(expression)) {
+            return collect_referenced_tables(*static_cast<BetweenExpression const&>(expression).expression(), tables, range);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+static void collect_conjuncts(NonnullRefPtr<Expression const> expression, Vector<NonnullRefPtr<Expression const>>& conjuncts)
+{
+    // Parentheses are parsed as a chained expression with a single element.
+    while (is<ChainedExpression>(*expression)) {
+        auto const& chained_expression = static_cast<ChainedExpression const&>(*expression);
+        if (chained_expression.expressions().size() != 1)
+            break;
+        expression = chained_expression.expressions().first();
+    }
+
+    if (is<BinaryOperatorExpression>(*expression)) {
+        auto const& binary_operator_expression = static_cast<BinaryOperatorExpression const&>(*expression);
+        if (binary_operator_expression.type() == BinaryOperator::And) {
+            collect_conjuncts(binary_operator_expression.lhs(), conjuncts);
+            collect_conjuncts(binary_operator_expression.rhs(), conjuncts);
+            return;
+        }
+    }
+
+    conjuncts.append(expression);
+}
+
+struct JoinColumns {
+    ColumnLocation outer;
+    ColumnLocation inner;
+};
+
+struct Conjunct {
+    NonnullRefPtr<Expression const> expression;
+    Optional<TableRange> tables;
+    bool is_planned { false };
+};
+
+// Checks whether the conjunct compares a column of one of the tables joined so far with a column of the next table, in a
+// way that a hash join can evaluate. Hashing has to agree with comparing values, so both columns must have the same type.
+static Optional<JoinColumns> hash_join_columns(Conjunct const& conjunct, NonnullRefPtrVector<TableDef> const& tables, size_t next_table_index)
+{
+    if (conjunct.is_planned || !is<BinaryOperatorExpression>(*conjunct.expression))
+        return {};
+
+    auto const& comparison = static_cast<BinaryOperatorExpression const&>(*conjunct.expression);
+    if (comparison.type() != BinaryOperator::Equals || !is<ColumnNameExpression>(*comparison.lhs()) || !is<ColumnNameExpression>(*comparison.rhs()))
+        return {};
+
+    auto lhs = locate_column(static_cast<ColumnNameExpression const&>(*comparison.lhs()), tables);
+    auto rhs = locate_column(static_cast<ColumnNameExpression const&>(*comparison.rhs()), tables);
+    if (!lhs.has_value() || !rhs.has_value())
+        return {};
+
+    if (lhs->table_index == next_table_index)
+        swap(lhs, rhs);
+    if (lhs->table_index >= next_table_index || rhs->table_index != next_table_index)
+        return {};
+
+    auto type = tables[lhs->table_index].columns()[lhs->column_index].type();
+    if (type != tables[rhs->table_index].columns()[rhs->column_index].type())
+        return {};
+    if (type != SQLType::Text && type != SQLType::Integer && type != SQLType::Boolean)
+        return {};
+
+    return JoinColumns { *lhs, *rhs };
+}
+
+// Plans the tables as a left-deep tree of joins in the order in which they are listed. Parts of the WHERE clause are
+// applied as soon as the tables they refer to are available, and equality between columns turns into a hash join.
+static NonnullOwnPtr<QueryPlanNode> create_plan(NonnullRefPtrVector<TableDef> const& tables, RefPtr<Expression> const& where_clause)
+{
+    if (tables.is_empty()) {
+        NonnullOwnPtr<QueryPlanNode> plan = make<SingleRow>();
+        if (where_clause)
+            plan = make<Filter>(move(plan), *where_clause, Filter::PredicateType::WhereClause);
+        return plan;
+    }
+
+    Vector<NonnullRefPtr<Expression const>> conjunct_expressions;
+    if (where_clause)
+        collect_conjuncts(*where_clause, conjunct_expressions);
+
+    auto predicate_type = conjunct_expressions.size() > 1 ? Filter::PredicateType::Conjunct : Filter::PredicateType::WhereClause;
+
+    Vector<Conjunct> conjuncts;
+    for (auto& expression : conjunct_expressions) {
+        TableRange range;
+        if (collect_referenced_tables(*expression, tables, range))
+            conjuncts.append({ expression, range });
+        else
+            conjuncts.append({ expression, {} });
+    }
+
+    auto apply_conjuncts = [&](NonnullOwnPtr<QueryPlanNode> plan, auto should_apply) {
+        for (auto& conjunct : conjuncts) {
+            if (conjunct.is_planned || !should_apply(conjunct))
+                continue;
+            plan = make<Filter>(move(plan), conjunct.expression, predicate_type);
+            conjunct.is_planned = true;
+        }
+        return plan;
+    };
+
+    auto scan_table = [&](size_t table_index) {
+        return apply_conjuncts(make<TableScan>(tables[table_index]), [&](Conjunct const& conjunct) {
+            if (!conjunct.tables.has_value())
+                return false;
+            auto const& range = *conjunct.tables;
+            if (!range.last.has_value())
+                return table_index == 0;
+            return range.first == table_index && range.last == table_index;
+        });
+    };
+
+    auto plan = scan_table(0);
+
+    for (size_t table_index = 1; table_index < tables.size(); ++table_index) {
+        auto table = scan_table(table_index);
+
+        Optional<JoinColumns> join_columns;
+        for (auto& conjunct : conjuncts) {
+            join_columns = hash_join_columns(conjunct, tables, table_index);
+            if (join_columns.has_value()) {
+                conjunct.is_planned = true;
+                break;
+            }
+        }
+
+        if (join_columns.has_value()) {
+            auto [outer_column, inner_column] = *join_columns;
+
+            // The rows of the outer side consist of the columns of all tables joined so far.
+            size_t outer_column_index = outer_column.column_index;
+            for (size_t i = 0; i < outer_column.table_index; ++i)
+                outer_column_index += tables[i].columns().size();
+
+            plan = make<HashJoin>(move(plan), outer_column_index, move(table), inner_column.column_index);
+        } else {
+            plan = make<NestedLoopJoin>(move(plan), move(table));
+        }
+
+        plan = apply_conjuncts(move(plan), [&](Conjunct const& conjunct) {
+            return conjunct.tables.has_value() && conjunct.tables->last == table_index;
+        });
+    }
+
+    return apply_conjuncts(move(plan), [](Conjunct const&) { return true; });
+}
+
 ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 {
     NonnullRefPtrVector<ResultColumn const> columns;
@@ -83,72 +321,17 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
         }
     }
 
-    ResultSet result { SQLCommand::Select, move(column_names) };
-
-    auto descriptor = adopt_ref(*new TupleDescriptor);
-    Tuple tuple(descriptor);
-    Vector<Tuple> rows;
-    descriptor->empend("__unity__"sv);
-    tuple.append(Value { true });
-    rows.append(tuple);
-
+    NonnullRefPtrVector<TableDef> tables;
     for (auto& table_descriptor : table_or_subquery_list()) {
-        if (!table_descriptor.is_table())
-            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
-
         auto table_def = TRY(context.database->get_table(table_descriptor.schema_name(), table_descriptor.table_name()));
-        if (table_def->num_columns() == 0)
-            continue;
-
-        auto old_descriptor_size = descriptor->size();
-        descriptor->extend(table_def->to_tuple_descriptor());
-
-        while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
-            auto cartesian_row = rows.take_first();
-            auto table_rows = TRY(context.database->select_all(*table_def));
-
-            for (auto& table_row : table_rows) {
-                auto new_row = cartesian_row;
-                new_row.extend(table_row);
-                rows.append(new_row);
-            }
-        }
+        if (table_def->num_columns() != 0)
+            tables.append(move(table_def));
     }
 
-    bool has_ordering { false };
-    auto sort_descriptor = adopt_ref(*new TupleDescriptor);
-    for (auto& term : m_ordering_term_list) {
-        sort_descriptor->append(TupleElementDescriptor { .order = term.order() });
-        has_ordering = true;
-    }
-    Tuple sort_key(sort_descriptor);
+    auto plan = create_plan(tables, where_clause());
 
-    for (auto& row : rows) {
-        context.current_row = &row;
-
-        if (where_clause()) {
-            auto where_result = TRY(where_clause()->evaluate(context)).to_bool();
-            if (!where_result.has_value() || !where_result.value())
-                continue;
-        }
-
-        tuple.clear();
-
-        for (auto& col : columns) {
-            auto value = TRY(col.expression()->evaluate(context));
-            tuple.append(value);
-        }
-
-        if (has_ordering) {
-            sort_key.clear();
-            for (auto& term : m_ordering_term_list) {
-                auto value = TRY(term.expression()->evaluate(context));
-                sort_key.append(value);
-            }
-        }
-
-        result.insert_row(tuple, sort_key);
-    }
+    if (!m_ordering_term_list.is_empty())
+        plan = make<Sort>(move(plan), m_ordering_term_list);
 
     if (m_limit_clause != nullptr) {
         size_t limit_value = NumericLimits<size_t>::max();
@@ -174,9 +357,30 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
             }
         }
 
-        result.limit(offset_value, limit_value);
+        plan = make<Limit>(move(plan), offset_value, limit_value);
+    }
+
+    ResultSet result { SQLCommand::Select, move(column_names) };
+    Tuple tuple(adopt_ref(*new TupleDescriptor));
+    Tuple sort_key;
+
+    while (true) {
+        auto row = TRY(plan->next(context));
+        if (!row.has_value())
+            break;
+
+        context.current_row = &row.value();
+        tuple.clear();
+
+        for (auto& col : columns) {
+            auto value = TRY(col.expression()->evaluate(context));
+            tuple.append(value);
+        }
+
+        result.insert_row(tuple, sort_key);
     }
 
+    context.current_row = nullptr;
     return result;
 }
 
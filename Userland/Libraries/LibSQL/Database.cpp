@@ -180,6 +180,11 @@ ErrorOr<Vector<Row>> Database::select_all(TableDef& table)
     return ret;
 }
 
+Row Database::read_row(TableDef& table, u32 pointer)
+{
+    return m_serializer.deserialize_block<Row>(pointer, table, pointer);
+}
+
 ErrorOr<Vector<Row>> Database::match(TableDef& table, Key const& key)
 {
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
@@ -42,6 +42,7 @@ public:
     ResultOr<NonnullRefPtr<TableDef>> get_table(DeprecatedString const&, DeprecatedString const&);
 
     ErrorOr<Vector<Row>> select_all(TableDef&);
+    Row read_row(TableDef&, u32 pointer);
     ErrorOr<Vector<Row>> match(TableDef&, Key const&);
     ErrorOr<void> insert(Row&);
     ErrorOr<void> remove(Row&);
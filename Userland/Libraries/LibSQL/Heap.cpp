@@ -7,12 +7,14 @@
 #include <AK/DeprecatedString.h>
 #include <AK/Format.h>
 #include <AK/QuickSort.h>
+#include <AK/StringHash.h>
 #include <LibCore/IODevice.h>
 #include <LibCore/System.h>
 #include <LibSQL/Heap.h>
 #include <LibSQL/Serializer.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 namespace SQL {
 
@@ -21,12 +23,43 @@ Heap::Heap(DeprecatedString file_name)
     set_name(move(file_name));
 }
 
+// Every frame in the write-ahead log holds one block, preceded by a header with the number of that block,
+// whether the frame ends a transaction, and a checksum to detect frames that were only partially written.
+constexpr static auto WAL_FRAME_BLOCK_OFFSET = 0;
+constexpr static auto WAL_FRAME_COMMIT_OFFSET = WAL_FRAME_BLOCK_OFFSET + sizeof(u32);
+constexpr static auto WAL_FRAME_CHECKSUM_OFFSET = WAL_FRAME_COMMIT_OFFSET + sizeof(u32);
+constexpr static auto WAL_FRAME_HEADER_SIZE = WAL_FRAME_CHECKSUM_OFFSET + sizeof(u32);
+constexpr static auto WAL_FRAME_SIZE = WAL_FRAME_HEADER_SIZE + BLOCKSIZE;
+
+static u32 wal_frame_checksum(u32 block, u32 is_commit, ReadonlyBytes data)
+{
+    return string_hash(reinterpret_cast<char const*>(data.data()), data.size(), pair_int_hash(block, is_commit));
+}
+
+static ErrorOr<void> sync_file(int fd)
+{
+    if (::fsync(fd) < 0)
+        return Error::from_syscall("fsync"sv, -errno);
+    return {};
+}
+
 Heap::~Heap()
 {
-    if (m_file && !m_write_ahead_log.is_empty()) {
-        if (auto maybe_error = flush(); maybe_error.is_error())
-            warnln("~Heap({}): {}", name(), maybe_error.error());
+    if (!m_file || !m_wal_file)
+        return;
+
+    if (auto maybe_error = flush(); maybe_error.is_error()) {
+        warnln("~Heap({}): {}", name(), maybe_error.error());
+        return;
+    }
+    if (auto maybe_error = checkpoint(); maybe_error.is_error()) {
+        warnln("~Heap({}): {}", name(), maybe_error.error());
+        return;
     }
+
+    m_wal_file = nullptr;
+    if (auto maybe_error = Core::System::unlink(wal_file_name()); maybe_error.is_error())
+        warnln("~Heap({}): {}", name(), maybe_error.error());
 }
 
 ErrorOr<void> Heap::open()
@@ -48,6 +81,7 @@ ErrorOr<void> Heap::open()
         m_next_block = m_end_of_file = file_size / BLOCKSIZE;
 
     auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
+    m_file_fd = file->fd();
     m_file = TRY(Core::BufferedFile::create(move(file)));
 
     if (file_size > 0) {
@@ -55,14 +89,33 @@ ErrorOr<void> Heap::open()
             m_file = nullptr;
             return error_maybe.release_error();
         }
+    }
+
+    // A log without a heap file is left over from a database that has been deleted since.
+    if (auto error_maybe = open_wal(file_size == 0); error_maybe.is_error()) {
+        m_file = nullptr;
+        return error_maybe.release_error();
+    }
+
+    if (file_size > 0) {
+        TRY(recover_from_wal());
+        TRY(read_zero_block());
     } else {
+        // Write the zero block right away, so the next open() can tell that this is a heap file.
         initialize_zero_block();
+        TRY(flush());
+        TRY(checkpoint());
     }
 
     // FIXME: We should more gracefully handle version incompatibilities. For now, we drop the database.
     if (m_version != current_version) {
         dbgln_if(SQL_DEBUG, "Heap file {} opened has incompatible version {}. Deleting for version {}.", name(), m_version, current_version);
         m_file = nullptr;
+        m_wal_file = nullptr;
+        m_wal_size = 0;
+        m_wal_frame_offsets.clear();
+        clear_cache();
+        m_next_block = m_end_of_file = 1;
 
         TRY(Core::System::unlink(name()));
         return open();
@@ -79,23 +132,32 @@ ErrorOr<ByteBuffer> Heap::read_block(u32 block)
         return Error::from_string_literal("Heap()::read_block(): Heap file not opened");
     }
 
-    if (auto buffer = m_write_ahead_log.get(block); buffer.has_value())
-        return TRY(ByteBuffer::copy(*buffer));
+    if (auto it = m_cache.find(block); it != m_cache.end()) {
+        it->value.is_referenced = true;
+        return TRY(ByteBuffer::copy(it->value.buffer));
+    }
 
     if (block >= m_next_block) {
         warnln("Heap({})::read_block({}): block # out of range (>= {})"sv, name(), block, m_next_block);
         return Error::from_string_literal("Heap()::read_block(): block # out of range");
     }
 
-    dbgln_if(SQL_DEBUG, "Read heap block {}", block);
-    TRY(seek_block(block));
+    ByteBuffer buffer;
+    if (auto offset = m_wal_frame_offsets.get(block); offset.has_value()) {
+        dbgln_if(SQL_DEBUG, "Read heap block {} from WAL", block);
+        buffer = TRY(read_wal_frame(*offset));
+    } else {
+        dbgln_if(SQL_DEBUG, "Read heap block {}", block);
+        TRY(seek_block(block));
 
-    auto buffer = TRY(ByteBuffer::create_uninitialized(BLOCKSIZE));
-    auto bytes = TRY(m_file->read(buffer));
+        buffer = TRY(ByteBuffer::create_uninitialized(BLOCKSIZE));
+        auto bytes = TRY(m_file->read(buffer));
 
-    dbgln_if(SQL_DEBUG, "{:hex-dump}", bytes.trim(8));
-    TRY(buffer.try_resize(bytes.size()));
+        dbgln_if(SQL_DEBUG, "{:hex-dump}", bytes.trim(8));
+        TRY(buffer.try_resize(bytes.size()));
+    }
 
+    cache_block(block, TRY(ByteBuffer::copy(buffer)), false);
     return buffer;
 }
 
@@ -166,22 +228,247 @@ u32 Heap::new_record_pointer()
     return m_next_block++;
 }
 
+void Heap::add_to_wal(u32 block, ByteBuffer& buffer)
+{
+    dbgln_if(SQL_DEBUG, "Adding to WAL: block #{}, size {}", block, buffer.size());
+    dbgln_if(SQL_DEBUG, "{:hex-dump}", buffer.bytes().trim(8));
+    cache_block(block, buffer, true);
+}
+
 ErrorOr<void> Heap::flush()
 {
     VERIFY(m_file);
     Vector<u32> blocks;
-    for (auto& wal_entry : m_write_ahead_log) {
-        blocks.append(wal_entry.key);
+    for (auto& cached_block : m_cache) {
+        if (cached_block.value.is_dirty)
+            blocks.append(cached_block.key);
     }
+    if (blocks.is_empty() && !m_wal_has_uncommitted_frames)
+        return {};
+
     quick_sort(blocks);
-    for (auto& block : blocks) {
-        auto buffer_it = m_write_ahead_log.find(block);
-        VERIFY(buffer_it != m_write_ahead_log.end());
-        dbgln_if(SQL_DEBUG, "Flushing block {} to {}", block, name());
-        TRY(write_block(block, buffer_it->value));
-    }
-    m_write_ahead_log.clear();
-    dbgln_if(SQL_DEBUG, "WAL flushed. Heap size = {}", size());
+    if (blocks.is_empty()) {
+        // All modified blocks were evicted to the log already, so only the end of the transaction needs to be marked.
+        auto buffer = TRY(read_block(0));
+        TRY(append_wal_frame(0, buffer, true));
+    }
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        auto it = m_cache.find(blocks[i]);
+        VERIFY(it != m_cache.end());
+        dbgln_if(SQL_DEBUG, "Flushing block {} to {}", blocks[i], wal_file_name());
+        TRY(append_wal_frame(blocks[i], it->value.buffer, i == blocks.size() - 1));
+    }
+    TRY(sync_file(m_wal_file->fd()));
+
+    for (auto block : blocks)
+        m_cache.find(block)->value.is_dirty = false;
+    dbgln_if(SQL_DEBUG, "WAL flushed. Heap size = {}, WAL frames = {}", size(), wal_frame_count());
+
+    if (wal_frame_count() >= wal_checkpoint_threshold)
+        TRY(checkpoint());
+    return {};
+}
+
+void Heap::set_cache_size(size_t cache_size)
+{
+    VERIFY(cache_size > 0);
+    // Blocks over the new limit are evicted the next time a block is added to the cache.
+    m_cache_size = cache_size;
+}
+
+size_t Heap::wal_frame_count() const
+{
+    return m_wal_size / WAL_FRAME_SIZE;
+}
+
+void Heap::cache_block(u32 block, ByteBuffer buffer, bool is_dirty)
+{
+    if (auto it = m_cache.find(block); it != m_cache.end()) {
+        it->value.buffer = move(buffer);
+        it->value.is_dirty |= is_dirty;
+        it->value.is_referenced = true;
+        return;
+    }
+
+    while (!m_clock.is_empty() && m_clock.size() >= m_cache_size) {
+        auto slot = find_eviction_candidate();
+        if (auto result = evict_block(m_clock[slot]); result.is_error()) {
+            // The cache is allowed to grow beyond its size rather than lose a modified block.
+            warnln("Heap({})::cache_block({}): Could not evict block {}: {}"sv, name(), block, m_clock[slot], result.error());
+            break;
+        }
+
+        if (m_clock.size() == m_cache_size) {
+            m_clock[slot] = block;
+            m_cache.set(block, { move(buffer), is_dirty });
+            return;
+        }
+
+        m_clock.remove(slot);
+        if (m_clock_hand > slot)
+            --m_clock_hand;
+    }
+
+    m_clock.append(block);
+    m_cache.set(block, { move(buffer), is_dirty });
+}
+
+size_t Heap::find_eviction_candidate()
+{
+    VERIFY(!m_clock.is_empty());
+
+    // Blocks that were used since the hand last passed them get a second chance. Since the hand clears
+    // the referenced flag as it goes, it finds a block within two turns at the most.
+    while (true) {
+        if (m_clock_hand >= m_clock.size())
+            m_clock_hand = 0;
+
+        auto slot = m_clock_hand++;
+        auto it = m_cache.find(m_clock[slot]);
+        VERIFY(it != m_cache.end());
+        if (!it->value.is_referenced)
+            return slot;
+        it->value.is_referenced = false;
+    }
+}
+
+ErrorOr<void> Heap::evict_block(u32 block)
+{
+    auto it = m_cache.find(block);
+    VERIFY(it != m_cache.end());
+
+    // A modified block can't go into the heap file before it's committed, so it's parked in the log instead.
+    if (it->value.is_dirty) {
+        dbgln_if(SQL_DEBUG, "Evicting modified block {} to {}", block, wal_file_name());
+        TRY(append_wal_frame(block, it->value.buffer, false));
+    }
+
+    m_cache.remove(it);
+    return {};
+}
+
+void Heap::clear_cache()
+{
+    m_cache.clear();
+    m_clock.clear();
+    m_clock_hand = 0;
+}
+
+ErrorOr<void> Heap::open_wal(bool discard_existing_wal)
+{
+    m_wal_file = TRY(Core::File::open(wal_file_name(), Core::File::OpenMode::ReadWrite));
+    if (discard_existing_wal)
+        TRY(m_wal_file->truncate(0));
+    m_wal_size = TRY(m_wal_file->seek(0, SeekMode::FromEndPosition));
+    m_wal_frame_offsets.clear();
+    m_wal_has_uncommitted_frames = false;
+    return {};
+}
+
+ErrorOr<void> Heap::append_wal_frame(u32 block, ByteBuffer const& buffer, bool is_commit)
+{
+    VERIFY(m_wal_file);
+    VERIFY(buffer.size() <= BLOCKSIZE);
+
+    auto frame = TRY(ByteBuffer::create_zeroed(WAL_FRAME_SIZE));
+    frame.overwrite(WAL_FRAME_HEADER_SIZE, buffer.data(), buffer.size());
+
+    u32 commit = is_commit ? 1 : 0;
+    u32 checksum = wal_frame_checksum(block, commit, frame.bytes().slice(WAL_FRAME_HEADER_SIZE));
+    frame.overwrite(WAL_FRAME_BLOCK_OFFSET, &block, sizeof(u32));
+    frame.overwrite(WAL_FRAME_COMMIT_OFFSET, &commit, sizeof(u32));
+    frame.overwrite(WAL_FRAME_CHECKSUM_OFFSET, &checksum, sizeof(u32));
+
+    TRY(m_wal_file->seek(m_wal_size, SeekMode::SetPosition));
+    TRY(m_wal_file->write_entire_buffer(frame));
+
+    m_wal_frame_offsets.set(block, m_wal_size);
+    m_wal_size += WAL_FRAME_SIZE;
+    m_wal_has_uncommitted_frames = !is_commit;
+    return {};
+}
+
+ErrorOr<ByteBuffer> Heap::read_wal_frame(u64 offset)
+{
+    VERIFY(m_wal_file);
+    auto buffer = TRY(ByteBuffer::create_uninitialized(BLOCKSIZE));
+    TRY(m_wal_file->seek(offset + WAL_FRAME_HEADER_SIZE, SeekMode::SetPosition));
+    TRY(m_wal_file->read_entire_buffer(buffer));
+    return buffer;
+}
+
+ErrorOr<void> Heap::recover_from_wal()
+{
+    HashMap<u32, u64> committed_frame_offsets;
+    HashMap<u32, u64> pending_frame_offsets;
+    u64 committed_size = 0;
+
+    auto frame = TRY(ByteBuffer::create_uninitialized(WAL_FRAME_SIZE));
+    TRY(m_wal_file->seek(0, SeekMode::SetPosition));
+    for (u64 offset = 0; offset + WAL_FRAME_SIZE <= m_wal_size; offset += WAL_FRAME_SIZE) {
+        TRY(m_wal_file->read_entire_buffer(frame));
+
+        u32 block;
+        u32 commit;
+        u32 checksum;
+        memcpy(&block, frame.offset_pointer(WAL_FRAME_BLOCK_OFFSET), sizeof(u32));
+        memcpy(&commit, frame.offset_pointer(WAL_FRAME_COMMIT_OFFSET), sizeof(u32));
+        memcpy(&checksum, frame.offset_pointer(WAL_FRAME_CHECKSUM_OFFSET), sizeof(u32));
+
+        // A frame that was torn by a crash ends the log.
+        if (commit > 1 || checksum != wal_frame_checksum(block, commit, frame.bytes().slice(WAL_FRAME_HEADER_SIZE)))
+            break;
+
+        pending_frame_offsets.set(block, offset);
+        if (commit) {
+            for (auto& pending_frame : pending_frame_offsets)
+                committed_frame_offsets.set(pending_frame.key, pending_frame.value);
+            pending_frame_offsets.clear();
+            committed_size = offset + WAL_FRAME_SIZE;
+        }
+    }
+
+    // Frames after the last commit belong to a transaction that never finished, so they're dropped.
+    if (committed_size != m_wal_size) {
+        dbgln_if(SQL_DEBUG, "Discarding {} uncommitted bytes from {}", m_wal_size - committed_size, wal_file_name());
+        TRY(m_wal_file->truncate(committed_size));
+        m_wal_size = committed_size;
+    }
+    if (committed_frame_offsets.is_empty())
+        return {};
+
+    dbgln_if(SQL_DEBUG, "Recovering {} blocks from {}", committed_frame_offsets.size(), wal_file_name());
+    m_wal_frame_offsets = move(committed_frame_offsets);
+    for (auto& frame_offset : m_wal_frame_offsets)
+        m_next_block = max(m_next_block, frame_offset.key + 1);
+
+    TRY(checkpoint());
+    clear_cache();
+    return {};
+}
+
+ErrorOr<void> Heap::checkpoint()
+{
+    VERIFY(!m_wal_has_uncommitted_frames);
+    if (m_wal_size == 0)
+        return {};
+
+    Vector<u32> blocks;
+    for (auto& frame_offset : m_wal_frame_offsets)
+        blocks.append(frame_offset.key);
+    quick_sort(blocks);
+
+    dbgln_if(SQL_DEBUG, "Checkpointing {} blocks from {}", blocks.size(), wal_file_name());
+    for (auto block : blocks) {
+        auto buffer = TRY(read_wal_frame(*m_wal_frame_offsets.get(block)));
+        TRY(write_block(block, buffer));
+    }
+
+    // The log can only be discarded once the heap file is known to hold everything that was in it.
+    TRY(sync_file(m_file_fd));
+    TRY(m_wal_file->truncate(0));
+    m_wal_size = 0;
+    m_wal_frame_offsets.clear();
     return {};
 }
 
@@ -28,12 +28,22 @@ constexpr static u32 BLOCKSIZE = 1024;
  * assumed that a single SQL database is backed by a single Heap.
  *
  * Currently only B-Trees and tuple stores are implemented.
+ *
+ * Blocks are read and written through a page cache of bounded size, which
+ * evicts blocks using the CLOCK algorithm. Modified blocks are appended to a
+ * write-ahead log next to the heap file, either when they're evicted from the
+ * cache or when they're committed by flush(). Once the log has grown large
+ * enough, a checkpoint copies the most recent version of every block in it
+ * into the heap file. When a heap is opened, the transactions that were
+ * committed to the log but not checkpointed yet are recovered.
  */
 class Heap : public Core::Object {
     C_OBJECT(Heap);
 
 public:
     static constexpr inline u32 current_version = 3;
+    static constexpr inline size_t default_cache_size = 1024;
+    static constexpr inline size_t wal_checkpoint_threshold = 1024;
 
     virtual ~Heap() override;
 
@@ -81,25 +91,48 @@ public:
         update_zero_block();
     }
 
-    void add_to_wal(u32 block, ByteBuffer& buffer)
-    {
-        dbgln_if(SQL_DEBUG, "Adding to WAL: block #{}, size {}", block, buffer.size());
-        dbgln_if(SQL_DEBUG, "{:hex-dump}", buffer.bytes().trim(8));
-        m_write_ahead_log.set(block, buffer);
-    }
+    // Writes the block into the page cache. It only becomes durable once it is committed by flush().
+    void add_to_wal(u32 block, ByteBuffer& buffer);
 
+    // Commits all blocks written so far to the write-ahead log.
     ErrorOr<void> flush();
 
+    // The maximum number of blocks kept in the page cache.
+    size_t cache_size() const { return m_cache_size; }
+    void set_cache_size(size_t);
+    size_t cached_block_count() const { return m_cache.size(); }
+
+    DeprecatedString wal_file_name() const { return DeprecatedString::formatted("{}-wal", name()); }
+    size_t wal_frame_count() const;
+
 private:
     explicit Heap(DeprecatedString);
 
+    struct CachedBlock {
+        ByteBuffer buffer;
+        bool is_dirty { false };
+        bool is_referenced { true };
+    };
+
     ErrorOr<void> write_block(u32, ByteBuffer&);
     ErrorOr<void> seek_block(u32);
     ErrorOr<void> read_zero_block();
     void initialize_zero_block();
     void update_zero_block();
 
+    void cache_block(u32 block, ByteBuffer buffer, bool is_dirty);
+    size_t find_eviction_candidate();
+    ErrorOr<void> evict_block(u32 block);
+    void clear_cache();
+
+    ErrorOr<void> open_wal(bool discard_existing_wal);
+    ErrorOr<void> append_wal_frame(u32 block, ByteBuffer const&, bool is_commit);
+    ErrorOr<ByteBuffer> read_wal_frame(u64 offset);
+    ErrorOr<void> recover_from_wal();
+    ErrorOr<void> checkpoint();
+
     OwnPtr<Core::BufferedFile> m_file;
+    int m_file_fd { -1 };
     u32 m_free_list { 0 };
     u32 m_next_block { 1 };
     u32 m_end_of_file { 1 };
@@ -108,7 +141,16 @@ private:
     u32 m_table_columns_root { 0 };
     u32 m_version { current_version };
     Array<u32, 16> m_user_values { 0 };
-    HashMap<u32, ByteBuffer> m_write_ahead_log;
+
+    HashMap<u32, CachedBlock> m_cache;
+    Vector<u32> m_clock;
+    size_t m_clock_hand { 0 };
+    size_t m_cache_size { default_cache_size };
+
+    OwnPtr<Core::File> m_wal_file;
+    u64 m_wal_size { 0 };
+    HashMap<u32, u64> m_wal_frame_offsets;
+    bool m_wal_has_uncommitted_frames { false };
 };
 
 }
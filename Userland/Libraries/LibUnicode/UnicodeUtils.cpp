@@ -234,6 +234,10 @@ ErrorOr<void> build_lowercase_string([[maybe_unused]] Utf8View code_points, [[ma
 
     return {};
 #else
+    for (auto code_point : code_points) TRY(builder.try_append_code_point(to_ascii_lowercase(code_point)));
+    return {};
+#endif
+#if 0
     return Error::from_string_literal("Unicode data has been disabled");
 #endif
 }
@@ -261,6 +265,10 @@ ErrorOr<void> build_uppercase_string([[maybe_unused]] Utf8View code_points, [[ma
 
     return {};
 #else
+    for (auto code_point : code_points) TRY(builder.try_append_code_point(to_ascii_uppercase(code_point)));
+    return {};
+#endif
+#if 0
     return Error::from_string_literal("Unicode data has been disabled");
 #endif
 }
@@ -353,6 +361,10 @@ ErrorOr<void> build_casefold_string([[maybe_unused]] Utf8View code_points, [[may
 
     return {};
 #else
+    for (auto code_point : code_points) TRY(builder.try_append_code_point(to_ascii_lowercase(code_point)));
+    return {};
+#endif
+#if 0
     return Error::from_string_literal("Unicode data has been disabled");
 #endif
 }
@@ -4,15 +4,87 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/System.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/AbstractMachine/GuardPages.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Types.h>
+#include <sys/mman.h>
 
 namespace Wasm {
 
+ErrorOr<MemoryInstance> MemoryInstance::create(MemoryType const& type, Backing backing)
+{
+    MemoryInstance instance { type };
+
+    if (backing == Backing::GuardPages) {
+        if constexpr (sizeof(FlatPtr) < sizeof(u64))
+            return Error::from_string_literal("Guard pages need a 64-bit address space");
+        TRY(GuardPageFaultScope::install_fault_handler());
+        auto* reservation = TRY(Core::System::mmap(nullptr, Constants::guard_page_memory_reservation_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0, 0, "Wasm memory"sv));
+        instance.m_reservation = static_cast<u8*>(reservation);
+    }
+
+    if (!instance.grow(type.limits().min() * Constants::page_size))
+        return Error::from_string_literal("Failed to grow to requested size");
+
+    return { move(instance) };
+}
+
+MemoryInstance::MemoryInstance(MemoryInstance&& other)
+    : m_type(other.m_type)
+    , m_size(exchange(other.m_size, 0))
+    , m_data(move(other.m_data))
+    , m_reservation(exchange(other.m_reservation, nullptr))
+{
+}
+
+MemoryInstance::~MemoryInstance()
+{
+    if (m_reservation)
+        MUST(Core::System::munmap(m_reservation, Constants::guard_page_memory_reservation_size));
+}
+
+bool MemoryInstance::is_in_guard_region(FlatPtr address) const
+{
+    auto reservation = reinterpret_cast<FlatPtr>(m_reservation);
+    return has_guard_pages() && address >= reservation && address - reservation < Constants::guard_page_memory_reservation_size;
+}
+
+bool MemoryInstance::grow(size_t size_to_grow)
+{
+    if (size_to_grow == 0)
+        return true;
+    // Only whole pages can be made accessible, and leaving the rest of a partial one accessible as well would let
+    // out-of-bounds accesses to it through.
+    if (has_guard_pages())
+        size_to_grow = round_up_to_power_of_two(size_to_grow, Constants::page_size);
+    u64 new_size = m_size + size_to_grow;
+    // Can't grow past 2^16 pages.
+    if (new_size >= Constants::page_size * 65536)
+        return false;
+    if (auto max = m_type.limits().max(); max.has_value()) {
+        if (max.value() * Constants::page_size < new_size)
+            return false;
+    }
+    auto previous_size = m_size;
+    if (has_guard_pages()) {
+        // The pages made accessible have never been touched, so they are zeroed already.
+        if (mprotect(m_reservation + previous_size, size_to_grow, PROT_READ | PROT_WRITE) < 0)
+            return false;
+    } else {
+        if (m_data.try_resize(new_size).is_error())
+            return false;
+        // The spec requires that we zero out everything on grow
+        __builtin_memset(m_data.offset_pointer(previous_size), 0, size_to_grow);
+    }
+    m_size = new_size;
+    return true;
+}
+
 Optional<FunctionAddress> Store::allocate(ModuleInstance& module, Module::Function const& function)
 {
     FunctionAddress address { m_functions.size() };
@@ -43,10 +115,15 @@ Optional<TableAddress> Store::allocate(TableType const& type)
 Optional<MemoryAddress> Store::allocate(MemoryType const& type)
 {
     MemoryAddress address { m_memories.size() };
-    auto instance = MemoryInstance::create(type);
+    auto instance = MemoryInstance::create(type, m_memory_backing);
+    if (instance.is_error() && m_memory_backing != MemoryInstance::Backing::Buffer) {
+        dbgln("LibWasm: Failed to create a memory with guard pages ({}), falling back to a bounds checked one", instance.error());
+        instance = MemoryInstance::create(type);
+    }
     if (instance.is_error())
         return {};
 
+    m_has_guard_page_memories |= instance.value().has_guard_pages();
     m_memories.append(instance.release_value());
     return address;
 }
@@ -96,6 +173,15 @@ MemoryInstance* Store::get(MemoryAddress address)
     return &m_memories[value];
 }
 
+bool Store::is_in_guard_region(FlatPtr address) const
+{
+    for (auto& memory : m_memories) {
+        if (memory.is_in_guard_region(address))
+            return true;
+    }
+    return false;
+}
+
 GlobalInstance* Store::get(GlobalAddress address)
 {
     auto value = address.value();
@@ -323,6 +409,7 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
                     size_t offset = 0;
                     result.values().first().value().visit(
                         [&](auto const& value) { offset = value; },
+                        [&](u128 const&) { instantiation_result = InstantiationError { "Data segment offset returned a vector"sv }; },
                         [&](Reference const&) { instantiation_result = InstantiationError { "Data segment offset returned a reference"sv }; });
                     if (instantiation_result.has_value() && instantiation_result->is_error())
                         return;
@@ -355,7 +442,7 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
                         }
                         if (instance->size() < data.init.size() + offset)
                             instance->grow(data.init.size() + offset - instance->size());
-                        instance->data().overwrite(offset, data.init.data(), data.init.size());
+                        instance->bytes().overwrite(offset, data.init.data(), data.init.size());
                     }
                 },
                 [&](DataSection::Data::Passive const& passive) {
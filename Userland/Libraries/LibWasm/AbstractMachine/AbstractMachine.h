@@ -70,7 +70,7 @@ public:
     {
     }
 
-    using AnyValueType = Variant<i32, i64, float, double, Reference>;
+    using AnyValueType = Variant<i32, i64, float, double, u128, Reference>;
     explicit Value(AnyValueType value)
         : m_value(move(value))
     {
@@ -99,6 +99,9 @@ public:
         case ValueType::Kind::F64:
             m_value = bit_cast<double>(raw_value);
             break;
+        case ValueType::Kind::V128:
+            m_value = u128(bit_cast<u64>(raw_value));
+            break;
         case ValueType::Kind::NullFunctionReference:
             VERIFY(raw_value == 0);
             m_value = Reference { Reference::Null { ValueType(ValueType::Kind::FunctionReference) } };
@@ -152,6 +155,7 @@ public:
             [](i64) { return ValueType::Kind::I64; },
             [](float) { return ValueType::Kind::F32; },
             [](double) { return ValueType::Kind::F64; },
+            [](u128) { return ValueType::Kind::V128; },
             [&](Reference const& type) {
                 return type.ref().visit(
                     [](Reference::Func const&) { return ValueType::Kind::FunctionReference; },
@@ -331,42 +335,42 @@ private:
 
 class MemoryInstance {
 public:
-    static ErrorOr<MemoryInstance> create(MemoryType const& type)
-    {
-        MemoryInstance instance { type };
+    enum class Backing {
+        // The memory lives in a ByteBuffer that is reallocated as it grows, and every access to it is bounds checked.
+        Buffer,
+        // The memory lives at the start of an address space reservation that is too large for any 32-bit address
+        // plus offset to reach past, of which only the current size is accessible. This lets accesses skip the
+        // bounds check, out-of-bounds ones fault on the inaccessible pages instead (see GuardPageFaultScope).
+        GuardPages,
+    };
 
-        if (!instance.grow(type.limits().min() * Constants::page_size))
-            return Error::from_string_literal("Failed to grow to requested size");
+    static ErrorOr<MemoryInstance> create(MemoryType const&, Backing = Backing::Buffer);
 
-        return { move(instance) };
-    }
+    MemoryInstance(MemoryInstance&&);
+    ~MemoryInstance();
 
     auto& type() const { return m_type; }
     auto size() const { return m_size; }
-    auto& data() const { return m_data; }
-    auto& data() { return m_data; }
+    bool has_guard_pages() const { return m_reservation != nullptr; }
+    bool is_in_guard_region(FlatPtr address) const;
+
+    Bytes bytes() { return { has_guard_pages() ? m_reservation : m_data.data(), m_size }; }
+    ReadonlyBytes bytes() const { return { has_guard_pages() ? m_reservation : m_data.data(), m_size }; }
 
-    bool grow(size_t size_to_grow)
+    // Only memories backed by a buffer have one, use bytes() where that doesn't matter.
+    ByteBuffer const& data() const
     {
-        if (size_to_grow == 0)
-            return true;
-        u64 new_size = m_data.size() + size_to_grow;
-        // Can't grow past 2^16 pages.
-        if (new_size >= Constants::page_size * 65536)
-            return false;
-        if (auto max = m_type.limits().max(); max.has_value()) {
-            if (max.value() * Constants::page_size < new_size)
-                return false;
-        }
-        auto previous_size = m_size;
-        if (m_data.try_resize(new_size).is_error())
-            return false;
-        m_size = new_size;
-        // The spec requires that we zero out everything on grow
-        __builtin_memset(m_data.offset_pointer(previous_size), 0, size_to_grow);
-        return true;
+        VERIFY(!has_guard_pages());
+        return m_data;
+    }
+    ByteBuffer& data()
+    {
+        VERIFY(!has_guard_pages());
+        return m_data;
     }
 
+    bool grow(size_t size_to_grow);
+
 private:
     explicit MemoryInstance(MemoryType const& type)
         : m_type(type)
@@ -376,6 +380,7 @@ private:
     MemoryType const& m_type;
     size_t m_size { 0 };
     ByteBuffer m_data;
+    u8* m_reservation { nullptr };
 };
 
 class GlobalInstance {
@@ -451,6 +456,11 @@ public:
     DataInstance* get(DataAddress);
     ElementInstance* get(ElementAddress);
 
+    // Only affects memories that are allocated afterwards.
+    void set_memory_backing(MemoryInstance::Backing backing) { m_memory_backing = backing; }
+    bool has_guard_page_memories() const { return m_has_guard_page_memories; }
+    bool is_in_guard_region(FlatPtr address) const;
+
 private:
     Vector<FunctionInstance> m_functions;
     Vector<TableInstance> m_tables;
@@ -458,6 +468,8 @@ private:
     Vector<GlobalInstance> m_globals;
     Vector<ElementInstance> m_elements;
     Vector<DataInstance> m_datas;
+    MemoryInstance::Backing m_memory_backing { MemoryInstance::Backing::Buffer };
+    bool m_has_guard_page_memories { false };
 };
 
 class Label {
@@ -478,11 +490,12 @@ private:
 
 class Frame {
 public:
-    explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity)
+    explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity, Module::Function const* function = nullptr)
         : m_module(module)
         , m_locals(move(locals))
         , m_expression(expression)
         , m_arity(arity)
+        , m_function(function)
     {
     }
 
@@ -491,12 +504,14 @@ public:
     auto& locals() { return m_locals; }
     auto& expression() const { return m_expression; }
     auto arity() const { return m_arity; }
+    auto function() const { return m_function; }
 
 private:
     ModuleInstance const& m_module;
     Vector<Value> m_locals;
     Expression const& m_expression;
     size_t m_arity { 0 };
+    Module::Function const* m_function { nullptr };
 };
 
 class Stack {
@@ -535,6 +550,7 @@ public:
     auto& store() { return m_store; }
 
     void enable_instruction_count_limit() { m_should_limit_instruction_count = true; }
+    void enable_guard_page_memories() { m_store.set_memory_backing(MemoryInstance::Backing::GuardPages); }
 
 private:
     Optional<InstantiationError> allocate_all_initial_phase(Module const&, ModuleInstance&, Vector<ExternValue>&, Vector<Value>& global_values);
@@ -11,6 +11,7 @@
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/AbstractMachine/GuardPages.h>
 #include <LibWasm/AbstractMachine/Operators.h>
 #include <LibWasm/Opcode.h>
 #include <LibWasm/Printer/Printer.h>
@@ -35,6 +36,19 @@ namespace Wasm {
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap.clear();
+
+    // Out-of-bounds accesses to memories with guard pages fault, which lands back here without unwinding anything
+    // in between. Every call gets its own scope, so that only this function's instructions are skipped that way;
+    // the trap then unwinds the calls it's nested in as usual.
+    Optional<GuardPageFaultScope> fault_scope;
+    if (configuration.store().has_guard_page_memories()) {
+        fault_scope.emplace(configuration.store());
+        if (sigsetjmp(fault_scope->jump_buffer(), 0) != 0) {
+            m_trap = Trap { "Memory access out of bounds" };
+            return;
+        }
+    }
+
     auto& instructions = configuration.frame().expression().instructions();
     auto max_ip_value = InstructionPointer { instructions.size() };
     auto& current_ip_value = configuration.ip();
@@ -98,6 +112,12 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         return;
     }
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
+    if (memory->has_guard_pages()) {
+        dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
+        ReadonlyBytes slice { memory->bytes().data() + instance_address, sizeof(ReadType) };
+        configuration.stack().peek() = Value(static_cast<PushType>(read_value<ReadType>(slice)));
+        return;
+    }
     Checked addition { instance_address };
     addition += sizeof(ReadType);
     if (addition.has_overflow() || addition.value() > memory->size()) {
@@ -106,7 +126,7 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
+    auto slice = memory->bytes().slice(instance_address, sizeof(ReadType));
     configuration.stack().peek() = Value(static_cast<PushType>(read_value<ReadType>(slice)));
 }
 
@@ -145,17 +165,17 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
         configuration.stack().entries().unchecked_append(move(entry));
 }
 
-template<typename PopType, typename PushType, typename Operator>
-void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration)
+template<typename PopType, typename PushType, typename Operator, typename RhsPopType>
+void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration, Operator const& operator_)
 {
     auto rhs_entry = configuration.stack().pop();
     auto& lhs_entry = configuration.stack().peek();
     auto rhs_ptr = rhs_entry.get_pointer<Value>();
     auto lhs_ptr = lhs_entry.get_pointer<Value>();
-    auto rhs = rhs_ptr->to<PopType>();
+    auto rhs = rhs_ptr->to<RhsPopType>();
     auto lhs = lhs_ptr->to<PopType>();
     PushType result;
-    auto call_result = Operator {}(lhs.value(), rhs.value());
+    auto call_result = operator_(lhs.value(), rhs.value());
     if constexpr (IsSpecializationOf<decltype(call_result), AK::Result>) {
         if (call_result.is_error()) {
             trap_if_not(false, call_result.error());
@@ -170,12 +190,12 @@ void BytecodeInterpreter::binary_numeric_operation(Configuration& configuration)
 }
 
 template<typename PopType, typename PushType, typename Operator>
-void BytecodeInterpreter::unary_operation(Configuration& configuration)
+void BytecodeInterpreter::unary_operation(Configuration& configuration, Operator const& operator_)
 {
     auto& entry = configuration.stack().peek();
     auto entry_ptr = entry.get_pointer<Value>();
     auto value = entry_ptr->to<PopType>();
-    auto call_result = Operator {}(*value);
+    auto call_result = operator_(*value);
     PushType result;
     if constexpr (IsSpecializationOf<decltype(call_result), AK::Result>) {
         if (call_result.is_error()) {
@@ -222,15 +242,22 @@ struct ConvertToRaw<double> {
     }
 };
 
+template<>
+struct ConvertToRaw<u128> {
+    u128 operator()(u128 value)
+    {
+        return u128 { static_cast<u64>(LittleEndian<u64>(value.low())), static_cast<u64>(LittleEndian<u64>(value.high())) };
+    }
+};
+
 template<typename PopT, typename StoreT>
 void BytecodeInterpreter::pop_and_store(Configuration& configuration, Instruction const& instruction)
 {
-    auto entry = configuration.stack().pop();
-    auto value = ConvertToRaw<StoreT> {}(*entry.get<Value>().to<PopT>());
+    // The popped entries are gone by the time the store happens, as a fault there won't destroy them.
+    auto value = ConvertToRaw<StoreT> {}(*configuration.stack().pop().get<Value>().to<PopT>());
     dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, sizeof(StoreT));
-    auto base_entry = configuration.stack().pop();
-    auto base = base_entry.get<Value>().to<i32>();
-    store_to_memory(configuration, instruction, { &value, sizeof(StoreT) }, *base);
+    auto base = *configuration.stack().pop().get<Value>().to<i32>();
+    store_to_memory(configuration, instruction, { &value, sizeof(StoreT) }, base);
 }
 
 void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruction const& instruction, ReadonlyBytes data, i32 base)
@@ -239,6 +266,11 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
     auto memory = configuration.store().get(address);
     auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
+    if (memory->has_guard_pages()) {
+        dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
+        data.copy_to({ memory->bytes().data() + instance_address, data.size() });
+        return;
+    }
     Checked addition { instance_address };
     addition += data.size();
     if (addition.has_overflow() || addition.value() > memory->size()) {
@@ -247,7 +279,30 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    data.copy_to(memory->bytes().slice(instance_address, data.size()));
+}
+
+template<typename LaneT>
+void BytecodeInterpreter::load_lane(Configuration& configuration, Instruction const& instruction)
+{
+    using PushT = Conditional<sizeof(LaneT) == sizeof(u64), i64, i32>;
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    auto vector = *configuration.stack().pop().get<Value>().to<u128>();
+    load_and_push<LaneT, PushT>(configuration, Instruction { instruction.opcode(), arg.memory });
+    if (m_trap.has_value())
+        return;
+    auto& entry = configuration.stack().peek();
+    entry = Value(Operators::VectorReplaceLane<LaneT> { arg.lane }(vector, *entry.get<Value>().to<PushT>()));
+}
+
+template<typename LaneT>
+void BytecodeInterpreter::store_lane(Configuration& configuration, Instruction const& instruction)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
+    auto vector = *configuration.stack().pop().get<Value>().to<u128>();
+    auto value = ConvertToRaw<LaneT> {}(Operators::as_vector<LaneT>(vector)[arg.lane]);
+    auto base = *configuration.stack().pop().get<Value>().to<i32>();
+    store_to_memory(configuration, Instruction { instruction.opcode(), arg.memory }, { &value, sizeof(LaneT) }, base);
 }
 
 template<typename T>
@@ -285,6 +340,14 @@ double BytecodeInterpreter::read_value<double>(ReadonlyBytes data)
     return bit_cast<double>(static_cast<u64>(raw_value));
 }
 
+template<>
+u128 BytecodeInterpreter::read_value<u128>(ReadonlyBytes data)
+{
+    auto low = read_value<u64>(data.slice(0, sizeof(u64)));
+    auto high = read_value<u64>(data.slice(sizeof(u64), sizeof(u64)));
+    return u128 { low, high };
+}
+
 template<typename V, typename T>
 MakeSigned<T> BytecodeInterpreter::checked_signed_truncate(V value)
 {
@@ -625,7 +688,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto value = configuration.stack().pop().get<Value>().to<i32>().value();
         auto destination_offset = configuration.stack().pop().get<Value>().to<i32>().value();
 
-        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->data().size());
+        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->size());
 
         if (count == 0)
             return;
@@ -648,8 +711,8 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto source_offset = configuration.stack().pop().get<Value>().to<i32>().value();
         auto destination_offset = configuration.stack().pop().get<Value>().to<i32>().value();
 
-        TRAP_IF_NOT(static_cast<size_t>(source_offset + count) <= instance->data().size());
-        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->data().size());
+        TRAP_IF_NOT(static_cast<size_t>(source_offset + count) <= instance->size());
+        TRAP_IF_NOT(static_cast<size_t>(destination_offset + count) <= instance->size());
 
         if (count == 0)
             return;
@@ -661,12 +724,12 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
 
         if (destination_offset <= source_offset) {
             for (auto i = 0; i < count; ++i) {
-                auto value = instance->data()[source_offset + i];
+                auto value = instance->bytes()[source_offset + i];
                 store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset + i);
             }
         } else {
             for (auto i = count - 1; i >= 0; --i) {
-                auto value = instance->data()[source_offset + i];
+                auto value = instance->bytes()[source_offset + i];
                 store_to_memory(configuration, synthetic_store_instruction, { &value, sizeof(value) }, destination_offset + i);
             }
         }
@@ -1014,6 +1077,514 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return unary_operation<double, i64, Operators::SaturatingTruncate<i64>>(configuration);
     case Instructions::i64_trunc_sat_f64_u.value():
         return unary_operation<double, i64, Operators::SaturatingTruncate<u64>>(configuration);
+    case Instructions::v128_load.value():
+        return load_and_push<u128, u128>(configuration, instruction);
+    case Instructions::v128_load8x8_s.value():
+        load_and_push<u64, u128>(configuration, instruction);
+        if (m_trap.has_value())
+            return;
+        return unary_operation<u128, u128, Operators::VectorExtend<i8, i16, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::v128_load8x8_u.value():
+        load_and_push<u64, u128>(configuration, instruction);
+        if (m_trap.has_value())
+            return;
+        return unary_operation<u128, u128, Operators::VectorExtend<u8, u16, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::v128_load16x4_s.value():
+        load_and_push<u64, u128>(configuration, instruction);
+        if (m_trap.has_value())
+            return;
+        return unary_operation<u128, u128, Operators::VectorExtend<i16, i32, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::v128_load16x4_u.value():
+        load_and_push<u64, u128>(configuration, instruction);
+        if (m_trap.has_value())
+            return;
+        return unary_operation<u128, u128, Operators::VectorExtend<u16, u32, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::v128_load32x2_s.value():
+        load_and_push<u64, u128>(configuration, instruction);
+        if (m_trap.has_value())
+            return;
+        return unary_operation<u128, u128, Operators::VectorExtend<i32, i64, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::v128_load32x2_u.value():
+        load_and_push<u64, u128>(configuration, instruction);
+        if (m_trap.has_value())
+            return;
+        return unary_operation<u128, u128, Operators::VectorExtend<u32, u64, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::v128_load8_splat.value():
+        load_and_push<u8, i32>(configuration, instruction);
+        if (m_trap.has_value())
+            return;
+        return unary_operation<i32, u128, Operators::VectorSplat<u8>>(configuration);
+    case Instructions::v128_load16_splat.value():
+        load_and_push<u16, i32>(configuration, instruction);
+        if (m_trap.has_value())
+            return;
+        return unary_operation<i32, u128, Operators::VectorSplat<u16>>(configuration);
+    case Instructions::v128_load32_splat.value():
+        load_and_push<u32, i32>(configuration, instruction);
+        if (m_trap.has_value())
+            return;
+        return unary_operation<i32, u128, Operators::VectorSplat<u32>>(configuration);
+    case Instructions::v128_load64_splat.value():
+        load_and_push<u64, i64>(configuration, instruction);
+        if (m_trap.has_value())
+            return;
+        return unary_operation<i64, u128, Operators::VectorSplat<u64>>(configuration);
+    case Instructions::v128_store.value():
+        return pop_and_store<u128, u128>(configuration, instruction);
+    case Instructions::v128_const.value():
+        configuration.stack().push(Value(instruction.arguments().get<u128>()));
+        return;
+    case Instructions::i8x16_shuffle.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShuffle>(configuration, { instruction.arguments().get<Instruction::ShuffleArgument>().lanes });
+    case Instructions::i8x16_swizzle.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorSwizzle>(configuration);
+    case Instructions::i8x16_splat.value():
+        return unary_operation<i32, u128, Operators::VectorSplat<i8>>(configuration);
+    case Instructions::i16x8_splat.value():
+        return unary_operation<i32, u128, Operators::VectorSplat<i16>>(configuration);
+    case Instructions::i32x4_splat.value():
+        return unary_operation<i32, u128, Operators::VectorSplat<i32>>(configuration);
+    case Instructions::i64x2_splat.value():
+        return unary_operation<i64, u128, Operators::VectorSplat<i64>>(configuration);
+    case Instructions::f32x4_splat.value():
+        return unary_operation<float, u128, Operators::VectorSplat<float>>(configuration);
+    case Instructions::f64x2_splat.value():
+        return unary_operation<double, u128, Operators::VectorSplat<double>>(configuration);
+    case Instructions::i8x16_extract_lane_s.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<i8, i32>>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::i8x16_extract_lane_u.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<u8, i32>>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::i8x16_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<i8>, i32>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::i16x8_extract_lane_s.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<i16, i32>>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::i16x8_extract_lane_u.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<u16, i32>>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::i16x8_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<i16>, i32>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::i32x4_extract_lane.value():
+        return unary_operation<u128, i32, Operators::VectorExtractLane<i32, i32>>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::i32x4_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<i32>, i32>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::i64x2_extract_lane.value():
+        return unary_operation<u128, i64, Operators::VectorExtractLane<i64, i64>>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::i64x2_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<i64>, i64>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::f32x4_extract_lane.value():
+        return unary_operation<u128, float, Operators::VectorExtractLane<float, float>>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::f32x4_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<float>, float>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::f64x2_extract_lane.value():
+        return unary_operation<u128, double, Operators::VectorExtractLane<double, double>>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::f64x2_replace_lane.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<double>, double>(configuration, { instruction.arguments().get<Instruction::LaneIndex>().lane });
+    case Instructions::i8x16_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8, Operators::Equals>>(configuration);
+    case Instructions::i8x16_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8, Operators::NotEquals>>(configuration);
+    case Instructions::i8x16_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8, Operators::LessThan>>(configuration);
+    case Instructions::i8x16_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8, Operators::LessThan>>(configuration);
+    case Instructions::i8x16_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8, Operators::GreaterThan>>(configuration);
+    case Instructions::i8x16_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8, Operators::GreaterThan>>(configuration);
+    case Instructions::i8x16_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i8x16_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i8x16_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i8, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i8x16_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i16x8_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16, Operators::Equals>>(configuration);
+    case Instructions::i16x8_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16, Operators::NotEquals>>(configuration);
+    case Instructions::i16x8_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16, Operators::LessThan>>(configuration);
+    case Instructions::i16x8_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16, Operators::LessThan>>(configuration);
+    case Instructions::i16x8_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16, Operators::GreaterThan>>(configuration);
+    case Instructions::i16x8_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16, Operators::GreaterThan>>(configuration);
+    case Instructions::i16x8_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i16x8_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i16x8_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i16, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i16x8_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i32x4_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32, Operators::Equals>>(configuration);
+    case Instructions::i32x4_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32, Operators::NotEquals>>(configuration);
+    case Instructions::i32x4_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32, Operators::LessThan>>(configuration);
+    case Instructions::i32x4_lt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32, Operators::LessThan>>(configuration);
+    case Instructions::i32x4_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32, Operators::GreaterThan>>(configuration);
+    case Instructions::i32x4_gt_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32, Operators::GreaterThan>>(configuration);
+    case Instructions::i32x4_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i32x4_le_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i32x4_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i32, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i32x4_ge_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::f32x4_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<float, Operators::Equals>>(configuration);
+    case Instructions::f32x4_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<float, Operators::NotEquals>>(configuration);
+    case Instructions::f32x4_lt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<float, Operators::LessThan>>(configuration);
+    case Instructions::f32x4_gt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<float, Operators::GreaterThan>>(configuration);
+    case Instructions::f32x4_le.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<float, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::f32x4_ge.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<float, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::f64x2_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<double, Operators::Equals>>(configuration);
+    case Instructions::f64x2_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<double, Operators::NotEquals>>(configuration);
+    case Instructions::f64x2_lt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<double, Operators::LessThan>>(configuration);
+    case Instructions::f64x2_gt.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<double, Operators::GreaterThan>>(configuration);
+    case Instructions::f64x2_le.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<double, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::f64x2_ge.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<double, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::v128_not.value():
+        return unary_operation<u128, u128, Operators::VectorNot>(configuration);
+    case Instructions::v128_and.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64, Operators::BitAnd>>(configuration);
+    case Instructions::v128_andnot.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorAndNot>(configuration);
+    case Instructions::v128_or.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64, Operators::BitOr>>(configuration);
+    case Instructions::v128_xor.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64, Operators::BitXor>>(configuration);
+    case Instructions::v128_bitselect.value(): {
+        auto mask = *configuration.stack().pop().get<Value>().to<u128>();
+        auto rhs = *configuration.stack().pop().get<Value>().to<u128>();
+        auto& lhs_entry = configuration.stack().peek();
+        lhs_entry = Value(Operators::VectorBitSelect {}(*lhs_entry.get<Value>().to<u128>(), rhs, mask));
+        return;
+    }
+    case Instructions::v128_any_true.value():
+        return unary_operation<u128, i32, Operators::VectorAnyTrue>(configuration);
+    case Instructions::v128_load8_lane.value():
+        return load_lane<u8>(configuration, instruction);
+    case Instructions::v128_load16_lane.value():
+        return load_lane<u16>(configuration, instruction);
+    case Instructions::v128_load32_lane.value():
+        return load_lane<u32>(configuration, instruction);
+    case Instructions::v128_load64_lane.value():
+        return load_lane<u64>(configuration, instruction);
+    case Instructions::v128_store8_lane.value():
+        return store_lane<u8>(configuration, instruction);
+    case Instructions::v128_store16_lane.value():
+        return store_lane<u16>(configuration, instruction);
+    case Instructions::v128_store32_lane.value():
+        return store_lane<u32>(configuration, instruction);
+    case Instructions::v128_store64_lane.value():
+        return store_lane<u64>(configuration, instruction);
+    case Instructions::v128_load32_zero.value():
+        return load_and_push<u32, u128>(configuration, instruction);
+    case Instructions::v128_load64_zero.value():
+        return load_and_push<u64, u128>(configuration, instruction);
+    case Instructions::f32x4_demote_f64x2_zero.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<double, float, Operators::Demote>>(configuration);
+    case Instructions::f64x2_promote_low_f32x4.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<float, double, Operators::Promote>>(configuration);
+    case Instructions::i8x16_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<i8>>(configuration);
+    case Instructions::i8x16_neg.value():
+        return unary_operation<u128, u128, Operators::VectorNegate<i8>>(configuration);
+    case Instructions::i8x16_popcnt.value():
+        return unary_operation<u128, u128, Operators::VectorLanewiseUnaryOperation<u8, Operators::LanePopCount>>(configuration);
+    case Instructions::i8x16_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<i8>>(configuration);
+    case Instructions::i8x16_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i8>>(configuration);
+    case Instructions::i8x16_narrow_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i16, i8>>(configuration);
+    case Instructions::i8x16_narrow_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i16, u8>>(configuration);
+    case Instructions::f32x4_ceil.value():
+        return unary_operation<u128, u128, Operators::VectorLanewiseUnaryOperation<float, Operators::Ceil>>(configuration);
+    case Instructions::f32x4_floor.value():
+        return unary_operation<u128, u128, Operators::VectorLanewiseUnaryOperation<float, Operators::Floor>>(configuration);
+    case Instructions::f32x4_trunc.value():
+        return unary_operation<u128, u128, Operators::VectorLanewiseUnaryOperation<float, Operators::TruncateFloat>>(configuration);
+    case Instructions::f32x4_nearest.value():
+        return unary_operation<u128, u128, Operators::VectorLanewiseUnaryOperation<float, Operators::NearbyIntegral>>(configuration);
+    case Instructions::i8x16_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<i8>, i32>(configuration);
+    case Instructions::i8x16_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i8>, i32>(configuration);
+    case Instructions::i8x16_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u8>, i32>(configuration);
+    case Instructions::i8x16_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8, Operators::Add>>(configuration);
+    case Instructions::i8x16_add_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<i8, Operators::SaturatingAdd<i8>>>(configuration);
+    case Instructions::i8x16_add_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u8, Operators::SaturatingAdd<u8>>>(configuration);
+    case Instructions::i8x16_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u8, Operators::Subtract>>(configuration);
+    case Instructions::i8x16_sub_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<i8, Operators::SaturatingSubtract<i8>>>(configuration);
+    case Instructions::i8x16_sub_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u8, Operators::SaturatingSubtract<u8>>>(configuration);
+    case Instructions::f64x2_ceil.value():
+        return unary_operation<u128, u128, Operators::VectorLanewiseUnaryOperation<double, Operators::Ceil>>(configuration);
+    case Instructions::f64x2_floor.value():
+        return unary_operation<u128, u128, Operators::VectorLanewiseUnaryOperation<double, Operators::Floor>>(configuration);
+    case Instructions::i8x16_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<i8, Operators::Minimum>>(configuration);
+    case Instructions::i8x16_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u8, Operators::Minimum>>(configuration);
+    case Instructions::i8x16_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<i8, Operators::Maximum>>(configuration);
+    case Instructions::i8x16_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u8, Operators::Maximum>>(configuration);
+    case Instructions::f64x2_trunc.value():
+        return unary_operation<u128, u128, Operators::VectorLanewiseUnaryOperation<double, Operators::TruncateFloat>>(configuration);
+    case Instructions::i8x16_avgr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u8, Operators::AverageRounded>>(configuration);
+    case Instructions::i16x8_extadd_pairwise_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtendAddPairwise<i8, i16>>(configuration);
+    case Instructions::i16x8_extadd_pairwise_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtendAddPairwise<u8, u16>>(configuration);
+    case Instructions::i32x4_extadd_pairwise_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtendAddPairwise<i16, i32>>(configuration);
+    case Instructions::i32x4_extadd_pairwise_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtendAddPairwise<u16, u32>>(configuration);
+    case Instructions::i16x8_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<i16>>(configuration);
+    case Instructions::i16x8_neg.value():
+        return unary_operation<u128, u128, Operators::VectorNegate<i16>>(configuration);
+    case Instructions::i16x8_q15mulr_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<i16, Operators::Q15MultiplyRoundSaturate>>(configuration);
+    case Instructions::i16x8_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<i16>>(configuration);
+    case Instructions::i16x8_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i16>>(configuration);
+    case Instructions::i16x8_narrow_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i32, i16>>(configuration);
+    case Instructions::i16x8_narrow_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<i32, u16>>(configuration);
+    case Instructions::i16x8_extend_low_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i8, i16, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extend_high_i8x16_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i8, i16, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i16x8_extend_low_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u8, u16, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extend_high_i8x16_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u8, u16, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i16x8_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<i16>, i32>(configuration);
+    case Instructions::i16x8_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i16>, i32>(configuration);
+    case Instructions::i16x8_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u16>, i32>(configuration);
+    case Instructions::i16x8_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16, Operators::Add>>(configuration);
+    case Instructions::i16x8_add_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<i16, Operators::SaturatingAdd<i16>>>(configuration);
+    case Instructions::i16x8_add_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u16, Operators::SaturatingAdd<u16>>>(configuration);
+    case Instructions::i16x8_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16, Operators::Subtract>>(configuration);
+    case Instructions::i16x8_sub_sat_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<i16, Operators::SaturatingSubtract<i16>>>(configuration);
+    case Instructions::i16x8_sub_sat_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u16, Operators::SaturatingSubtract<u16>>>(configuration);
+    case Instructions::f64x2_nearest.value():
+        return unary_operation<u128, u128, Operators::VectorLanewiseUnaryOperation<double, Operators::NearbyIntegral>>(configuration);
+    case Instructions::i16x8_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u16, Operators::Multiply>>(configuration);
+    case Instructions::i16x8_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<i16, Operators::Minimum>>(configuration);
+    case Instructions::i16x8_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u16, Operators::Minimum>>(configuration);
+    case Instructions::i16x8_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<i16, Operators::Maximum>>(configuration);
+    case Instructions::i16x8_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u16, Operators::Maximum>>(configuration);
+    case Instructions::i16x8_avgr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u16, Operators::AverageRounded>>(configuration);
+    case Instructions::i16x8_extmul_low_i8x16_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<i8, i16, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extmul_high_i8x16_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<i8, i16, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i16x8_extmul_low_i8x16_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<u8, u16, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i16x8_extmul_high_i8x16_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<u8, u16, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<i32>>(configuration);
+    case Instructions::i32x4_neg.value():
+        return unary_operation<u128, u128, Operators::VectorNegate<i32>>(configuration);
+    case Instructions::i32x4_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<i32>>(configuration);
+    case Instructions::i32x4_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i32>>(configuration);
+    case Instructions::i32x4_extend_low_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i16, i32, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extend_high_i16x8_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i16, i32, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_extend_low_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u16, u32, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extend_high_i16x8_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u16, u32, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<i32>, i32>(configuration);
+    case Instructions::i32x4_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i32>, i32>(configuration);
+    case Instructions::i32x4_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u32>, i32>(configuration);
+    case Instructions::i32x4_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32, Operators::Add>>(configuration);
+    case Instructions::i32x4_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32, Operators::Subtract>>(configuration);
+    case Instructions::i32x4_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u32, Operators::Multiply>>(configuration);
+    case Instructions::i32x4_min_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<i32, Operators::Minimum>>(configuration);
+    case Instructions::i32x4_min_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u32, Operators::Minimum>>(configuration);
+    case Instructions::i32x4_max_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<i32, Operators::Maximum>>(configuration);
+    case Instructions::i32x4_max_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<u32, Operators::Maximum>>(configuration);
+    case Instructions::i32x4_dot_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorDotProduct>(configuration);
+    case Instructions::i32x4_extmul_low_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<i16, i32, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extmul_high_i16x8_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<i16, i32, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i32x4_extmul_low_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<u16, u32, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i32x4_extmul_high_i16x8_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<u16, u32, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<i64>>(configuration);
+    case Instructions::i64x2_neg.value():
+        return unary_operation<u128, u128, Operators::VectorNegate<i64>>(configuration);
+    case Instructions::i64x2_all_true.value():
+        return unary_operation<u128, i32, Operators::VectorAllTrue<i64>>(configuration);
+    case Instructions::i64x2_bitmask.value():
+        return unary_operation<u128, i32, Operators::VectorBitmask<i64>>(configuration);
+    case Instructions::i64x2_extend_low_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i32, i64, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extend_high_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<i32, i64, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_extend_low_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u32, u64, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extend_high_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorExtend<u32, u64, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_shl.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftLeft<i64>, i32>(configuration);
+    case Instructions::i64x2_shr_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<i64>, i32>(configuration);
+    case Instructions::i64x2_shr_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<u64>, i32>(configuration);
+    case Instructions::i64x2_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64, Operators::Add>>(configuration);
+    case Instructions::i64x2_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64, Operators::Subtract>>(configuration);
+    case Instructions::i64x2_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<u64, Operators::Multiply>>(configuration);
+    case Instructions::i64x2_eq.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64, Operators::Equals>>(configuration);
+    case Instructions::i64x2_ne.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64, Operators::NotEquals>>(configuration);
+    case Instructions::i64x2_lt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64, Operators::LessThan>>(configuration);
+    case Instructions::i64x2_gt_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64, Operators::GreaterThan>>(configuration);
+    case Instructions::i64x2_le_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64, Operators::LessThanOrEquals>>(configuration);
+    case Instructions::i64x2_ge_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<i64, Operators::GreaterThanOrEquals>>(configuration);
+    case Instructions::i64x2_extmul_low_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<i32, i64, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extmul_high_i32x4_s.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<i32, i64, Operators::VectorHalf::High>>(configuration);
+    case Instructions::i64x2_extmul_low_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<u32, u64, Operators::VectorHalf::Low>>(configuration);
+    case Instructions::i64x2_extmul_high_i32x4_u.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorExtendMultiply<u32, u64, Operators::VectorHalf::High>>(configuration);
+    case Instructions::f32x4_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<float>>(configuration);
+    case Instructions::f32x4_neg.value():
+        return unary_operation<u128, u128, Operators::VectorNegate<float>>(configuration);
+    case Instructions::f32x4_sqrt.value():
+        return unary_operation<u128, u128, Operators::VectorLanewiseUnaryOperation<float, Operators::SquareRoot>>(configuration);
+    case Instructions::f32x4_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<float, Operators::Add>>(configuration);
+    case Instructions::f32x4_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<float, Operators::Subtract>>(configuration);
+    case Instructions::f32x4_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<float, Operators::Multiply>>(configuration);
+    case Instructions::f32x4_div.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<float, Operators::Divide>>(configuration);
+    case Instructions::f32x4_min.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<float, Operators::Minimum>>(configuration);
+    case Instructions::f32x4_max.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<float, Operators::Maximum>>(configuration);
+    case Instructions::f32x4_pmin.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<float, Operators::PseudoMinimum>>(configuration);
+    case Instructions::f32x4_pmax.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<float, Operators::PseudoMaximum>>(configuration);
+    case Instructions::f64x2_abs.value():
+        return unary_operation<u128, u128, Operators::VectorAbsolute<double>>(configuration);
+    case Instructions::f64x2_neg.value():
+        return unary_operation<u128, u128, Operators::VectorNegate<double>>(configuration);
+    case Instructions::f64x2_sqrt.value():
+        return unary_operation<u128, u128, Operators::VectorLanewiseUnaryOperation<double, Operators::SquareRoot>>(configuration);
+    case Instructions::f64x2_add.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<double, Operators::Add>>(configuration);
+    case Instructions::f64x2_sub.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<double, Operators::Subtract>>(configuration);
+    case Instructions::f64x2_mul.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorOperation<double, Operators::Multiply>>(configuration);
+    case Instructions::f64x2_div.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<double, Operators::Divide>>(configuration);
+    case Instructions::f64x2_min.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<double, Operators::Minimum>>(configuration);
+    case Instructions::f64x2_max.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<double, Operators::Maximum>>(configuration);
+    case Instructions::f64x2_pmin.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<double, Operators::PseudoMinimum>>(configuration);
+    case Instructions::f64x2_pmax.value():
+        return binary_numeric_operation<u128, u128, Operators::VectorLanewiseOperation<double, Operators::PseudoMaximum>>(configuration);
+    case Instructions::i32x4_trunc_sat_f32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<float, i32, Operators::SaturatingTruncate<i32>>>(configuration);
+    case Instructions::i32x4_trunc_sat_f32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<float, u32, Operators::SaturatingTruncate<u32>>>(configuration);
+    case Instructions::f32x4_convert_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<i32, float, Operators::LaneConvert<float>>>(configuration);
+    case Instructions::f32x4_convert_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<u32, float, Operators::LaneConvert<float>>>(configuration);
+    case Instructions::i32x4_trunc_sat_f64x2_s_zero.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<double, i32, Operators::SaturatingTruncate<i32>>>(configuration);
+    case Instructions::i32x4_trunc_sat_f64x2_u_zero.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<double, u32, Operators::SaturatingTruncate<u32>>>(configuration);
+    case Instructions::f64x2_convert_low_i32x4_s.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<i32, double, Operators::LaneConvert<double>>>(configuration);
+    case Instructions::f64x2_convert_low_i32x4_u.value():
+        return unary_operation<u128, u128, Operators::VectorConvert<u32, double, Operators::LaneConvert<double>>>(configuration);
     case Instructions::table_init.value():
     case Instructions::elem_drop.value():
     case Instructions::table_copy.value():
@@ -40,13 +40,17 @@ protected:
     template<typename PopT, typename StoreT>
     void pop_and_store(Configuration&, Instruction const&);
     void store_to_memory(Configuration&, Instruction const&, ReadonlyBytes data, i32 base);
+    template<typename LaneT>
+    void load_lane(Configuration&, Instruction const&);
+    template<typename LaneT>
+    void store_lane(Configuration&, Instruction const&);
     void call_address(Configuration&, FunctionAddress);
 
-    template<typename PopType, typename PushType, typename Operator>
-    void binary_numeric_operation(Configuration&);
+    template<typename PopType, typename PushType, typename Operator, typename RhsPopType = PopType>
+    void binary_numeric_operation(Configuration&, Operator const& = {});
 
     template<typename PopType, typename PushType, typename Operator>
-    void unary_operation(Configuration&);
+    void unary_operation(Configuration&, Operator const& = {});
 
     template<typename V, typename T>
     MakeUnsigned<T> checked_unsigned_truncate(V);
@@ -53,6 +53,7 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
             move(locals),
             wasm_function->code().body(),
             wasm_function->type().results().size(),
+            &wasm_function->code(),
         });
         m_ip = 0;
         return execute(interpreter);
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibWasm/AbstractMachine/GuardPages.h>
+#include <signal.h>
+
+namespace Wasm {
+
+static thread_local GuardPageFaultScope* s_innermost_scope { nullptr };
+static struct sigaction s_previous_action;
+
+static void handle_fault(int signal, siginfo_t* info, void* context)
+{
+    if (auto* scope = s_innermost_scope; scope && scope->store().is_in_guard_region(reinterpret_cast<FlatPtr>(info->si_addr)))
+        siglongjmp(scope->jump_buffer(), 1);
+
+    // This fault is not ours to handle, so pass it on to whoever handled it before us.
+    if (s_previous_action.sa_flags & SA_SIGINFO) {
+        s_previous_action.sa_sigaction(signal, info, context);
+        return;
+    }
+    if (s_previous_action.sa_handler != SIG_DFL && s_previous_action.sa_handler != SIG_IGN) {
+        s_previous_action.sa_handler(signal);
+        return;
+    }
+
+    // Nobody is going to handle it, so let the faulting access take the process down once it's retried.
+    struct sigaction default_action {};
+    default_action.sa_handler = SIG_DFL;
+    sigemptyset(&default_action.sa_mask);
+    sigaction(signal, &default_action, nullptr);
+}
+
+static ErrorOr<void> install_fault_handler_once()
+{
+    struct sigaction action {};
+    action.sa_sigaction = handle_fault;
+    // The handler never returns through sigreturn when it jumps back to a scope, so it must not leave the signal blocked.
+    action.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&action.sa_mask);
+    TRY(Core::System::sigaction(SIGSEGV, &action, &s_previous_action));
+    return {};
+}
+
+ErrorOr<void> GuardPageFaultScope::install_fault_handler()
+{
+    // The handler stays installed for the lifetime of the process. Initializing this only once is thread-safe.
+    static int const error_code = [] {
+        auto result = install_fault_handler_once();
+        return result.is_error() ? result.error().code() : 0;
+    }();
+    if (error_code != 0)
+        return Error::from_errno(error_code);
+    return {};
+}
+
+GuardPageFaultScope::GuardPageFaultScope(Store const& store)
+    : m_store(store)
+    , m_outer_scope(s_innermost_scope)
+{
+    s_innermost_scope = this;
+}
+
+GuardPageFaultScope::~GuardPageFaultScope()
+{
+    s_innermost_scope = m_outer_scope;
+}
+
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Noncopyable.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <setjmp.h>
+
+namespace Wasm {
+
+// Accesses to memories backed by guard pages are not bounds checked, those that are out of bounds fault instead.
+// While a scope is active on the current thread, such a fault jumps back to where its jump buffer was set up with
+// sigsetjmp(), which is expected to turn it into a trap that is then unwound like any other. The frames between
+// that point and the faulting access are abandoned without running destructors, so the interpreters enter a scope
+// for every function they execute, and don't hold on to any resources while accessing memory.
+class GuardPageFaultScope {
+    AK_MAKE_NONCOPYABLE(GuardPageFaultScope);
+    AK_MAKE_NONMOVABLE(GuardPageFaultScope);
+
+public:
+    static ErrorOr<void> install_fault_handler();
+
+    explicit GuardPageFaultScope(Store const&);
+    ~GuardPageFaultScope();
+
+    Store const& store() const { return m_store; }
+    sigjmp_buf& jump_buffer() { return m_jump_buffer; }
+
+private:
+    Store const& m_store;
+    GuardPageFaultScope* m_outer_scope { nullptr };
+    sigjmp_buf m_jump_buffer;
+};
+
+}
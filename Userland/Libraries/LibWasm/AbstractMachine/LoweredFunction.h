@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NumericLimits.h>
+#include <AK/Vector.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+// name, pop type, push type, operator
+#define ENUMERATE_WASM_LOWERED_UNARY_OPERATIONS(M)               \
+    M(i32_eqz, i32, i32, EqualsZero)                             \
+    M(i64_eqz, i64, i32, EqualsZero)                             \
+    M(i32_clz, i32, i32, CountLeadingZeros)                      \
+    M(i32_ctz, i32, i32, CountTrailingZeros)                     \
+    M(i32_popcnt, i32, i32, PopCount)                            \
+    M(i64_clz, i64, i64, CountLeadingZeros)                      \
+    M(i64_ctz, i64, i64, CountTrailingZeros)                     \
+    M(i64_popcnt, i64, i64, PopCount)                            \
+    M(f32_abs, float, float, Absolute)                           \
+    M(f32_neg, float, float, Negate)                             \
+    M(f32_ceil, float, float, Ceil)                              \
+    M(f32_floor, float, float, Floor)                            \
+    M(f32_trunc, float, float, Truncate)                         \
+    M(f32_nearest, float, float, NearbyIntegral)                 \
+    M(f32_sqrt, float, float, SquareRoot)                        \
+    M(f64_abs, double, double, Absolute)                         \
+    M(f64_neg, double, double, Negate)                           \
+    M(f64_ceil, double, double, Ceil)                            \
+    M(f64_floor, double, double, Floor)                          \
+    M(f64_trunc, double, double, Truncate)                       \
+    M(f64_nearest, double, double, NearbyIntegral)               \
+    M(f64_sqrt, double, double, SquareRoot)                      \
+    M(i32_wrap_i64, i64, i32, Wrap<i32>)                         \
+    M(i32_trunc_sf32, float, i32, CheckedTruncate<i32>)          \
+    M(i32_trunc_uf32, float, i32, CheckedTruncate<u32>)          \
+    M(i32_trunc_sf64, double, i32, CheckedTruncate<i32>)         \
+    M(i32_trunc_uf64, double, i32, CheckedTruncate<u32>)         \
+    M(i64_trunc_sf32, float, i64, CheckedTruncate<i64>)          \
+    M(i64_trunc_uf32, float, i64, CheckedTruncate<u64>)          \
+    M(i64_trunc_sf64, double, i64, CheckedTruncate<i64>)         \
+    M(i64_trunc_uf64, double, i64, CheckedTruncate<u64>)         \
+    M(i64_extend_si32, i32, i64, Extend<i64>)                    \
+    M(i64_extend_ui32, u32, i64, Extend<i64>)                    \
+    M(f32_convert_si32, i32, float, Convert<float>)              \
+    M(f32_convert_ui32, u32, float, Convert<float>)              \
+    M(f32_convert_si64, i64, float, Convert<float>)              \
+    M(f32_convert_ui64, u64, float, Convert<float>)              \
+    M(f32_demote_f64, double, float, Demote)                     \
+    M(f64_convert_si32, i32, double, Convert<double>)            \
+    M(f64_convert_ui32, u32, double, Convert<double>)            \
+    M(f64_convert_si64, i64, double, Convert<double>)            \
+    M(f64_convert_ui64, u64, double, Convert<double>)            \
+    M(f64_promote_f32, float, double, Promote)                   \
+    M(i32_reinterpret_f32, float, i32, Reinterpret<i32>)         \
+    M(i64_reinterpret_f64, double, i64, Reinterpret<i64>)        \
+    M(f32_reinterpret_i32, i32, float, Reinterpret<float>)       \
+    M(f64_reinterpret_i64, i64, double, Reinterpret<double>)     \
+    M(i32_extend8_s, i32, i32, SignExtend<i8>)                   \
+    M(i32_extend16_s, i32, i32, SignExtend<i16>)                 \
+    M(i64_extend8_s, i64, i64, SignExtend<i8>)                   \
+    M(i64_extend16_s, i64, i64, SignExtend<i16>)                 \
+    M(i64_extend32_s, i64, i64, SignExtend<i32>)                 \
+    M(i32_trunc_sat_f32_s, float, i32, SaturatingTruncate<i32>)  \
+    M(i32_trunc_sat_f32_u, float, i32, SaturatingTruncate<u32>)  \
+    M(i32_trunc_sat_f64_s, double, i32, SaturatingTruncate<i32>) \
+    M(i32_trunc_sat_f64_u, double, i32, SaturatingTruncate<u32>) \
+    M(i64_trunc_sat_f32_s, float, i64, SaturatingTruncate<i64>)  \
+    M(i64_trunc_sat_f32_u, float, i64, SaturatingTruncate<u64>)  \
+    M(i64_trunc_sat_f64_s, double, i64, SaturatingTruncate<i64>) \
+    M(i64_trunc_sat_f64_u, double, i64, SaturatingTruncate<u64>)
+
+// name, pop type, push type, operator
+#define ENUMERATE_WASM_LOWERED_BINARY_OPERATIONS(M) \
+    M(i32_eq, i32, i32, Equals)                     \
+    M(i32_ne, i32, i32, NotEquals)                  \
+    M(i32_lts, i32, i32, LessThan)                  \
+    M(i32_ltu, u32, i32, LessThan)                  \
+    M(i32_gts, i32, i32, GreaterThan)               \
+    M(i32_gtu, u32, i32, GreaterThan)               \
+    M(i32_les, i32, i32, LessThanOrEquals)          \
+    M(i32_leu, u32, i32, LessThanOrEquals)          \
+    M(i32_ges, i32, i32, GreaterThanOrEquals)       \
+    M(i32_geu, u32, i32, GreaterThanOrEquals)       \
+    M(i64_eq, i64, i32, Equals)                     \
+    M(i64_ne, i64, i32, NotEquals)                  \
+    M(i64_lts, i64, i32, LessThan)                  \
+    M(i64_ltu, u64, i32, LessThan)                  \
+    M(i64_gts, i64, i32, GreaterThan)               \
+    M(i64_gtu, u64, i32, GreaterThan)               \
+    M(i64_les, i64, i32, LessThanOrEquals)          \
+    M(i64_leu, u64, i32, LessThanOrEquals)          \
+    M(i64_ges, i64, i32, GreaterThanOrEquals)       \
+    M(i64_geu, u64, i32, GreaterThanOrEquals)       \
+    M(f32_eq, float, i32, Equals)                   \
+    M(f32_ne, float, i32, NotEquals)                \
+    M(f32_lt, float, i32, LessThan)                 \
+    M(f32_gt, float, i32, GreaterThan)              \
+    M(f32_le, float, i32, LessThanOrEquals)         \
+    M(f32_ge, float, i32, GreaterThanOrEquals)      \
+    M(f64_eq, double, i32, Equals)                  \
+    M(f64_ne, double, i32, NotEquals)               \
+    M(f64_lt, double, i32, LessThan)                \
+    M(f64_gt, double, i32, GreaterThan)             \
+    M(f64_le, double, i32, LessThanOrEquals)        \
+    M(f64_ge, double, i32, GreaterThanOrEquals)     \
+    M(i32_add, u32, i32, Add)                       \
+    M(i32_sub, u32, i32, Subtract)                  \
+    M(i32_mul, u32, i32, Multiply)                  \
+    M(i32_divs, i32, i32, Divide)                   \
+    M(i32_divu, u32, i32, Divide)                   \
+    M(i32_rems, i32, i32, Modulo)                   \
+    M(i32_remu, u32, i32, Modulo)                   \
+    M(i32_and, i32, i32, BitAnd)                    \
+    M(i32_or, i32, i32, BitOr)                      \
+    M(i32_xor, i32, i32, BitXor)                    \
+    M(i32_shl, u32, i32, BitShiftLeft)              \
+    M(i32_shrs, i32, i32, BitShiftRight)            \
+    M(i32_shru, u32, i32, BitShiftRight)            \
+    M(i32_rotl, u32, i32, BitRotateLeft)            \
+    M(i32_rotr, u32, i32, BitRotateRight)           \
+    M(i64_add, u64, i64, Add)                       \
+    M(i64_sub, u64, i64, Subtract)                  \
+    M(i64_mul, u64, i64, Multiply)                  \
+    M(i64_divs, i64, i64, Divide)                   \
+    M(i64_divu, u64, i64, Divide)                   \
+    M(i64_rems, i64, i64, Modulo)                   \
+    M(i64_remu, u64, i64, Modulo)                   \
+    M(i64_and, i64, i64, BitAnd)                    \
+    M(i64_or, i64, i64, BitOr)                      \
+    M(i64_xor, i64, i64, BitXor)                    \
+    M(i64_shl, u64, i64, BitShiftLeft)              \
+    M(i64_shrs, i64, i64, BitShiftRight)            \
+    M(i64_shru, u64, i64, BitShiftRight)            \
+    M(i64_rotl, u64, i64, BitRotateLeft)            \
+    M(i64_rotr, u64, i64, BitRotateRight)           \
+    M(f32_add, float, float, Add)                   \
+    M(f32_sub, float, float, Subtract)              \
+    M(f32_mul, float, float, Multiply)              \
+    M(f32_div, float, float, Divide)                \
+    M(f32_min, float, float, Minimum)               \
+    M(f32_max, float, float, Maximum)               \
+    M(f32_copysign, float, float, CopySign)         \
+    M(f64_add, double, double, Add)                 \
+    M(f64_sub, double, double, Subtract)            \
+    M(f64_mul, double, double, Multiply)            \
+    M(f64_div, double, double, Divide)              \
+    M(f64_min, double, double, Minimum)             \
+    M(f64_max, double, double, Maximum)             \
+    M(f64_copysign, double, double, CopySign)
+
+// name, type in memory, pushed type
+#define ENUMERATE_WASM_LOWERED_LOAD_OPERATIONS(M) \
+    M(i32_load, i32, i32)                         \
+    M(i64_load, i64, i64)                         \
+    M(f32_load, float, float)                     \
+    M(f64_load, double, double)                   \
+    M(i32_load8_s, i8, i32)                       \
+    M(i32_load8_u, u8, i32)                       \
+    M(i32_load16_s, i16, i32)                     \
+    M(i32_load16_u, u16, i32)                     \
+    M(i64_load8_s, i8, i64)                       \
+    M(i64_load8_u, u8, i64)                       \
+    M(i64_load16_s, i16, i64)                     \
+    M(i64_load16_u, u16, i64)                     \
+    M(i64_load32_s, i32, i64)                     \
+    M(i64_load32_u, u32, i64)
+
+// name, popped type, type in memory
+#define ENUMERATE_WASM_LOWERED_STORE_OPERATIONS(M) \
+    M(i32_store, i32, i32)                         \
+    M(i64_store, i64, i64)                         \
+    M(f32_store, float, float)                     \
+    M(f64_store, double, double)                   \
+    M(i32_store8, i32, i8)                         \
+    M(i32_store16, i32, i16)                       \
+    M(i64_store8, i64, i8)                         \
+    M(i64_store16, i64, i16)                       \
+    M(i64_store32, i64, i32)
+
+// A function body lowered into register code, as executed by the RegisterInterpreter.
+// Every activation of the function works on a flat array of untyped 64-bit slots: the parameters come first,
+// then the declared locals, and the operand stack lives above them. Since validation already fixes the height
+// of the operand stack at every instruction, stack entries are addressed by their slot index just like locals,
+// and branches are plain jumps to instruction indices that copy the carried values into place beforehand.
+class LoweredFunction {
+public:
+    enum class Operation : u16 {
+        Unreachable,
+        // slots[destination] = slots[lhs]
+        Copy,
+        // slots[destination] = immediate
+        Const,
+        // ip = immediate
+        Jump,
+        // if (slots[lhs] == 0) ip = immediate
+        JumpIfZero,
+        // if (slots[lhs] != 0) ip = immediate
+        JumpIfNotZero,
+        // ip = branch_tables[immediate + 1 + min(slots[lhs], branch_tables[immediate])]
+        BranchTable,
+        // Returns the `rhs` values starting at slots[lhs].
+        Return,
+        // Calls function `immediate` of the module with the arguments starting at slots[destination],
+        // which is also where the results end up.
+        Call,
+        // Like Call, but for the function slots[lhs] refers to in table `rhs`, which must have type `immediate`.
+        CallIndirect,
+        // slots[destination] = global `immediate`, whose type is the ValueType::Kind in `rhs`
+        GlobalGet,
+        // global `immediate` = slots[lhs], whose type is the ValueType::Kind in `rhs`
+        GlobalSet,
+        // slots[destination] = the function address for function `immediate` of the module
+        RefFunc,
+        RefIsNull,
+        // slots[destination] = slots[immediate] != 0 ? slots[lhs] : slots[rhs]
+        Select,
+        MemorySize,
+        MemoryGrow,
+        // These take their three operands from consecutive slots starting at slots[lhs].
+        MemoryFill,
+        MemoryCopy,
+        MemoryInit,
+        DataDrop,
+#define __ENUMERATE_OPERATION(name, ...) name,
+        ENUMERATE_WASM_LOWERED_UNARY_OPERATIONS(__ENUMERATE_OPERATION)
+        ENUMERATE_WASM_LOWERED_BINARY_OPERATIONS(__ENUMERATE_OPERATION)
+        ENUMERATE_WASM_LOWERED_LOAD_OPERATIONS(__ENUMERATE_OPERATION)
+        ENUMERATE_WASM_LOWERED_STORE_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+    };
+
+    struct Instruction {
+        Operation operation;
+        u32 destination { 0 };
+        u32 lhs { 0 };
+        u32 rhs { 0 };
+        // The constant, jump target, memory offset or index the operation refers to.
+        u64 immediate { 0 };
+    };
+
+    // Null references are stored with this value, everything else uses its address.
+    static constexpr u64 null_reference = NumericLimits<u64>::max();
+
+    Vector<Instruction> instructions;
+    // Each table starts with its number of labels, which are followed by the jump targets for each label and the default.
+    Vector<u32> branch_tables;
+    // The values the declared locals start out with, they follow the parameters.
+    Vector<u64> local_initializers;
+    Vector<ValueType> result_types;
+    size_t parameter_count { 0 };
+    size_t slot_count { 0 };
+};
+
+}
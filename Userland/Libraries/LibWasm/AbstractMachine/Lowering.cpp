@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/HashMap.h>
+#include <LibWasm/AbstractMachine/Lowering.h>
+#include <LibWasm/Opcode.h>
+
+namespace Wasm {
+
+using Operation = LoweredFunction::Operation;
+
+class FunctionLowerer {
+public:
+    FunctionLowerer(Context const& context, FunctionType const& type, Module::Function const& function)
+        : m_context(context)
+        , m_type(type)
+        , m_function(function)
+        , m_lowered(make<LoweredFunction>())
+    {
+    }
+
+    ErrorOr<NonnullOwnPtr<LoweredFunction>> lower();
+
+private:
+    struct ControlFrame {
+        enum class Kind {
+            Function,
+            Block,
+            Loop,
+            If,
+        };
+
+        ControlFrame(Kind kind, u32 base, size_t parameter_count, size_t result_count)
+            : kind(kind)
+            , base(base)
+            , parameter_count(parameter_count)
+            , result_count(result_count)
+        {
+        }
+
+        // Branches to a loop carry its parameters back to its start, all others carry the results to the end.
+        size_t branch_arity() const { return kind == Kind::Loop ? parameter_count : result_count; }
+
+        Kind kind;
+        // The slot the parameters of the frame start at, which is also where a branch to it moves the values it carries.
+        u32 base { 0 };
+        size_t parameter_count { 0 };
+        size_t result_count { 0 };
+        size_t loop_start { 0 };
+        // Jumps that have to be pointed at the end of the frame, once its position is known.
+        Vector<size_t> jumps_to_end;
+        Optional<size_t> jump_to_else;
+    };
+
+    struct Signature {
+        size_t parameter_count { 0 };
+        size_t result_count { 0 };
+    };
+
+    ErrorOr<void> lower(Instruction const&);
+    ErrorOr<void> lower_end();
+    ErrorOr<void> lower_unary(Operation);
+    ErrorOr<void> lower_binary(Operation);
+    ErrorOr<void> lower_call(LoweredFunction::Instruction, FunctionType const&);
+    ErrorOr<void> lower_branch(LabelIndex);
+    ErrorOr<Signature> signature_of(BlockType const&) const;
+    ErrorOr<ControlFrame*> frame_for_label(LabelIndex);
+
+    u32 push();
+    ErrorOr<u32> pop();
+    size_t emit(LoweredFunction::Instruction);
+    void emit_jump(Operation, u32 condition, ControlFrame& target);
+    void bind_label() { m_label_position = m_lowered->instructions.size(); }
+    u32 take_operand(u32 slot);
+    bool redirect_last_result(u32 slot, u32 destination);
+
+    Context const& m_context;
+    FunctionType const& m_type;
+    Module::Function const& m_function;
+    NonnullOwnPtr<LoweredFunction> m_lowered;
+    Vector<ControlFrame> m_control_stack;
+    size_t m_local_count { 0 };
+    // The operand stack is tracked by its height alone, the slot of the next value to be pushed.
+    u32 m_height { 0 };
+    // The position of the most recent jump target, instructions before it must not be merged with later ones.
+    size_t m_label_position { 0 };
+    bool m_unreachable { false };
+    size_t m_unreachable_depth { 0 };
+};
+
+static bool writes_only_its_destination(Operation operation)
+{
+    switch (operation) {
+    case Operation::Copy:
+    case Operation::Const:
+    case Operation::GlobalGet:
+    case Operation::RefFunc:
+    case Operation::RefIsNull:
+    case Operation::Select:
+    case Operation::MemorySize:
+    case Operation::MemoryGrow:
+#define __ENUMERATE_OPERATION(name, ...) case Operation::name:
+        ENUMERATE_WASM_LOWERED_UNARY_OPERATIONS(__ENUMERATE_OPERATION)
+        ENUMERATE_WASM_LOWERED_BINARY_OPERATIONS(__ENUMERATE_OPERATION)
+        ENUMERATE_WASM_LOWERED_LOAD_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Slots are only wide enough for scalars, anything that handles vectors is left to the bytecode interpreter.
+static bool has_vectors(Vector<ValueType> const& types)
+{
+    for (auto& type : types) {
+        if (type.kind() == ValueType::V128)
+            return true;
+    }
+    return false;
+}
+
+static bool has_vectors(FunctionType const& type)
+{
+    return has_vectors(type.parameters()) || has_vectors(type.results());
+}
+
+ErrorOr<NonnullOwnPtr<LoweredFunction>> FunctionLowerer::lower()
+{
+    if (has_vectors(m_type) || has_vectors(m_function.locals()))
+        return Error::from_string_literal("Vector values can't be lowered");
+
+    auto parameter_count = m_type.parameters().size();
+    m_local_count = parameter_count + m_function.locals().size();
+    if (m_local_count > NumericLimits<u32>::max() / 2)
+        return Error::from_string_literal("Too many locals");
+
+    m_lowered->parameter_count = parameter_count;
+    m_lowered->result_types = m_type.results();
+    TRY(m_lowered->local_initializers.try_ensure_capacity(m_function.locals().size()));
+    for (auto& type : m_function.locals())
+        m_lowered->local_initializers.unchecked_append(type.is_reference() ? LoweredFunction::null_reference : 0);
+
+    m_height = m_local_count;
+    m_lowered->slot_count = m_local_count;
+    TRY(m_control_stack.try_append({ ControlFrame::Kind::Function, m_height, 0, m_type.results().size() }));
+
+    for (auto& instruction : m_function.body().instructions())
+        TRY(lower(instruction));
+
+    // The body of a function has no explicit end.
+    if (m_control_stack.size() != 1)
+        return Error::from_string_literal("Unterminated block");
+    TRY(lower_end());
+
+    return move(m_lowered);
+}
+
+ErrorOr<void> FunctionLowerer::lower(Instruction const& instruction)
+{
+    auto opcode = instruction.opcode();
+    if (m_unreachable) {
+        // Nothing up to the end of the current block can be reached, though the nesting still has to be tracked.
+        if (opcode == Instructions::block || opcode == Instructions::loop || opcode == Instructions::if_) {
+            ++m_unreachable_depth;
+            return {};
+        }
+        if (m_unreachable_depth > 0) {
+            if (opcode == Instructions::structured_end)
+                --m_unreachable_depth;
+            return {};
+        }
+        if (opcode != Instructions::structured_end && opcode != Instructions::structured_else)
+            return {};
+    }
+
+    switch (opcode.value()) {
+    case Instructions::unreachable.value():
+        emit({ .operation = Operation::Unreachable });
+        m_unreachable = true;
+        return {};
+    case Instructions::nop.value():
+        return {};
+    case Instructions::block.value():
+    case Instructions::loop.value(): {
+        auto signature = TRY(signature_of(instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type));
+        if (m_height - m_control_stack.last().base < signature.parameter_count)
+            return Error::from_string_literal("Missing block parameters");
+
+        ControlFrame frame {
+            opcode == Instructions::loop ? ControlFrame::Kind::Loop : ControlFrame::Kind::Block,
+            static_cast<u32>(m_height - signature.parameter_count),
+            signature.parameter_count,
+            signature.result_count,
+        };
+        if (frame.kind == ControlFrame::Kind::Loop) {
+            bind_label();
+            frame.loop_start = m_lowered->instructions.size();
+        }
+        TRY(m_control_stack.try_append(move(frame)));
+        return {};
+    }
+    case Instructions::if_.value(): {
+        auto signature = TRY(signature_of(instruction.arguments().get<Instruction::StructuredInstructionArgs>().block_type));
+        // The else branch would need its own copy of the parameters, as the then branch is free to overwrite them.
+        if (signature.parameter_count != 0)
+            return Error::from_string_literal("If blocks with parameters aren't supported");
+
+        auto condition = take_operand(TRY(pop()));
+        ControlFrame frame { ControlFrame::Kind::If, m_height, 0, signature.result_count };
+        frame.jump_to_else = emit({ .operation = Operation::JumpIfZero, .lhs = condition });
+        TRY(m_control_stack.try_append(move(frame)));
+        return {};
+    }
+    case Instructions::structured_else.value(): {
+        auto& frame = m_control_stack.last();
+        if (frame.kind != ControlFrame::Kind::If || !frame.jump_to_else.has_value())
+            return Error::from_string_literal("Else outside of an if block");
+
+        if (!m_unreachable)
+            TRY(frame.jumps_to_end.try_append(emit({ .operation = Operation::Jump })));
+        m_lowered->instructions[frame.jump_to_else.release_value()].immediate = m_lowered->instructions.size();
+        bind_label();
+        m_height = frame.base + frame.parameter_count;
+        m_unreachable = false;
+        return {};
+    }
+    case Instructions::structured_end.value():
+        if (m_control_stack.size() <= 1)
+            return Error::from_string_literal("End outside of a block");
+        return lower_end();
+    case Instructions::return_.value(): {
+        auto result_count = m_control_stack.first().result_count;
+        if (m_height < result_count)
+            return Error::from_string_literal("Missing return values");
+        emit({ .operation = Operation::Return, .lhs = static_cast<u32>(m_height - result_count), .rhs = static_cast<u32>(result_count) });
+        m_unreachable = true;
+        return {};
+    }
+    case Instructions::br.value():
+        TRY(lower_branch(instruction.arguments().get<LabelIndex>()));
+        m_unreachable = true;
+        return {};
+    case Instructions::br_if.value(): {
+        auto label = instruction.arguments().get<LabelIndex>();
+        auto condition = take_operand(TRY(pop()));
+        auto& target = *TRY(frame_for_label(label));
+        auto arity = target.branch_arity();
+        if (target.kind == ControlFrame::Kind::Loop || target.kind == ControlFrame::Kind::Block || target.kind == ControlFrame::Kind::If) {
+            // If the carried values already are where they need to be, the branch is a single conditional jump.
+            if (arity == 0 || (m_height >= arity && m_height - arity == target.base)) {
+                emit_jump(Operation::JumpIfNotZero, condition, target);
+                return {};
+            }
+        }
+        auto skip_branch = emit({ .operation = Operation::JumpIfZero, .lhs = condition });
+        TRY(lower_branch(label));
+        m_lowered->instructions[skip_branch].immediate = m_lowered->instructions.size();
+        bind_label();
+        return {};
+    }
+    case Instructions::br_table.value(): {
+        auto& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
+        auto index = take_operand(TRY(pop()));
+        auto table = m_lowered->branch_tables.size();
+        TRY(m_lowered->branch_tables.try_resize(table + arguments.labels.size() + 2));
+        m_lowered->branch_tables[table] = arguments.labels.size();
+        emit({ .operation = Operation::BranchTable, .lhs = index, .immediate = table });
+
+        // Labels that carry values, or whose position isn't known yet, are reached through a stub that
+        // branches to them. Those stubs are shared between all entries for the same label.
+        HashMap<u32, size_t> stubs;
+        for (size_t i = 0; i <= arguments.labels.size(); ++i) {
+            auto label = i < arguments.labels.size() ? arguments.labels[i] : arguments.default_;
+            auto& target = *TRY(frame_for_label(label));
+            auto arity = target.branch_arity();
+            if (target.kind == ControlFrame::Kind::Loop && (arity == 0 || (m_height >= arity && m_height - arity == target.base))) {
+                m_lowered->branch_tables[table + 1 + i] = target.loop_start;
+                continue;
+            }
+            auto stub = stubs.find(label.value());
+            if (stub == stubs.end()) {
+                TRY(stubs.try_set(label.value(), m_lowered->instructions.size()));
+                stub = stubs.find(label.value());
+                TRY(lower_branch(label));
+            }
+            m_lowered->branch_tables[table + 1 + i] = stub->value;
+        }
+        m_unreachable = true;
+        return {};
+    }
+    case Instructions::call.value(): {
+        auto index = instruction.arguments().get<FunctionIndex>().value();
+        if (index >= m_context.functions.size())
+            return Error::from_string_literal("Invalid function index");
+        return lower_call({ .operation = Operation::Call, .immediate = index }, m_context.functions[index]);
+    }
+    case Instructions::call_indirect.value(): {
+        auto& arguments = instruction.arguments().get<Instruction::IndirectCallArgs>();
+        if (arguments.type.value() >= m_context.types.size())
+            return Error::from_string_literal("Invalid type index");
+        auto element = take_operand(TRY(pop()));
+        return lower_call({
+                              .operation = Operation::CallIndirect,
+                              .lhs = element,
+                              .rhs = static_cast<u32>(arguments.table.value()),
+                              .immediate = arguments.type.value(),
+                          },
+            m_context.types[arguments.type.value()]);
+    }
+    case Instructions::local_get.value(): {
+        auto local = instruction.arguments().get<LocalIndex>().value();
+        if (local >= m_local_count)
+            return Error::from_string_literal("Invalid local index");
+        emit({ .operation = Operation::Copy, .destination = push(), .lhs = static_cast<u32>(local) });
+        return {};
+    }
+    case Instructions::local_set.value(): {
+        auto local = instruction.arguments().get<LocalIndex>().value();
+        if (local >= m_local_count)
+            return Error::from_string_literal("Invalid local index");
+        auto value = TRY(pop());
+        if (!redirect_last_result(value, local))
+            emit({ .operation = Operation::Copy, .destination = static_cast<u32>(local), .lhs = value });
+        return {};
+    }
+    case Instructions::local_tee.value(): {
+        auto local = instruction.arguments().get<LocalIndex>().value();
+        if (local >= m_local_count)
+            return Error::from_string_literal("Invalid local index");
+        auto value = TRY(pop());
+        push();
+        emit({ .operation = Operation::Copy, .destination = static_cast<u32>(local), .lhs = value });
+        return {};
+    }
+    case Instructions::global_get.value(): {
+        auto index = instruction.arguments().get<GlobalIndex>().value();
+        if (index >= m_context.globals.size())
+            return Error::from_string_literal("Invalid global index");
+        if (m_context.globals[index].type().kind() == ValueType::V128)
+            return Error::from_string_literal("Vector values can't be lowered");
+        emit({
+            .operation = Operation::GlobalGet,
+            .destination = push(),
+            .rhs = static_cast<u32>(m_context.globals[index].type().kind()),
+            .immediate = index,
+        });
+        return {};
+    }
+    case Instructions::global_set.value(): {
+        auto index = instruction.arguments().get<GlobalIndex>().value();
+        if (index >= m_context.globals.size())
+            return Error::from_string_literal("Invalid global index");
+        if (m_context.globals[index].type().kind() == ValueType::V128)
+            return Error::from_string_literal("Vector values can't be lowered");
+        emit({
+            .operation = Operation::GlobalSet,
+            .lhs = take_operand(TRY(pop())),
+            .rhs = static_cast<u32>(m_context.globals[index].type().kind()),
+            .immediate = index,
+        });
+        return {};
+    }
+#define __ENUMERATE_OPERATION(name, ...)                                                                                            \
+    case Instructions::name.value(): {                                                                                              \
+        auto address = take_operand(TRY(pop()));                                                                                    \
+        auto offset = instruction.arguments().get<Instruction::MemoryArgument>().offset;                                            \
+        emit({ .operation = Operation::name, .destination = push(), .lhs = address, .immediate = offset });                         \
+        return {};                                                                                                                  \
+    }
+        ENUMERATE_WASM_LOWERED_LOAD_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+#define __ENUMERATE_OPERATION(name, ...)                                                                                            \
+    case Instructions::name.value(): {                                                                                              \
+        auto value = take_operand(TRY(pop()));                                                                                      \
+        auto address = take_operand(TRY(pop()));                                                                                    \
+        auto offset = instruction.arguments().get<Instruction::MemoryArgument>().offset;                                            \
+        emit({ .operation = Operation::name, .lhs = address, .rhs = value, .immediate = offset });                                  \
+        return {};                                                                                                                  \
+    }
+        ENUMERATE_WASM_LOWERED_STORE_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+    case Instructions::memory_size.value():
+        emit({ .operation = Operation::MemorySize, .destination = push() });
+        return {};
+    case Instructions::memory_grow.value(): {
+        auto pages = take_operand(TRY(pop()));
+        emit({ .operation = Operation::MemoryGrow, .destination = push(), .lhs = pages });
+        return {};
+    }
+    case Instructions::memory_fill.value():
+    case Instructions::memory_copy.value():
+    case Instructions::memory_init.value(): {
+        for (size_t i = 0; i < 3; ++i)
+            TRY(pop());
+        LoweredFunction::Instruction lowered { .operation = Operation::MemoryFill, .lhs = m_height };
+        if (opcode == Instructions::memory_copy) {
+            lowered.operation = Operation::MemoryCopy;
+        } else if (opcode == Instructions::memory_init) {
+            lowered.operation = Operation::MemoryInit;
+            lowered.immediate = instruction.arguments().get<DataIndex>().value();
+        }
+        emit(lowered);
+        return {};
+    }
+    case Instructions::data_drop.value():
+        emit({ .operation = Operation::DataDrop, .immediate = instruction.arguments().get<DataIndex>().value() });
+        return {};
+    case Instructions::ref_null.value():
+        emit({ .operation = Operation::Const, .destination = push(), .immediate = LoweredFunction::null_reference });
+        return {};
+    case Instructions::ref_func.value():
+        emit({ .operation = Operation::RefFunc, .destination = push(), .immediate = instruction.arguments().get<FunctionIndex>().value() });
+        return {};
+    case Instructions::ref_is_null.value():
+        return lower_unary(Operation::RefIsNull);
+    case Instructions::drop.value():
+        TRY(pop());
+        return {};
+    case Instructions::select.value():
+    case Instructions::select_typed.value(): {
+        auto condition = take_operand(TRY(pop()));
+        auto rhs = take_operand(TRY(pop()));
+        auto lhs = take_operand(TRY(pop()));
+        emit({ .operation = Operation::Select, .destination = push(), .lhs = lhs, .rhs = rhs, .immediate = condition });
+        return {};
+    }
+    case Instructions::i32_const.value():
+        emit({ .operation = Operation::Const, .destination = push(), .immediate = static_cast<u32>(instruction.arguments().get<i32>()) });
+        return {};
+    case Instructions::i64_const.value():
+        emit({ .operation = Operation::Const, .destination = push(), .immediate = bit_cast<u64>(instruction.arguments().get<i64>()) });
+        return {};
+    case Instructions::f32_const.value():
+        emit({ .operation = Operation::Const, .destination = push(), .immediate = bit_cast<u32>(instruction.arguments().get<float>()) });
+        return {};
+    case Instructions::f64_const.value():
+        emit({ .operation = Operation::Const, .destination = push(), .immediate = bit_cast<u64>(instruction.arguments().get<double>()) });
+        return {};
+#define __ENUMERATE_OPERATION(name, ...) \
+    case Instructions::name.value():     \
+        return lower_unary(Operation::name);
+        ENUMERATE_WASM_LOWERED_UNARY_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+#define __ENUMERATE_OPERATION(name, ...) \
+    case Instructions::name.value():     \
+        return lower_binary(Operation::name);
+        ENUMERATE_WASM_LOWERED_BINARY_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+    default:
+        // FIXME: Lower the table instructions, once they have been implemented.
+        return Error::from_string_literal("Instruction can't be lowered");
+    }
+}
+
+ErrorOr<void> FunctionLowerer::lower_end()
+{
+    auto frame = m_control_stack.take_last();
+    if (frame.kind == ControlFrame::Kind::Function) {
+        if (!m_unreachable) {
+            if (m_height < frame.result_count)
+                return Error::from_string_literal("Missing return values");
+            emit({ .operation = Operation::Return, .lhs = static_cast<u32>(m_height - frame.result_count), .rhs = static_cast<u32>(frame.result_count) });
+        }
+        return {};
+    }
+
+    // Where the block ended normally, the results already are right above its base.
+    auto end = m_lowered->instructions.size();
+    for (auto jump : frame.jumps_to_end)
+        m_lowered->instructions[jump].immediate = end;
+    if (frame.jump_to_else.has_value())
+        m_lowered->instructions[*frame.jump_to_else].immediate = end;
+    bind_label();
+
+    m_height = frame.base + frame.result_count;
+    m_lowered->slot_count = max(m_lowered->slot_count, static_cast<size_t>(m_height));
+    m_unreachable = false;
+    return {};
+}
+
+ErrorOr<void> FunctionLowerer::lower_unary(Operation operation)
+{
+    auto operand = take_operand(TRY(pop()));
+    emit({ .operation = operation, .destination = push(), .lhs = operand });
+    return {};
+}
+
+ErrorOr<void> FunctionLowerer::lower_binary(Operation operation)
+{
+    auto rhs = take_operand(TRY(pop()));
+    auto lhs = take_operand(TRY(pop()));
+    emit({ .operation = operation, .destination = push(), .lhs = lhs, .rhs = rhs });
+    return {};
+}
+
+ErrorOr<void> FunctionLowerer::lower_call(LoweredFunction::Instruction instruction, FunctionType const& type)
+{
+    if (has_vectors(type))
+        return Error::from_string_literal("Vector values can't be lowered");
+
+    // The callee's slots start at its first argument, so the arguments become its parameters without being moved,
+    // and it leaves its results right where the arguments were.
+    if (m_height - m_control_stack.last().base < type.parameters().size())
+        return Error::from_string_literal("Missing call arguments");
+    instruction.destination = m_height - type.parameters().size();
+    emit(instruction);
+
+    m_height = instruction.destination + type.results().size();
+    m_lowered->slot_count = max(m_lowered->slot_count, static_cast<size_t>(m_height));
+    return {};
+}
+
+ErrorOr<void> FunctionLowerer::lower_branch(LabelIndex label)
+{
+    auto& target = *TRY(frame_for_label(label));
+    auto arity = target.branch_arity();
+    if (m_height - m_control_stack.last().base < arity)
+        return Error::from_string_literal("Missing branch values");
+    auto first_value = static_cast<u32>(m_height - arity);
+
+    if (target.kind == ControlFrame::Kind::Function) {
+        emit({ .operation = Operation::Return, .lhs = first_value, .rhs = static_cast<u32>(arity) });
+        return {};
+    }
+
+    // The carried values can only ever move down the stack, so copying them in order doesn't clobber any of them.
+    for (u32 i = 0; i < arity; ++i) {
+        if (first_value + i != target.base + i)
+            emit({ .operation = Operation::Copy, .destination = target.base + i, .lhs = first_value + i });
+    }
+    emit_jump(Operation::Jump, 0, target);
+    return {};
+}
+
+ErrorOr<FunctionLowerer::Signature> FunctionLowerer::signature_of(BlockType const& type) const
+{
+    switch (type.kind()) {
+    case BlockType::Empty:
+        return Signature {};
+    case BlockType::Type:
+        if (type.value_type().kind() == ValueType::V128)
+            return Error::from_string_literal("Vector values can't be lowered");
+        return Signature { .result_count = 1 };
+    case BlockType::Index: {
+        auto index = type.type_index().value();
+        if (index >= m_context.types.size())
+            return Error::from_string_literal("Invalid type index");
+        auto& function_type = m_context.types[index];
+        if (has_vectors(function_type))
+            return Error::from_string_literal("Vector values can't be lowered");
+        return Signature { .parameter_count = function_type.parameters().size(), .result_count = function_type.results().size() };
+    }
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ErrorOr<FunctionLowerer::ControlFrame*> FunctionLowerer::frame_for_label(LabelIndex label)
+{
+    if (label.value() >= m_control_stack.size())
+        return Error::from_string_literal("Invalid label index");
+    return &m_control_stack[m_control_stack.size() - 1 - label.value()];
+}
+
+u32 FunctionLowerer::push()
+{
+    auto slot = m_height++;
+    m_lowered->slot_count = max(m_lowered->slot_count, static_cast<size_t>(m_height));
+    return slot;
+}
+
+ErrorOr<u32> FunctionLowerer::pop()
+{
+    if (m_height <= m_control_stack.last().base)
+        return Error::from_string_literal("Operand stack underflow");
+    return --m_height;
+}
+
+size_t FunctionLowerer::emit(LoweredFunction::Instruction instruction)
+{
+    m_lowered->instructions.append(instruction);
+    return m_lowered->instructions.size() - 1;
+}
+
+void FunctionLowerer::emit_jump(Operation operation, u32 condition, ControlFrame& target)
+{
+    auto jump = emit({ .operation = operation, .lhs = condition });
+    if (target.kind == ControlFrame::Kind::Loop)
+        m_lowered->instructions[jump].immediate = target.loop_start;
+    else
+        target.jumps_to_end.append(jump);
+}
+
+u32 FunctionLowerer::take_operand(u32 slot)
+{
+    // A value that was only just copied into its slot is read from where it was copied from instead,
+    // which turns e.g. `local.get 0; local.get 1; i32.add` into a single instruction. That isn't possible
+    // if a jump may land in between the copy and its use, as the slot then also gets its value from elsewhere.
+    auto& instructions = m_lowered->instructions;
+    if (instructions.size() <= m_label_position)
+        return slot;
+    auto& last = instructions.last();
+    if (last.operation != Operation::Copy || last.destination != slot)
+        return slot;
+    return instructions.take_last().lhs;
+}
+
+bool FunctionLowerer::redirect_last_result(u32 slot, u32 destination)
+{
+    // Likewise, a value that is stored into a local right after being computed is computed into the local directly.
+    auto& instructions = m_lowered->instructions;
+    if (instructions.size() <= m_label_position)
+        return false;
+    auto& last = instructions.last();
+    if (last.destination != slot || !writes_only_its_destination(last.operation))
+        return false;
+    last.destination = destination;
+    return true;
+}
+
+ErrorOr<NonnullOwnPtr<LoweredFunction>> lower_function(Context const& context, FunctionType const& type, Module::Function const& function)
+{
+    return FunctionLowerer { context, type, function }.lower();
+}
+
+}
@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
+#include <LibWasm/AbstractMachine/Validator.h>
+
+namespace Wasm {
+
+// Lowers the body of a function into register code (see LoweredFunction), given the context its module was validated in.
+// This relies on the body having passed validation, and fails for bodies that use something register code can't express yet.
+ErrorOr<NonnullOwnPtr<LoweredFunction>> lower_function(Context const&, FunctionType const&, Module::Function const&);
+
+}
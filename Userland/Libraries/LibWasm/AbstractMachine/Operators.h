@@ -9,8 +9,10 @@
 #include <AK/BitCast.h>
 #include <AK/BuiltinWrappers.h>
 #include <AK/Result.h>
+#include <AK/SIMD.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
+#include <AK/UFixedBigInt.h>
 #include <limits.h>
 #include <math.h>
 
@@ -128,6 +130,9 @@ struct Minimum {
                 return lhs > 0 ? rhs : lhs;
             if (isinf(rhs))
                 return rhs > 0 ? lhs : rhs;
+            // Zeros compare equal, but -0 is still the smaller one.
+            if (lhs == 0 && rhs == 0)
+                return signbit(lhs) ? lhs : rhs;
         }
         return min(lhs, rhs);
     }
@@ -147,6 +152,8 @@ struct Maximum {
                 return lhs > 0 ? lhs : rhs;
             if (isinf(rhs))
                 return rhs > 0 ? rhs : lhs;
+            if (lhs == 0 && rhs == 0)
+                return signbit(lhs) ? rhs : lhs;
         }
         return max(lhs, rhs);
     }
@@ -453,4 +460,441 @@ struct SaturatingTruncate {
     static StringView name() { return "truncate.saturating"sv; }
 };
 
+
+// Vector
+// All of these operate on v128 values, which are viewed as a native vector of lanes of the given type.
+// Whatever can be expressed with the operators of the vector types is mapped onto the host's vector
+// instructions by the compiler, the rest works lane by lane on those same vectors.
+
+template<typename Lane>
+struct NativeVectorType;
+
+#define DEFINE_NATIVE_VECTOR_TYPE(Lane, Type)   \
+    template<>                                  \
+    struct NativeVectorType<Lane> {             \
+        using Vector = AK::SIMD::Type;          \
+    }
+
+DEFINE_NATIVE_VECTOR_TYPE(i8, i8x16);
+DEFINE_NATIVE_VECTOR_TYPE(u8, u8x16);
+DEFINE_NATIVE_VECTOR_TYPE(i16, i16x8);
+DEFINE_NATIVE_VECTOR_TYPE(u16, u16x8);
+DEFINE_NATIVE_VECTOR_TYPE(i32, i32x4);
+DEFINE_NATIVE_VECTOR_TYPE(u32, u32x4);
+DEFINE_NATIVE_VECTOR_TYPE(i64, i64x2);
+DEFINE_NATIVE_VECTOR_TYPE(u64, u64x2);
+DEFINE_NATIVE_VECTOR_TYPE(float, f32x4);
+DEFINE_NATIVE_VECTOR_TYPE(double, f64x2);
+
+#undef DEFINE_NATIVE_VECTOR_TYPE
+
+template<typename Lane>
+using NativeVector = typename NativeVectorType<Lane>::Vector;
+
+template<typename Lane>
+static constexpr size_t lane_count = sizeof(u128) / sizeof(Lane);
+
+template<typename Lane>
+ALWAYS_INLINE static NativeVector<Lane> as_vector(u128 value)
+{
+    return bit_cast<NativeVector<Lane>>(value);
+}
+
+template<typename Vector>
+ALWAYS_INLINE static u128 from_vector(Vector vector)
+{
+    return bit_cast<u128>(vector);
+}
+
+template<typename Lane, typename Operator>
+struct VectorOperation {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        // Comparisons yield lanes of all ones or all zeros, exactly like the Wasm ones are specified to.
+        return from_vector(Operator {}(as_vector<Lane>(lhs), as_vector<Lane>(rhs)));
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+
+template<typename Lane, typename Operator>
+struct VectorLanewiseOperation {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_lanes = as_vector<Lane>(lhs);
+        auto rhs_lanes = as_vector<Lane>(rhs);
+        NativeVector<Lane> result;
+        for (size_t i = 0; i < lane_count<Lane>; ++i)
+            result[i] = Operator {}(lhs_lanes[i], rhs_lanes[i]);
+        return from_vector(result);
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+
+template<typename Lane, typename Operator>
+struct VectorLanewiseUnaryOperation {
+    u128 operator()(u128 value) const
+    {
+        auto lanes = as_vector<Lane>(value);
+        NativeVector<Lane> result;
+        for (size_t i = 0; i < lane_count<Lane>; ++i)
+            result[i] = Operator {}(lanes[i]);
+        return from_vector(result);
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+
+struct VectorAndNot {
+    u128 operator()(u128 lhs, u128 rhs) const { return from_vector(as_vector<u64>(lhs) & ~as_vector<u64>(rhs)); }
+
+    static StringView name() { return "andnot"sv; }
+};
+struct VectorNot {
+    u128 operator()(u128 value) const { return from_vector(~as_vector<u64>(value)); }
+
+    static StringView name() { return "not"sv; }
+};
+struct VectorAnyTrue {
+    i32 operator()(u128 value) const { return value != 0u; }
+
+    static StringView name() { return "any_true"sv; }
+};
+template<typename Lane>
+struct VectorAllTrue {
+    i32 operator()(u128 value) const
+    {
+        auto lanes = as_vector<Lane>(value);
+        for (size_t i = 0; i < lane_count<Lane>; ++i) {
+            if (lanes[i] == 0)
+                return 0;
+        }
+        return 1;
+    }
+
+    static StringView name() { return "all_true"sv; }
+};
+template<typename Lane>
+struct VectorBitmask {
+    i32 operator()(u128 value) const
+    {
+        auto lanes = as_vector<MakeSigned<Lane>>(value);
+        i32 result = 0;
+        for (size_t i = 0; i < lane_count<Lane>; ++i) {
+            if (lanes[i] < 0)
+                result |= 1 << i;
+        }
+        return result;
+    }
+
+    static StringView name() { return "bitmask"sv; }
+};
+
+// Integer lanes wrap around on overflow, which is what arithmetic on their unsigned counterparts does.
+template<typename Lane>
+struct VectorNegate {
+    u128 operator()(u128 value) const
+    {
+        if constexpr (IsFloatingPoint<Lane>) {
+            using Bits = Conditional<IsSame<Lane, float>, u32, u64>;
+            return from_vector(as_vector<Bits>(value) ^ (static_cast<Bits>(1) << (sizeof(Bits) * 8 - 1)));
+        } else {
+            return from_vector(0 - as_vector<MakeUnsigned<Lane>>(value));
+        }
+    }
+
+    static StringView name() { return "neg"sv; }
+};
+template<typename Lane>
+struct VectorAbsolute {
+    u128 operator()(u128 value) const
+    {
+        if constexpr (IsFloatingPoint<Lane>) {
+            using Bits = Conditional<IsSame<Lane, float>, u32, u64>;
+            return from_vector(as_vector<Bits>(value) & ~(static_cast<Bits>(1) << (sizeof(Bits) * 8 - 1)));
+        } else {
+            auto lanes = as_vector<Lane>(value);
+            auto negated = as_vector<Lane>(VectorNegate<Lane> {}(value));
+            NativeVector<Lane> result;
+            for (size_t i = 0; i < lane_count<Lane>; ++i)
+                result[i] = lanes[i] < 0 ? negated[i] : lanes[i];
+            return from_vector(result);
+        }
+    }
+
+    static StringView name() { return "abs"sv; }
+};
+
+template<typename Lane>
+struct VectorShiftLeft {
+    u128 operator()(u128 lhs, i32 rhs) const { return from_vector(as_vector<MakeUnsigned<Lane>>(lhs) << (static_cast<u32>(rhs) % (sizeof(Lane) * 8))); }
+
+    static StringView name() { return "<<"sv; }
+};
+// Signed lanes are shifted arithmetically, unsigned ones logically.
+template<typename Lane>
+struct VectorShiftRight {
+    u128 operator()(u128 lhs, i32 rhs) const { return from_vector(as_vector<Lane>(lhs) >> (static_cast<u32>(rhs) % (sizeof(Lane) * 8))); }
+
+    static StringView name() { return ">>"sv; }
+};
+
+struct VectorBitSelect {
+    u128 operator()(u128 lhs, u128 rhs, u128 mask) const
+    {
+        auto mask_lanes = as_vector<u64>(mask);
+        return from_vector((as_vector<u64>(lhs) & mask_lanes) | (as_vector<u64>(rhs) & ~mask_lanes));
+    }
+
+    static StringView name() { return "bitselect"sv; }
+};
+
+template<typename Lane>
+struct VectorSplat {
+    template<typename Scalar>
+    u128 operator()(Scalar value) const
+    {
+        NativeVector<Lane> result;
+        for (size_t i = 0; i < lane_count<Lane>; ++i)
+            result[i] = static_cast<Lane>(value);
+        return from_vector(result);
+    }
+
+    static StringView name() { return "splat"sv; }
+};
+
+// Unsigned lanes are zero extended into the result, signed ones sign extended.
+template<typename Lane, typename ResultT>
+struct VectorExtractLane {
+    ResultT operator()(u128 value) const
+    {
+        auto lane_value = as_vector<Lane>(value)[lane];
+        if constexpr (IsFloatingPoint<Lane>)
+            return lane_value;
+        else
+            return static_cast<ResultT>(static_cast<Conditional<IsSigned<Lane>, MakeSigned<ResultT>, MakeUnsigned<ResultT>>>(lane_value));
+    }
+
+    static StringView name() { return "extract_lane"sv; }
+
+    u8 lane { 0 };
+};
+template<typename Lane>
+struct VectorReplaceLane {
+    template<typename Scalar>
+    u128 operator()(u128 vector, Scalar value) const
+    {
+        auto lanes = as_vector<Lane>(vector);
+        lanes[lane] = static_cast<Lane>(value);
+        return from_vector(lanes);
+    }
+
+    static StringView name() { return "replace_lane"sv; }
+
+    u8 lane { 0 };
+};
+
+struct VectorShuffle {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_lanes = as_vector<u8>(lhs);
+        auto rhs_lanes = as_vector<u8>(rhs);
+        AK::SIMD::u8x16 result;
+        for (size_t i = 0; i < 16; ++i)
+            result[i] = lanes[i] < 16 ? lhs_lanes[lanes[i]] : rhs_lanes[lanes[i] - 16];
+        return from_vector(result);
+    }
+
+    static StringView name() { return "shuffle"sv; }
+
+    u8 const* lanes { nullptr };
+};
+struct VectorSwizzle {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lanes = as_vector<u8>(lhs);
+        auto indices = as_vector<u8>(rhs);
+        AK::SIMD::u8x16 result;
+        for (size_t i = 0; i < 16; ++i)
+            result[i] = indices[i] < 16 ? lanes[indices[i]] : 0;
+        return from_vector(result);
+    }
+
+    static StringView name() { return "swizzle"sv; }
+};
+
+// Widens half of the lanes of a vector, the ones with the lower indices or the higher ones.
+enum class VectorHalf {
+    Low,
+    High,
+};
+
+template<typename Lane, typename ResultLane, VectorHalf half>
+struct VectorExtend {
+    u128 operator()(u128 value) const
+    {
+        auto lanes = as_vector<Lane>(value);
+        constexpr size_t first_lane = half == VectorHalf::Low ? 0 : lane_count<ResultLane>;
+        NativeVector<ResultLane> result;
+        for (size_t i = 0; i < lane_count<ResultLane>; ++i)
+            result[i] = static_cast<ResultLane>(lanes[first_lane + i]);
+        return from_vector(result);
+    }
+
+    static StringView name() { return "extend"sv; }
+};
+template<typename Lane, typename ResultLane, VectorHalf half>
+struct VectorExtendMultiply {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_lanes = as_vector<ResultLane>(VectorExtend<Lane, ResultLane, half> {}(lhs));
+        auto rhs_lanes = as_vector<ResultLane>(VectorExtend<Lane, ResultLane, half> {}(rhs));
+        return from_vector(lhs_lanes * rhs_lanes);
+    }
+
+    static StringView name() { return "extmul"sv; }
+};
+template<typename Lane, typename ResultLane>
+struct VectorExtendAddPairwise {
+    u128 operator()(u128 value) const
+    {
+        auto lanes = as_vector<Lane>(value);
+        NativeVector<ResultLane> result;
+        for (size_t i = 0; i < lane_count<ResultLane>; ++i)
+            result[i] = static_cast<ResultLane>(lanes[2 * i]) + static_cast<ResultLane>(lanes[2 * i + 1]);
+        return from_vector(result);
+    }
+
+    static StringView name() { return "extadd_pairwise"sv; }
+};
+struct VectorDotProduct {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_lanes = as_vector<i16>(lhs);
+        auto rhs_lanes = as_vector<i16>(rhs);
+        AK::SIMD::u32x4 result;
+        // Both products being -32768 * -32768 overflows the sum, which has to wrap around.
+        for (size_t i = 0; i < 4; ++i)
+            result[i] = static_cast<u32>(lhs_lanes[2 * i] * rhs_lanes[2 * i]) + static_cast<u32>(lhs_lanes[2 * i + 1] * rhs_lanes[2 * i + 1]);
+        return from_vector(result);
+    }
+
+    static StringView name() { return "dot"sv; }
+};
+
+// Narrows the lanes of both vectors into one, saturating each to the range of the (signed or unsigned) result lanes.
+template<typename Lane, typename ResultLane>
+struct VectorNarrow {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_lanes = as_vector<Lane>(lhs);
+        auto rhs_lanes = as_vector<Lane>(rhs);
+        NativeVector<ResultLane> result;
+        for (size_t i = 0; i < lane_count<Lane>; ++i) {
+            result[i] = saturate(lhs_lanes[i]);
+            result[lane_count<Lane> + i] = saturate(rhs_lanes[i]);
+        }
+        return from_vector(result);
+    }
+
+    static ResultLane saturate(Lane value)
+    {
+        return static_cast<ResultLane>(clamp<Lane>(value, NumericLimits<ResultLane>::min(), NumericLimits<ResultLane>::max()));
+    }
+
+    static StringView name() { return "narrow"sv; }
+};
+
+template<typename Lane>
+struct SaturatingAdd {
+    Lane operator()(Lane lhs, Lane rhs) const
+    {
+        auto sum = static_cast<i32>(lhs) + static_cast<i32>(rhs);
+        return static_cast<Lane>(clamp<i32>(sum, NumericLimits<Lane>::min(), NumericLimits<Lane>::max()));
+    }
+
+    static StringView name() { return "add_sat"sv; }
+};
+template<typename Lane>
+struct SaturatingSubtract {
+    Lane operator()(Lane lhs, Lane rhs) const
+    {
+        auto difference = static_cast<i32>(lhs) - static_cast<i32>(rhs);
+        return static_cast<Lane>(clamp<i32>(difference, NumericLimits<Lane>::min(), NumericLimits<Lane>::max()));
+    }
+
+    static StringView name() { return "sub_sat"sv; }
+};
+struct AverageRounded {
+    template<typename Lane>
+    Lane operator()(Lane lhs, Lane rhs) const { return static_cast<Lane>((static_cast<u32>(lhs) + static_cast<u32>(rhs) + 1) / 2); }
+
+    static StringView name() { return "avgr"sv; }
+};
+struct Q15MultiplyRoundSaturate {
+    i16 operator()(i16 lhs, i16 rhs) const
+    {
+        auto product = (static_cast<i32>(lhs) * static_cast<i32>(rhs) + 0x4000) >> 15;
+        return static_cast<i16>(clamp<i32>(product, NumericLimits<i16>::min(), NumericLimits<i16>::max()));
+    }
+
+    static StringView name() { return "q15mulr_sat"sv; }
+};
+struct LanePopCount {
+    u8 operator()(u8 lane) const { return popcount(lane); }
+
+    static StringView name() { return "popcnt"sv; }
+};
+
+struct PseudoMinimum {
+    template<typename Lane>
+    Lane operator()(Lane lhs, Lane rhs) const { return rhs < lhs ? rhs : lhs; }
+
+    static StringView name() { return "pmin"sv; }
+};
+struct PseudoMaximum {
+    template<typename Lane>
+    Lane operator()(Lane lhs, Lane rhs) const { return lhs < rhs ? rhs : lhs; }
+
+    static StringView name() { return "pmax"sv; }
+};
+// Truncate only yields a Result to fit in with the checked operations, lanes can't trap.
+struct TruncateFloat {
+    template<typename Lane>
+    Lane operator()(Lane value) const
+    {
+        if constexpr (IsSame<Lane, float>)
+            return truncf(value);
+        else
+            return trunc(value);
+    }
+
+    static StringView name() { return "trunc"sv; }
+};
+
+// Unlike Convert, this honors the signedness of the lane type it's given.
+template<typename ResultT>
+struct LaneConvert {
+    template<typename Lhs>
+    ResultT operator()(Lhs lhs) const { return static_cast<ResultT>(lhs); }
+
+    static StringView name() { return "convert"sv; }
+};
+
+// Converts the lanes of a vector into as many lanes of the result as fit, the remaining ones are zeroed.
+template<typename Lane, typename ResultLane, typename Operator>
+struct VectorConvert {
+    u128 operator()(u128 value) const
+    {
+        auto lanes = as_vector<Lane>(value);
+        NativeVector<ResultLane> result {};
+        for (size_t i = 0; i < min(lane_count<Lane>, lane_count<ResultLane>); ++i)
+            result[i] = Operator {}(lanes[i]);
+        return from_vector(result);
+    }
+
+    static StringView name() { return Operator::name(); }
+};
+
 }
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/Endian.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/GuardPages.h>
+#include <LibWasm/AbstractMachine/Operators.h>
+#include <LibWasm/AbstractMachine/RegisterInterpreter.h>
+
+namespace Wasm {
+
+using Operation = LoweredFunction::Operation;
+
+#define TRAP(reason)              \
+    do {                          \
+        m_trap = Trap { reason }; \
+        return;                   \
+    } while (false)
+
+// i32 and f32 values live in the low 32 bits of their slot, with the upper bits cleared.
+template<typename T>
+static ALWAYS_INLINE T slot_as(u64 slot)
+{
+    if constexpr (IsSame<T, float>)
+        return bit_cast<float>(static_cast<u32>(slot));
+    else if constexpr (IsSame<T, double>)
+        return bit_cast<double>(slot);
+    else
+        return static_cast<T>(slot);
+}
+
+template<typename T>
+static ALWAYS_INLINE u64 to_slot(T value)
+{
+    if constexpr (IsSame<T, float>)
+        return bit_cast<u32>(value);
+    else if constexpr (IsSame<T, double>)
+        return bit_cast<u64>(value);
+    else
+        return static_cast<MakeUnsigned<T>>(value);
+}
+
+static u64 value_to_slot(Value const& value)
+{
+    return value.value().visit(
+        [](Reference const& reference) {
+            return reference.ref().visit(
+                [](Reference::Null const&) { return LoweredFunction::null_reference; },
+                [](auto const& reference) { return reference.address.value(); });
+        },
+        [](u128) -> u64 {
+            // Functions that handle vectors are never lowered, see FunctionLowerer.
+            VERIFY_NOT_REACHED();
+        },
+        [](auto value) { return to_slot(value); });
+}
+
+static Value slot_to_value(ValueType type, u64 slot)
+{
+    switch (type.kind()) {
+    case ValueType::I32:
+        return Value(slot_as<i32>(slot));
+    case ValueType::I64:
+        return Value(slot_as<i64>(slot));
+    case ValueType::F32:
+        return Value(slot_as<float>(slot));
+    case ValueType::F64:
+        return Value(slot_as<double>(slot));
+    case ValueType::FunctionReference:
+    case ValueType::ExternReference:
+        if (slot == LoweredFunction::null_reference)
+            return Value(Reference { Reference::Null { type } });
+        return Value(type, slot);
+    case ValueType::NullFunctionReference:
+        return Value(Reference { Reference::Null { ValueType(ValueType::FunctionReference) } });
+    case ValueType::NullExternReference:
+        return Value(Reference { Reference::Null { ValueType(ValueType::ExternReference) } });
+    case ValueType::V128:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+template<typename T>
+static ALWAYS_INLINE T read_from_memory(u8 const* data)
+{
+    if constexpr (IsFloatingPoint<T>) {
+        return bit_cast<T>(read_from_memory<Conditional<IsSame<T, float>, u32, u64>>(data));
+    } else {
+        T value;
+        __builtin_memcpy(&value, data, sizeof(T));
+        return AK::convert_between_host_and_little_endian(value);
+    }
+}
+
+template<typename T>
+static ALWAYS_INLINE void write_to_memory(u8* data, T value)
+{
+    if constexpr (IsFloatingPoint<T>) {
+        write_to_memory(data, bit_cast<Conditional<IsSame<T, float>, u32, u64>>(value));
+    } else {
+        value = AK::convert_between_host_and_little_endian(value);
+        __builtin_memcpy(data, &value, sizeof(T));
+    }
+}
+
+// Stores the result of an operator into its slot, or returns the reason the operation trapped.
+template<typename PushType, typename OperatorResult>
+static ALWAYS_INLINE Optional<StringView> store_result(u64& slot, OperatorResult result)
+{
+    if constexpr (IsSpecializationOf<OperatorResult, AK::Result>) {
+        if (result.is_error())
+            return result.error();
+        slot = to_slot(static_cast<PushType>(result.release_value()));
+    } else {
+        slot = to_slot(static_cast<PushType>(result));
+    }
+    return {};
+}
+
+bool RegisterInterpreter::ensure_slots(size_t count)
+{
+    if (m_slots.size() >= count)
+        return true;
+    return !m_slots.try_resize(max(count, m_slots.size() * 2)).is_error();
+}
+
+void RegisterInterpreter::interpret(Configuration& configuration)
+{
+    auto base = m_slots_in_use;
+    auto* function = configuration.frame().function();
+    auto* lowered = function ? function->lowered_body() : nullptr;
+    if (!lowered) {
+        BytecodeInterpreter::interpret(configuration);
+        return;
+    }
+
+    m_trap.clear();
+
+    if (!ensure_slots(base + lowered->slot_count))
+        TRAP("Out of memory for locals");
+    auto& locals = configuration.frame().locals();
+    for (size_t i = 0; i < lowered->parameter_count; ++i)
+        m_slots[base + i] = value_to_slot(locals[i]);
+
+    execute(configuration, *lowered, configuration.frame().module(), base);
+    m_slots_in_use = base;
+    if (m_trap.has_value())
+        return;
+
+    for (size_t i = 0; i < lowered->result_types.size(); ++i)
+        configuration.stack().push(slot_to_value(lowered->result_types[i], m_slots[base + i]));
+}
+
+bool RegisterInterpreter::call(Configuration& configuration, FunctionAddress address, size_t arguments)
+{
+    if (m_stack_info.size_free() < Constants::minimum_stack_space_to_keep_free) {
+        m_trap = Trap { "Call stack exhausted" };
+        return false;
+    }
+
+    auto* instance = configuration.store().get(address);
+    if (!instance) {
+        m_trap = Trap { "Call to nonexistent function" };
+        return false;
+    }
+
+    // Lowered functions are executed right away, with their slots starting at the arguments.
+    if (auto* function = instance->get_pointer<WasmFunction>(); function && function->code().lowered_body()) {
+        auto slots_in_use = m_slots_in_use;
+        execute(configuration, *function->code().lowered_body(), function->module(), arguments);
+        m_slots_in_use = slots_in_use;
+        return !m_trap.has_value();
+    }
+
+    // Everything else goes through the configuration, like calls made by the BytecodeInterpreter.
+    FunctionType const* type { nullptr };
+    instance->visit([&](auto const& function) { type = &function.type(); });
+    Vector<Value> values;
+    values.ensure_capacity(type->parameters().size());
+    for (size_t i = 0; i < type->parameters().size(); ++i)
+        values.unchecked_append(slot_to_value(type->parameters()[i], m_slots[arguments + i]));
+
+    Result result { Trap { ""sv } };
+    {
+        CallFrameHandle handle { *this, configuration };
+        result = configuration.call(*this, address, move(values));
+    }
+    if (result.is_trap()) {
+        m_trap = move(result.trap());
+        return false;
+    }
+
+    // The results come back with the last one first.
+    auto& results = result.values();
+    for (size_t i = 0; i < results.size(); ++i)
+        m_slots[arguments + i] = value_to_slot(results[results.size() - i - 1]);
+    return true;
+}
+
+void RegisterInterpreter::execute(Configuration& configuration, LoweredFunction const& function, ModuleInstance const& module, size_t base)
+{
+    // See BytecodeInterpreter::interpret(). This is done here rather than in interpret(), since lowered functions call
+    // each other directly.
+    Optional<GuardPageFaultScope> fault_scope;
+    if (configuration.store().has_guard_page_memories()) {
+        fault_scope.emplace(configuration.store());
+        if (sigsetjmp(fault_scope->jump_buffer(), 0) != 0)
+            TRAP("Memory access out of bounds");
+    }
+
+    if (!ensure_slots(base + function.slot_count))
+        TRAP("Out of memory for locals");
+    m_slots_in_use = base + function.slot_count;
+
+    auto* slots = m_slots.data() + base;
+    for (size_t i = 0; i < function.local_initializers.size(); ++i)
+        slots[function.parameter_count + i] = function.local_initializers[i];
+
+    auto& store = configuration.store();
+    auto* memory = module.memories().is_empty() ? nullptr : store.get(module.memories().first());
+    // Accesses to memories with guard pages fault instead when they are out of bounds.
+    auto check_bounds = memory && !memory->has_guard_pages();
+    auto const* instructions = function.instructions.data();
+    auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
+    u64 executed_instructions = 0;
+    size_t ip = 0;
+
+    for (;;) {
+        if (should_limit_instruction_count) {
+            if (executed_instructions++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]]
+                TRAP("Exceeded maximum allowed number of instructions");
+        }
+
+        auto const& instruction = instructions[ip++];
+        switch (instruction.operation) {
+        case Operation::Unreachable:
+            TRAP("Unreachable");
+        case Operation::Copy:
+            slots[instruction.destination] = slots[instruction.lhs];
+            break;
+        case Operation::Const:
+            slots[instruction.destination] = instruction.immediate;
+            break;
+        case Operation::Jump:
+            ip = instruction.immediate;
+            break;
+        case Operation::JumpIfZero:
+            if (static_cast<u32>(slots[instruction.lhs]) == 0)
+                ip = instruction.immediate;
+            break;
+        case Operation::JumpIfNotZero:
+            if (static_cast<u32>(slots[instruction.lhs]) != 0)
+                ip = instruction.immediate;
+            break;
+        case Operation::BranchTable: {
+            auto const* table = function.branch_tables.data() + instruction.immediate;
+            ip = table[1 + min(static_cast<u32>(slots[instruction.lhs]), table[0])];
+            break;
+        }
+        case Operation::Return:
+            for (size_t i = 0; i < instruction.rhs; ++i)
+                slots[i] = slots[instruction.lhs + i];
+            return;
+        case Operation::Call:
+        case Operation::CallIndirect: {
+            FunctionAddress address;
+            if (instruction.operation == Operation::Call) {
+                address = module.functions()[instruction.immediate];
+            } else {
+                auto& elements = store.get(module.tables()[instruction.rhs])->elements();
+                auto index = static_cast<u32>(slots[instruction.lhs]);
+                if (index >= elements.size())
+                    TRAP("Indirect call to an element outside of the table");
+                auto& element = elements[index];
+                if (!element.has_value() || !element->ref().has<Reference::Func>())
+                    TRAP("Indirect call to a null or non-function element");
+                address = element->ref().get<Reference::Func>().address;
+
+                auto* callee = store.get(address);
+                if (!callee)
+                    TRAP("Indirect call to nonexistent function");
+                FunctionType const* type { nullptr };
+                callee->visit([&](auto const& function) { type = &function.type(); });
+                auto& expected_type = module.types()[instruction.immediate];
+                if (type->parameters() != expected_type.parameters() || type->results() != expected_type.results())
+                    TRAP("Indirect call to a function of the wrong type");
+            }
+            if (!call(configuration, address, base + instruction.destination))
+                return;
+            // The call may have resized the slots, or allocated in the store.
+            slots = m_slots.data() + base;
+            memory = module.memories().is_empty() ? nullptr : store.get(module.memories().first());
+            check_bounds = memory && !memory->has_guard_pages();
+            break;
+        }
+        case Operation::GlobalGet:
+            slots[instruction.destination] = value_to_slot(store.get(module.globals()[instruction.immediate])->value());
+            break;
+        case Operation::GlobalSet: {
+            auto type = ValueType(static_cast<ValueType::Kind>(instruction.rhs));
+            store.get(module.globals()[instruction.immediate])->set_value(slot_to_value(type, slots[instruction.lhs]));
+            break;
+        }
+        case Operation::RefFunc:
+            slots[instruction.destination] = module.functions()[instruction.immediate].value();
+            break;
+        case Operation::RefIsNull:
+            slots[instruction.destination] = slots[instruction.lhs] == LoweredFunction::null_reference ? 1 : 0;
+            break;
+        case Operation::Select:
+            slots[instruction.destination] = static_cast<u32>(slots[instruction.immediate]) != 0 ? slots[instruction.lhs] : slots[instruction.rhs];
+            break;
+        case Operation::MemorySize:
+            slots[instruction.destination] = static_cast<u32>(memory->size() / Constants::page_size);
+            break;
+        case Operation::MemoryGrow: {
+            auto old_pages = static_cast<u32>(memory->size() / Constants::page_size);
+            auto size_to_grow = static_cast<u64>(static_cast<u32>(slots[instruction.lhs])) * Constants::page_size;
+            slots[instruction.destination] = memory->grow(size_to_grow) ? old_pages : NumericLimits<u32>::max();
+            break;
+        }
+        // https://webassembly.github.io/spec/core/bikeshed/#exec-memory-fill
+        case Operation::MemoryFill: {
+            auto destination = static_cast<u64>(static_cast<u32>(slots[instruction.lhs]));
+            auto value = static_cast<u8>(slots[instruction.lhs + 1]);
+            auto count = static_cast<u64>(static_cast<u32>(slots[instruction.lhs + 2]));
+            if (destination + count > memory->size())
+                TRAP("Memory access out of bounds");
+            __builtin_memset(memory->bytes().data() + destination, value, count);
+            break;
+        }
+        // https://webassembly.github.io/spec/core/bikeshed/#exec-memory-copy
+        case Operation::MemoryCopy: {
+            auto destination = static_cast<u64>(static_cast<u32>(slots[instruction.lhs]));
+            auto source = static_cast<u64>(static_cast<u32>(slots[instruction.lhs + 1]));
+            auto count = static_cast<u64>(static_cast<u32>(slots[instruction.lhs + 2]));
+            if (source + count > memory->size() || destination + count > memory->size())
+                TRAP("Memory access out of bounds");
+            __builtin_memmove(memory->bytes().data() + destination, memory->bytes().data() + source, count);
+            break;
+        }
+        // https://webassembly.github.io/spec/core/bikeshed/#exec-memory-init
+        case Operation::MemoryInit: {
+            auto& data = store.get(module.datas()[instruction.immediate])->data();
+            auto destination = static_cast<u64>(static_cast<u32>(slots[instruction.lhs]));
+            auto source = static_cast<u64>(static_cast<u32>(slots[instruction.lhs + 1]));
+            auto count = static_cast<u64>(static_cast<u32>(slots[instruction.lhs + 2]));
+            if (source + count > data.size() || destination + count > memory->size())
+                TRAP("Memory access out of bounds");
+            if (count != 0)
+                __builtin_memcpy(memory->bytes().data() + destination, data.data() + source, count);
+            break;
+        }
+        // https://webassembly.github.io/spec/core/bikeshed/#exec-data-drop
+        case Operation::DataDrop:
+            *store.get(module.datas()[instruction.immediate]) = DataInstance({});
+            break;
+#define __ENUMERATE_OPERATION(name, pop_type, push_type, operator_)                                                                                     \
+    case Operation::name:                                                                                                                               \
+        if (auto error = store_result<push_type>(slots[instruction.destination], Operators::operator_ {}(slot_as<pop_type>(slots[instruction.lhs]))); error.has_value()) \
+            TRAP(*error);                                                                                                                               \
+        break;
+            ENUMERATE_WASM_LOWERED_UNARY_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+#define __ENUMERATE_OPERATION(name, pop_type, push_type, operator_)                                                               \
+    case Operation::name: {                                                                                                       \
+        auto result = Operators::operator_ {}(slot_as<pop_type>(slots[instruction.lhs]), slot_as<pop_type>(slots[instruction.rhs])); \
+        if (auto error = store_result<push_type>(slots[instruction.destination], move(result)); error.has_value())                \
+            TRAP(*error);                                                                                                         \
+        break;                                                                                                                    \
+    }
+            ENUMERATE_WASM_LOWERED_BINARY_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+#define __ENUMERATE_OPERATION(name, memory_type, push_type)                                                           \
+    case Operation::name: {                                                                                           \
+        auto address = static_cast<u64>(static_cast<u32>(slots[instruction.lhs])) + instruction.immediate;           \
+        if (check_bounds && address + sizeof(memory_type) > memory->size())                                           \
+            TRAP("Memory access out of bounds");                                                                      \
+        auto value = static_cast<push_type>(read_from_memory<memory_type>(memory->bytes().data() + address));         \
+        slots[instruction.destination] = to_slot(value);                                                              \
+        break;                                                                                                        \
+    }
+            ENUMERATE_WASM_LOWERED_LOAD_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+#define __ENUMERATE_OPERATION(name, pop_type, memory_type)                                                           \
+    case Operation::name: {                                                                                          \
+        auto address = static_cast<u64>(static_cast<u32>(slots[instruction.lhs])) + instruction.immediate;          \
+        if (check_bounds && address + sizeof(memory_type) > memory->size())                                          \
+            TRAP("Memory access out of bounds");                                                                     \
+        auto value = static_cast<memory_type>(slot_as<pop_type>(slots[instruction.rhs]));                            \
+        write_to_memory(memory->bytes().data() + address, value);                                                    \
+        break;                                                                                                       \
+    }
+            ENUMERATE_WASM_LOWERED_STORE_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+        }
+    }
+}
+
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/LoweredFunction.h>
+
+namespace Wasm {
+
+// Executes function bodies as register code, lowering each the first time it's run, and falls back to
+// interpreting the bytecode for functions that could not be lowered.
+struct RegisterInterpreter : public BytecodeInterpreter {
+    virtual void interpret(Configuration&) override;
+    virtual ~RegisterInterpreter() override = default;
+
+private:
+    void execute(Configuration&, LoweredFunction const&, ModuleInstance const&, size_t base);
+    bool call(Configuration&, FunctionAddress, size_t arguments);
+    bool ensure_slots(size_t count);
+
+    // All active lowered functions share these, each using the slots from its base up to its slot count.
+    Vector<u64> m_slots;
+    size_t m_slots_in_use { 0 };
+};
+
+}
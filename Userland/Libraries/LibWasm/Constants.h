@@ -15,6 +15,7 @@ static constexpr auto i32_tag = 0x7f;
 static constexpr auto i64_tag = 0x7e;
 static constexpr auto f32_tag = 0x7d;
 static constexpr auto f64_tag = 0x7c;
+static constexpr auto v128_tag = 0x7b;
 static constexpr auto function_reference_tag = 0x70;
 static constexpr auto extern_reference_tag = 0x6f;
 
@@ -40,6 +41,8 @@ static constexpr auto page_size = 64 * KiB;
 // These are not concretely defined by the spec, so the values are only defined by us.
 static constexpr auto minimum_stack_space_to_keep_free = 256 * KiB; // Note: Value is arbitrary and chosen by testing with ASAN
 static constexpr auto max_allowed_executed_instructions_per_call = 256 * 1024 * 1024;
+// Enough address space that no 32-bit address plus 32-bit offset can access past its end.
+static constexpr u64 guard_page_memory_reservation_size = 8 * GiB + page_size;
 static constexpr auto max_allowed_vector_size = 500 * MiB;
 static constexpr auto max_allowed_function_locals_per_type = 42069; // Note: VERY arbitrary.
 
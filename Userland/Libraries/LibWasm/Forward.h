@@ -9,7 +9,9 @@
 namespace Wasm {
 
 class AbstractMachine;
+class LoweredFunction;
 class Validator;
+struct Context;
 struct ValidationError;
 
 }
@@ -220,9 +220,249 @@ namespace Instructions {
     M(structured_else, 0xff00)               \
     M(structured_end, 0xff01)
 
+// These are synthetic opcodes as well, made up of the 0xfd prefix and the LEB128-encoded selector of the instruction.
+#define ENUMERATE_SIMD_WASM_OPCODES(M)       \
+    M(v128_load, 0xfd00)                     \
+    M(v128_load8x8_s, 0xfd01)                \
+    M(v128_load8x8_u, 0xfd02)                \
+    M(v128_load16x4_s, 0xfd03)               \
+    M(v128_load16x4_u, 0xfd04)               \
+    M(v128_load32x2_s, 0xfd05)               \
+    M(v128_load32x2_u, 0xfd06)               \
+    M(v128_load8_splat, 0xfd07)              \
+    M(v128_load16_splat, 0xfd08)             \
+    M(v128_load32_splat, 0xfd09)             \
+    M(v128_load64_splat, 0xfd0a)             \
+    M(v128_store, 0xfd0b)                    \
+    M(v128_const, 0xfd0c)                    \
+    M(i8x16_shuffle, 0xfd0d)                 \
+    M(i8x16_swizzle, 0xfd0e)                 \
+    M(i8x16_splat, 0xfd0f)                   \
+    M(i16x8_splat, 0xfd10)                   \
+    M(i32x4_splat, 0xfd11)                   \
+    M(i64x2_splat, 0xfd12)                   \
+    M(f32x4_splat, 0xfd13)                   \
+    M(f64x2_splat, 0xfd14)                   \
+    M(i8x16_extract_lane_s, 0xfd15)          \
+    M(i8x16_extract_lane_u, 0xfd16)          \
+    M(i8x16_replace_lane, 0xfd17)            \
+    M(i16x8_extract_lane_s, 0xfd18)          \
+    M(i16x8_extract_lane_u, 0xfd19)          \
+    M(i16x8_replace_lane, 0xfd1a)            \
+    M(i32x4_extract_lane, 0xfd1b)            \
+    M(i32x4_replace_lane, 0xfd1c)            \
+    M(i64x2_extract_lane, 0xfd1d)            \
+    M(i64x2_replace_lane, 0xfd1e)            \
+    M(f32x4_extract_lane, 0xfd1f)            \
+    M(f32x4_replace_lane, 0xfd20)            \
+    M(f64x2_extract_lane, 0xfd21)            \
+    M(f64x2_replace_lane, 0xfd22)            \
+    M(i8x16_eq, 0xfd23)                      \
+    M(i8x16_ne, 0xfd24)                      \
+    M(i8x16_lt_s, 0xfd25)                    \
+    M(i8x16_lt_u, 0xfd26)                    \
+    M(i8x16_gt_s, 0xfd27)                    \
+    M(i8x16_gt_u, 0xfd28)                    \
+    M(i8x16_le_s, 0xfd29)                    \
+    M(i8x16_le_u, 0xfd2a)                    \
+    M(i8x16_ge_s, 0xfd2b)                    \
+    M(i8x16_ge_u, 0xfd2c)                    \
+    M(i16x8_eq, 0xfd2d)                      \
+    M(i16x8_ne, 0xfd2e)                      \
+    M(i16x8_lt_s, 0xfd2f)                    \
+    M(i16x8_lt_u, 0xfd30)                    \
+    M(i16x8_gt_s, 0xfd31)                    \
+    M(i16x8_gt_u, 0xfd32)                    \
+    M(i16x8_le_s, 0xfd33)                    \
+    M(i16x8_le_u, 0xfd34)                    \
+    M(i16x8_ge_s, 0xfd35)                    \
+    M(i16x8_ge_u, 0xfd36)                    \
+    M(i32x4_eq, 0xfd37)                      \
+    M(i32x4_ne, 0xfd38)                      \
+    M(i32x4_lt_s, 0xfd39)                    \
+    M(i32x4_lt_u, 0xfd3a)                    \
+    M(i32x4_gt_s, 0xfd3b)                    \
+    M(i32x4_gt_u, 0xfd3c)                    \
+    M(i32x4_le_s, 0xfd3d)                    \
+    M(i32x4_le_u, 0xfd3e)                    \
+    M(i32x4_ge_s, 0xfd3f)                    \
+    M(i32x4_ge_u, 0xfd40)                    \
+    M(f32x4_eq, 0xfd41)                      \
+    M(f32x4_ne, 0xfd42)                      \
+    M(f32x4_lt, 0xfd43)                      \
+    M(f32x4_gt, 0xfd44)                      \
+    M(f32x4_le, 0xfd45)                      \
+    M(f32x4_ge, 0xfd46)                      \
+    M(f64x2_eq, 0xfd47)                      \
+    M(f64x2_ne, 0xfd48)                      \
+    M(f64x2_lt, 0xfd49)                      \
+    M(f64x2_gt, 0xfd4a)                      \
+    M(f64x2_le, 0xfd4b)                      \
+    M(f64x2_ge, 0xfd4c)                      \
+    M(v128_not, 0xfd4d)                      \
+    M(v128_and, 0xfd4e)                      \
+    M(v128_andnot, 0xfd4f)                   \
+    M(v128_or, 0xfd50)                       \
+    M(v128_xor, 0xfd51)                      \
+    M(v128_bitselect, 0xfd52)                \
+    M(v128_any_true, 0xfd53)                 \
+    M(v128_load8_lane, 0xfd54)               \
+    M(v128_load16_lane, 0xfd55)              \
+    M(v128_load32_lane, 0xfd56)              \
+    M(v128_load64_lane, 0xfd57)              \
+    M(v128_store8_lane, 0xfd58)              \
+    M(v128_store16_lane, 0xfd59)             \
+    M(v128_store32_lane, 0xfd5a)             \
+    M(v128_store64_lane, 0xfd5b)             \
+    M(v128_load32_zero, 0xfd5c)              \
+    M(v128_load64_zero, 0xfd5d)              \
+    M(f32x4_demote_f64x2_zero, 0xfd5e)       \
+    M(f64x2_promote_low_f32x4, 0xfd5f)       \
+    M(i8x16_abs, 0xfd60)                     \
+    M(i8x16_neg, 0xfd61)                     \
+    M(i8x16_popcnt, 0xfd62)                  \
+    M(i8x16_all_true, 0xfd63)                \
+    M(i8x16_bitmask, 0xfd64)                 \
+    M(i8x16_narrow_i16x8_s, 0xfd65)          \
+    M(i8x16_narrow_i16x8_u, 0xfd66)          \
+    M(f32x4_ceil, 0xfd67)                    \
+    M(f32x4_floor, 0xfd68)                   \
+    M(f32x4_trunc, 0xfd69)                   \
+    M(f32x4_nearest, 0xfd6a)                 \
+    M(i8x16_shl, 0xfd6b)                     \
+    M(i8x16_shr_s, 0xfd6c)                   \
+    M(i8x16_shr_u, 0xfd6d)                   \
+    M(i8x16_add, 0xfd6e)                     \
+    M(i8x16_add_sat_s, 0xfd6f)               \
+    M(i8x16_add_sat_u, 0xfd70)               \
+    M(i8x16_sub, 0xfd71)                     \
+    M(i8x16_sub_sat_s, 0xfd72)               \
+    M(i8x16_sub_sat_u, 0xfd73)               \
+    M(f64x2_ceil, 0xfd74)                    \
+    M(f64x2_floor, 0xfd75)                   \
+    M(i8x16_min_s, 0xfd76)                   \
+    M(i8x16_min_u, 0xfd77)                   \
+    M(i8x16_max_s, 0xfd78)                   \
+    M(i8x16_max_u, 0xfd79)                   \
+    M(f64x2_trunc, 0xfd7a)                   \
+    M(i8x16_avgr_u, 0xfd7b)                  \
+    M(i16x8_extadd_pairwise_i8x16_s, 0xfd7c) \
+    M(i16x8_extadd_pairwise_i8x16_u, 0xfd7d) \
+    M(i32x4_extadd_pairwise_i16x8_s, 0xfd7e) \
+    M(i32x4_extadd_pairwise_i16x8_u, 0xfd7f) \
+    M(i16x8_abs, 0xfd80)                     \
+    M(i16x8_neg, 0xfd81)                     \
+    M(i16x8_q15mulr_sat_s, 0xfd82)           \
+    M(i16x8_all_true, 0xfd83)                \
+    M(i16x8_bitmask, 0xfd84)                 \
+    M(i16x8_narrow_i32x4_s, 0xfd85)          \
+    M(i16x8_narrow_i32x4_u, 0xfd86)          \
+    M(i16x8_extend_low_i8x16_s, 0xfd87)      \
+    M(i16x8_extend_high_i8x16_s, 0xfd88)     \
+    M(i16x8_extend_low_i8x16_u, 0xfd89)      \
+    M(i16x8_extend_high_i8x16_u, 0xfd8a)     \
+    M(i16x8_shl, 0xfd8b)                     \
+    M(i16x8_shr_s, 0xfd8c)                   \
+    M(i16x8_shr_u, 0xfd8d)                   \
+    M(i16x8_add, 0xfd8e)                     \
+    M(i16x8_add_sat_s, 0xfd8f)               \
+    M(i16x8_add_sat_u, 0xfd90)               \
+    M(i16x8_sub, 0xfd91)                     \
+    M(i16x8_sub_sat_s, 0xfd92)               \
+    M(i16x8_sub_sat_u, 0xfd93)               \
+    M(f64x2_nearest, 0xfd94)                 \
+    M(i16x8_mul, 0xfd95)                     \
+    M(i16x8_min_s, 0xfd96)                   \
+    M(i16x8_min_u, 0xfd97)                   \
+    M(i16x8_max_s, 0xfd98)                   \
+    M(i16x8_max_u, 0xfd99)                   \
+    M(i16x8_avgr_u, 0xfd9b)                  \
+    M(i16x8_extmul_low_i8x16_s, 0xfd9c)      \
+    M(i16x8_extmul_high_i8x16_s, 0xfd9d)     \
+    M(i16x8_extmul_low_i8x16_u, 0xfd9e)      \
+    M(i16x8_extmul_high_i8x16_u, 0xfd9f)     \
+    M(i32x4_abs, 0xfda0)                     \
+    M(i32x4_neg, 0xfda1)                     \
+    M(i32x4_all_true, 0xfda3)                \
+    M(i32x4_bitmask, 0xfda4)                 \
+    M(i32x4_extend_low_i16x8_s, 0xfda7)      \
+    M(i32x4_extend_high_i16x8_s, 0xfda8)     \
+    M(i32x4_extend_low_i16x8_u, 0xfda9)      \
+    M(i32x4_extend_high_i16x8_u, 0xfdaa)     \
+    M(i32x4_shl, 0xfdab)                     \
+    M(i32x4_shr_s, 0xfdac)                   \
+    M(i32x4_shr_u, 0xfdad)                   \
+    M(i32x4_add, 0xfdae)                     \
+    M(i32x4_sub, 0xfdb1)                     \
+    M(i32x4_mul, 0xfdb5)                     \
+    M(i32x4_min_s, 0xfdb6)                   \
+    M(i32x4_min_u, 0xfdb7)                   \
+    M(i32x4_max_s, 0xfdb8)                   \
+    M(i32x4_max_u, 0xfdb9)                   \
+    M(i32x4_dot_i16x8_s, 0xfdba)             \
+    M(i32x4_extmul_low_i16x8_s, 0xfdbc)      \
+    M(i32x4_extmul_high_i16x8_s, 0xfdbd)     \
+    M(i32x4_extmul_low_i16x8_u, 0xfdbe)      \
+    M(i32x4_extmul_high_i16x8_u, 0xfdbf)     \
+    M(i64x2_abs, 0xfdc0)                     \
+    M(i64x2_neg, 0xfdc1)                     \
+    M(i64x2_all_true, 0xfdc3)                \
+    M(i64x2_bitmask, 0xfdc4)                 \
+    M(i64x2_extend_low_i32x4_s, 0xfdc7)      \
+    M(i64x2_extend_high_i32x4_s, 0xfdc8)     \
+    M(i64x2_extend_low_i32x4_u, 0xfdc9)      \
+    M(i64x2_extend_high_i32x4_u, 0xfdca)     \
+    M(i64x2_shl, 0xfdcb)                     \
+    M(i64x2_shr_s, 0xfdcc)                   \
+    M(i64x2_shr_u, 0xfdcd)                   \
+    M(i64x2_add, 0xfdce)                     \
+    M(i64x2_sub, 0xfdd1)                     \
+    M(i64x2_mul, 0xfdd5)                     \
+    M(i64x2_eq, 0xfdd6)                      \
+    M(i64x2_ne, 0xfdd7)                      \
+    M(i64x2_lt_s, 0xfdd8)                    \
+    M(i64x2_gt_s, 0xfdd9)                    \
+    M(i64x2_le_s, 0xfdda)                    \
+    M(i64x2_ge_s, 0xfddb)                    \
+    M(i64x2_extmul_low_i32x4_s, 0xfddc)      \
+    M(i64x2_extmul_high_i32x4_s, 0xfddd)     \
+    M(i64x2_extmul_low_i32x4_u, 0xfdde)      \
+    M(i64x2_extmul_high_i32x4_u, 0xfddf)     \
+    M(f32x4_abs, 0xfde0)                     \
+    M(f32x4_neg, 0xfde1)                     \
+    M(f32x4_sqrt, 0xfde3)                    \
+    M(f32x4_add, 0xfde4)                     \
+    M(f32x4_sub, 0xfde5)                     \
+    M(f32x4_mul, 0xfde6)                     \
+    M(f32x4_div, 0xfde7)                     \
+    M(f32x4_min, 0xfde8)                     \
+    M(f32x4_max, 0xfde9)                     \
+    M(f32x4_pmin, 0xfdea)                    \
+    M(f32x4_pmax, 0xfdeb)                    \
+    M(f64x2_abs, 0xfdec)                     \
+    M(f64x2_neg, 0xfded)                     \
+    M(f64x2_sqrt, 0xfdef)                    \
+    M(f64x2_add, 0xfdf0)                     \
+    M(f64x2_sub, 0xfdf1)                     \
+    M(f64x2_mul, 0xfdf2)                     \
+    M(f64x2_div, 0xfdf3)                     \
+    M(f64x2_min, 0xfdf4)                     \
+    M(f64x2_max, 0xfdf5)                     \
+    M(f64x2_pmin, 0xfdf6)                    \
+    M(f64x2_pmax, 0xfdf7)                    \
+    M(i32x4_trunc_sat_f32x4_s, 0xfdf8)       \
+    M(i32x4_trunc_sat_f32x4_u, 0xfdf9)       \
+    M(f32x4_convert_i32x4_s, 0xfdfa)         \
+    M(f32x4_convert_i32x4_u, 0xfdfb)         \
+    M(i32x4_trunc_sat_f64x2_s_zero, 0xfdfc)  \
+    M(i32x4_trunc_sat_f64x2_u_zero, 0xfdfd)  \
+    M(f64x2_convert_low_i32x4_s, 0xfdfe)     \
+    M(f64x2_convert_low_i32x4_u, 0xfdff)
+
 #define ENUMERATE_WASM_OPCODES(M)         \
     ENUMERATE_SINGLE_BYTE_WASM_OPCODES(M) \
-    ENUMERATE_MULTI_BYTE_WASM_OPCODES(M)
+    ENUMERATE_MULTI_BYTE_WASM_OPCODES(M)  \
+    ENUMERATE_SIMD_WASM_OPCODES(M)
 
 #define M(name, value) static constexpr OpCode name = value;
 ENUMERATE_WASM_OPCODES(M)
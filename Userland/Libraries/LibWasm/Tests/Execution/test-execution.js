@@ -0,0 +1,75 @@
+// These run on whichever interpreter test-wasm was told to use, see --register-interpreter.
+// (module
+//   (memory 1)
+//   (func $fib (export "fib") (param i32) (result i32)
+//     (if (result i32) (i32.lt_u (local.get 0) (i32.const 2))
+//       (then (local.get 0))
+//       (else (i32.add (call $fib (i32.sub (local.get 0) (i32.const 1))) (call $fib (i32.sub (local.get 0) (i32.const 2)))))))
+//   (func (export "sum") (param i32) (result i64) (local i64)
+//     (block (loop
+//       (br_if 1 (i32.eqz (local.get 0)))
+//       (local.set 1 (i64.add (local.get 1) (i64.extend_i32_u (local.get 0))))
+//       (local.set 0 (i32.sub (local.get 0) (i32.const 1)))
+//       (br 0)))
+//     (local.get 1))
+//   (func (export "select_case") (param i32) (result i32)
+//     (block (block (block (br_table 0 1 2 (local.get 0))) (return (i32.const 10))) (return (i32.const 20)))
+//     (i32.const 30))
+//   (func (export "store_load") (param i32 f64) (result f64)
+//     (f64.store (local.get 0) (local.get 1))
+//     (f64.load (local.get 0)))
+//   (func (export "div") (param i32 i32) (result i32) (i32.div_s (local.get 0) (local.get 1))))
+// prettier-ignore
+const binary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x17, 0x04, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x60, 0x01, 0x7f, 0x01, 0x7e, 0x60, 0x02, 0x7f, 0x7c, 0x01, 0x7c, 0x60, 0x02, 0x7f, 0x7f, 0x01,
+    0x7f, 0x03, 0x06, 0x05, 0x00, 0x01, 0x00, 0x02, 0x03, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x2e,
+    0x05, 0x03, 0x66, 0x69, 0x62, 0x00, 0x00, 0x03, 0x73, 0x75, 0x6d, 0x00, 0x01, 0x0b, 0x73, 0x65,
+    0x6c, 0x65, 0x63, 0x74, 0x5f, 0x63, 0x61, 0x73, 0x65, 0x00, 0x02, 0x0a, 0x73, 0x74, 0x6f, 0x72,
+    0x65, 0x5f, 0x6c, 0x6f, 0x61, 0x64, 0x00, 0x03, 0x03, 0x64, 0x69, 0x76, 0x00, 0x04, 0x0a, 0x73,
+    0x05, 0x1c, 0x00, 0x20, 0x00, 0x41, 0x02, 0x49, 0x04, 0x7f, 0x20, 0x00, 0x05, 0x20, 0x00, 0x41,
+    0x01, 0x6b, 0x10, 0x00, 0x20, 0x00, 0x41, 0x02, 0x6b, 0x10, 0x00, 0x6a, 0x0b, 0x0b, 0x22, 0x01,
+    0x01, 0x7e, 0x02, 0x40, 0x03, 0x40, 0x20, 0x00, 0x45, 0x0d, 0x01, 0x20, 0x01, 0x20, 0x00, 0xad,
+    0x7c, 0x21, 0x01, 0x20, 0x00, 0x41, 0x01, 0x6b, 0x21, 0x00, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x01,
+    0x0b, 0x1a, 0x00, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x20, 0x00, 0x0e, 0x02, 0x00, 0x01, 0x02,
+    0x0b, 0x41, 0x0a, 0x0f, 0x0b, 0x41, 0x14, 0x0f, 0x0b, 0x41, 0x1e, 0x0b, 0x0e, 0x00, 0x20, 0x00,
+    0x20, 0x01, 0x39, 0x03, 0x00, 0x20, 0x00, 0x2b, 0x03, 0x00, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x20,
+    0x01, 0x6d, 0x0b,
+]);
+
+const module = parseWebAssemblyModule(binary);
+
+test("recursive calls", () => {
+    const fib = module.getExport("fib");
+    expect(module.invoke(fib, 0)).toBe(0);
+    expect(module.invoke(fib, 1)).toBe(1);
+    expect(module.invoke(fib, 20)).toBe(6765);
+});
+
+test("loops carry locals across iterations", () => {
+    const sum = module.getExport("sum");
+    expect(module.invoke(sum, 0)).toBe(0n);
+    expect(module.invoke(sum, 100000)).toBe(5000050000n);
+});
+
+test("br_table picks its target, and takes the default when out of range", () => {
+    const selectCase = module.getExport("select_case");
+    expect(module.invoke(selectCase, 0)).toBe(10);
+    expect(module.invoke(selectCase, 1)).toBe(20);
+    expect(module.invoke(selectCase, 2)).toBe(30);
+    expect(module.invoke(selectCase, 1000)).toBe(30);
+});
+
+test("memory accesses", () => {
+    const storeLoad = module.getExport("store_load");
+    expect(module.invoke(storeLoad, 8, 1.5)).toBe(1.5);
+    expect(module.invoke(storeLoad, 65528, -2.25)).toBe(-2.25);
+    expect(() => module.invoke(storeLoad, 65529, 0)).toThrow(TypeError, "Execution trapped");
+});
+
+test("traps", () => {
+    const div = module.getExport("div");
+    expect(module.invoke(div, -7, 2)).toBe(-3);
+    expect(() => module.invoke(div, 7, 0)).toThrow(TypeError, "Execution trapped");
+    expect(() => module.invoke(div, -2147483648, -1)).toThrow(TypeError, "Execution trapped");
+});
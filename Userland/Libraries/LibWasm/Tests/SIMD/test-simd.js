@@ -0,0 +1,767 @@
+// Vectors cross into JS as BigInts holding their 128 bits, with the first lane in the least significant bits.
+// prettier-ignore
+const binary = new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x12, 0x03, 0x60, 0x02, 0x7b, 0x7b, 0x01,
+    0x7b, 0x60, 0x01, 0x7b, 0x01, 0x7f, 0x60, 0x02, 0x7f, 0x7b, 0x01, 0x7b, 0x03, 0x06, 0x05, 0x00,
+    0x00, 0x00, 0x01, 0x02, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x4d, 0x05, 0x09, 0x69, 0x33, 0x32,
+    0x78, 0x34, 0x5f, 0x61, 0x64, 0x64, 0x00, 0x00, 0x0d, 0x69, 0x38, 0x78, 0x31, 0x36, 0x5f, 0x73,
+    0x68, 0x75, 0x66, 0x66, 0x6c, 0x65, 0x00, 0x01, 0x09, 0x66, 0x33, 0x32, 0x78, 0x34, 0x5f, 0x6d,
+    0x75, 0x6c, 0x00, 0x02, 0x0d, 0x69, 0x38, 0x78, 0x31, 0x36, 0x5f, 0x62, 0x69, 0x74, 0x6d, 0x61,
+    0x73, 0x6b, 0x00, 0x03, 0x11, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x5f, 0x6c, 0x6f, 0x61, 0x64, 0x36,
+    0x34, 0x5f, 0x7a, 0x65, 0x72, 0x6f, 0x00, 0x04, 0x0a, 0x46, 0x05, 0x09, 0x00, 0x20, 0x00, 0x20,
+    0x01, 0xfd, 0xae, 0x01, 0x0b, 0x18, 0x00, 0x20, 0x00, 0x20, 0x01, 0xfd, 0x0d, 0x0f, 0x0e, 0x0d,
+    0x0c, 0x0b, 0x0a, 0x09, 0x08, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x0b, 0x09, 0x00,
+    0x20, 0x00, 0x20, 0x01, 0xfd, 0xe6, 0x01, 0x0b, 0x06, 0x00, 0x20, 0x00, 0xfd, 0x64, 0x0b, 0x10,
+    0x00, 0x20, 0x00, 0x20, 0x01, 0xfd, 0x0b, 0x04, 0x00, 0x20, 0x00, 0xfd, 0x5d, 0x03, 0x00, 0x0b,
+]);
+
+const module = parseWebAssemblyModule(binary);
+
+test("lanewise integer arithmetic wraps around", () => {
+    const add = module.getExport("i32x4_add");
+    expect(module.invoke(add, 0x00000004_00000003_00000002_ffffffffn, 0x00000001_00000001_00000001_00000001n)).toBe(
+    0x00000005_00000004_00000003_00000000n
+    );
+});
+
+test("shuffle picks bytes out of both operands", () => {
+    const shuffle = module.getExport("i8x16_shuffle");
+    expect(module.invoke(shuffle, 0x0f0e0d0c_0b0a0908_07060504_03020100n, 0x1f1e1d1c_1b1a1918_17161514_13121110n)).toBe(
+    0x17161514_13121110_08090a0b_0c0d0e0fn
+    );
+});
+
+test("floating point lanes", () => {
+    const mul = module.getExport("f32x4_mul");
+    // [1.5, -2, 0.5, 3] * [2, 2, 2, 2]
+    expect(module.invoke(mul, 0x40400000_3f000000_c0000000_3fc00000n, 0x40000000_40000000_40000000_40000000n)).toBe(
+    0x40c00000_3f800000_c0800000_40400000n
+    );
+});
+
+test("bitmask collects the sign bits of all lanes", () => {
+    const bitmask = module.getExport("i8x16_bitmask");
+    expect(module.invoke(bitmask, 0x80000000_00000000_00000000_ff000080n)).toBe(0x8009);
+});
+
+test("vectors round trip through memory", () => {
+    const storeLoad = module.getExport("store_load64_zero");
+    expect(module.invoke(storeLoad, 16, 0x11223344_55667788_01234567_89abcdefn)).toBe(0x01234567_89abcdefn);
+    expect(() => module.invoke(storeLoad, 65530, 0n)).toThrow(TypeError, "Execution trapped");
+});
+
+// The rest of this file covers every vector instruction. Each one is wrapped in an exported function named after it,
+// which applies it to the function's parameters. The expected results come from modelling the lanes in JS.
+
+// prettier-ignore
+const selectors = {
+    "v128.load": 0x00, "v128.load8x8_s": 0x01, "v128.load8x8_u": 0x02, "v128.load16x4_s": 0x03,
+    "v128.load16x4_u": 0x04, "v128.load32x2_s": 0x05, "v128.load32x2_u": 0x06,
+    "v128.load8_splat": 0x07, "v128.load16_splat": 0x08, "v128.load32_splat": 0x09,
+    "v128.load64_splat": 0x0a, "v128.store": 0x0b, "v128.const": 0x0c, "i8x16.shuffle": 0x0d,
+    "i8x16.swizzle": 0x0e, "i8x16.splat": 0x0f, "i16x8.splat": 0x10, "i32x4.splat": 0x11,
+    "i64x2.splat": 0x12, "f32x4.splat": 0x13, "f64x2.splat": 0x14, "i8x16.extract_lane_s": 0x15,
+    "i8x16.extract_lane_u": 0x16, "i8x16.replace_lane": 0x17, "i16x8.extract_lane_s": 0x18,
+    "i16x8.extract_lane_u": 0x19, "i16x8.replace_lane": 0x1a, "i32x4.extract_lane": 0x1b,
+    "i32x4.replace_lane": 0x1c, "i64x2.extract_lane": 0x1d, "i64x2.replace_lane": 0x1e,
+    "f32x4.extract_lane": 0x1f, "f32x4.replace_lane": 0x20, "f64x2.extract_lane": 0x21,
+    "f64x2.replace_lane": 0x22, "i8x16.eq": 0x23, "i8x16.ne": 0x24, "i8x16.lt_s": 0x25,
+    "i8x16.lt_u": 0x26, "i8x16.gt_s": 0x27, "i8x16.gt_u": 0x28, "i8x16.le_s": 0x29,
+    "i8x16.le_u": 0x2a, "i8x16.ge_s": 0x2b, "i8x16.ge_u": 0x2c, "i16x8.eq": 0x2d, "i16x8.ne": 0x2e,
+    "i16x8.lt_s": 0x2f, "i16x8.lt_u": 0x30, "i16x8.gt_s": 0x31, "i16x8.gt_u": 0x32,
+    "i16x8.le_s": 0x33, "i16x8.le_u": 0x34, "i16x8.ge_s": 0x35, "i16x8.ge_u": 0x36,
+    "i32x4.eq": 0x37, "i32x4.ne": 0x38, "i32x4.lt_s": 0x39, "i32x4.lt_u": 0x3a, "i32x4.gt_s": 0x3b,
+    "i32x4.gt_u": 0x3c, "i32x4.le_s": 0x3d, "i32x4.le_u": 0x3e, "i32x4.ge_s": 0x3f,
+    "i32x4.ge_u": 0x40, "f32x4.eq": 0x41, "f32x4.ne": 0x42, "f32x4.lt": 0x43, "f32x4.gt": 0x44,
+    "f32x4.le": 0x45, "f32x4.ge": 0x46, "f64x2.eq": 0x47, "f64x2.ne": 0x48, "f64x2.lt": 0x49,
+    "f64x2.gt": 0x4a, "f64x2.le": 0x4b, "f64x2.ge": 0x4c, "v128.not": 0x4d, "v128.and": 0x4e,
+    "v128.andnot": 0x4f, "v128.or": 0x50, "v128.xor": 0x51, "v128.bitselect": 0x52,
+    "v128.any_true": 0x53, "v128.load8_lane": 0x54, "v128.load16_lane": 0x55,
+    "v128.load32_lane": 0x56, "v128.load64_lane": 0x57, "v128.store8_lane": 0x58,
+    "v128.store16_lane": 0x59, "v128.store32_lane": 0x5a, "v128.store64_lane": 0x5b,
+    "v128.load32_zero": 0x5c, "v128.load64_zero": 0x5d, "f32x4.demote_f64x2_zero": 0x5e,
+    "f64x2.promote_low_f32x4": 0x5f, "i8x16.abs": 0x60, "i8x16.neg": 0x61, "i8x16.popcnt": 0x62,
+    "i8x16.all_true": 0x63, "i8x16.bitmask": 0x64, "i8x16.narrow_i16x8_s": 0x65,
+    "i8x16.narrow_i16x8_u": 0x66, "f32x4.ceil": 0x67, "f32x4.floor": 0x68, "f32x4.trunc": 0x69,
+    "f32x4.nearest": 0x6a, "i8x16.shl": 0x6b, "i8x16.shr_s": 0x6c, "i8x16.shr_u": 0x6d,
+    "i8x16.add": 0x6e, "i8x16.add_sat_s": 0x6f, "i8x16.add_sat_u": 0x70, "i8x16.sub": 0x71,
+    "i8x16.sub_sat_s": 0x72, "i8x16.sub_sat_u": 0x73, "f64x2.ceil": 0x74, "f64x2.floor": 0x75,
+    "i8x16.min_s": 0x76, "i8x16.min_u": 0x77, "i8x16.max_s": 0x78, "i8x16.max_u": 0x79,
+    "f64x2.trunc": 0x7a, "i8x16.avgr_u": 0x7b, "i16x8.extadd_pairwise_i8x16_s": 0x7c,
+    "i16x8.extadd_pairwise_i8x16_u": 0x7d, "i32x4.extadd_pairwise_i16x8_s": 0x7e,
+    "i32x4.extadd_pairwise_i16x8_u": 0x7f, "i16x8.abs": 0x80, "i16x8.neg": 0x81,
+    "i16x8.q15mulr_sat_s": 0x82, "i16x8.all_true": 0x83, "i16x8.bitmask": 0x84,
+    "i16x8.narrow_i32x4_s": 0x85, "i16x8.narrow_i32x4_u": 0x86, "i16x8.extend_low_i8x16_s": 0x87,
+    "i16x8.extend_high_i8x16_s": 0x88, "i16x8.extend_low_i8x16_u": 0x89,
+    "i16x8.extend_high_i8x16_u": 0x8a, "i16x8.shl": 0x8b, "i16x8.shr_s": 0x8c, "i16x8.shr_u": 0x8d,
+    "i16x8.add": 0x8e, "i16x8.add_sat_s": 0x8f, "i16x8.add_sat_u": 0x90, "i16x8.sub": 0x91,
+    "i16x8.sub_sat_s": 0x92, "i16x8.sub_sat_u": 0x93, "f64x2.nearest": 0x94, "i16x8.mul": 0x95,
+    "i16x8.min_s": 0x96, "i16x8.min_u": 0x97, "i16x8.max_s": 0x98, "i16x8.max_u": 0x99,
+    "i16x8.avgr_u": 0x9b, "i16x8.extmul_low_i8x16_s": 0x9c, "i16x8.extmul_high_i8x16_s": 0x9d,
+    "i16x8.extmul_low_i8x16_u": 0x9e, "i16x8.extmul_high_i8x16_u": 0x9f, "i32x4.abs": 0xa0,
+    "i32x4.neg": 0xa1, "i32x4.all_true": 0xa3, "i32x4.bitmask": 0xa4,
+    "i32x4.extend_low_i16x8_s": 0xa7, "i32x4.extend_high_i16x8_s": 0xa8,
+    "i32x4.extend_low_i16x8_u": 0xa9, "i32x4.extend_high_i16x8_u": 0xaa, "i32x4.shl": 0xab,
+    "i32x4.shr_s": 0xac, "i32x4.shr_u": 0xad, "i32x4.add": 0xae, "i32x4.sub": 0xb1,
+    "i32x4.mul": 0xb5, "i32x4.min_s": 0xb6, "i32x4.min_u": 0xb7, "i32x4.max_s": 0xb8,
+    "i32x4.max_u": 0xb9, "i32x4.dot_i16x8_s": 0xba, "i32x4.extmul_low_i16x8_s": 0xbc,
+    "i32x4.extmul_high_i16x8_s": 0xbd, "i32x4.extmul_low_i16x8_u": 0xbe,
+    "i32x4.extmul_high_i16x8_u": 0xbf, "i64x2.abs": 0xc0, "i64x2.neg": 0xc1, "i64x2.all_true": 0xc3,
+    "i64x2.bitmask": 0xc4, "i64x2.extend_low_i32x4_s": 0xc7, "i64x2.extend_high_i32x4_s": 0xc8,
+    "i64x2.extend_low_i32x4_u": 0xc9, "i64x2.extend_high_i32x4_u": 0xca, "i64x2.shl": 0xcb,
+    "i64x2.shr_s": 0xcc, "i64x2.shr_u": 0xcd, "i64x2.add": 0xce, "i64x2.sub": 0xd1,
+    "i64x2.mul": 0xd5, "i64x2.eq": 0xd6, "i64x2.ne": 0xd7, "i64x2.lt_s": 0xd8, "i64x2.gt_s": 0xd9,
+    "i64x2.le_s": 0xda, "i64x2.ge_s": 0xdb, "i64x2.extmul_low_i32x4_s": 0xdc,
+    "i64x2.extmul_high_i32x4_s": 0xdd, "i64x2.extmul_low_i32x4_u": 0xde,
+    "i64x2.extmul_high_i32x4_u": 0xdf, "f32x4.abs": 0xe0, "f32x4.neg": 0xe1, "f32x4.sqrt": 0xe3,
+    "f32x4.add": 0xe4, "f32x4.sub": 0xe5, "f32x4.mul": 0xe6, "f32x4.div": 0xe7, "f32x4.min": 0xe8,
+    "f32x4.max": 0xe9, "f32x4.pmin": 0xea, "f32x4.pmax": 0xeb, "f64x2.abs": 0xec, "f64x2.neg": 0xed,
+    "f64x2.sqrt": 0xef, "f64x2.add": 0xf0, "f64x2.sub": 0xf1, "f64x2.mul": 0xf2, "f64x2.div": 0xf3,
+    "f64x2.min": 0xf4, "f64x2.max": 0xf5, "f64x2.pmin": 0xf6, "f64x2.pmax": 0xf7,
+    "i32x4.trunc_sat_f32x4_s": 0xf8, "i32x4.trunc_sat_f32x4_u": 0xf9, "f32x4.convert_i32x4_s": 0xfa,
+    "f32x4.convert_i32x4_u": 0xfb, "i32x4.trunc_sat_f64x2_s_zero": 0xfc,
+    "i32x4.trunc_sat_f64x2_u_zero": 0xfd, "f64x2.convert_low_i32x4_s": 0xfe,
+    "f64x2.convert_low_i32x4_u": 0xff,
+};
+
+const V128 = 0x7b;
+const I32 = 0x7f;
+const I64 = 0x7e;
+const F32 = 0x7d;
+const F64 = 0x7c;
+
+function uleb(value) {
+    const bytes = [];
+    do {
+        let byte = value & 0x7f;
+        value >>>= 7;
+        if (value !== 0) byte |= 0x80;
+        bytes.push(byte);
+    } while (value !== 0);
+    return bytes;
+}
+
+const vec = items => [...uleb(items.length), ...items.flat()];
+const section = (id, contents) => [id, ...uleb(contents.length), ...contents];
+
+function buildModule(functions) {
+    const types = functions.map(f => [
+        0x60,
+        ...vec(f.params.map(type => [type])),
+        ...vec(f.results.map(type => [type])),
+    ]);
+    const exports = functions.map((f, index) => [
+        ...vec([...f.instruction].map(c => [c.charCodeAt(0)])),
+        0x00,
+        ...uleb(index),
+    ]);
+    const bodies = functions.map(f => {
+        const code = [0x00, ...f.params.flatMap((_, index) => [0x20, ...uleb(index)])];
+        code.push(0xfd, ...uleb(selectors[f.instruction]), ...f.immediates, 0x0b);
+        return [...uleb(code.length), ...code];
+    });
+    return new Uint8Array([
+        ...[0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00],
+        ...section(1, vec(types)),
+        ...section(3, vec(functions.map((_, index) => uleb(index)))),
+        ...section(5, vec([[0x00, 0x01]])),
+        ...section(7, vec(exports)),
+        ...section(10, vec(bodies)),
+    ]);
+}
+
+const functions = [];
+function define(instruction, params, results, immediates = []) {
+    functions.push({ instruction, params, results, immediates });
+}
+
+function lanes(bits, values) {
+    let vector = 0n;
+    values.forEach((value, index) => {
+        vector |= BigInt.asUintN(bits, BigInt(value)) << BigInt(bits * index);
+    });
+    return vector;
+}
+
+function unpack(bits, vector, signed = false) {
+    const result = [];
+    for (let index = 0; index < 128 / bits; ++index) {
+        const lane = BigInt.asUintN(bits, vector >> BigInt(bits * index));
+        result.push(signed ? BigInt.asIntN(bits, lane) : lane);
+    }
+    return result;
+}
+
+const view = new DataView(new ArrayBuffer(8));
+function f32Bits(value) {
+    view.setFloat32(0, value, true);
+    return view.getUint32(0, true);
+}
+function f64Bits(value) {
+    view.setFloat64(0, value, true);
+    return view.getBigUint64(0, true);
+}
+
+const i8x16 = (...values) => lanes(8, values);
+const i16x8 = (...values) => lanes(16, values);
+const i32x4 = (...values) => lanes(32, values);
+const i64x2 = (...values) => lanes(64, values);
+const f32x4 = (...values) => lanes(32, values.map(f32Bits));
+const f64x2 = (...values) => lanes(64, values.map(f64Bits));
+const splat = (bits, value) => lanes(bits, Array(128 / bits).fill(value));
+
+// Pairs of lanes that hit the edge cases, the shapes with more lanes get more of them.
+function operandsFor(bits) {
+    const max = (1n << BigInt(bits - 1)) - 1n;
+    const min = -max - 1n;
+    // prettier-ignore
+    const pairs = [
+        [max, 1n], [min, -1n], [-1n, 1n], [3n, -7n], [0n, 0n], [min, min], [max, max],
+        [100n, -100n], [-3n, 5n], [1n, -1n], [max, min], [7n, 7n], [-100n, -3n], [min, max],
+        [42n, 17n], [-1n, -1n],
+    ].slice(0, 128 / bits);
+    return [lanes(bits, pairs.map(pair => pair[0])), lanes(bits, pairs.map(pair => pair[1]))];
+}
+
+function saturate(bits, signed, value) {
+    const min = signed ? -(1n << BigInt(bits - 1)) : 0n;
+    const max = signed ? (1n << BigInt(bits - 1)) - 1n : (1n << BigInt(bits)) - 1n;
+    return value < min ? min : value > max ? max : value;
+}
+
+const mask = condition => (condition ? -1n : 0n);
+
+function nearest(value) {
+    const rounded = Math.abs(value % 1) === 0.5 ? 2 * Math.round(value / 2) : Math.round(value);
+    return rounded === 0 && value < 0 ? -0 : rounded;
+}
+
+const integerShapes = [
+    { bits: 8, name: "i8x16" },
+    { bits: 16, name: "i16x8" },
+    { bits: 32, name: "i32x4" },
+    { bits: 64, name: "i64x2" },
+];
+
+const floatShapes = [
+    { bits: 32, name: "f32x4", vector: f32x4, round: Math.fround },
+    { bits: 64, name: "f64x2", vector: f64x2, round: value => value },
+];
+
+// These map the lanes of the operands to the lane of the result, they're signed unless noted.
+const integerBinaryOperations = {
+    add: { shapes: [8, 16, 32, 64], lane: (a, b) => a + b },
+    sub: { shapes: [8, 16, 32, 64], lane: (a, b) => a - b },
+    mul: { shapes: [16, 32, 64], lane: (a, b) => a * b },
+    add_sat_s: { shapes: [8, 16], lane: (a, b, bits) => saturate(bits, true, a + b) },
+    add_sat_u: {
+        shapes: [8, 16],
+        unsigned: true,
+        lane: (a, b, bits) => saturate(bits, false, a + b),
+    },
+    sub_sat_s: { shapes: [8, 16], lane: (a, b, bits) => saturate(bits, true, a - b) },
+    sub_sat_u: {
+        shapes: [8, 16],
+        unsigned: true,
+        lane: (a, b, bits) => saturate(bits, false, a - b),
+    },
+    min_s: { shapes: [8, 16, 32], lane: (a, b) => (a < b ? a : b) },
+    min_u: { shapes: [8, 16, 32], unsigned: true, lane: (a, b) => (a < b ? a : b) },
+    max_s: { shapes: [8, 16, 32], lane: (a, b) => (a > b ? a : b) },
+    max_u: { shapes: [8, 16, 32], unsigned: true, lane: (a, b) => (a > b ? a : b) },
+    avgr_u: { shapes: [8, 16], unsigned: true, lane: (a, b) => (a + b + 1n) >> 1n },
+    q15mulr_sat_s: { shapes: [16], lane: (a, b) => saturate(16, true, (a * b + 0x4000n) >> 15n) },
+    eq: { shapes: [8, 16, 32, 64], lane: (a, b) => mask(a === b) },
+    ne: { shapes: [8, 16, 32, 64], lane: (a, b) => mask(a !== b) },
+    lt_s: { shapes: [8, 16, 32, 64], lane: (a, b) => mask(a < b) },
+    lt_u: { shapes: [8, 16, 32], unsigned: true, lane: (a, b) => mask(a < b) },
+    gt_s: { shapes: [8, 16, 32, 64], lane: (a, b) => mask(a > b) },
+    gt_u: { shapes: [8, 16, 32], unsigned: true, lane: (a, b) => mask(a > b) },
+    le_s: { shapes: [8, 16, 32, 64], lane: (a, b) => mask(a <= b) },
+    le_u: { shapes: [8, 16, 32], unsigned: true, lane: (a, b) => mask(a <= b) },
+    ge_s: { shapes: [8, 16, 32, 64], lane: (a, b) => mask(a >= b) },
+    ge_u: { shapes: [8, 16, 32], unsigned: true, lane: (a, b) => mask(a >= b) },
+};
+
+const popcount = value => BigInt([...value.toString(2)].filter(digit => digit === "1").length);
+
+const integerUnaryOperations = {
+    abs: { shapes: [8, 16, 32, 64], lane: a => (a < 0n ? -a : a) },
+    neg: { shapes: [8, 16, 32, 64], lane: a => -a },
+    popcnt: { shapes: [8], unsigned: true, lane: popcount },
+};
+
+const shiftOperations = {
+    shl: { lane: (a, count) => a << count },
+    shr_s: { lane: (a, count) => a >> count },
+    shr_u: { unsigned: true, lane: (a, count) => a >> count },
+};
+
+const floatBinaryOperations = {
+    add: (a, b) => a + b,
+    sub: (a, b) => a - b,
+    mul: (a, b) => a * b,
+    div: (a, b) => a / b,
+    min: Math.min,
+    max: Math.max,
+    pmin: (a, b) => (b < a ? b : a),
+    pmax: (a, b) => (a < b ? b : a),
+};
+
+const floatUnaryOperations = {
+    abs: Math.abs,
+    neg: a => -a,
+    sqrt: Math.sqrt,
+    ceil: Math.ceil,
+    floor: Math.floor,
+    trunc: Math.trunc,
+    nearest,
+};
+
+const floatComparisons = {
+    eq: (a, b) => a === b,
+    ne: (a, b) => a !== b,
+    lt: (a, b) => a < b,
+    gt: (a, b) => a > b,
+    le: (a, b) => a <= b,
+    ge: (a, b) => a >= b,
+};
+
+// prettier-ignore
+const extendingShapes = [
+    { bits: 8, narrow: "i8x16", wide: "i16x8" },
+    { bits: 16, narrow: "i16x8", wide: "i32x4" },
+    { bits: 32, narrow: "i32x4", wide: "i64x2" },
+];
+
+for (const { bits, name } of integerShapes) {
+    for (const [operation, { shapes }] of Object.entries(integerBinaryOperations)) {
+        if (shapes.includes(bits)) define(`${name}.${operation}`, [V128, V128], [V128]);
+    }
+    for (const [operation, { shapes }] of Object.entries(integerUnaryOperations)) {
+        if (shapes.includes(bits)) define(`${name}.${operation}`, [V128], [V128]);
+    }
+    for (const operation of Object.keys(shiftOperations))
+        define(`${name}.${operation}`, [V128, I32], [V128]);
+    define(`${name}.all_true`, [V128], [I32]);
+    define(`${name}.bitmask`, [V128], [I32]);
+}
+
+for (const { name } of floatShapes) {
+    for (const operation of Object.keys(floatBinaryOperations))
+        define(`${name}.${operation}`, [V128, V128], [V128]);
+    for (const operation of Object.keys(floatUnaryOperations))
+        define(`${name}.${operation}`, [V128], [V128]);
+    for (const operation of Object.keys(floatComparisons))
+        define(`${name}.${operation}`, [V128, V128], [V128]);
+}
+
+for (const { bits, narrow, wide } of extendingShapes) {
+    for (const signedness of ["s", "u"]) {
+        for (const half of ["low", "high"]) {
+            define(`${wide}.extend_${half}_${narrow}_${signedness}`, [V128], [V128]);
+            define(`${wide}.extmul_${half}_${narrow}_${signedness}`, [V128, V128], [V128]);
+        }
+        if (bits === 32) continue;
+        define(`${wide}.extadd_pairwise_${narrow}_${signedness}`, [V128], [V128]);
+        define(`${narrow}.narrow_${wide}_${signedness}`, [V128, V128], [V128]);
+    }
+}
+define("i32x4.dot_i16x8_s", [V128, V128], [V128]);
+
+define("f32x4.demote_f64x2_zero", [V128], [V128]);
+define("f64x2.promote_low_f32x4", [V128], [V128]);
+for (const signedness of ["s", "u"]) {
+    define(`i32x4.trunc_sat_f32x4_${signedness}`, [V128], [V128]);
+    define(`f32x4.convert_i32x4_${signedness}`, [V128], [V128]);
+    define(`i32x4.trunc_sat_f64x2_${signedness}_zero`, [V128], [V128]);
+    define(`f64x2.convert_low_i32x4_${signedness}`, [V128], [V128]);
+}
+
+// prettier-ignore
+define("v128.const", [], [V128], [
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+]);
+// prettier-ignore
+define("i8x16.shuffle", [V128, V128], [V128], [
+    0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23,
+]);
+define("i8x16.swizzle", [V128, V128], [V128]);
+define("i8x16.splat", [I32], [V128]);
+define("i16x8.splat", [I32], [V128]);
+define("i32x4.splat", [I32], [V128]);
+define("i64x2.splat", [I64], [V128]);
+define("f32x4.splat", [F32], [V128]);
+define("f64x2.splat", [F64], [V128]);
+define("i8x16.extract_lane_s", [V128], [I32], [15]);
+define("i8x16.extract_lane_u", [V128], [I32], [15]);
+define("i16x8.extract_lane_s", [V128], [I32], [7]);
+define("i16x8.extract_lane_u", [V128], [I32], [7]);
+define("i32x4.extract_lane", [V128], [I32], [3]);
+define("i64x2.extract_lane", [V128], [I64], [1]);
+define("f32x4.extract_lane", [V128], [F32], [2]);
+define("f64x2.extract_lane", [V128], [F64], [1]);
+define("i8x16.replace_lane", [V128, I32], [V128], [3]);
+define("i16x8.replace_lane", [V128, I32], [V128], [7]);
+define("i32x4.replace_lane", [V128, I32], [V128], [0]);
+define("i64x2.replace_lane", [V128, I64], [V128], [1]);
+define("f32x4.replace_lane", [V128, F32], [V128], [1]);
+define("f64x2.replace_lane", [V128, F64], [V128], [0]);
+
+define("v128.not", [V128], [V128]);
+for (const operation of ["and", "andnot", "or", "xor"])
+    define(`v128.${operation}`, [V128, V128], [V128]);
+define("v128.bitselect", [V128, V128, V128], [V128]);
+define("v128.any_true", [V128], [I32]);
+
+// Memory accesses have an alignment hint of 1 and no offset, the lane to access comes after those.
+const memarg = [0x00, 0x00];
+// prettier-ignore
+const loads = [
+    "load", "load8x8_s", "load8x8_u", "load16x4_s", "load16x4_u", "load32x2_s", "load32x2_u",
+    "load8_splat", "load16_splat", "load32_splat", "load64_splat", "load32_zero", "load64_zero",
+];
+for (const load of loads) define(`v128.${load}`, [I32], [V128], memarg);
+define("v128.store", [I32, V128], [], memarg);
+define("v128.load8_lane", [I32, V128], [V128], [...memarg, 15]);
+define("v128.load16_lane", [I32, V128], [V128], [...memarg, 7]);
+define("v128.load32_lane", [I32, V128], [V128], [...memarg, 3]);
+define("v128.load64_lane", [I32, V128], [V128], [...memarg, 1]);
+define("v128.store8_lane", [I32, V128], [], [...memarg, 5]);
+define("v128.store16_lane", [I32, V128], [], [...memarg, 6]);
+define("v128.store32_lane", [I32, V128], [], [...memarg, 2]);
+define("v128.store64_lane", [I32, V128], [], [...memarg, 1]);
+
+const instructions = parseWebAssemblyModule(buildModule(functions));
+const call = (instruction, ...args) =>
+    instructions.invoke(instructions.getExport(instruction), ...args);
+
+test("every vector instruction is covered", () => {
+    const covered = new Set(functions.map(f => f.instruction));
+    expect(Object.keys(selectors).filter(instruction => !covered.has(instruction))).toEqual([]);
+    expect(functions).toHaveLength(Object.keys(selectors).length);
+});
+
+for (const { bits, name } of integerShapes) {
+    const [a, b] = operandsFor(bits);
+    const laneCount = 128 / bits;
+
+    for (const [operation, { shapes, unsigned, lane }] of Object.entries(integerBinaryOperations)) {
+        if (!shapes.includes(bits)) continue;
+        test(`${name}.${operation}`, () => {
+            const aLanes = unpack(bits, a, !unsigned);
+            const bLanes = unpack(bits, b, !unsigned);
+            const expected = aLanes.map((aLane, index) => lane(aLane, bLanes[index], bits));
+            expect(call(`${name}.${operation}`, a, b)).toBe(lanes(bits, expected));
+        });
+    }
+
+    for (const [operation, { shapes, unsigned, lane }] of Object.entries(integerUnaryOperations)) {
+        if (!shapes.includes(bits)) continue;
+        test(`${name}.${operation}`, () => {
+            const expected = unpack(bits, a, !unsigned).map(aLane => lane(aLane));
+            expect(call(`${name}.${operation}`, a)).toBe(lanes(bits, expected));
+        });
+    }
+
+    for (const [operation, { unsigned, lane }] of Object.entries(shiftOperations)) {
+        test(`${name}.${operation}`, () => {
+            // The shift count is taken modulo the lane width.
+            for (const count of [0, 1, bits - 1, bits, bits + 2, -1]) {
+                const effectiveCount = BigInt(((count % bits) + bits) % bits);
+                const aLanes = unpack(bits, a, !unsigned);
+                const expected = aLanes.map(aLane => lane(aLane, effectiveCount));
+                expect(call(`${name}.${operation}`, a, count)).toBe(lanes(bits, expected));
+            }
+        });
+    }
+
+    test(`${name}.all_true`, () => {
+        expect(call(`${name}.all_true`, splat(bits, 1))).toBe(1);
+        expect(call(`${name}.all_true`, splat(bits, -1n << BigInt(bits - 1)))).toBe(1);
+        expect(call(`${name}.all_true`, lanes(bits, [...Array(laneCount - 1).fill(1), 0]))).toBe(0);
+        expect(call(`${name}.all_true`, 0n)).toBe(0);
+    });
+
+    test(`${name}.bitmask`, () => {
+        let expected = 0;
+        unpack(bits, a, true).forEach((aLane, index) => {
+            if (aLane < 0n) expected |= 1 << index;
+        });
+        expect(call(`${name}.bitmask`, a)).toBe(expected);
+        expect(call(`${name}.bitmask`, splat(bits, -1))).toBe(2 ** laneCount - 1);
+    });
+}
+
+for (const { bits, narrow, wide } of extendingShapes) {
+    const [a, b] = operandsFor(bits);
+    const count = 64 / bits;
+
+    for (const [signedness, signed] of [["s", true], ["u", false]]) {
+        for (const [half, start] of [["low", 0], ["high", count]]) {
+            test(`${wide}.extend_${half}_${narrow}_${signedness}`, () => {
+                const expected = unpack(bits, a, signed).slice(start, start + count);
+                expect(call(`${wide}.extend_${half}_${narrow}_${signedness}`, a)).toBe(
+                    lanes(2 * bits, expected)
+                );
+            });
+
+            test(`${wide}.extmul_${half}_${narrow}_${signedness}`, () => {
+                const aLanes = unpack(bits, a, signed).slice(start, start + count);
+                const bLanes = unpack(bits, b, signed).slice(start, start + count);
+                const expected = aLanes.map((aLane, index) => aLane * bLanes[index]);
+                expect(call(`${wide}.extmul_${half}_${narrow}_${signedness}`, a, b)).toBe(
+                    lanes(2 * bits, expected)
+                );
+            });
+        }
+
+        if (bits === 32) continue;
+
+        test(`${wide}.extadd_pairwise_${narrow}_${signedness}`, () => {
+            const aLanes = unpack(bits, a, signed);
+            const expected = [];
+            for (let index = 0; index < count; ++index)
+                expected.push(aLanes[2 * index] + aLanes[2 * index + 1]);
+            expect(call(`${wide}.extadd_pairwise_${narrow}_${signedness}`, a)).toBe(
+                lanes(2 * bits, expected)
+            );
+        });
+
+        test(`${narrow}.narrow_${wide}_${signedness}`, () => {
+            // Both variants take signed lanes, and saturate them to the range of the narrow ones.
+            const [wideA, wideB] = operandsFor(2 * bits);
+            const wideLanes = [...unpack(2 * bits, wideA, true), ...unpack(2 * bits, wideB, true)];
+            const expected = wideLanes.map(lane => saturate(bits, signed, lane));
+            expect(call(`${narrow}.narrow_${wide}_${signedness}`, wideA, wideB)).toBe(
+                lanes(bits, expected)
+            );
+        });
+    }
+}
+
+test("i32x4.dot_i16x8_s", () => {
+    const [a, b] = operandsFor(16);
+    const aLanes = unpack(16, a, true);
+    const bLanes = unpack(16, b, true);
+    const expected = [];
+    for (let index = 0; index < 8; index += 2)
+        expected.push(aLanes[index] * bLanes[index] + aLanes[index + 1] * bLanes[index + 1]);
+    expect(call("i32x4.dot_i16x8_s", a, b)).toBe(i32x4(...expected));
+    // This is the only case that overflows.
+    const minimums = splat(16, -0x8000);
+    expect(call("i32x4.dot_i16x8_s", minimums, minimums)).toBe(splat(32, -0x80000000));
+});
+
+for (const { bits, name, vector, round } of floatShapes) {
+    const take = values => values.slice(0, 128 / bits);
+    const exponentBits = bits === 32 ? BigInt(f32Bits(Infinity)) : f64Bits(Infinity);
+    const isNaNLane = lane => (lane & ~(1n << BigInt(bits - 1))) > exponentBits;
+
+    for (const [operation, lane] of Object.entries(floatBinaryOperations)) {
+        test(`${name}.${operation}`, () => {
+            // The lanes of min and max compare equal or are zeros of different signs.
+            const minOrMax = operation.includes("min") || operation.includes("max");
+            const a = take(minOrMax ? [-0, 0, -1.5, 8] : [1.5, -0, 0.5, -2.75]);
+            const b = take(minOrMax ? [0, -0, -1.5, 7.5] : [-0.25, 2, 4, 0.5]);
+            const expected = a.map((aLane, index) => round(lane(aLane, b[index])));
+            expect(call(`${name}.${operation}`, vector(...a), vector(...b))).toBe(
+                vector(...expected)
+            );
+        });
+    }
+
+    test(`${name}.min and ${name}.max return NaN if either lane is NaN`, () => {
+        for (const operation of ["min", "max"]) {
+            const a = vector(...take([NaN, 1, 2, 3]));
+            const b = vector(...take([1, NaN, 2, 3]));
+            const result = unpack(bits, call(`${name}.${operation}`, a, b));
+            expect(isNaNLane(result[0])).toBeTrue();
+            expect(isNaNLane(result[1])).toBeTrue();
+        }
+    });
+
+    for (const [operation, lane] of Object.entries(floatUnaryOperations)) {
+        test(`${name}.${operation}`, () => {
+            const a = take(operation === "sqrt" ? [-0, 2.25, 0, 4] : [-1.5, 2.5, -0.5, 0.75]);
+            const expected = a.map(aLane => round(lane(aLane)));
+            expect(call(`${name}.${operation}`, vector(...a))).toBe(vector(...expected));
+        });
+    }
+
+    for (const [operation, lane] of Object.entries(floatComparisons)) {
+        test(`${name}.${operation}`, () => {
+            const a = bits === 32 ? [1, NaN, -0, 2] : [NaN, -0];
+            const b = bits === 32 ? [1, NaN, 0, 3] : [1, 0];
+            const expected = a.map((aLane, index) => mask(lane(aLane, b[index])));
+            expect(call(`${name}.${operation}`, vector(...a), vector(...b))).toBe(
+                lanes(bits, expected)
+            );
+        });
+    }
+}
+
+test("conversions between floats of different sizes", () => {
+    expect(call("f32x4.demote_f64x2_zero", f64x2(1.5, -2.25))).toBe(f32x4(1.5, -2.25, 0, 0));
+    expect(call("f32x4.demote_f64x2_zero", f64x2(1e300, 0.1))).toBe(
+        f32x4(Infinity, Math.fround(0.1), 0, 0)
+    );
+    expect(call("f64x2.promote_low_f32x4", f32x4(0.5, -3, 9, 9))).toBe(f64x2(0.5, -3));
+});
+
+test("conversions from floats to integers saturate", () => {
+    expect(call("i32x4.trunc_sat_f32x4_s", f32x4(1.9, -1.9, 3e9, NaN))).toBe(
+        i32x4(1, -1, 0x7fffffff, 0)
+    );
+    expect(call("i32x4.trunc_sat_f32x4_u", f32x4(1.9, -1.9, 5e9, NaN))).toBe(
+        i32x4(1, 0, 0xffffffff, 0)
+    );
+    expect(call("i32x4.trunc_sat_f64x2_s_zero", f64x2(-3.7, -1e10))).toBe(
+        i32x4(-3, -0x80000000, 0, 0)
+    );
+    expect(call("i32x4.trunc_sat_f64x2_u_zero", f64x2(-3.7, 1e10))).toBe(
+        i32x4(0, 0xffffffff, 0, 0)
+    );
+});
+
+test("conversions from integers to floats", () => {
+    expect(call("f32x4.convert_i32x4_s", i32x4(1, -2, 16777217, 0))).toBe(
+        f32x4(1, -2, 16777216, 0)
+    );
+    expect(call("f32x4.convert_i32x4_u", i32x4(-1, 1, 0, 3))).toBe(f32x4(4294967296, 1, 0, 3));
+    expect(call("f64x2.convert_low_i32x4_s", i32x4(-5, 7, 100, 100))).toBe(f64x2(-5, 7));
+    expect(call("f64x2.convert_low_i32x4_u", i32x4(-1, 2, 100, 100))).toBe(f64x2(4294967295, 2));
+});
+
+test("v128.const", () => {
+    // prettier-ignore
+    expect(call("v128.const")).toBe(i8x16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+});
+
+test("i8x16.shuffle", () => {
+    const a = i8x16(...Array.from({ length: 16 }, (_, index) => index));
+    const b = i8x16(...Array.from({ length: 16 }, (_, index) => 0x10 + index));
+    // prettier-ignore
+    const expected = i8x16(
+        0x00, 0x10, 0x01, 0x11, 0x02, 0x12, 0x03, 0x13,
+        0x04, 0x14, 0x05, 0x15, 0x06, 0x16, 0x07, 0x17
+    );
+    expect(call("i8x16.shuffle", a, b)).toBe(expected);
+});
+
+test("i8x16.swizzle picks zero for indices that are out of range", () => {
+    const a = i8x16(...Array.from({ length: 16 }, (_, index) => 0x10 + index));
+    // prettier-ignore
+    const indices = i8x16(15, 0, 1, 16, 255, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12);
+    // prettier-ignore
+    const expected = i8x16(
+        0x1f, 0x10, 0x11, 0x00, 0x00, 0x12, 0x13, 0x14,
+        0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c
+    );
+    expect(call("i8x16.swizzle", a, indices)).toBe(expected);
+});
+
+test("splats", () => {
+    expect(call("i8x16.splat", 0x1ff)).toBe(splat(8, -1));
+    expect(call("i16x8.splat", -2)).toBe(splat(16, -2));
+    expect(call("i32x4.splat", 0x12345678)).toBe(splat(32, 0x12345678));
+    expect(call("i64x2.splat", -3n)).toBe(splat(64, -3n));
+    expect(call("f32x4.splat", 1.5)).toBe(f32x4(1.5, 1.5, 1.5, 1.5));
+    expect(call("f64x2.splat", -0.25)).toBe(f64x2(-0.25, -0.25));
+});
+
+test("extracting lanes", () => {
+    const bytes = i8x16(...Array.from({ length: 15 }, (_, index) => index), 0x80);
+    expect(call("i8x16.extract_lane_s", bytes)).toBe(-128);
+    expect(call("i8x16.extract_lane_u", bytes)).toBe(128);
+    const shorts = i16x8(1, 2, 3, 4, 5, 6, 7, 0x8000);
+    expect(call("i16x8.extract_lane_s", shorts)).toBe(-32768);
+    expect(call("i16x8.extract_lane_u", shorts)).toBe(32768);
+    expect(call("i32x4.extract_lane", i32x4(1, 2, 3, -4))).toBe(-4);
+    expect(call("i64x2.extract_lane", i64x2(1n, -5n))).toBe(-5n);
+    expect(call("f32x4.extract_lane", f32x4(1, 2, 3.5, 4))).toBe(3.5);
+    expect(call("f64x2.extract_lane", f64x2(1, -2.5))).toBe(-2.5);
+});
+
+test("replacing lanes", () => {
+    expect(call("i8x16.replace_lane", 0n, 0x1ff)).toBe(i8x16(0, 0, 0, 0xff));
+    expect(call("i16x8.replace_lane", 0n, 0x12345)).toBe(i16x8(0, 0, 0, 0, 0, 0, 0, 0x2345));
+    expect(call("i32x4.replace_lane", i32x4(1, 2, 3, 4), -1)).toBe(i32x4(-1, 2, 3, 4));
+    expect(call("i64x2.replace_lane", i64x2(1n, 2n), -7n)).toBe(i64x2(1n, -7n));
+    expect(call("f32x4.replace_lane", f32x4(1, 2, 3, 4), 0.5)).toBe(f32x4(1, 0.5, 3, 4));
+    expect(call("f64x2.replace_lane", f64x2(1, 2), 8)).toBe(f64x2(8, 2));
+});
+
+test("bitwise operations", () => {
+    const all = (1n << 128n) - 1n;
+    const a = 0xff00ff00_f0f0f0f0_12345678_9abcdef0n;
+    const b = 0x0ff00ff0_ffff0000_87654321_0fedcba9n;
+    const c = 0xffffffff_00000000_0f0f0f0f_f0f0f0f0n;
+    expect(call("v128.not", a)).toBe(a ^ all);
+    expect(call("v128.and", a, b)).toBe(a & b);
+    expect(call("v128.andnot", a, b)).toBe(a & (b ^ all));
+    expect(call("v128.or", a, b)).toBe(a | b);
+    expect(call("v128.xor", a, b)).toBe(a ^ b);
+    expect(call("v128.bitselect", a, b, c)).toBe((a & c) | (b & (c ^ all)));
+    expect(call("v128.any_true", 0n)).toBe(0);
+    expect(call("v128.any_true", 1n << 127n)).toBe(1);
+});
+
+describe("memory", () => {
+    // prettier-ignore
+    const bytes = [
+        0x01, 0x82, 0x03, 0x84, 0x05, 0x86, 0x07, 0x88,
+        0x09, 0x8a, 0x0b, 0x8c, 0x0d, 0x8e, 0x0f, 0x90,
+    ];
+    const stored = i8x16(...bytes);
+    call("v128.store", 0, stored);
+
+    test("loads", () => {
+        expect(call("v128.load", 0)).toBe(stored);
+        expect(call("v128.load8x8_s", 0)).toBe(i16x8(...unpack(8, stored, true).slice(0, 8)));
+        expect(call("v128.load8x8_u", 0)).toBe(i16x8(...unpack(8, stored).slice(0, 8)));
+        expect(call("v128.load16x4_s", 0)).toBe(i32x4(...unpack(16, stored, true).slice(0, 4)));
+        expect(call("v128.load16x4_u", 0)).toBe(i32x4(...unpack(16, stored).slice(0, 4)));
+        expect(call("v128.load32x2_s", 0)).toBe(i64x2(...unpack(32, stored, true).slice(0, 2)));
+        expect(call("v128.load32x2_u", 0)).toBe(i64x2(...unpack(32, stored).slice(0, 2)));
+    });
+
+    test("loads that splat or zero the other lanes", () => {
+        expect(call("v128.load8_splat", 1)).toBe(splat(8, 0x82));
+        expect(call("v128.load16_splat", 2)).toBe(splat(16, 0x8403));
+        expect(call("v128.load32_splat", 4)).toBe(splat(32, 0x88078605));
+        expect(call("v128.load64_splat", 8)).toBe(splat(64, 0x900f8e0d_8c0b8a09n));
+        expect(call("v128.load32_zero", 12)).toBe(i32x4(0x900f8e0d));
+        expect(call("v128.load64_zero", 8)).toBe(i64x2(0x900f8e0d_8c0b8a09n));
+    });
+
+    test("loads into a single lane", () => {
+        const ones = splat(8, -1);
+        expect(call("v128.load8_lane", 1, ones)).toBe(i8x16(...Array(15).fill(-1), 0x82));
+        expect(call("v128.load16_lane", 2, ones)).toBe(i16x8(...Array(7).fill(-1), 0x8403));
+        expect(call("v128.load32_lane", 4, ones)).toBe(i32x4(-1, -1, -1, 0x88078605));
+        expect(call("v128.load64_lane", 8, ones)).toBe(i64x2(-1n, 0x900f8e0d_8c0b8a09n));
+    });
+
+    test("stores of a single lane", () => {
+        call("v128.store8_lane", 32, stored);
+        expect(call("v128.load", 32)).toBe(i8x16(bytes[5]));
+        call("v128.store16_lane", 48, stored);
+        expect(call("v128.load", 48)).toBe(i16x8(unpack(16, stored)[6]));
+        call("v128.store32_lane", 64, stored);
+        expect(call("v128.load", 64)).toBe(i32x4(unpack(32, stored)[2]));
+        call("v128.store64_lane", 80, stored);
+        expect(call("v128.load", 80)).toBe(i64x2(unpack(64, stored)[1]));
+    });
+
+    test("accesses that are out of bounds trap", () => {
+        expect(call("v128.load", 65520)).toBe(0n);
+        expect(() => call("v128.load", 65521)).toThrow(TypeError, "Execution trapped");
+        expect(() => call("v128.load64_splat", 65529)).toThrow(TypeError, "Execution trapped");
+        expect(() => call("v128.load32_zero", 65533)).toThrow(TypeError, "Execution trapped");
+        expect(() => call("v128.load16_lane", 65535, 0n)).toThrow(TypeError, "Execution trapped");
+        expect(() => call("v128.store", 65521, 0n)).toThrow(TypeError, "Execution trapped");
+        call("v128.store8_lane", 65535, 0n);
+        expect(() => call("v128.store8_lane", 65536, 0n)).toThrow(TypeError, "Execution trapped");
+    });
+});
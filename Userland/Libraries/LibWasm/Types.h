@@ -11,7 +11,9 @@
 #include <AK/DistinctNumeric.h>
 #include <AK/LEB128.h>
 #include <AK/NonnullOwnPtrVector.h>
+#include <AK/OwnPtr.h>
 #include <AK/Result.h>
+#include <AK/UFixedBigInt.h>
 #include <AK/Variant.h>
 #include <LibWasm/Constants.h>
 #include <LibWasm/Forward.h>
@@ -193,6 +195,7 @@ public:
         I64,
         F32,
         F64,
+        V128,
         FunctionReference,
         ExternReference,
         NullFunctionReference,
@@ -223,6 +226,8 @@ public:
             return "f32";
         case F64:
             return "f64";
+        case V128:
+            return "v128";
         case FunctionReference:
             return "funcref";
         case ExternReference:
@@ -444,6 +449,19 @@ public:
         u32 offset;
     };
 
+    struct MemoryAndLaneArgument {
+        MemoryArgument memory;
+        u8 lane;
+    };
+
+    struct LaneIndex {
+        u8 lane;
+    };
+
+    struct ShuffleArgument {
+        u8 lanes[16];
+    };
+
     template<typename T>
     explicit Instruction(OpCode opcode, T argument)
         : m_opcode(opcode)
@@ -467,8 +485,11 @@ private:
         GlobalIndex,
         IndirectCallArgs,
         LabelIndex,
+        LaneIndex,
         LocalIndex,
+        MemoryAndLaneArgument,
         MemoryArgument,
+        ShuffleArgument,
         StructuredInstructionArgs,
         TableBranchArgs,
         TableElementArgs,
@@ -480,6 +501,7 @@ private:
         float,
         i32,
         i64,
+        u128,
         u8 // Empty state
     > m_arguments;
     // clang-format on
@@ -987,21 +1009,25 @@ public:
 
     class Function {
     public:
-        explicit Function(TypeIndex type, Vector<ValueType> local_types, Expression body)
-            : m_type(type)
-            , m_local_types(move(local_types))
-            , m_body(move(body))
-        {
-        }
+        explicit Function(TypeIndex type, Vector<ValueType> local_types, Expression body);
+        Function(Function&&);
+        ~Function();
 
         auto& type() const { return m_type; }
         auto& locals() const { return m_local_types; }
         auto& body() const { return m_body; }
+        // The body is lowered the first time this is asked for, which only works once the module has been validated.
+        // Null if it couldn't be lowered.
+        LoweredFunction const* lowered_body() const;
+        void set_lowering_context(Context const&, FunctionType const&, Badge<Validator>);
 
     private:
         TypeIndex m_type;
         Vector<ValueType> m_local_types;
         Expression m_body;
+        Context const* m_lowering_context { nullptr };
+        FunctionType const* m_lowering_type { nullptr };
+        mutable Optional<OwnPtr<LoweredFunction>> m_lowered_body;
     };
 
     using AnySection = Variant<
@@ -1022,17 +1048,14 @@ public:
     static constexpr Array<u8, 4> wasm_magic { 0, 'a', 's', 'm' };
     static constexpr Array<u8, 4> wasm_version { 1, 0, 0, 0 };
 
-    explicit Module(Vector<AnySection> sections)
-        : m_sections(move(sections))
-    {
-        if (!populate_sections()) {
-            m_validation_status = ValidationStatus::Invalid;
-            m_validation_error = "Failed to populate module sections"sv;
-        }
-    }
+    explicit Module(Vector<AnySection> sections);
+    Module(Module&&);
+    Module& operator=(Module&&);
+    ~Module();
 
     auto& sections() const { return m_sections; }
     auto& functions() const { return m_functions; }
+    auto& functions() { return m_functions; }
     auto& type(TypeIndex index) const
     {
         FunctionType const* type = nullptr;
@@ -1062,6 +1085,7 @@ public:
     }
 
     void set_validation_status(ValidationStatus status, Badge<Validator>) { set_validation_status(status); }
+    void set_validation_context(NonnullOwnPtr<Context>, Badge<Validator>);
     ValidationStatus validation_status() const { return m_validation_status; }
     StringView validation_error() const { return *m_validation_error; }
     void set_validation_error(DeprecatedString error) { m_validation_error = move(error); }
@@ -1076,5 +1100,7 @@ private:
     Vector<Function> m_functions;
     ValidationStatus m_validation_status { ValidationStatus::Unchecked };
     Optional<DeprecatedString> m_validation_error;
+    // Kept around for lowering function bodies, see Function::lowered_body().
+    OwnPtr<Context> m_validation_context;
 };
 }
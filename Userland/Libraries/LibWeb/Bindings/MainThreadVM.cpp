@@ -64,6 +64,9 @@ JS::VM& main_thread_vm()
 
         static_cast<WebEngineCustomData*>(vm->custom_data())->event_loop.set_vm(*vm);
 
+        // Mark the heap in small steps between tasks, so that garbage collection doesn't make us miss frames.
+        vm->heap().set_incremental_marking_enabled(true);
+
         // 8.1.5.1 HostEnsureCanAddPrivateElement(O), https://html.spec.whatwg.org/multipage/webappapis.html#the-hostensurecanaddprivateelement-implementation
         vm->host_ensure_can_add_private_element = [](JS::Object const& object) -> JS::ThrowCompletionOr<void> {
             // 1. If O is a WindowProxy object, or implements Location, then return Completion { [[Type]]: throw, [[Value]]: a new TypeError }.
@@ -17,6 +17,7 @@
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/GradientPainting.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/Platform/Timer.h>
 
 namespace Web::CSS {
@@ -1535,6 +1536,8 @@ void ImageStyleValue::animate()
 
     if (on_animate)
         on_animate();
+    else if (m_document && m_document->browsing_context())
+        m_document->browsing_context()->set_needs_display();
 }
 
 Gfx::Bitmap const* ImageStyleValue::bitmap(size_t frame_index) const
@@ -11,6 +11,7 @@
 #include <AK/Debug.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/FunctionObject.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
@@ -66,6 +67,7 @@
 #include <LibWeb/Infra/Strings.h>
 #include <LibWeb/Layout/BlockFormattingContext.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
+#include <LibWeb/Layout/LayoutState.h>
 #include <LibWeb/Layout/TreeBuilder.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Page/Page.h>
@@ -306,7 +308,7 @@ Document::Document(JS::Realm& realm, const AK::URL& url)
     });
 
     m_layout_update_timer = Platform::Timer::create_single_shot(0, [this] {
-        force_layout();
+        update_layout();
     });
 }
 
@@ -717,6 +719,7 @@ void Document::tear_down_layout_tree()
     }
 
     m_layout_root = nullptr;
+    m_previous_layout_state = nullptr;
 }
 
 Color Document::background_color(Gfx::Palette const& palette) const
@@ -806,6 +809,16 @@ AK::URL Document::parse_url(DeprecatedString const& url) const
 }
 
 void Document::set_needs_layout()
+{
+    // NOTE: Since we don't know which part of the layout tree is affected, nothing from the previous layout can be reused.
+    m_previous_layout_state = nullptr;
+    if (m_needs_layout)
+        return;
+    m_needs_layout = true;
+    schedule_layout_update();
+}
+
+void Document::set_needs_incremental_layout(Badge<Layout::Node>)
 {
     if (m_needs_layout)
         return;
@@ -852,14 +865,18 @@ void Document::update_layout()
         m_layout_root = verify_cast<Layout::InitialContainingBlock>(*tree_builder.build(*this));
     }
 
-    Layout::LayoutState layout_state;
-    layout_state.used_values_per_layout_node.resize(layout_node_count());
+    auto layout_timer = Core::ElapsedTimer::start_new();
+
+    auto layout_state = make<Layout::LayoutState>();
+    layout_state->used_values_per_layout_node.resize(layout_node_count());
+    if (m_previous_layout_state)
+        layout_state->set_previous(*m_previous_layout_state);
 
     {
-        Layout::BlockFormattingContext root_formatting_context(layout_state, *m_layout_root, nullptr);
+        Layout::BlockFormattingContext root_formatting_context(*layout_state, *m_layout_root, nullptr);
 
         auto& icb = static_cast<Layout::InitialContainingBlock&>(*m_layout_root);
-        auto& icb_state = layout_state.get_mutable(icb);
+        auto& icb_state = layout_state->get_mutable(icb);
         icb_state.set_content_width(viewport_rect.width());
         icb_state.set_content_height(viewport_rect.height());
 
@@ -871,7 +888,17 @@ void Document::update_layout()
                 Layout::AvailableSize::make_definite(viewport_rect.height())));
     }
 
-    layout_state.commit();
+    layout_state->commit();
+
+    if (m_previous_layout_state)
+        ++m_layout_statistics.incremental_layout_count;
+    ++m_layout_statistics.layout_count;
+    m_layout_statistics.last_layout_time = layout_timer.elapsed_time();
+    m_layout_statistics.total_layout_time += m_layout_statistics.last_layout_time;
+
+    layout_state->m_previous = nullptr;
+    m_previous_layout_state = move(layout_state);
+    m_layout_root->clear_needs_layout();
 
     browsing_context()->set_needs_display();
 
@@ -1746,7 +1773,7 @@ void Document::run_the_resize_steps()
 
     window().dispatch_event(DOM::Event::create(realm(), UIEvents::EventNames::resize).release_value_but_fixme_should_propagate_errors());
 
-    schedule_layout_update();
+    invalidate_layout();
 }
 
 // https://w3c.github.io/csswg-drafts/cssom-view-1/#document-run-the-scroll-steps
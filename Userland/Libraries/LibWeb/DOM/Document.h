@@ -12,6 +12,7 @@
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/OwnPtr.h>
+#include <AK/Time.h>
 #include <AK/URL.h>
 #include <AK/Vector.h>
 #include <AK/WeakPtr.h>
@@ -190,6 +191,7 @@ public:
     void update_layout();
 
     void set_needs_layout();
+    void set_needs_incremental_layout(Badge<Layout::Node>);
 
     void invalidate_layout();
     void invalidate_stacking_context_tree();
@@ -202,6 +204,14 @@ public:
     void schedule_style_update();
     void schedule_layout_update();
 
+    struct LayoutStatistics {
+        size_t layout_count { 0 };
+        size_t incremental_layout_count { 0 };
+        Time last_layout_time;
+        Time total_layout_time;
+    };
+    LayoutStatistics const& layout_statistics() const { return m_layout_statistics; }
+
     JS::NonnullGCPtr<HTMLCollection> get_elements_by_name(DeprecatedString const&);
     JS::NonnullGCPtr<HTMLCollection> get_elements_by_class_name(DeprecatedFlyString const&);
 
@@ -479,6 +489,12 @@ private:
 
     JS::GCPtr<Layout::InitialContainingBlock> m_layout_root;
 
+    // NOTE: The state committed by the most recent layout. Subtrees that haven't been marked as needing layout
+    //       since then can copy their used values from here instead of being laid out again.
+    OwnPtr<Layout::LayoutState> m_previous_layout_state;
+
+    LayoutStatistics m_layout_statistics;
+
     Optional<Color> m_link_color;
     Optional<Color> m_active_link_color;
     Optional<Color> m_visited_link_color;
@@ -367,12 +367,15 @@ class PerformanceTiming;
 
 namespace Web::Painting {
 enum class PaintPhase;
+class BorderRadiusCornerClipper;
 class ButtonPaintable;
 class CheckBoxPaintable;
+class DisplayList;
 class LabelablePaintable;
 class Paintable;
 class PaintableBox;
 class PaintableWithLines;
+class RecordingPainter;
 class StackingContext;
 class TextPaintable;
 struct BorderRadiusData;
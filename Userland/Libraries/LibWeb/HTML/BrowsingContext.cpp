@@ -368,22 +368,27 @@ void BrowsingContext::set_size(CSSPixelSize size)
 
 void BrowsingContext::set_needs_display()
 {
+    if (auto* document = active_document(); document && document->layout_node())
+        document->layout_node()->invalidate_display_list();
+
     set_needs_display(viewport_rect());
 }
 
 void BrowsingContext::set_needs_display(CSSPixelRect const& rect)
 {
-    if (!viewport_rect().intersects(rect))
+    // NOTE: Our content is recorded into the display lists of the container's document as well,
+    //       so those have to be invalidated even if the change isn't visible right now.
+    if (!is_top_level()) {
+        if (container() && container()->layout_node())
+            container()->layout_node()->set_needs_display();
         return;
+    }
 
-    if (is_top_level()) {
-        if (m_page)
-            m_page->client().page_did_invalidate(to_top_level_rect(rect));
+    if (!viewport_rect().intersects(rect))
         return;
-    }
 
-    if (container() && container()->layout_node())
-        container()->layout_node()->set_needs_display();
+    if (m_page)
+        m_page->client().page_did_invalidate(to_top_level_rect(rect));
 }
 
 void BrowsingContext::scroll_to(CSSPixelPoint position)
@@ -86,6 +86,8 @@ void HTMLInputElement::set_checked(bool checked, ChangeSource change_source)
 
     m_checked = checked;
     set_needs_style_update(true);
+    if (layout_node())
+        layout_node()->set_needs_display();
 }
 
 void HTMLInputElement::set_checked_binding(bool checked)
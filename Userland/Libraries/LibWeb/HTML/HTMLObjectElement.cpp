@@ -340,7 +340,9 @@ void HTMLObjectElement::update_layout_and_child_objects(Representation represent
 
     m_representation = representation;
     set_needs_style_update(true);
-    document().set_needs_layout();
+
+    // NOTE: The kind of layout node we create depends on our representation, so the layout tree has to be rebuilt.
+    document().invalidate_layout();
 }
 
 // https://html.spec.whatwg.org/multipage/interaction.html#dom-tabindex
@@ -502,10 +502,14 @@ void BlockFormattingContext::layout_block_level_box(Box const& box, BlockContain
             // Margins of elements that establish new formatting contexts do not collapse with their in-flow children
             m_margin_state.reset();
 
-            independent_formatting_context->run(box, layout_mode, box_state.available_inner_space_or_constraints_from(available_space));
+            if (try_reuse_previous_layout_of_inside(box, layout_mode))
+                independent_formatting_context = nullptr;
+            else
+                independent_formatting_context->run(box, layout_mode, box_state.available_inner_space_or_constraints_from(available_space));
         } else {
             if (box.children_are_inline()) {
-                layout_inline_children(verify_cast<BlockContainer>(box), layout_mode, box_state.available_inner_space_or_constraints_from(available_space));
+                if (!can_reuse_previous_layout_of_inline_children(box) || !try_reuse_previous_layout_of_inside(box, layout_mode))
+                    layout_inline_children(verify_cast<BlockContainer>(box), layout_mode, box_state.available_inner_space_or_constraints_from(available_space));
             } else {
                 if (box_state.border_top > 0 || box_state.padding_top > 0) {
                     // margin-top of block container can't collapse with it's children if it has non zero border or padding
@@ -547,6 +551,28 @@ void BlockFormattingContext::layout_block_level_box(Box const& box, BlockContain
         independent_formatting_context->parent_context_did_dimension_child_root_box();
 }
 
+bool BlockFormattingContext::can_reuse_previous_layout_of_inline_children(Box const& box) const
+{
+    // NOTE: Nothing can be reused from a dirty subtree, so don't bother walking it looking for floats.
+    if (box.needs_layout() || box.child_needs_layout())
+        return false;
+
+    // NOTE: Line boxes are shortened by floats in this BFC, and floats inside the inline content are placed by this BFC.
+    //       Since reusing the previous layout would skip both, we only do it when no floats are involved at all.
+    if (!m_left_floats.all_boxes.is_empty() || !m_right_floats.all_boxes.is_empty())
+        return false;
+
+    bool has_floating_descendant = false;
+    box.for_each_in_subtree_of_type<Box>([&](Box const& descendant) {
+        if (descendant.is_floating()) {
+            has_floating_descendant = true;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    return !has_floating_descendant;
+}
+
 void BlockFormattingContext::layout_block_level_children(BlockContainer const& block_container, LayoutMode layout_mode, AvailableSpace const& available_space)
 {
     VERIFY(!block_container.children_are_inline());
@@ -46,6 +46,8 @@ void Box::set_scroll_offset(CSSPixelPoint offset)
 
 void Box::set_needs_display()
 {
+    invalidate_display_list();
+
     if (paint_box())
         browsing_context().set_needs_display(paint_box()->absolute_rect());
 }
@@ -216,6 +216,8 @@ void FlexFormattingContext::run(Box const& run_box, LayoutMode, AvailableSpace c
     // AD-HOC: Layout the inside of all flex items.
     copy_dimensions_from_flex_items_to_boxes();
     for (auto& flex_item : m_flex_items) {
+        if (try_reuse_previous_layout_of_inside(flex_item.box, LayoutMode::Normal))
+            continue;
         auto& box_state = m_state.get(flex_item.box);
         if (auto independent_formatting_context = layout_inside(flex_item.box, LayoutMode::Normal, box_state.available_inner_space_or_constraints_from(m_available_space_for_flex_container->space)))
             independent_formatting_context->parent_context_did_dimension_child_root_box();
@@ -208,6 +208,64 @@ OwnPtr<FormattingContext> FormattingContext::layout_inside(Box const& child_box,
     return independent_formatting_context;
 }
 
+// If nothing inside `box` has been marked as needing layout since the previous layout, and the parent formatting context
+// has given `box` the same size as back then, laying out its inside would produce the same used values all over again.
+// In that case, we copy them over from the previous layout instead and return true.
+bool FormattingContext::try_reuse_previous_layout_of_inside(Box const& box, LayoutMode layout_mode)
+{
+    // NOTE: Intrinsic sizing lays out boxes under hypothetical constraints, so only the results of normal layout are kept around.
+    if (layout_mode != LayoutMode::Normal)
+        return false;
+
+    auto const* previous_state = m_state.m_root.m_previous;
+    if (!previous_state)
+        return false;
+
+    if (box.needs_layout() || box.child_needs_layout())
+        return false;
+
+    auto previous_used_values_for = [&](NodeWithStyleAndBoxModelMetrics const& node) -> LayoutState::UsedValues const* {
+        // NOTE: Nodes created since the previous layout have nothing to reuse.
+        if (node.serial_id() >= previous_state->used_values_per_layout_node.size())
+            return nullptr;
+        return previous_state->used_values_per_layout_node[node.serial_id()].ptr();
+    };
+
+    auto const* previous_box_state = previous_used_values_for(box);
+    if (!previous_box_state)
+        return false;
+
+    auto const& box_state = m_state.get(box);
+    if (box_state.width_constraint != SizeConstraint::None || box_state.height_constraint != SizeConstraint::None)
+        return false;
+    if (box_state.content_width() != previous_box_state->content_width())
+        return false;
+    if (box_state.has_definite_height() && box_state.content_height() != previous_box_state->content_height())
+        return false;
+
+    // NOTE: Absolutely positioned descendants with a containing block outside of `box` are placed relative to
+    //       something that may well have moved since the previous layout.
+    bool has_descendant_positioned_from_outside = false;
+    box.for_each_in_subtree_of_type<Box>([&](Box const& descendant) {
+        if (descendant.is_absolutely_positioned() && !box.is_inclusive_ancestor_of(*descendant.containing_block())) {
+            has_descendant_positioned_from_outside = true;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    if (has_descendant_positioned_from_outside)
+        return false;
+
+    box.for_each_in_subtree_of_type<NodeWithStyleAndBoxModelMetrics>([&](NodeWithStyleAndBoxModelMetrics const& descendant) {
+        if (auto const* previous_used_values = previous_used_values_for(descendant))
+            m_state.used_values_per_layout_node[descendant.serial_id()] = adopt_own(*new LayoutState::UsedValues(*previous_used_values));
+        return IterationDecision::Continue;
+    });
+
+    m_state.get_mutable(box).reuse_inside_layout_from(*previous_box_state);
+    return true;
+}
+
 CSSPixels FormattingContext::greatest_child_width(Box const& box)
 {
     CSSPixels max_width = 0;
@@ -89,6 +89,7 @@ protected:
     static bool should_treat_height_as_auto(Box const&, AvailableSpace const&);
 
     OwnPtr<FormattingContext> layout_inside(Box const&, LayoutMode, AvailableSpace const&);
+    [[nodiscard]] bool try_reuse_previous_layout_of_inside(Box const&, LayoutMode);
     void compute_inset(Box const& box);
 
     struct SpaceUsedByFloats {
@@ -8,6 +8,7 @@
 #include <LibWeb/Dump.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/Painting/StackingContext.h>
 
 namespace Web::Layout {
@@ -56,6 +56,9 @@ void LayoutState::commit()
     // Only the top-level LayoutState should ever be committed.
     VERIFY(!m_parent);
 
+    // NOTE: Used values are copied rather than moved into the paintables, since the committed state is kept
+    //       around so the next layout can reuse it for subtrees that haven't changed.
+
     HashTable<Layout::TextNode*> text_nodes;
 
     for (auto& used_values_ptr : used_values_per_layout_node) {
@@ -78,7 +81,7 @@ void LayoutState::commit()
             auto& paint_box = const_cast<Painting::PaintableBox&>(*box.paint_box());
             paint_box.set_offset(used_values.offset);
             paint_box.set_content_size(used_values.content_width(), used_values.content_height());
-            paint_box.set_overflow_data(move(used_values.overflow_data));
+            paint_box.set_overflow_data(used_values.overflow_data);
             paint_box.set_containing_line_box_fragment(used_values.containing_line_box_fragment);
 
             if (is<Layout::BlockContainer>(box)) {
@@ -88,7 +91,7 @@ void LayoutState::commit()
                             text_nodes.set(static_cast<Layout::TextNode*>(const_cast<Layout::Node*>(&fragment.layout_node())));
                     }
                 }
-                static_cast<Painting::PaintableWithLines&>(paint_box).set_line_boxes(move(used_values.line_boxes));
+                static_cast<Painting::PaintableWithLines&>(paint_box).set_line_boxes(Vector<LineBox>(used_values.line_boxes));
             }
         }
     }
@@ -97,6 +100,22 @@ void LayoutState::commit()
         text_node->set_paintable(text_node->create_paintable());
 }
 
+void LayoutState::set_previous(LayoutState const& previous)
+{
+    // Only the top-level LayoutState should ever reuse values from a previous layout.
+    VERIFY(!m_parent);
+    VERIFY(!previous.m_parent);
+
+    m_previous = &previous;
+
+    for (auto const& it : previous.intrinsic_sizes) {
+        auto const& node = *it.key;
+        if (node.needs_layout() || node.child_needs_layout())
+            continue;
+        intrinsic_sizes.set(it.key, adopt_own(*new IntrinsicSizes(*it.value)));
+    }
+}
+
 CSSPixels box_baseline(LayoutState const& state, Box const& box)
 {
     auto const& box_state = state.get(box);
@@ -324,6 +343,14 @@ void LayoutState::UsedValues::set_node(NodeWithStyleAndBoxModelMetrics& node, Us
     }
 }
 
+void LayoutState::UsedValues::reuse_inside_layout_from(UsedValues const& previous)
+{
+    VERIFY(m_node == previous.m_node);
+    line_boxes = previous.line_boxes;
+    overflow_data = previous.overflow_data;
+    m_floating_descendants = previous.m_floating_descendants;
+}
+
 void LayoutState::UsedValues::set_content_width(CSSPixels width)
 {
     m_content_width = width;
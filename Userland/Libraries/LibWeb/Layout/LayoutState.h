@@ -127,6 +127,10 @@ struct LayoutState {
         void add_floating_descendant(Box const& box) { m_floating_descendants.set(&box); }
         auto const& floating_descendants() const { return m_floating_descendants; }
 
+        // Takes over the results of laying out the inside of this node from `previous`,
+        // without touching anything the parent formatting context has assigned already.
+        void reuse_inside_layout_from(UsedValues const& previous);
+
     private:
         AvailableSize available_width_inside() const;
         AvailableSize available_height_inside() const;
@@ -147,6 +151,10 @@ struct LayoutState {
 
     void commit();
 
+    // Makes the used values and cached intrinsic sizes of `previous`, the state committed by the previous layout
+    // of the same layout tree, available to nodes whose subtree hasn't been marked as needing layout since then.
+    void set_previous(LayoutState const& previous);
+
     // NOTE: get_mutable() will CoW the UsedValues if it's inherited from an ancestor state;
     UsedValues& get_mutable(NodeWithStyleAndBoxModelMetrics const&);
 
@@ -175,6 +183,7 @@ struct LayoutState {
 
     LayoutState const* m_parent { nullptr };
     LayoutState const& m_root;
+    LayoutState const* m_previous { nullptr };
 };
 
 CSSPixelRect absolute_content_rect(Box const&, LayoutState const&);
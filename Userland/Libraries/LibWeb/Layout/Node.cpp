@@ -15,6 +15,8 @@
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Layout/TableBox.h>
 #include <LibWeb/Layout/TextNode.h>
+#include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/StackingContext.h>
 #include <LibWeb/Platform/FontPlugin.h>
 
 namespace Web::Layout {
@@ -164,8 +166,37 @@ InitialContainingBlock& Node::root()
     return *document().layout_node();
 }
 
+void Node::invalidate_display_list()
+{
+    // If the stacking context tree is waiting to be rebuilt, there's nothing recorded that could go stale.
+    auto const* root_paint_box = document().paint_box();
+    if (!root_paint_box || !root_paint_box->stacking_context())
+        return;
+
+    // Everything is painted into the initial containing block, so it takes all of the recorded display lists with it.
+    if (is<InitialContainingBlock>(*this)) {
+        for_each_in_inclusive_subtree_of_type<Box>([](Box const& box) {
+            if (auto const* paint_box = box.paint_box(); paint_box && paint_box->stacking_context())
+                paint_box->stacking_context()->invalidate_display_list();
+            return IterationDecision::Continue;
+        });
+        return;
+    }
+
+    for (Node const* ancestor = this; ancestor; ancestor = ancestor->parent()) {
+        if (!is<Box>(*ancestor))
+            continue;
+        if (auto const* paint_box = static_cast<Box const&>(*ancestor).paint_box(); paint_box && paint_box->stacking_context()) {
+            paint_box->stacking_context()->invalidate_display_list();
+            return;
+        }
+    }
+}
+
 void Node::set_needs_display()
 {
+    invalidate_display_list();
+
     auto* containing_block = this->containing_block();
     if (!containing_block)
         return;
@@ -181,6 +212,24 @@ void Node::set_needs_display()
     });
 }
 
+void Node::set_needs_layout()
+{
+    m_needs_layout = true;
+    for (auto* ancestor = parent(); ancestor && !ancestor->m_child_needs_layout; ancestor = ancestor->parent())
+        ancestor->m_child_needs_layout = true;
+    document().set_needs_incremental_layout({});
+}
+
+void Node::clear_needs_layout()
+{
+    m_needs_layout = false;
+    if (!m_child_needs_layout)
+        return;
+    m_child_needs_layout = false;
+    for (auto* child = first_child(); child; child = child->next_sibling())
+        child->clear_needs_layout();
+}
+
 CSSPixelPoint Node::box_type_agnostic_position() const
 {
     if (is<Box>(*this))
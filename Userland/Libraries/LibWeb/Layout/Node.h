@@ -129,6 +129,18 @@ public:
 
     virtual void set_needs_display();
 
+    // NOTE: Drops the display lists recorded for the stacking context this node gets painted into,
+    //       so that they are re-recorded the next time the page is painted.
+    void invalidate_display_list();
+
+    // NOTE: A node that needs layout has changed in a way that may affect its own geometry or that of its descendants.
+    //       Its ancestors are flagged with child_needs_layout() so that layout can find its way down to it,
+    //       while clean subtrees can reuse the used values from the previous layout pass.
+    bool needs_layout() const { return m_needs_layout; }
+    bool child_needs_layout() const { return m_child_needs_layout; }
+    void set_needs_layout();
+    void clear_needs_layout();
+
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
@@ -164,6 +176,8 @@ private:
     bool m_has_style { false };
     bool m_visible { true };
     bool m_children_are_inline { false };
+    bool m_needs_layout { false };
+    bool m_child_needs_layout { false };
     SelectionState m_selection_state { SelectionState::None };
 
     bool m_is_flex_item { false };
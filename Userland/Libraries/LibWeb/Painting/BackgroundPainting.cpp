@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/Painter.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
@@ -14,6 +15,7 @@
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
 #include <LibWeb/Painting/GradientPainting.h>
 #include <LibWeb/Painting/PaintContext.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 
 namespace Web::Painting {
 
@@ -75,8 +77,7 @@ void paint_background(PaintContext& context, Layout::NodeWithStyleAndBoxModelMet
         }
     }
 
-    Gfx::AntiAliasingPainter aa_painter { painter };
-    aa_painter.fill_rect_with_rounded_corners(context.rounded_device_rect(color_box.rect).to_type<int>(),
+    painter.fill_rect_with_rounded_corners(context.rounded_device_rect(color_box.rect).to_type<int>(),
         background_color, color_box.radii.top_left.as_corner(context), color_box.radii.top_right.as_corner(context), color_box.radii.bottom_right.as_corner(context), color_box.radii.bottom_left.as_corner(context));
 
     if (!has_paintable_layers)
@@ -106,7 +107,8 @@ void paint_background(PaintContext& context, Layout::NodeWithStyleAndBoxModelMet
     for (auto& layer : background_layers->in_reverse()) {
         if (!layer_is_paintable(layer))
             continue;
-        Gfx::PainterStateSaver state { painter };
+        painter.save();
+        ScopeGuard restore_painter = [&] { painter.restore(); };
 
         // Clip
         auto clip_box = get_box(layer.clip);
@@ -129,6 +131,7 @@ void paint_background(PaintContext& context, Layout::NodeWithStyleAndBoxModelMet
         switch (layer.attachment) {
         case CSS::BackgroundAttachment::Fixed:
             background_positioning_area = layout_node.root().browsing_context().viewport_rect();
+            painter.set_depends_on_viewport();
             break;
         case CSS::BackgroundAttachment::Local:
         case CSS::BackgroundAttachment::Scroll:
@@ -316,8 +319,12 @@ void paint_background(PaintContext& context, Layout::NodeWithStyleAndBoxModelMet
             while (image_x <= css_clip_rect.right()) {
                 image_rect.set_x(image_x);
                 auto image_device_rect = context.rounded_device_rect(image_rect);
-                if (image_device_rect != last_image_device_rect && image_device_rect.intersects(context.device_viewport_rect()))
-                    image.paint(context, image_device_rect, image_rendering);
+                if (image_device_rect != last_image_device_rect) {
+                    if (image_device_rect.intersects(context.device_viewport_rect()))
+                        image.paint(context, image_device_rect, image_rendering);
+                    else
+                        painter.set_depends_on_viewport();
+                }
                 last_image_device_rect = image_device_rect;
                 if (!repeat_x)
                     break;
@@ -11,6 +11,7 @@
 #include <LibGfx/Path.h>
 #include <LibWeb/Painting/BorderPainting.h>
 #include <LibWeb/Painting/PaintContext.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 
 namespace Web::Painting {
 
@@ -134,8 +135,7 @@ void paint_border(PaintContext& context, BorderEdge edge, DevicePixelRect const&
             break;
         }
         if (border_style == CSS::LineStyle::Dotted) {
-            Gfx::AntiAliasingPainter aa_painter { context.painter() };
-            aa_painter.draw_line(p1.to_type<int>(), p2.to_type<int>(), color, device_pixel_width.value(), gfx_line_style);
+            context.painter().draw_anti_aliased_line(p1.to_type<int>(), p2.to_type<int>(), color, device_pixel_width.value(), gfx_line_style);
             return;
         }
         context.painter().draw_line(p1.to_type<int>(), p2.to_type<int>(), color, device_pixel_width.value(), gfx_line_style);
@@ -347,12 +347,16 @@ void paint_all_borders(PaintContext& context, CSSPixelRect const& bordered_rect,
     inner_bottom_left.vertical_radius = max(0, inner_bottom_left.vertical_radius - context.enclosing_device_pixels(borders_data.bottom.width).value());
     aa_painter.fill_rect_with_rounded_corners(inner_corner_mask_rect.to_type<int>(), border_color_no_alpha, inner_top_left, inner_top_right, inner_bottom_right, inner_bottom_left, Gfx::AntiAliasingPainter::BlendMode::AlphaSubtract);
 
+    // NOTE: The cached bitmap gets painted over by the next border, so the display list needs its own copy.
+    auto corner_mask_or_error = corner_bitmap->cropped(corner_mask_rect.to_type<int>());
+    if (corner_mask_or_error.is_error())
+        return;
+    auto corner_mask = corner_mask_or_error.release_value();
+
     // TODO: Support dual color corners. Other browsers will render a rounded corner between two borders of
     // different colors using both colours, normally split at a 45 degree angle (though the exact angle is interpolated).
     auto blit_corner = [&](Gfx::IntPoint position, Gfx::IntRect const& src_rect, Color corner_color) {
-        context.painter().blit_filtered(position, *corner_bitmap, src_rect, [&](auto const& corner_pixel) {
-            return corner_color.with_alpha((corner_color.alpha() * corner_pixel.alpha()) / 255);
-        });
+        context.painter().blit_mask(position, *corner_mask, src_rect, corner_color);
     };
 
     // FIXME: Corners should actually split between the two colors, if both are provided (and differ)
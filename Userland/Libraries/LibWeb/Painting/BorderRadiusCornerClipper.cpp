@@ -7,10 +7,11 @@
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Painter.h>
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 
 namespace Web::Painting {
 
-ErrorOr<BorderRadiusCornerClipper> BorderRadiusCornerClipper::create(PaintContext& context, DevicePixelRect const& border_rect, BorderRadiiData const& border_radii, CornerClip corner_clip, UseCachedBitmap use_cached_bitmap)
+ErrorOr<NonnullRefPtr<BorderRadiusCornerClipper>> BorderRadiusCornerClipper::create(PaintContext& context, DevicePixelRect const& border_rect, BorderRadiiData const& border_radii, CornerClip corner_clip, UseCachedBitmap use_cached_bitmap)
 {
     VERIFY(border_radii.has_any_radius());
 
@@ -48,7 +49,7 @@ ErrorOr<BorderRadiusCornerClipper> BorderRadiusCornerClipper::create(PaintContex
         .corner_bitmap_size = corners_bitmap_size
     };
 
-    return BorderRadiusCornerClipper { corner_data, corner_bitmap.release_nonnull(), corner_clip };
+    return adopt_nonnull_ref_or_enomem(new (nothrow) BorderRadiusCornerClipper(corner_data, corner_bitmap.release_nonnull(), corner_clip));
 }
 
 void BorderRadiusCornerClipper::sample_under_corners(Gfx::Painter& page_painter)
@@ -107,4 +108,22 @@ void BorderRadiusCornerClipper::blit_corner_clipping(Gfx::Painter& painter)
         painter.blit(m_data.page_locations.bottom_left.to_type<int>(), *m_corner_bitmap, m_data.corner_radii.bottom_left.as_rect().translated(m_data.bitmap_locations.bottom_left.to_type<int>()));
 }
 
+ScopedCornerRadiusClip::ScopedCornerRadiusClip(PaintContext& context, RecordingPainter& painter, DevicePixelRect const& border_rect, BorderRadiiData const& border_radii, CornerClip corner_clip, BorderRadiusCornerClipper::UseCachedBitmap use_cached_bitmap)
+    : m_painter(painter)
+{
+    if (border_radii.has_any_radius()) {
+        auto clipper = BorderRadiusCornerClipper::create(context, border_rect, border_radii, corner_clip, use_cached_bitmap);
+        if (!clipper.is_error()) {
+            m_corner_clipper = clipper.release_value();
+            m_painter.sample_under_corners(*m_corner_clipper);
+        }
+    }
+}
+
+ScopedCornerRadiusClip::~ScopedCornerRadiusClip()
+{
+    if (m_corner_clipper)
+        m_painter.blit_corner_clipping(*m_corner_clipper);
+}
+
 }
@@ -10,6 +10,7 @@
 #include <LibWeb/Layout/ButtonBox.h>
 #include <LibWeb/Layout/Label.h>
 #include <LibWeb/Painting/ButtonPaintable.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 
 namespace Web::Painting {
 
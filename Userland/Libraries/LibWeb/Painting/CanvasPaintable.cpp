@@ -5,6 +5,7 @@
  */
 
 #include <LibWeb/Painting/CanvasPaintable.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 
 namespace Web::Painting {
 
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Utf8View.h>
+#include <LibGfx/AntiAliasingPainter.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/StylePainter.h>
+#include <LibWeb/Painting/BorderRadiusCornerClipper.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/FilterPainting.h>
+
+namespace Web::Painting {
+
+NonnullRefPtr<DisplayList> DisplayList::create(Vector<Item> items, RecordingState const& initial_state, RecordingState const& final_state, bool depends_on_viewport)
+{
+    return adopt_ref(*new DisplayList(move(items), initial_state, final_state, depends_on_viewport));
+}
+
+DisplayList::DisplayList(Vector<Item> items, RecordingState const& initial_state, RecordingState const& final_state, bool depends_on_viewport)
+    : m_items(move(items))
+    , m_initial_state(initial_state)
+    , m_final_state(final_state)
+    , m_depends_on_viewport(depends_on_viewport)
+{
+    for (auto const& item : m_items) {
+        if (!item.bounding_rect.has_value()) {
+            // Lists that start a new coordinate space can't be bounded in ours, so give up on culling this list as a whole.
+            if (auto const* execute = item.command.get_pointer<DisplayListCommands::ExecuteDisplayList>(); execute && execute->starts_new_coordinate_space)
+                m_has_unbounded_content = true;
+            continue;
+        }
+        if (!m_bounding_rect.has_value())
+            m_bounding_rect = item.bounding_rect;
+        else
+            m_bounding_rect = m_bounding_rect->united(*item.bounding_rect);
+    }
+
+    // Skipping a list that leaves the painter in a different state than it found it would throw off whatever comes after it.
+    if (m_initial_state.translation != m_final_state.translation || m_initial_state.clip_rect != m_final_state.clip_rect)
+        m_has_unbounded_content = true;
+}
+
+DisplayList::~DisplayList() = default;
+
+size_t DisplayList::command_count() const
+{
+    size_t count = 0;
+    for (auto const& item : m_items) {
+        ++count;
+        if (auto const* execute = item.command.get_pointer<DisplayListCommands::ExecuteDisplayList>())
+            count += execute->display_list->command_count();
+        else if (auto const* layer = item.command.get_pointer<DisplayListCommands::PaintLayer>())
+            count += layer->content->command_count();
+    }
+    return count;
+}
+
+void DisplayList::execute(Gfx::Painter& painter) const
+{
+    execute(painter, painter.translation(), painter.clip_rect());
+}
+
+static void paint_layer(Gfx::Painter& painter, DisplayListCommands::PaintLayer const& layer)
+{
+    // NOTE: This copies the background at the destination, then scales it down/up to the size of the source,
+    //       because a bunch of our rendering effects rely on being able to sample the painter (see border radii,
+    //       shadows, filters, etc).
+    auto destination_rect = layer.destination_rect;
+    Gfx::FloatPoint destination_clipped_fixup {};
+    auto try_get_scaled_destination_bitmap = [&]() -> ErrorOr<NonnullRefPtr<Gfx::Bitmap>> {
+        Gfx::IntRect actual_destination_rect;
+        auto bitmap = TRY(painter.get_region_bitmap(destination_rect, Gfx::BitmapFormat::BGRA8888, actual_destination_rect));
+        // get_region_bitmap() may clip to a smaller region if the requested rect goes outside the painter, so we need to account for that.
+        destination_clipped_fixup = (destination_rect.location() - actual_destination_rect.location()).to_type<float>();
+        destination_rect = actual_destination_rect;
+        if (layer.source_size != layer.transformed_destination_size) {
+            auto sx = layer.source_size.width() / layer.transformed_destination_size.width();
+            auto sy = layer.source_size.height() / layer.transformed_destination_size.height();
+            bitmap = TRY(bitmap->scaled(sx, sy));
+            destination_clipped_fixup.scale_by(sx, sy);
+        }
+        return bitmap;
+    };
+
+    auto bitmap_or_error = try_get_scaled_destination_bitmap();
+    if (bitmap_or_error.is_error())
+        return;
+    auto bitmap = bitmap_or_error.release_value_but_fixme_should_propagate_errors();
+
+    Gfx::Painter layer_painter(bitmap);
+    auto content_offset = (layer.content_origin + destination_clipped_fixup).scaled(layer.device_pixels_per_css_pixel, layer.device_pixels_per_css_pixel);
+    layer_painter.translate(content_offset.to_rounded<int>());
+    layer.content->execute(layer_painter);
+
+    if (destination_rect.size() == bitmap->size())
+        painter.blit(destination_rect.location(), *bitmap, bitmap->rect(), layer.opacity);
+    else
+        painter.draw_scaled_bitmap(destination_rect, *bitmap, bitmap->rect(), layer.opacity, Gfx::Painter::ScalingMode::BilinearBlend);
+}
+
+static void apply_backdrop_filter(Gfx::Painter& painter, DisplayListCommands::ApplyBackdropFilter const& command)
+{
+    // This performs the backdrop filter operation: https://drafts.fxtf.org/filter-effects-2/#backdrop-filter-operation
+
+    // Note: The region bitmap can be smaller than the backdrop_region if it's at the edge of canvas.
+    Gfx::IntRect actual_region {};
+
+    // FIXME: Go through the steps to find the "Backdrop Root Image"
+    // https://drafts.fxtf.org/filter-effects-2/#BackdropRoot
+
+    // 1. Copy the Backdrop Root Image into a temporary buffer, such as a raster image. Call this buffer T’.
+    auto maybe_backdrop_bitmap = painter.get_region_bitmap(command.backdrop_region, Gfx::BitmapFormat::BGRA8888, actual_region);
+    if (actual_region.is_empty())
+        return;
+    if (maybe_backdrop_bitmap.is_error()) {
+        dbgln("Failed get region bitmap for backdrop-filter");
+        return;
+    }
+    auto backdrop_bitmap = maybe_backdrop_bitmap.release_value();
+    // 2. Apply the backdrop-filter’s filter operations to the entire contents of T'.
+    apply_filter_list(*backdrop_bitmap, command.filters);
+
+    // FIXME: 3. If element B has any transforms (between B and the Backdrop Root), apply the inverse of those transforms to the contents of T’.
+
+    // 4. Apply a clip to the contents of T’, using the border box of element B, including border-radius if specified. Note that the children of B are not considered for the sizing or location of this clip.
+    if (command.corner_clipper)
+        command.corner_clipper->sample_under_corners(painter);
+
+    // FIXME: 5. Draw all of element B, including its background, border, and any children elements, into T’.
+
+    // FXIME: 6. If element B has any transforms, effects, or clips, apply those to T’.
+
+    // 7. Composite the contents of T’ into element B’s parent, using source-over compositing.
+    painter.blit(actual_region.location(), *backdrop_bitmap, backdrop_bitmap->rect());
+
+    if (command.corner_clipper)
+        command.corner_clipper->blit_corner_clipping(painter);
+}
+
+void DisplayList::execute(Gfx::Painter& painter, Gfx::IntPoint origin, Gfx::IntRect const& base_clip_rect) const
+{
+    using namespace DisplayListCommands;
+
+    for (auto const& item : m_items) {
+        // Skip anything that falls entirely outside of the area being repainted.
+        if (item.bounding_rect.has_value() && !item.bounding_rect->translated(origin).intersects(painter.clip_rect()))
+            continue;
+
+        item.command.visit(
+            [&](Save const&) {
+                painter.save();
+            },
+            [&](Restore const&) {
+                painter.restore();
+            },
+            [&](Translate const& command) {
+                painter.translate(command.delta);
+            },
+            [&](AddClipRect const& command) {
+                painter.add_clip_rect(command.rect);
+            },
+            [&](SetClipRect const& command) {
+                painter.set_clip_rect(command.rect.translated(origin).intersected(base_clip_rect));
+            },
+            [&](ClearClipRect const&) {
+                painter.set_clip_rect(base_clip_rect);
+            },
+            [&](FillRect const& command) {
+                painter.fill_rect(command.rect, command.color);
+            },
+            [&](DrawRect const& command) {
+                painter.draw_rect(command.rect, command.color, command.rough);
+            },
+            [&](DrawFocusRect const& command) {
+                painter.draw_focus_rect(command.rect, command.color);
+            },
+            [&](DrawLine const& command) {
+                painter.draw_line(command.from, command.to, command.color, command.thickness, command.style, command.alternate_color);
+            },
+            [&](DrawTriangleWave const& command) {
+                painter.draw_triangle_wave(command.from, command.to, command.color, command.amplitude, command.thickness);
+            },
+            [&](DrawText const& command) {
+                painter.draw_text(command.rect, command.text, *command.font, command.alignment, command.color, command.elision, command.wrapping);
+            },
+            [&](DrawGlyphRun const& command) {
+                painter.draw_text_run(command.baseline_start, Utf8View(command.text.view()), *command.font, command.color);
+            },
+            [&](Blit const& command) {
+                painter.blit(command.position, *command.bitmap, command.src_rect, command.opacity);
+            },
+            [&](BlitMask const& command) {
+                auto color = command.color;
+                painter.blit_filtered(command.position, *command.mask, command.src_rect, [color](auto const& mask_pixel) {
+                    return color.with_alpha((color.alpha() * mask_pixel.alpha()) / 255);
+                });
+            },
+            [&](DrawScaledBitmap const& command) {
+                painter.draw_scaled_bitmap(command.dst_rect, *command.bitmap, command.src_rect, command.opacity, command.scaling_mode);
+            },
+            [&](FillRectWithLinearGradient const& command) {
+                painter.fill_rect_with_linear_gradient(command.rect, command.color_stops, command.angle, command.repeat_length);
+            },
+            [&](FillRectWithConicGradient const& command) {
+                painter.fill_rect_with_conic_gradient(command.rect, command.color_stops, command.center, command.start_angle, command.repeat_length);
+            },
+            [&](FillRectWithRadialGradient const& command) {
+                painter.fill_rect_with_radial_gradient(command.rect, command.color_stops, command.center, command.size, command.repeat_length);
+            },
+            [&](FillRectWithRoundedCorners const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.fill_rect_with_rounded_corners(command.rect, command.color, command.top_left, command.top_right, command.bottom_right, command.bottom_left, command.blend_mode);
+            },
+            [&](FillEllipse const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.fill_ellipse(command.rect, command.color);
+            },
+            [&](DrawEllipse const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.draw_ellipse(command.rect, command.color, command.thickness);
+            },
+            [&](DrawAntiAliasedLine const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.draw_line(command.from, command.to, command.color, command.thickness, command.style);
+            },
+            [&](FillPath const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.translate(command.translation);
+                aa_painter.fill_path(command.path, command.color, command.winding_rule);
+            },
+            [&](StrokePath const& command) {
+                Gfx::AntiAliasingPainter aa_painter { painter };
+                aa_painter.translate(command.translation);
+                aa_painter.stroke_path(command.path, command.color, command.thickness);
+            },
+            [&](PaintFrame const& command) {
+                Gfx::StylePainter::paint_frame(painter, command.rect, command.palette, command.shape, command.shadow, command.thickness);
+            },
+            [&](PaintProgressbar const& command) {
+                Gfx::StylePainter::paint_progressbar(painter, command.rect, command.palette, command.min, command.max, command.value, command.text);
+            },
+            [&](PaintRadioButton const& command) {
+                Gfx::StylePainter::paint_radio_button(painter, command.rect, command.palette, command.is_checked, command.is_being_pressed);
+            },
+            [&](SampleUnderCorners const& command) {
+                command.corner_clipper->sample_under_corners(painter);
+            },
+            [&](BlitCornerClipping const& command) {
+                command.corner_clipper->blit_corner_clipping(painter);
+            },
+            [&](ApplyBackdropFilter const& command) {
+                apply_backdrop_filter(painter, command);
+            },
+            [&](PaintLayer const& command) {
+                paint_layer(painter, command);
+            },
+            [&](ExecuteDisplayList const& command) {
+                if (!command.starts_new_coordinate_space) {
+                    command.display_list->execute(painter, origin, base_clip_rect);
+                    return;
+                }
+                Gfx::PainterStateSaver saver(painter);
+                if (command.resets_translation)
+                    painter.translate(-painter.translation());
+                if (auto const& bounding_rect = command.display_list->bounding_rect(); bounding_rect.has_value() && !bounding_rect->translated(painter.translation()).intersects(painter.clip_rect()))
+                    return;
+                command.display_list->execute(painter, painter.translation(), painter.clip_rect());
+            });
+    }
+}
+
+}
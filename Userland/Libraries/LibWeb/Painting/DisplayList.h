@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/DeprecatedString.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+#include <LibGfx/AntiAliasingPainter.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/Font.h>
+#include <LibGfx/Gradients.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/Palette.h>
+#include <LibGfx/Path.h>
+#include <LibGfx/Rect.h>
+#include <LibGfx/StylePainter.h>
+#include <LibGfx/TextAlignment.h>
+#include <LibGfx/TextElision.h>
+#include <LibGfx/TextWrapping.h>
+#include <LibWeb/CSS/StyleValue.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::Painting {
+
+// The painter state a display list was recorded against. Clip rects are in the recorder's
+// absolute coordinate space, which is the target painter's space shifted by wherever the
+// translation was when the list (or the outermost list it was embedded in) started.
+struct RecordingState {
+    Gfx::IntPoint translation;
+    Gfx::IntRect clip_rect;
+    RefPtr<Gfx::Font const> font;
+
+    bool operator==(RecordingState const&) const = default;
+};
+
+namespace DisplayListCommands {
+
+struct Save {
+};
+
+struct Restore {
+};
+
+struct Translate {
+    Gfx::IntPoint delta;
+};
+
+struct AddClipRect {
+    Gfx::IntRect rect;
+};
+
+struct SetClipRect {
+    Gfx::IntRect rect;
+};
+
+struct ClearClipRect {
+};
+
+struct FillRect {
+    Gfx::IntRect rect;
+    Color color;
+};
+
+struct DrawRect {
+    Gfx::IntRect rect;
+    Color color;
+    bool rough { false };
+};
+
+struct DrawFocusRect {
+    Gfx::IntRect rect;
+    Color color;
+};
+
+struct DrawLine {
+    Gfx::IntPoint from;
+    Gfx::IntPoint to;
+    Color color;
+    int thickness { 1 };
+    Gfx::Painter::LineStyle style { Gfx::Painter::LineStyle::Solid };
+    Color alternate_color { Color::Transparent };
+};
+
+struct DrawTriangleWave {
+    Gfx::IntPoint from;
+    Gfx::IntPoint to;
+    Color color;
+    int amplitude { 0 };
+    int thickness { 1 };
+};
+
+struct DrawText {
+    Gfx::IntRect rect;
+    DeprecatedString text;
+    NonnullRefPtr<Gfx::Font const> font;
+    Gfx::TextAlignment alignment;
+    Color color;
+    Gfx::TextElision elision;
+    Gfx::TextWrapping wrapping;
+};
+
+struct DrawGlyphRun {
+    Gfx::IntPoint baseline_start;
+    DeprecatedString text;
+    NonnullRefPtr<Gfx::Font const> font;
+    Color color;
+};
+
+struct Blit {
+    Gfx::IntPoint position;
+    NonnullRefPtr<Gfx::Bitmap const> bitmap;
+    Gfx::IntRect src_rect;
+    float opacity { 1.0f };
+};
+
+// Paints `color`, using the alpha channel of `mask` as coverage.
+struct BlitMask {
+    Gfx::IntPoint position;
+    NonnullRefPtr<Gfx::Bitmap const> mask;
+    Gfx::IntRect src_rect;
+    Color color;
+};
+
+struct DrawScaledBitmap {
+    Gfx::IntRect dst_rect;
+    NonnullRefPtr<Gfx::Bitmap const> bitmap;
+    Gfx::IntRect src_rect;
+    float opacity { 1.0f };
+    Gfx::Painter::ScalingMode scaling_mode { Gfx::Painter::ScalingMode::NearestNeighbor };
+};
+
+struct FillRectWithLinearGradient {
+    Gfx::IntRect rect;
+    Vector<Gfx::ColorStop> color_stops;
+    float angle { 0 };
+    Optional<float> repeat_length;
+};
+
+struct FillRectWithConicGradient {
+    Gfx::IntRect rect;
+    Vector<Gfx::ColorStop> color_stops;
+    Gfx::IntPoint center;
+    float start_angle { 0 };
+    Optional<float> repeat_length;
+};
+
+struct FillRectWithRadialGradient {
+    Gfx::IntRect rect;
+    Vector<Gfx::ColorStop> color_stops;
+    Gfx::IntPoint center;
+    Gfx::IntSize size;
+    Optional<float> repeat_length;
+};
+
+struct FillRectWithRoundedCorners {
+    Gfx::IntRect rect;
+    Color color;
+    Gfx::AntiAliasingPainter::CornerRadius top_left;
+    Gfx::AntiAliasingPainter::CornerRadius top_right;
+    Gfx::AntiAliasingPainter::CornerRadius bottom_right;
+    Gfx::AntiAliasingPainter::CornerRadius bottom_left;
+    Gfx::AntiAliasingPainter::BlendMode blend_mode { Gfx::AntiAliasingPainter::BlendMode::Normal };
+};
+
+struct FillEllipse {
+    Gfx::IntRect rect;
+    Color color;
+};
+
+struct DrawEllipse {
+    Gfx::IntRect rect;
+    Color color;
+    int thickness { 1 };
+};
+
+struct DrawAntiAliasedLine {
+    Gfx::IntPoint from;
+    Gfx::IntPoint to;
+    Color color;
+    float thickness { 1 };
+    Gfx::Painter::LineStyle style { Gfx::Painter::LineStyle::Solid };
+};
+
+struct FillPath {
+    Gfx::Path path;
+    Color color;
+    Gfx::Painter::WindingRule winding_rule { Gfx::Painter::WindingRule::Nonzero };
+    Gfx::FloatPoint translation;
+};
+
+struct StrokePath {
+    Gfx::Path path;
+    Color color;
+    float thickness { 1 };
+    Gfx::FloatPoint translation;
+};
+
+struct PaintFrame {
+    Gfx::IntRect rect;
+    Palette palette;
+    Gfx::FrameShape shape;
+    Gfx::FrameShadow shadow;
+    int thickness { 1 };
+};
+
+struct PaintProgressbar {
+    Gfx::IntRect rect;
+    Palette palette;
+    int min { 0 };
+    int max { 0 };
+    int value { 0 };
+    DeprecatedString text;
+};
+
+struct PaintRadioButton {
+    Gfx::IntRect rect;
+    Palette palette;
+    bool is_checked { false };
+    bool is_being_pressed { false };
+};
+
+struct SampleUnderCorners {
+    NonnullRefPtr<BorderRadiusCornerClipper> corner_clipper;
+};
+
+struct BlitCornerClipping {
+    NonnullRefPtr<BorderRadiusCornerClipper> corner_clipper;
+};
+
+// https://drafts.fxtf.org/filter-effects-2/#backdrop-filter-operation
+// The filter lengths have already been resolved against the layout node, see resolve_filter_list().
+struct ApplyBackdropFilter {
+    Gfx::IntRect backdrop_region;
+    Vector<CSS::FilterFunction> filters;
+    RefPtr<BorderRadiusCornerClipper> corner_clipper;
+};
+
+// Paints `content` into a copy of the pixels under `destination_rect`, then composites the result back
+// with the given opacity. This is how opacity and non-translation transforms are applied to stacking contexts.
+struct PaintLayer {
+    Gfx::IntRect destination_rect;
+    Gfx::FloatSize source_size;
+    Gfx::FloatSize transformed_destination_size;
+    Gfx::FloatPoint content_origin;
+    float device_pixels_per_css_pixel { 1 };
+    float opacity { 1 };
+    NonnullRefPtr<DisplayList> content;
+};
+
+struct ExecuteDisplayList {
+    NonnullRefPtr<DisplayList> display_list;
+    bool starts_new_coordinate_space { false };
+    bool resets_translation { false };
+};
+
+}
+
+using DisplayListCommand = Variant<
+    DisplayListCommands::Save,
+    DisplayListCommands::Restore,
+    DisplayListCommands::Translate,
+    DisplayListCommands::AddClipRect,
+    DisplayListCommands::SetClipRect,
+    DisplayListCommands::ClearClipRect,
+    DisplayListCommands::FillRect,
+    DisplayListCommands::DrawRect,
+    DisplayListCommands::DrawFocusRect,
+    DisplayListCommands::DrawLine,
+    DisplayListCommands::DrawTriangleWave,
+    DisplayListCommands::DrawText,
+    DisplayListCommands::DrawGlyphRun,
+    DisplayListCommands::Blit,
+    DisplayListCommands::BlitMask,
+    DisplayListCommands::DrawScaledBitmap,
+    DisplayListCommands::FillRectWithLinearGradient,
+    DisplayListCommands::FillRectWithConicGradient,
+    DisplayListCommands::FillRectWithRadialGradient,
+    DisplayListCommands::FillRectWithRoundedCorners,
+    DisplayListCommands::FillEllipse,
+    DisplayListCommands::DrawEllipse,
+    DisplayListCommands::DrawAntiAliasedLine,
+    DisplayListCommands::FillPath,
+    DisplayListCommands::StrokePath,
+    DisplayListCommands::PaintFrame,
+    DisplayListCommands::PaintProgressbar,
+    DisplayListCommands::PaintRadioButton,
+    DisplayListCommands::SampleUnderCorners,
+    DisplayListCommands::BlitCornerClipping,
+    DisplayListCommands::ApplyBackdropFilter,
+    DisplayListCommands::PaintLayer,
+    DisplayListCommands::ExecuteDisplayList>;
+
+// A recorded sequence of painting commands, see RecordingPainter. Display lists are immutable once
+// recorded, so they can be replayed any number of times and shared between the lists they are embedded in.
+class DisplayList : public RefCounted<DisplayList> {
+public:
+    struct Item {
+        DisplayListCommand command;
+        // The area this command may touch, in the recorder's absolute coordinates.
+        // Commands without a bounding rect (state changes, etc.) are always executed.
+        Optional<Gfx::IntRect> bounding_rect;
+    };
+
+    static NonnullRefPtr<DisplayList> create(Vector<Item>, RecordingState const& initial_state, RecordingState const& final_state, bool depends_on_viewport);
+    ~DisplayList();
+
+    // Replays the list onto `painter`, starting from its current state.
+    void execute(Gfx::Painter&) const;
+
+    RecordingState const& initial_state() const { return m_initial_state; }
+    RecordingState const& final_state() const { return m_final_state; }
+    // The area touched by the commands of this list, in the recorder's absolute coordinates.
+    // Lists without a bounding rect can't be culled.
+    Optional<Gfx::IntRect> bounding_rect() const
+    {
+        if (m_has_unbounded_content)
+            return {};
+        return m_bounding_rect;
+    }
+    bool depends_on_viewport() const { return m_depends_on_viewport; }
+    bool is_empty() const { return m_items.is_empty(); }
+    size_t command_count() const;
+
+private:
+    DisplayList(Vector<Item>, RecordingState const& initial_state, RecordingState const& final_state, bool depends_on_viewport);
+
+    // `origin` is the target painter's translation at the point where the recorder's translation was zero,
+    // `base_clip_rect` is what ClearClipRect returns to.
+    void execute(Gfx::Painter&, Gfx::IntPoint origin, Gfx::IntRect const& base_clip_rect) const;
+
+    Vector<Item> m_items;
+    RecordingState m_initial_state;
+    RecordingState m_final_state;
+    Optional<Gfx::IntRect> m_bounding_rect;
+    bool m_has_unbounded_content { false };
+    bool m_depends_on_viewport { false };
+};
+
+}
@@ -16,10 +16,25 @@
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
 #include <LibWeb/Painting/FilterPainting.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 
 namespace Web::Painting {
 
-void apply_filter_list(Gfx::Bitmap& target_bitmap, Layout::Node const& node, ReadonlySpan<CSS::FilterFunction> filter_list)
+Vector<CSS::FilterFunction> resolve_filter_list(Layout::Node const& node, ReadonlySpan<CSS::FilterFunction> filter_list)
+{
+    Vector<CSS::FilterFunction> resolved_filter_list;
+    resolved_filter_list.ensure_capacity(filter_list.size());
+    for (auto& filter_function : filter_list) {
+        if (auto const* blur = filter_function.get_pointer<CSS::Filter::Blur>(); blur && blur->radius.has_value()) {
+            resolved_filter_list.unchecked_append(CSS::Filter::Blur { CSS::Length::make_px(blur->radius->resolved(node).to_px(node)) });
+            continue;
+        }
+        resolved_filter_list.unchecked_append(filter_function);
+    }
+    return resolved_filter_list;
+}
+
+void apply_filter_list(Gfx::Bitmap& target_bitmap, ReadonlySpan<CSS::FilterFunction> filter_list)
 {
     auto apply_color_filter = [&](Gfx::ColorFilter const& filter) {
         const_cast<Gfx::ColorFilter&>(filter).apply(target_bitmap, target_bitmap.rect(), target_bitmap, target_bitmap.rect());
@@ -30,8 +45,11 @@ void apply_filter_list(Gfx::Bitmap& target_bitmap, Layout::Node const& node, Rea
             [&](CSS::Filter::Blur const& blur) {
                 // Applies a Gaussian blur to the input image.
                 // The passed parameter defines the value of the standard deviation to the Gaussian function.
+                // NOTE: The radius has already been made absolute by resolve_filter_list().
+                int sigma = blur.radius.has_value() ? blur.radius->absolute_length_to_px().value() : 0;
+                // Note: The radius/sigma of the blur needs to be doubled for LibGfx's blur functions.
                 Gfx::StackBlurFilter filter { target_bitmap };
-                filter.process_rgba(blur.resolved_radius(node), Color::Transparent);
+                filter.process_rgba(sigma * 2, Color::Transparent);
             },
             [&](CSS::Filter::Color const& color) {
                 auto amount = color.resolved_amount();
@@ -104,36 +122,14 @@ void apply_backdrop_filter(PaintContext& context, Layout::Node const& node, CSSP
 
     auto backdrop_region = context.rounded_device_rect(backdrop_rect);
 
-    // Note: The region bitmap can be smaller than the backdrop_region if it's at the edge of canvas.
-    // Note: This is in DevicePixels, but we use an IntRect because `get_region_bitmap()` below writes to it.
-    Gfx::IntRect actual_region {};
-
-    // FIXME: Go through the steps to find the "Backdrop Root Image"
-    // https://drafts.fxtf.org/filter-effects-2/#BackdropRoot
-
-    // 1. Copy the Backdrop Root Image into a temporary buffer, such as a raster image. Call this buffer T’.
-    auto maybe_backdrop_bitmap = context.painter().get_region_bitmap(backdrop_region.to_type<int>(), Gfx::BitmapFormat::BGRA8888, actual_region);
-    if (actual_region.is_empty())
-        return;
-    if (maybe_backdrop_bitmap.is_error()) {
-        dbgln("Failed get region bitmap for backdrop-filter");
-        return;
+    // NOTE: This needs the pixels painted so far, so the actual operation happens when the display list is executed.
+    RefPtr<BorderRadiusCornerClipper> corner_clipper;
+    if (border_radii_data.has_any_radius()) {
+        auto clipper = BorderRadiusCornerClipper::create(context, backdrop_region, border_radii_data);
+        if (!clipper.is_error())
+            corner_clipper = clipper.release_value();
     }
-    auto backdrop_bitmap = maybe_backdrop_bitmap.release_value();
-    // 2. Apply the backdrop-filter’s filter operations to the entire contents of T'.
-    apply_filter_list(*backdrop_bitmap, node, backdrop_filter.filters());
-
-    // FIXME: 3. If element B has any transforms (between B and the Backdrop Root), apply the inverse of those transforms to the contents of T’.
-
-    // 4. Apply a clip to the contents of T’, using the border box of element B, including border-radius if specified. Note that the children of B are not considered for the sizing or location of this clip.
-    ScopedCornerRadiusClip corner_clipper { context, context.painter(), backdrop_region, border_radii_data };
-
-    // FIXME: 5. Draw all of element B, including its background, border, and any children elements, into T’.
-
-    // FXIME: 6. If element B has any transforms, effects, or clips, apply those to T’.
-
-    // 7. Composite the contents of T’ into element B’s parent, using source-over compositing.
-    context.painter().blit(actual_region.location(), *backdrop_bitmap, backdrop_bitmap->rect());
+    context.painter().apply_backdrop_filter(backdrop_region.to_type<int>(), resolve_filter_list(node, backdrop_filter.filters()), move(corner_clipper));
 }
 
 }
@@ -12,7 +12,10 @@
 
 namespace Web::Painting {
 
-void apply_filter_list(Gfx::Bitmap& target_bitmap, Layout::Node const& node, ReadonlySpan<CSS::FilterFunction> filter_list);
+// Resolves the relative lengths in `filter_list` against `node`, so the result can be applied without it.
+Vector<CSS::FilterFunction> resolve_filter_list(Layout::Node const& node, ReadonlySpan<CSS::FilterFunction> filter_list);
+
+void apply_filter_list(Gfx::Bitmap& target_bitmap, ReadonlySpan<CSS::FilterFunction> filter_list);
 
 void apply_backdrop_filter(PaintContext&, Layout::Node const&, CSSPixelRect const&, BorderRadiiData const&, CSS::BackdropFilter const&);
 
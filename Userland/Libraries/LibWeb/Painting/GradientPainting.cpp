@@ -8,6 +8,7 @@
 #include <LibGfx/Gradients.h>
 #include <LibWeb/CSS/StyleValue.h>
 #include <LibWeb/Painting/GradientPainting.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 
 namespace Web::Painting {
 
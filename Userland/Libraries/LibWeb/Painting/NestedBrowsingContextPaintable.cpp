@@ -10,6 +10,7 @@
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
 #include <LibWeb/Painting/NestedBrowsingContextPaintable.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 
 namespace Web::Painting {
 
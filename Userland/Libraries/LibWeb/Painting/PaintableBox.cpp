@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/GenericShorthands.h>
 #include <LibUnicode/CharacterTypes.h>
 #include <LibWeb/DOM/Document.h>
@@ -15,6 +16,7 @@
 #include <LibWeb/Painting/BackgroundPainting.h>
 #include <LibWeb/Painting/FilterPainting.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/Painting/StackingContext.h>
 #include <LibWeb/Platform/FontPlugin.h>
 
@@ -260,6 +262,22 @@ void PaintableBox::paint_background(PaintContext& context) const
             background_layers = document().background_layers();
             background_color = document().background_color(context.palette());
         }
+
+        // NOTE: Background images are positioned against the viewport here, so they have to be re-recorded when scrolling.
+        //       A plain color can cover everything that could be scrolled into view instead, which keeps the display list reusable.
+        bool has_paintable_layers = background_layers && any_of(*background_layers, [](auto& layer) {
+            return layer.background_image && layer.background_image->is_paintable();
+        });
+        if (has_paintable_layers) {
+            context.painter().set_depends_on_viewport();
+        } else {
+            auto canvas_size = background_rect.size();
+            if (auto overflow_rect = document().layout_node()->paint_box()->scrollable_overflow_rect(); overflow_rect.has_value()) {
+                canvas_size.set_width(max(canvas_size.width(), overflow_rect->width()));
+                canvas_size.set_height(max(canvas_size.height(), overflow_rect->height()));
+            }
+            background_rect = { {}, canvas_size };
+        }
     } else {
         background_rect = absolute_padding_box_rect();
     }
@@ -360,7 +378,7 @@ void PaintableBox::apply_clip_overflow_rect(PaintContext& context, PaintPhase ph
             }
             clip_overflow();
             m_overflow_corner_radius_clipper = corner_clipper.release_value();
-            m_overflow_corner_radius_clipper->sample_under_corners(context.painter());
+            context.painter().sample_under_corners(*m_overflow_corner_radius_clipper);
         }
     }
 }
@@ -375,9 +393,9 @@ void PaintableBox::clear_clip_overflow_rect(PaintContext& context, PaintPhase ph
         context.painter().restore();
         m_clipping_overflow = false;
     }
-    if (m_overflow_corner_radius_clipper.has_value()) {
-        m_overflow_corner_radius_clipper->blit_corner_clipping(context.painter());
-        m_overflow_corner_radius_clipper = {};
+    if (m_overflow_corner_radius_clipper) {
+        context.painter().blit_corner_clipping(*m_overflow_corner_radius_clipper);
+        m_overflow_corner_radius_clipper = nullptr;
     }
 }
 
@@ -415,7 +433,7 @@ static void paint_cursor_if_needed(PaintContext& context, Layout::TextNode const
     context.painter().draw_rect(cursor_device_rect, text_node.computed_values().color());
 }
 
-static void paint_text_decoration(PaintContext& context, Gfx::Painter& painter, Layout::Node const& text_node, Layout::LineBoxFragment const& fragment)
+static void paint_text_decoration(PaintContext& context, RecordingPainter& painter, Layout::Node const& text_node, Layout::LineBoxFragment const& fragment)
 {
     auto& font = fragment.layout_node().font();
     auto fragment_box = fragment.absolute_rect();
@@ -533,9 +551,10 @@ static void paint_text_fragment(PaintContext& context, Layout::TextNode const& t
         auto selection_rect = context.enclosing_device_rect(fragment.selection_rect(text_node.font())).to_type<int>();
         if (!selection_rect.is_empty()) {
             painter.fill_rect(selection_rect, context.palette().selection());
-            Gfx::PainterStateSaver saver(painter);
+            painter.save();
             painter.add_clip_rect(selection_rect);
             painter.draw_text_run(baseline_start.to_type<int>(), view, scaled_font ? *scaled_font : font, context.palette().selection_text());
+            painter.restore();
         }
 
         paint_text_decoration(context, painter, text_node, fragment);
@@ -554,7 +573,7 @@ void PaintableWithLines::paint(PaintContext& context, PaintPhase phase) const
         return;
 
     bool should_clip_overflow = computed_values().overflow_x() != CSS::Overflow::Visible && computed_values().overflow_y() != CSS::Overflow::Visible;
-    Optional<BorderRadiusCornerClipper> corner_clipper;
+    RefPtr<BorderRadiusCornerClipper> corner_clipper;
 
     if (should_clip_overflow) {
         context.painter().save();
@@ -569,7 +588,7 @@ void PaintableWithLines::paint(PaintContext& context, PaintPhase phase) const
             auto clipper = BorderRadiusCornerClipper::create(context, clip_box, border_radii);
             if (!clipper.is_error()) {
                 corner_clipper = clipper.release_value();
-                corner_clipper->sample_under_corners(context.painter());
+                context.painter().sample_under_corners(*corner_clipper);
             }
         }
     }
@@ -619,8 +638,8 @@ void PaintableWithLines::paint(PaintContext& context, PaintPhase phase) const
 
     if (should_clip_overflow) {
         context.painter().restore();
-        if (corner_clipper.has_value())
-            corner_clipper->blit_corner_clipping(context.painter());
+        if (corner_clipper)
+            context.painter().blit_corner_clipping(*corner_clipper);
     }
 
     // FIXME: Merge this loop with the above somehow..
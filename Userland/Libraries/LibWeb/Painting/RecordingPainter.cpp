@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Utf8View.h>
+#include <LibGfx/Font/FontDatabase.h>
+#include <LibWeb/Painting/BorderRadiusCornerClipper.h>
+#include <LibWeb/Painting/RecordingPainter.h>
+
+namespace Web::Painting {
+
+// Large enough to contain any page, small enough to be translated around without overflowing.
+static Gfx::IntRect const unbounded_clip_rect { -(1 << 28), -(1 << 28), 1 << 29, 1 << 29 };
+
+RecordingState RecordingPainter::default_state()
+{
+    return RecordingState {
+        .translation = {},
+        .clip_rect = unbounded_clip_rect,
+        .font = nullptr,
+    };
+}
+
+RecordingPainter::RecordingPainter(RecordingState const& initial_state)
+    : m_initial_state(initial_state)
+{
+    m_state_stack.append(initial_state);
+}
+
+RecordingPainter::~RecordingPainter() = default;
+
+void RecordingPainter::push(DisplayListCommand command, Optional<Gfx::IntRect> local_bounding_rect)
+{
+    Optional<Gfx::IntRect> bounding_rect;
+    if (local_bounding_rect.has_value()) {
+        bounding_rect = local_bounding_rect->translated(translation());
+        // NOTE: Our clip rect is never smaller than the one the target painter will have at this point,
+        //       so anything outside of it can't show up on screen.
+        if (!bounding_rect->intersects(clip_rect()))
+            return;
+    }
+    m_items.append({ move(command), bounding_rect });
+}
+
+void RecordingPainter::save()
+{
+    m_state_stack.append(state());
+    push(DisplayListCommands::Save {});
+}
+
+void RecordingPainter::restore()
+{
+    VERIFY(m_state_stack.size() > 1);
+    m_state_stack.take_last();
+    push(DisplayListCommands::Restore {});
+}
+
+void RecordingPainter::translate(Gfx::IntPoint delta)
+{
+    mutable_state().translation.translate_by(delta);
+    push(DisplayListCommands::Translate { delta });
+}
+
+void RecordingPainter::add_clip_rect(Gfx::IntRect const& rect)
+{
+    mutable_state().clip_rect.intersect(rect.translated(translation()));
+    push(DisplayListCommands::AddClipRect { rect });
+}
+
+void RecordingPainter::set_clip_rect(Gfx::IntRect const& rect)
+{
+    mutable_state().clip_rect = rect;
+    push(DisplayListCommands::SetClipRect { rect });
+}
+
+void RecordingPainter::clear_clip_rect()
+{
+    mutable_state().clip_rect = unbounded_clip_rect;
+    push(DisplayListCommands::ClearClipRect {});
+}
+
+void RecordingPainter::set_font(Gfx::Font const& font)
+{
+    // NOTE: Text commands always carry their font, so this only needs to be tracked here.
+    mutable_state().font = font;
+}
+
+Gfx::Font const& RecordingPainter::font() const
+{
+    if (!state().font)
+        return Gfx::FontDatabase::default_font();
+    return *state().font;
+}
+
+static Gfx::IntRect line_bounding_rect(Gfx::IntPoint from, Gfx::IntPoint to, int inflation)
+{
+    return Gfx::IntRect::from_two_points(from, to).inflated(inflation * 2 + 2, inflation * 2 + 2);
+}
+
+void RecordingPainter::fill_rect(Gfx::IntRect const& rect, Color color)
+{
+    push(DisplayListCommands::FillRect { rect, color }, rect);
+}
+
+void RecordingPainter::draw_rect(Gfx::IntRect const& rect, Color color, bool rough)
+{
+    push(DisplayListCommands::DrawRect { rect, color, rough }, rect);
+}
+
+void RecordingPainter::draw_focus_rect(Gfx::IntRect const& rect, Color color)
+{
+    push(DisplayListCommands::DrawFocusRect { rect, color }, rect.inflated(2, 2));
+}
+
+void RecordingPainter::draw_line(Gfx::IntPoint from, Gfx::IntPoint to, Color color, int thickness, Gfx::Painter::LineStyle style, Color alternate_color)
+{
+    push(DisplayListCommands::DrawLine { from, to, color, thickness, style, alternate_color }, line_bounding_rect(from, to, thickness));
+}
+
+void RecordingPainter::draw_triangle_wave(Gfx::IntPoint from, Gfx::IntPoint to, Color color, int amplitude, int thickness)
+{
+    push(DisplayListCommands::DrawTriangleWave { from, to, color, amplitude, thickness }, line_bounding_rect(from, to, amplitude + thickness));
+}
+
+void RecordingPainter::draw_text(Gfx::IntRect const& rect, StringView text, Gfx::TextAlignment alignment, Color color, Gfx::TextElision elision, Gfx::TextWrapping wrapping)
+{
+    draw_text(rect, text, font(), alignment, color, elision, wrapping);
+}
+
+void RecordingPainter::draw_text(Gfx::IntRect const& rect, StringView text, Gfx::Font const& font, Gfx::TextAlignment alignment, Color color, Gfx::TextElision elision, Gfx::TextWrapping wrapping)
+{
+    // NOTE: Unelided text is allowed to overflow its rect, so this is never culled.
+    push(DisplayListCommands::DrawText {
+        .rect = rect,
+        .text = text,
+        .font = font,
+        .alignment = alignment,
+        .color = color,
+        .elision = elision,
+        .wrapping = wrapping,
+    });
+}
+
+void RecordingPainter::draw_text_run(Gfx::IntPoint baseline_start, Utf8View const& text, Gfx::Font const& font, Color color)
+{
+    auto metrics = font.pixel_metrics();
+    auto slack = font.glyph_height();
+    Gfx::IntRect bounding_rect {
+        baseline_start.x() - slack,
+        baseline_start.y() - static_cast<int>(ceilf(metrics.ascent)) - slack,
+        static_cast<int>(ceilf(font.width(text))) + slack * 2,
+        static_cast<int>(ceilf(metrics.ascent + metrics.descent)) + slack * 2,
+    };
+    push(DisplayListCommands::DrawGlyphRun {
+             .baseline_start = baseline_start,
+             .text = text.as_string(),
+             .font = font,
+             .color = color,
+         },
+        bounding_rect);
+}
+
+void RecordingPainter::blit(Gfx::IntPoint position, Gfx::Bitmap const& bitmap, Gfx::IntRect const& src_rect, float opacity)
+{
+    push(DisplayListCommands::Blit { position, bitmap, src_rect, opacity }, Gfx::IntRect { position, src_rect.size() });
+}
+
+void RecordingPainter::blit_mask(Gfx::IntPoint position, Gfx::Bitmap const& mask, Gfx::IntRect const& src_rect, Color color)
+{
+    push(DisplayListCommands::BlitMask { position, mask, src_rect, color }, Gfx::IntRect { position, src_rect.size() });
+}
+
+void RecordingPainter::draw_scaled_bitmap(Gfx::IntRect const& dst_rect, Gfx::Bitmap const& bitmap, Gfx::IntRect const& src_rect, float opacity, Gfx::Painter::ScalingMode scaling_mode)
+{
+    push(DisplayListCommands::DrawScaledBitmap { dst_rect, bitmap, src_rect, opacity, scaling_mode }, dst_rect);
+}
+
+void RecordingPainter::fill_rect_with_linear_gradient(Gfx::IntRect const& rect, ReadonlySpan<Gfx::ColorStop> color_stops, float angle, Optional<float> repeat_length)
+{
+    Vector<Gfx::ColorStop> stops;
+    stops.append(color_stops.data(), color_stops.size());
+    push(DisplayListCommands::FillRectWithLinearGradient { rect, move(stops), angle, repeat_length }, rect);
+}
+
+void RecordingPainter::fill_rect_with_conic_gradient(Gfx::IntRect const& rect, ReadonlySpan<Gfx::ColorStop> color_stops, Gfx::IntPoint center, float start_angle, Optional<float> repeat_length)
+{
+    Vector<Gfx::ColorStop> stops;
+    stops.append(color_stops.data(), color_stops.size());
+    push(DisplayListCommands::FillRectWithConicGradient { rect, move(stops), center, start_angle, repeat_length }, rect);
+}
+
+void RecordingPainter::fill_rect_with_radial_gradient(Gfx::IntRect const& rect, ReadonlySpan<Gfx::ColorStop> color_stops, Gfx::IntPoint center, Gfx::IntSize size, Optional<float> repeat_length)
+{
+    Vector<Gfx::ColorStop> stops;
+    stops.append(color_stops.data(), color_stops.size());
+    push(DisplayListCommands::FillRectWithRadialGradient { rect, move(stops), center, size, repeat_length }, rect);
+}
+
+void RecordingPainter::fill_rect_with_rounded_corners(Gfx::IntRect const& rect, Color color, CornerRadius top_left, CornerRadius top_right, CornerRadius bottom_right, CornerRadius bottom_left, Gfx::AntiAliasingPainter::BlendMode blend_mode)
+{
+    push(DisplayListCommands::FillRectWithRoundedCorners { rect, color, top_left, top_right, bottom_right, bottom_left, blend_mode }, rect);
+}
+
+void RecordingPainter::fill_ellipse(Gfx::IntRect const& rect, Color color)
+{
+    push(DisplayListCommands::FillEllipse { rect, color }, rect);
+}
+
+void RecordingPainter::draw_ellipse(Gfx::IntRect const& rect, Color color, int thickness)
+{
+    push(DisplayListCommands::DrawEllipse { rect, color, thickness }, rect.inflated(thickness * 2, thickness * 2));
+}
+
+void RecordingPainter::draw_anti_aliased_line(Gfx::IntPoint from, Gfx::IntPoint to, Color color, float thickness, Gfx::Painter::LineStyle style)
+{
+    push(DisplayListCommands::DrawAntiAliasedLine { from, to, color, thickness, style }, line_bounding_rect(from, to, static_cast<int>(ceilf(thickness))));
+}
+
+static Gfx::IntRect path_bounding_rect(Gfx::Path const& path, Gfx::FloatPoint translation, float thickness)
+{
+    return Gfx::enclosing_int_rect(path.bounding_box().translated(translation).inflated(thickness * 2 + 2, thickness * 2 + 2));
+}
+
+void RecordingPainter::fill_path(Gfx::Path const& path, Color color, Gfx::Painter::WindingRule winding_rule, Gfx::FloatPoint translation)
+{
+    push(DisplayListCommands::FillPath { path, color, winding_rule, translation }, path_bounding_rect(path, translation, 0));
+}
+
+void RecordingPainter::stroke_path(Gfx::Path const& path, Color color, float thickness, Gfx::FloatPoint translation)
+{
+    push(DisplayListCommands::StrokePath { path, color, thickness, translation }, path_bounding_rect(path, translation, thickness));
+}
+
+void RecordingPainter::paint_frame(Gfx::IntRect const& rect, Palette const& palette, Gfx::FrameShape shape, Gfx::FrameShadow shadow, int thickness)
+{
+    push(DisplayListCommands::PaintFrame { rect, palette, shape, shadow, thickness }, rect);
+}
+
+void RecordingPainter::paint_progressbar(Gfx::IntRect const& rect, Palette const& palette, int min, int max, int value, StringView text)
+{
+    push(DisplayListCommands::PaintProgressbar { rect, palette, min, max, value, text }, rect);
+}
+
+void RecordingPainter::paint_radio_button(Gfx::IntRect const& rect, Palette const& palette, bool is_checked, bool is_being_pressed)
+{
+    push(DisplayListCommands::PaintRadioButton { rect, palette, is_checked, is_being_pressed }, rect);
+}
+
+void RecordingPainter::sample_under_corners(BorderRadiusCornerClipper& corner_clipper)
+{
+    push(DisplayListCommands::SampleUnderCorners { corner_clipper });
+}
+
+void RecordingPainter::blit_corner_clipping(BorderRadiusCornerClipper& corner_clipper)
+{
+    push(DisplayListCommands::BlitCornerClipping { corner_clipper });
+}
+
+void RecordingPainter::apply_backdrop_filter(Gfx::IntRect const& backdrop_region, Vector<CSS::FilterFunction> filters, RefPtr<BorderRadiusCornerClipper> corner_clipper)
+{
+    push(DisplayListCommands::ApplyBackdropFilter { backdrop_region, move(filters), move(corner_clipper) }, backdrop_region);
+}
+
+void RecordingPainter::paint_layer(DisplayListCommands::PaintLayer layer)
+{
+    if (layer.content->depends_on_viewport())
+        m_depends_on_viewport = true;
+    auto destination_rect = layer.destination_rect;
+    push(move(layer), destination_rect);
+}
+
+void RecordingPainter::append(DisplayList& display_list, CoordinateSpace coordinate_space)
+{
+    if (display_list.depends_on_viewport())
+        m_depends_on_viewport = true;
+
+    if (coordinate_space == CoordinateSpace::Shared) {
+        VERIFY(display_list.initial_state() == state());
+        // NOTE: The list's bounding rect is already in our coordinates.
+        auto bounding_rect = display_list.bounding_rect();
+        if (!bounding_rect.has_value() || bounding_rect->intersects(clip_rect()))
+            m_items.append({ DisplayListCommands::ExecuteDisplayList { display_list, false, false }, bounding_rect });
+        mutable_state() = display_list.final_state();
+        return;
+    }
+
+    push(DisplayListCommands::ExecuteDisplayList { display_list, true, coordinate_space == CoordinateSpace::NewViewportRelative });
+}
+
+NonnullRefPtr<DisplayList> RecordingPainter::take_display_list()
+{
+    return DisplayList::create(move(m_items), m_initial_state, state(), m_depends_on_viewport);
+}
+
+}
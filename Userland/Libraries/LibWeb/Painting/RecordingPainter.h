@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Forward.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
+#include <LibGfx/AntiAliasingPainter.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/StylePainter.h>
+#include <LibWeb/Painting/DisplayList.h>
+
+namespace Web::Painting {
+
+// A drop-in for Gfx::Painter that records what gets painted into a DisplayList instead of touching any pixels.
+// It mirrors the state a real painter would have (translation, clip rect and font), so that painting code can
+// keep querying it, with one difference: a fresh recorder has no clip at all. Whatever ends up outside of the
+// target's clip rect is culled when the list is executed instead, which keeps recorded lists independent of
+// the part of the page that happens to be visible.
+class RecordingPainter {
+    AK_MAKE_NONCOPYABLE(RecordingPainter);
+    AK_MAKE_NONMOVABLE(RecordingPainter);
+
+public:
+    explicit RecordingPainter(RecordingState const& initial_state = default_state());
+    ~RecordingPainter();
+
+    static RecordingState default_state();
+
+    RecordingState const& state() const { return m_state_stack.last(); }
+
+    void save();
+    void restore();
+
+    void translate(int dx, int dy) { translate({ dx, dy }); }
+    void translate(Gfx::IntPoint delta);
+    Gfx::IntPoint translation() const { return state().translation; }
+
+    void add_clip_rect(Gfx::IntRect const&);
+    void set_clip_rect(Gfx::IntRect const&);
+    void clear_clip_rect();
+    Gfx::IntRect clip_rect() const { return state().clip_rect; }
+
+    void set_font(Gfx::Font const&);
+    Gfx::Font const& font() const;
+
+    void fill_rect(Gfx::IntRect const&, Color);
+    void draw_rect(Gfx::IntRect const&, Color, bool rough = false);
+    void draw_focus_rect(Gfx::IntRect const&, Color);
+    void draw_line(Gfx::IntPoint, Gfx::IntPoint, Color, int thickness = 1, Gfx::Painter::LineStyle style = Gfx::Painter::LineStyle::Solid, Color alternate_color = Color::Transparent);
+    void draw_triangle_wave(Gfx::IntPoint, Gfx::IntPoint, Color, int amplitude, int thickness = 1);
+
+    void draw_text(Gfx::IntRect const&, StringView, Gfx::TextAlignment = Gfx::TextAlignment::TopLeft, Color = Color::Black, Gfx::TextElision = Gfx::TextElision::None, Gfx::TextWrapping = Gfx::TextWrapping::DontWrap);
+    void draw_text(Gfx::IntRect const&, StringView, Gfx::Font const&, Gfx::TextAlignment = Gfx::TextAlignment::TopLeft, Color = Color::Black, Gfx::TextElision = Gfx::TextElision::None, Gfx::TextWrapping = Gfx::TextWrapping::DontWrap);
+    void draw_text_run(Gfx::IntPoint baseline_start, Utf8View const&, Gfx::Font const&, Color);
+
+    void blit(Gfx::IntPoint, Gfx::Bitmap const&, Gfx::IntRect const& src_rect, float opacity = 1.0f);
+    void blit_mask(Gfx::IntPoint, Gfx::Bitmap const& mask, Gfx::IntRect const& src_rect, Color);
+    void draw_scaled_bitmap(Gfx::IntRect const& dst_rect, Gfx::Bitmap const&, Gfx::IntRect const& src_rect, float opacity = 1.0f, Gfx::Painter::ScalingMode = Gfx::Painter::ScalingMode::NearestNeighbor);
+
+    void fill_rect_with_linear_gradient(Gfx::IntRect const&, ReadonlySpan<Gfx::ColorStop>, float angle, Optional<float> repeat_length = {});
+    void fill_rect_with_conic_gradient(Gfx::IntRect const&, ReadonlySpan<Gfx::ColorStop>, Gfx::IntPoint center, float start_angle, Optional<float> repeat_length = {});
+    void fill_rect_with_radial_gradient(Gfx::IntRect const&, ReadonlySpan<Gfx::ColorStop>, Gfx::IntPoint center, Gfx::IntSize size, Optional<float> repeat_length = {});
+
+    // Anti-aliased operations, see Gfx::AntiAliasingPainter.
+    using CornerRadius = Gfx::AntiAliasingPainter::CornerRadius;
+    void fill_rect_with_rounded_corners(Gfx::IntRect const&, Color, CornerRadius top_left, CornerRadius top_right, CornerRadius bottom_right, CornerRadius bottom_left, Gfx::AntiAliasingPainter::BlendMode = Gfx::AntiAliasingPainter::BlendMode::Normal);
+    void fill_ellipse(Gfx::IntRect const&, Color);
+    void draw_ellipse(Gfx::IntRect const&, Color, int thickness);
+    void draw_anti_aliased_line(Gfx::IntPoint, Gfx::IntPoint, Color, float thickness = 1, Gfx::Painter::LineStyle = Gfx::Painter::LineStyle::Solid);
+    void fill_path(Gfx::Path const&, Color, Gfx::Painter::WindingRule, Gfx::FloatPoint translation = {});
+    void stroke_path(Gfx::Path const&, Color, float thickness, Gfx::FloatPoint translation = {});
+
+    // See Gfx::StylePainter.
+    void paint_frame(Gfx::IntRect const&, Palette const&, Gfx::FrameShape, Gfx::FrameShadow, int thickness);
+    void paint_progressbar(Gfx::IntRect const&, Palette const&, int min, int max, int value, StringView text);
+    void paint_radio_button(Gfx::IntRect const&, Palette const&, bool is_checked, bool is_being_pressed);
+
+    // Effects that have to read back the pixels painted so far.
+    void sample_under_corners(BorderRadiusCornerClipper&);
+    void blit_corner_clipping(BorderRadiusCornerClipper&);
+    void apply_backdrop_filter(Gfx::IntRect const& backdrop_region, Vector<CSS::FilterFunction> filters, RefPtr<BorderRadiusCornerClipper> corner_clipper);
+    void paint_layer(DisplayListCommands::PaintLayer);
+
+    enum class CoordinateSpace {
+        // The list was recorded starting from this recorder's current state.
+        Shared,
+        // The list was recorded by a default-constructed recorder, relative to our current translation.
+        New,
+        // Like New, but relative to the target painter's origin (i.e. the viewport) instead.
+        NewViewportRelative,
+    };
+    void append(DisplayList&, CoordinateSpace);
+
+    // Call this when the painted output depends on the position of the viewport in a way that isn't
+    // reflected in the recorder state, so that lists recorded from here aren't reused after scrolling.
+    void set_depends_on_viewport() { m_depends_on_viewport = true; }
+
+    NonnullRefPtr<DisplayList> take_display_list();
+
+private:
+    RecordingState& mutable_state() { return m_state_stack.last(); }
+    void push(DisplayListCommand, Optional<Gfx::IntRect> local_bounding_rect = {});
+
+    RecordingState m_initial_state;
+    Vector<RecordingState, 4> m_state_stack;
+    Vector<DisplayList::Item> m_items;
+    bool m_depends_on_viewport { false };
+};
+
+}
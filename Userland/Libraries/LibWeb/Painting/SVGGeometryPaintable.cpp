@@ -4,8 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <LibGfx/AntiAliasingPainter.h>
 #include <LibWeb/Layout/ImageBox.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/Painting/SVGGeometryPaintable.h>
 #include <LibWeb/SVG/SVGSVGElement.h>
 
@@ -38,11 +38,10 @@ void SVGGeometryPaintable::paint(PaintContext& context, PaintPhase phase) const
 
     auto& geometry_element = layout_box().dom_node();
 
-    Gfx::AntiAliasingPainter painter { context.painter() };
+    auto& painter = context.painter();
     auto& svg_context = context.svg_context();
 
     auto offset = svg_context.svg_element_position();
-    painter.translate(offset);
 
     auto const* svg_element = geometry_element.first_ancestor_of_type<SVG::SVGSVGElement>();
     auto maybe_view_box = svg_element->view_box();
@@ -105,17 +104,18 @@ void SVGGeometryPaintable::paint(PaintContext& context, PaintPhase phase) const
         painter.fill_path(
             closed_path,
             fill_color,
-            Gfx::Painter::WindingRule::EvenOdd);
+            Gfx::Painter::WindingRule::EvenOdd,
+            offset);
     }
 
     if (auto stroke_color = geometry_element.stroke_color().value_or(svg_context.stroke_color()); stroke_color.alpha() > 0) {
         painter.stroke_path(
             path,
             stroke_color,
-            geometry_element.stroke_width().value_or(svg_context.stroke_width()));
+            geometry_element.stroke_width().value_or(svg_context.stroke_width()),
+            offset);
     }
 
-    painter.translate(-offset);
     context.painter().clear_clip_rect();
 }
 
@@ -7,6 +7,7 @@
  */
 
 #include <AK/NumericLimits.h>
+#include <AK/ScopeGuard.h>
 #include <LibGfx/DisjointRectSet.h>
 #include <LibGfx/Filters/StackBlurFilter.h>
 #include <LibGfx/Painter.h>
@@ -14,6 +15,7 @@
 #include <LibWeb/Painting/BorderPainting.h>
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
 #include <LibWeb/Painting/PaintContext.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/Painting/ShadowPainting.h>
 
 namespace Web::Painting {
@@ -240,7 +242,8 @@ void paint_box_shadow(PaintContext& context, CSSPixelRect const& content_rect, B
         auto bottom_right_corner_blit_pos = inner_bounding_rect.bottom_right().translated(-bottom_right_corner_size.width() + 1 + double_radius, -bottom_right_corner_size.height() + 1 + double_radius);
 
         auto paint_shadow = [&](DevicePixelRect clip_rect) {
-            Gfx::PainterStateSaver save { painter };
+            painter.save();
+            ScopeGuard restore_painter = [&] { painter.restore(); };
             painter.add_clip_rect(clip_rect.to_type<int>());
 
             paint_shadow_infill();
@@ -17,6 +17,7 @@
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Layout/ReplacedBox.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/Painting/StackingContext.h>
 
 namespace Web::Painting {
@@ -362,15 +363,62 @@ Gfx::AffineTransform StackingContext::affine_transform_matrix() const
 
 void StackingContext::paint(PaintContext& context) const
 {
-    Gfx::PainterStateSaver saver(context.painter());
-    if (m_box.is_fixed_position()) {
-        context.painter().translate(-context.painter().translation());
-    }
-
     auto opacity = m_box.computed_values().opacity();
     if (opacity == 0.0f)
         return;
 
+    auto& recorder = context.painter();
+
+    // The root stacking context and fixed position ones don't care where they are painted, so they get their own
+    // coordinate space. This way, scrolling around doesn't invalidate the lists recorded for them.
+    auto coordinate_space = RecordingPainter::CoordinateSpace::Shared;
+    if (!m_parent)
+        coordinate_space = RecordingPainter::CoordinateSpace::New;
+    else if (m_box.is_fixed_position())
+        coordinate_space = RecordingPainter::CoordinateSpace::NewViewportRelative;
+    auto initial_state = coordinate_space == RecordingPainter::CoordinateSpace::Shared ? recorder.state() : RecordingPainter::default_state();
+
+    DisplayListCacheKey key {
+        .initial_state = initial_state,
+        .device_pixels_per_css_pixel = context.device_pixels_per_css_pixel(),
+        .palette = &context.palette().impl(),
+        .has_focus = context.has_focus(),
+        .should_show_line_box_borders = context.should_show_line_box_borders(),
+        .device_viewport_rect = {},
+    };
+    if (m_cached_display_list && m_cached_display_list->depends_on_viewport())
+        key.device_viewport_rect = context.device_viewport_rect();
+
+    // FIXME: The SVG context isn't part of the key, so don't bother caching anything painted inside of an <svg>.
+    if (!m_cached_display_list || m_cached_display_list_key != key || context.has_svg_context()) {
+        RecordingPainter display_list_recorder { initial_state };
+        auto display_list_context = context.clone(display_list_recorder);
+        record(display_list_context);
+        auto display_list = display_list_recorder.take_display_list();
+
+        if (context.has_svg_context()) {
+            recorder.append(*display_list, coordinate_space);
+            return;
+        }
+        key.device_viewport_rect = {};
+        if (display_list->depends_on_viewport())
+            key.device_viewport_rect = context.device_viewport_rect();
+        m_cached_display_list = move(display_list);
+        m_cached_display_list_key = move(key);
+    }
+
+    recorder.append(*m_cached_display_list, coordinate_space);
+}
+
+void StackingContext::invalidate_display_list() const
+{
+    for (auto const* stacking_context = this; stacking_context; stacking_context = stacking_context->m_parent)
+        stacking_context->m_cached_display_list = nullptr;
+}
+
+void StackingContext::record(PaintContext& context) const
+{
+    auto opacity = m_box.computed_values().opacity();
     auto affine_transform = affine_transform_matrix();
     auto translation = context.rounded_device_point(affine_transform.translation().to_type<CSSPixels>()).to_type<int>().to_type<float>();
     affine_transform.set_translation(translation);
@@ -382,43 +430,26 @@ void StackingContext::paint(PaintContext& context) const
         auto destination_rect = transformed_destination_rect.to_rounded<int>();
 
         // FIXME: We should find a way to scale the paintable, rather than paint into a separate bitmap,
-        // then scale it. This snippet now copies the background at the destination, then scales it down/up
-        // to the size of the source (which could add some artefacts, though just scaling the bitmap already does that).
-        // We need to copy the background at the destination because a bunch of our rendering effects now rely on
-        // being able to sample the painter (see border radii, shadows, filters, etc).
-        CSSPixelPoint destination_clipped_fixup {};
-        auto try_get_scaled_destination_bitmap = [&]() -> ErrorOr<NonnullRefPtr<Gfx::Bitmap>> {
-            Gfx::IntRect actual_destination_rect;
-            auto bitmap = TRY(context.painter().get_region_bitmap(destination_rect, Gfx::BitmapFormat::BGRA8888, actual_destination_rect));
-            // get_region_bitmap() may clip to a smaller region if the requested rect goes outside the painter, so we need to account for that.
-            destination_clipped_fixup = CSSPixelPoint { destination_rect.location() - actual_destination_rect.location() };
-            destination_rect = actual_destination_rect;
-            if (source_rect.size() != transformed_destination_rect.size()) {
-                auto sx = static_cast<float>(source_rect.width()) / transformed_destination_rect.width();
-                auto sy = static_cast<float>(source_rect.height()) / transformed_destination_rect.height();
-                bitmap = TRY(bitmap->scaled(sx, sy));
-                destination_clipped_fixup.scale_by(sx, sy);
-            }
-            return bitmap;
-        };
-
-        auto bitmap_or_error = try_get_scaled_destination_bitmap();
-        if (bitmap_or_error.is_error())
-            return;
-        auto bitmap = bitmap_or_error.release_value_but_fixme_should_propagate_errors();
-        Gfx::Painter painter(bitmap);
-        painter.translate(context.rounded_device_point(-paintable().absolute_paint_rect().location() + destination_clipped_fixup).to_type<int>());
-        auto paint_context = context.clone(painter);
-        paint_internal(paint_context);
-
-        if (destination_rect.size() == bitmap->size())
-            context.painter().blit(destination_rect.location(), *bitmap, bitmap->rect(), opacity);
-        else
-            context.painter().draw_scaled_bitmap(destination_rect, *bitmap, bitmap->rect(), opacity, Gfx::Painter::ScalingMode::BilinearBlend);
+        // then scale it. See paint_layer() in DisplayList.cpp for how the layer gets composited.
+        RecordingPainter layer_recorder;
+        auto layer_context = context.clone(layer_recorder);
+        paint_internal(layer_context);
+
+        auto content_origin = -paintable().absolute_paint_rect().location();
+        context.painter().paint_layer({
+            .destination_rect = destination_rect,
+            .source_size = source_rect.size(),
+            .transformed_destination_size = transformed_destination_rect.size(),
+            .content_origin = { content_origin.x().value(), content_origin.y().value() },
+            .device_pixels_per_css_pixel = context.device_pixels_per_css_pixel(),
+            .opacity = opacity,
+            .content = layer_recorder.take_display_list(),
+        });
     } else {
-        Gfx::PainterStateSaver saver(context.painter());
+        context.painter().save();
         context.painter().translate(affine_transform.translation().to_rounded<int>());
         paint_internal(context);
+        context.painter().restore();
     }
 }
 
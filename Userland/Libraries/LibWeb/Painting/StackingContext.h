@@ -9,6 +9,7 @@
 #include <AK/Vector.h>
 #include <LibGfx/Matrix4x4.h>
 #include <LibWeb/Layout/Node.h>
+#include <LibWeb/Painting/DisplayList.h>
 #include <LibWeb/Painting/Paintable.h>
 
 namespace Web::Painting {
@@ -34,6 +35,10 @@ public:
     void paint(PaintContext&) const;
     Optional<HitTestResult> hit_test(CSSPixelPoint, HitTestType) const;
 
+    // Drops the display list recorded for this stacking context, along with the ones of
+    // all the stacking contexts it gets painted into.
+    void invalidate_display_list() const;
+
     Gfx::FloatMatrix4x4 const& transform_matrix() const { return m_transform; }
     Gfx::AffineTransform affine_transform_matrix() const;
 
@@ -48,6 +53,21 @@ private:
     StackingContext* const m_parent { nullptr };
     Vector<StackingContext*> m_children;
 
+    // Everything a recorded display list depends on besides the paintables themselves.
+    struct DisplayListCacheKey {
+        RecordingState initial_state;
+        float device_pixels_per_css_pixel { 0 };
+        Gfx::PaletteImpl const* palette { nullptr };
+        bool has_focus { false };
+        bool should_show_line_box_borders { false };
+        Optional<DevicePixelRect> device_viewport_rect;
+
+        bool operator==(DisplayListCacheKey const&) const = default;
+    };
+    mutable RefPtr<DisplayList> m_cached_display_list;
+    mutable DisplayListCacheKey m_cached_display_list_key;
+
+    void record(PaintContext&) const;
     void paint_internal(PaintContext&) const;
     Gfx::FloatMatrix4x4 get_transformation_matrix(CSS::Transformation const& transformation) const;
     Gfx::FloatMatrix4x4 combine_transformations(Vector<CSS::Transformation> const& transformations) const;
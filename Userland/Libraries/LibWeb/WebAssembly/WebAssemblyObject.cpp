@@ -11,6 +11,7 @@
 #include "WebAssemblyModulePrototype.h"
 #include "WebAssemblyTableObject.h"
 #include "WebAssemblyTablePrototype.h"
+#include <AK/AnyOf.h>
 #include <AK/MemoryStream.h>
 #include <AK/ScopeGuard.h>
 #include <LibJS/Runtime/Array.h>
@@ -196,6 +197,10 @@ JS::ThrowCompletionOr<size_t> WebAssemblyObject::instantiate_module(JS::VM& vm,
                     //        just extract its address and resolve to that.
                     Wasm::HostFunction host_function {
                         [&](auto&, auto& arguments) -> Wasm::Result {
+                            // The caller surfaces this as a TypeError, as it would if JS called a function like this.
+                            if (has_vector_values(type))
+                                return Wasm::Trap { "Cannot call a JavaScript function that takes or returns a v128" };
+
                             JS::MarkedVector<JS::Value> argument_values { vm.heap() };
                             for (auto& entry : arguments)
                                 argument_values.append(to_js_value(vm, entry));
@@ -351,6 +356,14 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyObject::instantiate)
     return promise;
 }
 
+// https://webassembly.github.io/spec/js-api/#exported-function-exotic-objects
+// v128 values have no JS representation, so calls across the boundary that would carry them must fail.
+bool has_vector_values(Wasm::FunctionType const& type)
+{
+    auto is_vector = [](auto& value_type) { return value_type.kind() == Wasm::ValueType::V128; };
+    return any_of(type.parameters(), is_vector) || any_of(type.results(), is_vector);
+}
+
 JS::Value to_js_value(JS::VM& vm, Wasm::Value& wasm_value)
 {
     auto& realm = *vm.current_realm();
@@ -368,6 +381,9 @@ JS::Value to_js_value(JS::VM& vm, Wasm::Value& wasm_value)
         return create_native_function(vm, wasm_value.to<Wasm::Reference::Func>().value().address, "FIXME_IHaveNoIdeaWhatThisShouldBeCalled");
     case Wasm::ValueType::NullFunctionReference:
         return JS::js_null();
+    case Wasm::ValueType::V128:
+        // Functions dealing in vectors can't be called from or into JS, see has_vector_values().
+        VERIFY_NOT_REACHED();
     case Wasm::ValueType::ExternReference:
     case Wasm::ValueType::NullExternReference:
         TODO();
@@ -416,6 +432,8 @@ JS::ThrowCompletionOr<Wasm::Value> to_webassembly_value(JS::VM& vm, JS::Value va
 
         return vm.throw_completion<JS::TypeError>(JS::ErrorType::NotAnObjectOfType, "Exported function");
     }
+    case Wasm::ValueType::V128:
+        return vm.throw_completion<JS::TypeError>("Cannot convert a value to a v128"sv);
     case Wasm::ValueType::ExternReference:
     case Wasm::ValueType::NullExternReference:
         TODO();
@@ -437,6 +455,9 @@ JS::NativeFunction* create_native_function(JS::VM& vm, Wasm::FunctionAddress add
         name,
         [address, type = type.release_value()](JS::VM& vm) -> JS::ThrowCompletionOr<JS::Value> {
             auto& realm = *vm.current_realm();
+            if (has_vector_values(type))
+                return vm.throw_completion<JS::TypeError>("Cannot call a WebAssembly function that takes or returns a v128"sv);
+
             Vector<Wasm::Value> values;
             values.ensure_capacity(type.parameters().size());
 
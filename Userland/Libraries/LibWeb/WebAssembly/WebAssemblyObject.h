@@ -16,6 +16,7 @@ namespace Web::Bindings {
 class WebAssemblyMemoryObject;
 class WebAssemblyTableObject;
 JS::ThrowCompletionOr<size_t> parse_module(JS::VM&, JS::Object* buffer);
+bool has_vector_values(Wasm::FunctionType const&);
 JS::NativeFunction* create_native_function(JS::VM&, Wasm::FunctionAddress address, DeprecatedString const& name);
 JS::Value to_js_value(JS::VM&, Wasm::Value& wasm_value);
 JS::ThrowCompletionOr<Wasm::Value> to_webassembly_value(JS::VM&, JS::Value value, Wasm::ValueType const& type);
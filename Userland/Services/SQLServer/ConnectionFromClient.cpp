@@ -87,8 +87,9 @@ Messages::SQLServer::ExecuteStatementResponse ConnectionFromClient::execute_stat
     dbgln_if(SQLSERVER_DEBUG, "ConnectionFromClient::execute_query_statement(statement_id: {})", statement_id);
 
     auto statement = SQLStatement::statement_for(statement_id);
-    if (statement && statement->connection()->client_id() == client_id()) {
-        // FIXME: Support taking parameters from IPC requests.
+    if (statement && statement->client_id() == client_id()) {
+        if (auto* database_connection = statement->connection())
+            database_connection->did_execute_statement(statement_id);
         return statement->execute(move(const_cast<Vector<SQL::Value>&>(placeholder_values)));
     }
 
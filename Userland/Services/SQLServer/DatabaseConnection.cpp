@@ -61,6 +61,7 @@ DatabaseConnection::DatabaseConnection(NonnullRefPtr<SQL::Database> database, De
 void DatabaseConnection::disconnect()
 {
     dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection::disconnect(connection_id {}, database '{}'", connection_id(), m_database_name);
+    release_prepared_statements();
     s_connections.remove(connection_id());
 }
 
@@ -68,8 +69,56 @@ SQL::ResultOr<SQL::StatementID> DatabaseConnection::prepare_statement(StringView
 {
     dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection::prepare_statement(connection_id {}, database '{}', sql '{}'", connection_id(), m_database_name, sql);
 
+    auto use = ++m_prepared_statement_use_count;
+    DeprecatedString sql_text = sql;
+
+    if (auto it = m_prepared_statements.find(sql_text); it != m_prepared_statements.end()) {
+        dbgln_if(SQLSERVER_DEBUG, "Reusing prepared statement {}", it->value.statement_id);
+        it->value.last_use = use;
+        return it->value.statement_id;
+    }
+
     auto statement = TRY(SQLStatement::create(*this, sql));
+    if (m_prepared_statements.size() >= prepared_statement_cache_size)
+        evict_least_recently_used_statement();
+
+    m_prepared_statements.set(move(sql_text), { statement->statement_id(), use });
     return statement->statement_id();
 }
 
+void DatabaseConnection::did_execute_statement(SQL::StatementID statement_id)
+{
+    for (auto& prepared_statement : m_prepared_statements) {
+        if (prepared_statement.value.statement_id == statement_id) {
+            prepared_statement.value.last_use = ++m_prepared_statement_use_count;
+            return;
+        }
+    }
+}
+
+void DatabaseConnection::evict_least_recently_used_statement()
+{
+    VERIFY(!m_prepared_statements.is_empty());
+
+    auto least_recently_used = m_prepared_statements.begin();
+    for (auto it = m_prepared_statements.begin(); it != m_prepared_statements.end(); ++it) {
+        if (it->value.last_use < least_recently_used->value.last_use)
+            least_recently_used = it;
+    }
+
+    dbgln_if(SQLSERVER_DEBUG, "Evicting prepared statement {}", least_recently_used->value.statement_id);
+    if (auto statement = SQLStatement::statement_for(least_recently_used->value.statement_id))
+        statement->release();
+    m_prepared_statements.remove(least_recently_used);
+}
+
+void DatabaseConnection::release_prepared_statements()
+{
+    for (auto& prepared_statement : m_prepared_statements) {
+        if (auto statement = SQLStatement::statement_for(prepared_statement.value.statement_id))
+            statement->release();
+    }
+    m_prepared_statements.clear();
+}
+
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
 #include <LibCore/Object.h>
 #include <LibSQL/Database.h>
@@ -19,6 +20,8 @@ class DatabaseConnection final : public Core::Object {
     C_OBJECT_ABSTRACT(DatabaseConnection)
 
 public:
+    static constexpr inline size_t prepared_statement_cache_size = 64;
+
     static ErrorOr<NonnullRefPtr<DatabaseConnection>> create(StringView database_path, DeprecatedString database_name, int client_id);
     ~DatabaseConnection() override = default;
 
@@ -28,15 +31,32 @@ public:
     NonnullRefPtr<SQL::Database> database() { return m_database; }
     StringView database_name() const { return m_database_name; }
     void disconnect();
+
+    // Preparing the same SQL text again returns the statement that was prepared for it before, as long as
+    // it's among the most recently used statements of the connection.
     SQL::ResultOr<SQL::StatementID> prepare_statement(StringView sql);
 
+    // Keeps a statement that is executed repeatedly from being evicted, even if its SQL text isn't prepared again.
+    void did_execute_statement(SQL::StatementID);
+
 private:
     DatabaseConnection(NonnullRefPtr<SQL::Database> database, DeprecatedString database_name, int client_id);
 
+    void evict_least_recently_used_statement();
+    void release_prepared_statements();
+
+    struct PreparedStatement {
+        SQL::StatementID statement_id { 0 };
+        u64 last_use { 0 };
+    };
+
     NonnullRefPtr<SQL::Database> m_database;
     DeprecatedString m_database_name;
     SQL::ConnectionID m_connection_id { 0 };
     int m_client_id { 0 };
+
+    HashMap<DeprecatedString, PreparedStatement> m_prepared_statements;
+    u64 m_prepared_statement_use_count { 0 };
 };
 
 }
@@ -36,6 +36,8 @@ SQL::ResultOr<NonnullRefPtr<SQLStatement>> SQLStatement::create(DatabaseConnecti
 
 SQLStatement::SQLStatement(DatabaseConnection& connection, NonnullRefPtr<SQL::AST::Statement> statement)
     : Core::Object(&connection)
+    , m_connection(connection)
+    , m_client_id(connection.client_id())
     , m_statement_id(s_next_statement_id++)
     , m_statement(move(statement))
 {
@@ -47,32 +49,41 @@ void SQLStatement::report_error(SQL::Result result, SQL::ExecutionID execution_i
 {
     dbgln_if(SQLSERVER_DEBUG, "SQLStatement::report_error(statement_id {}, error {}", statement_id(), result.error_string());
 
-    auto client_connection = ConnectionFromClient::client_connection_for(connection()->client_id());
-
-    s_statements.remove(statement_id());
-    remove_from_parent();
-
+    auto client_connection = ConnectionFromClient::client_connection_for(client_id());
     if (client_connection)
         client_connection->async_execution_error(statement_id(), execution_id, result.error(), result.error_string());
     else
         warnln("Cannot return execution error. Client disconnected");
 }
 
+void SQLStatement::release()
+{
+    dbgln_if(SQLSERVER_DEBUG, "SQLStatement::release(statement_id {})", statement_id());
+    s_statements.remove(statement_id());
+    remove_from_parent();
+}
+
 Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_values)
 {
     dbgln_if(SQLSERVER_DEBUG, "SQLStatement::execute(statement_id {}", statement_id());
 
-    auto client_connection = ConnectionFromClient::client_connection_for(connection()->client_id());
+    auto client_connection = ConnectionFromClient::client_connection_for(client_id());
     if (!client_connection) {
         warnln("Cannot yield next result. Client disconnected");
         return {};
     }
 
+    if (!m_connection) {
+        warnln("Cannot execute statement. Database connection has disappeared");
+        return {};
+    }
+
     auto execution_id = m_next_execution_id++;
     m_ongoing_executions.set(execution_id);
 
-    deferred_invoke([this, placeholder_values = move(placeholder_values), execution_id] {
-        auto execution_result = m_statement->execute(connection()->database(), placeholder_values);
+    // Executions that are already queued when the statement is released still run, so hold on to the database until then.
+    deferred_invoke([this, database = m_connection->database(), placeholder_values = move(placeholder_values), execution_id] {
+        auto execution_result = m_statement->execute(database, placeholder_values);
         m_ongoing_executions.remove(execution_id);
 
         if (execution_result.is_error()) {
@@ -80,7 +91,13 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
             return;
         }
 
-        auto client_connection = ConnectionFromClient::client_connection_for(connection()->client_id());
+        // Every statement is its own transaction, so its changes are made durable before it's reported as successful.
+        if (auto commit_result = database->commit(); commit_result.is_error()) {
+            report_error(commit_result.release_error(), execution_id);
+            return;
+        }
+
+        auto client_connection = ConnectionFromClient::client_connection_for(client_id());
         if (!client_connection) {
             warnln("Cannot return statement execution results. Client disconnected");
             return;
@@ -124,7 +141,7 @@ bool SQLStatement::should_send_result_rows(SQL::ResultSet const& result) const
 
 void SQLStatement::next(SQL::ExecutionID execution_id, SQL::ResultSet result, size_t result_size)
 {
-    auto client_connection = ConnectionFromClient::client_connection_for(connection()->client_id());
+    auto client_connection = ConnectionFromClient::client_connection_for(client_id());
     if (!client_connection) {
         warnln("Cannot yield next result. Client disconnected");
         return;
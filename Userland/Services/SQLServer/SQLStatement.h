@@ -9,6 +9,7 @@
 #include <AK/DeprecatedString.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/Vector.h>
+#include <AK/WeakPtr.h>
 #include <LibCore/Object.h>
 #include <LibSQL/AST/AST.h>
 #include <LibSQL/Result.h>
@@ -28,9 +29,13 @@ public:
 
     static RefPtr<SQLStatement> statement_for(SQL::StatementID statement_id);
     SQL::StatementID statement_id() const { return m_statement_id; }
-    DatabaseConnection* connection() { return dynamic_cast<DatabaseConnection*>(parent()); }
+    int client_id() const { return m_client_id; }
+    DatabaseConnection* connection() { return m_connection.ptr(); }
     Optional<SQL::ExecutionID> execute(Vector<SQL::Value> placeholder_values);
 
+    // Makes the statement unavailable to clients. Executions that are already underway still run to completion.
+    void release();
+
 private:
     SQLStatement(DatabaseConnection&, NonnullRefPtr<SQL::AST::Statement> statement);
 
@@ -38,6 +43,9 @@ private:
     void next(SQL::ExecutionID execution_id, SQL::ResultSet result, size_t result_size);
     void report_error(SQL::Result, SQL::ExecutionID execution_id);
 
+    // Weak, since the connection owns the statement as one of its children.
+    WeakPtr<DatabaseConnection> m_connection;
+    int m_client_id { 0 };
     SQL::StatementID m_statement_id { 0 };
 
     HashTable<SQL::ExecutionID> m_ongoing_executions;
@@ -14,6 +14,7 @@
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/Platform/Timer.h>
 #include <WebContent/WebContentClientEndpoint.h>
 #include <WebContent/WebDriverConnection.h>
@@ -118,11 +119,13 @@ void PageHost::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& targ
         return;
     }
 
-    Web::PaintContext context(painter, palette(), device_pixels_per_css_pixel());
+    Web::Painting::RecordingPainter recording_painter;
+    Web::PaintContext context(recording_painter, palette(), device_pixels_per_css_pixel());
     context.set_should_show_line_box_borders(m_should_show_line_box_borders);
     context.set_device_viewport_rect(content_rect);
     context.set_has_focus(m_has_focus);
     layout_root->paint_all_phases(context);
+    recording_painter.take_display_list()->execute(painter);
 }
 
 void PageHost::set_viewport_rect(Web::DevicePixelRect const& rect)
@@ -9,20 +9,22 @@
 #include <AK/Base64.h>
 #include <AK/Debug.h>
 #include <AK/LexicalPath.h>
-#include <AK/MemoryStream.h>
+#include <AK/MemMem.h>
 #include <AK/QuickSort.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <AK/URL.h>
 #include <LibCore/DateTime.h>
-#include <LibCore/DeprecatedFile.h>
 #include <LibCore/DirIterator.h>
-#include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibCore/MimeData.h>
+#include <LibCore/System.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibHTTP/HttpResponse.h>
 #include <WebServer/Client.h>
 #include <WebServer/Configuration.h>
+#include <WebServer/FileCache.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -37,68 +39,109 @@ Client::Client(NonnullOwnPtr<Core::BufferedTCPSocket> socket, Core::Object* pare
 
 void Client::die()
 {
+    if (m_idle_timer)
+        m_idle_timer->stop();
     m_socket->close();
     deferred_invoke([this] { remove_from_parent(); });
 }
 
 void Client::start()
 {
-    m_socket->on_ready_to_read = [this] {
-        StringBuilder builder;
+    // FIXME: Propagate errors
+    m_idle_timer = Core::Timer::create_single_shot(keep_alive_timeout_ms, [this] { die(); }, this).release_value_but_fixme_should_propagate_errors();
+    m_idle_timer->start();
 
-        auto maybe_buffer = ByteBuffer::create_uninitialized(m_socket->buffer_size());
-        if (maybe_buffer.is_error()) {
-            warnln("Could not create buffer for client: {}", maybe_buffer.error());
+    m_socket->on_ready_to_read = [this] {
+        if (auto result = on_ready_to_read(); result.is_error()) {
+            warnln("Failed to handle the request: {}", result.error());
             die();
-            return;
         }
+    };
+}
 
-        auto buffer = maybe_buffer.release_value();
-        for (;;) {
-            auto maybe_can_read = m_socket->can_read_without_blocking();
-            if (maybe_can_read.is_error()) {
-                warnln("Failed to get the blocking status for the socket: {}", maybe_can_read.error());
-                die();
-                return;
-            }
-
-            if (!maybe_can_read.value())
-                break;
-
-            auto maybe_bytes_read = m_socket->read_until_any_of(buffer, Array { "\r"sv, "\n"sv, "\r\n"sv });
-            if (maybe_bytes_read.is_error()) {
-                warnln("Failed to read a line from the request: {}", maybe_bytes_read.error());
-                die();
-                return;
-            }
-
-            if (m_socket->is_eof()) {
-                die();
-                break;
-            }
-
-            builder.append(StringView { maybe_bytes_read.value() });
-            builder.append("\r\n"sv);
+static bool should_keep_connection_alive(HTTP::HttpRequest const& request)
+{
+    if (auto it = request.headers().find_if([](auto& header) { return header.name.equals_ignoring_case("Connection"sv); }); !it.is_end()) {
+        auto value = it->value.trim_whitespace();
+        if (value.equals_ignoring_case("close"sv))
+            return false;
+        if (value.equals_ignoring_case("keep-alive"sv))
+            return true;
+    }
+
+    // HTTP/1.1 connections are persistent by default, HTTP/1.0 ones have to ask for it.
+    return request.version() == HTTP::HttpRequest::Version::HTTP1_1;
+}
+
+static Optional<size_t> request_content_length(HTTP::HttpRequest const& request)
+{
+    auto it = request.headers().find_if([](auto& header) { return header.name.equals_ignoring_case("Content-Length"sv); });
+    if (it.is_end())
+        return 0;
+    return it->value.trim_whitespace().to_uint<size_t>();
+}
+
+ErrorOr<void> Client::on_ready_to_read()
+{
+    bool peer_closed_connection = false;
+    while (TRY(m_socket->can_read_without_blocking())) {
+        auto old_size = m_request_buffer.size();
+        TRY(m_request_buffer.try_resize(old_size + m_socket->buffer_size()));
+        auto bytes_read = TRY(m_socket->read(m_request_buffer.bytes().slice(old_size)));
+        m_request_buffer.resize(old_size + bytes_read.size());
+
+        if (m_socket->is_eof()) {
+            peer_closed_connection = true;
+            break;
+        }
+    }
+
+    // Requests are answered in the order they were received, even if the client sent several of them without waiting for a response.
+    size_t handled_size = 0;
+    while (handled_size < m_request_buffer.size()) {
+        auto pending_data = m_request_buffer.bytes().slice(handled_size);
+        auto header_end = AK::memmem_optional(pending_data.data(), pending_data.size(), "\r\n\r\n", 4);
+        if (!header_end.has_value()) {
+            if (pending_data.size() > max_request_header_size)
+                return Error::from_string_literal("Request header is too large");
+            break;
         }
 
-        auto request = builder.to_byte_buffer();
-        dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", DeprecatedString::copy(request));
+        auto header_size = header_end.value() + 4;
+        auto request = HTTP::HttpRequest::from_raw_request(pending_data.trim(header_size));
+        if (!request.has_value())
+            return Error::from_string_literal("Malformed request");
 
-        auto maybe_did_handle = handle_request(request);
-        if (maybe_did_handle.is_error()) {
-            warnln("Failed to handle the request: {}", maybe_did_handle.error());
+        // Request bodies aren't used, but they still have to be skipped to get to the next request.
+        auto content_length = request_content_length(request.value());
+        if (!content_length.has_value())
+            return Error::from_string_literal("Invalid Content-Length header");
+        if (pending_data.size() - header_size < content_length.value())
+            break;
+
+        dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", StringView { pending_data.trim(header_size) });
+        TRY(handle_request(request.value()));
+        handled_size += header_size + content_length.value();
+
+        if (!m_keep_alive) {
+            die();
+            return {};
         }
+    }
 
+    if (peer_closed_connection) {
         die();
-    };
+        return {};
+    }
+
+    if (handled_size > 0)
+        m_request_buffer = TRY(m_request_buffer.slice(handled_size, m_request_buffer.size() - handled_size));
+    m_idle_timer->restart();
+    return {};
 }
 
-ErrorOr<bool> Client::handle_request(ReadonlyBytes raw_request)
+ErrorOr<void> Client::handle_request(HTTP::HttpRequest const& request)
 {
-    auto request_or_error = HTTP::HttpRequest::from_raw_request(raw_request);
-    if (!request_or_error.has_value())
-        return false;
-    auto& request = request_or_error.value();
     auto resource_decoded = URL::percent_decode(request.resource());
 
     if constexpr (WEBSERVER_DEBUG) {
@@ -108,9 +151,13 @@ ErrorOr<bool> Client::handle_request(ReadonlyBytes raw_request)
         }
     }
 
-    if (request.method() != HTTP::HttpRequest::Method::GET) {
+    m_keep_alive = should_keep_connection_alive(request);
+
+    if (request.method() != HTTP::HttpRequest::Method::GET && request.method() != HTTP::HttpRequest::Method::HEAD) {
+        // The client may expect us to handle the body of this request in some way, so don't try to read further requests after it.
+        m_keep_alive = false;
         TRY(send_error_response(501, request));
-        return false;
+        return {};
     }
 
     // Check for credentials if they are required
@@ -121,7 +168,7 @@ ErrorOr<bool> Client::handle_request(ReadonlyBytes raw_request)
             Vector<String> headers {};
             TRY(headers.try_append(basic_auth_header));
             TRY(send_error_response(401, request, move(headers)));
-            return false;
+            return {};
         }
     }
 
@@ -133,7 +180,14 @@ ErrorOr<bool> Client::handle_request(ReadonlyBytes raw_request)
     path_builder.append(requested_path);
     auto real_path = TRY(path_builder.to_string());
 
-    if (Core::DeprecatedFile::is_directory(real_path.bytes_as_string_view())) {
+    auto maybe_stat = Core::System::stat(real_path);
+    if (maybe_stat.is_error()) {
+        TRY(send_error_response(404, request));
+        return {};
+    }
+    auto st = maybe_stat.release_value();
+
+    if (S_ISDIR(st.st_mode)) {
         if (!resource_decoded.ends_with('/')) {
             StringBuilder red;
 
@@ -141,100 +195,129 @@ ErrorOr<bool> Client::handle_request(ReadonlyBytes raw_request)
             red.append("/"sv);
 
             TRY(send_redirect(red.to_deprecated_string(), request));
-            return true;
+            return {};
         }
 
         StringBuilder index_html_path_builder;
         index_html_path_builder.append(real_path);
         index_html_path_builder.append("/index.html"sv);
         auto index_html_path = TRY(index_html_path_builder.to_string());
-        if (!Core::DeprecatedFile::exists(index_html_path)) {
+        auto maybe_index_html_stat = Core::System::stat(index_html_path);
+        if (maybe_index_html_stat.is_error()) {
             TRY(handle_directory_listing(requested_path, real_path, request));
-            return true;
+            return {};
         }
         real_path = index_html_path;
+        st = maybe_index_html_stat.release_value();
     }
 
-    auto file = Core::DeprecatedFile::construct(real_path.bytes_as_string_view());
-    if (!file->open(Core::OpenMode::ReadOnly)) {
-        TRY(send_error_response(404, request));
-        return false;
+    if (!S_ISREG(st.st_mode)) {
+        TRY(send_error_response(403, request));
+        return {};
     }
 
-    if (file->is_device()) {
-        TRY(send_error_response(403, request));
-        return false;
+    // Larger files are sent straight from the file to the socket by the kernel, without mapping them here.
+    if (static_cast<size_t>(st.st_size) > max_coalesced_body_size) {
+        TRY(send_file_response(real_path, st, request));
+        return {};
+    }
+
+    auto maybe_file = FileCache::the().get(real_path, st);
+    if (maybe_file.is_error()) {
+        TRY(send_error_response(404, request));
+        return {};
     }
 
-    auto stream = TRY(Core::File::open(real_path.bytes_as_string_view(), Core::File::OpenMode::Read));
+    auto file = maybe_file.release_value();
+    TRY(send_response(file.bytes(), request, file.mime_type));
+    return {};
+}
 
-    auto const info = ContentInfo {
-        .type = TRY(String::from_deprecated_string(Core::guess_mime_type_based_on_filename(real_path.bytes_as_string_view()))),
-        .length = TRY(Core::DeprecatedFile::size(real_path.bytes_as_string_view()))
-    };
-    TRY(send_response(*stream, request, move(info)));
-    return true;
+void Client::append_connection_header(StringBuilder& builder) const
+{
+    if (m_keep_alive)
+        builder.append("Connection: keep-alive\r\n"sv);
+    else
+        builder.append("Connection: close\r\n"sv);
 }
 
-ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& request, ContentInfo content_info)
+void Client::append_response_headers(StringBuilder& builder, size_t content_length, String const& content_type) const
 {
-    StringBuilder builder;
-    builder.append("HTTP/1.0 200 OK\r\n"sv);
+    builder.append("HTTP/1.1 200 OK\r\n"sv);
     builder.append("Server: WebServer (SerenityOS)\r\n"sv);
     builder.append("X-Frame-Options: SAMEORIGIN\r\n"sv);
     builder.append("X-Content-Type-Options: nosniff\r\n"sv);
     builder.append("Pragma: no-cache\r\n"sv);
-    if (content_info.type == "text/plain")
-        builder.appendff("Content-Type: {}; charset=utf-8\r\n", content_info.type);
+    if (content_type == "text/plain")
+        builder.appendff("Content-Type: {}; charset=utf-8\r\n", content_type);
     else
-        builder.appendff("Content-Type: {}\r\n", content_info.type);
-    builder.appendff("Content-Length: {}\r\n", content_info.length);
+        builder.appendff("Content-Type: {}\r\n", content_type);
+    builder.appendff("Content-Length: {}\r\n", content_length);
+    append_connection_header(builder);
     builder.append("\r\n"sv);
+}
 
-    auto builder_contents = builder.to_byte_buffer();
-    TRY(m_socket->write(builder_contents));
-    log_response(200, request);
+ErrorOr<void> Client::send_response(ReadonlyBytes content, HTTP::HttpRequest const& request, String const& content_type)
+{
+    StringBuilder builder;
+    append_response_headers(builder, content.size(), content_type);
 
-    char buffer[PAGE_SIZE];
-    do {
-        auto size = TRY(response.read({ buffer, sizeof(buffer) })).size();
-        if (response.is_eof() && size == 0)
-            break;
+    if (request.method() == HTTP::HttpRequest::Method::HEAD)
+        content = {};
 
-        ReadonlyBytes write_buffer { buffer, size };
-        while (!write_buffer.is_empty()) {
-            auto nwritten = TRY(m_socket->write(write_buffer));
+    // Small bodies go out with the headers, larger ones are written straight from where they are.
+    if (content.size() <= max_coalesced_body_size) {
+        builder.append(StringView { content });
+        content = {};
+    }
 
-            if (nwritten == 0) {
-                dbgln("EEEEEE got 0 bytes written!");
-            }
+    TRY(m_socket->write_entire_buffer(builder.string_view().bytes()));
+    TRY(m_socket->write_entire_buffer(content));
 
-            write_buffer = write_buffer.slice(nwritten);
-        }
-    } while (true);
+    log_response(200, request);
+    return {};
+}
 
-    auto keep_alive = false;
-    if (auto it = request.headers().find_if([](auto& header) { return header.name.equals_ignoring_case("Connection"sv); }); !it.is_end()) {
-        if (it->value.trim_whitespace().equals_ignoring_case("keep-alive"sv))
-            keep_alive = true;
+ErrorOr<void> Client::send_file_response(String const& path, struct stat const& st, HTTP::HttpRequest const& request)
+{
+    auto fd = TRY(Core::System::open(path, O_RDONLY | O_CLOEXEC));
+    ScopeGuard close_fd = [&] { (void)Core::System::close(fd); };
+
+    StringBuilder builder;
+    auto content_type = TRY(String::from_deprecated_string(Core::guess_mime_type_based_on_filename(path)));
+    append_response_headers(builder, st.st_size, content_type);
+    TRY(m_socket->write_entire_buffer(builder.string_view().bytes()));
+
+    if (request.method() != HTTP::HttpRequest::Method::HEAD) {
+        auto socket_fd = m_socket->fd();
+        if (!socket_fd.has_value())
+            return Error::from_errno(ENOTCONN);
+
+        off_t offset = 0;
+        while (offset < st.st_size) {
+            auto nsent = TRY(Core::System::sendfile(socket_fd.value(), fd, &offset, st.st_size - offset));
+            // The file was truncated after we announced its length, so the connection can't be used any further.
+            if (nsent == 0)
+                return Error::from_string_literal("File was truncated while sending it");
+        }
     }
-    if (!keep_alive)
-        m_socket->close();
 
+    log_response(200, request);
     return {};
 }
 
 ErrorOr<void> Client::send_redirect(StringView redirect_path, HTTP::HttpRequest const& request)
 {
     StringBuilder builder;
-    builder.append("HTTP/1.0 301 Moved Permanently\r\n"sv);
+    builder.append("HTTP/1.1 301 Moved Permanently\r\n"sv);
     builder.append("Location: "sv);
     builder.append(redirect_path);
     builder.append("\r\n"sv);
+    builder.append("Content-Length: 0\r\n"sv);
+    append_connection_header(builder);
     builder.append("\r\n"sv);
 
-    auto builder_contents = builder.to_byte_buffer();
-    TRY(m_socket->write(builder_contents));
+    TRY(m_socket->write_entire_buffer(builder.string_view().bytes()));
 
     log_response(301, request);
     return {};
@@ -336,9 +419,7 @@ ErrorOr<void> Client::handle_directory_listing(String const& requested_path, Str
     builder.append("</body>\n"sv);
     builder.append("</html>\n"sv);
 
-    auto response = builder.to_deprecated_string();
-    FixedMemoryStream stream { response.bytes() };
-    return send_response(stream, request, { .type = TRY(String::from_utf8("text/html"sv)), .length = response.length() });
+    return send_response(builder.string_view().bytes(), request, TRY(String::from_utf8("text/html"sv)));
 }
 
 ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const& request, Vector<String> const& headers)
@@ -352,7 +433,7 @@ ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const
     content_builder.append("</h1></body></html>"sv);
 
     StringBuilder header_builder;
-    header_builder.appendff("HTTP/1.0 {} ", code);
+    header_builder.appendff("HTTP/1.1 {} ", code);
     header_builder.append(reason_phrase);
     header_builder.append("\r\n"sv);
 
@@ -362,9 +443,11 @@ ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const
     }
     header_builder.append("Content-Type: text/html; charset=UTF-8\r\n"sv);
     header_builder.appendff("Content-Length: {}\r\n", content_builder.length());
+    append_connection_header(header_builder);
     header_builder.append("\r\n"sv);
-    TRY(m_socket->write(header_builder.to_byte_buffer()));
-    TRY(m_socket->write(content_builder.to_byte_buffer()));
+    if (request.method() != HTTP::HttpRequest::Method::HEAD)
+        header_builder.append(content_builder.string_view());
+    TRY(m_socket->write_entire_buffer(header_builder.string_view().bytes()));
 
     log_response(code, request);
     return {};
@@ -7,11 +7,14 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/String.h>
 #include <LibCore/Object.h>
 #include <LibCore/Socket.h>
+#include <LibCore/Timer.h>
 #include <LibHTTP/Forward.h>
 #include <LibHTTP/HttpRequest.h>
+#include <sys/stat.h>
 
 namespace WebServer {
 
@@ -19,26 +22,37 @@ class Client final : public Core::Object {
     C_OBJECT(Client);
 
 public:
+    // Connections that have been idle for this long are closed, so that persistent connections don't pile up.
+    static constexpr int keep_alive_timeout_ms = 15000;
+    // Requests whose headers don't fit into this many bytes are rejected.
+    static constexpr size_t max_request_header_size = 64 * KiB;
+    // Bodies up to this size are sent along with the headers in a single write.
+    static constexpr size_t max_coalesced_body_size = 16 * KiB;
+
     void start();
 
 private:
     Client(NonnullOwnPtr<Core::BufferedTCPSocket>, Core::Object* parent);
 
-    struct ContentInfo {
-        String type;
-        size_t length {};
-    };
-
-    ErrorOr<bool> handle_request(ReadonlyBytes);
-    ErrorOr<void> send_response(Stream&, HTTP::HttpRequest const&, ContentInfo);
+    ErrorOr<void> on_ready_to_read();
+    ErrorOr<void> handle_request(HTTP::HttpRequest const&);
+    ErrorOr<void> send_response(ReadonlyBytes content, HTTP::HttpRequest const&, String const& content_type);
+    ErrorOr<void> send_file_response(String const& path, struct stat const&, HTTP::HttpRequest const&);
     ErrorOr<void> send_redirect(StringView redirect, HTTP::HttpRequest const&);
     ErrorOr<void> send_error_response(unsigned code, HTTP::HttpRequest const&, Vector<String> const& headers = {});
+    void append_connection_header(StringBuilder&) const;
+    void append_response_headers(StringBuilder&, size_t content_length, String const& content_type) const;
     void die();
     void log_response(unsigned code, HTTP::HttpRequest const&);
     ErrorOr<void> handle_directory_listing(String const& requested_path, String const& real_path, HTTP::HttpRequest const&);
     bool verify_credentials(Vector<HTTP::HttpRequest::Header> const&);
 
     NonnullOwnPtr<Core::BufferedTCPSocket> m_socket;
+    RefPtr<Core::Timer> m_idle_timer;
+
+    // Data that has been received, but not handled yet. This can hold a partial request, or several pipelined ones.
+    ByteBuffer m_request_buffer;
+    bool m_keep_alive { false };
 };
 
 }
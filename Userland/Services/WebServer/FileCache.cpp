@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/MimeData.h>
+#include <WebServer/FileCache.h>
+
+namespace WebServer {
+
+FileCache& FileCache::the()
+{
+    static FileCache s_the;
+    return s_the;
+}
+
+bool FileCache::Entry::matches(struct stat const& st) const
+{
+    return device == st.st_dev
+        && inode == st.st_ino
+        && size == st.st_size
+        && modification_time.tv_sec == st.st_mtim.tv_sec
+        && modification_time.tv_nsec == st.st_mtim.tv_nsec;
+}
+
+ErrorOr<FileCache::File> FileCache::open(String const& path, struct stat const& st)
+{
+    File file;
+    if (st.st_size > 0)
+        file.mapped_file = TRY(Core::MappedFile::map(path));
+    file.mime_type = TRY(String::from_deprecated_string(Core::guess_mime_type_based_on_filename(path)));
+    return file;
+}
+
+ErrorOr<FileCache::File> FileCache::get(String const& path, struct stat const& st)
+{
+    if (auto it = m_entries.find(path); it != m_entries.end()) {
+        if (it->value.matches(st)) {
+            it->value.last_use = ++m_use_count;
+            return it->value.file;
+        }
+        m_entries.remove(it);
+    }
+
+    auto file = TRY(open(path, st));
+    if (m_entries.size() >= max_entry_count)
+        evict_least_recently_used_entry();
+
+    TRY(m_entries.try_set(path, Entry { file, st.st_dev, st.st_ino, st.st_size, st.st_mtim, ++m_use_count }));
+    return file;
+}
+
+void FileCache::evict_least_recently_used_entry()
+{
+    auto least_recently_used = m_entries.begin();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->value.last_use < least_recently_used->value.last_use)
+            least_recently_used = it;
+    }
+    m_entries.remove(least_recently_used);
+}
+
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2023, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/RefPtr.h>
+#include <AK/String.h>
+#include <LibCore/MappedFile.h>
+#include <sys/stat.h>
+
+namespace WebServer {
+
+// Keeps the most recently served small files mapped into memory, so that serving them again
+// only takes a stat() to check that they haven't changed since. Larger files are sent with sendfile().
+class FileCache {
+public:
+    static constexpr size_t max_entry_count = 64;
+
+    struct File {
+        RefPtr<Core::MappedFile> mapped_file; // Empty files can't be mapped, so this is null for them.
+        String mime_type;
+
+        ReadonlyBytes bytes() const { return mapped_file ? mapped_file->bytes() : ReadonlyBytes {}; }
+    };
+
+    static FileCache& the();
+
+    // Returns the regular file at `path`, given the result of stat()'ing it.
+    ErrorOr<File> get(String const& path, struct stat const&);
+
+private:
+    struct Entry {
+        File file;
+        dev_t device { 0 };
+        ino_t inode { 0 };
+        off_t size { 0 };
+        timespec modification_time {};
+        u64 last_use { 0 };
+
+        bool matches(struct stat const&) const;
+    };
+
+    static ErrorOr<File> open(String const& path, struct stat const&);
+    void evict_least_recently_used_entry();
+
+    HashMap<String, Entry> m_entries;
+    u64 m_use_count { 0 };
+};
+
+}
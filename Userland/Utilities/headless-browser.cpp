@@ -34,11 +34,13 @@
 #include <LibMain/Main.h>
 #include <LibWeb/Cookie/ParsedCookie.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/Dump.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/Layout/InitialContainingBlock.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/Platform/EventLoopPluginSerenity.h>
 #include <LibWeb/Platform/FontPluginSerenity.h>
 #include <LibWeb/Platform/ImageCodecPlugin.h>
@@ -85,11 +87,49 @@ public:
             return;
         }
 
-        Web::PaintContext context(painter, palette(), device_pixels_per_css_pixel());
+        Web::Painting::RecordingPainter recording_painter;
+        Web::PaintContext context(recording_painter, palette(), device_pixels_per_css_pixel());
         context.set_should_show_line_box_borders(false);
         context.set_device_viewport_rect(content_rect);
         context.set_has_focus(true);
         layout_root->paint_all_phases(context);
+        recording_painter.take_display_list()->execute(painter);
+    }
+
+    DeprecatedString dump_layout_tree(bool from_scratch)
+    {
+        auto* document = page().top_level_browsing_context().active_document();
+        if (!document)
+            return "(no DOM tree)";
+
+        // NOTE: Throwing away the previous layout makes this lay out everything again, instead of reusing the parts
+        //       that haven't changed since the last layout.
+        if (from_scratch)
+            document->set_needs_layout();
+        document->update_layout();
+
+        auto* layout_root = this->layout_root();
+        if (!layout_root)
+            return "(no layout tree)";
+        StringBuilder builder;
+        Web::dump_tree(builder, *layout_root);
+        return builder.to_deprecated_string();
+    }
+
+    void set_should_report_layout_timings(bool should_report_layout_timings)
+    {
+        m_should_report_layout_timings = should_report_layout_timings;
+    }
+
+    void report_layout_timings() const
+    {
+        if (!m_should_report_layout_timings)
+            return;
+        auto const* document = page().top_level_browsing_context().active_document();
+        if (!document)
+            return;
+        auto const& statistics = document->layout_statistics();
+        outln("Layout: {} passes ({} incremental), {}us in total", statistics.layout_count, statistics.incremental_layout_count, statistics.total_layout_time.to_microseconds());
     }
 
     void setup_palette(Core::AnonymousBuffer theme_buffer)
@@ -208,6 +248,13 @@ public:
 
     virtual void page_did_layout() override
     {
+        if (!m_should_report_layout_timings)
+            return;
+        auto* document = page().top_level_browsing_context().active_document();
+        if (!document)
+            return;
+        auto const& statistics = document->layout_statistics();
+        dbgln("Layout pass #{} took {}us", statistics.layout_count, statistics.last_layout_time.to_microseconds());
     }
 
     virtual void page_did_request_scroll_into_view(Web::CSSPixelRect const&) override
@@ -253,6 +300,8 @@ private:
     Web::DevicePixelRect m_screen_rect { 0, 0, 800, 600 };
     Web::CSS::PreferredColorScheme m_preferred_color_scheme { Web::CSS::PreferredColorScheme::Auto };
 
+    bool m_should_report_layout_timings { false };
+
     RefPtr<WebContent::WebDriverConnection> m_webdriver;
 };
 
@@ -703,6 +752,19 @@ static void load_page_for_screenshot_and_exit(HeadlessBrowserPageClient& page_cl
             auto image_buffer = MUST(Gfx::PNGWriter::encode(output_bitmap));
             MUST(output_file->write(image_buffer.bytes()));
 
+            page_client.report_layout_timings();
+            exit(0);
+        }).release_value_but_fixme_should_propagate_errors();
+
+    timer->start();
+}
+
+static void load_page_for_layout_dump_and_exit(HeadlessBrowserPageClient& page_client, int dump_after, bool from_scratch)
+{
+    auto timer = Core::Timer::create_single_shot(
+        dump_after * 1000,
+        [&page_client, from_scratch]() {
+            outln("{}", page_client.dump_layout_tree(from_scratch));
             exit(0);
         }).release_value_but_fixme_should_propagate_errors();
 
@@ -717,6 +779,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     StringView error_page_url;
     StringView ca_certs_path;
     StringView webdriver_ipc_path;
+    bool report_layout_timings = false;
+    bool dump_layout_tree = false;
+    bool dump_layout_tree_from_scratch = false;
 
     Core::EventLoop event_loop;
     Core::ArgsParser args_parser;
@@ -726,6 +791,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(error_page_url, "URL for the error page (defaults to file:///res/html/error.html)", "error-page", 'e', "error-page-url");
     args_parser.add_option(ca_certs_path, "The bundled ca certificates file", "certs", 'c', "ca-certs-path");
     args_parser.add_option(webdriver_ipc_path, "Path to the WebDriver IPC socket", "webdriver-ipc-path", 0, "path");
+    args_parser.add_option(report_layout_timings, "Report the time spent on layout", "layout-timings", 'l');
+    args_parser.add_option(dump_layout_tree, "Dump the layout tree after [n] seconds instead of taking a screenshot", "dump-layout-tree", 'd');
+    args_parser.add_option(dump_layout_tree_from_scratch, "Lay out the whole page again before dumping the layout tree", "from-scratch", 0);
     args_parser.add_positional_argument(url, "URL to open", "url", Core::ArgsParser::Required::Yes);
     args_parser.parse(arguments);
 
@@ -757,6 +825,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         Web::FrameLoader::set_error_page_url(error_page_url);
 
     auto page_client = HeadlessBrowserPageClient::create();
+    page_client->set_should_report_layout_timings(report_layout_timings);
 
     if (!resources_folder.is_empty()) {
         auto system_theme = TRY(Gfx::load_system_theme(LexicalPath::join(resources_folder, "themes/Default.ini"sv).string()));
@@ -775,6 +844,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if (!webdriver_ipc_path.is_empty())
         TRY(page_client->connect_to_webdriver(webdriver_ipc_path));
+    else if (dump_layout_tree)
+        load_page_for_layout_dump_and_exit(*page_client, take_screenshot_after, dump_layout_tree_from_scratch);
     else
         load_page_for_screenshot_and_exit(*page_client, take_screenshot_after);
 
@@ -72,6 +72,7 @@ private:
 static bool s_dump_ast = false;
 static bool s_run_bytecode = false;
 static bool s_opt_bytecode = false;
+static bool s_dump_property_lookup_cache_statistics = false;
 static bool s_as_module = false;
 static bool s_print_last_result = false;
 static bool s_strip_ansi = false;
@@ -236,6 +237,12 @@ static ErrorOr<bool> parse_and_run(JS::Interpreter& interpreter, StringView sour
                     result = result_or_error.value.release_error();
                 else
                     result = result_or_error.frame->registers[0];
+
+                if (s_dump_property_lookup_cache_statistics) {
+                    auto const& statistics = bytecode_interpreter.property_lookup_cache_statistics();
+                    dbgln("GetById: {} cache hits, {} cache misses", statistics.get_by_id_hits, statistics.get_by_id_misses);
+                    dbgln("PutById: {} cache hits, {} cache misses", statistics.put_by_id_hits, statistics.put_by_id_misses);
+                }
             } else {
                 return ReturnEarly::Yes;
             }
@@ -607,6 +614,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
     args_parser.add_option(s_run_bytecode, "Run the bytecode", "run-bytecode", 'b');
     args_parser.add_option(s_opt_bytecode, "Optimize the bytecode", "optimize-bytecode", 'p');
+    args_parser.add_option(s_dump_property_lookup_cache_statistics, "Dump property lookup cache statistics after running the bytecode", "dump-property-lookup-cache-statistics", 0);
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
@@ -7,12 +7,14 @@
 
 #include <AK/MemoryStream.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibLine/Editor.h>
 #include <LibMain/Main.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/RegisterInterpreter.h>
 #include <LibWasm/Printer/Printer.h>
 #include <LibWasm/Types.h>
 #include <signal.h>
@@ -128,7 +130,7 @@ static bool pre_interpret_hook(Wasm::Configuration& config, Wasm::InstructionPoi
                     warnln("invalid memory index {} (not found)", args[2]);
                     continue;
                 }
-                warnln("{:>32hex-dump}", mem->data().bytes());
+                warnln("{:>32hex-dump}", mem->bytes());
                 continue;
             }
             if (what.is_one_of("i", "instr", "instruction")) {
@@ -276,6 +278,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool debug = false;
     bool export_all_imports = false;
     bool shell_mode = false;
+    bool use_register_interpreter = false;
+    bool print_execution_time = false;
+    bool use_guard_pages = false;
     DeprecatedString exported_function_to_execute;
     Vector<u64> values_to_push;
     Vector<DeprecatedString> modules_to_link_in;
@@ -288,6 +293,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     parser.add_option(exported_function_to_execute, "Attempt to execute the named exported function from the module (implies -i)", "execute", 'e', "name");
     parser.add_option(export_all_imports, "Export noop functions corresponding to imports", "export-noop", 0);
     parser.add_option(shell_mode, "Launch a REPL in the module's context (implies -i)", "shell", 's');
+    parser.add_option(use_register_interpreter, "Execute the register code function bodies are lowered into, instead of their bytecode", "register-ir", 0);
+    parser.add_option(print_execution_time, "Print how long the executed function took to run", "time", 0);
+    parser.add_option(use_guard_pages, "Back memories with guard pages instead of bounds checking accesses to them", "guard-pages", 0);
     parser.add_option(Core::ArgsParser::Option {
         .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
         .help_string = "Extra modules to link with, use to resolve imports",
@@ -328,6 +336,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 1;
     }
 
+    if (use_register_interpreter && debug) {
+        warnln("The debugger can only step through bytecode, ignoring --register-ir");
+        use_register_interpreter = false;
+    }
+
     if (debug || shell_mode) {
         old_signal = signal(SIGINT, sigint_handler);
     }
@@ -349,6 +362,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if (attempt_instantiate) {
         Wasm::AbstractMachine machine;
+        if (use_guard_pages)
+            machine.enable_guard_page_memories();
         Core::EventLoop main_loop;
         if (debug) {
             g_line_editor = Line::Editor::construct();
@@ -513,7 +528,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 outln();
             }
 
-            auto result = machine.invoke(g_interpreter, run_address.value(), move(values));
+            Wasm::RegisterInterpreter register_interpreter;
+            Wasm::Interpreter& interpreter = use_register_interpreter ? static_cast<Wasm::Interpreter&>(register_interpreter) : g_interpreter;
+            auto timer = Core::ElapsedTimer::start_new();
+            auto result = machine.invoke(interpreter, run_address.value(), move(values));
+            if (print_execution_time)
+                warnln("Execution took {}ms", timer.elapsed());
 
             if (debug)
                 launch_repl();